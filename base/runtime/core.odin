@@ -148,6 +148,7 @@ Type_Info_Struct_Flag :: enum u8 {
 	all_or_none = 2,
 	align       = 3,
 	simple      = 4,
+	reorder     = 5,
 }
 
 Type_Info_Struct :: struct {
@@ -184,6 +185,13 @@ Type_Info_Enum :: struct {
 	base:   ^Type_Info,
 	names:  []string,
 	values: []Type_Info_Enum_Value,
+
+	// Lookup tables generated by the compiler for enums with enough fields, use `type_info_enum_index_of_value`
+	// and `type_info_enum_index_of_name` rather than these directly
+	min_value:    Type_Info_Enum_Value,
+	value_lookup: []i32, // `value_lookup[value - min_value]` is the index of `value` or -1, empty when the values are sparse
+	value_order:  []i32, // indices of `values` sorted by value, empty when `value_lookup` is used
+	name_order:   []i32, // indices of `names` sorted by name
 }
 Type_Info_Map :: struct {
 	key:      ^Type_Info,
@@ -428,6 +436,21 @@ Allocator :: struct {
 	data:      rawptr,
 }
 
+Allocation_Site_Kind :: enum u8 {
+	Make,
+	New,
+	Append,
+	Delete,
+	Free,
+}
+
+// With `-instrument-allocations`, the compiler calls `allocation_site_hook` (when it is not nil) before every
+// call to `make`, `new`, `new_clone`, `append`, `non_zero_append`, `delete` and `free`. `site_id` is static for
+// each call site and is listed along with its location in the `-allocation-sites-file`.
+Allocation_Site_Hook :: #type proc "contextless" (site_id: u64, kind: Allocation_Site_Kind, loc: ^Source_Code_Location)
+
+allocation_site_hook: Allocation_Site_Hook
+
 Byte     :: 1
 Kilobyte :: 1024 * Byte
 Megabyte :: 1024 * Kilobyte
@@ -810,6 +833,70 @@ type_info_underlying :: proc "contextless" (info: ^Type_Info) -> ^Type_Info {
 // This is also aliased as `type_info_core`
 type_info_base_without_enum :: type_info_core
 
+// type_info_enum_index_of_value returns the index into `names` and `values` of the first field with the given value.
+// This uses the lookup tables generated by the compiler when they exist, otherwise it is a linear scan.
+@(require_results)
+type_info_enum_index_of_value :: proc "contextless" (e: ^Type_Info_Enum, value: Type_Info_Enum_Value) -> (index: int, ok: bool) #no_bounds_check {
+	if len(e.value_lookup) != 0 {
+		offset := u64(value) - u64(e.min_value)
+		if offset < u64(len(e.value_lookup)) {
+			i := e.value_lookup[offset]
+			return int(i), i >= 0
+		}
+		return -1, false
+	} else if len(e.value_order) != 0 {
+		lo, hi := 0, len(e.value_order)
+		for lo < hi {
+			mid := int(uint(lo+hi) >> 1)
+			if e.values[e.value_order[mid]] < value {
+				lo = mid+1
+			} else {
+				hi = mid
+			}
+		}
+		if lo < len(e.value_order) {
+			i := int(e.value_order[lo])
+			return i, e.values[i] == value
+		}
+		return -1, false
+	}
+	for v, i in e.values {
+		if v == value {
+			return i, true
+		}
+	}
+	return -1, false
+}
+
+// type_info_enum_index_of_name returns the index into `names` and `values` of the field with the given name.
+// This uses the lookup tables generated by the compiler when they exist, otherwise it is a linear scan.
+@(require_results)
+type_info_enum_index_of_name :: proc "contextless" (e: ^Type_Info_Enum, name: string) -> (index: int, ok: bool) #no_bounds_check {
+	if len(e.name_order) != 0 {
+		lo, hi := 0, len(e.name_order)
+		for lo < hi {
+			mid := int(uint(lo+hi) >> 1)
+			if string_cmp(e.names[e.name_order[mid]], name) < 0 {
+				lo = mid+1
+			} else {
+				hi = mid
+			}
+		}
+		if lo < len(e.name_order) {
+			i := int(e.name_order[lo])
+			return i, e.names[i] == name
+		}
+		return -1, false
+	}
+	for n, i in e.names {
+		if n == name {
+			return i, true
+		}
+	}
+	return -1, false
+}
+
+
 @(require_results)
 __type_info_of :: proc "contextless" (id: typeid) -> ^Type_Info #no_bounds_check {
 	n := u64(len(type_table))
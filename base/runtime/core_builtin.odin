@@ -771,34 +771,25 @@ append_elem :: proc(array: ^$T/[dynamic]$E, #no_broadcast arg: E, loc := #caller
 		}
 		(^Raw_Dynamic_Array)(array).len += 1
 		return 1, nil
-	} else when intrinsics.type_is_internally_pointer_like(E) {
-		return _append_elem_ptr((^Raw_Dynamic_Array)(array), rawptr(arg), should_zero=true, loc=loc)
-	} else when ODIN_OPTIMIZATION_MODE <= .Size {
-		arg := arg
-		return _append_elem((^Raw_Dynamic_Array)(array), size_of(E), align_of(E), &arg, should_zero=true, loc=loc)
 	} else {
 		if array == nil {
 			return
 		}
-		arg := arg
 		arr := (^Raw_Dynamic_Array)(array)
-		if arr.cap < arr.len+1 {
-			// Same behavior as _append_elems but there's only one arg, so we always just add DEFAULT_DYNAMIC_ARRAY_CAPACITY.
-			cap := max(2 * arr.cap, DEFAULT_DYNAMIC_ARRAY_CAPACITY)
-
-			// do not 'or_return' here as it could be a partial success
-			err = _reserve_dynamic_array_unsafe(arr, size_of(E), align_of(E), cap, should_zero=true, loc=loc)
-		}
-		if arr.cap-arr.len > 0 {
-			// NOTE(bill, 2026-06-19): When this is in the hot path with -o:speed or -o:aggressive enabled,
-			// this code path cannot rely on type erasure and `mem_copy_non_overlapping`.
-			// So directly inlining the call and storing the argument like this helps the optimize a lot
+		if arr.len < arr.cap {
+			// NOTE: The common case is kept inline and stores the argument directly, only growing
+			// the array goes through the out of line procedures
 			assert(arr.data != nil, loc=loc)
 			([^]E)(arr.data)[arr.len] = arg
 			arr.len += 1
-			num_appended = 1
+			return 1, nil
+		}
+		when intrinsics.type_is_internally_pointer_like(E) {
+			return _append_elem_ptr(arr, rawptr(arg), should_zero=true, loc=loc)
+		} else {
+			arg := arg
+			return _append_elem(arr, size_of(E), align_of(E), &arg, should_zero=true, loc=loc)
 		}
-		return
 	}
 }
 
@@ -810,34 +801,25 @@ non_zero_append_elem :: proc(array: ^$T/[dynamic]$E, #no_broadcast arg: E, loc :
 	when size_of(E) == 0 {
 		(^Raw_Dynamic_Array)(array).len += 1
 		return 1, nil
-	} else when intrinsics.type_is_internally_pointer_like(E) {
-		return _append_elem_ptr((^Raw_Dynamic_Array)(array), rawptr(arg), should_zero=false, loc=loc)
-	} else when ODIN_OPTIMIZATION_MODE <= .Size {
-		arg := arg
-		return _append_elem((^Raw_Dynamic_Array)(array), size_of(E), align_of(E), &arg, should_zero=false, loc=loc)
 	} else {
 		if array == nil {
 			return
 		}
-		arg := arg
 		arr := (^Raw_Dynamic_Array)(array)
-		if arr.cap < arr.len+1 {
-			// Same behavior as _append_elems but there's only one arg, so we always just add DEFAULT_DYNAMIC_ARRAY_CAPACITY.
-			cap := max(2 * arr.cap, DEFAULT_DYNAMIC_ARRAY_CAPACITY)
-
-			// do not 'or_return' here as it could be a partial success
-			err = _reserve_dynamic_array_unsafe(arr, size_of(E), align_of(E), cap, should_zero=false, loc=loc)
-		}
-		if arr.cap-arr.len > 0 {
-			// NOTE(bill, 2026-06-19): When this is in the hot path with -o:speed or -o:aggressive enabled,
-			// this code path cannot rely on type erasure and `mem_copy_non_overlapping`.
-			// So directly inlining the call and storing the argument like this helps the optimize a lot
+		if arr.len < arr.cap {
+			// NOTE: The common case is kept inline and stores the argument directly, only growing
+			// the array goes through the out of line procedures
 			assert(arr.data != nil, loc=loc)
 			([^]E)(arr.data)[arr.len] = arg
 			arr.len += 1
-			num_appended = 1
+			return 1, nil
+		}
+		when intrinsics.type_is_internally_pointer_like(E) {
+			return _append_elem_ptr(arr, rawptr(arg), should_zero=false, loc=loc)
+		} else {
+			arg := arg
+			return _append_elem(arr, size_of(E), align_of(E), &arg, should_zero=false, loc=loc)
 		}
-		return
 	}
 }
 
@@ -194,6 +194,29 @@ map_hash_is_valid :: #force_inline proc "contextless" (hash: Map_Hash) -> bool {
 	return (hash != 0) & (hash & TOMBSTONE_MASK == 0)
 }
 
+// Returns the index of the first occupied cell at or after `start`, or `capacity` if there is none.
+// The code generated for `for k, v in m` calls this when it reaches an unoccupied cell, so that
+// iterating a sparse map skips over its empty and deleted cells several at a time.
+@(require_results)
+map_next_valid_hash :: proc "contextless" (hs: [^]Map_Hash, start, capacity: int) -> int #no_bounds_check {
+	i := start
+	when HAS_HARDWARE_SIMD {
+		for /**/; i + 8 <= capacity; i += 8 {
+			h := intrinsics.unaligned_load(cast(^#simd[8]Map_Hash)&hs[i])
+			occupied := intrinsics.simd_lanes_ne(h, 0) & intrinsics.simd_lanes_eq(h & TOMBSTONE_MASK, 0)
+			if intrinsics.simd_reduce_or(occupied) != 0 {
+				break
+			}
+		}
+	}
+	for /**/; i < capacity; i += 1 {
+		if map_hash_is_valid(hs[i]) {
+			return i
+		}
+	}
+	return capacity
+}
+
 @(require_results)
 map_seed :: #force_inline proc "contextless" (m: Raw_Map) -> uintptr {
 	return map_seed_from_map_data(map_data(m))
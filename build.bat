@@ -102,6 +102,7 @@ set compiler_includes= ^
 	/Isrc\
 set libs= ^
 	kernel32.lib ^
+	Advapi32.lib ^
 	Synchronization.lib ^
 	bin\llvm\windows\LLVM-C.lib
 set odin_res=misc\odin.res
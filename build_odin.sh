@@ -117,15 +117,15 @@ Darwin)
 	;;
 FreeBSD)
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS -lstdc++ $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS -lstdc++ $($LLVM_CONFIG --libs core native orcjit --system-libs)"
 	;;
 NetBSD)
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS -lstdc++ $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS -lstdc++ $($LLVM_CONFIG --libs core native orcjit --system-libs)"
 	;;
 Linux)
 	CXXFLAGS="$CXXFLAGS $($LLVM_CONFIG --cxxflags --ldflags)"
-	LDFLAGS="$LDFLAGS -lstdc++ -ldl $($LLVM_CONFIG --libs core native --system-libs --libfiles)"
+	LDFLAGS="$LDFLAGS -lstdc++ -ldl $($LLVM_CONFIG --libs core native orcjit --system-libs --libfiles)"
 	# Copy libLLVM*.so into current directory for linking
 	# NOTE: This is needed by the Linux release pipeline!
 	# cp $(readlink -f $($LLVM_CONFIG --libfiles)) ./
@@ -134,7 +134,7 @@ Linux)
 OpenBSD)
 	CXXFLAGS="$CXXFLAGS -I/usr/local/include $($LLVM_CONFIG --cxxflags --ldflags)"
 	LDFLAGS="$LDFLAGS -lstdc++ -L/usr/local/lib -Wl,-rpath,$($LLVM_CONFIG --libdir) -liconv"
-	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native --system-libs)"
+	LDFLAGS="$LDFLAGS $($LLVM_CONFIG --libs core native orcjit --system-libs)"
 	;;
 *)
 	error "Platform \"$OS_NAME\" unsupported"
@@ -175,7 +175,18 @@ run_demo() {
 	./odin run examples/demo -vet -strict-style -- Hellope World
 }
 
-if [ $# -eq 0 ]; then
+# Benchmarks the compiler itself against a stored baseline, see tests/benchmark/compiler
+run_benchmark_compiler() {
+	if [ ! -f "./odin" ]; then
+		build_odin release
+	fi
+	python3 tests/benchmark/compiler/benchmark_compiler.py "$@"
+}
+
+if [ $# -ge 1 ] && [ "$1" = "benchmark-compiler" ]; then
+	shift
+	run_benchmark_compiler "$@"
+elif [ $# -eq 0 ]; then
 	build_odin debug
 	run_demo
 
@@ -1684,13 +1684,11 @@ enum_value_to_string :: proc(val: any) -> (string, bool) {
 //
 string_to_enum_value :: proc($T: typeid, s: string) -> (T, bool) {
 	ti := runtime.type_info_base(type_info_of(T))
-	if e, ok := ti.variant.(runtime.Type_Info_Enum); ok {
-		for str, idx in e.names {
-			if s == str {
-				// NOTE(bill): Unsafe cast
-				ptr := cast(^T)&e.values[idx]
-				return ptr^, true
-			}
+	if e, ok := &ti.variant.(runtime.Type_Info_Enum); ok {
+		if idx, found := runtime.type_info_enum_index_of_name(e, s); found {
+			// NOTE(bill): Unsafe cast
+			ptr := cast(^T)&e.values[idx]
+			return ptr^, true
 		}
 	}
 	return T{}, false
@@ -1752,20 +1750,11 @@ stored_enum_value_to_string :: proc(enum_type: ^runtime.Type_Info, ev: runtime.T
 	#partial switch &e in et.variant {
 	case: return "", false
 	case runtime.Type_Info_Enum:
-		if reflect.is_string(e.base) {
-			for val, idx in e.values {
-				if val == ev {
-					return e.names[idx], true
-				}
-			}
-		} else if len(e.values) == 0 {
+		if len(e.values) == 0 && !reflect.is_string(e.base) {
 			return "", true
-		} else {
-			for val, idx in e.values {
-				if val == ev {
-					return e.names[idx], true
-				}
-			}
+		}
+		if idx, found := runtime.type_info_enum_index_of_value(&e, ev); found {
+			return e.names[idx], true
 		}
 		return "", false
 	}
@@ -1874,7 +1863,7 @@ fmt_bit_set :: proc(fi: ^Info, v: any, name: string = "", verb: rune = 'v') {
 		io.write_byte(fi.writer, '{', &fi.n)
 		defer io.write_byte(fi.writer, '}', &fi.n)
 
-		e, is_enum := et.variant.(runtime.Type_Info_Enum)
+		e, is_enum := &et.variant.(runtime.Type_Info_Enum)
 		commas := 0
 		loop: for i in transmute(bit_set[0..<128])bits {
 			i := i64(i) + info.lower
@@ -1887,17 +1876,14 @@ fmt_bit_set :: proc(fi: ^Info, v: any, name: string = "", verb: rune = 'v') {
 				if ti_named, is_named := info.elem.variant.(runtime.Type_Info_Named); is_named {
 					enum_name = ti_named.name
 				}
-				for ev, evi in e.values {
-					v := u64(ev)
-					if v == u64(i) {
-						if verb == 'w' {
-							io.write_string(fi.writer, enum_name, &fi.n)
-							io.write_byte(fi.writer, '.', &fi.n)
-						}
-						io.write_string(fi.writer, e.names[evi], &fi.n)
-						commas += 1
-						continue loop
+				if evi, found := runtime.type_info_enum_index_of_value(e, runtime.Type_Info_Enum_Value(i)); found {
+					if verb == 'w' {
+						io.write_string(fi.writer, enum_name, &fi.n)
+						io.write_byte(fi.writer, '.', &fi.n)
 					}
+					io.write_string(fi.writer, e.names[evi], &fi.n)
+					commas += 1
+					continue loop
 				}
 			}
 			io.write_i64(fi.writer, i, 10, &fi.n)
@@ -810,6 +810,7 @@ Struct_Type :: struct {
 	is_no_copy:      bool,
 	is_all_or_none:  bool,
 	is_simple:       bool,
+	is_reorder:      bool,
 	fields:          ^Field_List,
 	name_count:      int,
 }
@@ -11,8 +11,8 @@ Array :: struct($T: typeid) {
 String :: distinct Array(byte)
 
 Version_Type_Major :: 0
-Version_Type_Minor :: 3
-Version_Type_Patch :: 2
+Version_Type_Minor :: 4
+Version_Type_Patch :: 0
 
 Version_Type :: struct {
 	major, minor, patch: u8,
@@ -44,6 +44,40 @@ Header :: struct {
 	pkgs:     Array(Pkg),
 	entities: Array(Entity),
 	types:    Array(Type),
+
+	sections:  Array(Section),
+	pkg_index: Array(Pkg_Index_Entry), // sorted by `fullpath_hash`
+}
+
+Section_Kind :: enum u32le {
+	Invalid  = 0,
+	Files    = 1,
+	Pkgs     = 2,
+	Entities = 3,
+	Types    = 4,
+	Strings  = 5,
+	Blob     = 6, // every other array, including `pkg_index`
+}
+
+Section_Version :: 1
+
+// Every section is one contiguous byte range of the file, so a reader can map the file
+// and only touch the sections it needs. `version` changes whenever the layout of a
+// section's items changes, independently of the file version.
+Section :: struct {
+	kind:    Section_Kind,
+	version: u32le,
+	offset:  u32le, // in bytes from the start of the file
+	size:    u32le, // in bytes
+}
+
+// The top level entities of a package (its `entries`) are stored contiguously in `entities`,
+// so one package can be read without looking at any other package.
+Pkg_Index_Entry :: struct {
+	fullpath_hash: u32le, // FNV-1a (32-bit) of the package's fullpath
+	pkg:           Pkg_Index,
+	first_entity:  Entity_Index,
+	entity_count:  u32le,
 }
 
 File_Index   :: distinct u32le
@@ -325,6 +359,45 @@ from_string :: proc(base: ^Header_Base, s: String) -> string {
 
 
 
+// Finds a package by its fullpath through `pkg_index`, without scanning `pkgs`
+find_pkg :: proc(h: ^Header, fullpath: string) -> (pkg: ^Pkg, index: Pkg_Index, ok: bool) {
+	hash := u32le(0x811c9dc5)
+	for b in transmute([]byte)fullpath {
+		hash = (hash ~ u32le(b)) * 0x01000193
+	}
+
+	pkgs := from_array(&h.base, h.pkgs)
+	entries := from_array(&h.base, h.pkg_index)
+	lo, hi := 0, len(entries)
+	for lo < hi {
+		mid := lo + (hi-lo)/2
+		if entries[mid].fullpath_hash < hash {
+			lo = mid+1
+		} else {
+			hi = mid
+		}
+	}
+	for i := lo; i < len(entries) && entries[i].fullpath_hash == hash; i += 1 {
+		p := &pkgs[entries[i].pkg]
+		if from_string(&h.base, p.fullpath) == fullpath {
+			return p, entries[i].pkg, true
+		}
+	}
+	return
+}
+
+// Returns the contiguous range of `entities` holding the top level entities of a package
+pkg_entities :: proc(h: ^Header, index: Pkg_Index) -> []Entity {
+	for entry in from_array(&h.base, h.pkg_index) {
+		if entry.pkg == index {
+			entities := from_array(&h.base, h.entities)
+			lo := int(entry.first_entity)
+			return entities[lo:][:entry.entity_count]
+		}
+	}
+	return nil
+}
+
 Reader_Error :: enum {
 	None,
 	Header_Too_Small,
@@ -2763,6 +2763,7 @@ parse_operand :: proc(p: ^Parser, lhs: bool) -> ^ast.Expr {
 		is_no_copy:      bool
 		is_all_or_none:  bool
 		is_simple:       bool
+		is_reorder:      bool
 		fields:          ^ast.Field_List
 		name_count:      int
 
@@ -2796,6 +2797,11 @@ parse_operand :: proc(p: ^Parser, lhs: bool) -> ^ast.Expr {
 					error(p, tag.pos, "duplicate struct tag '#%s'", tag.text)
 				}
 				is_simple = true
+			case "reorder":
+				if is_reorder {
+					error(p, tag.pos, "duplicate struct tag '#%s'", tag.text)
+				}
+				is_reorder = true
 			case "align":
 				if align != nil {
 					error(p, tag.pos, "duplicate struct tag '#%s'", tag.text)
@@ -2837,6 +2843,10 @@ parse_operand :: proc(p: ^Parser, lhs: bool) -> ^ast.Expr {
 			is_all_or_none = false
 			error(p, tok.pos, "'#raw_union' cannot also be '#all_or_none")
 		}
+		if is_reorder && (is_raw_union || is_packed) {
+			is_reorder = false
+			error(p, tok.pos, "'#raw_union' and '#packed' cannot also be '#reorder'")
+		}
 
 		where_token: tokenizer.Token
 		where_clauses: []^ast.Expr
@@ -2866,6 +2876,7 @@ parse_operand :: proc(p: ^Parser, lhs: bool) -> ^ast.Expr {
 		st.is_no_copy        = is_no_copy
 		st.is_all_or_none    = is_all_or_none
 		st.is_simple         = is_simple
+		st.is_reorder        = is_reorder
 		st.fields            = fields
 		st.name_count        = name_count
 		st.where_token       = where_token
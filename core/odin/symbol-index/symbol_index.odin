@@ -0,0 +1,175 @@
+// The symbol index file format, as written by `odin check -export-symbol-index:<filename>`.
+//
+// The data is meant to be memory mapped and queried in place, answering go-to-definition and
+// find-references queries without running the compiler again.
+package odin_symbol_index
+
+import "core:mem"
+
+Array :: struct($T: typeid) {
+	offset: u32le,
+	length: u32le,
+}
+
+String :: distinct Array(byte)
+
+Version :: 1
+
+Magic_String :: "odinsym\x00"
+
+Header :: struct {
+	magic:       [8]byte,
+	version:     u32le,
+	total_size:  u32le, // in bytes
+
+	files:       Array(String), // indexed by `File_Index`, the file with index 0 is always empty
+	symbols:     Array(Symbol),
+	uses:        Array(Use),         // grouped by symbol, and sorted by position within each group
+	uses_by_pos: Array(Use_Index),   // sorted by (file, offset)
+	strings:     Array(byte),        // every `String` points into this
+}
+
+File_Index   :: distinct u32le
+Symbol_Index :: distinct u32le
+Use_Index    :: distinct u32le
+
+Pos :: struct {
+	file:   File_Index, // 0 when there is no source position, e.g. for builtins
+	line:   u32le,
+	column: u32le,
+	offset: u32le,
+}
+
+// NOTE: Matches the compiler's `EntityKind`
+Symbol_Kind :: enum u32le {
+	Invalid,
+	Constant,
+	Variable,
+	Type_Name,
+	Procedure,
+	Proc_Group,
+	Builtin,
+	Import_Name,
+	Library_Name,
+	Nil,
+	Label,
+}
+
+Symbol_Flag :: enum u32le {
+	Global = 0, // declared in a package or file scope
+}
+
+Symbol_Flags :: distinct bit_set[Symbol_Flag; u32le]
+
+Symbol :: struct {
+	name:      String,
+	pkg:       String,
+	kind:      Symbol_Kind,
+	flags:     Symbol_Flags,
+	pos:       Pos,
+	first_use: Use_Index,
+	use_count: u32le,
+}
+
+Use :: struct {
+	symbol: Symbol_Index,
+	length: u32le, // in bytes
+	pos:    Pos,
+}
+
+from_array :: proc(h: ^Header, a: $A/Array($T)) -> []T {
+	s: mem.Raw_Slice
+	s.data = rawptr(uintptr(h) + uintptr(a.offset))
+	s.len = int(a.length)
+	return transmute([]T)s
+}
+from_string :: proc(h: ^Header, s: String) -> string {
+	return string(from_array(h, s))
+}
+
+file_path :: proc(h: ^Header, file: File_Index) -> string {
+	files := from_array(h, h.files)
+	if int(file) >= len(files) {
+		return ""
+	}
+	return from_string(h, files[file])
+}
+
+// Finds the file index for a full path, which is needed to query by position
+find_file :: proc(h: ^Header, fullpath: string) -> (file: File_Index, ok: bool) {
+	for f, i in from_array(h, h.files) {
+		if i != 0 && from_string(h, f) == fullpath {
+			return File_Index(i), true
+		}
+	}
+	return
+}
+
+// Returns the identifier use at a byte offset within a file, e.g. the cursor position of an editor
+use_at :: proc(h: ^Header, file: File_Index, offset: u32le) -> (use: ^Use, ok: bool) {
+	uses := from_array(h, h.uses)
+	by_pos := from_array(h, h.uses_by_pos)
+
+	// Find the last use which starts at or before the offset
+	lo, hi := 0, len(by_pos)
+	for lo < hi {
+		mid := lo + (hi-lo)/2
+		p := uses[by_pos[mid]].pos
+		if p.file < file || (p.file == file && p.offset <= offset) {
+			lo = mid+1
+		} else {
+			hi = mid
+		}
+	}
+	if lo == 0 {
+		return
+	}
+	use = &uses[by_pos[lo-1]]
+	if use.pos.file == file && offset < use.pos.offset + use.length {
+		return use, true
+	}
+	return nil, false
+}
+
+// Go-to-definition: the symbol referred to by the identifier at a byte offset within a file
+definition_at :: proc(h: ^Header, file: File_Index, offset: u32le) -> (symbol: ^Symbol, ok: bool) {
+	use := use_at(h, file, offset) or_return
+	return &from_array(h, h.symbols)[use.symbol], true
+}
+
+// Find-references: every recorded use of a symbol
+references :: proc(h: ^Header, symbol: ^Symbol) -> []Use {
+	uses := from_array(h, h.uses)
+	lo := int(symbol.first_use)
+	return uses[lo:][:symbol.use_count]
+}
+
+Reader_Error :: enum {
+	None,
+	Header_Too_Small,
+	Invalid_Magic,
+	Data_Too_Small,
+	Invalid_Version,
+}
+
+read_from_bytes :: proc(data: []byte) -> (h: ^Header, err: Reader_Error) {
+	if len(data) < size_of(Header) {
+		err = .Header_Too_Small
+		return
+	}
+	header := (^Header)(raw_data(data))
+	if header.magic != Magic_String {
+		err = .Invalid_Magic
+		return
+	}
+	if len(data) < int(header.total_size) {
+		err = .Data_Too_Small
+		return
+	}
+	if header.version != Version {
+		err = .Invalid_Version
+		return
+	}
+	h = header
+	return
+}
@@ -773,12 +773,10 @@ struct_tag_lookup :: proc(tag: Struct_Tag, key: string) -> (value: string, ok: b
 enum_string :: proc(a: any) -> string {
 	if a == nil { return "" }
 	ti := runtime.type_info_base(type_info_of(a.id))
-	if e, ok := ti.variant.(runtime.Type_Info_Enum); ok {
+	if e, ok := &ti.variant.(runtime.Type_Info_Enum); ok {
 		v, _ := as_i64(a)
-		for value, i in e.values {
-			if value == Type_Info_Enum_Value(v) {
-				return e.names[i]
-			}
+		if i, found := runtime.type_info_enum_index_of_value(e, Type_Info_Enum_Value(v)); found {
+			return e.names[i]
 		}
 	} else {
 		panic("expected an enum to reflect.enum_string")
@@ -791,15 +789,10 @@ enum_string :: proc(a: any) -> string {
 @(require_results)
 enum_from_name :: proc($Enum_Type: typeid, name: string) -> (value: Enum_Type, ok: bool) {
 	ti := type_info_base(type_info_of(Enum_Type))
-	if eti, eti_ok := ti.variant.(runtime.Type_Info_Enum); eti_ok {
-		for value_name, i in eti.names {
-			if value_name != name {
-				continue
-			}
-			v := eti.values[i]
-			value = Enum_Type(v)
+	if eti, eti_ok := &ti.variant.(runtime.Type_Info_Enum); eti_ok {
+		if i, found := runtime.type_info_enum_index_of_name(eti, name); found {
+			value = Enum_Type(eti.values[i])
 			ok = true
-			return
 		}
 	}
 	return
@@ -809,14 +802,10 @@ enum_from_name :: proc($Enum_Type: typeid, name: string) -> (value: Enum_Type, o
 @(require_results)
 enum_from_name_any :: proc(Enum_Type: typeid, name: string) -> (value: Type_Info_Enum_Value, ok: bool) {
 	ti := runtime.type_info_base(type_info_of(Enum_Type))
-	if eti, eti_ok := ti.variant.(runtime.Type_Info_Enum); eti_ok {
-		for value_name, i in eti.names {
-			if value_name != name {
-				continue
-			}
+	if eti, eti_ok := &ti.variant.(runtime.Type_Info_Enum); eti_ok {
+		if i, found := runtime.type_info_enum_index_of_name(eti, name); found {
 			value = eti.values[i]
 			ok = true
-			return
 		}
 	}
 	return
@@ -826,17 +815,9 @@ enum_from_name_any :: proc(Enum_Type: typeid, name: string) -> (value: Type_Info
 @(require_results)
 enum_name_from_value :: proc(value: $Enum_Type) -> (name: string, ok: bool) where intrinsics.type_is_enum(Enum_Type) {
 	ti := type_info_base(type_info_of(Enum_Type))
-	e := ti.variant.(runtime.Type_Info_Enum) or_return
-	if len(e.values) == 0 {
-		return
-	}
-	ev := Type_Info_Enum_Value(value)
-	for val, idx in e.values {
-		if val == ev {
-			return e.names[idx], true
-		}
-	}
-	return
+	e := (&ti.variant.(runtime.Type_Info_Enum)) or_return
+	i := runtime.type_info_enum_index_of_value(e, Type_Info_Enum_Value(value)) or_return
+	return e.names[i], true
 }
 
 // enum_name_from_value_any returns the name of enum field if a valid name using reflection, otherwise returns `"", false`
@@ -846,17 +827,10 @@ enum_name_from_value_any :: proc(value: any) -> (name: string, ok: bool) {
 		return
 	}
 	ti := type_info_base(type_info_of(value.id))
-	e := ti.variant.(runtime.Type_Info_Enum) or_return
-	if len(e.values) == 0 {
-		return
-	}
+	e := (&ti.variant.(runtime.Type_Info_Enum)) or_return
 	ev := Type_Info_Enum_Value(as_i64(value) or_return)
-	for val, idx in e.values {
-		if val == ev {
-			return e.names[idx], true
-		}
-	}
-	return
+	i := runtime.type_info_enum_index_of_value(e, ev) or_return
+	return e.names[i], true
 }
 
 // Returns whether the value given has a defined name in the enum type.
@@ -722,6 +722,7 @@ write_type_writer :: #force_no_inline proc(w: io.Writer, ti: ^Type_Info, n_writt
 		if .raw_union   in info.flags { io.write_string(w, "#raw_union ",   &n) or_return }
 		if .all_or_none in info.flags { io.write_string(w, "#all_or_none ", &n) or_return }
 		if .simple      in info.flags { io.write_string(w, "#simple ",      &n) or_return }
+		if .reorder     in info.flags { io.write_string(w, "#reorder ",     &n) or_return }
 		if .align in info.flags {
 			io.write_string(w, "#align(",      &n) or_return
 			io.write_i64(w, i64(ti.align), 10, &n) or_return
@@ -0,0 +1,83 @@
+package testing
+
+import "base:intrinsics"
+import "core:time"
+
+// IMPORTANT NOTE: Compiler requires this layout
+Benchmark_Signature :: proc(^B)
+
+// IMPORTANT NOTE: Compiler requires this layout, which is the same as `Internal_Test`
+Internal_Benchmark :: struct {
+	pkg:  string,
+	name: string,
+	p:    Benchmark_Signature,
+}
+
+/*
+The state of a procedure with the attribute `@(benchmark)`, which `odin bench` runs.
+
+The procedure must do the work being measured `b.n` times, the runner picks `n` so that
+each measured round takes long enough to be timed reliably:
+
+	@(benchmark)
+	bench_hash :: proc(b: ^testing.B) {
+		data := make([]byte, 4096)
+		defer delete(data)
+		b.bytes = len(data)
+
+		testing.reset_timer(b) // Do not count the setup.
+		for _ in 0..<b.n {
+			testing.keep(hash.crc32(data))
+		}
+	}
+*/
+B :: struct {
+	// The number of times the work must be done.
+	n: int,
+
+	// The number of bytes the work processes each time, when set the throughput is reported as well.
+	bytes: int,
+
+	// The seed for any random operations, the same as `T.seed` for tests.
+	seed: u64,
+
+	_start:   time.Tick,
+	_elapsed: time.Duration,
+	_running: bool,
+	_failed:  bool,
+}
+
+// Starts (or resumes) the timing of a benchmark, which is done by the runner before calling it.
+start_timer :: proc "contextless" (b: ^B) {
+	if !b._running {
+		b._start   = time.tick_now()
+		b._running = true
+	}
+}
+
+// Pauses the timing of a benchmark, for setup which should not be measured.
+stop_timer :: proc "contextless" (b: ^B) {
+	if b._running {
+		b._elapsed += time.tick_since(b._start)
+		b._running  = false
+	}
+}
+
+// Discards the time measured so far, without stopping the timer.
+reset_timer :: proc "contextless" (b: ^B) {
+	b._elapsed = 0
+	if b._running {
+		b._start = time.tick_now()
+	}
+}
+
+// Marks a benchmark as failed, its results are not reported.
+bench_fail :: proc "contextless" (b: ^B) {
+	b._failed = true
+}
+
+// Keeps a value from being optimized away when nothing else uses it.
+keep :: #force_inline proc "contextless" (value: $T) {
+	value := value
+	intrinsics.volatile_store(&value, value)
+}
@@ -0,0 +1,14 @@
+#+private
+package testing
+
+import "core:sys/linux"
+
+_pin_to_cpu :: proc(cpu: int) -> bool {
+	mask: [16]u64
+	if cpu >= len(mask)*64 {
+		return false
+	}
+	mask[cpu/64] = 1 << uint(cpu%64)
+	_, err := linux.sched_setaffinity(0, size_of(mask), &mask)
+	return err == nil
+}
@@ -0,0 +1,8 @@
+#+private
+#+build !windows
+#+build !linux
+package testing
+
+_pin_to_cpu :: proc(cpu: int) -> bool {
+	return false
+}
@@ -0,0 +1,11 @@
+#+private
+package testing
+
+import win32 "core:sys/windows"
+
+_pin_to_cpu :: proc(cpu: int) -> bool {
+	if cpu >= 8*size_of(win32.DWORD_PTR) {
+		return false
+	}
+	return win32.SetThreadAffinityMask(win32.GetCurrentThread(), 1 << uint(cpu)) != 0
+}
@@ -0,0 +1,210 @@
+#+private
+package testing
+
+@(require) import "core:encoding/json"
+import            "core:fmt"
+import            "core:math/rand"
+@(require) import "core:os"
+import            "core:slice"
+import            "core:strings"
+import            "core:time"
+
+// Select a specific set of benchmarks to run by name, in the same format as `ODIN_TEST_NAMES`.
+BENCH_NAMES           : string : #config(ODIN_BENCH_NAMES,               "")
+// How long each benchmark is run before it is measured, in milliseconds.
+BENCH_WARMUP_MS       : int    : #config(ODIN_BENCH_WARMUP_MS,           100)
+// How long each measured round of a benchmark should take at least, in milliseconds.
+BENCH_ROUND_MS        : int    : #config(ODIN_BENCH_ROUND_MS,            100)
+// How many rounds each benchmark is measured for, the median and the fastest of them are reported.
+BENCH_ROUNDS          : int    : #config(ODIN_BENCH_ROUNDS,              5)
+// Run every round for exactly this many iterations, rather than picking the count from `ODIN_BENCH_ROUND_MS`.
+BENCH_ITERATIONS      : int    : #config(ODIN_BENCH_ITERATIONS,          0)
+// Pin the benchmarks to this CPU, where supported. -1 leaves the scheduling to the OS.
+BENCH_CPU             : int    : #config(ODIN_BENCH_CPU,                 -1)
+// Output the results of the benchmarks to the given path.
+BENCH_JSON_REPORT     : string : #config(ODIN_BENCH_JSON_REPORT,         "")
+// Compare the results against a JSON report of a previous run, and fail if any benchmark got slower.
+BENCH_BASELINE        : string : #config(ODIN_BENCH_BASELINE,            "")
+// How many percent slower than the baseline a benchmark may be before it counts as a regression.
+BENCH_THRESHOLD       : int    : #config(ODIN_BENCH_THRESHOLD,           5)
+
+BENCH_MAX_ITERATIONS :: 1_000_000_000
+
+Bench_JSON :: struct {
+	cpu:        int,
+	benchmarks: [dynamic]Bench_JSON_Result,
+}
+
+Bench_JSON_Result :: struct {
+	pkg:           string,
+	name:          string,
+	iterations:    int,
+	ns_per_op:     f64, // the median of the rounds
+	min_ns_per_op: f64,
+	mb_per_s:      f64, // only when `B.bytes` is set
+}
+
+bench_run_once :: proc(it: Internal_Benchmark, b: ^B, n: int) -> time.Duration {
+	b.n        = n
+	b._elapsed = 0
+	b._running = false
+
+	start_timer(b)
+	it.p(b)
+	stop_timer(b)
+
+	free_all(context.temp_allocator)
+	return b._elapsed
+}
+
+// Runs the benchmark until it has warmed up, and returns the iteration count for the measured rounds.
+bench_warm_up :: proc(it: Internal_Benchmark, b: ^B) -> int {
+	warmup := time.Duration(BENCH_WARMUP_MS) * time.Millisecond
+	round  := time.Duration(BENCH_ROUND_MS)  * time.Millisecond
+
+	start := time.tick_now()
+	n := max(BENCH_ITERATIONS, 1)
+	for !b._failed {
+		elapsed := bench_run_once(it, b, n)
+		if BENCH_ITERATIONS > 0 || elapsed >= round || n >= BENCH_MAX_ITERATIONS {
+			if time.tick_since(start) >= warmup {
+				break
+			}
+			continue
+		}
+		// Aim a bit past the round time so that the next run is likely to be long enough.
+		next := n * 100
+		if elapsed > 0 {
+			next = int(f64(n) * 1.2 * f64(round) / f64(elapsed))
+		}
+		n = clamp(next, n+1, min(n*100, BENCH_MAX_ITERATIONS))
+	}
+	return n
+}
+
+bench_runner :: proc(internal_benchmarks: []Internal_Benchmark) -> bool {
+	internal_benchmarks := internal_benchmarks
+
+	if BENCH_NAMES != "" {
+		selected := make([dynamic]Internal_Benchmark, 0, len(internal_benchmarks), context.temp_allocator)
+		index_list := BENCH_NAMES
+		for selector in strings.split_iterator(&index_list, ",") {
+			pkg, _, name := strings.partition(selector, ".")
+			if name == "" {
+				pkg, name = "", pkg
+			}
+			found := false
+			for it in internal_benchmarks {
+				if it.name == name && (pkg == "" || it.pkg == pkg) {
+					append(&selected, it)
+					found = true
+				}
+			}
+			if !found {
+				fmt.eprintfln("No benchmark found for the name: %q", selector)
+			}
+		}
+		internal_benchmarks = selected[:]
+	}
+
+	if len(internal_benchmarks) == 0 {
+		fmt.println("No benchmarks to run.")
+		return true
+	}
+
+	pinned_cpu := -1
+	when BENCH_CPU >= 0 {
+		if _pin_to_cpu(BENCH_CPU) {
+			pinned_cpu = BENCH_CPU
+		} else {
+			fmt.eprintfln("Unable to pin the benchmarks to CPU %i, they are run unpinned.", BENCH_CPU)
+		}
+	}
+
+	baseline: Bench_JSON
+	when BENCH_BASELINE != "" {
+		baseline_data, read_err := os.read_entire_file(BENCH_BASELINE, context.allocator)
+		fmt.assertf(read_err == nil, "unable to read the baseline %q, error: %v", BENCH_BASELINE, read_err)
+		json_err := json.unmarshal(baseline_data, &baseline)
+		fmt.assertf(json_err == nil, "unable to parse the baseline %q, error: %v", BENCH_BASELINE, json_err)
+	}
+
+	report := Bench_JSON{cpu = pinned_cpu}
+	rounds := make([]f64, max(BENCH_ROUNDS, 1))
+	defer delete(rounds)
+
+	name_width := 0
+	for it in internal_benchmarks {
+		name_width = max(name_width, len(it.pkg) + 1 + len(it.name))
+	}
+
+	regressions := 0
+	failures    := 0
+	for it in internal_benchmarks {
+		b := B{seed = rand.uint64()}
+
+		n := bench_warm_up(it, &b)
+		for &ns_per_op in rounds {
+			if b._failed {
+				break
+			}
+			elapsed := bench_run_once(it, &b, n)
+			ns_per_op = f64(time.duration_nanoseconds(elapsed)) / f64(n)
+		}
+
+		full_name := fmt.tprintf("%s.%s", it.pkg, it.name)
+		if b._failed {
+			fmt.printfln("%-*s  FAILED", name_width, full_name)
+			failures += 1
+			continue
+		}
+
+		slice.sort(rounds)
+		result := Bench_JSON_Result{
+			pkg           = it.pkg,
+			name          = it.name,
+			iterations    = n,
+			ns_per_op     = rounds[len(rounds)/2],
+			min_ns_per_op = rounds[0],
+		}
+		if b.bytes > 0 && result.ns_per_op > 0 {
+			result.mb_per_s = f64(b.bytes) * 1e3 / result.ns_per_op
+		}
+		append(&report.benchmarks, result)
+
+		// NOTE: integers and floats are zero padded by a width, so they are padded as strings instead
+		fmt.printf("%-*s  %12s  %14s ns/op  (min %.2f)", name_width, full_name,
+		           fmt.tprint(n), fmt.tprintf("%.2f", result.ns_per_op), result.min_ns_per_op)
+		if result.mb_per_s > 0 {
+			fmt.printf("  %.2f MB/s", result.mb_per_s)
+		}
+
+		for old in baseline.benchmarks {
+			if old.pkg != it.pkg || old.name != it.name || old.ns_per_op <= 0 {
+				continue
+			}
+			change := (result.ns_per_op - old.ns_per_op) / old.ns_per_op * 100
+			fmt.printf("  %+.1f%%", change)
+			if change > f64(BENCH_THRESHOLD) {
+				fmt.print(" REGRESSION")
+				regressions += 1
+			}
+			break
+		}
+		fmt.println()
+	}
+
+	when BENCH_JSON_REPORT != "" {
+		json_fd, err := os.open(BENCH_JSON_REPORT, {.Write, .Create, .Trunc}, {.Read_User, .Write_User, .Read_Group, .Read_Other})
+		fmt.assertf(err == nil, "unable to open file %q for writing of JSON report, error: %v", BENCH_JSON_REPORT, err)
+		defer os.close(json_fd)
+
+		json_err := json.marshal_to_writer(os.to_stream(json_fd), report, &{ pretty = true })
+		fmt.assertf(json_err == nil, "Error writing JSON report: %v", json_err)
+	}
+
+	if regressions > 0 {
+		fmt.printfln("%i benchmark%s regressed by more than %i%% against %s.", regressions, "" if regressions == 1 else "s", BENCH_THRESHOLD, BENCH_BASELINE)
+	}
+	return regressions == 0 && failures == 0
+}
@@ -40,5 +40,27 @@ Defineables through `#config`:
 	// Print the full file path for failed test cases on a new line
 	// in a way that's friendly to regex capture for an editor's "go to error".
 	GO_TO_ERROR           : bool   : #config(ODIN_TEST_GO_TO_ERROR,          false)
+
+`odin bench` runs the procedures with the attribute `@(benchmark)` instead, one at a time, see `B`.
+It is configured with these defineables:
+
+	// Select a specific set of benchmarks to run by name, in the same format as `ODIN_TEST_NAMES`.
+	BENCH_NAMES           : string : #config(ODIN_BENCH_NAMES,               "")
+	// How long each benchmark is run before it is measured, in milliseconds.
+	BENCH_WARMUP_MS       : int    : #config(ODIN_BENCH_WARMUP_MS,           100)
+	// How long each measured round of a benchmark should take at least, in milliseconds.
+	BENCH_ROUND_MS        : int    : #config(ODIN_BENCH_ROUND_MS,            100)
+	// How many rounds each benchmark is measured for, the median and the fastest of them are reported.
+	BENCH_ROUNDS          : int    : #config(ODIN_BENCH_ROUNDS,              5)
+	// Run every round for exactly this many iterations, rather than picking the count from `ODIN_BENCH_ROUND_MS`.
+	BENCH_ITERATIONS      : int    : #config(ODIN_BENCH_ITERATIONS,          0)
+	// Pin the benchmarks to this CPU, where supported. -1 leaves the scheduling to the OS.
+	BENCH_CPU             : int    : #config(ODIN_BENCH_CPU,                 -1)
+	// Output the results of the benchmarks to the given path.
+	BENCH_JSON_REPORT     : string : #config(ODIN_BENCH_JSON_REPORT,         "")
+	// Compare the results against a JSON report of a previous run, and fail if any benchmark got slower.
+	BENCH_BASELINE        : string : #config(ODIN_BENCH_BASELINE,            "")
+	// How many percent slower than the baseline a benchmark may be before it counts as a regression.
+	BENCH_THRESHOLD       : int    : #config(ODIN_BENCH_THRESHOLD,           5)
 */
 package testing
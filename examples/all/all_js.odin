@@ -111,6 +111,7 @@ package all
 
 @(require) import "core:odin/ast"
 @(require) import doc_format "core:odin/doc-format"
+@(require) import symbol_index "core:odin/symbol-index"
 
 @(require) import "core:odin/tokenizer"
 @(require) import "core:path/slashpath"
@@ -119,6 +119,7 @@ package all
 @(require) import "core:odin/ast"
 @(require) import doc_format "core:odin/doc-format"
 @(require) import "core:odin/parser"
+@(require) import symbol_index "core:odin/symbol-index"
 @(require) import "core:odin/tokenizer"
 
 @(require) import "core:prof/spall"
@@ -57,6 +57,38 @@ gb_internal void array_sort(Array<T> &array, gbCompareProc compare_proc) {
 }
 
 
+// NOTE: An `Array<T>` whose first `N` elements are stored inline (usually on the stack) and
+// which only spills to `allocator` once it grows past that. The allocator must be an arena
+// style allocator (e.g. `temporary_allocator()`) since the inline storage is never freed
+// through it. `InlineArray` cannot be copied, but `.array` can be passed anywhere an
+// `Array<T>` is expected as long as it does not outlive the `InlineArray` itself.
+template <typename T, isize N>
+struct InlineArray {
+	T        inline_data[N];
+	Array<T> array;
+
+	InlineArray(gbAllocator const &a, isize count=0, isize capacity=0) {
+		capacity = gb_max(capacity, count);
+		if (capacity <= N) {
+			gb_zero_size(inline_data, gb_size_of(T)*count);
+			array = array_make_from_ptr(inline_data, count, N);
+			array.allocator = a;
+		} else {
+			array = array_make<T>(a, count, capacity);
+		}
+	}
+	InlineArray(InlineArray const &) = delete;
+	InlineArray &operator=(InlineArray const &) = delete;
+
+	T &operator[](isize index) {
+		return array[index];
+	}
+	T const &operator[](isize index) const {
+		return array[index];
+	}
+};
+
+
 
 template <typename T>
 struct Slice {
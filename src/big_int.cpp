@@ -146,12 +146,27 @@ gb_internal i64 big_int_sign(BigInt const *x) {
 }
 
 
+// NOTE: `mp_init` reserves MP_DEFAULT_DIGIT_COUNT digits, which is far more than a 64-bit value
+// needs, and most constants are small
 gb_internal void big_int_from_u64(BigInt *dst, u64 x) {
-	mp_init_u64(dst, x);
+	mp_init_size(dst, 0);
+	mp_set_u64(dst, x);
 }
 gb_internal void big_int_from_i64(BigInt *dst, i64 x) {
-	mp_init_i64(dst, x);
+	mp_init_size(dst, 0);
+	mp_set_i64(dst, x);
+}
 
+// NOTE: returns true if `x` fits within a single digit (|x| < 2^MP_DIGIT_BIT), which allows
+// most arithmetic on two such values to be done natively within an i64
+gb_internal bool big_int_get_small(BigInt const *x, i64 *value) {
+	GB_STATIC_ASSERT(MP_DIGIT_BIT < 63);
+	if (x->used > 1) {
+		return false;
+	}
+	i64 v = x->used == 0 ? 0 : cast(i64)x->dp[0];
+	*value = x->sign == MP_NEG ? -v : v;
+	return true;
 }
 gb_internal void big_int_init(BigInt *dst, BigInt const *src) {
 	if (dst == src) {
@@ -2,6 +2,9 @@
 #include <sys/types.h>
 #include <sys/sysctl.h>
 #endif
+#if defined(GB_SYSTEM_LINUX)
+#include <sched.h>
+#endif
 #include "build_cpuid.cpp"
 
 // #if defined(GB_SYSTEM_WINDOWS)
@@ -258,6 +261,7 @@ enum TimingsExportFormat : i32 {
 	TimingsExportUnspecified = 0,
 	TimingsExportJson        = 1,
 	TimingsExportCSV         = 2,
+	TimingsExportTrace       = 3,
 };
 
 enum DependenciesExportFormat : i32 {
@@ -414,6 +418,21 @@ enum SanitizerFlags : u32 {
 	SanitizerFlag_Thread  = 1u<<2,
 };
 
+enum InstrumentationMode : u8 {
+	InstrumentationMode_Calls,     // calls to the @(instrumentation_enter) and @(instrumentation_exit) procedures
+	InstrumentationMode_Patchable, // a NOP sled at the entry of each procedure, to be patched at runtime
+};
+
+struct InstrumentationFilter {
+	String pattern; // glob matched against `package.procedure`
+	bool   exclude;
+};
+
+struct PathPrefixMap {
+	String from;
+	String to;
+};
+
 struct BuildCacheData {
 	u64 crc;
 	String cache_dir;
@@ -423,7 +442,19 @@ struct BuildCacheData {
 	String args_path;
 	String env_path;
 
+	// per module object files, keyed by the module's bitcode (see `lb_emit_object_cached`)
+	String objects_dir;
+	u64    objects_config_hash; // the arguments, environment and compiler version the objects are built with
+
 	bool copy_already_done;
+
+	// remote cache, shared between machines (see `cached.cpp`)
+	String remote_url;    // -internal-cache-remote:<url> or ODIN_CACHE_REMOTE
+	String remote_header; // ODIN_CACHE_REMOTE_HEADER, e.g. "Authorization: Bearer <token>"
+	String remote_name;   // content addressed name of the executable within the remote cache
+	bool   remote_read_only;
+	bool   remote_hit;
+	bool   remote_disabled; // the configuration is invalid, see `cache_remote_init`
 };
 
 
@@ -431,6 +462,25 @@ enum LTOKind : i32 {
 	LTO_None,
 	LTO_Thin,
 	LTO_Thin_Files,
+	LTO_Full,
+};
+
+enum ISelKind : u8 {
+	ISel_Default, // FastISel when not optimizing, SelectionDAG otherwise
+	ISel_Fast,
+	ISel_Global,  // GlobalISel, falling back to SelectionDAG per procedure
+};
+
+enum DebugCompressionKind : u8 {
+	DebugCompression_None,
+	DebugCompression_Zlib,
+	DebugCompression_Zstd,
+};
+
+enum PGOKind : i32 {
+	PGO_None,
+	PGO_Generate,
+	PGO_Use,
 };
 
 enum LinkerChoice : i32 {
@@ -476,6 +526,9 @@ struct BuildContext {
 	String ODIN_BUILD_PROJECT_NAME;           // Odin main/initial package's directory name
 	Windows_Subsystem ODIN_WINDOWS_SUBSYSTEM; // .Console, .Windows
 	bool   ODIN_DEBUG;                        // Odin in debug mode
+	bool   debug_line_tables;                 // -debug:lines, only line tables and without ODIN_DEBUG
+	bool   debug_split;                       // Move the debug info into a separate file after linking
+	DebugCompressionKind debug_compression;   // Compress the debug sections of the linked output
 	bool   ODIN_DISABLE_ASSERT;               // Whether the default 'assert' et al is disabled in code or not
 	bool   ODIN_DEFAULT_TO_NIL_ALLOCATOR;     // Whether the default allocator is a "nil" allocator or not (i.e. it does nothing)
 	bool   ODIN_DEFAULT_TO_PANIC_ALLOCATOR;   // Whether the default allocator is a "panic" allocator or not (i.e. panics on any call to it)
@@ -508,6 +561,16 @@ struct BuildContext {
 
 	u64 vet_flags;
 	u32 sanitizer_flags;
+
+	InstrumentationMode          instrumentation_mode;
+	Array<InstrumentationFilter> instrumentation_filters;
+
+	bool                 deterministic;
+	bool                 jit; // `odin run -jit`, runs the program in-process instead of linking an executable
+	Array<PathPrefixMap> path_prefix_maps; // -path-prefix-map:<old>=<new>, the last matching one is used
+	i64                          instrumentation_min_size; // in LLVM instructions
+	bool                         instrument_allocations;
+	String                       allocation_sites_file;
 	StringSet vet_packages;
 
 	bool   has_resource;
@@ -525,10 +588,22 @@ struct BuildContext {
 	String export_timings_file;
 	DependenciesExportFormat export_dependencies_format;
 	String export_dependencies_file;
+	String export_symbol_index_file;
+	String exported_symbols_file;
 	bool   show_unused;
 	bool   show_unused_with_location;
+	String check_file; // -check-file:<filename>, full path
 	bool   show_more_timings;
+	bool   show_perf_counters;
+	bool   show_stats;
+	bool   show_lock_contention;
 	bool   show_defineables;
+	bool   show_unroll_report;
+	bool   show_global_init_report;
+	bool   show_code_size;
+	bool   show_stack_usage;
+	bool   wasm_opt;
+	i64    unroll_budget;
 	String export_defineables_file;
 	bool   ignore_unused_defineables;
 	bool   show_system_calls;
@@ -565,8 +640,9 @@ struct BuildContext {
 	bool   json_errors;
 	bool   has_ansi_terminal_colours;
 
-	bool   fast_isel;
+	ISelKind isel_kind;
 	bool   ignore_lazy;
+	bool   ast_stats;
 	bool   ignore_llvm_build;
 	bool   ignore_panic;
 
@@ -575,10 +651,24 @@ struct BuildContext {
 
 	bool   build_diagnostics;
 
+	Array<String> multiple_targets;           // -target:a,b,c, each is built by its own `odin` subprocess
+	String output_suffix;                     // -internal-output-suffix, set for each of those subprocesses
+
 	bool   use_single_module;
 	bool   use_separate_modules;
 	LTOKind lto_kind;
+	PGOKind pgo_kind;
+	String  pgo_profile_path;
+	String  opt_remarks;
+	String  opt_remarks_file;
+	bool    post_link_optimize;
+	String  symbol_ordering_file;
 	bool   module_per_file;
+	bool   partition_modules;
+	bool   link_into_single_module;
+	bool   emit_to_memory;
+	bool   proc_cost_report;
+	bool   polymorphic_report;
 	bool   cached;
 	BuildCacheData build_cache_data;
 
@@ -587,6 +677,7 @@ struct BuildContext {
 	bool internal_weak_monomorphization;
 	bool internal_ignore_llvm_verification;
 	bool internal_llvm_no_sroa;
+	bool internal_odin_abi_registers;
 
 	bool   enable_rvo;
 
@@ -599,6 +690,7 @@ struct BuildContext {
 	bool   copy_file_contents;
 
 	bool   no_rtti;
+	bool   rtti_minimal;
 
 	bool   dynamic_map_calls;
 
@@ -616,6 +708,7 @@ struct BuildContext {
 	bool   disable_red_zone;
 	bool   disable_unwind;
 	bool   no_plt;
+	bool   profile_friendly;
 
 	isize max_error_count;
 
@@ -628,9 +721,14 @@ struct BuildContext {
 	Array<String> extra_packages;
 
 	bool      test_all_packages;
+	bool      test_shards;
+	bool      benchmark; // `odin bench`, which is `odin test` running the @(benchmark) procedures instead
 
-	gbAffinity affinity;
-	isize      thread_count;
+	gbAffinity   affinity;
+	isize        thread_count;
+	char const * thread_count_reason;
+	i64          max_memory; // in bytes, 0 means no limit on the memory of the LLVM module tasks
+	bool         pin_threads;
 
 	PtrMap<char const *, ExactValue> defined_values;
 
@@ -663,6 +761,11 @@ gb_internal bool IS_ODIN_DEBUG(void) {
 	return build_context.ODIN_DEBUG;
 }
 
+// NOTE: true for both -debug and -debug:lines, whereas ODIN_DEBUG is only set by the former
+gb_internal bool build_has_debug_info(void) {
+	return build_context.ODIN_DEBUG || build_context.debug_line_tables;
+}
+
 
 gb_internal bool global_warnings_as_errors(void) {
 	return build_context.warnings_as_errors;
@@ -1395,8 +1498,8 @@ gb_internal String internal_odin_root_dir(void) {
 gb_global BlockingMutex fullpath_mutex;
 
 #if defined(GB_SYSTEM_WINDOWS)
-gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
-	String result = {};
+gb_internal InternedString internal_path_to_fullpath(String s, bool *ok_) {
+	InternedString result = {};
 
 	String16 string16 = string_to_string16(heap_allocator(), s);
 	defer (gb_free(heap_allocator(), string16.text));
@@ -1407,20 +1510,24 @@ gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
 
 	len = GetFullPathNameW(cast(wchar_t *)&string16[0], 0, nullptr, nullptr);
 	if (len != 0) {
-		wchar_t *text = permanent_alloc_array<wchar_t>(len+1);
+		wchar_t *text = gb_alloc_array(heap_allocator(), wchar_t, len+1);
+		defer (gb_free(heap_allocator(), text));
 		GetFullPathNameW(cast(wchar_t *)&string16[0], len, text, nullptr);
 		mutex_unlock(&fullpath_mutex);
 
 		text[len] = 0;
-		result = string16_to_string(a, make_string16(cast(u16 *)text, len));
-		result = string_trim_whitespace(result);
+		String path = string16_to_string(heap_allocator(), make_string16(cast(u16 *)text, len));
+		defer (gb_free(heap_allocator(), path.text));
+
+		String trimmed = string_trim_whitespace(path);
 
 		// Replace Windows style separators
-		for (isize i = 0; i < result.len; i++) {
-			if (result.text[i] == '\\') {
-				result.text[i] = '/';
+		for (isize i = 0; i < trimmed.len; i++) {
+			if (trimmed.text[i] == '\\') {
+				trimmed.text[i] = '/';
 			}
 		}
+		result = string_interner_insert(trimmed);
 		if (ok_) *ok_ = true;
 	} else {
 		if (ok_) *ok_ = false;
@@ -1430,21 +1537,7 @@ gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
 	return result;
 }
 #elif defined(GB_SYSTEM_OSX) || defined(GB_SYSTEM_UNIX)
-
-struct PathToFullpathResult {
-	String result;
-	bool   ok;
-};
-
-gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
-	static gb_thread_local StringMap<PathToFullpathResult> cache;
-
-	PathToFullpathResult *cached = string_map_get(&cache, s);
-	if (cached != nullptr) {
-		if (ok_) *ok_ = cached->ok;
-		return copy_string(a, cached->result);
-	}
-
+gb_internal InternedString internal_path_to_fullpath(String s, bool *ok_) {
 	char *p;
 	p = realpath(cast(char *)s.text, 0);
 	defer (free(p));
@@ -1460,31 +1553,55 @@ gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
 		//
 		// I have opted for 2 because it is much simpler + we already return `ok = false` + further
 		// checks and processes will use the path and cause errors (which we want).
-		String result = copy_string(a, s);
-
-		PathToFullpathResult cached_result = {};
-		cached_result.result = copy_string(permanent_allocator(), result);
-		cached_result.ok     = false;
-		string_map_set(&cache, copy_string(permanent_allocator(), s), cached_result);
-
-		return result;
+		return string_interner_insert(s);
 	}
 	if (ok_) *ok_ = true;
-	String result = copy_string(a, make_string_c(p));
-
-	PathToFullpathResult cached_result = {};
-	cached_result.result = copy_string(permanent_allocator(), result);
-	cached_result.ok     = true;
-	string_map_set(&cache, copy_string(permanent_allocator(), s), cached_result);
-
-	return result;
+	return string_interner_insert(make_string_c(p));
 }
 #else
 #error Implement system
 #endif
 
+struct PathToFullpathResult {
+	InternedString result;
+	bool           ok;
+};
 
-gb_internal String get_fullpath_relative(gbAllocator a, String base_dir, String path, bool *ok_) {
+// NOTE: Shared between all threads so that each distinct path is only ever
+// normalized once; both the keys and the results live in the string interner.
+gb_global RwMutex                          fullpath_cache_mutex;
+gb_global StringMap<PathToFullpathResult>  fullpath_cache;
+
+// NOTE: The returned string is interned (and NUL terminated) and must never be freed.
+gb_internal String path_to_fullpath_interned(String s, bool *ok_) {
+	rw_mutex_shared_lock(&fullpath_cache_mutex);
+	PathToFullpathResult *cached = string_map_get(&fullpath_cache, s);
+	if (cached != nullptr) {
+		PathToFullpathResult found = *cached;
+		rw_mutex_shared_unlock(&fullpath_cache_mutex);
+
+		if (ok_) *ok_ = found.ok;
+		return found.result.string();
+	}
+	rw_mutex_shared_unlock(&fullpath_cache_mutex);
+
+	PathToFullpathResult result = {};
+	result.result = internal_path_to_fullpath(s, &result.ok);
+
+	rw_mutex_lock(&fullpath_cache_mutex);
+	string_map_set(&fullpath_cache, string_interner_insert(s).string(), result);
+	rw_mutex_unlock(&fullpath_cache_mutex);
+
+	if (ok_) *ok_ = result.ok;
+	return result.result.string();
+}
+
+gb_internal String path_to_fullpath(gbAllocator a, String s, bool *ok_) {
+	return copy_string(a, path_to_fullpath_interned(s, ok_));
+}
+
+
+gb_internal String get_fullpath_relative_interned(String base_dir, String path, bool *ok_) {
 	u8 *str = gb_alloc_array(heap_allocator(), u8, base_dir.len+1+path.len+1);
 	defer (gb_free(heap_allocator(), str));
 
@@ -1506,7 +1623,11 @@ gb_internal String get_fullpath_relative(gbAllocator a, String base_dir, String
 
 	String res = make_string(str, i);
 	res = string_trim_whitespace(res);
-	return path_to_fullpath(a, res, ok_);
+	return path_to_fullpath_interned(res, ok_);
+}
+
+gb_internal String get_fullpath_relative(gbAllocator a, String base_dir, String path, bool *ok_) {
+	return copy_string(a, get_fullpath_relative_interned(base_dir, path, ok_));
 }
 
 
@@ -1742,18 +1863,213 @@ gb_internal void init_build_context_error_pos_style() {
 	}
 }
 
+gb_internal void add_path_prefix_map(String from, String to) {
+	while (from.len > 1 && (from[from.len-1] == '/' || from[from.len-1] == '\\')) {
+		from.len -= 1;
+	}
+	if (build_context.path_prefix_maps.allocator.proc == nullptr) {
+		array_init(&build_context.path_prefix_maps, heap_allocator());
+	}
+	array_add(&build_context.path_prefix_maps, PathPrefixMap{from, to});
+}
+
+// NOTE: Applied to every path which ends up in the output (source code locations, `#file`, debug info),
+// so that the output does not depend upon where the sources were checked out
+gb_internal String remap_path_prefix(String const &path) {
+	auto const &maps = build_context.path_prefix_maps;
+	for (isize i = maps.count-1; i >= 0; i--) {
+		String from = maps[i].from;
+		if (from.len == 0 || path.len < from.len) {
+			continue;
+		}
+		bool match = true;
+		for (isize j = 0; j < from.len; j++) {
+			u8 a = path[j] == '\\' ? '/' : path[j];
+			u8 b = from[j] == '\\' ? '/' : from[j];
+			if (a != b) {
+				match = false;
+				break;
+			}
+		}
+		if (!match || (path.len > from.len && path[from.len] != '/' && path[from.len] != '\\')) {
+			continue;
+		}
+		return concatenate_strings(permanent_allocator(), maps[i].to, substring(path, from.len, path.len));
+	}
+	return path;
+}
+
+#if defined(GB_SYSTEM_LINUX)
+// NOTE: Returns the number of CPUs allowed by a CFS quota, or 0 if there is no limit
+gb_internal isize linux_cpu_quota_from_files(char const *max_path, char const *period_path) {
+	FILE *f = fopen(max_path, "r");
+	if (f == nullptr) {
+		return 0;
+	}
+	char quota[32] = {};
+	long long period = 0;
+	int n = 0;
+	if (period_path == nullptr) {
+		// cgroup v2: "cpu.max" is "<quota|max> <period>"
+		n = fscanf(f, "%31s %lld", quota, &period);
+	} else {
+		// cgroup v1: the quota and the period are separate files, and no limit is -1
+		n = fscanf(f, "%31s", quota);
+	}
+	fclose(f);
+	if (n < 1) {
+		return 0;
+	}
+	if (period_path != nullptr) {
+		f = fopen(period_path, "r");
+		if (f == nullptr) {
+			return 0;
+		}
+		n = fscanf(f, "%lld", &period);
+		fclose(f);
+		if (n < 1) {
+			return 0;
+		}
+	}
+	if (gb_strcmp(quota, "max") == 0) {
+		return 0;
+	}
+	long long q = atoll(quota);
+	if (q <= 0 || period <= 0) {
+		return 0;
+	}
+	return cast(isize)gb_max((q + period - 1) / period, 1);
+}
+
+gb_internal isize linux_cgroup_cpu_quota(void) {
+	// cgroup v2: walk up from the cgroup of this process, as a limit on any ancestor applies too
+	FILE *f = fopen("/proc/self/cgroup", "r");
+	if (f != nullptr) {
+		char line[1024] = {};
+		char group[1024] = {};
+		while (fgets(line, gb_size_of(line), f)) {
+			if (line[0] == '0' && line[1] == ':' && line[2] == ':') {
+				gb_strncpy(group, line+3, gb_size_of(group)-1);
+				isize len = gb_strlen(group);
+				while (len > 0 && (group[len-1] == '\n' || group[len-1] == '/')) {
+					group[--len] = 0;
+				}
+				break;
+			}
+		}
+		fclose(f);
+
+		isize min_quota = 0;
+		for (;;) {
+			char path[1100] = {};
+			gb_snprintf(path, gb_size_of(path), "/sys/fs/cgroup%s/cpu.max", group);
+			isize quota = linux_cpu_quota_from_files(path, nullptr);
+			if (quota > 0 && (min_quota == 0 || quota < min_quota)) {
+				min_quota = quota;
+			}
+			char *slash = cast(char *)gb_char_last_occurence(group, '/');
+			if (slash == nullptr) {
+				break;
+			}
+			*slash = 0;
+		}
+		if (min_quota > 0) {
+			return min_quota;
+		}
+	}
+
+	// cgroup v1: inside a container the cpu controller is mounted at the cgroup of the process
+	char const *v1_dirs[] = {"/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct"};
+	for (char const *dir : v1_dirs) {
+		char quota_path[64] = {};
+		char period_path[64] = {};
+		gb_snprintf(quota_path,  gb_size_of(quota_path),  "%s/cpu.cfs_quota_us",  dir);
+		gb_snprintf(period_path, gb_size_of(period_path), "%s/cpu.cfs_period_us", dir);
+		isize quota = linux_cpu_quota_from_files(quota_path, period_path);
+		if (quota > 0) {
+			return quota;
+		}
+	}
+	return 0;
+}
+#endif
+
+// NOTE: The default number of threads, which accounts for the CPUs this process may actually use
+// rather than every core on the host, e.g. inside a container limited by a cgroup CPU quota.
+gb_internal isize default_thread_count(gbAffinity *a, char const **reason) {
+	isize count = gb_max(a->thread_count, 1);
+	*reason = "all cores";
+
+#if defined(GB_SYSTEM_LINUX)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, gb_size_of(set), &set) == 0) {
+		isize affinity_count = CPU_COUNT(&set);
+		if (affinity_count > 0 && affinity_count < count) {
+			count = affinity_count;
+			*reason = "sched_getaffinity";
+		}
+	}
+	isize quota = linux_cgroup_cpu_quota();
+	if (quota > 0 && quota < count) {
+		count = quota;
+		*reason = "cgroup cpu quota";
+	}
+#elif defined(GB_SYSTEM_WINDOWS)
+	DWORD_PTR process_mask = 0;
+	DWORD_PTR system_mask = 0;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+		isize affinity_count = 0;
+		for (DWORD_PTR m = process_mask; m != 0; m &= m-1) {
+			affinity_count += 1;
+		}
+		if (affinity_count > 0 && affinity_count < count) {
+			count = affinity_count;
+			*reason = "process affinity mask";
+		}
+	}
+	JOBOBJECT_CPU_RATE_CONTROL_INFORMATION rate = {};
+	if (QueryInformationJobObject(nullptr, JobObjectCpuRateControlInformation, &rate, gb_size_of(rate), nullptr) &&
+	    (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_ENABLE) &&
+	    (rate.ControlFlags & JOB_OBJECT_CPU_RATE_CONTROL_HARD_CAP)) {
+		// NOTE: the rate is in 1/100ths of a percent of all of the processors on the system
+		isize job_count = gb_max((cast(isize)rate.CpuRate * a->thread_count + 9999) / 10000, 1);
+		if (job_count < count) {
+			count = job_count;
+			*reason = "job object cpu rate";
+		}
+	}
+#endif
+
+	return count;
+}
+
 gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subtarget) {
 	BuildContext *bc = &build_context;
 
 	gb_affinity_init(&bc->affinity);
 	if (bc->thread_count == 0) {
-		bc->thread_count = gb_max(bc->affinity.thread_count, 1);
+		bc->thread_count = default_thread_count(&bc->affinity, &bc->thread_count_reason);
+	} else {
+		bc->thread_count_reason = "-thread-count";
 	}
 
 	bc->ODIN_VENDOR  = str_lit("odin");
 	bc->ODIN_VERSION = ODIN_VERSION;
 	bc->ODIN_ROOT    = odin_root_dir();
 
+	if (bc->deterministic) {
+		// NOTE: Placed before any explicit -path-prefix-map so that those take precedence
+		auto explicit_maps = bc->path_prefix_maps;
+		bc->path_prefix_maps = {};
+		add_path_prefix_map(bc->ODIN_ROOT, str_lit("odin"));
+		add_path_prefix_map(get_working_directory(permanent_allocator()), str_lit("."));
+		for (PathPrefixMap const &m : explicit_maps) {
+			array_add(&bc->path_prefix_maps, m);
+		}
+		array_free(&explicit_maps);
+	}
+
 	if (bc->max_error_count <= 0) {
 		bc->max_error_count = DEFAULT_MAX_ERROR_COLLECTOR_COUNT;
 	}
@@ -1847,6 +2163,11 @@ gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subta
 	bc->threaded_checker = true;
 	#endif
 
+	if (bc->wasm_opt && !is_arch_wasm()) {
+		gb_printf_err("-wasm-opt is only supported on wasm targets\n");
+		gb_exit(1);
+	}
+
 	if (bc->disable_red_zone) {
 		if (is_arch_wasm() && bc->metrics.os == TargetOs_freestanding) {
 			gb_printf_err("-disable-red-zone is not supported on this target");
@@ -2071,6 +2392,8 @@ gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subta
 		// default to `-o:none` to improve the debug symbol generation by default
 		if (bc->ODIN_DEBUG) {
 			bc->optimization_level = -1; // -o:none
+		} else if (bc->benchmark) {
+			bc->optimization_level = 2; // -o:speed
 		} else {
 			bc->optimization_level = 0; // -o:minimal
 		}
@@ -2088,23 +2411,43 @@ gb_internal void init_build_context(TargetMetrics *cross_target, Subtarget subta
 		bc->use_separate_modules = false;
 	}
 
-	if (bc->lto_kind == LTO_Thin || bc->lto_kind == LTO_Thin_Files) {
+	if (bc->opt_remarks_file.len != 0 && bc->opt_remarks.len == 0) {
+		gb_printf_err("-opt-remarks-file requires -opt-remarks\n");
+		gb_exit(1);
+	}
+
+	if (bc->allocation_sites_file.len != 0 && !bc->instrument_allocations) {
+		gb_printf_err("-allocation-sites-file requires -instrument-allocations\n");
+		gb_exit(1);
+	}
+
+	if (bc->link_into_single_module) {
+		if (bc->lto_kind != LTO_None || bc->jit || bc->cached) {
+			gb_printf_err("-internal-link-single-module cannot be used with -lto, -jit or -internal-cached\n");
+			gb_exit(1);
+		}
+		if (bc->use_single_module) {
+			bc->link_into_single_module = false;
+		}
+	}
+
+	if (bc->lto_kind != LTO_None) {
 #if LLVM_VERSION_MAJOR < 17
-		gb_printf_err("-lto:thin requires LLVM 17 or later\n");
+		gb_printf_err("-lto requires LLVM 17 or later\n");
 		gb_exit(1);
 #endif
 		if (bc->build_mode == BuildMode_Assembly || bc->build_mode == BuildMode_LLVM_IR) {
-			gb_printf_err("-lto:thin is incompatible with -build-mode:asm and -build-mode:llvm-ir\n");
+			gb_printf_err("-lto is incompatible with -build-mode:asm and -build-mode:llvm-ir\n");
 			gb_exit(1);
 		}
 #if defined(GB_SYSTEM_WINDOWS)
 		if (bc->linker_choice != Linker_lld) {
-			gb_printf_err("-lto:thin on Windows requires -linker:lld\n");
+			gb_printf_err("-lto on Windows requires -linker:lld\n");
 			gb_exit(1);
 		}
 #endif
 		if (bc->use_single_module) {
-			gb_printf_err("Warning: -lto:thin overrides -use-single-module; separate modules will be used\n");
+			gb_printf_err("Warning: -lto overrides -use-single-module; separate modules will be used\n");
 		}
 		bc->use_separate_modules = true;
 		if (bc->lto_kind == LTO_Thin_Files) {
@@ -2193,6 +2536,130 @@ gb_internal bool check_target_feature_is_valid_globally(String const &feature, S
 	return true;
 }
 
+// NOTE: The CPUID (and XCR0) registers checked at run time by the dispatcher of a @(target_clones="...") procedure
+enum TargetCloneReg : u8 {
+	TargetCloneReg_Leaf1_ECX,
+	TargetCloneReg_Leaf1_EDX,
+	TargetCloneReg_Leaf7_EBX,
+	TargetCloneReg_Leaf7_ECX,
+	TargetCloneReg_Ext1_ECX, // leaf 0x80000001
+	TargetCloneReg_XCR0,
+
+	TargetCloneReg_COUNT,
+};
+
+struct TargetCloneFeatureBit {
+	char const *    name;
+	TargetCloneReg  reg;
+	u8              bit;
+	u8              xcr0;    // the register state the OS must save, for the VEX and EVEX encoded vector features
+	char const *    implies; // the features LLVM enables along with this one, which must be checked too
+};
+
+// NOTE: bmi and bmi2 are VEX encoded but only use general purpose registers, so they work regardless of XCR0
+gb_global TargetCloneFeatureBit const target_clone_amd64_feature_bits[] = {
+	{"sse3",     TargetCloneReg_Leaf1_ECX,  0, 0x00, nullptr},
+	{"ssse3",    TargetCloneReg_Leaf1_ECX,  9, 0x00, "sse3"},
+	{"fma",      TargetCloneReg_Leaf1_ECX, 12, 0x06, "avx"},
+	{"cx16",     TargetCloneReg_Leaf1_ECX, 13, 0x00, nullptr},
+	{"sse4.1",   TargetCloneReg_Leaf1_ECX, 19, 0x00, "ssse3"},
+	{"sse4.2",   TargetCloneReg_Leaf1_ECX, 20, 0x00, "sse4.1"},
+	{"movbe",    TargetCloneReg_Leaf1_ECX, 22, 0x00, nullptr},
+	{"popcnt",   TargetCloneReg_Leaf1_ECX, 23, 0x00, nullptr},
+	{"xsave",    TargetCloneReg_Leaf1_ECX, 26, 0x00, nullptr},
+	{"avx",      TargetCloneReg_Leaf1_ECX, 28, 0x06, "sse4.2"},
+	{"f16c",     TargetCloneReg_Leaf1_ECX, 29, 0x06, "avx"},
+	{"bmi",      TargetCloneReg_Leaf7_EBX,  3, 0x00, nullptr},
+	{"avx2",     TargetCloneReg_Leaf7_EBX,  5, 0x06, "avx"},
+	{"bmi2",     TargetCloneReg_Leaf7_EBX,  8, 0x00, nullptr},
+	{"avx512f",  TargetCloneReg_Leaf7_EBX, 16, 0xe6, "avx2,fma,f16c"},
+	{"avx512dq", TargetCloneReg_Leaf7_EBX, 17, 0xe6, "avx512f"},
+	{"avx512cd", TargetCloneReg_Leaf7_EBX, 28, 0xe6, "avx512f"},
+	{"avx512bw", TargetCloneReg_Leaf7_EBX, 30, 0xe6, "avx512f"},
+	{"avx512vl", TargetCloneReg_Leaf7_EBX, 31, 0xe6, "avx512f"},
+	{"sahf",     TargetCloneReg_Ext1_ECX,   0, 0x00, nullptr},
+	{"lzcnt",    TargetCloneReg_Ext1_ECX,   5, 0x00, nullptr},
+};
+
+gb_global String const target_clone_amd64_levels[][2] = {
+	{str_lit("x86-64-v2"), str_lit("cx16,sahf,popcnt,sse3,sse4.1,sse4.2,ssse3")},
+	{str_lit("x86-64-v3"), str_lit("cx16,sahf,popcnt,sse3,sse4.1,sse4.2,ssse3,avx,avx2,bmi,bmi2,f16c,fma,lzcnt,movbe,xsave")},
+	{str_lit("x86-64-v4"), str_lit("cx16,sahf,popcnt,sse3,sse4.1,sse4.2,ssse3,avx,avx2,bmi,bmi2,f16c,fma,lzcnt,movbe,xsave,avx512f,avx512bw,avx512cd,avx512dq,avx512vl")},
+};
+
+struct TargetClone {
+	String name;
+	String llvm_features; // e.g. "+avx,+avx2"
+	u32    masks[TargetCloneReg_COUNT];
+};
+
+gb_internal TargetCloneFeatureBit const *target_clone_find_feature(String const &name) {
+	for (auto const &f : target_clone_amd64_feature_bits) {
+		if (name == make_string_c(f.name)) {
+			return &f;
+		}
+	}
+	return nullptr;
+}
+
+gb_internal void target_clone_require_feature(TargetClone *clone, TargetCloneFeatureBit const *f) {
+	clone->masks[f->reg] |= 1u<<f->bit;
+	if (f->xcr0 != 0) {
+		// NOTE: the OS must also save the YMM (and ZMM) register state, which is only readable with xgetbv
+		clone->masks[TargetCloneReg_Leaf1_ECX] |= 1u<<27; // osxsave
+		clone->masks[TargetCloneReg_XCR0] |= f->xcr0;
+	}
+	if (f->implies != nullptr) {
+		String_Iterator it = {make_string_c(f->implies), 0};
+		for (;;) {
+			String str = string_split_iterator(&it, ',');
+			if (str == "") break;
+			TargetCloneFeatureBit const *implied = target_clone_find_feature(str);
+			GB_ASSERT(implied != nullptr);
+			target_clone_require_feature(clone, implied);
+		}
+	}
+}
+
+// NOTE: A target is either an x86-64 micro-architecture level or a '+' separated list of features, e.g. "avx2+fma"
+gb_internal bool target_clone_parse(String const &target, TargetClone *clone_, String *invalid) {
+	TargetClone clone = {};
+	clone.name = target;
+
+	String features = target;
+	for (auto const &level : target_clone_amd64_levels) {
+		if (target == level[0]) {
+			features = level[1];
+			break;
+		}
+	}
+
+	gbString llvm_features = gb_string_make(permanent_allocator(), "");
+	char sep = features == target ? '+' : ',';
+	String_Iterator it = {features, 0};
+	for (;;) {
+		String str = string_split_iterator(&it, sep);
+		if (str == "") break;
+
+		TargetCloneFeatureBit const *found = target_clone_find_feature(str);
+		if (found == nullptr) {
+			if (invalid) *invalid = str;
+			return false;
+		}
+		target_clone_require_feature(&clone, found);
+
+		if (gb_string_length(llvm_features) != 0) {
+			llvm_features = gb_string_appendc(llvm_features, ",");
+		}
+		llvm_features = gb_string_appendc(llvm_features, "+");
+		llvm_features = gb_string_append_length(llvm_features, str.text, str.len);
+	}
+
+	clone.llvm_features = make_string_c(llvm_features);
+	if (clone_) *clone_ = clone;
+	return true;
+}
+
 gb_internal bool check_target_feature_is_valid_for_target_arch(String const &feature, String *invalid) {
 	return check_target_feature_is_valid(feature, build_context.metrics.arch, invalid);
 }
@@ -2317,7 +2784,7 @@ gb_internal bool init_build_paths(String init_filename) {
 
 		if ((bc->command_kind & Command__does_build) && (!bc->ignore_microsoft_magic)) {
 			// NOTE(ic): It would be nice to extend this so that we could specify the Visual Studio version that we want instead of defaulting to the latest.
-			Find_Result find_result = find_visual_studio_and_windows_sdk();
+			Find_Result find_result = find_visual_studio_and_windows_sdk_cached();
 
 			if (find_result.windows_sdk_version == 0) {
 				gb_printf_err("Windows SDK not found.\n");
@@ -2440,7 +2907,7 @@ gb_internal bool init_build_paths(String init_filename) {
 			if (output_is_directory) {
 				gb_printf_err("Output path %.*s is a directory.\n", LIT(output_file));
 				return false;
-			} else if (bc->build_paths[BuildPath_Output].ext.len == 0) {
+			} else if (bc->build_paths[BuildPath_Output].ext.len == 0 && bc->output_suffix.len == 0) {
 				gb_printf_err("Output path %.*s must have an appropriate extension.\n", LIT(output_file));
 				return false;
 			}
@@ -2525,7 +2992,16 @@ gb_internal bool init_build_paths(String init_filename) {
 		bc->build_paths[BuildPath_Output] = output_path;
 	}
 
-	if (build_context.ODIN_DEBUG) {
+	if (bc->output_suffix.len > 0 && !output_should_be_directory) {
+		// NOTE: Set for each target of -target:a,b,c, so that their outputs do not overwrite each other
+		Path *output_path = &bc->build_paths[BuildPath_Output];
+		output_path->name = concatenate_strings(ha, output_path->name, bc->output_suffix);
+		if (output_path->ext.len == 0) {
+			output_path->ext = copy_string(ha, output_extension);
+		}
+	}
+
+	if (build_has_debug_info()) {
 		if (build_context.metrics.os == TargetOs_windows) {
 			if (bc->pdb_filepath.len > 0) {
 				bc->build_paths[BuildPath_Symbols] = path_from_string(ha, bc->pdb_filepath);
@@ -2615,6 +3091,80 @@ gb_internal bool init_build_paths(String init_filename) {
 		}
 	}
 
+	if (build_context.debug_split) {
+		if (!build_has_debug_info()) {
+			gb_printf_err("-debug-split requires -debug\n");
+			return false;
+		}
+		switch (build_context.metrics.os) {
+		case TargetOs_linux:
+		case TargetOs_freebsd:
+		case TargetOs_openbsd:
+		case TargetOs_netbsd:
+			break;
+		default:
+			gb_printf_err("-debug-split is only supported on ELF targets, Windows already uses a separate .pdb and Darwin a separate .dSYM\n");
+			return false;
+		}
+	}
+
+	if (build_context.debug_compression != DebugCompression_None) {
+		if (!build_has_debug_info()) {
+			gb_printf_err("-compress-debug-sections requires -debug or -debug:lines\n");
+			return false;
+		}
+		switch (build_context.metrics.os) {
+		case TargetOs_linux:
+		case TargetOs_freebsd:
+		case TargetOs_openbsd:
+		case TargetOs_netbsd:
+			break;
+		default:
+			gb_printf_err("-compress-debug-sections is only supported on ELF targets\n");
+			return false;
+		}
+	}
+
+	if (build_context.pgo_kind == PGO_Generate) {
+		switch (build_context.metrics.os) {
+		case TargetOs_linux:
+		case TargetOs_darwin:
+		case TargetOs_freebsd:
+			break;
+		default:
+			gb_printf_err("-pgo:generate is only supported on Linux, Darwin, and FreeBSD\n");
+			return false;
+		}
+	}
+
+	if (build_context.post_link_optimize || build_context.symbol_ordering_file.len != 0) {
+		char const *flag = build_context.post_link_optimize ? "-post-link-optimize" : "-symbol-ordering-file";
+		bool is_elf = false;
+		switch (build_context.metrics.os) {
+		case TargetOs_linux:
+		case TargetOs_freebsd:
+		case TargetOs_openbsd:
+		case TargetOs_netbsd:
+			is_elf = !is_arch_wasm();
+			break;
+		}
+		if (!is_elf) {
+			gb_printf_err("%s is only supported on ELF targets\n", flag);
+			return false;
+		}
+		if (build_context.build_mode != BuildMode_Executable && build_context.build_mode != BuildMode_DynamicLibrary) {
+			gb_printf_err("%s is only supported with -build-mode:exe and -build-mode:dll\n", flag);
+			return false;
+		}
+	}
+
+	if (build_context.symbol_ordering_file.len != 0) {
+		if (build_context.linker_choice != Linker_lld && build_context.linker_choice != Linker_mold) {
+			gb_printf_err("-symbol-ordering-file requires -linker:lld or -linker:mold\n");
+			return false;
+		}
+	}
+
 	bool no_crt_checks_failed = false;
 	if (build_context.no_crt && !build_context.ODIN_DEFAULT_TO_NIL_ALLOCATOR && !build_context.ODIN_DEFAULT_TO_PANIC_ALLOCATOR) {
 		switch (build_context.metrics.os) {
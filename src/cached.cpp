@@ -121,18 +121,7 @@ gb_internal bool check_if_exists_directory_otherwise_create(String const &str) {
 	return false;
 #endif
 }
-gb_internal bool try_copy_executable_cache_internal(bool to_cache) {
-	String exe_name = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
-	defer (gb_free(heap_allocator(), exe_name.text));
-
-	gbString cache_name = gb_string_make(heap_allocator(), "");
-	defer (gb_string_free(cache_name));
-
-	String cache_dir = build_context.build_cache_data.cache_dir;
-
-	cache_name = gb_string_append_length(cache_name, cache_dir.text, cache_dir.len);
-	cache_name = gb_string_appendc(cache_name, "/");
-
+gb_internal gbString cache_append_executable_name(gbString cache_name) {
 	cache_name = gb_string_appendc(cache_name, "cached-exe");
 	if (selected_target_metrics) {
 		cache_name = gb_string_appendc(cache_name, "-");
@@ -144,6 +133,21 @@ gb_internal bool try_copy_executable_cache_internal(bool to_cache) {
 		cache_name = gb_string_append_length(cache_name, st.text, st.len);
 	}
 	cache_name = gb_string_appendc(cache_name, ".bin");
+	return cache_name;
+}
+
+gb_internal bool try_copy_executable_cache_internal(bool to_cache) {
+	String exe_name = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
+	defer (gb_free(heap_allocator(), exe_name.text));
+
+	gbString cache_name = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(cache_name));
+
+	String cache_dir = build_context.build_cache_data.cache_dir;
+
+	cache_name = gb_string_append_length(cache_name, cache_dir.text, cache_dir.len);
+	cache_name = gb_string_appendc(cache_name, "/");
+	cache_name = cache_append_executable_name(cache_name);
 
 	if (to_cache) {
 		return gb_file_copy(
@@ -257,8 +261,80 @@ Array<String> cache_gather_envs() {
 	return envs;
 }
 
+// NOTE: Each line of `files.manifest` is `<last write time> <size> <content hash> <path>`
+struct CacheFileEntry {
+	String     path;
+	gbFileTime last_write_time;
+	i64        size;
+	u64        content_hash;
+
+	bool       expected; // whether the compare against the values above is wanted
+	bool       matches;
+};
+
+gb_internal bool cache_file_stat(char const *path_c, gbFileTime *last_write_time_, i64 *size_) {
+	gbFile f = {};
+	if (gb_file_open(&f, path_c) != gbFileError_None) {
+		return false;
+	}
+	*size_ = gb_file_size(&f);
+	gb_file_close(&f);
+	*last_write_time_ = gb_file_last_write_time(path_c);
+	return true;
+}
+
+gb_internal u64 cache_file_content_hash(char const *path_c) {
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, path_c);
+	defer (gb_file_free_contents(&fc));
+	return xxh64(fc.data, fc.size);
+}
+
+// NOTE: Fills in the entry from the file system. If `expected` is set, this checks against
+// the recorded values instead, and only hashes the contents when the last write time differs.
+gb_internal WORKER_TASK_PROC(cache_file_entry_worker_proc) {
+	CacheFileEntry *entry = cast(CacheFileEntry *)data;
+	char const *path_c = alloc_cstring(temporary_allocator(), entry->path);
+
+	gbFileTime last_write_time = 0;
+	i64 size = 0;
+	if (!cache_file_stat(path_c, &last_write_time, &size)) {
+		entry->matches = false;
+		return 0;
+	}
+
+	if (!entry->expected) {
+		entry->last_write_time = last_write_time;
+		entry->size            = size;
+		entry->content_hash    = cache_file_content_hash(path_c);
+		entry->matches         = true;
+		return 0;
+	}
+
+	if (size != entry->size) {
+		entry->matches = false;
+	} else if (last_write_time == entry->last_write_time) {
+		entry->matches = true; // fast path: not touched since the manifest was written
+	} else {
+		entry->matches = cache_file_content_hash(path_c) == entry->content_hash;
+	}
+	return 0;
+}
+
+gb_internal void cache_process_file_entries(Slice<CacheFileEntry> entries) {
+	if (entries.count > 1 && global_thread_pool.threads.count > 1) {
+		for (CacheFileEntry &entry : entries) {
+			thread_pool_add_task(cache_file_entry_worker_proc, &entry);
+		}
+		thread_pool_wait();
+	} else {
+		for (CacheFileEntry &entry : entries) {
+			cache_file_entry_worker_proc(&entry);
+		}
+	}
+}
+
 // returns false if different, true if it is the same
-gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
+gb_internal bool try_cached_build_local(Checker *c, Array<String> const &args) {
 	TEMPORARY_ALLOCATOR_GUARD();
 
 	auto files = cache_gather_files(c);
@@ -286,6 +362,27 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 	build_context.build_cache_data.args_path  = args_path;
 	build_context.build_cache_data.env_path   = env_path;
 
+	// NOTE: Shared by every build within the output directory, an object is only reused when its whole module,
+	// and everything which affects code generation outside of the module itself, is unchanged
+	if (build_context.lto_kind == LTO_None && build_context.pgo_kind == PGO_None) {
+		String objects_dir = concatenate_strings(permanent_allocator(), base_cache_dir, str_lit("/objects"));
+		(void)check_if_exists_directory_otherwise_create(objects_dir);
+
+		u64 config_hash = xxh64(ODIN_VERSION.text, ODIN_VERSION.len);
+	#ifdef GIT_SHA
+		config_hash = xxh64(GIT_SHA, gb_strlen(GIT_SHA), config_hash);
+	#endif
+		for (String const &arg : args) {
+			String targ = string_trim_whitespace(arg);
+			config_hash = xxh64(targ.text, targ.len, config_hash);
+		}
+		for (String const &env : envs) {
+			config_hash = xxh64(env.text, env.len, config_hash);
+		}
+		build_context.build_cache_data.objects_dir         = objects_dir;
+		build_context.build_cache_data.objects_config_hash = config_hash;
+	}
+
 	if (check_if_exists_directory_otherwise_create(cache_dir)) {
 		return false;
 	}
@@ -316,6 +413,9 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 		String data = {cast(u8 *)loaded_file.data, loaded_file.size};
 		String_Iterator it = {data, 0};
 
+		auto entries = slice_make<CacheFileEntry>(heap_allocator(), files.count);
+		defer (slice_free(&entries, heap_allocator()));
+
 		isize file_count = 0;
 
 		for (; it.pos < data.len; file_count++) {
@@ -323,34 +423,44 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 			if (line.len == 0) {
 				break;
 			}
-			isize sep = string_index_byte(line, ' ');
-			if (sep < 0) {
+			if (file_count >= files.count) {
 				return false;
 			}
 
-			String timestamp_str = substring(line, 0, sep);
-			String path_str = substring(line, sep+1, line.len);
-
-			timestamp_str = string_trim_whitespace(timestamp_str);
-			path_str = string_trim_whitespace(path_str);
-
-			if (file_count >= files.count) {
-				return false;
+			String fields[3] = {};
+			for (isize i = 0; i < gb_count_of(fields); i++) {
+				isize sep = string_index_byte(line, ' ');
+				if (sep < 0) {
+					return false;
+				}
+				fields[i] = string_trim_whitespace(substring(line, 0, sep));
+				line = substring(line, sep+1, line.len);
 			}
+			String path_str = string_trim_whitespace(line);
+
 			if (files[file_count] != path_str) {
 				return false;
 			}
 
-			u64 timestamp = exact_value_to_u64(exact_value_integer_from_string(timestamp_str));
-			gbFileTime last_write_time = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path_str));
-			if (last_write_time != timestamp) {
-				return false;
-			}
+			CacheFileEntry *entry = &entries[file_count];
+			entry->path            = files[file_count];
+			entry->last_write_time = u64_from_string(fields[0]);
+			entry->size            = cast(i64)u64_from_string(fields[1]);
+			entry->content_hash    = u64_from_string(concatenate_strings(temporary_allocator(), str_lit("0x"), fields[2]));
+			entry->expected        = true;
 		}
 
 		if (file_count != files.count) {
 			return false;
 		}
+
+		cache_process_file_entries(entries);
+		for (CacheFileEntry const &entry : entries) {
+			if (!entry.matches) {
+				debugf("Cache: file changed %.*s\n", LIT(entry.path));
+				return false;
+			}
+		}
 	}
 	{
 		LoadedFile loaded_file = {};
@@ -420,6 +530,261 @@ gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
 	return try_copy_executable_from_cache();
 }
 
+// NOTE: The remote cache is shared between machines, e.g. the CI agents which all build the same commits.
+// Unlike the local cache, it is content addressed: the executable is stored under a name derived from the
+// contents of every source file, the arguments, the compiler version and the target, so a hit never needs
+// validating against the manifests.
+//
+//     http:// or https://    `GET <url>/<name>` and `PUT <url>/<name>` through `curl`, e.g. an S3-compatible bucket
+//     anything else          a directory, e.g. a network share
+//
+// `ODIN_CACHE_REMOTE_HEADER` is passed along with every HTTP request (e.g. "Authorization: Bearer <token>").
+// A read-only remote cache never has anything stored to it, e.g. for developer machines.
+gb_internal bool cache_remote_init(void) {
+	BuildCacheData *bcd = &build_context.build_cache_data;
+	gbAllocator a = permanent_allocator();
+	if (bcd->remote_disabled) {
+		return false;
+	}
+
+	if (bcd->remote_url.len == 0) {
+		char const *url = gb_get_env("ODIN_CACHE_REMOTE", a);
+		if (url) {
+			bcd->remote_url = string_trim_whitespace(make_string_c(url));
+		}
+	}
+	if (!bcd->remote_read_only) {
+		char const *read_only = gb_get_env("ODIN_CACHE_REMOTE_READ_ONLY", a);
+		if (read_only) {
+			String s = string_trim_whitespace(make_string_c(read_only));
+			bcd->remote_read_only = s.len != 0 && s != "0" && s != "false";
+		}
+	}
+	if (bcd->remote_header.len == 0) {
+		char const *header = gb_get_env("ODIN_CACHE_REMOTE_HEADER", a);
+		if (header) {
+			bcd->remote_header = string_trim_whitespace(make_string_c(header));
+		}
+	}
+	if (string_index_byte(bcd->remote_header, '\n') >= 0 || string_index_byte(bcd->remote_header, '\r') >= 0) {
+		gb_printf_err("Warning: ODIN_CACHE_REMOTE_HEADER must be a single line, the remote cache is not used\n");
+		bcd->remote_url = {};
+		bcd->remote_header = {};
+		bcd->remote_disabled = true;
+		return false;
+	}
+	while (bcd->remote_url.len > 0 && (bcd->remote_url[bcd->remote_url.len-1] == '/' || bcd->remote_url[bcd->remote_url.len-1] == '\\')) {
+		bcd->remote_url.len -= 1;
+	}
+	return bcd->remote_url.len != 0;
+}
+
+gb_internal bool cache_remote_is_http(void) {
+	String url = build_context.build_cache_data.remote_url;
+	return string_starts_with(url, str_lit("http://")) || string_starts_with(url, str_lit("https://"));
+}
+
+// NOTE: Absolute paths within the arguments (e.g. `odin build /home/ci/app -out:/home/ci/app/bin/app`) are
+// remapped like the paths of the source files, and only the replacement of a `-path-prefix-map` is kept, so
+// that the name does not depend upon where the checkout is when the paths within the output do not either
+gb_internal String cache_remote_normalize_arg(String arg) {
+	arg = string_trim_whitespace(arg);
+	if (string_starts_with(arg, str_lit("-path-prefix-map:"))) {
+		isize eq = string_index_byte(arg, '=');
+		if (eq >= 0) {
+			return substring(arg, eq, arg.len);
+		}
+		return arg;
+	}
+
+	isize value_start = 0;
+	if (arg.len > 0 && arg[0] == '-') {
+		value_start = string_index_byte(arg, ':') + 1;
+		if (value_start == 0) {
+			return arg;
+		}
+	}
+	String value = substring(arg, value_start, arg.len);
+	if (value.len == 0 || !gb_path_is_absolute(alloc_cstring(temporary_allocator(), value))) {
+		return arg;
+	}
+	return concatenate_strings(temporary_allocator(), substring(arg, 0, value_start), remap_path_prefix(value));
+}
+
+gb_internal String cache_remote_executable_name(Array<String> const &files, Array<String> const &args, Array<String> const &envs) {
+	auto entries = slice_make<CacheFileEntry>(heap_allocator(), files.count);
+	defer (slice_free(&entries, heap_allocator()));
+	for_array(i, files) {
+		entries[i].path = files[i];
+	}
+	cache_process_file_entries(entries);
+
+	u64 hash = xxh64(ODIN_VERSION.text, ODIN_VERSION.len);
+	for (CacheFileEntry const &entry : entries) {
+		// NOTE: With -path-prefix-map (or -deterministic), differently located checkouts share entries
+		String path = remap_path_prefix(entry.path);
+		hash = xxh64(path.text, path.len, hash);
+		hash = xxh64(&entry.content_hash, gb_size_of(entry.content_hash), hash);
+	}
+	// NOTE: args[0] is wherever the compiler itself is installed, which ODIN_VERSION already stands for
+	for (isize i = 1; i < args.count; i++) {
+		String targ = cache_remote_normalize_arg(args[i]);
+		hash = xxh64(targ.text, targ.len, hash);
+	}
+	for (String const &env : envs) {
+		// NOTE: Only the compiler's own variables, the rest (e.g. host names and job ids) differ between machines
+		if (string_starts_with(env, str_lit("ODIN_")) && !string_starts_with(env, str_lit("ODIN_CACHE_REMOTE"))) {
+			hash = xxh64(env.text, env.len, hash);
+		}
+	}
+
+	gbString name = gb_string_make(permanent_allocator(), "");
+	name = gb_string_append_fmt(name, "%016llx-", cast(unsigned long long)hash);
+	name = cache_append_executable_name(name);
+	return make_string(cast(u8 *)name, gb_string_length(name));
+}
+
+gb_internal i32 system_exec_argv(char const *name, char const **argv);
+
+gb_internal void cache_remote_curl_config_option(gbString *config, char const *name, String value) {
+	*config = gb_string_append_fmt(*config, "%s = \"", name);
+	for (isize i = 0; i < value.len; i++) {
+		if (value[i] == '"' || value[i] == '\\') {
+			*config = gb_string_appendc(*config, "\\");
+		}
+		*config = gb_string_append_length(*config, &value[i], 1);
+	}
+	*config = gb_string_appendc(*config, "\"\n");
+}
+
+// NOTE: curl is spawned directly rather than through a shell, and it reads everything (most importantly the
+// header, which usually holds a token) from a config file only readable by the user, so none of it shows up
+// in the process list, the output of -show-system-calls, or is ever interpreted by a shell
+gb_internal bool cache_remote_http_transfer(bool store, String local_path) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	BuildCacheData *bcd = &build_context.build_cache_data;
+
+	gbString config = gb_string_make(temporary_allocator(), "silent\nfail\n");
+	if (!store) {
+		config = gb_string_appendc(config, "location\n");
+	}
+	if (bcd->remote_header.len != 0) {
+		cache_remote_curl_config_option(&config, "header", bcd->remote_header);
+	}
+	cache_remote_curl_config_option(&config, store ? "upload-file" : "output", local_path);
+	cache_remote_curl_config_option(&config, "url", concatenate3_strings(temporary_allocator(), bcd->remote_url, str_lit("/"), bcd->remote_name));
+
+	String config_path = concatenate_strings(temporary_allocator(), local_path, str_lit(".curlrc"));
+	char const *config_c = alloc_cstring(temporary_allocator(), config_path);
+	defer (gb_file_remove(config_c));
+
+	gbFile f = {};
+	if (gb_file_create(&f, config_c) != gbFileError_None) {
+		return false;
+	}
+#if !defined(GB_SYSTEM_WINDOWS)
+	fchmod(f.fd.i, 0600);
+#endif
+	bool written = gb_file_write(&f, config, gb_string_length(config));
+	gb_file_close(&f);
+	if (!written) {
+		return false;
+	}
+
+	char const *argv[] = {"curl", "-K", config_c, nullptr};
+	return system_exec_argv("remote-cache", argv) == 0;
+}
+
+gb_internal bool try_cached_build_remote(Checker *c, Array<String> const &args) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	BuildCacheData *bcd = &build_context.build_cache_data;
+
+	auto files = cache_gather_files(c);
+	defer (array_free(&files));
+	auto envs = cache_gather_envs();
+	defer (array_free(&envs));
+
+	bcd->remote_name = cache_remote_executable_name(files, args, envs);
+
+	String exe_name = path_to_string(temporary_allocator(), build_context.build_paths[BuildPath_Output]);
+	char const *exe_c = alloc_cstring(temporary_allocator(), exe_name);
+	char const *tmp_c = alloc_cstring(temporary_allocator(), concatenate_strings(temporary_allocator(), exe_name, str_lit(".remote")));
+
+	// NOTE: Fetched next to the executable and then moved into place, so a failed transfer never leaves a partial executable
+	bool ok = false;
+	if (cache_remote_is_http()) {
+		ok = cache_remote_http_transfer(false, make_string_c(tmp_c));
+	} else {
+		String src = concatenate3_strings(temporary_allocator(), bcd->remote_url, str_lit("/"), bcd->remote_name);
+		char const *src_c = alloc_cstring(temporary_allocator(), src);
+		ok = gb_file_exists(src_c) && gb_file_copy(src_c, tmp_c, false);
+	}
+	if (!ok) {
+		gb_file_remove(tmp_c);
+		debugf("Cache: remote miss %.*s\n", LIT(bcd->remote_name));
+		return false;
+	}
+	gb_file_remove(exe_c);
+	if (!gb_file_move(tmp_c, exe_c)) {
+		gb_file_remove(tmp_c);
+		return false;
+	}
+#if !defined(GB_SYSTEM_WINDOWS)
+	chmod(exe_c, 0755);
+#endif
+	debugf("Cache: remote hit %.*s\n", LIT(bcd->remote_name));
+
+	bcd->remote_hit = true;
+	try_copy_executable_to_cache();
+	return true;
+}
+
+gb_internal bool try_cached_build(Checker *c, Array<String> const &args) {
+	if (try_cached_build_local(c, args)) {
+		return true;
+	}
+	if (!cache_remote_init()) {
+		return false;
+	}
+	return try_cached_build_remote(c, args);
+}
+
+// NOTE: Only called after an actual build, the name is the one from the last `try_cached_build`
+gb_internal void try_copy_executable_to_remote_cache(void) {
+	BuildCacheData *bcd = &build_context.build_cache_data;
+	if (bcd->remote_url.len == 0 || bcd->remote_read_only || bcd->remote_name.len == 0) {
+		return;
+	}
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	String exe_name = path_to_string(temporary_allocator(), build_context.build_paths[BuildPath_Output]);
+	char const *exe_c = alloc_cstring(temporary_allocator(), exe_name);
+
+	bool ok = false;
+	if (cache_remote_is_http()) {
+		ok = cache_remote_http_transfer(true, exe_name);
+	} else {
+		// NOTE: Copied under a unique name and then renamed, as other machines may be storing the same entry
+		String dst = concatenate3_strings(temporary_allocator(), bcd->remote_url, str_lit("/"), bcd->remote_name);
+		gbString tmp = gb_string_make(temporary_allocator(), "");
+		tmp = gb_string_append_fmt(tmp, "%.*s.%llx.tmp", LIT(dst), cast(unsigned long long)time_stamp_time_now());
+		char const *dst_c = alloc_cstring(temporary_allocator(), dst);
+
+		ok = gb_file_copy(exe_c, tmp, false);
+		if (ok) {
+			// NOTE: Another machine storing the same entry first is just as good
+			gb_file_remove(dst_c);
+			ok = gb_file_move(tmp, dst_c) || gb_file_exists(dst_c);
+		}
+		gb_file_remove(tmp);
+	}
+	if (!ok) {
+		gb_printf_err("Warning: Failed to store the executable in the remote cache: %.*s\n", LIT(bcd->remote_url));
+	} else {
+		debugf("Cache: stored %.*s in the remote cache\n", LIT(bcd->remote_name));
+	}
+}
+
 void write_cached_build(Checker *c, Array<String> const &args) {
 	auto files = cache_gather_files(c);
 	defer (array_free(&files));
@@ -436,9 +801,19 @@ void write_cached_build(Checker *c, Array<String> const &args) {
 		defer (gb_file_close(&f));
 		gb_file_open_mode(&f, gbFileMode_Write, path_c);
 
-		for (String const &path : files) {
-			gbFileTime ft = gb_file_last_write_time(alloc_cstring(temporary_allocator(), path));
-			gb_fprintf(&f, "%llu %.*s\n", cast(unsigned long long)ft, LIT(path));
+		auto entries = slice_make<CacheFileEntry>(heap_allocator(), files.count);
+		defer (slice_free(&entries, heap_allocator()));
+		for_array(i, files) {
+			entries[i].path = files[i];
+		}
+		cache_process_file_entries(entries);
+
+		for (CacheFileEntry const &entry : entries) {
+			gb_fprintf(&f, "%llu %lld %016llx %.*s\n",
+			           cast(unsigned long long)entry.last_write_time,
+			           cast(long long)entry.size,
+			           cast(unsigned long long)entry.content_hash,
+			           LIT(entry.path));
 		}
 	}
 	{
@@ -1992,6 +1992,45 @@ gb_internal bool check_builtin_simd_operation(CheckerContext *c, Operand *operan
 	return false;
 }
 
+gb_internal gbFileError read_load_file(String const &path, LoadFileTier tier, String *data_) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	char *c_str = alloc_cstring(temporary_allocator(), path);
+
+	gbFile f = {};
+	gbFileError file_error = gb_file_open(&f, c_str);
+	defer (gb_file_close(&f));
+
+	if (file_error == gbFileError_None) {
+		switch(tier) {
+		case LoadFileTier_Exists:
+			// Nothing to do.
+			break;
+		case LoadFileTier_Contents: {
+			isize file_size = cast(isize)gb_file_size(&f);
+			if (file_size >= LOAD_FILE_LARGE_SIZE) {
+				LoadedFile loaded_file = {};
+				if (load_file_32(c_str, &loaded_file, false) == LoadedFile_None) {
+					data_->text = cast(u8 *)loaded_file.data;
+					data_->len = loaded_file.size;
+					break;
+				}
+			}
+			if (file_size > 0) {
+				u8 *ptr = permanent_alloc_array<u8>(file_size+1);
+				gb_file_read_at(&f, ptr, file_size, 0);
+				ptr[file_size] = '\0';
+				data_->text = ptr;
+				data_->len = file_size;
+			}
+			break;
+		}
+		default:
+			GB_PANIC("Unhandled LoadFileTier");
+		};
+	}
+	return file_error;
+}
+
 gb_internal bool cache_load_file_directive(CheckerContext *c, Ast *call, String const &original_string, bool err_on_not_found, LoadFileCache **cache_, LoadFileTier tier, bool use_mutex=true) {
 	ast_node(ce, CallExpr, call);
 	ast_node(bd, BasicDirective, ce->proc);
@@ -2052,36 +2091,8 @@ gb_internal bool cache_load_file_directive(CheckerContext *c, Ast *call, String
 
 	if (tier > cache_tier) {
 		cache_tier = tier;
-
-		TEMPORARY_ALLOCATOR_GUARD();
-		char *c_str = alloc_cstring(temporary_allocator(), path);
-
-		gbFile f = {};
-		file_error = gb_file_open(&f, c_str);
-		defer (gb_file_close(&f));
-
-		if (file_error == gbFileError_None) {
-			exists = true;
-
-			switch(tier) {
-			case LoadFileTier_Exists:
-				// Nothing to do.
-				break;
-			case LoadFileTier_Contents: {
-				isize file_size = cast(isize)gb_file_size(&f);
-				if (file_size > 0) {
-					u8 *ptr = permanent_alloc_array<u8>(file_size+1);
-					gb_file_read_at(&f, ptr, file_size, 0);
-					ptr[file_size] = '\0';
-					data.text = ptr;
-					data.len = file_size;
-				}
-				break;
-			}
-			default:
-				GB_PANIC("Unhandled LoadFileTier");
-			};
-		}
+		file_error = read_load_file(path, tier, &data);
+		exists = file_error == gbFileError_None;
 	}
 
 	switch (file_error) {
@@ -2216,6 +2227,85 @@ gb_internal int file_cache_sort_cmp(void const *x, void const *y) {
 	return string_compare(a->path, b->path);
 }
 
+struct LoadFilePrefetch {
+	String      path;
+	gbFileError file_error;
+	String      data;
+};
+
+gb_internal WORKER_TASK_PROC(load_file_prefetch_proc) {
+	LoadFilePrefetch *p = cast(LoadFilePrefetch *)data;
+	p->file_error = read_load_file(p->path, LoadFileTier_Contents, &p->data);
+	return 0;
+}
+
+// NOTE: Reads the files of a `#load_directory` on the thread pool and adds them to the `#load` cache,
+// so that the directive then only has to look them up. No mutex is held whilst waiting, as the waiting
+// thread helps with other tasks, which may be checking another `#load` themselves.
+gb_internal void prefetch_load_directory(CheckerContext *c, String const &path) {
+	if (global_thread_pool.threads.count <= 1) {
+		return;
+	}
+
+	Array<FileInfo> list = {};
+	ReadDirectoryError rd_err = read_directory(path, &list);
+	defer (array_free(&list));
+	if (rd_err != ReadDirectory_None || list.count < 2) {
+		return;
+	}
+
+	auto files = array_make<LoadFilePrefetch>(heap_allocator(), 0, list.count);
+	defer (array_free(&files));
+	{
+		MUTEX_GUARD(&c->info->load_file_mutex);
+		for (FileInfo const &fi : list) {
+			if (fi.is_dir) {
+				continue;
+			}
+			LoadFileCache **found = string_map_get(&c->info->load_file_cache, fi.fullpath);
+			if (found && (*found)->tier >= LoadFileTier_Contents) {
+				continue;
+			}
+			LoadFilePrefetch p = {};
+			p.path = copy_string(permanent_allocator(), fi.fullpath);
+			array_add(&files, p);
+		}
+	}
+
+	ThreadPoolTaskGroup group = {};
+	for (LoadFilePrefetch &p : files) {
+		thread_pool_add_task_to_group(&global_thread_pool, &group, load_file_prefetch_proc, &p);
+	}
+	thread_pool_wait_group(&global_thread_pool, &group);
+
+	MUTEX_GUARD(&c->info->load_file_mutex);
+	for (LoadFilePrefetch const &p : files) {
+		if (p.file_error != gbFileError_None) {
+			// NOTE: Left for the directive itself to report
+			continue;
+		}
+		LoadFileCache **found = string_map_get(&c->info->load_file_cache, p.path);
+		if (found) {
+			LoadFileCache *cache = *found;
+			if (cache->tier < LoadFileTier_Contents) {
+				cache->tier = LoadFileTier_Contents;
+				cache->exists = true;
+				cache->file_error = gbFileError_None;
+				cache->data = p.data;
+			}
+			continue;
+		}
+		LoadFileCache *new_cache = permanent_alloc_item<LoadFileCache>();
+		new_cache->path = p.path;
+		new_cache->data = p.data;
+		new_cache->file_error = gbFileError_None;
+		new_cache->exists = true;
+		new_cache->tier = LoadFileTier_Contents;
+		string_map_init(&new_cache->hashes, 32);
+		string_map_set(&c->info->load_file_cache, p.path, new_cache);
+	}
+}
+
 gb_internal LoadDirectiveResult check_load_directory_directive(CheckerContext *c, Operand *operand, Ast *call, Type *type_hint, bool err_on_not_found) {
 	ast_node(ce, CallExpr, call);
 	ast_node(bd, BasicDirective, ce->proc);
@@ -2261,6 +2351,15 @@ gb_internal LoadDirectiveResult check_load_directory_directive(CheckerContext *c
 		bool ok = determine_path_from_string(ignore_mutex, call, base_dir, original_string, &path);
 		gb_unused(ok);
 	}
+
+	bool is_cached = false;
+	mutex_lock(&c->info->load_directory_mutex);
+	is_cached = string_map_get(&c->info->load_directory_cache, path) != nullptr;
+	mutex_unlock(&c->info->load_directory_mutex);
+	if (!is_cached) {
+		prefetch_load_directory(c, path);
+	}
+
 	MUTEX_GUARD(&c->info->load_directory_mutex);
 
 
@@ -2769,6 +2868,16 @@ gb_internal bool check_builtin_procedure_directive(CheckerContext *c, Operand *o
 		MUTEX_GUARD(&c->info->defineables_mutex);
 		array_add(&c->info->defineables, defineable);
 
+	} else if (name == "eval") {
+		if (ce->args.count != 1) {
+			if (ce->args.count == 0) {
+				error(ce->close, "'#eval' expects 1 argument, got 0");
+			} else {
+				error(ce->args[0], "'#eval' expects 1 argument, got %td", ce->args.count);
+			}
+			return false;
+		}
+		return check_eval_directive(c, operand, call, ce->args[0]);
 	} else {
 		error(call, "Unknown directive call: #%.*s", LIT(name));
 	}
@@ -2839,6 +2948,9 @@ gb_internal bool check_builtin_procedure(CheckerContext *c, Operand *operand, As
 		if (name == "config") {
 			break;
 		}
+		if (name == "eval") {
+			break;
+		}
 		/*fallthrough*/
 	}
 	default:
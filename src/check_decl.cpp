@@ -181,7 +181,7 @@ gb_internal void override_entity_in_scope(Entity *original_entity, Entity *new_e
 	original_entity->type = new_entity->type;
 	original_entity->kind = new_entity->kind;
 	original_entity->decl_info = new_entity->decl_info;
-	original_entity->aliased_of = new_entity;
+	entity_cold(original_entity)->aliased_of = new_entity;
 
 	original_entity->identifier.store(new_entity->identifier);
 
@@ -521,7 +521,9 @@ gb_internal void check_type_decl(CheckerContext *ctx, Entity *e, Ast *init_expr,
 		AttributeContext ac = {};
 		check_decl_attributes(ctx, decl->attributes, type_decl_attribute, &ac);
 
-		e->deprecated_message = ac.deprecated_message;
+		if (ac.deprecated_message.len != 0) {
+			entity_cold(e)->deprecated_message = ac.deprecated_message;
+		}
 
 		if (e->kind == Entity_TypeName && ac.objc_class != "") {
 
@@ -704,6 +706,7 @@ gb_internal void check_const_decl(CheckerContext *ctx, Entity *e, Ast *type_expr
 			// Thank goodness I made entities a tagged union to allow for this implace patching
 			e->kind = Entity_ProcGroup;
 			e->ProcGroup.entities = array_clone(heap_allocator(), operand.proc_group->ProcGroup.entities);
+			e->ProcGroup.exact_first_params = operand.proc_group->ProcGroup.exact_first_params;
 			return;
 		}
 
@@ -1256,6 +1259,32 @@ gb_internal void check_foreign_procedure(CheckerContext *ctx, Entity *e, DeclInf
 	mutex_unlock(&ctx->info->foreign_mutex);
 }
 
+// NOTE: -instrumentation-filter; a procedure is instrumented if it matches any inclusive pattern (or
+// there are none) and no exclusive pattern
+gb_internal bool instrumentation_filter_allows(Entity *e) {
+	auto const &filters = build_context.instrumentation_filters;
+	if (filters.count == 0) {
+		return true;
+	}
+
+	String pkg_name = e->pkg != nullptr ? e->pkg->name : str_lit("");
+	String name = concatenate3_strings(temporary_allocator(), pkg_name, str_lit("."), e->token.string);
+
+	bool has_include = false;
+	bool included = false;
+	for (InstrumentationFilter const &f : filters) {
+		if (f.exclude) {
+			if (string_glob_match(f.pattern, name)) {
+				return false;
+			}
+		} else {
+			has_include = true;
+			included = included || string_glob_match(f.pattern, name);
+		}
+	}
+	return included || !has_include;
+}
+
 gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 	GB_ASSERT(e->type == nullptr);
 	if (d->proc_lit->kind != Ast_ProcLit) {
@@ -1326,6 +1355,9 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 	if (ac.test) {
 		e->flags |= EntityFlag_Test;
 	}
+	if (ac.benchmark) {
+		e->flags |= EntityFlag_Benchmark;
+	}
 	if (ac.init && ac.fini) {
 		error(e->token, "A procedure cannot be both declared as @(init) and @(fini)");
 	} else if (ac.init) {
@@ -1342,6 +1374,11 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 		e->flags |= EntityFlag_Cold;
 	}
 	e->Procedure.optimization_mode = cast(ProcedureOptimizationMode)ac.optimization_mode;
+	if (ac.has_max_stack_usage) {
+		e->Procedure.has_max_stack_usage = true;
+		e->Procedure.max_stack_usage = ac.max_stack_usage;
+		ctx->info->has_max_stack_usage.store(true, std::memory_order_relaxed);
+	}
 
 	check_objc_methods(ctx, e, ac);
 
@@ -1378,6 +1415,31 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 		}
 	}
 
+	if (ac.target_clones.len != 0) {
+		if (build_context.metrics.arch != TargetArch_amd64) {
+			error(e->token, "@(target_clones=\"...\") is only supported on amd64");
+		} else if (ac.require_target_feature.len != 0 || ac.enable_target_feature.len != 0) {
+			error(e->token, "@(target_clones=\"...\") cannot be combined with @(require_target_feature) or @(enable_target_feature)");
+		} else if (pl->body == nullptr) {
+			error(e->token, "@(target_clones=\"...\") requires a procedure body");
+		} else if (pt->is_polymorphic || pt->c_vararg) {
+			error(e->token, "@(target_clones=\"...\") cannot be used on polymorphic or C variadic procedures");
+		} else if (e->parent_proc_decl.load(std::memory_order_relaxed) != nullptr) {
+			error(e->token, "@(target_clones=\"...\") can only be used on procedures declared at file scope");
+		} else {
+			String_Iterator it = {ac.target_clones, 0};
+			for (;;) {
+				String target = string_trim_whitespace(string_split_iterator(&it, ','));
+				if (target == "") break;
+				String invalid = {};
+				if (!target_clone_parse(target, nullptr, &invalid)) {
+					error(e->token, "@(target_clones=\"...\") has an unknown feature '%.*s' in target '%.*s'", LIT(invalid), LIT(target));
+				}
+			}
+			e->Procedure.target_clones = ac.target_clones;
+		}
+	}
+
 	switch (e->Procedure.optimization_mode) {
 	case ProcedureOptimizationMode_None:
 		if (pl->inlining == ProcInlining_inline) {
@@ -1406,7 +1468,7 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 
 		switch (ac.no_instrumentation) {
 		case Instrumentation_Enabled:  has_instrumentation = true; break;
-		case Instrumentation_Default:  break;
+		case Instrumentation_Default:  has_instrumentation = has_instrumentation && instrumentation_filter_allows(e); break;
 		case Instrumentation_Disabled: has_instrumentation = false;  break;
 		}
 	}
@@ -1486,8 +1548,11 @@ gb_internal void check_proc_decl(CheckerContext *ctx, Entity *e, DeclInfo *d) {
 
 	e->Procedure.fast_math_flags = ac.fast_math_flags;
 
-	e->deprecated_message = ac.deprecated_message;
-	e->warning_message = ac.warning_message;
+	if (ac.deprecated_message.len != 0 || ac.warning_message.len != 0) {
+		EntityCold *cold = entity_cold(e);
+		cold->deprecated_message = ac.deprecated_message;
+		cold->warning_message = ac.warning_message;
+	}
 	ac.link_name = handle_link_name(ctx, e->token, ac.link_name, ac.link_prefix, ac.link_suffix);
 
 	if (ac.link_section.len > 0) {
@@ -1980,6 +2045,8 @@ gb_internal void check_proc_group_decl(CheckerContext *ctx, Entity *pg_entity, D
 		}
 	}
 
+	check_proc_group_index_first_params(pg_entity);
+
 	AttributeContext ac = {};
 	check_decl_attributes(ctx, d->attributes, proc_group_attribute, &ac);
 	check_objc_methods(ctx, pg_entity, ac);
@@ -2087,8 +2154,8 @@ gb_internal void add_deps_from_child_to_parent(DeclInfo *decl) {
 			rw_mutex_shared_lock(&decl->deps_mutex);
 			rw_mutex_lock(&decl->parent->deps_mutex);
 
-			FOR_PTR_SET(e, decl->deps) {
-				ptr_set_add(&decl->parent->deps, e);
+			for (Entity *e : decl->deps) {
+				entity_set_add(&decl->parent->deps, e);
 			}
 
 			rw_mutex_unlock(&decl->parent->deps_mutex);
@@ -2191,7 +2258,7 @@ gb_internal bool check_proc_body(CheckerContext *ctx_, Token token, DeclInfo *de
 					GB_ASSERT(scope != nullptr);
 					rw_mutex_lock(&scope->mutex);
 					for (auto const &entry : scope->elements) {
-						Entity *f = entry.value;
+						Entity *f = entry.value();
 						if (f->kind == Entity_Variable) {
 							Entity *uvar = alloc_entity_using_variable(e, f->token, f->type, nullptr);
 							if (is_value) uvar->flags |= EntityFlag_Value;
@@ -2224,7 +2291,7 @@ gb_internal bool check_proc_body(CheckerContext *ctx_, Token token, DeclInfo *de
 	rw_mutex_unlock(&ctx->scope->mutex);
 
 
-	bool where_clause_ok = evaluate_where_clauses(ctx, nullptr, decl->scope, &decl->proc_lit->ProcLit.where_clauses, !decl->where_clauses_evaluated.load(std::memory_order_relaxed));
+	bool where_clause_ok = evaluate_decl_where_clauses(ctx, nullptr, decl, !decl->where_clauses_evaluated.load(std::memory_order_relaxed));
 	if (!where_clause_ok) {
 		// NOTE(bill, 2019-08-31): Don't check the body as the where clauses failed
 		return false;
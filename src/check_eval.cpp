@@ -0,0 +1,1379 @@
+// NOTE: `#eval(f(args))` runs a procedure with constant arguments whilst checking and yields its result
+// as a constant, so that generated lookup tables (CRC tables, sine tables, perfect hashes, etc) need
+// neither be checked in as huge literals nor be computed at startup.
+//
+// The evaluator walks the checked AST of the procedure bodies and only supports a side effect free
+// subset of the language: booleans, integers, floats, enums and strings, fixed and enumerated arrays
+// and structs of those, local variables, `if`, `when`, `switch`, `for`, `for in` over ranges and
+// arrays, calls to other procedures, conversions and the `len`, `min`, `max` and `abs` built-ins.
+//
+// It is only allowed within package level declarations, which are checked single threaded, and the
+// bodies of the procedures it calls are checked on demand.
+
+#define CHECK_EVAL_STEP_LIMIT  (1ll<<26)
+#define CHECK_EVAL_DEPTH_LIMIT 256
+
+struct CheckEvalValue {
+	ExactValue      value;      // booleans, integers, floats and strings
+	CheckEvalValue *elems;      // arrays and structs
+	isize           elem_count;
+};
+
+struct CheckEvalFrame {
+	PtrMap<Entity *, CheckEvalValue *> locals;
+	TypeProc *     proc_type;
+	CheckEvalValue result;
+};
+
+enum CheckEvalFlow {
+	CheckEvalFlow_Next,
+	CheckEvalFlow_Break,
+	CheckEvalFlow_Continue,
+	CheckEvalFlow_Return,
+	CheckEvalFlow_Failed,
+};
+
+struct CheckEvaluator {
+	CheckerContext *c;
+	Arena           arena;
+	i64             steps;
+	isize           depth;
+	bool            failed;
+};
+
+gb_internal bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped);
+
+gb_internal bool check_eval_expr(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node, CheckEvalValue *out);
+gb_internal CheckEvalFlow check_eval_stmt(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node);
+
+
+gb_internal bool check_eval_error(CheckEvaluator *ev, Ast *node, char const *fmt, ...) {
+	if (!ev->failed) {
+		ev->failed = true;
+		va_list va;
+		va_start(va, fmt);
+		error_va(ast_token(node).pos, ast_end_pos(node), fmt, va);
+		va_end(va);
+	}
+	return false;
+}
+
+gb_internal bool check_eval_unsupported(CheckEvaluator *ev, Ast *node) {
+	return check_eval_error(ev, node, "'#eval' does not support a %.*s", LIT(ast_strings[node->kind]));
+}
+
+gb_internal bool check_eval_step(CheckEvaluator *ev, Ast *node, i64 amount=1) {
+	if (ev->failed) {
+		return false;
+	}
+	ev->steps += amount;
+	if (ev->steps > CHECK_EVAL_STEP_LIMIT) {
+		return check_eval_error(ev, node, "'#eval' exceeded its limit of %lld evaluation steps", cast(long long)CHECK_EVAL_STEP_LIMIT);
+	}
+	return true;
+}
+
+gb_internal CheckEvalValue *check_eval_alloc(CheckEvaluator *ev, isize count) {
+	return arena_alloc_array<CheckEvalValue>(&ev->arena, gb_max(count, 1));
+}
+
+// NOTE: Returns the basic type which holds the value of a scalar, or nullptr if it is not supported
+gb_internal Type *check_eval_scalar_type(Type *type) {
+	Type *t = core_type(type);
+	if (t != nullptr && t->kind == Type_Enum) {
+		t = core_type(t->Enum.base_type);
+	}
+	if (t == nullptr || t->kind != Type_Basic) {
+		return nullptr;
+	}
+	if (is_type_boolean(t) || is_type_integer(t) || is_type_float(t)) {
+		return t;
+	}
+	if (is_type_string(t) && !is_type_cstring(t) && !is_type_string16(t)) {
+		return t;
+	}
+	return nullptr;
+}
+
+gb_internal bool check_eval_is_aggregate(Type *type) {
+	Type *bt = base_type(type);
+	switch (bt->kind) {
+	case Type_Array:
+	case Type_EnumeratedArray:
+		return true;
+	case Type_Struct:
+		return !bt->Struct.is_raw_union && bt->Struct.soa_kind == StructSoa_None;
+	}
+	return false;
+}
+
+gb_internal isize check_eval_aggregate_count(Type *type) {
+	Type *bt = base_type(type);
+	switch (bt->kind) {
+	case Type_Array:           return cast(isize)bt->Array.count;
+	case Type_EnumeratedArray: return cast(isize)bt->EnumeratedArray.count;
+	case Type_Struct:          return bt->Struct.fields.count;
+	}
+	return 0;
+}
+
+gb_internal Type *check_eval_aggregate_elem(Type *type, isize index) {
+	Type *bt = base_type(type);
+	switch (bt->kind) {
+	case Type_Array:           return bt->Array.elem;
+	case Type_EnumeratedArray: return bt->EnumeratedArray.elem;
+	case Type_Struct:          return bt->Struct.fields[index]->type;
+	}
+	return nullptr;
+}
+
+gb_internal ExactValue check_eval_wrap_integer(ExactValue v, Type *t) {
+	i64 bits = 8*type_size_of(t);
+	bool is_signed = !is_type_unsigned(t);
+
+	i64 small = 0;
+	if (bits <= 64 && big_int_get_small(&v.value_integer, &small)) {
+		u64 u = cast(u64)small;
+		if (bits < 64) {
+			u64 mask = (1ull<<bits) - 1;
+			u &= mask;
+			if (is_signed && ((u >> (bits-1)) & 1)) {
+				u |= ~mask;
+			}
+		}
+		return is_signed ? exact_value_i64(cast(i64)u) : exact_value_u64(u);
+	}
+
+	BigInt modulus = big_int_make_u64(1);
+	BigInt shift = big_int_make_i64(bits);
+	big_int_shl_eq(&modulus, &shift);
+
+	ExactValue res = {ExactValue_Integer};
+	big_int_mod_mod(&res.value_integer, &v.value_integer, &modulus);
+	if (is_signed) {
+		BigInt one = big_int_make_u64(1);
+		BigInt half = {};
+		big_int_shr(&half, &modulus, &one);
+		if (big_int_cmp(&res.value_integer, &half) >= 0) {
+			big_int_sub_eq(&res.value_integer, &modulus);
+		}
+	}
+	return res;
+}
+
+// NOTE: Converts a scalar to `type`, wrapping integers around like the generated code does
+gb_internal bool check_eval_convert(CheckEvaluator *ev, Ast *node, ExactValue v, Type *type, ExactValue *out) {
+	Type *t = check_eval_scalar_type(type);
+	if (t == nullptr) {
+		gbString s = type_to_string(type);
+		defer (gb_string_free(s));
+		return check_eval_error(ev, node, "'#eval' does not support values of type '%s'", s);
+	}
+	if (is_type_untyped(t)) {
+		*out = v;
+		return true;
+	}
+
+	if (is_type_boolean(t)) {
+		if (v.kind != ExactValue_Bool) {
+			return check_eval_error(ev, node, "'#eval' expected a boolean value");
+		}
+	} else if (is_type_integer(t)) {
+		if (v.kind == ExactValue_Float) {
+			f64 x = v.value_float;
+			if (!(x > -9223372036854775808.0 && x < 18446744073709551616.0)) {
+				return check_eval_error(ev, node, "'#eval' cannot represent %f as an integer", x);
+			}
+			v = x < 0 ? exact_value_i64(cast(i64)x) : exact_value_u64(cast(u64)x);
+		}
+		if (v.kind != ExactValue_Integer) {
+			return check_eval_error(ev, node, "'#eval' expected an integer value");
+		}
+		v = check_eval_wrap_integer(v, t);
+	} else if (is_type_float(t)) {
+		v = exact_value_to_float(v);
+		if (v.kind != ExactValue_Float) {
+			return check_eval_error(ev, node, "'#eval' expected a float value");
+		}
+		if (type_size_of(t) < 8) {
+			v.value_float = cast(f64)cast(f32)v.value_float;
+		}
+	} else if (v.kind != ExactValue_String) {
+		return check_eval_error(ev, node, "'#eval' expected a string value");
+	}
+	*out = v;
+	return true;
+}
+
+gb_internal bool check_eval_zero(CheckEvaluator *ev, Ast *node, CheckEvalValue *v, Type *type) {
+	gb_zero_item(v);
+	if (check_eval_is_aggregate(type)) {
+		isize count = check_eval_aggregate_count(type);
+		if (!check_eval_step(ev, node, count)) {
+			return false;
+		}
+		v->elem_count = count;
+		v->elems = check_eval_alloc(ev, count);
+		Type *bt = base_type(type);
+		if (bt->kind != Type_Struct && count > 0 && !check_eval_is_aggregate(check_eval_aggregate_elem(type, 0))) {
+			// NOTE: every element of a scalar array has the same zero value
+			if (!check_eval_zero(ev, node, &v->elems[0], check_eval_aggregate_elem(type, 0))) {
+				return false;
+			}
+			for (isize i = 1; i < count; i++) {
+				v->elems[i] = v->elems[0];
+			}
+			return true;
+		}
+		for (isize i = 0; i < count; i++) {
+			if (!check_eval_zero(ev, node, &v->elems[i], check_eval_aggregate_elem(type, i))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	Type *t = check_eval_scalar_type(type);
+	if (t == nullptr) {
+		gbString s = type_to_string(type);
+		defer (gb_string_free(s));
+		return check_eval_error(ev, node, "'#eval' does not support values of type '%s'", s);
+	}
+	if (is_type_boolean(t)) {
+		v->value = exact_value_bool(false);
+	} else if (is_type_integer(t)) {
+		v->value = exact_value_i64(0);
+	} else if (is_type_float(t)) {
+		v->value = exact_value_float(0);
+	} else {
+		v->value = exact_value_string({});
+	}
+	return true;
+}
+
+gb_internal bool check_eval_copy(CheckEvaluator *ev, Ast *node, CheckEvalValue *dst, CheckEvalValue const *src) {
+	*dst = *src;
+	if (src->elems == nullptr) {
+		return true;
+	}
+	if (!check_eval_step(ev, node, src->elem_count)) {
+		return false;
+	}
+	dst->elems = check_eval_alloc(ev, src->elem_count);
+	for (isize i = 0; i < src->elem_count; i++) {
+		if (!check_eval_copy(ev, node, &dst->elems[i], &src->elems[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// NOTE: `src` is owned by the caller and moved into `dst`
+gb_internal bool check_eval_assign(CheckEvaluator *ev, Ast *node, CheckEvalValue *dst, CheckEvalValue *src, Type *type) {
+	if (check_eval_is_aggregate(type)) {
+		if (src->elems == nullptr && src->elem_count == 0 && check_eval_aggregate_count(type) != 0) {
+			return check_eval_error(ev, node, "'#eval' expected an aggregate value");
+		}
+		*dst = *src;
+		return true;
+	}
+	dst->elems = nullptr;
+	dst->elem_count = 0;
+	return check_eval_convert(ev, node, src->value, type, &dst->value);
+}
+
+gb_internal bool check_eval_constant(CheckEvaluator *ev, Ast *node, Type *type, ExactValue value, CheckEvalValue *out) {
+	if (!check_eval_is_aggregate(type)) {
+		gb_zero_item(out);
+		if (value.kind == ExactValue_Invalid) {
+			return check_eval_zero(ev, node, out, type);
+		}
+		return check_eval_convert(ev, node, value, type, &out->value);
+	}
+
+	if (!check_eval_zero(ev, node, out, type)) {
+		return false;
+	}
+	if (value.kind == ExactValue_Invalid) {
+		return true;
+	}
+	Type *bt = base_type(type);
+	if (value.kind != ExactValue_Compound) {
+		if (bt->kind == Type_Struct) {
+			return check_eval_unsupported(ev, node);
+		}
+		// NOTE: a scalar constant of an array type is spread over all of its elements
+		for (isize i = 0; i < out->elem_count; i++) {
+			if (!check_eval_constant(ev, node, check_eval_aggregate_elem(type, i), value, &out->elems[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	ast_node(cl, CompoundLit, value.value_compound);
+	for_array(i, cl->elems) {
+		Ast *elem = cl->elems[i];
+		if (elem->kind != Ast_FieldValue) {
+			if (i >= out->elem_count) {
+				return check_eval_unsupported(ev, elem);
+			}
+			TypeAndValue tav = elem->tav;
+			if (!check_eval_constant(ev, elem, check_eval_aggregate_elem(type, i), tav.value, &out->elems[i])) {
+				return false;
+			}
+			continue;
+		}
+
+		ast_node(fv, FieldValue, elem);
+		TypeAndValue tav = fv->value->tav;
+		if (bt->kind == Type_Struct) {
+			if (fv->field->kind != Ast_Ident) {
+				return check_eval_unsupported(ev, elem);
+			}
+			Selection sel = lookup_field(type, fv->field->Ident.interned, false);
+			if (sel.index.count != 1) {
+				return check_eval_unsupported(ev, elem);
+			}
+			isize index = sel.index[0];
+			if (!check_eval_constant(ev, elem, check_eval_aggregate_elem(type, index), tav.value, &out->elems[index])) {
+				return false;
+			}
+			continue;
+		}
+
+		i64 lo = 0;
+		i64 hi = 0;
+		if (is_ast_range(fv->field)) {
+			ast_node(ie, BinaryExpr, fv->field);
+			lo = exact_value_to_i64(ie->left->tav.value);
+			hi = exact_value_to_i64(ie->right->tav.value);
+			if (ie->op.kind != Token_RangeHalf) {
+				hi += 1;
+			}
+		} else {
+			lo = exact_value_to_i64(fv->field->tav.value);
+			hi = lo+1;
+		}
+		if (bt->kind == Type_EnumeratedArray) {
+			i64 min = exact_value_to_i64(*bt->EnumeratedArray.min_value);
+			lo -= min;
+			hi -= min;
+		}
+		for (i64 j = lo; j < hi; j++) {
+			if (j < 0 || j >= out->elem_count) {
+				return check_eval_unsupported(ev, elem);
+			}
+			if (!check_eval_constant(ev, elem, check_eval_aggregate_elem(type, cast(isize)j), tav.value, &out->elems[j])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+gb_internal bool check_eval_index(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node, Type *type, isize count, isize *index_) {
+	CheckEvalValue index = {};
+	if (!check_eval_expr(ev, f, node, &index)) {
+		return false;
+	}
+	if (index.value.kind != ExactValue_Integer) {
+		return check_eval_error(ev, node, "'#eval' expected an integer index");
+	}
+	i64 i = exact_value_to_i64(index.value);
+	Type *bt = base_type(type);
+	if (bt->kind == Type_EnumeratedArray) {
+		i -= exact_value_to_i64(*bt->EnumeratedArray.min_value);
+	}
+	if (i < 0 || i >= count) {
+		return check_eval_error(ev, node, "'#eval' index %lld is out of bounds 0..<%td", cast(long long)i, count);
+	}
+	*index_ = cast(isize)i;
+	return true;
+}
+
+// NOTE: Returns the storage of an addressable expression, or evaluates it into `tmp`
+gb_internal CheckEvalValue *check_eval_ref(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node, CheckEvalValue *tmp) {
+	switch (node->kind) {
+	case_ast_node(pe, ParenExpr, node);
+		return check_eval_ref(ev, f, pe->expr, tmp);
+	case_end;
+
+	case_ast_node(i, Ident, node);
+		if (node->tav.mode != Addressing_Constant) {
+			Entity *e = entity_of_node(node);
+			CheckEvalValue **found = e != nullptr ? map_get(&f->locals, e) : nullptr;
+			if (found == nullptr) {
+				check_eval_error(ev, node, "'#eval' cannot refer to '%.*s' as it is neither a local variable nor a constant", LIT(i->token.string));
+				return nullptr;
+			}
+			return *found;
+		}
+	case_end;
+
+	case_ast_node(ie, IndexExpr, node);
+		Type *type = type_of_expr(ie->expr);
+		if (node->tav.mode != Addressing_Constant && check_eval_is_aggregate(type) && base_type(type)->kind != Type_Struct) {
+			CheckEvalValue *base = check_eval_ref(ev, f, ie->expr, tmp);
+			isize index = 0;
+			if (base == nullptr || !check_eval_index(ev, f, ie->index, type, base->elem_count, &index)) {
+				return nullptr;
+			}
+			return &base->elems[index];
+		}
+	case_end;
+
+	case_ast_node(se, SelectorExpr, node);
+		Type *type = type_of_expr(se->expr);
+		if (node->tav.mode != Addressing_Constant && se->selector->kind == Ast_Ident && se->swizzle_count == 0 &&
+		    se->expr->tav.mode != Addressing_Invalid && se->expr->tav.mode != Addressing_Type &&
+		    base_type(type)->kind == Type_Struct) {
+			Selection sel = lookup_field(type, se->selector->Ident.interned, false);
+			if (sel.entity == nullptr || sel.indirect || sel.pseudo_field) {
+				check_eval_unsupported(ev, node);
+				return nullptr;
+			}
+			CheckEvalValue *base = check_eval_ref(ev, f, se->expr, tmp);
+			for (i32 index : sel.index) {
+				if (base == nullptr || index >= base->elem_count) {
+					check_eval_unsupported(ev, node);
+					return nullptr;
+				}
+				base = &base->elems[index];
+			}
+			return base;
+		}
+	case_end;
+	}
+
+	if (!check_eval_expr(ev, f, node, tmp)) {
+		return nullptr;
+	}
+	return tmp;
+}
+
+gb_internal bool check_eval_binary_op(CheckEvaluator *ev, Ast *node, TokenKind op, ExactValue x, ExactValue y, Type *type, ExactValue *out) {
+	switch (op) {
+	case Token_CmpEq:
+	case Token_NotEq:
+	case Token_Lt:
+	case Token_Gt:
+	case Token_LtEq:
+	case Token_GtEq:
+		*out = exact_value_bool(compare_exact_values(op, x, y));
+		return true;
+	}
+
+	Type *t = check_eval_scalar_type(type);
+	if (t == nullptr) {
+		return check_eval_unsupported(ev, node);
+	}
+	if (is_type_integer(t) || (is_type_untyped(t) && x.kind == ExactValue_Integer && y.kind == ExactValue_Integer)) {
+		if (op == Token_Quo) {
+			op = Token_QuoEq; // NOTE: integer division, see `check_binary_expr`
+		}
+		if ((op == Token_QuoEq || op == Token_Mod || op == Token_ModMod) &&
+		    y.kind == ExactValue_Integer && big_int_is_zero(&y.value_integer)) {
+			return check_eval_error(ev, node, "'#eval' integer division by zero");
+		}
+	}
+
+	ExactValue res = exact_binary_operator_value(op, x, y);
+	if (res.kind == ExactValue_Invalid) {
+		return check_eval_error(ev, node, "'#eval' does not support the operator '%.*s' here", LIT(token_strings[op]));
+	}
+	return check_eval_convert(ev, node, res, type, out);
+}
+
+gb_internal bool check_eval_call(CheckEvaluator *ev, CheckEvalFrame *f, Ast *call, CheckEvalValue *out);
+
+gb_internal bool check_eval_expr(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node, CheckEvalValue *out) {
+	if (!check_eval_step(ev, node)) {
+		return false;
+	}
+	gb_zero_item(out);
+
+	TypeAndValue tav = node->tav;
+	if (tav.mode == Addressing_Constant) {
+		return check_eval_constant(ev, node, tav.type, tav.value, out);
+	}
+
+	switch (node->kind) {
+	case_ast_node(pe, ParenExpr, node);
+		return check_eval_expr(ev, f, pe->expr, out);
+	case_end;
+
+	case Ast_Ident:
+	case Ast_IndexExpr:
+	case Ast_SelectorExpr: {
+		if (node->kind == Ast_IndexExpr && is_type_string(type_of_expr(node->IndexExpr.expr))) {
+			CheckEvalValue str = {};
+			if (!check_eval_expr(ev, f, node->IndexExpr.expr, &str)) {
+				return false;
+			}
+			isize index = 0;
+			if (!check_eval_index(ev, f, node->IndexExpr.index, t_int, str.value.value_string.len, &index)) {
+				return false;
+			}
+			out->value = exact_value_u64(str.value.value_string[index]);
+			return true;
+		}
+		CheckEvalValue tmp = {};
+		CheckEvalValue *v = check_eval_ref(ev, f, node, &tmp);
+		if (v == nullptr) {
+			return false;
+		}
+		if (v == &tmp) {
+			*out = tmp;
+			return true;
+		}
+		return check_eval_copy(ev, node, out, v);
+	}
+
+	case_ast_node(be, BinaryExpr, node);
+		TokenKind op = be->op.kind;
+		CheckEvalValue x = {};
+		CheckEvalValue y = {};
+		if (!check_eval_expr(ev, f, be->left, &x)) {
+			return false;
+		}
+		if (op == Token_CmpAnd || op == Token_CmpOr) {
+			if (x.value.kind != ExactValue_Bool) {
+				return check_eval_unsupported(ev, node);
+			}
+			if (x.value.value_bool == (op == Token_CmpOr)) {
+				out->value = x.value;
+				return true;
+			}
+			if (!check_eval_expr(ev, f, be->right, &y)) {
+				return false;
+			}
+			out->value = y.value;
+			return true;
+		}
+		if (!check_eval_expr(ev, f, be->right, &y)) {
+			return false;
+		}
+		if (x.elems != nullptr || y.elems != nullptr) {
+			return check_eval_unsupported(ev, node);
+		}
+		return check_eval_binary_op(ev, node, op, x.value, y.value, tav.type, &out->value);
+	case_end;
+
+	case_ast_node(ue, UnaryExpr, node);
+		CheckEvalValue x = {};
+		if (!check_eval_expr(ev, f, ue->expr, &x)) {
+			return false;
+		}
+		Type *t = check_eval_scalar_type(tav.type);
+		if (x.elems != nullptr || t == nullptr) {
+			return check_eval_unsupported(ev, node);
+		}
+		i32 precision = 0;
+		if (ue->op.kind == Token_Xor) {
+			if (is_type_untyped(t)) {
+				return check_eval_unsupported(ev, node);
+			}
+			precision = cast(i32)(8*type_size_of(t));
+		}
+		ExactValue res = exact_unary_operator_value(ue->op.kind, x.value, precision, is_type_unsigned(t));
+		if (res.kind == ExactValue_Invalid) {
+			return check_eval_unsupported(ev, node);
+		}
+		return check_eval_convert(ev, node, res, tav.type, &out->value);
+	case_end;
+
+	case_ast_node(te, TernaryIfExpr, node);
+		CheckEvalValue cond = {};
+		if (!check_eval_expr(ev, f, te->cond, &cond)) {
+			return false;
+		}
+		if (cond.value.kind != ExactValue_Bool) {
+			return check_eval_unsupported(ev, node);
+		}
+		CheckEvalValue v = {};
+		if (!check_eval_expr(ev, f, cond.value.value_bool ? te->x : te->y, &v)) {
+			return false;
+		}
+		return check_eval_assign(ev, node, out, &v, tav.type);
+	case_end;
+
+	case_ast_node(tc, TypeCast, node);
+		if (tc->token.kind != Token_cast) {
+			return check_eval_unsupported(ev, node);
+		}
+		CheckEvalValue v = {};
+		if (!check_eval_expr(ev, f, tc->expr, &v)) {
+			return false;
+		}
+		return check_eval_assign(ev, node, out, &v, tav.type);
+	case_end;
+
+	case_ast_node(cl, CompoundLit, node);
+		Type *type = tav.type;
+		if (!check_eval_is_aggregate(type)) {
+			return check_eval_unsupported(ev, node);
+		}
+		if (!check_eval_zero(ev, node, out, type)) {
+			return false;
+		}
+		bool is_struct = base_type(type)->kind == Type_Struct;
+		for_array(i, cl->elems) {
+			Ast *elem = cl->elems[i];
+			Ast *value = elem;
+			isize index = i;
+			if (elem->kind == Ast_FieldValue) {
+				ast_node(fv, FieldValue, elem);
+				value = fv->value;
+				if (is_struct && fv->field->kind == Ast_Ident) {
+					Selection sel = lookup_field(type, fv->field->Ident.interned, false);
+					if (sel.index.count != 1) {
+						return check_eval_unsupported(ev, elem);
+					}
+					index = sel.index[0];
+				} else if (!is_struct && fv->field->tav.mode == Addressing_Constant) {
+					index = cast(isize)exact_value_to_i64(fv->field->tav.value);
+					if (base_type(type)->kind == Type_EnumeratedArray) {
+						index -= cast(isize)exact_value_to_i64(*base_type(type)->EnumeratedArray.min_value);
+					}
+				} else {
+					return check_eval_unsupported(ev, elem);
+				}
+			}
+			if (index < 0 || index >= out->elem_count) {
+				return check_eval_unsupported(ev, elem);
+			}
+			CheckEvalValue v = {};
+			if (!check_eval_expr(ev, f, value, &v) ||
+			    !check_eval_assign(ev, value, &out->elems[index], &v, check_eval_aggregate_elem(type, index))) {
+				return false;
+			}
+		}
+		return true;
+	case_end;
+
+	case Ast_CallExpr:
+		return check_eval_call(ev, f, node, out);
+	}
+
+	return check_eval_unsupported(ev, node);
+}
+
+gb_internal bool check_eval_builtin_call(CheckEvaluator *ev, CheckEvalFrame *f, Ast *call, BuiltinProcId id, CheckEvalValue *out) {
+	ast_node(ce, CallExpr, call);
+	Type *type = call->tav.type;
+
+	switch (id) {
+	case BuiltinProc_len: {
+		CheckEvalValue x = {};
+		if (!check_eval_expr(ev, f, ce->args[0], &x)) {
+			return false;
+		}
+		if (x.value.kind != ExactValue_String) {
+			return check_eval_unsupported(ev, call);
+		}
+		return check_eval_convert(ev, call, exact_value_i64(x.value.value_string.len), type, &out->value);
+	}
+
+	case BuiltinProc_abs: {
+		CheckEvalValue x = {};
+		if (!check_eval_expr(ev, f, ce->args[0], &x)) {
+			return false;
+		}
+		ExactValue v = x.value;
+		if (compare_exact_values(Token_Lt, v, exact_value_i64(0))) {
+			v = exact_unary_operator_value(Token_Sub, v, 0, false);
+		}
+		return check_eval_convert(ev, call, v, type, &out->value);
+	}
+
+	case BuiltinProc_min:
+	case BuiltinProc_max: {
+		if (ce->args.count < 2) {
+			return check_eval_unsupported(ev, call);
+		}
+		TokenKind op = id == BuiltinProc_min ? Token_Lt : Token_Gt;
+		ExactValue res = {};
+		for_array(i, ce->args) {
+			CheckEvalValue x = {};
+			if (!check_eval_expr(ev, f, ce->args[i], &x)) {
+				return false;
+			}
+			if (x.elems != nullptr) {
+				return check_eval_unsupported(ev, call);
+			}
+			if (i == 0 || compare_exact_values(op, x.value, res)) {
+				res = x.value;
+			}
+		}
+		return check_eval_convert(ev, call, res, type, &out->value);
+	}
+	}
+
+	return check_eval_error(ev, call, "'#eval' does not support the built-in procedure '%.*s'", LIT(builtin_procs[id].name));
+}
+
+gb_internal bool check_eval_ensure_body_checked(CheckEvaluator *ev, Ast *node, Entity *e) {
+	DeclInfo *decl = e->decl_info;
+	if (decl->proc_checked_state.load() == ProcCheckedState_Checked) {
+		return true;
+	}
+
+	ProcInfo pi = {};
+	pi.file  = e->file;
+	pi.token = e->token;
+	pi.decl  = decl;
+	pi.type  = e->type;
+	pi.body  = decl->proc_lit->ProcLit.body;
+	pi.tags  = e->Procedure.tags;
+
+	UntypedExprInfoMap untyped = {};
+	bool ok = check_proc_info(ev->c->checker, &pi, &untyped);
+	untyped_expr_info_map_destroy(&untyped);
+	if (!ok) {
+		return check_eval_error(ev, node, "'#eval' cannot evaluate '%.*s' as its body could not be checked (is it evaluated within its own body?)", LIT(e->token.string));
+	}
+	return true;
+}
+
+gb_internal bool check_eval_call(CheckEvaluator *ev, CheckEvalFrame *f, Ast *call, CheckEvalValue *out) {
+	ast_node(ce, CallExpr, call);
+	Ast *proc = unparen_expr(ce->proc);
+
+	for (Ast *arg : ce->args) {
+		if (arg->kind == Ast_FieldValue || arg->kind == Ast_Ellipsis) {
+			return check_eval_error(ev, arg, "'#eval' only supports positional arguments");
+		}
+	}
+
+	if (proc->tav.mode == Addressing_Type) {
+		// NOTE: conversion, e.g. `u32(x)`
+		if (ce->args.count != 1) {
+			return check_eval_unsupported(ev, call);
+		}
+		CheckEvalValue v = {};
+		if (!check_eval_expr(ev, f, ce->args[0], &v)) {
+			return false;
+		}
+		return check_eval_assign(ev, call, out, &v, call->tav.type);
+	}
+
+	Entity *e = entity_of_node(proc);
+	if (proc->tav.mode == Addressing_Builtin) {
+		if (e == nullptr || e->kind != Entity_Builtin) {
+			return check_eval_unsupported(ev, call);
+		}
+		return check_eval_builtin_call(ev, f, call, cast(BuiltinProcId)e->Builtin.id, out);
+	}
+
+	if (e == nullptr || e->kind != Entity_Procedure) {
+		return check_eval_error(ev, call, "'#eval' can only call procedures by name");
+	}
+	String name = e->token.string;
+	DeclInfo *decl = e->decl_info;
+	if (e->Procedure.is_foreign || decl == nullptr || decl->proc_lit == nullptr ||
+	    decl->proc_lit->kind != Ast_ProcLit || decl->proc_lit->ProcLit.body == nullptr) {
+		return check_eval_error(ev, call, "'#eval' cannot call '%.*s' as it has no body", LIT(name));
+	}
+
+	Type *pt = base_type(e->type);
+	GB_ASSERT(pt->kind == Type_Proc);
+	if (pt->Proc.is_polymorphic && !pt->Proc.is_poly_specialized) {
+		return check_eval_error(ev, call, "'#eval' cannot call the polymorphic procedure '%.*s'", LIT(name));
+	}
+	if (pt->Proc.variadic || pt->Proc.result_count > 1) {
+		return check_eval_error(ev, call, "'#eval' can only call procedures with at most one result and no variadic parameters, got '%.*s'", LIT(name));
+	}
+	isize param_count = pt->Proc.param_count;
+	if (ce->args.count > param_count) {
+		return check_eval_unsupported(ev, call);
+	}
+
+	if (!check_eval_ensure_body_checked(ev, call, e)) {
+		return false;
+	}
+
+	if (ev->depth >= CHECK_EVAL_DEPTH_LIMIT) {
+		return check_eval_error(ev, call, "'#eval' exceeded its call depth limit of %d", CHECK_EVAL_DEPTH_LIMIT);
+	}
+
+	CheckEvalFrame frame = {};
+	frame.proc_type = &pt->Proc;
+	map_init(&frame.locals);
+	defer (map_destroy(&frame.locals));
+
+	for (isize i = 0; i < param_count; i++) {
+		Entity *param = pt->Proc.params->Tuple.variables[i];
+		CheckEvalValue *v = check_eval_alloc(ev, 1);
+		CheckEvalValue arg = {};
+		if (i < ce->args.count) {
+			if (!check_eval_expr(ev, f, ce->args[i], &arg)) {
+				return false;
+			}
+		} else if (param->kind == Entity_Variable && param->Variable.param_value.kind == ParameterValue_Constant) {
+			if (!check_eval_constant(ev, call, param->type, param->Variable.param_value.value, &arg)) {
+				return false;
+			}
+		} else {
+			return check_eval_error(ev, call, "'#eval' cannot pass the default value of '%.*s'", LIT(param->token.string));
+		}
+		if (!check_eval_assign(ev, call, v, &arg, param->type)) {
+			return false;
+		}
+		map_set(&frame.locals, param, v);
+	}
+
+	Entity *named_result = nullptr;
+	if (pt->Proc.result_count == 1) {
+		Entity *result = pt->Proc.results->Tuple.variables[0];
+		if (pt->Proc.has_named_results) {
+			named_result = result;
+			CheckEvalValue *v = check_eval_alloc(ev, 1);
+			if (!check_eval_zero(ev, call, v, result->type)) {
+				return false;
+			}
+			map_set(&frame.locals, result, v);
+		}
+	}
+
+	ev->depth += 1;
+	CheckEvalFlow flow = check_eval_stmt(ev, &frame, decl->proc_lit->ProcLit.body);
+	ev->depth -= 1;
+	if (flow == CheckEvalFlow_Failed) {
+		return false;
+	}
+
+	if (pt->Proc.result_count == 1) {
+		if (flow != CheckEvalFlow_Return) {
+			if (named_result == nullptr) {
+				return check_eval_error(ev, call, "'#eval' reached the end of '%.*s' without a return", LIT(name));
+			}
+			frame.result = **map_get(&frame.locals, named_result);
+		}
+		*out = frame.result;
+	}
+	return true;
+}
+
+gb_internal CheckEvalFlow check_eval_stmts(CheckEvaluator *ev, CheckEvalFrame *f, Slice<Ast *> const &stmts) {
+	for (Ast *stmt : stmts) {
+		CheckEvalFlow flow = check_eval_stmt(ev, f, stmt);
+		if (flow != CheckEvalFlow_Next) {
+			return flow;
+		}
+	}
+	return CheckEvalFlow_Next;
+}
+
+gb_internal bool check_eval_bool(CheckEvaluator *ev, CheckEvalFrame *f, Ast *cond, bool *value_) {
+	CheckEvalValue v = {};
+	if (!check_eval_expr(ev, f, cond, &v)) {
+		return false;
+	}
+	if (v.value.kind != ExactValue_Bool) {
+		return check_eval_error(ev, cond, "'#eval' expected a boolean condition");
+	}
+	*value_ = v.value.value_bool;
+	return true;
+}
+
+gb_internal bool check_eval_bind(CheckEvaluator *ev, CheckEvalFrame *f, Ast *name, CheckEvalValue *value) {
+	Entity *e = entity_of_node(name);
+	if (e == nullptr || is_blank_ident(name)) {
+		return true;
+	}
+	CheckEvalValue *v = check_eval_alloc(ev, 1);
+	if (!check_eval_assign(ev, name, v, value, e->type)) {
+		return false;
+	}
+	map_set(&f->locals, e, v);
+	return true;
+}
+
+// NOTE: Runs the body of a loop, returns true if the loop should continue
+gb_internal bool check_eval_loop_body(CheckEvaluator *ev, CheckEvalFrame *f, Ast *body, CheckEvalFlow *flow_) {
+	CheckEvalFlow flow = check_eval_stmt(ev, f, body);
+	switch (flow) {
+	case CheckEvalFlow_Next:
+	case CheckEvalFlow_Continue:
+		return true;
+	case CheckEvalFlow_Break:
+		return false;
+	}
+	*flow_ = flow;
+	return false;
+}
+
+gb_internal CheckEvalFlow check_eval_stmt(CheckEvaluator *ev, CheckEvalFrame *f, Ast *node) {
+	if (node == nullptr) {
+		return CheckEvalFlow_Next;
+	}
+	if (!check_eval_step(ev, node)) {
+		return CheckEvalFlow_Failed;
+	}
+
+	switch (node->kind) {
+	case Ast_EmptyStmt:
+		return CheckEvalFlow_Next;
+
+	case_ast_node(bs, BlockStmt, node);
+		if (bs->label != nullptr) {
+			break;
+		}
+		return check_eval_stmts(ev, f, bs->stmts);
+	case_end;
+
+	case_ast_node(es, ExprStmt, node);
+		CheckEvalValue v = {};
+		if (!check_eval_expr(ev, f, es->expr, &v)) {
+			return CheckEvalFlow_Failed;
+		}
+		return CheckEvalFlow_Next;
+	case_end;
+
+	case_ast_node(vd, ValueDecl, node);
+		if (!vd->is_mutable) {
+			return CheckEvalFlow_Next; // NOTE: constants, types and nested procedures
+		}
+		if (vd->attributes.count != 0) {
+			break;
+		}
+		if (vd->values.count != 0 && vd->values.count != vd->names.count) {
+			break;
+		}
+		for_array(i, vd->names) {
+			Ast *name = vd->names[i];
+			Entity *e = entity_of_node(name);
+			CheckEvalValue v = {};
+			if (vd->values.count != 0) {
+				if (!check_eval_expr(ev, f, vd->values[i], &v)) {
+					return CheckEvalFlow_Failed;
+				}
+			} else if (e != nullptr && !check_eval_zero(ev, name, &v, e->type)) {
+				return CheckEvalFlow_Failed;
+			}
+			if (!check_eval_bind(ev, f, name, &v)) {
+				return CheckEvalFlow_Failed;
+			}
+		}
+		return CheckEvalFlow_Next;
+	case_end;
+
+	case_ast_node(as, AssignStmt, node);
+		if (as->lhs.count != as->rhs.count) {
+			break;
+		}
+		if (as->op.kind == Token_Eq) {
+			TEMPORARY_ALLOCATOR_GUARD();
+			CheckEvalValue *values = gb_alloc_array(temporary_allocator(), CheckEvalValue, as->rhs.count);
+			for_array(i, as->rhs) {
+				if (!check_eval_expr(ev, f, as->rhs[i], &values[i])) {
+					return CheckEvalFlow_Failed;
+				}
+			}
+			for_array(i, as->lhs) {
+				Ast *lhs = as->lhs[i];
+				if (is_blank_ident(lhs)) {
+					continue;
+				}
+				CheckEvalValue tmp = {};
+				CheckEvalValue *dst = check_eval_ref(ev, f, lhs, &tmp);
+				if (dst == nullptr || dst == &tmp) {
+					check_eval_unsupported(ev, lhs);
+					return CheckEvalFlow_Failed;
+				}
+				if (!check_eval_assign(ev, lhs, dst, &values[i], type_of_expr(lhs))) {
+					return CheckEvalFlow_Failed;
+				}
+			}
+			return CheckEvalFlow_Next;
+		}
+
+		if (!gb_is_between(as->op.kind, Token__AssignOpBegin+1, Token__AssignOpEnd-1) || as->lhs.count != 1) {
+			break;
+		}
+		TokenKind op = cast(TokenKind)(cast(i32)as->op.kind - (Token_AddEq - Token_Add));
+		Ast *lhs = as->lhs[0];
+		CheckEvalValue tmp = {};
+		CheckEvalValue *dst = check_eval_ref(ev, f, lhs, &tmp);
+		if (dst == nullptr || dst == &tmp || dst->elems != nullptr) {
+			check_eval_unsupported(ev, lhs);
+			return CheckEvalFlow_Failed;
+		}
+		CheckEvalValue y = {};
+		if (op == Token_CmpAnd || op == Token_CmpOr) {
+			if (dst->value.kind == ExactValue_Bool && dst->value.value_bool == (op == Token_CmpOr)) {
+				return CheckEvalFlow_Next;
+			}
+			if (!check_eval_expr(ev, f, as->rhs[0], &y) || !check_eval_convert(ev, node, y.value, type_of_expr(lhs), &dst->value)) {
+				return CheckEvalFlow_Failed;
+			}
+			return CheckEvalFlow_Next;
+		}
+		if (!check_eval_expr(ev, f, as->rhs[0], &y)) {
+			return CheckEvalFlow_Failed;
+		}
+		if (y.elems != nullptr) {
+			check_eval_unsupported(ev, node);
+			return CheckEvalFlow_Failed;
+		}
+		if (!check_eval_binary_op(ev, node, op, dst->value, y.value, type_of_expr(lhs), &dst->value)) {
+			return CheckEvalFlow_Failed;
+		}
+		return CheckEvalFlow_Next;
+	case_end;
+
+	case_ast_node(is, IfStmt, node);
+		if (is->label != nullptr) {
+			break;
+		}
+		CheckEvalFlow flow = check_eval_stmt(ev, f, is->init);
+		if (flow != CheckEvalFlow_Next) {
+			return flow;
+		}
+		bool cond = false;
+		if (!check_eval_bool(ev, f, is->cond, &cond)) {
+			return CheckEvalFlow_Failed;
+		}
+		return check_eval_stmt(ev, f, cond ? is->body : is->else_stmt);
+	case_end;
+
+	case_ast_node(ws, WhenStmt, node);
+		if (!ws->is_cond_determined) {
+			break;
+		}
+		return check_eval_stmt(ev, f, ws->determined_cond ? ws->body : ws->else_stmt);
+	case_end;
+
+	case_ast_node(fs, ForStmt, node);
+		if (fs->label != nullptr) {
+			break;
+		}
+		CheckEvalFlow flow = check_eval_stmt(ev, f, fs->init);
+		if (flow != CheckEvalFlow_Next) {
+			return flow;
+		}
+		for (;;) {
+			if (fs->cond != nullptr) {
+				bool cond = false;
+				if (!check_eval_bool(ev, f, fs->cond, &cond)) {
+					return CheckEvalFlow_Failed;
+				}
+				if (!cond) {
+					break;
+				}
+			}
+			if (!check_eval_loop_body(ev, f, fs->body, &flow)) {
+				return flow;
+			}
+			flow = check_eval_stmt(ev, f, fs->post);
+			if (flow != CheckEvalFlow_Next) {
+				return flow;
+			}
+		}
+		return CheckEvalFlow_Next;
+	case_end;
+
+	case_ast_node(rs, RangeStmt, node);
+		if (rs->label != nullptr || rs->reverse || rs->vals.count > 2) {
+			break;
+		}
+		Ast *val0 = rs->vals.count > 0 ? rs->vals[0] : nullptr;
+		Ast *val1 = rs->vals.count > 1 ? rs->vals[1] : nullptr;
+		CheckEvalFlow flow = CheckEvalFlow_Next;
+
+		Ast *expr = unparen_expr(rs->expr);
+		if (is_ast_range(expr)) {
+			ast_node(ie, BinaryExpr, expr);
+			CheckEvalValue lo = {};
+			CheckEvalValue hi = {};
+			if (!check_eval_expr(ev, f, ie->left, &lo) || !check_eval_expr(ev, f, ie->right, &hi)) {
+				return CheckEvalFlow_Failed;
+			}
+			if (lo.value.kind != ExactValue_Integer || hi.value.kind != ExactValue_Integer) {
+				break;
+			}
+			TokenKind cmp = ie->op.kind == Token_RangeHalf ? Token_Lt : Token_LtEq;
+			for (i64 i = 0; ; i++) {
+				ExactValue index = exact_value_i64(i);
+				CheckEvalValue value = {};
+				value.value = exact_binary_operator_value(Token_Add, lo.value, index);
+				if (!compare_exact_values(cmp, value.value, hi.value)) {
+					break;
+				}
+				CheckEvalValue index_value = {};
+				index_value.value = index;
+				if ((val0 && !check_eval_bind(ev, f, val0, &value)) ||
+				    (val1 && !check_eval_bind(ev, f, val1, &index_value))) {
+					return CheckEvalFlow_Failed;
+				}
+				if (!check_eval_loop_body(ev, f, rs->body, &flow)) {
+					return flow;
+				}
+			}
+			return CheckEvalFlow_Next;
+		}
+
+		Type *type = type_of_expr(expr);
+		Type *bt = base_type(type);
+		if (expr->tav.mode == Addressing_Type && bt->kind == Type_Enum) {
+			for_array(i, bt->Enum.fields) {
+				CheckEvalValue value = {};
+				CheckEvalValue index_value = {};
+				value.value = bt->Enum.fields[i]->Constant.value;
+				index_value.value = exact_value_i64(i);
+				if ((val0 && !check_eval_bind(ev, f, val0, &value)) ||
+				    (val1 && !check_eval_bind(ev, f, val1, &index_value))) {
+					return CheckEvalFlow_Failed;
+				}
+				if (!check_eval_loop_body(ev, f, rs->body, &flow)) {
+					return flow;
+				}
+			}
+			return CheckEvalFlow_Next;
+		}
+		if (!check_eval_is_aggregate(type) || bt->kind == Type_Struct) {
+			break;
+		}
+
+		// NOTE: `for &x in array` refers to the elements in place, so the array itself must be addressable
+		bool by_ref = val0 != nullptr && val0->kind == Ast_UnaryExpr && val0->UnaryExpr.op.kind == Token_And;
+		CheckEvalValue tmp = {};
+		CheckEvalValue *array = check_eval_ref(ev, f, expr, &tmp);
+		if (array == nullptr) {
+			return CheckEvalFlow_Failed;
+		}
+		for (isize i = 0; i < array->elem_count; i++) {
+			CheckEvalValue index_value = {};
+			index_value.value = exact_value_i64(i);
+			if (bt->kind == Type_EnumeratedArray) {
+				index_value.value = exact_binary_operator_value(Token_Add, *bt->EnumeratedArray.min_value, index_value.value);
+			}
+			if (by_ref) {
+				Entity *e = entity_of_node(val0->UnaryExpr.expr);
+				if (e != nullptr) {
+					map_set(&f->locals, e, &array->elems[i]);
+				}
+			} else if (val0 != nullptr) {
+				CheckEvalValue value = {};
+				if (!check_eval_copy(ev, val0, &value, &array->elems[i]) || !check_eval_bind(ev, f, val0, &value)) {
+					return CheckEvalFlow_Failed;
+				}
+			}
+			if (val1 && !check_eval_bind(ev, f, val1, &index_value)) {
+				return CheckEvalFlow_Failed;
+			}
+			if (!check_eval_loop_body(ev, f, rs->body, &flow)) {
+				return flow;
+			}
+		}
+		return CheckEvalFlow_Next;
+	case_end;
+
+	case_ast_node(ss, SwitchStmt, node);
+		if (ss->label != nullptr || ss->body == nullptr || ss->body->kind != Ast_BlockStmt) {
+			break;
+		}
+		CheckEvalFlow flow = check_eval_stmt(ev, f, ss->init);
+		if (flow != CheckEvalFlow_Next) {
+			return flow;
+		}
+		CheckEvalValue tag = {};
+		tag.value = exact_value_bool(true);
+		if (ss->tag != nullptr && !check_eval_expr(ev, f, ss->tag, &tag)) {
+			return CheckEvalFlow_Failed;
+		}
+		if (tag.elems != nullptr) {
+			break;
+		}
+
+		Ast *default_clause = nullptr;
+		Ast *match = nullptr;
+		for (Ast *clause : ss->body->BlockStmt.stmts) {
+			ast_node(cc, CaseClause, clause);
+			if (cc->list.count == 0) {
+				default_clause = clause;
+				continue;
+			}
+			for (Ast *expr : cc->list) {
+				expr = unparen_expr(expr);
+				bool matches = false;
+				if (is_ast_range(expr)) {
+					ast_node(ie, BinaryExpr, expr);
+					CheckEvalValue lo = {};
+					CheckEvalValue hi = {};
+					if (!check_eval_expr(ev, f, ie->left, &lo) || !check_eval_expr(ev, f, ie->right, &hi)) {
+						return CheckEvalFlow_Failed;
+					}
+					TokenKind cmp = ie->op.kind == Token_RangeHalf ? Token_Lt : Token_LtEq;
+					matches = compare_exact_values(Token_GtEq, tag.value, lo.value) && compare_exact_values(cmp, tag.value, hi.value);
+				} else {
+					CheckEvalValue v = {};
+					if (!check_eval_expr(ev, f, expr, &v)) {
+						return CheckEvalFlow_Failed;
+					}
+					matches = compare_exact_values(Token_CmpEq, tag.value, v.value);
+				}
+				if (matches) {
+					match = clause;
+					break;
+				}
+			}
+			if (match != nullptr) {
+				break;
+			}
+		}
+		if (match == nullptr) {
+			match = default_clause;
+		}
+		if (match == nullptr) {
+			return CheckEvalFlow_Next;
+		}
+		for (Ast *stmt : match->CaseClause.stmts) {
+			if (stmt->kind == Ast_BranchStmt && stmt->BranchStmt.token.kind == Token_fallthrough) {
+				check_eval_unsupported(ev, stmt);
+				return CheckEvalFlow_Failed;
+			}
+		}
+		flow = check_eval_stmts(ev, f, match->CaseClause.stmts);
+		return flow == CheckEvalFlow_Break ? CheckEvalFlow_Next : flow;
+	case_end;
+
+	case_ast_node(rs, ReturnStmt, node);
+		TypeProc *pt = f->proc_type;
+		if (rs->results.count == 0) {
+			if (pt->result_count == 1) {
+				Entity *result = pt->results->Tuple.variables[0];
+				f->result = **map_get(&f->locals, result);
+			}
+			return CheckEvalFlow_Return;
+		}
+		if (rs->results.count != 1 || pt->result_count != 1) {
+			break;
+		}
+		CheckEvalValue v = {};
+		if (!check_eval_expr(ev, f, rs->results[0], &v) ||
+		    !check_eval_assign(ev, rs->results[0], &f->result, &v, pt->results->Tuple.variables[0]->type)) {
+			return CheckEvalFlow_Failed;
+		}
+		return CheckEvalFlow_Return;
+	case_end;
+
+	case_ast_node(bs, BranchStmt, node);
+		if (bs->label != nullptr) {
+			break;
+		}
+		switch (bs->token.kind) {
+		case Token_break:    return CheckEvalFlow_Break;
+		case Token_continue: return CheckEvalFlow_Continue;
+		}
+	case_end;
+	}
+
+	check_eval_unsupported(ev, node);
+	return CheckEvalFlow_Failed;
+}
+
+gb_internal ExactValue check_eval_to_exact_value(CheckEvaluator *ev, Ast *node, CheckEvalValue const *v, Type *type) {
+	if (!check_eval_is_aggregate(type)) {
+		return v->value;
+	}
+
+	AstFile *f = ev->c->file;
+	Token token = ast_token(node);
+
+	isize count = v->elem_count;
+	Slice<Ast *> elems = permanent_slice_make<Ast *>(count);
+	for (isize i = 0; i < count; i++) {
+		Type *elem_type = check_eval_aggregate_elem(type, i);
+		ExactValue value = check_eval_to_exact_value(ev, node, &v->elems[i], elem_type);
+
+		Ast *elem = nullptr;
+		if (value.kind == ExactValue_Compound) {
+			elem = value.value_compound;
+		} else {
+			elem = alloc_ast_node(f, Ast_BasicLit);
+			Token lit = token;
+			switch (value.kind) {
+			case ExactValue_Bool:    lit.kind = Token_Ident;   break;
+			case ExactValue_Integer: lit.kind = Token_Integer; break;
+			case ExactValue_Float:   lit.kind = Token_Float;   break;
+			case ExactValue_String:  lit.kind = Token_String;  break;
+			}
+			lit.string = make_string_c(exact_value_to_string(value));
+			elem->BasicLit.token = lit;
+			elem->tav.mode  = Addressing_Constant;
+			elem->tav.type  = elem_type;
+			elem->tav.value = value;
+		}
+		elems[i] = elem;
+	}
+
+	Ast *lit = alloc_ast_node(f, Ast_CompoundLit);
+	lit->CompoundLit.elems = elems;
+	lit->CompoundLit.open = token;
+	lit->CompoundLit.close = ast_end_token(node);
+	lit->CompoundLit.max_count = count;
+
+	ExactValue value = exact_value_compound(lit);
+	lit->tav.mode  = Addressing_Constant;
+	lit->tav.type  = type;
+	lit->tav.value = value;
+	return value;
+}
+
+gb_internal bool check_eval_directive(CheckerContext *c, Operand *operand, Ast *call, Ast *arg) {
+	if (!in_single_threaded_checker_stage.load(std::memory_order_relaxed)) {
+		error(call, "'#eval' is only allowed within package level declarations");
+		return false;
+	}
+
+	Ast *expr = unparen_expr(arg);
+	if (expr == nullptr || expr->kind != Ast_CallExpr) {
+		error(arg, "'#eval' expects a procedure call");
+		return false;
+	}
+
+	// NOTE: the procedures are never called at runtime, so they do not need a 'context'
+	auto prev_flags = c->scope->flags;
+	c->scope->flags |= ScopeFlag_ContextDefined;
+	Operand o = {};
+	check_expr(c, &o, expr);
+	c->scope->flags = prev_flags;
+	if (o.mode == Addressing_Invalid) {
+		return false;
+	}
+	if (o.mode == Addressing_NoValue || o.type == nullptr || is_type_tuple(o.type)) {
+		error(arg, "'#eval' expects a call which returns a single value");
+		return false;
+	}
+	if (o.mode == Addressing_Constant) {
+		*operand = o;
+		return true;
+	}
+	if (!check_eval_is_aggregate(o.type) && check_eval_scalar_type(o.type) == nullptr) {
+		gbString s = type_to_string(o.type);
+		error(arg, "'#eval' does not support values of type '%s'", s);
+		gb_string_free(s);
+		return false;
+	}
+
+	CheckEvaluator ev = {};
+	ev.c = c;
+	ev.arena.parent_thread = get_current_thread();
+	defer (arena_free_all(&ev.arena));
+
+	CheckEvalFrame frame = {};
+	map_init(&frame.locals);
+	defer (map_destroy(&frame.locals));
+
+	CheckEvalValue result = {};
+	if (!check_eval_expr(&ev, &frame, expr, &result)) {
+		return false;
+	}
+
+	operand->mode  = Addressing_Constant;
+	operand->type  = o.type;
+	operand->value = check_eval_to_exact_value(&ev, call, &result, o.type);
+	return true;
+}
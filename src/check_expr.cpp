@@ -122,6 +122,9 @@ gb_internal isize get_procedure_param_count_excluding_defaults(Type *pt, isize *
 gb_internal bool is_expr_inferred_fixed_array(Ast *type_expr);
 
 gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands);
+gb_internal bool polymorphic_record_operands_hash(TypeTuple *params, isize param_count, Array<Operand> const &ordered_operands, u64 *hash_);
+gb_internal Entity *find_complete_polymorphic_record_entity(GenTypesData *found_gen_types, u64 hash, isize param_count, Array<Operand> const &ordered_operands);
+gb_internal void add_complete_polymorphic_record_entity(GenTypesData *found_gen_types, Entity *e);
 
 gb_internal bool complete_soa_type(Checker *checker, Type *t, bool wait_to_finish);
 
@@ -252,20 +255,51 @@ gb_internal void check_did_you_mean_type(String const &name, Slice<Entity *> con
 	check_did_you_mean_print(&d, prefix);
 }
 
+// NOTE: The entities of a package are all collected before anything is checked, so its scope no longer
+// changes and the bigram index can be built once and shared by every suggestion for that package
+gb_internal DidYouMeanIndex *did_you_mean_index_of_package(AstPackage *pkg) {
+	DidYouMeanIndex *index = pkg->did_you_mean_index.load(std::memory_order_acquire);
+	if (index != nullptr) {
+		return index;
+	}
+
+	Scope *scope = pkg->scope;
+	rw_mutex_shared_lock(&scope->mutex);
+	Array<String> targets = {};
+	array_init(&targets, permanent_allocator(), 0, scope->elements.count);
+	for (auto const &entry : scope->elements) {
+		String name = entry.value()->token.string;
+		if (name.len != 0 && name != "_") {
+			array_add(&targets, name);
+		}
+	}
+	rw_mutex_shared_unlock(&scope->mutex);
+
+	DidYouMeanIndex *new_index = did_you_mean_index_make(permanent_allocator(), slice_from_array(targets));
+	if (pkg->did_you_mean_index.compare_exchange_strong(index, new_index, std::memory_order_acq_rel)) {
+		return new_index;
+	}
+	return index;
+}
+
 gb_internal void check_did_you_mean_scope(String const &name, Scope *scope, char const *prefix = "") {
 	if (build_context.terse_errors) { return; }
 
 	ERROR_BLOCK();
 
-	DidYouMeanAnswers d = did_you_mean_make(heap_allocator(), scope->elements.count, name);
+	DidYouMeanAnswers d = did_you_mean_make(heap_allocator(), 0, name);
 	defer (did_you_mean_destroy(&d));
 
-	rw_mutex_shared_lock(&scope->mutex);
-	for (auto const &entry : scope->elements) {
-		Entity *e = entry.value;
-		did_you_mean_append(&d, e->token.string);
+	if ((scope->flags & ScopeFlag_Pkg) && scope->pkg != nullptr) {
+		did_you_mean_append_from_index(&d, did_you_mean_index_of_package(scope->pkg));
+	} else {
+		rw_mutex_shared_lock(&scope->mutex);
+		for (auto const &entry : scope->elements) {
+			Entity *e = entry.value();
+			did_you_mean_append(&d, e->token.string);
+		}
+		rw_mutex_shared_unlock(&scope->mutex);
 	}
-	rw_mutex_shared_unlock(&scope->mutex);
 	check_did_you_mean_print(&d, prefix);
 }
 
@@ -356,7 +390,7 @@ gb_internal void check_scope_decls(CheckerContext *c, Slice<Ast *> const &nodes,
 	check_collect_entities(c, nodes);
 
 	for (auto const &entry : s->elements) {
-		Entity *e = entry.value;\
+		Entity *e = entry.value();\
 		switch (e->kind) {
 		case Entity_Constant:
 		case Entity_TypeName:
@@ -372,6 +406,141 @@ gb_internal void check_scope_decls(CheckerContext *c, Slice<Ast *> const &nodes,
 	}
 }
 
+// NOTE: `gen_procs->mutex` must be held
+gb_internal Entity *find_generated_polymorphic_procedure(GenProcsData *gen_procs, Type *final_proc_type, u64 hash) {
+	for (auto *entry = multi_map_find_first(&gen_procs->procs_by_hash, hash);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&gen_procs->procs_by_hash, entry)) {
+		Entity *other = entry->value;
+		Type *pt = base_type(other->type);
+		if (are_types_identical(pt, final_proc_type)) {
+			return other;
+		}
+	}
+	return nullptr;
+}
+
+// NOTE: Returns false if the operands cannot be used as a key for `GenProcsData.resolutions`, i.e.
+// when inferring the specialization from them may depend on more than their types and values
+gb_internal bool polymorphic_proc_operands_hash(Array<Operand> const &operands, u64 *hash_) {
+	u64 hash = 0xcbf29ce484222325ull;
+	hash = (hash ^ cast(u64)operands.count) * 0x100000001b3ull;
+	for (Operand const &o : operands) {
+		switch (o.mode) {
+		case Addressing_Value:
+		case Addressing_Variable:
+		case Addressing_Constant:
+		case Addressing_Type:
+			break;
+		default:
+			return false;
+		}
+		if (o.expr == nullptr || o.type == nullptr || is_type_polymorphic(o.type) || is_type_proc(o.type)) {
+			return false;
+		}
+		u64 h = type_hash_canonical_type(o.type) ^ cast(u64)o.mode;
+		if (o.mode == Addressing_Constant) {
+			switch (o.value.kind) {
+			case ExactValue_Invalid:
+			case ExactValue_Bool:
+			case ExactValue_String:
+			case ExactValue_Integer:
+			case ExactValue_Float:
+				break;
+			default:
+				return false;
+			}
+			h ^= cast(u64)hash_exact_value(o.value) * 0x9e3779b97f4a7c15ull;
+		}
+		hash = (hash ^ h) * 0x100000001b3ull;
+	}
+	*hash_ = hash ? hash : 1;
+	return true;
+}
+
+gb_internal bool polymorphic_proc_operands_match(Slice<Operand> const &a, Array<Operand> const &b) {
+	if (a.count != b.count) {
+		return false;
+	}
+	for (isize i = 0; i < a.count; i++) {
+		Operand const &x = a[i];
+		Operand const &y = b[i];
+		if (x.mode != y.mode || !are_types_identical(x.type, y.type)) {
+			return false;
+		}
+		if (x.mode == Addressing_Constant) {
+			if (x.value.kind != y.value.kind) {
+				return false;
+			}
+			if (x.value.kind != ExactValue_Invalid && !compare_exact_values(Token_CmpEq, x.value, y.value)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// NOTE: Default values which are not plain constants are checked in the context of the caller
+// for each call (adding its dependencies), so those signatures are never resolved from the cache
+gb_internal bool polymorphic_proc_resolution_cacheable(Type *final_proc_type) {
+	TypeProc *pt = &base_type(final_proc_type)->Proc;
+	if (pt->params == nullptr) {
+		return true;
+	}
+	for (Entity *param : pt->params->Tuple.variables) {
+		if (param->kind != Entity_Variable) {
+			continue;
+		}
+		ParameterValue const &pv = param->Variable.param_value;
+		switch (pv.kind) {
+		case ParameterValue_Invalid:
+		case ParameterValue_Nil:
+		case ParameterValue_Location:
+			break;
+		case ParameterValue_Constant:
+			if (pv.value.kind == ExactValue_Procedure || pv.value.kind == ExactValue_Compound) {
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+gb_internal Entity *find_generated_polymorphic_procedure_from_operands(GenProcsData *gen_procs, u64 hash, Array<Operand> const &operands) {
+	Entity *found = nullptr;
+	rw_mutex_shared_lock(&gen_procs->mutex); // @local-mutex
+	for (auto *entry = multi_map_find_first(&gen_procs->resolutions, hash);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&gen_procs->resolutions, entry)) {
+		if (polymorphic_proc_operands_match(entry->value->operands, operands)) {
+			found = entry->value->entity;
+			break;
+		}
+	}
+	rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
+	return found;
+}
+
+gb_internal void add_generated_polymorphic_procedure_resolution(GenProcsData *gen_procs, u64 hash, Array<Operand> const &operands, Entity *entity) {
+	GenProcResolution *res = permanent_alloc_item<GenProcResolution>();
+	res->operands = permanent_slice_make<Operand>(operands.count);
+	for (isize i = 0; i < operands.count; i++) {
+		Operand o = {};
+		o.mode  = operands[i].mode;
+		o.type  = operands[i].type;
+		o.value = operands[i].value;
+		res->operands[i] = o;
+	}
+	res->entity = entity;
+
+	rw_mutex_lock(&gen_procs->mutex); // @local-mutex
+	multi_map_insert(&gen_procs->resolutions, hash, res);
+	rw_mutex_unlock(&gen_procs->mutex); // @local-mutex
+}
+
 gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, Entity *base_entity, Type *type,
                                                         Array<Operand> const *param_operands, Ast *poly_def_node, PolyProcData *poly_proc_data) {
 	///////////////////////////////////////////////////////////////////////////////
@@ -450,6 +619,29 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 		array_free(&operands);
 	});
 
+	// NOTE: A call with the same argument types as an earlier one resolves to the same specialization,
+	// so skip inferring the procedure type again
+	u64 operands_hash = 0;
+	bool use_resolutions = param_operands != nullptr &&
+	                       old_c->polymorphic_scope == nullptr &&
+	                       polymorphic_proc_operands_hash(operands, &operands_hash);
+	if (use_resolutions) {
+		mutex_lock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
+		GenProcsData *gen_procs = base_entity->Procedure.gen_procs;
+		mutex_unlock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
+
+		Entity *other = nullptr;
+		if (gen_procs != nullptr) {
+			other = find_generated_polymorphic_procedure_from_operands(gen_procs, operands_hash, operands);
+		}
+		if (other != nullptr) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
+			}
+			return true;
+		}
+	}
+
 
 	CheckerContext nctx = *old_c;
 
@@ -472,12 +664,17 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 	if (!success) {
 		return false;
 	}
+	if (use_resolutions) {
+		use_resolutions = polymorphic_proc_resolution_cacheable(final_proc_type);
+	}
 
 	GenProcsData *gen_procs = nullptr;
 
 	GB_ASSERT(base_entity->identifier.load()->kind == Ast_Ident);
 	GB_ASSERT(base_entity->kind == Entity_Procedure);
 
+	u64 final_proc_hash = type_hash_canonical_proc_params(final_proc_type);
+
 	mutex_lock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
 	gen_procs = base_entity->Procedure.gen_procs;
 	if (gen_procs) {
@@ -485,27 +682,28 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 
 		mutex_unlock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
 
-		for (Entity *other : gen_procs->procs) {
-			Type *pt = base_type(other->type);
-			if (are_types_identical(pt, final_proc_type)) {
-				rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
+		Entity *other = find_generated_polymorphic_procedure(gen_procs, final_proc_type, final_proc_hash);
+		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 
-				if (poly_proc_data) {
-					poly_proc_data->gen_entity = other;
-				}
-				return true;
+		if (other != nullptr) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
+			}
+			if (use_resolutions) {
+				add_generated_polymorphic_procedure_resolution(gen_procs, operands_hash, operands, other);
 			}
+			return true;
 		}
-
-		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 	} else {
 		gen_procs = permanent_alloc_item<GenProcsData>();
 		gen_procs->procs.allocator = heap_allocator();
+		mutex_set_name(&gen_procs->mutex, "GenProcsData.mutex");
 		base_entity->Procedure.gen_procs = gen_procs;
 		mutex_unlock(&base_entity->Procedure.gen_procs_mutex); // @entity-mutex
 	}
 
 
+	Ast *cloned_proc_type_node = nullptr;
 	{
 		// LEAK NOTE(bill): This is technically a memory leak as it has to generate the type twice
 		bool prev_no_polymorphic_errors = nctx.no_polymorphic_errors;
@@ -518,45 +716,53 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 		ptr_set_clear(&scope->imported);
 
 		// LEAK NOTE(bill): Cloning this AST may be leaky but this is not really an issue due to arena-based allocation
-		Ast *cloned_proc_type_node = clone_ast(pt->node);
+		cloned_proc_type_node = clone_ast(pt->node);
 		success = check_procedure_type(&nctx, final_proc_type, cloned_proc_type_node, &operands);
 		if (!success) {
 			return false;
 		}
 
+		final_proc_hash = type_hash_canonical_proc_params(final_proc_type);
+
 		rw_mutex_shared_lock(&gen_procs->mutex); // @local-mutex
-		for (Entity *other : gen_procs->procs) {
-			Type *pt = base_type(other->type);
-			if (are_types_identical(pt, final_proc_type)) {
-				rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
+		Entity *other = find_generated_polymorphic_procedure(gen_procs, final_proc_type, final_proc_hash);
+		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 
-				if (poly_proc_data) {
-					poly_proc_data->gen_entity = other;
-				}
+		if (other != nullptr) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
+			}
 
-				DeclInfo *decl = other->decl_info;
-				if (decl->proc_checked_state != ProcCheckedState_Checked) {
-					ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
-					proc_info->file  = other->file;
-					proc_info->token = other->token;
-					proc_info->decl  = decl;
-					proc_info->type  = other->type;
-					proc_info->body  = decl->proc_lit->ProcLit.body;
-					proc_info->tags  = other->Procedure.tags;;
-					proc_info->generated_from_polymorphic = true;
-					proc_info->poly_def_node = poly_def_node;
+			DeclInfo *decl = other->decl_info;
+			if (decl->proc_checked_state != ProcCheckedState_Checked) {
+				ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
+				proc_info->file  = other->file;
+				proc_info->token = other->token;
+				proc_info->decl  = decl;
+				proc_info->type  = other->type;
+				proc_info->body  = decl->proc_lit->ProcLit.body;
+				proc_info->tags  = other->Procedure.tags;;
+				proc_info->generated_from_polymorphic = true;
+				proc_info->poly_def_node = poly_def_node;
 
-					check_procedure_later(nctx.checker, proc_info);
-				}
+				check_procedure_later(nctx.checker, proc_info);
+			}
 
-				return true;
+			if (use_resolutions) {
+				add_generated_polymorphic_procedure_resolution(gen_procs, operands_hash, operands, other);
 			}
+			return true;
 		}
-		rw_mutex_shared_unlock(&gen_procs->mutex); // @local-mutex
 	}
 
 
-	Ast *proc_lit = clone_ast(old_decl->proc_lit);
+	// NOTE: the procedure type has already been cloned (and checked) above, so only the body needs cloning
+	Ast *proc_lit = nullptr;
+	if (old_decl->proc_lit->ProcLit.type == pt->node) {
+		proc_lit = clone_proc_lit_with_type(old_decl->proc_lit, cloned_proc_type_node);
+	} else {
+		proc_lit = clone_ast(old_decl->proc_lit);
+	}
 	ast_node(pl, ProcLit, proc_lit);
 	// NOTE(bill): Associate the scope declared above withinth this procedure declaration's type
 	add_scope(&nctx, pl->type, final_proc_type->Proc.scope);
@@ -628,8 +834,17 @@ gb_internal bool find_or_generate_polymorphic_procedure(CheckerContext *old_c, E
 
 	rw_mutex_lock(&gen_procs->mutex); // @local-mutex
 		array_add(&gen_procs->procs, entity);
+		multi_map_insert(&gen_procs->procs_by_hash, final_proc_hash, entity);
 	rw_mutex_unlock(&gen_procs->mutex); // @local-mutex
 
+	if (use_resolutions) {
+		add_generated_polymorphic_procedure_resolution(gen_procs, operands_hash, operands, entity);
+	}
+
+	if (build_context.proc_cost_report) {
+		proc_cost_add_instantiation(base_entity, entity);
+	}
+
 	ProcInfo *proc_info = permanent_alloc_item<ProcInfo>();
 	proc_info->file  = file;
 	proc_info->token = token;
@@ -4361,12 +4576,92 @@ gb_internal void check_binary_expr_dependency(CheckerContext *c, Token op, Type
 	}
 }
 
+gb_internal void check_binary_expr_operation(CheckerContext *c, Operand *x, Operand *y, Ast *node, Type *type_hint, bool use_lhs_as_type_hint);
+gb_internal void check_expr_base_record(CheckerContext *c, Operand *o, Ast *node);
+
+gb_internal bool is_binary_expr_chain_op(TokenKind op) {
+	switch (op) {
+	case Token_Add:
+	case Token_Sub:
+	case Token_Mul:
+	case Token_Quo:
+	case Token_Mod:
+	case Token_ModMod:
+	case Token_And:
+	case Token_Or:
+	case Token_Xor:
+	case Token_AndNot:
+	case Token_CmpAnd:
+	case Token_CmpOr:
+		return true;
+	}
+	return false;
+}
+
+// NOTE: Returns the left operand of `node` if it continues a left-deep chain of the same operator,
+// e.g. `a | b | c | ...`, which can be checked and lowered without recursing once per operand
+gb_internal Ast *binary_expr_chain_left(Ast *node) {
+	if (node->kind != Ast_BinaryExpr || !is_binary_expr_chain_op(node->BinaryExpr.op.kind)) {
+		return nullptr;
+	}
+	Ast *left = node->BinaryExpr.left;
+	if (left->kind != Ast_BinaryExpr || left->state_flags != 0 ||
+	    left->BinaryExpr.op.kind != node->BinaryExpr.op.kind ||
+	    left->BinaryExpr.left->kind != Ast_BinaryExpr) {
+		return nullptr;
+	}
+	return left;
+}
+
+gb_internal void check_binary_expr_chain(CheckerContext *c, Operand *x, Ast *node, Type *type_hint, bool use_lhs_as_type_hint) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto spine = array_make<Ast *>(temporary_allocator(), 0, 16);
+	for (Ast *e = node; e != nullptr; e = binary_expr_chain_left(e)) {
+		array_add(&spine, e);
+	}
+
+	// NOTE: This does what the recursion through `check_expr_with_type_hint` would do for each left
+	// operand, the innermost of which is not part of the chain and is checked as normal
+	check_expr_with_type_hint(c, x, spine[spine.count-1]->BinaryExpr.left, type_hint);
+
+	for (isize i = spine.count-1; i >= 0; i--) {
+		Ast *e = spine[i];
+		ast_node(be, BinaryExpr, e);
+		bool use_lhs = i == 0 ? use_lhs_as_type_hint : true;
+
+		Operand y = {};
+		if (can_use_other_type_as_type_hint(use_lhs, x->type)) {
+			check_expr_with_type_hint(c, &y, be->right, x->type);
+		} else {
+			check_expr_with_type_hint(c, &y, be->right, type_hint);
+		}
+		check_binary_expr_operation(c, x, &y, e, type_hint, use_lhs);
+
+		e->viral_state_flags |= be->left->viral_state_flags;
+		e->viral_state_flags |= be->right->viral_state_flags;
+
+		if (i == 0) {
+			break;
+		}
+		if (c->unroll_node_count != nullptr) {
+			*c->unroll_node_count += 1;
+		}
+		x->expr = e;
+		check_expr_base_record(c, x, e);
+	}
+}
+
 gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Type *type_hint, bool use_lhs_as_type_hint=false) {
 	GB_ASSERT(node->kind == Ast_BinaryExpr);
 	Operand y_ = {}, *y = &y_;
 
 	ast_node(be, BinaryExpr, node);
 
+	if (binary_expr_chain_left(node) != nullptr) {
+		check_binary_expr_chain(c, x, node, type_hint, use_lhs_as_type_hint);
+		return;
+	}
+
 	defer({
 		node->viral_state_flags |= be->left->viral_state_flags;
 		node->viral_state_flags |= be->right->viral_state_flags;
@@ -4522,6 +4817,14 @@ gb_internal void check_binary_expr(CheckerContext *c, Operand *x, Ast *node, Typ
 		}
 		break;
 	}
+
+	check_binary_expr_operation(c, x, y, node, type_hint, use_lhs_as_type_hint);
+}
+
+gb_internal void check_binary_expr_operation(CheckerContext *c, Operand *x, Operand *y, Ast *node, Type *type_hint, bool use_lhs_as_type_hint) {
+	ast_node(be, BinaryExpr, node);
+	Token op = be->op;
+
 	if (x->mode == Addressing_Invalid) {
 		return;
 	}
@@ -4821,6 +5124,38 @@ gb_internal Operand make_operand_from_node(Ast *node) {
 }
 
 
+gb_internal void update_untyped_expr_type_finish(CheckerContext *c, Ast *e, ExprInfo *old, Type *type, bool final);
+
+// NOTE: Does what the recursion through the left operands of `a && b && c && ...` would do, in the same
+// order, as such chains can be thousands of operands deep
+gb_internal void update_untyped_binary_expr_chain(CheckerContext *c, Ast *e, Type *type, bool final) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto spine = array_make<Ast *>(temporary_allocator(), 0, 16);
+	auto infos = array_make<ExprInfo *>(temporary_allocator(), 0, 16);
+	array_add(&spine, e);
+	array_add(&infos, cast(ExprInfo *)nullptr);
+	for (;;) {
+		Ast *left = binary_expr_chain_left(spine[spine.count-1]);
+		if (left == nullptr) {
+			break;
+		}
+		ExprInfo *info = check_get_expr_info(c, left);
+		if (info == nullptr || info->value.kind != ExactValue_Invalid) {
+			break;
+		}
+		array_add(&spine, left);
+		array_add(&infos, info);
+	}
+
+	update_untyped_expr_type(c, spine[spine.count-1]->BinaryExpr.left, type, final);
+	for (isize i = spine.count-1; i >= 0; i--) {
+		update_untyped_expr_type(c, spine[i]->BinaryExpr.right, type, final);
+		if (i > 0) {
+			update_untyped_expr_type_finish(c, spine[i], infos[i], type, final);
+		}
+	}
+}
+
 gb_internal void update_untyped_expr_type(CheckerContext *c, Ast *e, Type *type, bool final) {
 	GB_ASSERT(e != nullptr);
 	ExprInfo *old = check_get_expr_info(c, e);
@@ -4857,6 +5192,8 @@ gb_internal void update_untyped_expr_type(CheckerContext *c, Ast *e, Type *type,
 			// NOTE(bill): Do nothing as the types are fine
 		} else if (token_is_shift(be->op.kind)) {
 			update_untyped_expr_type(c, be->left, type, final);
+		} else if (binary_expr_chain_left(e) != nullptr) {
+			update_untyped_binary_expr_chain(c, e, type, final);
 		} else {
 			update_untyped_expr_type(c, be->left,  type, final);
 			update_untyped_expr_type(c, be->right, type, final);
@@ -4925,6 +5262,10 @@ gb_internal void update_untyped_expr_type(CheckerContext *c, Ast *e, Type *type,
 	case_end;
 	}
 
+	update_untyped_expr_type_finish(c, e, old, type, final);
+}
+
+gb_internal void update_untyped_expr_type_finish(CheckerContext *c, Ast *e, ExprInfo *old, Type *type, bool final) {
 	if (!final && is_type_untyped(type)) {
 		old->type = base_type(type);
 		return;
@@ -6430,8 +6771,8 @@ gb_internal bool check_unpack_arguments(CheckerContext *ctx, Entity **lhs, isize
 			}
 			rw_mutex_shared_lock(&decl->deps_mutex);
 			rw_mutex_lock(&c->decl->deps_mutex);
-			FOR_PTR_SET(dep, decl->deps) {
-				ptr_set_add(&c->decl->deps, dep);
+			for (Entity *dep : decl->deps) {
+				entity_set_add(&c->decl->deps, dep);
 			}
 			rw_mutex_unlock(&c->decl->deps_mutex);
 			rw_mutex_shared_unlock(&decl->deps_mutex);
@@ -6658,7 +6999,8 @@ gb_internal CallArgumentError check_call_arguments_internal(CheckerContext *c, A
 
 	GB_ASSERT(ce->split_args);
 	auto visited = temporary_slice_make<bool>(pt->param_count);
-	auto ordered_operands = array_make<Operand>(temporary_allocator(), pt->param_count);
+	InlineArray<Operand, 8> ordered_operands_storage(temporary_allocator(), pt->param_count);
+	Array<Operand> &ordered_operands = ordered_operands_storage.array;
 	defer ({
 		for (Operand const &o : ordered_operands) {
 			if (o.expr != nullptr) {
@@ -7114,7 +7456,7 @@ gb_internal bool evaluate_where_clauses(CheckerContext *ctx, Ast *call_expr, Sco
 					if (scope != nullptr) {
 						isize print_count = 0;
 						for (auto const &entry : scope->elements) {
-							Entity *e = entry.value;
+							Entity *e = entry.value();
 							switch (e->kind) {
 							case Entity_TypeName: {
 								// if (print_count == 0) error_line("\n\tWith the following definitions:\n");
@@ -7172,6 +7514,25 @@ gb_internal bool evaluate_where_clauses(CheckerContext *ctx, Ast *call_expr, Sco
 	return true;
 }
 
+// NOTE: The `where` clauses of a declaration are evaluated once and the verdict is reused by every
+// later call site (and the body check), they are only re-evaluated when a failure needs reporting
+gb_internal bool evaluate_decl_where_clauses(CheckerContext *ctx, Ast *call_expr, DeclInfo *decl, bool print_err) {
+	GB_ASSERT(decl->proc_lit != nullptr && decl->proc_lit->kind == Ast_ProcLit);
+	switch (decl->where_clauses_state.load(std::memory_order_acquire)) {
+	case WhereClauseState_Passed:
+		return true;
+	case WhereClauseState_Failed:
+		if (!print_err) {
+			return false;
+		}
+		break;
+	}
+
+	bool ok = evaluate_where_clauses(ctx, call_expr, decl->scope, &decl->proc_lit->ProcLit.where_clauses, print_err);
+	decl->where_clauses_state.store(ok ? WhereClauseState_Passed : WhereClauseState_Failed, std::memory_order_release);
+	return ok;
+}
+
 gb_internal bool check_named_arguments(CheckerContext *c, Type *type, Slice<Ast *> const &named_args, Array<Operand> *named_operands, bool show_error) {
 	bool success = true;
 
@@ -7283,8 +7644,7 @@ gb_internal bool check_call_arguments_single(CheckerContext *c, Ast *call, Opera
 		ctx.curr_proc_decl = decl;
 		ctx.curr_proc_sig  = e->type;
 
-		GB_ASSERT(decl->proc_lit->kind == Ast_ProcLit);
-		bool ok = evaluate_where_clauses(&ctx, call, decl->scope, &decl->proc_lit->ProcLit.where_clauses, !return_on_failure);
+		bool ok = evaluate_decl_where_clauses(&ctx, call, decl, !return_on_failure);
 		if (return_on_failure) {
 			if (!ok) {
 				return false;
@@ -7306,6 +7666,85 @@ gb_internal bool check_call_arguments_single(CheckerContext *c, Ast *call, Opera
 }
 
 
+gb_internal bool is_type_only_assignable_from_itself(Type *t) {
+	// NOTE: a typed (non-constant) value of one of these types can only be assigned to an
+	// identical type, see `check_distance_between_types`
+	t = base_type(t);
+	if (t == nullptr) {
+		return false;
+	}
+	switch (t->kind) {
+	case Type_Basic:
+		if (t->Basic.flags & BasicFlag_Untyped) {
+			return false;
+		}
+		return (t->Basic.flags & (BasicFlag_Integer|BasicFlag_Float|BasicFlag_Boolean|BasicFlag_String)) != 0;
+	case Type_Slice:
+	case Type_DynamicArray:
+	case Type_Map:
+		return !is_type_polymorphic(t);
+	}
+	return false;
+}
+
+gb_internal void check_proc_group_index_first_params(Entity *pg_entity) {
+	GB_ASSERT(pg_entity->kind == Entity_ProcGroup);
+	auto *pge = &pg_entity->ProcGroup;
+
+	for (Entity *p : pge->entities) {
+		if (p->type == nullptr || p->type == t_invalid) {
+			continue;
+		}
+		Type *pt = base_type(p->type);
+		if (pt == nullptr || pt->kind != Type_Proc || pt->Proc.is_polymorphic || pt->Proc.param_count == 0) {
+			continue;
+		}
+		Entity *param = pt->Proc.params->Tuple.variables[0];
+		if (param->kind != Entity_Variable) {
+			continue;
+		}
+		if (param->flags & (EntityFlag_Ellipsis|EntityFlag_CVarArg|EntityFlag_AnyInt)) {
+			continue;
+		}
+		if (!is_type_only_assignable_from_itself(param->type)) {
+			continue;
+		}
+		if (pge->exact_first_params.entries == nullptr) {
+			map_init(&pge->exact_first_params, 2*pge->entities.count);
+		}
+		map_set(&pge->exact_first_params, p, base_type(param->type));
+	}
+}
+
+// NOTE: returns true if `p` cannot possibly accept `first_arg` as its first argument, without
+// having to fully check the call against it
+gb_internal bool check_proc_group_first_arg_mismatch(Entity *pg_entity, Entity *p, Operand const &first_arg) {
+	if (pg_entity == nullptr || pg_entity->kind != Entity_ProcGroup) {
+		return false;
+	}
+	auto *pge = &pg_entity->ProcGroup;
+	if (pge->exact_first_params.count == 0) {
+		return false;
+	}
+	if (first_arg.mode != Addressing_Value && first_arg.mode != Addressing_Variable) {
+		return false;
+	}
+	if (first_arg.expr != nullptr) {
+		Ast *expr = unparen_expr(first_arg.expr);
+		if (expr != nullptr && expr->kind == Ast_AutoCast) {
+			return false;
+		}
+	}
+	if (!is_type_only_assignable_from_itself(first_arg.type)) {
+		return false;
+	}
+	Type **param_type = map_get(&pge->exact_first_params, p);
+	if (param_type == nullptr) {
+		return false;
+	}
+	return !are_types_identical(*param_type, base_type(first_arg.type));
+}
+
 gb_internal CallArgumentData check_call_arguments_proc_group(CheckerContext *c, Operand *operand, Ast *call) {
 	ast_node(ce, CallExpr, call);
 	GB_ASSERT(ce->split_args != nullptr);
@@ -7400,8 +7839,10 @@ gb_internal CallArgumentData check_call_arguments_proc_group(CheckerContext *c,
 
 	TEMPORARY_ALLOCATOR_GUARD();
 
-	auto positional_operands = array_make<Operand>(temporary_allocator(), 0, 0);
-	auto named_operands = array_make<Operand>(temporary_allocator(), 0, 0);
+	InlineArray<Operand, 8> positional_operands_storage(temporary_allocator());
+	InlineArray<Operand, 4> named_operands_storage(temporary_allocator());
+	Array<Operand> &positional_operands = positional_operands_storage.array;
+	Array<Operand> &named_operands      = named_operands_storage.array;
 
 	if (procs.count == 1) {
 		Entity *e = procs[0];
@@ -7546,6 +7987,10 @@ gb_internal CallArgumentData check_call_arguments_proc_group(CheckerContext *c,
 		if (p->flags & EntityFlag_Disabled) {
 			continue;
 		}
+		if (positional_operands.count > 0 &&
+		    check_proc_group_first_arg_mismatch(operand->proc_group, p, positional_operands[0])) {
+			continue;
+		}
 
 		Type *pt = base_type(p->type);
 		if (pt != nullptr && is_type_proc(pt)) {
@@ -8047,8 +8492,10 @@ gb_internal CallArgumentData check_call_arguments(CheckerContext *c, Operand *op
 
 	TEMPORARY_ALLOCATOR_GUARD();
 
-	auto positional_operands = array_make<Operand>(temporary_allocator(), 0, positional_args.count);
-	auto named_operands      = array_make<Operand>(temporary_allocator(), 0, 0);
+	InlineArray<Operand, 8> positional_operands_storage(temporary_allocator(), 0, positional_args.count);
+	InlineArray<Operand, 4> named_operands_storage(temporary_allocator());
+	Array<Operand> &positional_operands = positional_operands_storage.array;
+	Array<Operand> &named_operands      = named_operands_storage.array;
 
 	if (positional_args.count > 0) {
 		Entity **lhs =  nullptr;
@@ -8420,6 +8867,17 @@ gb_internal CallArgumentError check_polymorphic_record_type(CheckerContext *c, O
 
 	{
 		GenTypesData *found_gen_types = ensure_polymorphic_record_entity_has_gen_types(c, original_type);
+
+		u64 operands_hash = 0;
+		if (polymorphic_record_operands_hash(get_record_polymorphic_params(original_type), param_count, ordered_operands, &operands_hash)) {
+			Entity *found_entity = find_complete_polymorphic_record_entity(found_gen_types, operands_hash, param_count, ordered_operands);
+			if (found_entity) {
+				operand->mode = Addressing_Type;
+				operand->type = found_entity->type;
+				return err;
+			}
+		}
+
 		mutex_lock(&found_gen_types->mutex);
 		defer (mutex_unlock(&found_gen_types->mutex));
 
@@ -8503,6 +8961,8 @@ gb_internal CallArgumentError check_polymorphic_record_type(CheckerContext *c, O
 			}
 		}
 
+		add_complete_polymorphic_record_entity(found_gen_types, named_type->Named.type_name);
+
 		operand->mode = Addressing_Type;
 		operand->type = named_type;
 	}
@@ -8731,6 +9191,7 @@ gb_internal ExprKind check_call_expr(CheckerContext *c, Operand *operand, Ast *c
 		    name == "load_directory" ||
 		    name == "load_hash" ||
 		    name == "hash" ||
+		    name == "eval" ||
 		    name == "caller_expression"
 		) {
 			operand->mode = Addressing_Builtin;
@@ -9654,7 +10115,7 @@ gb_internal ExprKind check_basic_directive_expr(CheckerContext *c, Operand *o, A
 	o->mode = Addressing_Constant;
 	String name = bd->name.string;
 	if (name == "file") {
-		String file = get_file_path_string(bd->token.pos.file_id);
+		String file = remap_path_prefix(get_file_path_string(bd->token.pos.file_id));
 		switch (build_context.source_code_location_info) {
 		case SourceCodeLocationInfo_Normal:
 			break;
@@ -9671,7 +10132,7 @@ gb_internal ExprKind check_basic_directive_expr(CheckerContext *c, Operand *o, A
 		o->type = t_untyped_string;
 		o->value = exact_value_string(file);
 	} else if (name == "directory") {
-		String file = get_file_path_string(bd->token.pos.file_id);
+		String file = remap_path_prefix(get_file_path_string(bd->token.pos.file_id));
 		String path = dir_from_path(file);
 		switch (build_context.source_code_location_info) {
 		case SourceCodeLocationInfo_Normal:
@@ -9761,7 +10222,8 @@ gb_internal ExprKind check_basic_directive_expr(CheckerContext *c, Operand *o, A
 		    name == "load" ||
 		    name == "load_hash" ||
 		    name == "load_directory" ||
-		    name == "load_or"
+		    name == "load_or" ||
+		    name == "eval"
 		) {
 			error(node, "'#%.*s' must be used as a call", LIT(name));
 			o->type = t_invalid;
@@ -10663,6 +11125,12 @@ gb_internal ExprKind check_compound_literal(CheckerContext *c, Operand *o, Ast *
 			}
 
 			wait_signal_until_available(&t->Struct.fields_wait_signal);
+			if (t->Struct.is_reorder && cl->elems[0]->kind != Ast_FieldValue) {
+				gbString type_str = type_to_string(type);
+				error(node, "%s ('struct #reorder') compound literals are only allowed to contain 'field = value' elements, as its fields are not in declaration order", type_str);
+				gb_string_free(type_str);
+				break;
+			}
 			isize field_count = t->Struct.fields.count;
 			isize min_field_count = t->Struct.fields.count;
 			for (isize i = min_field_count-1; i >= 0; i--) {
@@ -12656,7 +13124,15 @@ gb_internal ExprKind check_expr_base_internal(CheckerContext *c, Operand *o, Ast
 
 
 gb_internal ExprKind check_expr_base(CheckerContext *c, Operand *o, Ast *node, Type *type_hint) {
+	if (c->unroll_node_count != nullptr) {
+		*c->unroll_node_count += 1;
+	}
 	ExprKind kind = check_expr_base_internal(c, o, node, type_hint);
+	check_expr_base_record(c, o, node);
+	return kind;
+}
+
+gb_internal void check_expr_base_record(CheckerContext *c, Operand *o, Ast *node) {
 	if (o->type != nullptr && core_type(o->type) == nullptr) {
 		o->type = t_invalid;
 		gbString xs = expr_to_string(o->expr);
@@ -12673,7 +13149,6 @@ gb_internal ExprKind check_expr_base(CheckerContext *c, Operand *o, Ast *node, T
 	check_rtti_type_disallowed(node, o->type, "An expression is using a type, %s, which has been disallowed");
 
 	add_type_and_value(c, node, o->mode, o->type, o->value);
-	return kind;
 }
 
 
@@ -13371,6 +13846,7 @@ gb_internal gbString write_expr_to_string(gbString str, Ast *node, bool shorthan
 		if (st->is_raw_union)   str = gb_string_appendc(str, "#raw_union ");
 		if (st->is_all_or_none) str = gb_string_appendc(str, "#all_or_none ");
 		if (st->is_simple)      str = gb_string_appendc(str, "#simple ");
+		if (st->is_reorder)     str = gb_string_appendc(str, "#reorder ");
 		if (st->align) {
 			str = gb_string_appendc(str, "#align ");
 			str = write_expr_to_string(str, st->align, shorthand);
@@ -656,6 +656,9 @@ gb_internal Type *check_assignment_variable(CheckerContext *ctx, Operand *lhs, O
 gb_internal void check_stmt_internal(CheckerContext *ctx, Ast *node, u32 flags);
 gb_internal void check_stmt(CheckerContext *ctx, Ast *node, u32 flags) {
 	u32 prev_state_flags = ctx->state_flags;
+	if (ctx->unroll_node_count != nullptr) {
+		*ctx->unroll_node_count += 1;
+	}
 
 	if (node->state_flags != 0) {
 		u32 in = node->state_flags;
@@ -787,7 +790,7 @@ gb_internal bool check_using_stmt_entity(CheckerContext *ctx, AstUsingStmt *us,
 					gb_string_free(expr_str);
 					return false;
 				}
-				f->using_parent = e;
+				entity_cold(f)->using_parent = e;
 			}
 		} else {
 			error(us->token, "'using' can be only applied to enum type entities");
@@ -806,7 +809,7 @@ gb_internal bool check_using_stmt_entity(CheckerContext *ctx, AstUsingStmt *us,
 				continue;
 			}
 
-			Entity *decl = scope->elements.slots[i].value;
+			Entity *decl = scope->elements.slots[i].value();
 			if (!is_entity_exported(decl, true)) {
 				continue;
 			}
@@ -841,7 +844,7 @@ gb_internal bool check_using_stmt_entity(CheckerContext *ctx, AstUsingStmt *us,
 			Scope *found = t->Struct.scope;
 			GB_ASSERT(found != nullptr);
 			for (auto const &entry : found->elements) {
-				Entity *f = entry.value;
+				Entity *f = entry.value();
 				if (f->kind == Entity_Variable) {
 					Entity *uvar = alloc_entity_using_variable(e, f->token, f->type, expr);
 					if (!is_ptr && e->flags & EntityFlag_Value) uvar->flags |= EntityFlag_Value;
@@ -912,6 +915,34 @@ gb_internal void error_var_decl_identifier(Ast *name) {
 	}
 }
 
+// NOTE: The body of an '#unroll for' is only checked once, but the backend emits it once per
+// iteration, so its generated size is the checked size of the body times the iteration count.
+gb_internal void check_unroll_range_stmt_cost(CheckerContext *ctx, Ast *node, i64 iterations, i64 body_nodes) {
+	iterations = gb_max(iterations, 1);
+	i64 expanded_nodes = body_nodes*iterations;
+	if (ctx->unroll_node_count != nullptr) {
+		*ctx->unroll_node_count += expanded_nodes;
+	}
+
+	i64 budget = build_context.unroll_budget;
+	if (budget > 0 && expanded_nodes > budget && body_nodes <= budget) {
+		// NOTE: only warn on the loop which crosses the budget, not on every enclosing loop
+		warning(node, "'#unroll for' expands to roughly %lld AST nodes (%lld iterations of %lld nodes), exceeding the budget of %lld set by -unroll-budget",
+		        cast(long long)expanded_nodes, cast(long long)iterations, cast(long long)body_nodes, cast(long long)budget);
+	}
+
+	if (build_context.show_unroll_report) {
+		UnrollReport report = {};
+		report.node           = node;
+		report.iterations     = iterations;
+		report.body_nodes     = body_nodes;
+		report.expanded_nodes = expanded_nodes;
+
+		MUTEX_GUARD(&ctx->info->unroll_reports_mutex);
+		array_add(&ctx->info->unroll_reports, report);
+	}
+}
+
 gb_internal void check_unroll_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags) {
 	ast_node(irs, UnrollRangeStmt, node);
 	check_open_scope(ctx, node);
@@ -1144,7 +1175,14 @@ gb_internal void check_unroll_range_stmt(CheckerContext *ctx, Ast *node, u32 mod
 	}
 
 	u32 new_flags = mod_flags & ~Stmt_BreakAllowed & ~Stmt_ContinueAllowed;
+
+	i64 body_nodes = 0;
+	i64 *prev_unroll_node_count = ctx->unroll_node_count;
+	ctx->unroll_node_count = &body_nodes;
 	check_stmt(ctx, irs->body, new_flags);
+	ctx->unroll_node_count = prev_unroll_node_count;
+
+	check_unroll_range_stmt_cost(ctx, node, exact_value_to_i64(inline_for_depth), body_nodes);
 }
 
 gb_internal void check_switch_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags) {
@@ -1756,6 +1794,25 @@ gb_internal void check_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags)
 		check_stmt(ctx, rs->init, mod_flags);
 	}
 
+	if (rs->prefetch != nullptr) {
+		Operand x = {};
+		check_expr(ctx, &x, rs->prefetch);
+		if (x.mode != Addressing_Constant || !is_type_integer(x.type)) {
+			gbString s = expr_to_string(x.expr);
+			error(x.expr, "Expected a constant integer for #prefetch, got '%s'", s);
+			gb_string_free(s);
+		} else {
+			i64 v = exact_value_to_i64(exact_value_to_integer(x.value));
+			if (v < 1) {
+				error(x.expr, "Expected a constant integer >= 1 for #prefetch, got %lld", cast(long long)v);
+			} else if (v > 4096) {
+				error(x.expr, "Too large of a value for #prefetch, got %lld, expected <= 4096", cast(long long)v);
+			} else {
+				rs->prefetch_distance = v;
+			}
+		}
+	}
+
 	u32 new_flags = mod_flags | Stmt_BreakAllowed | Stmt_ContinueAllowed;
 
 	auto vals = array_make<Type *>(temporary_allocator(), 0, 2);
@@ -1911,6 +1968,7 @@ gb_internal void check_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags)
 				is_map = true;
 				array_add(&vals, t->Map.key);
 				array_add(&vals, t->Map.value);
+				add_package_dependency(ctx, "runtime", "map_next_valid_hash");
 				if (is_reverse) {
 					error(node, "#reverse for is not supported for map types, as maps are unordered");
 				}
@@ -2031,6 +2089,28 @@ gb_internal void check_range_stmt(CheckerContext *ctx, Ast *node, u32 mod_flags)
 
 	skip_expr_range_stmt:; // NOTE(zhiayang): again, declaring a variable immediately after a label... weird.
 
+	if (rs->prefetch_distance > 0) {
+		Type *t = is_range ? nullptr : base_type(type_deref(type_of_expr(expr)));
+		bool ok = false;
+		if (t != nullptr) {
+			switch (t->kind) {
+			case Type_Array:
+			case Type_EnumeratedArray:
+			case Type_Slice:
+			case Type_DynamicArray:
+			case Type_FixedCapacityDynamicArray:
+				ok = true;
+				break;
+			case Type_Struct:
+				ok = t->Struct.soa_kind != StructSoa_None;
+				break;
+			}
+		}
+		if (!ok) {
+			error(rs->prefetch, "#prefetch is only supported for arrays, slices, dynamic arrays, and #soa data");
+		}
+	}
+
 	if (rs->vals.count > max_val_count) {
 		error(rs->vals[max_val_count], "Expected a maximum of %td identifier%s, got %td", max_val_count, max_val_count == 1 ? "" : "s", rs->vals.count);
 	}
@@ -2378,7 +2458,7 @@ gb_internal void check_value_decl_stmt(CheckerContext *ctx, Ast *node, u32 mod_f
 				Scope *scope = t->Struct.scope;
 				GB_ASSERT(scope != nullptr);
 				for (auto const &entry : scope->elements) {
-					Entity *f = entry.value;
+					Entity *f = entry.value();
 					if (f->kind == Entity_Variable) {
 						Entity *uvar = alloc_entity_using_variable(e, f->token, f->type, e->identifier);
 						uvar->flags |= (e->flags & EntityFlag_Value);
@@ -257,6 +257,55 @@ gb_internal void check_struct_fields(CheckerContext *ctx, Ast *node, Slice<Entit
 }
 
 
+struct StructFieldOrder {
+	i64   align;
+	isize index;
+};
+
+gb_internal int struct_field_order_cmp(void const *a, void const *b) {
+	StructFieldOrder const *x = cast(StructFieldOrder const *)a;
+	StructFieldOrder const *y = cast(StructFieldOrder const *)b;
+	if (x->align != y->align) {
+		return x->align > y->align ? -1 : +1;
+	}
+	return x->index < y->index ? -1 : x->index > y->index;
+}
+
+// NOTE: `struct #reorder` sorts its fields by descending alignment, which minimizes the padding between
+// them. Fields of the same alignment stay in declaration order, and a 'subtype' field stays first. This is
+// the real order of the fields from then on (offsets, RTTI, debug info), so 'field_index' is updated too.
+gb_internal void reorder_struct_fields(Type *struct_type) {
+	Slice<Entity *> fields = struct_type->Struct.fields;
+	String *tags = struct_type->Struct.tags;
+	if (fields.count <= 1) {
+		return;
+	}
+
+	auto order = slice_make<StructFieldOrder>(heap_allocator(), fields.count);
+	defer (gb_free(heap_allocator(), order.data));
+	for_array(i, fields) {
+		Entity *f = fields[i];
+		order[i].index = i;
+		if (f->flags & EntityFlag_Subtype) {
+			order[i].align = I64_MAX;
+		} else {
+			order[i].align = type_align_of(f->type);
+		}
+	}
+	gb_sort_array(order.data, order.count, struct_field_order_cmp);
+
+	auto new_fields = slice_make<Entity *>(permanent_allocator(), fields.count);
+	String *new_tags = permanent_alloc_array<String>(fields.count);
+	for_array(i, order) {
+		Entity *f = fields[order[i].index];
+		f->Variable.field_index = cast(i32)i;
+		new_fields[i] = f;
+		new_tags[i]   = tags[order[i].index];
+	}
+	struct_type->Struct.fields = new_fields;
+	struct_type->Struct.tags   = new_tags;
+}
+
 gb_internal bool check_custom_align(CheckerContext *ctx, Ast *node, i64 *align_, char const *msg) {
 	GB_ASSERT(align_ != nullptr);
 	Operand o = {};
@@ -302,6 +351,8 @@ gb_internal GenTypesData *ensure_polymorphic_record_entity_has_gen_types(Checker
 	if (original_type->Named.gen_types_data == nullptr) {
 		GenTypesData *gen_types = permanent_alloc_item<GenTypesData>();
 		gen_types->types = array_make<Entity *>(heap_allocator());
+		mutex_set_name(&gen_types->mutex,                "GenTypesData.mutex");
+		mutex_set_name(&gen_types->complete_types_mutex, "GenTypesData.complete_types_mutex");
 		original_type->Named.gen_types_data = gen_types;
 	}
 	found_gen_types = original_type->Named.gen_types_data;
@@ -600,61 +651,136 @@ gb_internal bool check_record_poly_operand_specialization(CheckerContext *ctx, T
 	return true;
 }
 
-gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands) {
-	for (Entity *e : found_gen_types->types) {
-		Type *t = base_type(e->type);
-		TypeTuple *tuple = get_record_polymorphic_params(t);
-		GB_ASSERT_MSG(tuple != nullptr, "%s :: %s", type_to_string(e->type), type_to_string(t));
-		GB_ASSERT(param_count == tuple->variables.count);
+gb_internal bool polymorphic_record_entity_matches(Entity *e, isize param_count, Array<Operand> const &ordered_operands) {
+	Type *t = base_type(e->type);
+	TypeTuple *tuple = get_record_polymorphic_params(t);
+	GB_ASSERT_MSG(tuple != nullptr, "%s :: %s", type_to_string(e->type), type_to_string(t));
+	GB_ASSERT(param_count == tuple->variables.count);
 
-		bool skip = false;
+	for (isize j = 0; j < param_count; j++) {
+		Entity *p = tuple->variables[j];
+		Operand o = {};
+		if (j < ordered_operands.count) {
+			o = ordered_operands[j];
+		}
+		if (o.expr == nullptr) {
+			continue;
+		}
+		Entity *oe = entity_of_node(o.expr);
+		if (p == oe) {
+			// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
+			// Saves on a lot of checking too below
+			continue;
+		}
 
-		for (isize j = 0; j < param_count; j++) {
-			Entity *p = tuple->variables[j];
-			Operand o = {};
-			if (j < ordered_operands.count) {
-				o = ordered_operands[j];
+		if (p->kind == Entity_TypeName) {
+			if (is_type_polymorphic(o.type)) {
+				// NOTE(bill): Do not add polymorphic version to the gen_types
+				return false;
 			}
-			if (o.expr == nullptr) {
-				continue;
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
 			}
-			Entity *oe = entity_of_node(o.expr);
-			if (p == oe) {
-				// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
-				// Saves on a lot of checking too below
-				continue;
+		} else if (p->kind == Entity_Constant) {
+			if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
+				return false;
 			}
-
-			if (p->kind == Entity_TypeName) {
-				if (is_type_polymorphic(o.type)) {
-					// NOTE(bill): Do not add polymorphic version to the gen_types
-					skip = true;
-					break;
-				}
-				if (!are_types_identical(o.type, p->type)) {
-					skip = true;
-					break;
-				}
-			} else if (p->kind == Entity_Constant) {
-				if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
-					skip = true;
-					break;
-				}
-				if (!are_types_identical(o.type, p->type)) {
-					skip = true;
-					break;
-				}
-			} else {
-				GB_PANIC("Unknown entity kind");
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
 			}
+		} else {
+			GB_PANIC("Unknown entity kind");
 		}
-		if (!skip) {
+	}
+	return true;
+}
+
+gb_internal Entity *find_polymorphic_record_entity(GenTypesData *found_gen_types, isize param_count, Array<Operand> const &ordered_operands) {
+	for (Entity *e : found_gen_types->types) {
+		if (polymorphic_record_entity_matches(e, param_count, ordered_operands)) {
 			return e;
 		}
 	}
 	return nullptr;
 };
 
+gb_internal u64 polymorphic_record_hash_param(u64 hash, Entity *param, Type *type, ExactValue const &value) {
+	u64 h = type_hash_canonical_type(type);
+	if (param->kind == Entity_Constant) {
+		h ^= cast(u64)hash_exact_value(value) * 0x9e3779b97f4a7c15ull;
+	}
+	return (hash ^ h) * 0x100000001b3ull;
+}
+
+// NOTE: `params` are the polymorphic parameters of the original record, returns false if the
+// operands cannot be hashed consistently with `polymorphic_record_entity_hash`
+gb_internal bool polymorphic_record_operands_hash(TypeTuple *params, isize param_count, Array<Operand> const &ordered_operands, u64 *hash_) {
+	if (params == nullptr || params->variables.count != param_count || ordered_operands.count < param_count) {
+		return false;
+	}
+	u64 hash = 0xcbf29ce484222325ull;
+	for (isize j = 0; j < param_count; j++) {
+		Entity *p = params->variables[j];
+		Operand const &o = ordered_operands[j];
+		if (o.expr == nullptr || o.type == nullptr || is_type_polymorphic(o.type)) {
+			return false;
+		}
+		if (p->kind != Entity_TypeName && p->kind != Entity_Constant) {
+			return false;
+		}
+		hash = polymorphic_record_hash_param(hash, p, o.type, o.value);
+	}
+	*hash_ = hash ? hash : 1;
+	return true;
+}
+
+gb_internal bool polymorphic_record_entity_hash(Entity *e, u64 *hash_) {
+	TypeTuple *tuple = get_record_polymorphic_params(e->type);
+	if (tuple == nullptr) {
+		return false;
+	}
+	u64 hash = 0xcbf29ce484222325ull;
+	for (Entity *p : tuple->variables) {
+		if (p->type == nullptr || is_type_polymorphic(p->type)) {
+			return false;
+		}
+		if (p->kind == Entity_TypeName) {
+			hash = polymorphic_record_hash_param(hash, p, p->type, {});
+		} else if (p->kind == Entity_Constant) {
+			hash = polymorphic_record_hash_param(hash, p, p->type, p->Constant.value);
+		} else {
+			return false;
+		}
+	}
+	*hash_ = hash ? hash : 1;
+	return true;
+}
+
+gb_internal Entity *find_complete_polymorphic_record_entity(GenTypesData *found_gen_types, u64 hash, isize param_count, Array<Operand> const &ordered_operands) {
+	Entity *found = nullptr;
+	rw_mutex_shared_lock(&found_gen_types->complete_types_mutex);
+	for (auto *entry = multi_map_find_first(&found_gen_types->complete_types, hash);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&found_gen_types->complete_types, entry)) {
+		if (polymorphic_record_entity_matches(entry->value, param_count, ordered_operands)) {
+			found = entry->value;
+			break;
+		}
+	}
+	rw_mutex_shared_unlock(&found_gen_types->complete_types_mutex);
+	return found;
+}
+
+gb_internal void add_complete_polymorphic_record_entity(GenTypesData *found_gen_types, Entity *e) {
+	u64 hash = 0;
+	if (e == nullptr || !polymorphic_record_entity_hash(e, &hash)) {
+		return;
+	}
+	rw_mutex_lock(&found_gen_types->complete_types_mutex);
+	multi_map_insert(&found_gen_types->complete_types, hash, e);
+	rw_mutex_unlock(&found_gen_types->complete_types_mutex);
+}
+
 
 gb_internal void check_struct_type(CheckerContext *ctx, Type *struct_type, Ast *node, Array<Operand> *poly_operands, Type *named_type, Type *original_type_for_poly) {
 	GB_ASSERT(is_type_struct(struct_type));
@@ -722,6 +848,13 @@ gb_internal void check_struct_type(CheckerContext *ctx, Type *struct_type, Ast *
 			}
 		}
 
+		if (st->is_reorder && !struct_type->Struct.is_raw_union) {
+			struct_type->Struct.is_reorder = true;
+			if (!struct_type->Struct.is_polymorphic) {
+				reorder_struct_fields(struct_type);
+			}
+		}
+
 		wait_signal_set(&struct_type->Struct.fields_wait_signal);
 	}
 
@@ -1502,8 +1635,9 @@ gb_internal void check_bit_set_type(CheckerContext *c, Type *type, Type *named_t
 
 // If `specialization` is a polymorphic-record specialization that has been published into
 // its originating record's `gen_types` cache, return that cache's `GenTypesData`. Its
-// `RecursiveMutex` guards concurrent `find_polymorphic_record_entity` reads, so the
-// in-place finalization below must hold it. Returns nullptr otherwise.
+// `RecursiveMutex` and `complete_types_mutex` guard concurrent `find_polymorphic_record_entity`
+// and `find_complete_polymorphic_record_entity` reads, so the in-place finalization below
+// must hold both. Returns nullptr otherwise.
 gb_internal GenTypesData *gen_types_data_of_specialization(Type *specialization) {
 	if (specialization != nullptr &&
 	    specialization->kind == Type_Named &&
@@ -1554,9 +1688,15 @@ gb_internal bool check_type_specialization_to_internal(CheckerContext *ctx, Type
 		// finalize it under that record's (recursive) gen_types mutex so a concurrent
 		// find_polymorphic_record_entity on another thread cannot observe a torn Type.
 		GenTypesData *gen_types = gen_types_data_of_specialization(specialization);
-		if (gen_types != nullptr) mutex_lock(&gen_types->mutex);
+		if (gen_types != nullptr) {
+			mutex_lock(&gen_types->mutex);
+			rw_mutex_lock(&gen_types->complete_types_mutex);
+		}
 		gb_memmove(specialization, type, gb_size_of(Type));
-		if (gen_types != nullptr) mutex_unlock(&gen_types->mutex);
+		if (gen_types != nullptr) {
+			rw_mutex_unlock(&gen_types->complete_types_mutex);
+			mutex_unlock(&gen_types->mutex);
+		}
 	}
 
 	return true;
@@ -2383,7 +2523,7 @@ gb_internal Type *check_get_params(CheckerContext *ctx, Scope *scope, Ast *_para
 	isize specialization_count = 0;
 	if (scope != nullptr) {
 		for (auto const &entry : scope->elements) {
-			Entity *e = entry.value;
+			Entity *e = entry.value();
 			if (e->kind == Entity_TypeName) {
 				Type *t = e->type;
 				if (t->kind == Type_Generic &&
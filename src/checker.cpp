@@ -50,6 +50,10 @@ gb_internal bool check_rtti_type_disallowed(Token const &token, Type *type, char
 
 gb_internal bool check_rtti_type_disallowed(Ast *expr, Type *type, char const *format) {
 	GB_ASSERT(expr != nullptr);
+	if (!build_context.no_rtti || type == nullptr) {
+		// NOTE: `ast_token` walks down to the leftmost operand, so only do it when it could be needed
+		return false;
+	}
 	return check_rtti_type_disallowed(ast_token(expr), type, format);
 }
 
@@ -172,7 +176,10 @@ gb_internal void init_decl_info(DeclInfo *d, Scope *scope, DeclInfo *parent) {
 	}
 	d->parent = parent;
 	d->scope  = scope;
-	ptr_set_init(&d->deps, 0);
+	mutex_set_name(&d->next_mutex,           "DeclInfo.next_mutex");
+	mutex_set_name(&d->proc_checked_mutex,   "DeclInfo.proc_checked_mutex");
+	mutex_set_name(&d->deps_mutex,           "DeclInfo.deps_mutex");
+	mutex_set_name(&d->type_info_deps_mutex, "DeclInfo.type_info_deps_mutex");
 	type_set_init(&d->type_info_deps, 0);
 	d->labels.allocator = heap_allocator();
 	d->variadic_reuses.allocator = heap_allocator();
@@ -188,7 +195,6 @@ gb_internal DeclInfo *make_decl_info(Scope *scope, DeclInfo *parent) {
 
 // gb_internal void destroy_declaration_info(DeclInfo *d) {
 // 	mutex_destroy(&d->proc_checked_mutex);
-// 	ptr_set_destroy(&d->deps);
 // 	array_free(&d->labels);
 // }
 
@@ -213,8 +219,16 @@ gb_internal DeclInfo *make_decl_info(Scope *scope, DeclInfo *parent) {
 
 
 
+// NOTE: Only counted with -show-stats
+gb_global std::atomic<isize> global_scope_count;
+
 gb_internal Scope *create_scope(CheckerInfo *info, Scope *parent) {
 	Scope *s = permanent_alloc_item<Scope>();
+	memory_account(MemorySubsystem_Scopes, gb_size_of(Scope));
+	if (build_context.show_stats) {
+		global_scope_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	mutex_set_name(&s->mutex, "Scope.mutex");
 	scope_map_init(&s->elements);
 	s->parent = parent;
 
@@ -387,6 +401,9 @@ gb_internal Entity *scope_lookup_current(Scope *s, InternedString name, u32 hash
 
 gb_global std::atomic<bool> in_single_threaded_checker_stage;
 
+// NOTE: For `-check-file`, only the procedure bodies declared within this file are checked
+gb_global AstFile *global_check_file;
+
 gb_internal void scope_lookup_parent(Scope *scope, InternedString name, Scope **scope_, Entity **entity_, u32 hash) {
 	bool is_single_threaded = in_single_threaded_checker_stage.load(std::memory_order_relaxed);
 	if (scope != nullptr) {
@@ -743,8 +760,12 @@ gb_internal void check_scope_usage_internal(Checker *c, Scope *scope, u64 vet_fl
 
 	rw_mutex_shared_lock(&scope->mutex);
 	for (auto const &entry : scope->elements) {
-		Entity *e = entry.value;
+		Entity *e = entry.value();
 		if (e == nullptr) continue;
+		if (global_check_file != nullptr && e->file != global_check_file) {
+			// NOTE: Whether these are used cannot be known, as the other bodies were not checked
+			continue;
+		}
 
 		vet_flags = original_vet_flags;
 		if (per_entity) {
@@ -757,6 +778,10 @@ gb_internal void check_scope_usage_internal(Checker *c, Scope *scope, u64 vet_fl
 		if (vet_unused_procedures && e->pkg && e->pkg->kind == Package_Runtime) {
 			vet_unused_procedures = false;
 		}
+		if (global_check_file != nullptr) {
+			// NOTE: A procedure may only be used by the bodies of other files, which were not checked
+			vet_unused_procedures = false;
+		}
 
 		VettedEntity ve_unused = {};
 		VettedEntity ve_shadowed = {};
@@ -873,10 +898,10 @@ gb_internal void check_scope_usage(Checker *c, Scope *scope, u64 vet_flags) {
 
 gb_internal void add_dependency(CheckerInfo *info, DeclInfo *d, Entity *e) {
 	if (in_single_threaded_checker_stage.load(std::memory_order_relaxed)) {
-		ptr_set_add(&d->deps, e);
+		entity_set_add(&d->deps, e);
 	} else {
 		rw_mutex_lock(&d->deps_mutex);
-		ptr_set_add(&d->deps, e);
+		entity_set_add(&d->deps, e);
 		rw_mutex_unlock(&d->deps_mutex);
 	}
 }
@@ -1110,9 +1135,79 @@ gb_internal i64 odin_compile_timestamp(void) {
 }
 
 
+// NOTE: Names which nearly every compilation interns, see `string_interner_preseed`. The keywords,
+// basic types and builtin procedures are taken from their own tables in `init_string_interner_preseed`.
+gb_global String const string_interner_preseed_names[] = {
+	// attributes
+	str_lit("builtin"), str_lit("cold"), str_lit("default_calling_convention"), str_lit("deferred"),
+	str_lit("deferred_in"), str_lit("deferred_in_by_ptr"), str_lit("deferred_in_out"),
+	str_lit("deferred_in_out_by_ptr"), str_lit("deferred_none"), str_lit("deferred_out"),
+	str_lit("deferred_out_by_ptr"), str_lit("deprecated"), str_lit("disabled"),
+	str_lit("enable_target_feature"), str_lit("entry_point_only"), str_lit("export"),
+	str_lit("extra_linker_flags"), str_lit("fast_math"), str_lit("fini"), str_lit("force"),
+	str_lit("ignore_duplicates"), str_lit("init"), str_lit("instrumentation_enter"),
+	str_lit("instrumentation_exit"), str_lit("link_name"), str_lit("link_prefix"), str_lit("link_section"),
+	str_lit("link_suffix"), str_lit("linkage"), str_lit("no_instrumentation"), str_lit("no_sanitize_address"),
+	str_lit("optimization_mode"), str_lit("private"), str_lit("require"), str_lit("require_results"),
+	str_lit("require_target_feature"), str_lit("rodata"), str_lit("static"), str_lit("target_clones"),
+	str_lit("test"), str_lit("thread_local"),
+	// directives
+	str_lit("force_inline"), str_lit("force_no_inline"), str_lit("no_bounds_check"), str_lit("bounds_check"),
+	str_lit("type"), str_lit("caller_location"), str_lit("caller_expression"), str_lit("location"),
+	str_lit("load"), str_lit("config"), str_lit("assert"), str_lit("panic"), str_lit("partial"),
+	str_lit("unroll"), str_lit("reverse"), str_lit("optional_ok"), str_lit("optional_allocator_error"),
+	str_lit("no_alias"), str_lit("any_int"), str_lit("c_vararg"), str_lit("by_ptr"), str_lit("no_broadcast"),
+	str_lit("const"), str_lit("packed"), str_lit("raw_union"), str_lit("align"), str_lit("no_nil"),
+	str_lit("shared_nil"), str_lit("sparse"), str_lit("simd"), str_lit("soa"), str_lit("file"), str_lit("line"),
+	str_lit("procedure"), str_lit("exists"), str_lit("defined"), str_lit("directory"), str_lit("hash"),
+	str_lit("no_copy"), str_lit("eval"),
+	// base:runtime
+	str_lit("runtime"), str_lit("context"), str_lit("allocator"), str_lit("temp_allocator"), str_lit("logger"),
+	str_lit("user_ptr"), str_lit("user_index"), str_lit("assertion_failure_proc"), str_lit("random_generator"),
+	str_lit("Allocator"), str_lit("Allocator_Error"), str_lit("Allocator_Mode"), str_lit("Allocator_Proc"),
+	str_lit("Logger"), str_lit("Context"), str_lit("Source_Code_Location"), str_lit("file_path"),
+	str_lit("column"), str_lit("Type_Info"), str_lit("Typeid_Kind"), str_lit("Raw_String"),
+	str_lit("Raw_Cstring"), str_lit("Raw_Slice"), str_lit("Raw_Dynamic_Array"), str_lit("Raw_Map"),
+	str_lit("Raw_Any"), str_lit("Map_Info"), str_lit("Map_Cell_Info"), str_lit("Map_Hash"), str_lit("data"),
+	str_lit("len"), str_lit("cap"), str_lit("size"), str_lit("alignment"), str_lit("ptr"), str_lit("id"),
+	str_lit("variant"), str_lit("flags"), str_lit("elem"), str_lit("elem_size"), str_lit("index"),
+	str_lit("key"), str_lit("value"), str_lit("types"), str_lit("names"), str_lit("offsets"), str_lit("tags"),
+	str_lit("base"), str_lit("fields"), str_lit("field_count"), str_lit("ok"), str_lit("err"),
+	str_lit("old_size"), str_lit("old_memory"), str_lit("new_size"), str_lit("mode"), str_lit("main"),
+	str_lit("default_context"), str_lit("bounds_check_error"), str_lit("slice_expr_error_hi"),
+	str_lit("slice_expr_error_lo_hi"), str_lit("multi_pointer_slice_expr_error"),
+	str_lit("matrix_bounds_check_error"), str_lit("type_assertion_check"), str_lit("type_assertion_check2"),
+	str_lit("dynamic_array_expr_error"), str_lit("memset"), str_lit("memcpy"), str_lit("memmove"),
+	str_lit("mem_zero"), str_lit("mem_copy"), str_lit("mem_copy_non_overlapping"), str_lit("print_string"),
+	str_lit("print_byte"), str_lit("x"), str_lit("y"), str_lit("z"), str_lit("w"), str_lit("r"), str_lit("g"),
+	str_lit("b"), str_lit("a"), str_lit("i"), str_lit("j"), str_lit("n"), str_lit("v"), str_lit("s"),
+	str_lit("p"),
+};
+
+gb_internal void init_string_interner_preseed(void) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	auto names = array_make<String>(temporary_allocator(), 0, 1024);
+	for (i32 kind = Token__KeywordBegin+1; kind < Token__KeywordEnd; kind++) {
+		array_add(&names, token_strings[kind]);
+	}
+	for (isize i = 0; i < gb_count_of(basic_types); i++) {
+		array_add(&names, basic_types[i].Basic.name);
+	}
+	for (isize i = 0; i < gb_count_of(builtin_procs); i++) {
+		array_add(&names, builtin_procs[i].name);
+	}
+	for (isize i = 0; i < gb_count_of(string_interner_preseed_names); i++) {
+		array_add(&names, string_interner_preseed_names[i]);
+	}
+	string_interner_preseed(names.data, names.count);
+}
+
 gb_internal void init_universal(void) {
 	BuildContext *bc = &build_context;
 
+	init_string_interner_preseed();
+
 	builtin_pkg    = create_builtin_package("builtin");
 	intrinsics_pkg = create_builtin_package("intrinsics");
 	config_pkg     = create_builtin_package("config");
@@ -1599,12 +1694,26 @@ gb_internal void init_checker_info(CheckerInfo *i) {
 
 	TIME_SECTION("checker info: general");
 
+	mutex_set_name(&i->builtin_mutex,           "CheckerInfo.builtin_mutex");
+	mutex_set_name(&i->lazy_mutex,              "CheckerInfo.lazy_mutex");
+	mutex_set_name(&i->foreign_mutex,           "CheckerInfo.foreign_mutex");
+	mutex_set_name(&i->objc_objc_msgSend_mutex, "CheckerInfo.objc_objc_msgSend_mutex");
+	mutex_set_name(&i->objc_class_name_mutex,   "CheckerInfo.objc_class_name_mutex");
+	mutex_set_name(&i->objc_method_mutex,       "CheckerInfo.objc_method_mutex");
+	mutex_set_name(&i->load_file_mutex,         "CheckerInfo.load_file_mutex");
+	mutex_set_name(&i->instrumentation_mutex,   "CheckerInfo.instrumentation_mutex");
+	mutex_set_name(&i->load_directory_mutex,    "CheckerInfo.load_directory_mutex");
+
 	array_init(&i->definitions,   a);
 	array_init(&i->entities,      a);
-	map_init(&i->global_untyped);
+	concurrent_map_init(&i->global_untyped);
+	if (build_context.proc_cost_report) {
+		concurrent_map_init(&global_proc_costs);
+	}
 	string_map_init(&i->foreigns);
 
 	type_set_init(&i->min_dep_type_info_set);
+	type_set_init(&i->min_dep_type_info_root_set);
 	map_init(&i->min_dep_type_info_index_map);
 
 	string_map_init(&i->files);
@@ -1615,6 +1724,7 @@ gb_internal void init_checker_info(CheckerInfo *i) {
 	array_init(&i->fini_procedures, a, 0, 0);
 	array_init(&i->required_foreign_imports_through_force, a, 0, 0);
 	array_init(&i->defineables, a);
+	array_init(&i->unroll_reports, a);
 
 	map_init(&i->objc_msgSend_types);
 	mpsc_init(&i->objc_class_implementations, a);
@@ -1634,19 +1744,24 @@ gb_internal void init_checker_info(CheckerInfo *i) {
 	mpsc_init(&i->intrinsics_entry_point_usage, a); // 1<<10); // just waste some memory here, even if it probably never used
 
 	mpsc_init(&i->raddbg_type_views_queue, a);
+	mpsc_init(&i->entity_uses_queue, a);
 	array_init(&i->raddbg_type_views, a);
 
 	string_map_init(&i->load_directory_cache);
 	map_init(&i->load_directory_map);
+
+	string_map_init(&i->when_cond_cache);
 }
 
 gb_internal void destroy_checker_info(CheckerInfo *i) {
 	array_free(&i->definitions);
 	array_free(&i->entities);
-	map_destroy(&i->global_untyped);
+	concurrent_map_destroy(&i->global_untyped);
 	string_map_destroy(&i->foreigns);
+	string_map_destroy(&i->when_cond_cache);
 
 	type_set_destroy(&i->min_dep_type_info_set);
+	type_set_destroy(&i->min_dep_type_info_root_set);
 	map_destroy(&i->min_dep_type_info_index_map);
 
 	string_map_destroy(&i->files);
@@ -1654,6 +1769,7 @@ gb_internal void destroy_checker_info(CheckerInfo *i) {
 	array_free(&i->variable_init_order);
 	array_free(&i->required_foreign_imports_through_force);
 	array_free(&i->defineables);
+	array_free(&i->unroll_reports);
 
 	array_free(&i->all_procedures);
 
@@ -1856,44 +1972,131 @@ gb_internal DeclInfo *decl_info_of_entity(Entity *e) {
 // 	}
 // 	return nullptr;
 // }
-gb_internal ExprInfo *check_get_expr_info(CheckerContext *c, Ast *expr) {
-	if (c->untyped != nullptr) {
-		ExprInfo **found = map_get(c->untyped, expr);
-		if (found) {
-			return *found;
+gb_internal gb_inline UntypedExprInfo *untyped_expr_info_map_entry(UntypedExprInfoMap *m, u32 index) {
+	return &m->blocks[index >> UNTYPED_EXPR_INFO_BLOCK_SHIFT][index & (UNTYPED_EXPR_INFO_BLOCK_SIZE-1)];
+}
+
+gb_internal void untyped_expr_info_map_release_indices(UntypedExprInfoMap *m) {
+	// NOTE: Only the indices this map still owns are reset, another worker may have claimed the node since
+	for (u32 i = 0; i < m->count; i++) {
+		UntypedExprInfo *entry = untyped_expr_info_map_entry(m, i);
+		if (entry->expr != nullptr) {
+			u32 expected = i+1;
+			entry->expr->untyped_index.compare_exchange_strong(expected, 0, std::memory_order_relaxed);
 		}
+	}
+}
+
+gb_internal void untyped_expr_info_map_destroy(UntypedExprInfoMap *m) {
+	untyped_expr_info_map_release_indices(m);
+	for (UntypedExprInfo *block : m->blocks) {
+		gb_free(heap_allocator(), block);
+	}
+	array_free(&m->blocks);
+	map_destroy(&m->shared);
+	m->shared = {};
+	m->count = 0;
+}
+
+gb_internal void untyped_expr_info_map_clear(UntypedExprInfoMap *m) {
+	// NOTE: The blocks are kept around to be reused
+	untyped_expr_info_map_release_indices(m);
+	map_clear(&m->shared);
+	m->count = 0;
+}
+
+gb_internal ExprInfo *untyped_expr_info_map_entry_info(UntypedExprInfoMap *m, u32 index, Ast *expr) {
+	if (index == 0 || index > m->count) {
 		return nullptr;
-	} else {
-		rw_mutex_shared_lock(&c->info->global_untyped_mutex);
-		ExprInfo **found = map_get(&c->info->global_untyped, expr);
-		rw_mutex_shared_unlock(&c->info->global_untyped_mutex);
-		if (found) {
-			return *found;
-		}
+	}
+	UntypedExprInfo *entry = untyped_expr_info_map_entry(m, index-1);
+	if (entry->expr != expr) {
 		return nullptr;
 	}
+	return &entry->info;
+}
+
+gb_internal ExprInfo *untyped_expr_info_map_get(UntypedExprInfoMap *m, Ast *expr) {
+	ExprInfo *info = untyped_expr_info_map_entry_info(m, expr->untyped_index.load(std::memory_order_relaxed), expr);
+	if (info == nullptr && m->shared.count != 0) {
+		u32 *found = map_get(&m->shared, expr);
+		if (found != nullptr) {
+			info = untyped_expr_info_map_entry_info(m, *found, expr);
+		}
+	}
+	return info;
+}
+
+gb_internal void untyped_expr_info_map_set(UntypedExprInfoMap *m, Ast *expr, ExprInfo const &info) {
+	ExprInfo *found = untyped_expr_info_map_get(m, expr);
+	if (found) {
+		*found = info;
+		return;
+	}
+
+	u32 index = m->count;
+	if ((index >> UNTYPED_EXPR_INFO_BLOCK_SHIFT) >= cast(u32)m->blocks.count) {
+		if (m->blocks.allocator.proc == nullptr) {
+			array_init(&m->blocks, heap_allocator());
+		}
+		array_add(&m->blocks, gb_alloc_array(heap_allocator(), UntypedExprInfo, UNTYPED_EXPR_INFO_BLOCK_SIZE));
+	}
+	UntypedExprInfo *entry = untyped_expr_info_map_entry(m, index);
+	entry->expr = expr;
+	entry->info = info;
+	m->count = index+1;
+
+	// NOTE: A node can be checked by more than one worker at once (e.g. the parameters of a polymorphic
+	// procedure are shared by its specializations), so the index is only claimed if no other map owns it
+	u32 expected = 0;
+	if (!expr->untyped_index.compare_exchange_strong(expected, m->count, std::memory_order_relaxed)) {
+		map_set(&m->shared, expr, m->count);
+	}
+}
+
+gb_internal void untyped_expr_info_map_remove(UntypedExprInfoMap *m, Ast *expr) {
+	u32 index = expr->untyped_index.load(std::memory_order_relaxed);
+	if (untyped_expr_info_map_entry_info(m, index, expr) != nullptr) {
+		// NOTE: Only the key is cleared, so the `ExprInfo` stays readable by the caller which removed it
+		untyped_expr_info_map_entry(m, index-1)->expr = nullptr;
+		expr->untyped_index.compare_exchange_strong(index, 0, std::memory_order_relaxed);
+		return;
+	}
+	u32 *found = m->shared.count != 0 ? map_get(&m->shared, expr) : nullptr;
+	if (found != nullptr && untyped_expr_info_map_entry_info(m, *found, expr) != nullptr) {
+		untyped_expr_info_map_entry(m, *found-1)->expr = nullptr;
+		map_remove(&m->shared, expr);
+	}
+}
+
+gb_internal ExprInfo *check_get_expr_info(CheckerContext *c, Ast *expr) {
+	if (c->untyped != nullptr) {
+		return untyped_expr_info_map_get(c->untyped, expr);
+	} else {
+		ExprInfo *found = nullptr;
+		concurrent_map_get(&c->info->global_untyped, expr, &found);
+		return found;
+	}
 }
 
 gb_internal void check_set_expr_info(CheckerContext *c, Ast *expr, AddressingMode mode, Type *type, ExactValue value) {
 	if (c->untyped != nullptr) {
-		map_set(c->untyped, expr, make_expr_info(mode, type, value, false));
+		ExprInfo info = {};
+		info.mode  = mode;
+		info.type  = type;
+		info.value = value;
+		untyped_expr_info_map_set(c->untyped, expr, info);
 	} else {
-		rw_mutex_lock(&c->info->global_untyped_mutex);
-		map_set(&c->info->global_untyped, expr, make_expr_info(mode, type, value, false));
-		rw_mutex_unlock(&c->info->global_untyped_mutex);
+		concurrent_map_set(&c->info->global_untyped, expr, make_expr_info(mode, type, value, false));
 	}
 }
 
 gb_internal void check_remove_expr_info(CheckerContext *c, Ast *e) {
 	if (c->untyped != nullptr) {
-		map_remove(c->untyped, e);
-		GB_ASSERT(map_get(c->untyped, e) == nullptr);
+		untyped_expr_info_map_remove(c->untyped, e);
+		GB_ASSERT(untyped_expr_info_map_get(c->untyped, e) == nullptr);
 	} else {
-		auto *untyped = &c->info->global_untyped;
-		rw_mutex_lock(&c->info->global_untyped_mutex);
-		map_remove(untyped, e);
-		GB_ASSERT(map_get(untyped, e) == nullptr);
-		rw_mutex_unlock(&c->info->global_untyped_mutex);
+		concurrent_map_remove(&c->info->global_untyped, e);
 	}
 }
 
@@ -1944,19 +2147,21 @@ gb_internal void add_untyped(CheckerContext *c, Ast *expr, AddressingMode mode,
 	check_set_expr_info(c, expr, mode, type, value);
 }
 
-struct alignas(GB_CACHE_LINE_SIZE) TypeAndValueMutexStripes {
-	BlockingMutex mutex;
-	u8 padding[GB_CACHE_LINE_SIZE - gb_size_of(BlockingMutex)];
-};
-
-enum { TypeAndValueMutexStripes_COUNT = 128 };
-gb_global TypeAndValueMutexStripes tav_mutex_stripes[TypeAndValueMutexStripes_COUNT];
+// NOTE: A node is nearly always written by the one thread which is checking the procedure body (or the
+// declaration) that contains it, so there is no shared mutex for `Ast::tav`. The only nodes which are
+// written by several threads at once are the ones shared between checks, e.g. the signature of a
+// polymorphic procedure which is being specialized concurrently, and for those a writer claims the node
+// through `Ast::tav_writer` so that the fields are never torn. Readers never block.
+gb_internal gb_inline void tav_writer_acquire(Ast *node) {
+	while (node->tav_writer.exchange(1, std::memory_order_acquire) != 0) {
+		while (node->tav_writer.load(std::memory_order_relaxed) != 0) {
+			yield_thread();
+		}
+	}
+}
 
-gb_internal BlockingMutex *tav_mutex_for_node(Ast *node) {
-	GB_ASSERT(node != nullptr);
-	uintptr h = cast(uintptr)node;
-	h ^= h >> 6;
-	return &tav_mutex_stripes[h % TypeAndValueMutexStripes_COUNT].mutex;
+gb_internal gb_inline void tav_writer_release(Ast *node) {
+	node->tav_writer.store(0, std::memory_order_release);
 }
 
 gb_internal void add_type_and_value(CheckerContext *ctx, Ast *expr, AddressingMode mode, Type *type, ExactValue const &value) {
@@ -1970,21 +2175,13 @@ gb_internal void add_type_and_value(CheckerContext *ctx, Ast *expr, AddressingMo
 		return;
 	}
 
-	BlockingMutex *mutex = tav_mutex_for_node(expr);
-
-	/* Previous logic:
-		BlockingMutex *mutex = &ctx->info->type_and_value_mutex;
-		if (ctx->decl) {
-			mutex = &ctx->decl->type_and_value_mutex;
-		} else if (ctx->pkg) {
-			mutex = &ctx->pkg->type_and_value_mutex;
-		}
-	*/
-
-	mutex_lock(mutex);
 	Ast *prev_expr = nullptr;
 	while (prev_expr != expr) {
 		prev_expr = expr;
+		tav_writer_acquire(expr);
+		if (build_context.ast_stats && expr->tav.mode == Addressing_Invalid) {
+			global_ast_annotated_node_count.fetch_add(1, std::memory_order_relaxed);
+		}
 		expr->tav.mode = mode;
 		if (type != nullptr && expr->tav.type != nullptr &&
 		    is_type_any(type) && is_type_untyped(expr->tav.type)) {
@@ -2000,13 +2197,13 @@ gb_internal void add_type_and_value(CheckerContext *ctx, Ast *expr, AddressingMo
 		} else if (mode == Addressing_Value && type != nullptr && is_type_proc(type)) {
 			expr->tav.value = value;
 		}
+		tav_writer_release(expr);
 
 		expr = unparen_expr(expr);
 		if (expr == nullptr) {
 			break;
 		};
 	}
-	mutex_unlock(mutex);
 }
 
 gb_internal void add_entity_definition(CheckerInfo *i, Ast *identifier, Entity *entity) {
@@ -2026,7 +2223,7 @@ gb_internal void add_entity_definition(CheckerInfo *i, Ast *identifier, Entity *
 
 gb_internal bool redeclaration_error(String name, Entity *prev, Entity *found) {
 	TokenPos pos = found->token.pos;
-	Entity *up = found->using_parent;
+	Entity *up = entity_cold_get(found)->using_parent;
 	if (up != nullptr) {
 		if (pos == up->token.pos) {
 			// NOTE(bill): Error should have been handled already
@@ -2072,7 +2269,7 @@ gb_internal void add_entity_flags_from_file(CheckerContext *c, Entity *e, Scope
 		AstPackage *pkg = c->file->pkg;
 		if (pkg->kind == Package_Init && e->kind == Entity_Procedure && e->token.string == "main") {
 			// Do nothing
-		} else if (e->flags & (EntityFlag_Test|EntityFlag_Init|EntityFlag_Fini)) {
+		} else if (e->flags & (EntityFlag_Test|EntityFlag_Benchmark|EntityFlag_Init|EntityFlag_Fini)) {
 			// Do nothing
 		} else {
 			e->flags |= EntityFlag_Lazy;
@@ -2142,14 +2339,19 @@ gb_internal void add_entity_use(CheckerContext *c, Ast *identifier, Entity *enti
 	entity->identifier.store(identifier);
 
 	identifier->Ident.entity = entity;
-
-	String dmsg = entity->deprecated_message;
-	if (dmsg.len > 0) {
-		warning(identifier, "%.*s is deprecated: %.*s", LIT(entity->token.string), LIT(dmsg));
+	if (build_context.export_symbol_index_file.len != 0) {
+		mpsc_enqueue(&c->info->entity_uses_queue, EntityUse{identifier, entity});
 	}
-	String wmsg = entity->warning_message;
-	if (wmsg.len > 0) {
-		warning(identifier, "%.*s: %.*s", LIT(entity->token.string), LIT(wmsg));
+
+	if (EntityCold *cold = entity->cold.load(std::memory_order_acquire)) {
+		String dmsg = cold->deprecated_message;
+		if (dmsg.len > 0) {
+			warning(identifier, "%.*s is deprecated: %.*s", LIT(entity->token.string), LIT(dmsg));
+		}
+		String wmsg = cold->warning_message;
+		if (wmsg.len > 0) {
+			warning(identifier, "%.*s: %.*s", LIT(entity->token.string), LIT(wmsg));
+		}
 	}
 }
 
@@ -2159,7 +2361,7 @@ gb_internal bool could_entity_be_lazy(Entity *e, DeclInfo *d) {
 		return false;
 	}
 
-	if (e->flags & (EntityFlag_Test|EntityFlag_Init|EntityFlag_Fini)) {
+	if (e->flags & (EntityFlag_Test|EntityFlag_Benchmark|EntityFlag_Init|EntityFlag_Fini)) {
 		return false;
 	} else if (e->kind == Entity_Variable && e->Variable.is_export) {
 		return false;
@@ -2187,7 +2389,7 @@ gb_internal bool could_entity_be_lazy(Entity *e, DeclInfo *d) {
 			}
 
 			if (name.len != 0) {
-				if (name == "test") {
+				if (name == "test" || name == "benchmark") {
 					return false;
 				} else if (name == "export") {
 					return false;
@@ -2548,6 +2750,12 @@ gb_internal void check_procedure_later(Checker *c, ProcInfo *info) {
 		debugf("CHECK PROCEDURE LATER! %.*s :: %s {...}\n", LIT(e->token.string), type_to_string(e->type));
 	}
 
+	if (global_check_file != nullptr && info->file != global_check_file) {
+		// NOTE: Bodies are never needed to evaluate anything outside of themselves, so any declared
+		// elsewhere can be skipped when only the diagnostics of a single file are wanted
+		return;
+	}
+
 	if (global_procedure_body_in_worker_queue.load()) {
 		thread_pool_add_task(check_proc_info_worker_proc, info);
 	} else {
@@ -2573,6 +2781,111 @@ gb_internal void check_procedure_later(Checker *c, AstFile *file, Token token, D
 }
 
 
+// NOTE: the minimum dependency set is built on the thread pool, so each thread collects the types it
+// reaches into its own sets (which also act as the recursion guard for `add_min_dep_type_info`) and
+// they are merged into `CheckerInfo` once the pool has finished, see `merge_min_dep_type_info_sets`
+struct MinDepTypeInfoThreadState {
+	MinDepTypeInfoThreadState *next;
+	TypeSet set;
+	TypeSet root_set;
+};
+
+gb_global std::atomic<MinDepTypeInfoThreadState *> min_dep_type_info_thread_states;
+gb_global gb_thread_local MinDepTypeInfoThreadState *min_dep_type_info_thread_state_;
+
+gb_internal MinDepTypeInfoThreadState *min_dep_type_info_thread_state(void) {
+	MinDepTypeInfoThreadState *ts = min_dep_type_info_thread_state_;
+	if (ts == nullptr) {
+		ts = gb_alloc_item(heap_allocator(), MinDepTypeInfoThreadState);
+
+		MinDepTypeInfoThreadState *head = min_dep_type_info_thread_states.load(std::memory_order_relaxed);
+		do {
+			ts->next = head;
+		} while (!min_dep_type_info_thread_states.compare_exchange_weak(head, ts));
+
+		min_dep_type_info_thread_state_ = ts;
+	}
+	return ts;
+}
+
+// NOTE: must only be called when no thread can be adding to the minimum dependency set
+gb_internal void merge_min_dep_type_info_sets(Checker *c) {
+	MinDepTypeInfoThreadState *head = min_dep_type_info_thread_states.load(std::memory_order_acquire);
+	for (MinDepTypeInfoThreadState *ts = head; ts != nullptr; ts = ts->next) {
+		for (TypeInfoPair const &tt : ts->set) {
+			type_set_update(&c->info.min_dep_type_info_set, tt);
+		}
+		for (TypeInfoPair const &tt : ts->root_set) {
+			type_set_update(&c->info.min_dep_type_info_root_set, tt);
+		}
+		type_set_destroy(&ts->set);
+		type_set_destroy(&ts->root_set);
+	}
+}
+
+// NOTE: -rtti:minimal; the types which are used directly (e.g. through `type_info_of` or `any`) keep their full
+// member information, as does every type reachable from them as an element, field, or variant, since walking a
+// value (e.g. `fmt` with `%v` or `json.marshal`) needs the names of the nested types too.
+// Only the types which are reachable through a procedure signature alone get the minimal form.
+gb_internal void add_min_dep_type_info_root(Checker *c, Type *t) {
+	if (!build_context.rtti_minimal || t == nullptr) {
+		return;
+	}
+	t = default_type(t);
+	if (is_type_untyped(t) || is_type_polymorphic(base_type(t))) {
+		return;
+	}
+	MinDepTypeInfoThreadState *ts = min_dep_type_info_thread_state();
+	if (type_set_update(&ts->root_set, t)) {
+		return;
+	}
+	Type *bt = base_type(t);
+	if (bt != t) {
+		add_min_dep_type_info_root(c, bt);
+		return;
+	}
+
+	switch (bt->kind) {
+	case Type_Pointer:         add_min_dep_type_info_root(c, bt->Pointer.elem);         break;
+	case Type_MultiPointer:    add_min_dep_type_info_root(c, bt->MultiPointer.elem);    break;
+	case Type_Array:           add_min_dep_type_info_root(c, bt->Array.elem);           break;
+	case Type_Slice:           add_min_dep_type_info_root(c, bt->Slice.elem);           break;
+	case Type_DynamicArray:    add_min_dep_type_info_root(c, bt->DynamicArray.elem);    break;
+	case Type_FixedCapacityDynamicArray: add_min_dep_type_info_root(c, bt->FixedCapacityDynamicArray.elem); break;
+	case Type_Matrix:          add_min_dep_type_info_root(c, bt->Matrix.elem);          break;
+	case Type_SimdVector:      add_min_dep_type_info_root(c, bt->SimdVector.elem);      break;
+	case Type_SoaPointer:      add_min_dep_type_info_root(c, bt->SoaPointer.elem);      break;
+	case Type_EnumeratedArray:
+		add_min_dep_type_info_root(c, bt->EnumeratedArray.index);
+		add_min_dep_type_info_root(c, bt->EnumeratedArray.elem);
+		break;
+	case Type_Map:
+		add_min_dep_type_info_root(c, bt->Map.key);
+		add_min_dep_type_info_root(c, bt->Map.value);
+		break;
+	case Type_Union:
+		for (Type *variant : bt->Union.variants) {
+			add_min_dep_type_info_root(c, variant);
+		}
+		break;
+	case Type_Struct:
+		for (Entity *f : bt->Struct.fields) {
+			add_min_dep_type_info_root(c, f->type);
+		}
+		break;
+	case Type_BitField:
+		for (Entity *f : bt->BitField.fields) {
+			add_min_dep_type_info_root(c, f->type);
+		}
+		break;
+	case Type_Tuple:
+		for (Entity *v : bt->Tuple.variables) {
+			add_min_dep_type_info_root(c, v->type);
+		}
+		break;
+	}
+}
+
 gb_internal void add_min_dep_type_info(Checker *c, Type *t) {
 	if (t == nullptr) {
 		return;
@@ -2585,7 +2898,7 @@ gb_internal void add_min_dep_type_info(Checker *c, Type *t) {
 		return;
 	}
 
-	if (type_set_update_with_mutex(&c->info.min_dep_type_info_set, t, &c->info.min_dep_type_info_set_mutex)) {
+	if (type_set_update(&min_dep_type_info_thread_state()->set, t)) {
 		return;
 	}
 
@@ -2694,7 +3007,7 @@ gb_internal void add_min_dep_type_info(Checker *c, Type *t) {
 	case Type_Struct:
 		if (bt->Struct.scope != nullptr) {
 			for (auto const &entry : bt->Struct.scope->elements) {
-				Entity *e = entry.value;
+				Entity *e = entry.value();
 				switch (bt->Struct.soa_kind) {
 				case StructSoa_Dynamic:
 					add_min_dep_type_info(c, t_type_info_ptr); // append_soa
@@ -2793,8 +3106,9 @@ gb_internal void add_dependency_to_set(Checker *c, Entity *entity) {
 	}
 	for (TypeInfoPair const tt : decl->type_info_deps) {
 		add_min_dep_type_info(c, tt.type);
+		add_min_dep_type_info_root(c, tt.type);
 	}
-	FOR_PTR_SET(e, decl->deps) {
+	for (Entity *e : decl->deps) {
 		switch (e->kind) {
 		case Entity_Procedure:
 			if (e->Procedure.is_foreign) {
@@ -2821,7 +3135,7 @@ gb_internal void add_dependency_to_set(Checker *c, Entity *entity) {
 		}
 	}
 
-	FOR_PTR_SET(e, decl->deps) {
+	for (Entity *e : decl->deps) {
 		add_dependency_to_set(c, e);
 	}
 
@@ -2851,9 +3165,10 @@ gb_internal WORKER_TASK_PROC(add_dependency_to_set_worker) {
 	}
 	for (TypeInfoPair const tt : decl->type_info_deps) {
 		add_min_dep_type_info(c, tt.type);
+		add_min_dep_type_info_root(c, tt.type);
 	}
 
-	FOR_PTR_SET(e, decl->deps) {
+	for (Entity *e : decl->deps) {
 		switch (e->kind) {
 		case Entity_Procedure:
 			if (e->Procedure.is_foreign) {
@@ -2880,7 +3195,7 @@ gb_internal WORKER_TASK_PROC(add_dependency_to_set_worker) {
 		}
 	}
 
-	FOR_PTR_SET(e, decl->deps) {
+	for (Entity *e : decl->deps) {
 		add_dependency_to_set_threaded(c, e);
 	}
 
@@ -2892,6 +3207,12 @@ gb_internal void add_dependency_to_set_threaded(Checker *c, Entity *entity) {
 	if (entity == nullptr) {
 		return;
 	}
+	// NOTE: Most edges of the dependency graph lead to an entity which has already been reached,
+	// so skip the task entirely for those. This check is racy, but the worker still performs the
+	// definitive `fetch_add`, so at worst a redundant task gets queued.
+	if (entity->min_dep_count.load(std::memory_order_relaxed) > 0) {
+		return;
+	}
 	thread_pool_add_task(add_dependency_to_set_worker, entity);
 }
 
@@ -2908,12 +3229,15 @@ gb_internal void force_add_dependency_entity(Checker *c, Scope *scope, String co
 	add_dependency_to_set(c, e);
 }
 
+// NOTE: With `odin bench` the @(benchmark) procedures are collected instead of the @(test) ones, into the same array
 gb_internal void collect_testing_procedures_of_package(Checker *c, AstPackage *pkg) {
+	bool benchmark = build_context.benchmark;
 	AstPackage *testing_package = get_core_package(&c->info, str_lit("testing"));
 	Scope *testing_scope = testing_package->scope;
 	u32 hash = 0;
-	InternedString interned = string_interner_insert(str_lit("Test_Signature"), 0, &hash);
+	InternedString interned = string_interner_insert(benchmark ? str_lit("Benchmark_Signature") : str_lit("Test_Signature"), 0, &hash);
 	Entity *test_signature = scope_lookup_current(testing_scope, interned, hash);
+	u64 flag = benchmark ? EntityFlag_Benchmark : EntityFlag_Test;
 
 	for_array(i, c->info.entities) {
 		Entity *e = c->info.entities[i];
@@ -2924,7 +3248,7 @@ gb_internal void collect_testing_procedures_of_package(Checker *c, AstPackage *p
 			continue;
 		}
 
-		if ((e->flags & EntityFlag_Test) == 0) {
+		if ((e->flags & flag) == 0) {
 			continue;
 		}
 
@@ -2938,7 +3262,11 @@ gb_internal void collect_testing_procedures_of_package(Checker *c, AstPackage *p
 			// Good
 		} else {
 			gbString str = type_to_string(t);
-			error(e->token, "Testing procedures must have a signature type of proc(^testing.T), got %s", str);
+			if (benchmark) {
+				error(e->token, "Benchmark procedures must have a signature type of proc(^testing.B), got %s", str);
+			} else {
+				error(e->token, "Testing procedures must have a signature type of proc(^testing.T), got %s", str);
+			}
 			gb_string_free(str);
 			is_tester = false;
 		}
@@ -3085,7 +3413,7 @@ gb_internal void generate_minimum_dependency_set_internal(Checker *c, Entity *st
 
 		// Add all of testing library as a dependency
 		for (auto const &entry : testing_scope->elements) {
-			Entity *e = entry.value;
+			Entity *e = entry.value();
 			if (e != nullptr) {
 				e->flags |= EntityFlag_Used;
 				add_to_set(c, e);
@@ -3201,6 +3529,10 @@ gb_internal void generate_minimum_dependency_set(Checker *c, Entity *start) {
 		str_lit("multi_pointer_slice_expr_error"),
 	);
 
+	FORCE_ADD_RUNTIME_ENTITIES(build_context.instrument_allocations,
+		str_lit("allocation_site_hook"),
+	);
+
 	add_dependency_to_set(c, c->info.instrumentation_enter_entity);
 	add_dependency_to_set(c, c->info.instrumentation_exit_entity);
 
@@ -3208,6 +3540,8 @@ gb_internal void generate_minimum_dependency_set(Checker *c, Entity *start) {
 
 	thread_pool_wait();
 
+	merge_min_dep_type_info_sets(c);
+
 
 #undef FORCE_ADD_RUNTIME_ENTITIES
 }
@@ -3262,7 +3596,7 @@ gb_internal Array<EntityGraphNode *> generate_entity_dependency_graph(CheckerInf
 		DeclInfo *decl = decl_info_of_entity(e);
 		GB_ASSERT(decl != nullptr);
 
-		FOR_PTR_SET(dep, decl->deps) {
+		for (Entity *dep : decl->deps) {
 			GB_ASSERT(dep != nullptr);
 			if (dep->flags & EntityFlag_Field) {
 				continue;
@@ -3843,6 +4177,12 @@ gb_internal DECL_ATTRIBUTE_PROC(proc_decl_attribute) {
 		}
 		ac->test = true;
 		return true;
+	} else if (name == "benchmark") {
+		if (value != nullptr) {
+			error(value, "Expected no value for '%.*s'", LIT(name));
+		}
+		ac->benchmark = true;
+		return true;
 	} else if (name == "export") {
 		ExactValue ev = check_decl_attribute_value(c, value);
 		if (ev.kind == ExactValue_Invalid) {
@@ -4112,6 +4452,17 @@ gb_internal DECL_ATTRIBUTE_PROC(proc_decl_attribute) {
 			}
 		}
 		return true;
+	} else if (name == "max_stack_usage") {
+		ExactValue ev = check_decl_attribute_value(c, value);
+		if (ev.kind != ExactValue_Integer) {
+			error(elem, "Expected an integer value for '%.*s'", LIT(name));
+		} else if (big_int_is_neg(&ev.value_integer)) {
+			error(elem, "Expected a non-negative number of bytes for '%.*s'", LIT(name));
+		} else {
+			ac->has_max_stack_usage = true;
+			ac->max_stack_usage = exact_value_to_i64(ev);
+		}
+		return true;
 	} else if (name == "optimization_mode") {
 		ExactValue ev = check_decl_attribute_value(c, value);
 		if (ev.kind == ExactValue_String) {
@@ -4215,6 +4566,14 @@ gb_internal DECL_ATTRIBUTE_PROC(proc_decl_attribute) {
 			error(elem, "Expected a string value for '%.*s'", LIT(name));
 		}
 		return true;
+	} else if (name == "target_clones") {
+		ExactValue ev = check_decl_attribute_value(c, value);
+		if (ev.kind == ExactValue_String) {
+			ac->target_clones = ev.value_string;
+		} else {
+			error(elem, "Expected a string value for '%.*s'", LIT(name));
+		}
+		return true;
 	} else if (name == "entry_point_only") {
 		if (value != nullptr) {
 			error(value, "'%.*s' expects no parameter", LIT(name));
@@ -4551,6 +4910,7 @@ gb_internal DECL_ATTRIBUTE_PROC(type_decl_attribute) {
 
 
 #include "check_expr.cpp"
+#include "check_eval.cpp"
 #include "check_builtin.cpp"
 #include "check_type.cpp"
 #include "name_canonicalization.cpp"
@@ -4715,21 +5075,104 @@ gb_internal bool check_arity_match(CheckerContext *c, AstValueDecl *vd, bool is_
 	return true;
 }
 
-gb_internal void check_collect_entities_from_when_stmt(CheckerContext *c, AstWhenStmt *ws) {
-	Operand operand = {Addressing_Invalid};
-	if (!ws->is_cond_determined) {
-		check_expr(c, &operand, ws->cond);
-		if (operand.mode != Addressing_Invalid && !is_type_boolean(operand.type)) {
-			error(ws->cond, "Non-boolean condition in 'when' statement");
+// NOTE: Returns false if `expr` refers to anything but the builtin constants (e.g. `ODIN_OS`),
+// otherwise the key is the same for every file which uses the same condition
+gb_internal bool write_when_cond_cache_key(CheckerContext *c, gbString *key, Ast *expr) {
+	switch (expr->kind) {
+	case_ast_node(i, Ident, expr);
+		Entity *e = scope_lookup(c->scope, i->interned, i->hash);
+		if (e == nullptr || e->kind != Entity_Constant || e->scope != builtin_pkg->scope) {
+			return false;
+		}
+		*key = gb_string_append_length(*key, i->token.string.text, i->token.string.len);
+		return true;
+	case_end;
+	case_ast_node(ise, ImplicitSelectorExpr, expr);
+		if (ise->selector == nullptr || ise->selector->kind != Ast_Ident) {
+			return false;
+		}
+		String name = ise->selector->Ident.token.string;
+		*key = gb_string_appendc(*key, ".");
+		*key = gb_string_append_length(*key, name.text, name.len);
+		return true;
+	case_end;
+	case_ast_node(bl, BasicLit, expr);
+		*key = gb_string_append_length(*key, bl->token.string.text, bl->token.string.len);
+		return true;
+	case_end;
+	case_ast_node(pe, ParenExpr, expr);
+		return write_when_cond_cache_key(c, key, pe->expr);
+	case_end;
+	case_ast_node(ue, UnaryExpr, expr);
+		*key = gb_string_append_length(*key, token_strings[ue->op.kind].text, token_strings[ue->op.kind].len);
+		return write_when_cond_cache_key(c, key, ue->expr);
+	case_end;
+	case_ast_node(be, BinaryExpr, expr);
+		*key = gb_string_appendc(*key, "(");
+		if (!write_when_cond_cache_key(c, key, be->left)) {
+			return false;
 		}
-		if (operand.mode != Addressing_Constant) {
-			error(ws->cond, "Non-constant condition in 'when' statement");
+		*key = gb_string_append_length(*key, token_strings[be->op.kind].text, token_strings[be->op.kind].len);
+		if (!write_when_cond_cache_key(c, key, be->right)) {
+			return false;
 		}
+		*key = gb_string_appendc(*key, ")");
+		return true;
+	case_end;
+	}
+	return false;
+}
+
+// NOTE: The same platform conditions (e.g. `when ODIN_OS == .Linux`) are repeated across many of the files
+// in `core:sys` and the like, so the result of a condition which only uses the builtin constants is memoized
+// by its text rather than being type checked again in every file
+gb_internal void check_file_when_stmt_cond(CheckerContext *c, AstWhenStmt *ws) {
+	if (ws->is_cond_determined) {
+		return;
+	}
 
-		ws->is_cond_determined = true;
-		ws->determined_cond = operand.value.kind == ExactValue_Bool && operand.value.value_bool;
+	TEMPORARY_ALLOCATOR_GUARD();
+	String key = {};
+	if (build_context.export_symbol_index_file.len == 0) { // the symbol index needs the uses of every identifier
+		gbString k = gb_string_make(temporary_allocator(), "");
+		if (write_when_cond_cache_key(c, &k, ws->cond)) {
+			key = make_string(cast(u8 const *)k, gb_string_length(k));
+		}
+	}
+	if (key.len != 0) {
+		mutex_lock(&c->info->when_cond_mutex);
+		bool *found = string_map_get(&c->info->when_cond_cache, key);
+		bool value = found != nullptr && *found;
+		mutex_unlock(&c->info->when_cond_mutex);
+		if (found != nullptr) {
+			ws->is_cond_determined = true;
+			ws->determined_cond = value;
+			return;
+		}
 	}
 
+	Operand operand = {Addressing_Invalid};
+	check_expr(c, &operand, ws->cond);
+	if (operand.mode != Addressing_Invalid && !is_type_boolean(operand.type)) {
+		error(ws->cond, "Non-boolean condition in 'when' statement");
+	}
+	if (operand.mode != Addressing_Constant) {
+		error(ws->cond, "Non-constant condition in 'when' statement");
+	}
+
+	ws->is_cond_determined = true;
+	ws->determined_cond = operand.value.kind == ExactValue_Bool && operand.value.value_bool;
+
+	if (key.len != 0 && operand.mode == Addressing_Constant && operand.value.kind == ExactValue_Bool) {
+		mutex_lock(&c->info->when_cond_mutex);
+		string_map_set(&c->info->when_cond_cache, copy_string(permanent_allocator(), key), ws->determined_cond);
+		mutex_unlock(&c->info->when_cond_mutex);
+	}
+}
+
+gb_internal void check_collect_entities_from_when_stmt(CheckerContext *c, AstWhenStmt *ws) {
+	check_file_when_stmt_cond(c, ws);
+
 	if (ws->body == nullptr || ws->body->kind != Ast_BlockStmt) {
 		error(ws->cond, "Invalid body for 'when' statement");
 	} else {
@@ -4825,6 +5268,7 @@ gb_internal void check_collect_value_decl(CheckerContext *c, Ast *decl) {
 
 	EntityVisiblityKind entity_visibility_kind = c->foreign_context.visibility_kind;
 	bool is_test = false;
+	bool is_benchmark = false;
 	bool is_init = false;
 	bool is_fini = false;
 	bool is_priv = false;
@@ -4887,6 +5331,8 @@ gb_internal void check_collect_value_decl(CheckerContext *c, Ast *decl) {
 				j -= 1;
 			} else if (name == "test") {
 				is_test = true;
+			} else if (name == "benchmark") {
+				is_benchmark = true;
 			} else if (name == "init") {
 				is_init = true;
 			} else if (name == "fini") {
@@ -4899,6 +5345,10 @@ gb_internal void check_collect_value_decl(CheckerContext *c, Ast *decl) {
 		error(decl, "Attribute 'private' is not allowed on a test case");
 		return;
 	}
+	if (is_priv && is_benchmark) {
+		error(decl, "Attribute 'private' is not allowed on a benchmark");
+		return;
+	}
 
 	if (entity_visibility_kind == EntityVisiblity_Public &&
 	    (c->scope->flags&ScopeFlag_File) &&
@@ -5039,6 +5489,9 @@ gb_internal void check_collect_value_decl(CheckerContext *c, Ast *decl) {
 				if (is_test) {
 					e->flags |= EntityFlag_Test;
 				}
+				if (is_benchmark) {
+					e->flags |= EntityFlag_Benchmark;
+				}
 				if (is_init && is_fini) {
 					error(name, "A procedure cannot be both declared as @(init) and @(fini)");
 				} else if (is_init) {
@@ -5135,7 +5588,7 @@ gb_internal bool correct_type_alias_in_scope_backwards(CheckerContext *c, Scope
 	bool correction = false;
 	for (u32 n = s->elements.count, i = n-1; i < n; i--) {
 		auto const &slot = s->elements.slots[i];
-		Entity *e = slot.value;
+		Entity *e = slot.value();
 		if (slot.hash && e != nullptr) {
 			correction |= correct_single_type_alias(c, e);
 		}
@@ -5145,9 +5598,9 @@ gb_internal bool correct_type_alias_in_scope_backwards(CheckerContext *c, Scope
 gb_internal bool correct_type_alias_in_scope_forwards(CheckerContext *c, Scope *s) {
 	bool correction = false;
 	for (auto const &entry : s->elements) {
-		Entity *e = entry.value;
+		Entity *e = entry.value();
 		if (e != nullptr) {
-			correction |= correct_single_type_alias(c, entry.value);
+			correction |= correct_single_type_alias(c, entry.value());
 		}
 	}
 	return correction;
@@ -5717,7 +6170,7 @@ gb_internal void check_foreign_import_fullpaths(Checker *c) {
 	init_checker_context(&ctx, c);
 
 	UntypedExprInfoMap untyped = {};
-	defer (map_destroy(&untyped));
+	defer (untyped_expr_info_map_destroy(&untyped));
 
 	for (Entity *e = nullptr; mpsc_dequeue(&c->info.foreign_imports_to_check_fullpaths, &e); /**/) {
 		GB_ASSERT(e != nullptr);
@@ -5883,19 +6336,7 @@ gb_internal bool collect_file_decls(CheckerContext *ctx, Slice<Ast *> const &dec
 gb_internal bool collect_file_decls_from_when_stmt(CheckerContext *ctx, AstWhenStmt *ws);
 
 gb_internal bool collect_when_stmt_from_file(CheckerContext *ctx, AstWhenStmt *ws) {
-	Operand operand = {Addressing_Invalid};
-	if (!ws->is_cond_determined) {
-		check_expr(ctx, &operand, ws->cond);
-		if (operand.mode != Addressing_Invalid && !is_type_boolean(operand.type)) {
-			error(ws->cond, "Non-boolean condition in 'when' statement");
-		}
-		if (operand.mode != Addressing_Constant) {
-			error(ws->cond, "Non-constant condition in 'when' statement");
-		}
-
-		ws->is_cond_determined = true;
-		ws->determined_cond = operand.value.kind == ExactValue_Bool && operand.value.value_bool;
-	}
+	check_file_when_stmt_cond(ctx, ws);
 
 	if (ws->body == nullptr || ws->body->kind != Ast_BlockStmt) {
 		error(ws->cond, "Invalid body for 'when' statement");
@@ -5922,19 +6363,7 @@ gb_internal bool collect_when_stmt_from_file(CheckerContext *ctx, AstWhenStmt *w
 }
 
 gb_internal bool collect_file_decls_from_when_stmt(CheckerContext *ctx, AstWhenStmt *ws) {
-	Operand operand = {Addressing_Invalid};
-	if (!ws->is_cond_determined) {
-		check_expr(ctx, &operand, ws->cond);
-		if (operand.mode != Addressing_Invalid && !is_type_boolean(operand.type)) {
-			error(ws->cond, "Non-boolean condition in 'when' statement");
-		}
-		if (operand.mode != Addressing_Constant) {
-			error(ws->cond, "Non-constant condition in 'when' statement");
-		}
-
-		ws->is_cond_determined = true;
-		ws->determined_cond = operand.value.kind == ExactValue_Bool && operand.value.value_bool;
-	}
+	check_file_when_stmt_cond(ctx, ws);
 
 	if (ws->body == nullptr || ws->body->kind != Ast_BlockStmt) {
 		error(ws->cond, "Invalid body for 'when' statement");
@@ -6072,6 +6501,11 @@ struct CollectEntityWorkerData {
 
 gb_global CollectEntityWorkerData *collect_entity_worker_data;
 
+struct CollectEntitiesTask {
+	AstFile *    file;
+	Slice<Ast *> decls;
+};
+
 gb_internal WORKER_TASK_PROC(check_collect_entities_all_worker_proc) {
 	CollectEntityWorkerData *wd = &collect_entity_worker_data[current_thread_index()];
 
@@ -6079,10 +6513,11 @@ gb_internal WORKER_TASK_PROC(check_collect_entities_all_worker_proc) {
 	CheckerContext *ctx = &wd->ctx;
 	UntypedExprInfoMap *untyped = &wd->untyped;
 
-	AstFile *f = cast(AstFile *)data;
+	CollectEntitiesTask *task = cast(CollectEntitiesTask *)data;
+	AstFile *f = task->file;
 	reset_checker_context(ctx, f, untyped);
 
-	check_collect_entities(ctx, f->decls);
+	check_collect_entities(ctx, task->decls);
 	GB_ASSERT(ctx->collect_delayed_decls == false);
 
 	add_untyped_expressions(&c->info, ctx->untyped);
@@ -6090,6 +6525,65 @@ gb_internal WORKER_TASK_PROC(check_collect_entities_all_worker_proc) {
 	return 0;
 }
 
+struct TypeLayoutWorkerData {
+	Type **types;
+	isize  count;
+};
+
+gb_internal void check_compute_type_layout(Type *t) {
+	if (t == nullptr || !is_type_typed(t) || is_type_polymorphic(t)) {
+		return;
+	}
+	type_size_of(t);
+	type_align_of(t);
+
+	Type *bt = base_type(t);
+	if (bt->kind == Type_Struct || bt->kind == Type_Tuple) {
+		type_set_offsets(bt);
+	}
+}
+
+gb_internal WORKER_TASK_PROC(check_compute_type_layouts_worker_proc) {
+	TypeLayoutWorkerData *wd = cast(TypeLayoutWorkerData *)data;
+	for (isize i = 0; i < wd->count; i++) {
+		check_compute_type_layout(wd->types[i]);
+	}
+	return 0;
+}
+
+// NOTE: Computes the size, alignment, and field offsets of every type which requires
+// runtime type information ahead of the backend, spread across the thread pool. The
+// layouts are frozen beforehand so that each nested type is only laid out once and
+// shared by every type which contains it.
+gb_internal void check_compute_type_layouts(Checker *c) {
+	if (any_errors()) {
+		return;
+	}
+	g_type_layouts_frozen.store(true, std::memory_order_relaxed);
+
+	isize type_count = c->info.min_dep_type_info_set.count;
+	if (type_count == 0) {
+		return;
+	}
+
+	Type **types = gb_alloc_array(permanent_allocator(), Type *, type_count);
+	isize index = 0;
+	for (auto const &tt : c->info.min_dep_type_info_set) {
+		types[index++] = tt.type;
+	}
+	type_count = index;
+
+	isize thread_count = gb_max(global_thread_pool.threads.count, 1);
+	isize chunk_size = gb_max((type_count + thread_count*4 - 1) / (thread_count*4), 64);
+	for (isize offset = 0; offset < type_count; offset += chunk_size) {
+		auto *wd = gb_alloc_item(permanent_allocator(), TypeLayoutWorkerData);
+		wd->types = types + offset;
+		wd->count = gb_min(chunk_size, type_count - offset);
+		thread_pool_add_task(check_compute_type_layouts_worker_proc, wd);
+	}
+	thread_pool_wait();
+}
+
 gb_internal void check_collect_entities_all(Checker *c) {
 	isize thread_count = global_thread_pool.threads.count;
 
@@ -6098,12 +6592,55 @@ gb_internal void check_collect_entities_all(Checker *c) {
 		auto *wd = &collect_entity_worker_data[i];
 		wd->c = c;
 		init_checker_context(&wd->ctx, c);
-		map_init(&wd->untyped);
+		wd->untyped = {};
 	}
 
+	// NOTE: Files with a huge number of top level declarations (e.g. generated bindings) are split up,
+	// otherwise a single such file is the critical path of this stage. Only the value declarations are
+	// chunked, as collecting them is independent of each other (the entities are added through the
+	// scope mutexes or the package's queue, and their source order is derived from their position).
+	// Everything else appends to the file's delayed queues, which stay with the first task in order.
+	isize const CHUNK_SIZE = 1024;
+
 	for (auto const &entry : c->info.files) {
 		AstFile *f = entry.value;
-		thread_pool_add_task(check_collect_entities_all_worker_proc, f);
+		if (f->decls.count <= CHUNK_SIZE || thread_count <= 1) {
+			auto *task = permanent_alloc_item<CollectEntitiesTask>();
+			task->file  = f;
+			task->decls = f->decls;
+			thread_pool_add_task(check_collect_entities_all_worker_proc, task);
+			continue;
+		}
+
+		auto head  = array_make<Ast *>(permanent_allocator(), 0, CHUNK_SIZE);
+		auto chunk = array_make<Ast *>(permanent_allocator(), 0, CHUNK_SIZE);
+		isize value_decl_count = 0;
+		for (Ast *decl : f->decls) {
+			if (decl->kind != Ast_ValueDecl || value_decl_count < CHUNK_SIZE) {
+				value_decl_count += decl->kind == Ast_ValueDecl;
+				array_add(&head, decl);
+				continue;
+			}
+			array_add(&chunk, decl);
+			if (chunk.count == CHUNK_SIZE) {
+				auto *task = permanent_alloc_item<CollectEntitiesTask>();
+				task->file  = f;
+				task->decls = slice_from_array(chunk);
+				thread_pool_add_task(check_collect_entities_all_worker_proc, task);
+				chunk = array_make<Ast *>(permanent_allocator(), 0, CHUNK_SIZE);
+			}
+		}
+		if (chunk.count != 0) {
+			auto *task = permanent_alloc_item<CollectEntitiesTask>();
+			task->file  = f;
+			task->decls = slice_from_array(chunk);
+			thread_pool_add_task(check_collect_entities_all_worker_proc, task);
+		}
+
+		auto *task = permanent_alloc_item<CollectEntitiesTask>();
+		task->file  = f;
+		task->decls = slice_from_array(head);
+		thread_pool_add_task(check_collect_entities_all_worker_proc, task);
 	}
 	thread_pool_wait();
 }
@@ -6137,7 +6674,7 @@ gb_internal void check_export_entities(Checker *c) {
 
 	for (isize i = 0; i < thread_count; i++) {
 		auto *wd = &collect_entity_worker_data[i];
-		map_clear(&wd->untyped);
+		untyped_expr_info_map_clear(&wd->untyped);
 		init_checker_context(&wd->ctx, c);
 	}
 
@@ -6209,7 +6746,7 @@ gb_internal void check_import_entities(Checker *c) {
 	init_checker_context(&ctx, c);
 
 	UntypedExprInfoMap untyped = {};
-	defer (map_destroy(&untyped));
+	defer (untyped_expr_info_map_destroy(&untyped));
 
 	isize min_pkg_index = 0;
 	for (isize pkg_index = 0; pkg_index < package_order.count; pkg_index++) {
@@ -6319,7 +6856,7 @@ gb_internal bool find_entity_path_tuple(Type *tuple, Entity *end, gbAllocator al
 			continue;
 		}
 
-		FOR_PTR_SET(dep, var_decl->deps) {
+		for (Entity *dep : var_decl->deps) {
 			if (dep == end) {
 				auto path = array_make<Entity *>(allocator);
 				array_add(&path, dep);
@@ -6369,7 +6906,7 @@ gb_internal Array<Entity *> find_entity_path(Entity *start, Entity *end, gbAlloc
 				return path;
 			}
 		} else {
-			FOR_PTR_SET(dep, decl->deps) {
+			for (Entity *dep : decl->deps) {
 				if (dep == end) {
 					auto path = array_make<Entity *>(allocator);
 					array_add(&path, dep);
@@ -6468,9 +7005,10 @@ gb_internal void check_procedure_later_from_entity(Checker *c, Entity *e, char c
 	}
 	if ((e->flags & EntityFlag_Overridden) != 0) {
 		// NOTE (zen3ger) Delay checking of a proc alias until the underlying proc is checked.
-		GB_ASSERT(e->aliased_of != nullptr);
-		GB_ASSERT(e->aliased_of->kind == Entity_Procedure);
-		if ((e->aliased_of->flags & EntityFlag_ProcBodyChecked) != 0) {
+		Entity *aliased_of = entity_cold_get(e)->aliased_of;
+		GB_ASSERT(aliased_of != nullptr);
+		GB_ASSERT(aliased_of->kind == Entity_Procedure);
+		if ((aliased_of->flags & EntityFlag_ProcBodyChecked) != 0) {
 			e->flags |= EntityFlag_ProcBodyChecked;
 			return;
 		}
@@ -6510,6 +7048,8 @@ gb_internal void check_procedure_later_from_entity(Checker *c, Entity *e, char c
 }
 
 
+gb_internal void proc_info_release_waiting(Checker *c, DeclInfo *decl);
+
 gb_internal bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped) {
 	if (pi == nullptr) {
 		return false;
@@ -6524,6 +7064,10 @@ gb_internal bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *u
 	defer (mutex_unlock(&pi->decl->proc_checked_mutex));
 
 	Entity *e = pi->decl->entity;
+	u64 cost_start = (build_context.proc_cost_report && e != nullptr) ? time_stamp_time_now() : 0;
+	defer (if (cost_start) {
+		proc_cost_info(e)->check_time.fetch_add(time_stamp_time_now() - cost_start, std::memory_order_relaxed);
+	});
 	switch (pi->decl->proc_checked_state.load()) {
 	case ProcCheckedState_InProgress:
 		if (e) {
@@ -6594,6 +7138,10 @@ gb_internal bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *u
 		ctx.state_flags &= ~StateFlag_type_assert;
 	}
 
+	if (pi->decl->proc_lit != nullptr && pi->decl->proc_lit->kind == Ast_ProcLit) {
+		parse_lazy_proc_body(pi->decl->proc_lit);
+	}
+
 	bool body_was_checked = check_proc_body(&ctx, pi->token, pi->decl, pi->type, pi->body);
 
 	if (body_was_checked) {
@@ -6616,8 +7164,12 @@ gb_internal bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *u
 
 	add_untyped_expressions(&c->info, ctx.untyped);
 
+	if (global_procedure_body_in_worker_queue.load(std::memory_order_relaxed)) {
+		proc_info_release_waiting(c, pi->decl);
+	}
+
 	rw_mutex_shared_lock(&ctx.decl->deps_mutex);
-	FOR_PTR_SET(dep, ctx.decl->deps) {
+	for (Entity *dep : ctx.decl->deps) {
 		if (dep && dep->kind == Entity_Procedure &&
 		    (dep->flags & EntityFlag_ProcBodyChecked) == 0) {
 			check_procedure_later_from_entity(c, dep, NULL);
@@ -6641,7 +7193,7 @@ gb_internal void check_unchecked_bodies(Checker *c) {
 	GB_ASSERT(c->procs_to_check.count == 0);
 
 	UntypedExprInfoMap untyped = {};
-	defer (map_destroy(&untyped));
+	defer (untyped_expr_info_map_destroy(&untyped));
 
 	// use the `procs_to_check` array
 	global_procedure_body_in_worker_queue = false;
@@ -6669,7 +7221,7 @@ gb_internal void check_unchecked_bodies(Checker *c) {
 gb_internal void check_safety_all_procedures_for_unchecked(Checker *c) {
 	GB_ASSERT(DEBUG_CHECK_ALL_PROCEDURES);
 	UntypedExprInfoMap untyped = {};
-	defer (map_destroy(&untyped));
+	defer (untyped_expr_info_map_destroy(&untyped));
 
 
 	array_reserve(&c->info.all_procedures, c->info.all_procedures_queue.count.load());
@@ -6720,6 +7272,68 @@ gb_internal void check_test_procedures(Checker *c) {
 
 gb_global std::atomic<isize> total_bodies_checked;
 
+gb_internal ProcCostInfo *proc_cost_info(Entity *e) {
+	ProcCostInfo *info = nullptr;
+	if (concurrent_map_get(&global_proc_costs, e, &info)) {
+		return info;
+	}
+	ProcCostInfo *new_info = permanent_alloc_item<ProcCostInfo>();
+	new_info->entity = e;
+	if (concurrent_map_set_if_not_previously_exists(&global_proc_costs, e, new_info)) {
+		concurrent_map_get(&global_proc_costs, e, &info);
+		return info;
+	}
+	return new_info;
+}
+
+gb_internal void proc_cost_add_instantiation(Entity *base_entity, Entity *e) {
+	ProcCostInfo *info = proc_cost_info(base_entity);
+	info->instantiations.fetch_add(1, std::memory_order_relaxed);
+	concurrent_map_set(&global_proc_costs, e, info);
+}
+
+gb_internal void print_proc_cost_report(isize top_count) {
+	auto infos = array_make<ProcCostInfo *>(heap_allocator(), 0, concurrent_map_count(&global_proc_costs));
+	defer (array_free(&infos));
+
+	for (auto &shard : global_proc_costs.shards) {
+		for (auto const &entry : shard.map) {
+			// NOTE: instantiations are reported through the procedure they were generated from
+			if (entry.value->entity == entry.key) {
+				array_add(&infos, entry.value);
+			}
+		}
+	}
+
+	gb_sort_array(infos.data, infos.count, [](void const *a, void const *b) -> int {
+		ProcCostInfo *x = *cast(ProcCostInfo *const *)a;
+		ProcCostInfo *y = *cast(ProcCostInfo *const *)b;
+		u64 cx = x->check_time.load(std::memory_order_relaxed) + x->pass_time.load(std::memory_order_relaxed);
+		u64 cy = y->check_time.load(std::memory_order_relaxed) + y->pass_time.load(std::memory_order_relaxed);
+		return cx < cy ? +1 : cx > cy ? -1 : 0;
+	});
+
+	f64 to_ms = 1000.0/cast(f64)time_stamp__freq();
+
+	gb_printf("Procedure compile cost (top %td of %td)\n", gb_min(top_count, infos.count), infos.count);
+	gb_printf("\t%10s %10s %10s %12s  %s\n", "check ms", "passes ms", "instances", "instructions", "procedure");
+	for (isize i = 0; i < gb_min(top_count, infos.count); i++) {
+		ProcCostInfo *info = infos[i];
+		Entity *e = info->entity;
+		TokenPos pos = e->token.pos;
+		gb_printf("\t%10.3f %10.3f %10td %12td  ",
+		          cast(f64)info->check_time.load(std::memory_order_relaxed) * to_ms,
+		          cast(f64)info->pass_time.load(std::memory_order_relaxed) * to_ms,
+		          info->instantiations.load(std::memory_order_relaxed),
+		          info->ir_instructions.load(std::memory_order_relaxed));
+		if (e->pkg != nullptr) {
+			gb_printf("%.*s.", LIT(e->pkg->name));
+		}
+		gb_printf("%.*s (%s)\n", LIT(e->token.string), token_pos_to_string(pos));
+	}
+	gb_printf("\n");
+}
+
 gb_internal bool consume_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped) {
 	GB_ASSERT(pi->decl != nullptr);
 	switch (pi->decl->proc_checked_state.load()) {
@@ -6740,7 +7354,7 @@ gb_internal bool consume_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap
 		}
 	}
 	if (untyped) {
-		map_clear(untyped);
+		untyped_expr_info_map_clear(untyped);
 	}
 	if (check_proc_info(c, pi, untyped)) {
 		total_bodies_checked.fetch_add(1, std::memory_order_relaxed);
@@ -6756,12 +7370,43 @@ struct CheckProcedureBodyWorkerData {
 
 gb_global CheckProcedureBodyWorkerData *check_procedure_bodies_worker_data;
 
+gb_global ProcInfo *const PROC_INFO_WAITING_CLOSED = cast(ProcInfo *)cast(uintptr)1;
+
+// NOTE: Rather than re-queueing a nested procedure until its parent's body has been checked (which
+// spins the workers whilst the parent is in progress), it is parked on the parent's `waiting_procs`
+// and queued by `proc_info_release_waiting` once the parent is done. Returns false if the parent is
+// already done, in which case the procedure can be checked straight away.
+gb_internal bool proc_info_wait_for_parent(DeclInfo *parent, ProcInfo *pi) {
+	ProcInfo *head = parent->waiting_procs.load(std::memory_order_acquire);
+	do {
+		if (head == PROC_INFO_WAITING_CLOSED) {
+			return false;
+		}
+		pi->next_waiting = head;
+	} while (!parent->waiting_procs.compare_exchange_weak(head, pi, std::memory_order_acq_rel));
+	return true;
+}
+
+gb_internal void proc_info_release_waiting(Checker *c, DeclInfo *decl) {
+	ProcInfo *pi = decl->waiting_procs.exchange(PROC_INFO_WAITING_CLOSED, std::memory_order_acq_rel);
+	if (pi == PROC_INFO_WAITING_CLOSED) {
+		return;
+	}
+	while (pi != nullptr) {
+		ProcInfo *next = pi->next_waiting;
+		pi->next_waiting = nullptr;
+		check_procedure_later(c, pi);
+		pi = next;
+	}
+}
+
 gb_internal WORKER_TASK_PROC(check_proc_info_worker_proc) {
 	auto *wd = &check_procedure_bodies_worker_data[current_thread_index()];
 	UntypedExprInfoMap *untyped = &wd->untyped;
 	Checker *c = wd->c;
 
 	ProcInfo *pi = cast(ProcInfo *)data;
+	TRACE_SCOPE("check_proc_info", pi->token.string);
 
 	GB_ASSERT(pi->decl != nullptr);
 	if (pi->decl->parent && pi->decl->parent->entity) {
@@ -6770,11 +7415,12 @@ gb_internal WORKER_TASK_PROC(check_proc_info_worker_proc) {
 		// This is prevent any possible race conditions in evaluation when multithreaded
 		// NOTE(bill): In single threaded mode, this should never happen
 		if (parent->kind == Entity_Procedure && (parent->flags & EntityFlag_ProcBodyChecked) == 0) {
-			thread_pool_add_task(check_proc_info_worker_proc, pi);
-			return 1;
+			if (proc_info_wait_for_parent(pi->decl->parent, pi)) {
+				return 1;
+			}
 		}
 	}
-	map_clear(untyped);
+	untyped_expr_info_map_clear(untyped);
 	if (check_proc_info(c, pi, untyped)) {
 		total_bodies_checked.fetch_add(1, std::memory_order_relaxed);
 		return 0;
@@ -6789,7 +7435,7 @@ gb_internal void check_init_worker_data(Checker *c) {
 
 	for (isize i = 0; i < thread_count; i++) {
 		check_procedure_bodies_worker_data[i].c = c;
-		map_init(&check_procedure_bodies_worker_data[i].untyped);
+		check_procedure_bodies_worker_data[i].untyped = {};
 	}
 }
 
@@ -6815,8 +7461,13 @@ gb_internal void check_procedure_bodies(Checker *c) {
 	global_procedure_body_in_worker_queue = true;
 
 	isize prev_procs_to_check_count = c->procs_to_check.count;
-	for_array(i, c->procs_to_check) {
-		thread_pool_add_task(check_proc_info_worker_proc, c->procs_to_check[i]);
+	{
+		TEMPORARY_ALLOCATOR_GUARD();
+		WorkerTask *tasks = gb_alloc_array(temporary_allocator(), WorkerTask, c->procs_to_check.count);
+		for_array(i, c->procs_to_check) {
+			tasks[i] = {check_proc_info_worker_proc, c->procs_to_check[i], nullptr};
+		}
+		thread_pool_add_tasks(&global_thread_pool, nullptr, tasks, c->procs_to_check.count);
 	}
 	GB_ASSERT(prev_procs_to_check_count == c->procs_to_check.count);
 	array_clear(&c->procs_to_check);
@@ -6829,14 +7480,26 @@ gb_internal void add_untyped_expressions(CheckerInfo *cinfo, UntypedExprInfoMap
 	if (untyped == nullptr) {
 		return;
 	}
-	for (auto const &entry : *untyped) {
-		Ast *expr = entry.key;
-		ExprInfo *info = entry.value;
-		if (expr != nullptr && info != nullptr) {
-			mpsc_enqueue(&cinfo->checker->global_untyped_queue, UntypedExprInfo{expr, info});
+	for (u32 i = 0; i < untyped->count; i++) {
+		UntypedExprInfo *entry = untyped_expr_info_map_entry(untyped, i);
+		if (entry->expr != nullptr) {
+			mpsc_enqueue(&cinfo->checker->global_untyped_queue, *entry);
+		}
+	}
+	untyped_expr_info_map_clear(untyped);
+}
+
+gb_internal void add_untyped_expressions(CheckerInfo *cinfo, ConcurrentPtrMap<Ast *, ExprInfo *> *untyped) {
+	for (auto &shard : untyped->shards) {
+		for (auto const &entry : shard.map) {
+			Ast *expr = entry.key;
+			ExprInfo *info = entry.value;
+			if (expr != nullptr && info != nullptr) {
+				mpsc_enqueue(&cinfo->checker->global_untyped_queue, UntypedExprInfo{expr, *info});
+			}
 		}
+		map_clear(&shard.map);
 	}
-	map_clear(untyped);
 }
 
 gb_internal Type *tuple_to_pointers(Type *ot) {
@@ -7590,14 +8253,32 @@ gb_internal WORKER_TASK_PROC(check_scope_usage_pkg_worker) {
 
 
 
+// NOTE: The scopes of the procedure bodies have already been vetted whilst checking them (see the end of
+// `check_proc_body`), so all that is left are the file and package scopes, whose entities can only be
+// known to be unused once every body has been checked. Such a scope can only produce a diagnostic when
+// one of its files has the matching vet flag enabled, so any other scope is not walked at all.
 gb_internal void check_all_scope_usages(Checker *c) {
 	for (auto const &entry : c->info.files) {
 		AstFile *f = entry.value;
-		thread_pool_add_task(check_scope_usage_file_worker, f);
+		u64 vet_flags = ast_file_vet_flags(f);
+		if ((vet_flags & (VetFlag_Unused|VetFlag_Shadowing|VetFlag_Using)) != 0) {
+			thread_pool_add_task(check_scope_usage_file_worker, f);
+		}
 	}
-	for (auto const &entry : c->info.packages) {
-		AstPackage *pkg = entry.value;
-		thread_pool_add_task(check_scope_usage_pkg_worker, pkg);
+	if (global_check_file == nullptr) {
+		for (auto const &entry : c->info.packages) {
+			AstPackage *pkg = entry.value;
+			if (pkg->kind == Package_Runtime) {
+				continue;
+			}
+			// NOTE: Only unused procedures can be reported for the entities of a package scope
+			for (AstFile *f : pkg->files) {
+				if ((ast_file_vet_flags(f) & VetFlag_UnusedProcedures) != 0) {
+					thread_pool_add_task(check_scope_usage_pkg_worker, pkg);
+					break;
+				}
+			}
+		}
 	}
 
 	thread_pool_wait();
@@ -7630,7 +8311,7 @@ gb_internal void check_for_inline_cycles(Checker *c) {
 		DeclInfo *decl = e->decl_info;
 		ast_node(pl, ProcLit, decl->proc_lit);
 		if (pl->inlining == ProcInlining_inline) {
-			FOR_PTR_SET(dep, decl->deps) {
+			for (Entity *dep : decl->deps) {
 				if (dep == e) {
 					error(e->token, "Cannot inline recursive procedure '%.*s'", LIT(e->token.string));
 					break;
@@ -7664,6 +8345,20 @@ gb_internal void check_parsed_files(Checker *c) {
 		}
 	}
 
+	if (build_context.check_file.len != 0) {
+		for (AstPackage *pkg : c->parser->packages) {
+			for (AstFile *f : pkg->files) {
+				if (f->fullpath == build_context.check_file) {
+					global_check_file = f;
+				}
+			}
+		}
+		if (global_check_file == nullptr) {
+			error({}, "-check-file:%.*s is not a file of any of the checked packages", LIT(build_context.check_file));
+			return;
+		}
+	}
+
 	TIME_SECTION("init worker data");
 	check_init_worker_data(c);
 
@@ -7772,6 +8467,8 @@ gb_internal void check_parsed_files(Checker *c) {
 	check_merge_queues_into_arrays(c);
 	thread_pool_wait();
 
+	merge_min_dep_type_info_sets(c);
+
 	TIME_SECTION("check entry point");
 	if (build_context.build_mode == BuildMode_Executable && !build_context.no_entry_point && build_context.command_kind != Command_test) {
 		Scope *s = c->info.init_scope;
@@ -7785,8 +8482,8 @@ gb_internal void check_parsed_files(Checker *c) {
 			token.pos.column  = 1;
 			if (s->pkg->files.count > 0) {
 				AstFile *f = s->pkg->files[0];
-				if (f->tokens.count > 0) {
-					token = f->tokens[0];
+				if (f->token_count > 0) {
+					token = f->first_token;
 				}
 			}
 
@@ -7827,11 +8524,11 @@ gb_internal void check_parsed_files(Checker *c) {
 
 	TIME_SECTION("add untyped expression values");
 	for (UntypedExprInfo u = {}; mpsc_dequeue(&c->global_untyped_queue, &u); /**/) {
-		GB_ASSERT(u.expr != nullptr && u.info != nullptr);
-		if (is_type_typed(u.info->type)) {
-			compiler_error("%s (type %s) is typed!", expr_to_string(u.expr), type_to_string(u.info->type));
+		GB_ASSERT(u.expr != nullptr);
+		if (is_type_typed(u.info.type)) {
+			compiler_error("%s (type %s) is typed!", expr_to_string(u.expr), type_to_string(u.info.type));
 		}
-		add_type_and_value(&c->builtin_ctx, u.expr, u.info->mode, u.info->type, u.info->value);
+		add_type_and_value(&c->builtin_ctx, u.expr, u.info.mode, u.info.type, u.info.value);
 	}
 
 	TIME_SECTION("initialize and check for collisions in type info array");
@@ -7844,7 +8541,7 @@ gb_internal void check_parsed_files(Checker *c) {
 		for (auto const &tt : c->info.min_dep_type_info_set) {
 			array_add(&type_info_types, tt);
 		}
-		array_sort(type_info_types, type_info_pair_cmp);
+		array_sort_parallel(type_info_types, type_info_pair_cmp);
 
 		array_init(&c->info.type_info_types_hash_map, heap_allocator(), type_info_types.count*2 + 1);
 		map_reserve(&c->info.min_dep_type_info_index_map, type_info_types.count);
@@ -7909,5 +8606,8 @@ gb_internal void check_parsed_files(Checker *c) {
 	}
 
 
+	TIME_SECTION("compute type layouts");
+	check_compute_type_layouts(c);
+
 	TIME_SECTION("type check finish");
 }
@@ -133,6 +133,7 @@ struct AttributeContext {
 	bool    has_disabled_proc     : 1;
 	bool    disabled_proc         : 1;
 	bool    test                  : 1;
+	bool    benchmark             : 1;
 	bool    init                  : 1;
 	bool    fini                  : 1;
 	bool    set_cold              : 1;
@@ -144,7 +145,9 @@ struct AttributeContext {
 	bool    no_sanitize_thread    : 1;
 	bool    rodata                : 1;
 	bool    ignore_duplicates     : 1;
+	bool    has_max_stack_usage   : 1;
 	u32 optimization_mode; // ProcedureOptimizationMode
+	i64 max_stack_usage;   // in bytes, see `has_max_stack_usage`
 	i64 foreign_import_priority_index;
 	String extra_linker_flags;
 	InstrumentationFlag no_instrumentation;
@@ -162,6 +165,7 @@ struct AttributeContext {
 
 	String require_target_feature; // required by the target micro-architecture
 	String enable_target_feature;  // will be enabled for the procedure only
+	String target_clones;          // compiled once per target, selected at run time
 
 	u64 fast_math_flags;
 
@@ -197,11 +201,64 @@ char const *ProcCheckedState_strings[ProcCheckedState_COUNT] {
 	"Checked",
 };
 
+// NOTE: The verdict of a declaration's `where` clauses, which only depend on its (specialized) parameters
+enum WhereClauseState : u8 {
+	WhereClauseState_Unknown,
+	WhereClauseState_Passed,
+	WhereClauseState_Failed,
+};
+
 struct VariadicReuseData {
 	Type *slice_type; // ..elem_type
 	i64 max_count;
 };
 
+enum {ENTITY_SET_INLINE_CAP = 4};
+
+// NOTE: A set of entities stored by their dense ids (see `entity_from_id`) rather than by pointer, which
+// halves the size of each slot, and most declarations only depend upon a few entities so the inline
+// buffer is kept small too
+struct EntitySet {
+	u32 *keys;
+	u32  count;
+	u32  capacity;
+	u32  inline_keys[ENTITY_SET_INLINE_CAP];
+};
+
+gb_internal Entity *entity_from_id(u32 id);
+
+struct EntitySetIterator {
+	EntitySet *set;
+	u32 index;
+
+	EntitySetIterator &operator++() noexcept {
+		for (;;) {
+			++index;
+			if (set->capacity == index || set->keys[index] != 0) {
+				return *this;
+			}
+		}
+	}
+
+	bool operator==(EntitySetIterator const &other) const noexcept {
+		return this->set == other.set && this->index == other.index;
+	}
+	bool operator!=(EntitySetIterator const &other) const noexcept {
+		return !(*this == other);
+	}
+
+	Entity *operator*() const {
+		return entity_from_id(set->keys[index]);
+	}
+};
+
+gb_internal bool entity_set_update(EntitySet *s, Entity *e); // returns true if it previously existed
+gb_internal void entity_set_add   (EntitySet *s, Entity *e);
+
+gb_internal EntitySetIterator begin(EntitySet &set) noexcept;
+gb_internal EntitySetIterator end(EntitySet &set) noexcept;
+
+
 // DeclInfo is used to store information of certain declarations to allow for "any order" usage
 struct DeclInfo {
 	DeclInfo *    parent; // NOTE(bill): only used for procedure literals at the moment
@@ -226,23 +283,24 @@ struct DeclInfo {
 	bool                          is_using;
 	bool                          foreign_require_results;
 	std::atomic<bool>             where_clauses_evaluated;
+	std::atomic<WhereClauseState> where_clauses_state;
 	std::atomic<ProcCheckedState> proc_checked_state;
 
 	BlockingMutex     proc_checked_mutex;
+	// NOTE: Nested procedures which are waiting on this body to be checked, see `proc_info_wait_for_parent`
+	std::atomic<struct ProcInfo *> waiting_procs;
 	isize             defer_used;
 	std::atomic<bool> defer_use_checked;
 
 	CommentGroup *comment;
 	CommentGroup *docs;
 
-	RwMutex          deps_mutex;
-	PtrSet<Entity *> deps;
+	RwMutex   deps_mutex;
+	EntitySet deps;
 
 	RwMutex type_info_deps_mutex;
 	TypeSet type_info_deps;
 
-	BlockingMutex type_and_value_mutex;
-
 	Array<BlockLabel> labels;
 
 	i32 scope_index;
@@ -265,25 +323,51 @@ struct ProcInfo {
 	u64       tags;
 	bool      generated_from_polymorphic;
 	Ast *     poly_def_node;
+	ProcInfo *next_waiting; // DeclInfo.waiting_procs
 };
 
 
 enum { DEFAULT_SCOPE_CAPACITY = 32 };
 
 
+// NOTE: The entity is stored by its dense id (see `entity_from_id`) so that a slot is 8 bytes rather than
+// 16, which fits twice as many slots of a probed group in a cache line
 struct ScopeMapSlot {
-	u32     hash;
-	u32     _pad;
-	Entity *value;
+	u32 hash;
+	u32 entity_id; // 0 once cleared
+
+	gb_inline Entity *value() const {
+		return this->entity_id ? entity_from_id(this->entity_id) : nullptr;
+	}
 };
 
+gb_internal u32 scope_map_slot_id(Entity *e);
+
 enum { SCOPE_MAP_INLINE_CAP = 16 };
 
+// NOTE: The map is an open addressing table probed a group of 16 slots at a time. Each slot has a
+// control byte which is either SCOPE_MAP_CTRL_EMPTY or a 7-bit tag of the hash, so a whole group is
+// compared with one SIMD comparison and the keys are only touched on a tag match.
+// The control bytes are followed by a copy of the first group so a group can be loaded at any slot.
+// As entries are never removed (only cleared), a key is always before the first group with an empty slot.
+enum { SCOPE_MAP_GROUP_WIDTH = 16 };
+enum : u8 { SCOPE_MAP_CTRL_EMPTY = 0x80 };
+
+#if defined(GB_CPU_X86)
+	#include <emmintrin.h>
+	#define SCOPE_MAP_SIMD_SSE2 1
+#elif defined(GB_CPU_ARM) && defined(GB_ARCH_64_BIT) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define SCOPE_MAP_SIMD_NEON 1
+#endif
+
 struct ScopeMap {
 	InternedString  inline_keys [SCOPE_MAP_INLINE_CAP];
 	ScopeMapSlot    inline_slots[SCOPE_MAP_INLINE_CAP];
+	u8              inline_ctrl [SCOPE_MAP_INLINE_CAP + SCOPE_MAP_GROUP_WIDTH];
 	InternedString *keys;
 	ScopeMapSlot *  slots;
+	u8 *            ctrl; // cap + SCOPE_MAP_GROUP_WIDTH
 	u32             count;
 	u32             cap;
 };
@@ -292,94 +376,118 @@ gb_internal gb_inline u32 scope_map_max_load(u32 cap) {
 	return cap - (cap>>2); // 75%
 }
 
+// NOTE: String hashes are 31-bit so the tag is taken from bits 24..30
+gb_internal gb_inline u8 scope_map__tag(u32 hash) {
+	return cast(u8)((hash >> 24) & 0x7f);
+}
+
+// NOTE: Returns a mask with one bit set per matching slot of the group, see 'scope_map__mask_index'
+gb_internal gb_inline u64 scope_map__group_match(u8 const *group, u8 ctrl) {
+#if defined(SCOPE_MAP_SIMD_SSE2)
+	__m128i g = _mm_loadu_si128(cast(__m128i const *)group);
+	return cast(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(cast(char)ctrl)));
+#elif defined(SCOPE_MAP_SIMD_NEON)
+	uint8x16_t eq = vceqq_u8(vld1q_u8(group), vdupq_n_u8(ctrl));
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+#else
+	u64 mask = 0;
+	for (u32 i = 0; i < SCOPE_MAP_GROUP_WIDTH; i++) {
+		mask |= cast(u64)(group[i] == ctrl) << i;
+	}
+	return mask;
+#endif
+}
+
+gb_internal gb_inline u32 scope_map__mask_index(u64 mask) {
+#if defined(SCOPE_MAP_SIMD_NEON)
+	return count_trailing_zeros(mask) >> 2;
+#else
+	return count_trailing_zeros(mask);
+#endif
+}
+
+gb_internal gb_inline void scope_map__set_ctrl(u8 *ctrl, u32 cap, u32 pos, u8 value) {
+	ctrl[pos] = value;
+	if (pos < SCOPE_MAP_GROUP_WIDTH) {
+		ctrl[cap + pos] = value;
+	}
+}
+
 gb_internal gb_inline void scope_map_init(ScopeMap *m) {
 	m->cap = SCOPE_MAP_INLINE_CAP;
 	m->slots = m->inline_slots;
 	m->keys = m->inline_keys;
+	m->ctrl = m->inline_ctrl;
+	gb_memset(m->inline_ctrl, SCOPE_MAP_CTRL_EMPTY, gb_size_of(m->inline_ctrl));
 }
 
 
-gb_internal Entity *scope_map_insert_for_rehash(
-	InternedString *keys, ScopeMapSlot *slots, u32 mask,
+gb_internal void scope_map_insert_for_rehash(
+	InternedString *keys, ScopeMapSlot *slots, u8 *ctrl, u32 cap,
 	InternedString key, u32 hash, Entity *value) {
+	u32 mask = cap-1;
 	u32 pos = hash & mask;
-	u32 dist = 0;
 
 	for (;;) {
-		ScopeMapSlot *s = &slots[pos];
-
-		if (s->hash == 0) {
-			keys[pos] = key;
-			s->hash   = hash;
-			s->value  = value;
-			return nullptr;
-		}
-
-		u32 existing_dist = (pos - s->hash) & mask;
-
-		if (dist > existing_dist) {
-			auto    tmp_key   = keys[pos];
-			u32     tmp_hash  = s->hash;
-			Entity *tmp_value = s->value;
-
-			keys[pos] = key;
-			s->hash   = hash;
-			s->value  = value;
-
-			hash  = tmp_hash;
-			value = tmp_value;
-			key   = tmp_key;
-			dist  = existing_dist;
+		u64 empty = scope_map__group_match(ctrl + pos, SCOPE_MAP_CTRL_EMPTY);
+		if (empty != 0) {
+			u32 index = (pos + scope_map__mask_index(empty)) & mask;
+			keys[index] = key;
+			slots[index].hash      = hash;
+			slots[index].entity_id = scope_map_slot_id(value);
+			scope_map__set_ctrl(ctrl, cap, index, scope_map__tag(hash));
+			return;
 		}
-
-		dist += 1;
-		pos = (pos+1) & mask;
+		pos = (pos + SCOPE_MAP_GROUP_WIDTH) & mask;
 	}
 }
 
-gb_internal gb_inline void scope_map_allocate_entries(u32 cap, InternedString **keys, ScopeMapSlot **slots) {
+gb_internal gb_inline void scope_map_allocate_entries(u32 cap, InternedString **keys, ScopeMapSlot **slots, u8 **ctrl) {
 	Arena *arena = get_arena(ThreadArena_Permanent);
-	isize size = (gb_size_of(InternedString) + gb_size_of(ScopeMapSlot)) * cap;
+	isize size = (gb_size_of(InternedString) + gb_size_of(ScopeMapSlot)) * cap + (cap + SCOPE_MAP_GROUP_WIDTH);
 	u8 *data = cast(u8 *)arena_alloc(arena, size, 8);
+	memory_account(MemorySubsystem_Scopes, size);
 
 	*keys  = cast(InternedString *)data;
 	*slots = cast(ScopeMapSlot *)(*keys + cap);
-
-	// *keys  = permanent_alloc_array<String>(cap);
-	// *slots = permanent_alloc_array<ScopeMapSlot>(cap);
+	*ctrl  = cast(u8 *)(*slots + cap);
+	gb_memset(*ctrl, SCOPE_MAP_CTRL_EMPTY, cap + SCOPE_MAP_GROUP_WIDTH);
 }
 
 
-gb_internal void scope_map_grow(ScopeMap *m) {
-	u32 new_cap = m->cap << 1;
-	u32 new_mask = new_cap - 1;
-
+gb_internal void scope_map_rehash(ScopeMap *m, u32 new_cap) {
 	InternedString *new_keys;
 	ScopeMapSlot *  new_slots;
-	scope_map_allocate_entries(new_cap, &new_keys, &new_slots);
+	u8 *            new_ctrl;
+	scope_map_allocate_entries(new_cap, &new_keys, &new_slots, &new_ctrl);
 
 	if (m->count > 0) {
 		for (u32 i = 0; i < m->cap; i++) {
 			if (m->slots[i].hash) {
-				scope_map_insert_for_rehash(new_keys, new_slots, new_mask,
-				                            m->keys[i], m->slots[i].hash, m->slots[i].value);
+				scope_map_insert_for_rehash(new_keys, new_slots, new_ctrl, new_cap,
+				                            m->keys[i], m->slots[i].hash, m->slots[i].value());
 			}
 		}
 	}
 
 	m->slots = new_slots;
 	m->keys  = new_keys;
+	m->ctrl  = new_ctrl;
 	m->cap   = new_cap;
 }
 
+gb_internal void scope_map_grow(ScopeMap *m) {
+	scope_map_rehash(m, m->cap << 1);
+}
+
 gb_internal void scope_map_reserve(ScopeMap *m, isize capacity) {
 	if (m->slots == nullptr) {
 		scope_map_init(m);
 	}
 	u32 new_cap = next_pow2_u32(cast(u32)capacity);
 	if (m->cap < new_cap && new_cap > SCOPE_MAP_INLINE_CAP) {
-		scope_map_allocate_entries(new_cap, &m->keys, &m->slots);
-		m->cap   = new_cap;
+		scope_map_rehash(m, new_cap);
 	}
 }
 
@@ -395,73 +503,58 @@ gb_internal Entity *scope_map_insert(ScopeMap *m, InternedString key, u32 hash,
 
 	u32 mask = m->cap-1;
 	u32 pos = hash & mask;
-	u32 dist = 0;
+	u8  tag = scope_map__tag(hash);
 
 	for (;;) {
-		ScopeMapSlot *s = &m->slots[pos];
+		u8 const *group = m->ctrl + pos;
+		for (u64 match = scope_map__group_match(group, tag); match != 0; match &= match-1) {
+			u32 index = (pos + scope_map__mask_index(match)) & mask;
+			if (m->slots[index].hash == hash && m->keys[index] == key) {
+				Entity *old = m->slots[index].value();
+				m->slots[index].entity_id = scope_map_slot_id(value);
+				return old;
+			}
+		}
 
-		if (s->hash == 0) {
-			m->keys[pos] = key;
-			s->hash  = hash;
-			s->value = value;
+		u64 empty = scope_map__group_match(group, SCOPE_MAP_CTRL_EMPTY);
+		if (empty != 0) {
+			u32 index = (pos + scope_map__mask_index(empty)) & mask;
+			m->keys[index] = key;
+			m->slots[index].hash      = hash;
+			m->slots[index].entity_id = scope_map_slot_id(value);
+			scope_map__set_ctrl(m->ctrl, m->cap, index, tag);
 			m->count += 1;
 			return nullptr;
 		}
 
-		if (s->hash == hash && m->keys[pos] == key) {
-			Entity *old = s->value;
-			s->value = value;
-			return old;
-		}
-
-		u32 existing_dist = (pos - s->hash) & mask;
-
-		if (dist > existing_dist) {
-			auto    tmp_key   = m->keys[pos];
-			u32     tmp_hash  = s->hash;
-			Entity *tmp_value = s->value;
-
-			m->keys[pos] = key;
-			s->hash      = hash;
-			s->value     = value;
-
-			key   = tmp_key;
-			hash  = tmp_hash;
-			value = tmp_value;
-			dist  = existing_dist;
-		}
-
-		dist += 1;
-		pos = (pos+1) & mask;
+		pos = (pos + SCOPE_MAP_GROUP_WIDTH) & mask;
 	}
 }
 
 gb_internal Entity *scope_map_get(ScopeMap *m, InternedString key, u32 hash) {
 	u32 mask = m->cap-1;
 	u32 pos = hash & mask;
-	u32 dist = 0;
-	for (;;) {
-		ScopeMapSlot *s = &m->slots[pos];
-		u32 curr_hash = s->hash;
-		if (curr_hash == 0) {
-			return nullptr;
+	u8  tag = scope_map__tag(hash);
+
+	for (u32 probed = 0; probed < m->cap; probed += SCOPE_MAP_GROUP_WIDTH) {
+		u8 const *group = m->ctrl + pos;
+		for (u64 match = scope_map__group_match(group, tag); match != 0; match &= match-1) {
+			u32 index = (pos + scope_map__mask_index(match)) & mask;
+			if (m->slots[index].hash == hash && m->keys[index] == key) {
+				return m->slots[index].value();
+			}
 		}
-
-		u32 existing_dist = (pos - curr_hash) & mask;
-		if (dist > existing_dist) {
+		if (scope_map__group_match(group, SCOPE_MAP_CTRL_EMPTY) != 0) {
 			return nullptr;
 		}
-		if (curr_hash == hash && m->keys[pos] == key) {
-			return s->value;
-		}
-
-		dist += 1;
-		pos = (pos + 1) & mask;
+		pos = (pos + SCOPE_MAP_GROUP_WIDTH) & mask;
 	}
+	return nullptr;
 }
 
 gb_internal void scope_map_clear(ScopeMap *m) {
 	gb_memset(m->slots, 0, gb_size_of(*m->slots) * m->cap);
+	gb_memset(m->ctrl, SCOPE_MAP_CTRL_EMPTY, m->cap + SCOPE_MAP_GROUP_WIDTH);
 	m->count = 0;
 }
 
@@ -622,11 +715,27 @@ struct AtomOpMapEntry {
 struct CheckerContext;
 
 struct UntypedExprInfo {
-	Ast *expr;
-	ExprInfo *info;
+	Ast *    expr;
+	ExprInfo info;
+};
+
+// NOTE: The untyped expressions of the procedure (or declarations) which is being checked are stored
+// in a side array rather than in a hash map. Each node caches its index into the array in
+// `Ast::untyped_index`, which is validated against the entry's `expr`, so a lookup does no hashing.
+// The index is owned by the first map to claim it, a node which is also being checked by another
+// worker at the same time has its index kept in `shared` instead.
+// The entries are bump allocated in fixed size blocks and never move, so an `ExprInfo *` stays valid
+// until the array is cleared, and the blocks are reused for the next procedure.
+enum : u32 {
+	UNTYPED_EXPR_INFO_BLOCK_SHIFT = 10,
+	UNTYPED_EXPR_INFO_BLOCK_SIZE  = 1u<<UNTYPED_EXPR_INFO_BLOCK_SHIFT,
 };
 
-typedef PtrMap<Ast *, ExprInfo *> UntypedExprInfoMap; 
+struct UntypedExprInfoMap {
+	Array<UntypedExprInfo *> blocks;
+	u32                      count;
+	PtrMap<Ast *, u32>       shared;
+};
 
 enum ObjcMsgKind : u32 {
 	ObjcMsg_normal,
@@ -650,6 +759,10 @@ enum LoadFileTier {
 	LoadFileTier_Contents,
 };
 
+// NOTE: Files at least this large are memory mapped rather than copied by `#load`, and the
+// backend embeds them with the assembler's `.incbin` rather than as an LLVM constant
+#define LOAD_FILE_LARGE_SIZE (1ll<<20)
+
 struct LoadFileCache {
 	LoadFileTier   tier;
 	bool           exists;
@@ -672,16 +785,42 @@ struct LoadDirectoryCache {
 };
 
 
+// NOTE: The argument types (and constant values) which a call resolved to a specialization with,
+// see `find_generated_polymorphic_procedure_from_operands`
+struct GenProcResolution {
+	Slice<Operand> operands;
+	Entity *       entity;
+};
+
 struct GenProcsData {
-	Array<Entity *> procs;
-	RwMutex         mutex;
+	Array<Entity *>          procs;
+	PtrMap<u64, Entity *>    procs_by_hash; // multi-map keyed by `type_hash_canonical_proc_params`
+	PtrMap<u64, GenProcResolution *> resolutions; // multi-map keyed by `polymorphic_proc_operands_hash`
+	RwMutex                  mutex;
 };
 
 struct GenTypesData {
 	Array<Entity *> types;
 	RecursiveMutex  mutex;
+
+	// NOTE: Fully checked instantiations keyed by `polymorphic_record_entity_hash`.
+	// These can be looked up without taking `mutex`, which is held while generating a new one
+	PtrMap<u64, Entity *> complete_types; // multi-map
+	RwMutex               complete_types_mutex;
+};
+
+// NOTE: Only recorded with -internal-proc-cost-report
+// Instantiations of a polymorphic procedure share the ProcCostInfo of the procedure they were generated from
+struct ProcCostInfo {
+	Entity *           entity;
+	std::atomic<isize> instantiations;
+	std::atomic<u64>   check_time;
+	std::atomic<isize> ir_instructions;
+	std::atomic<u64>   pass_time;
 };
 
+gb_global ConcurrentPtrMap<Entity *, ProcCostInfo *> global_proc_costs;
+
 struct Defineable {
 	String        name;
 	ExactValue    default_value;
@@ -693,12 +832,25 @@ struct Defineable {
 	String pos_str;
 };
 
+// NOTE: sizes are measured in checked AST nodes, nested '#unroll for' bodies count in their expanded form
+struct UnrollReport {
+	Ast *node;
+	i64  iterations;
+	i64  body_nodes;
+	i64  expanded_nodes;
+};
+
 struct RaddbgTypeView {
 	Type * type;
 	String view;
 };
 
 // CheckerInfo stores all the symbol information for a type-checked program
+struct EntityUse {
+	Ast *   identifier;
+	Entity *entity;
+};
+
 struct CheckerInfo {
 	Checker *checker;
 
@@ -715,8 +867,8 @@ struct CheckerInfo {
 	RwMutex minimum_dependency_type_info_mutex;
 	PtrMap</*type info hash*/u64, /*min dep index*/isize> min_dep_type_info_index_map;
 
-	RWSpinLock	    min_dep_type_info_set_mutex;
 	TypeSet             min_dep_type_info_set;
+	TypeSet             min_dep_type_info_root_set; // -rtti:minimal, types which keep their full member information
 	Array<TypeInfoPair> type_info_types_hash_map; // 2 * type_info_types.count
 
 
@@ -731,14 +883,17 @@ struct CheckerInfo {
 	BlockingMutex     defineables_mutex;
 	Array<Defineable> defineables;
 
+	BlockingMutex       unroll_reports_mutex;
+	Array<UnrollReport> unroll_reports;
+
 
 	// Below are accessed within procedures
-	RwMutex            global_untyped_mutex;
-	UntypedExprInfoMap global_untyped; // NOTE(bill): This needs to be a map and not on the Ast
-	                                   // as it needs to be iterated across afterwards
+	ConcurrentPtrMap<Ast *, ExprInfo *> global_untyped; // NOTE(bill): This needs to be a map and not on the Ast
+	                                                    // as it needs to be iterated across afterwards
 	BlockingMutex builtin_mutex;
 
-	BlockingMutex type_and_value_mutex;
+	BlockingMutex   when_cond_mutex;
+	StringMap<bool> when_cond_cache; // see `check_file_when_stmt_cond`
 
 	RecursiveMutex lazy_mutex; // Mutex required for lazy type checking of specific files
 
@@ -763,6 +918,8 @@ struct CheckerInfo {
 
 	MPSCQueue<Ast *> intrinsics_entry_point_usage;
 
+	MPSCQueue<EntityUse> entity_uses_queue; // NOTE: only filled for `-export-symbol-index`
+
 	BlockingMutex objc_objc_msgSend_mutex;
 	PtrMap<Ast *, ObjcMsgData> objc_msgSend_types;
 
@@ -784,6 +941,8 @@ struct CheckerInfo {
 	Entity *instrumentation_enter_entity;
 	Entity *instrumentation_exit_entity;
 
+	std::atomic<bool> has_max_stack_usage; // some procedure has @(max_stack_usage), see `lb_gathers_stack_usage`
+
 
 	BlockingMutex                       load_directory_mutex;
 	StringMap<LoadDirectoryCache *>     load_directory_cache;
@@ -823,6 +982,7 @@ struct CheckerContext {
 
 #define MAX_INLINE_FOR_DEPTH 1024ll
 	i64 inline_for_depth;
+	i64 *unroll_node_count; // checked nodes within the innermost '#unroll for' body
 
 	u32        stmt_flags;
 	bool       in_enum_type;
@@ -928,3 +1088,6 @@ gb_internal GenTypesData *ensure_polymorphic_record_entity_has_gen_types(Checker
 
 
 gb_internal void init_map_internal_types(Type *type);
+
+gb_internal ProcCostInfo *proc_cost_info(Entity *e);
+gb_internal void          proc_cost_add_instantiation(Entity *base_entity, Entity *e);
@@ -169,6 +169,90 @@ gb_internal u64 fnv64a(void const *data, isize len, u64 seed=0xcbf29ce484222325u
 	return h;
 }
 
+// NOTE: XXH64, used for hashing file contents and strings where fnv64a is too slow
+enum : u64 {
+	XXH64_PRIME_1 = 0x9e3779b185ebca87ull,
+	XXH64_PRIME_2 = 0xc2b2ae3d27d4eb4full,
+	XXH64_PRIME_3 = 0x165667b19e3779f9ull,
+	XXH64_PRIME_4 = 0x85ebca77c2b2ae63ull,
+	XXH64_PRIME_5 = 0x27d4eb2f165667c5ull,
+};
+
+gb_internal gb_inline u64 xxh64__rotl(u64 x, u32 r) {
+	return (x << r) | (x >> (64 - r));
+}
+gb_internal gb_inline u64 xxh64__read_u64(u8 const *p) {
+	u64 x;
+	memcpy(&x, p, 8);
+	return x;
+}
+gb_internal gb_inline u32 xxh64__read_u32(u8 const *p) {
+	u32 x;
+	memcpy(&x, p, 4);
+	return x;
+}
+gb_internal gb_inline u64 xxh64__round(u64 acc, u64 input) {
+	acc += input * XXH64_PRIME_2;
+	acc  = xxh64__rotl(acc, 31);
+	acc *= XXH64_PRIME_1;
+	return acc;
+}
+gb_internal gb_inline u64 xxh64__merge_round(u64 acc, u64 val) {
+	acc ^= xxh64__round(0, val);
+	return acc*XXH64_PRIME_1 + XXH64_PRIME_4;
+}
+
+gb_internal u64 xxh64(void const *data, isize len, u64 seed=0) {
+	u8 const *p   = cast(u8 const *)data;
+	u8 const *end = p + len;
+	u64 h = 0;
+
+	if (len >= 32) {
+		u8 const *limit = end - 32;
+		u64 v1 = seed + XXH64_PRIME_1 + XXH64_PRIME_2;
+		u64 v2 = seed + XXH64_PRIME_2;
+		u64 v3 = seed;
+		u64 v4 = seed - XXH64_PRIME_1;
+		do {
+			v1 = xxh64__round(v1, xxh64__read_u64(p)); p += 8;
+			v2 = xxh64__round(v2, xxh64__read_u64(p)); p += 8;
+			v3 = xxh64__round(v3, xxh64__read_u64(p)); p += 8;
+			v4 = xxh64__round(v4, xxh64__read_u64(p)); p += 8;
+		} while (p <= limit);
+
+		h = xxh64__rotl(v1, 1) + xxh64__rotl(v2, 7) + xxh64__rotl(v3, 12) + xxh64__rotl(v4, 18);
+		h = xxh64__merge_round(h, v1);
+		h = xxh64__merge_round(h, v2);
+		h = xxh64__merge_round(h, v3);
+		h = xxh64__merge_round(h, v4);
+	} else {
+		h = seed + XXH64_PRIME_5;
+	}
+
+	h += cast(u64)len;
+
+	for (; p+8 <= end; p += 8) {
+		h ^= xxh64__round(0, xxh64__read_u64(p));
+		h  = xxh64__rotl(h, 27)*XXH64_PRIME_1 + XXH64_PRIME_4;
+	}
+	if (p+4 <= end) {
+		h ^= cast(u64)xxh64__read_u32(p) * XXH64_PRIME_1;
+		h  = xxh64__rotl(h, 23)*XXH64_PRIME_2 + XXH64_PRIME_3;
+		p += 4;
+	}
+	for (; p < end; p++) {
+		h ^= cast(u64)(*p) * XXH64_PRIME_5;
+		h  = xxh64__rotl(h, 11)*XXH64_PRIME_1;
+	}
+
+	h ^= h >> 33;
+	h *= XXH64_PRIME_2;
+	h ^= h >> 29;
+	h *= XXH64_PRIME_3;
+	h ^= h >> 32;
+	return h;
+}
+
 gb_internal u64 u64_digit_value(Rune r) {
 	switch (r) {
 	case '0': return 0;
@@ -369,6 +453,7 @@ gb_global bool global_module_path_set = false;
 #include "priority_queue.cpp"
 #include "thread_pool.cpp"
 #include "string_interner.cpp"
+#include "output_buffer.cpp"
 
 
 gb_internal String obfuscate_string(String const &s, char const *prefix) {
@@ -484,6 +569,30 @@ gb_internal u64 floor_log2(u64 x) {
 	return cast(u64)(bit_set_count(x) - 1);
 }
 
+// NOTE: 'x' must not be zero
+gb_internal gb_inline u32 count_trailing_zeros(u32 x) {
+#if defined(GB_COMPILER_MSVC)
+	unsigned long index = 0;
+	_BitScanForward(&index, x);
+	return cast(u32)index;
+#else
+	return cast(u32)__builtin_ctz(x);
+#endif
+}
+
+gb_internal gb_inline u32 count_trailing_zeros(u64 x) {
+#if defined(GB_COMPILER_MSVC) && defined(GB_ARCH_64_BIT)
+	unsigned long index = 0;
+	_BitScanForward64(&index, x);
+	return cast(u32)index;
+#elif defined(GB_COMPILER_MSVC)
+	u32 lo = cast(u32)x;
+	return lo ? count_trailing_zeros(lo) : 32 + count_trailing_zeros(cast(u32)(x >> 32));
+#else
+	return cast(u32)__builtin_ctzll(x);
+#endif
+}
+
 
 gb_internal u32 ceil_log2(u32 x) {
 	i32 y = cast(i32)(x & (x-1));
@@ -793,6 +902,53 @@ gb_internal LoadedFileError load_file_32(char const *fullpath, LoadedFile *memor
 			}
 			return err;
 		}
+	#else
+		int fd = open(fullpath, O_RDONLY);
+		if (fd < 0) {
+			switch (errno) {
+			case ENOENT:
+			case ENOTDIR:
+				return LoadedFile_NotExists;
+			case EACCES:
+			case EPERM:
+				return LoadedFile_Permission;
+			}
+			return LoadedFile_Invalid;
+		}
+
+		struct stat st = {};
+		if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+			i64 file_size = cast(i64)st.st_size;
+			if (file_size > I32_MAX) {
+				close(fd);
+				return LoadedFile_FileTooLarge;
+			}
+			if (file_size == 0) {
+				close(fd);
+				memory_mapped_file->handle = nullptr;
+				memory_mapped_file->data   = nullptr;
+				memory_mapped_file->size   = 0;
+				return LoadedFile_Empty;
+			}
+
+			// NOTE: The bytes past the end of the file within the last mapped page are guaranteed
+			// to be zero, which acts as the NUL terminator. If the file size is an exact multiple of
+			// the page size there is no such guard, so fall back to copying the contents.
+			if ((file_size % DEFAULT_PAGE_SIZE) != 0) {
+				void *file_data = mmap(nullptr, cast(size_t)file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				close(fd);
+				if (file_data != MAP_FAILED) {
+					memory_mapped_file->handle = file_data;
+					memory_mapped_file->data   = file_data;
+					memory_mapped_file->size   = cast(i32)file_size;
+					return LoadedFile_None;
+				}
+			} else {
+				close(fd);
+			}
+		} else {
+			close(fd);
+		}
 	#endif
 	}
 	
@@ -900,17 +1056,84 @@ gb_internal DidYouMeanAnswers did_you_mean_make(gbAllocator allocator, isize cap
 gb_internal void did_you_mean_destroy(DidYouMeanAnswers *d) {
 	array_free(&d->distances);
 }
+// NOTE: Only the distances up to `max_distance` matter for a suggestion, so this keeps just the last
+// three rows and stops as soon as two consecutive rows are beyond it (a transposition reaches back
+// two rows), returning `max_distance+1`
+gb_internal isize levenstein_distance_case_insensitive_bounded(String const &a, String const &b, isize max_distance) {
+	if (gb_abs(a.len - b.len) > max_distance) {
+		return max_distance+1;
+	}
+
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	isize w = b.len+1;
+	isize *rows = gb_alloc_array(temporary_allocator(), isize, 3*w);
+	isize *prev2 = rows;
+	isize *prev  = rows + w;
+	isize *curr  = rows + 2*w;
+	for (isize j = 0; j <= b.len; j++) {
+		prev[j] = j;
+	}
+
+	bool prev_beyond = false;
+	for (isize i = 1; i <= a.len; i++) {
+		char a_c = gb_char_to_lower(cast(char)a.text[i-1]);
+		curr[0] = i;
+		isize row_minimum = i;
+		for (isize j = 1; j <= b.len; j++) {
+			char b_c = gb_char_to_lower(cast(char)b.text[j-1]);
+			if (a_c == b_c) {
+				curr[j] = prev[j-1];
+			} else {
+				isize minimum = gb_min(gb_min(prev[j], curr[j-1]), prev[j-1]) + 1;
+				#if USE_DAMERAU_LEVENSHTEIN
+				if (i > 1 && j > 1) {
+					minimum = gb_min(minimum, prev2[j-2] + 1);
+				}
+				#endif
+				curr[j] = minimum;
+			}
+			row_minimum = gb_min(row_minimum, curr[j]);
+		}
+
+		bool beyond = row_minimum > max_distance;
+		if (beyond && prev_beyond) {
+			return max_distance+1;
+		}
+		prev_beyond = beyond;
+
+		isize *next = prev2;
+		prev2 = prev;
+		prev  = curr;
+		curr  = next;
+	}
+	return gb_min(prev[b.len], max_distance+1);
+}
+
 gb_internal void did_you_mean_append(DidYouMeanAnswers *d, String const &target) {
 	if (target.len == 0 || target == "_") {
 		return;
 	}
+	isize distance = levenstein_distance_case_insensitive_bounded(d->key, target, MAX_SMALLEST_DID_YOU_MEAN_DISTANCE);
+	if (distance > MAX_SMALLEST_DID_YOU_MEAN_DISTANCE) {
+		return;
+	}
 	DistanceAndTarget dat = {};
 	dat.target = target;
-	dat.distance = levenstein_distance_case_insensitive(d->key, target);
+	dat.distance = distance;
 	array_add(&d->distances, dat);
 }
 gb_internal Slice<DistanceAndTarget> did_you_mean_results(DidYouMeanAnswers *d) {
-	array_sort(d->distances, gb_isize_cmp(gb_offset_of(DistanceAndTarget, distance)));
+	// NOTE: Ties are ordered by name, so the suggestions shown within -did-you-mean-limit do not depend
+	// on the order the candidates were found in
+	array_sort(d->distances, [](void const *a, void const *b) -> int {
+		DistanceAndTarget const *x = cast(DistanceAndTarget const *)a;
+		DistanceAndTarget const *y = cast(DistanceAndTarget const *)b;
+		if (x->distance != y->distance) {
+			return x->distance < y->distance ? -1 : +1;
+		}
+		return string_compare(x->target, y->target);
+	});
 	isize count = 0;
 	for (isize i = 0; i < d->distances.count; i++) {
 		isize distance = d->distances[i].distance;
@@ -923,6 +1146,114 @@ gb_internal Slice<DistanceAndTarget> did_you_mean_results(DidYouMeanAnswers *d)
 }
 
 
+// NOTE: An index of the distinct case-insensitive character bigrams of a fixed set of candidates, e.g. the
+// entities of a package, so that a suggestion only computes the edit distance to the candidates which share
+// enough bigrams with the key. Each edit removes at most three bigrams (a transposition), so a candidate
+// within the maximum distance shares at least `bigrams(key) - 3*MAX_SMALLEST_DID_YOU_MEAN_DISTANCE` of them.
+struct DidYouMeanBigram {
+	u16 bigram;
+	i32 target;
+};
+
+struct DidYouMeanIndex {
+	Slice<String>           targets;
+	Slice<DidYouMeanBigram> bigrams; // sorted by bigram
+};
+
+gb_internal isize did_you_mean_distinct_bigrams(String const &s, u16 *bigrams) {
+	isize count = 0;
+	for (isize i = 0; i+1 < s.len; i++) {
+		u16 b = cast(u16)((cast(u8)gb_char_to_lower(cast(char)s.text[i]) << 8) | cast(u8)gb_char_to_lower(cast(char)s.text[i+1]));
+		bool found = false;
+		for (isize j = 0; j < count; j++) {
+			if (bigrams[j] == b) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			bigrams[count++] = b;
+		}
+	}
+	return count;
+}
+
+gb_internal int did_you_mean_bigram_cmp(void const *a, void const *b) {
+	DidYouMeanBigram const *x = cast(DidYouMeanBigram const *)a;
+	DidYouMeanBigram const *y = cast(DidYouMeanBigram const *)b;
+	if (x->bigram != y->bigram) {
+		return x->bigram < y->bigram ? -1 : +1;
+	}
+	return x->target < y->target ? -1 : x->target > y->target ? +1 : 0;
+}
+
+gb_internal DidYouMeanIndex *did_you_mean_index_make(gbAllocator allocator, Slice<String> targets) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	isize total = 0;
+	for (String const &target : targets) {
+		total += gb_max(target.len-1, 0);
+	}
+
+	DidYouMeanIndex *index = gb_alloc_item(allocator, DidYouMeanIndex);
+	index->targets = targets;
+
+	Array<DidYouMeanBigram> bigrams = {};
+	array_init(&bigrams, allocator, 0, total);
+	for_array(i, targets) {
+		String const &target = targets[i];
+		u16 *distinct = gb_alloc_array(temporary_allocator(), u16, gb_max(target.len, 1));
+		isize count = did_you_mean_distinct_bigrams(target, distinct);
+		for (isize j = 0; j < count; j++) {
+			array_add(&bigrams, DidYouMeanBigram{distinct[j], cast(i32)i});
+		}
+	}
+	array_sort(bigrams, did_you_mean_bigram_cmp);
+	index->bigrams = slice_from_array(bigrams);
+	return index;
+}
+
+gb_internal void did_you_mean_append_from_index(DidYouMeanAnswers *d, DidYouMeanIndex *index) {
+	TEMPORARY_ALLOCATOR_GUARD();
+
+	u16 *key_bigrams = gb_alloc_array(temporary_allocator(), u16, gb_max(d->key.len, 1));
+	isize key_bigram_count = did_you_mean_distinct_bigrams(d->key, key_bigrams);
+	isize threshold = key_bigram_count - 3*MAX_SMALLEST_DID_YOU_MEAN_DISTANCE;
+	if (threshold <= 0) {
+		// NOTE: Too short a key for the bigrams to rule anything out
+		for (String const &target : index->targets) {
+			did_you_mean_append(d, target);
+		}
+		return;
+	}
+
+	i32 *shared = gb_alloc_array(temporary_allocator(), i32, index->targets.count);
+	gb_zero_array(shared, index->targets.count);
+	for (isize i = 0; i < key_bigram_count; i++) {
+		u16 b = key_bigrams[i];
+		isize lo = 0;
+		isize hi = index->bigrams.count;
+		while (lo < hi) {
+			isize mid = lo + (hi-lo)/2;
+			if (index->bigrams[mid].bigram < b) {
+				lo = mid+1;
+			} else {
+				hi = mid;
+			}
+		}
+		for (isize j = lo; j < index->bigrams.count && index->bigrams[j].bigram == b; j++) {
+			shared[index->bigrams[j].target] += 1;
+		}
+	}
+
+	for_array(i, index->targets) {
+		if (shared[i] >= threshold) {
+			did_you_mean_append(d, index->targets[i]);
+		}
+	}
+}
+
+
 #if defined(GB_SYSTEM_WINDOWS)
 	#pragma warning(pop)
 #endif
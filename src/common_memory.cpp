@@ -69,13 +69,22 @@ struct Arena {
 	isize         temp_count;
 	Thread *      parent_thread;
 	bool          custom_arena;
+	bool          large_pages;
 };
 
 enum { DEFAULT_MINIMUM_BLOCK_SIZE = 8ll*1024ll*1024ll };
 
+// NOTE: With -large-pages, the permanent arenas map their blocks with huge pages (MADV_HUGEPAGE on Linux,
+// MEM_LARGE_PAGES on Windows) as the checker's pointer chasing over entities, types and nodes is bound by
+// the TLB on large programs. They also use larger blocks, as the permanent arenas are the ones which grow
+// the most.
+enum { LARGE_PAGES_PERMANENT_BLOCK_SIZE = 64ll*1024ll*1024ll };
+
 gb_global isize DEFAULT_PAGE_SIZE = 4096;
+gb_global isize LARGE_PAGE_SIZE   = 2ll*1024ll*1024ll;
+gb_global bool  virtual_memory_large_pages;
 
-gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit);
+gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit, bool large_pages=false);
 gb_internal void virtual_memory_dealloc(MemoryBlock *block);
 gb_internal void *arena_alloc(Arena *arena, isize min_size, isize alignment);
 gb_internal void arena_free_all(Arena *arena);
@@ -99,6 +108,11 @@ gb_internal void thread_init_arenas(Thread *t) {
 
 	t->permanent_arena->minimum_block_size = DEFAULT_MINIMUM_BLOCK_SIZE;
 	t->temporary_arena->minimum_block_size = DEFAULT_MINIMUM_BLOCK_SIZE;
+
+	if (virtual_memory_large_pages) {
+		t->permanent_arena->large_pages = true;
+		t->permanent_arena->minimum_block_size = LARGE_PAGES_PERMANENT_BLOCK_SIZE;
+	}
 }
 
 gb_internal void *arena_alloc(Arena *arena, isize min_size, isize alignment) {
@@ -116,7 +130,7 @@ gb_internal void *arena_alloc(Arena *arena, isize min_size, isize alignment) {
 		
 		isize block_size = gb_max(size, arena->minimum_block_size);
 		
-		MemoryBlock *new_block = virtual_memory_alloc(block_size, true);
+		MemoryBlock *new_block = virtual_memory_alloc(block_size, true, arena->large_pages);
 		new_block->prev = arena->curr_block;
 		arena->curr_block = new_block;
 	}
@@ -216,6 +230,8 @@ gb_global std::atomic<isize> global_platform_memory_total_usage;
 gb_global PlatformMemoryBlock global_platform_memory_block_sentinel;
 
 gb_internal PlatformMemoryBlock *platform_virtual_memory_alloc(isize total_size, bool commit);
+gb_internal PlatformMemoryBlock *platform_virtual_memory_alloc_large(isize total_size);
+gb_internal bool platform_virtual_memory_enable_large_pages(void);
 gb_internal void platform_virtual_memory_free(PlatformMemoryBlock *block);
 gb_internal void platform_virtual_memory_protect(void *memory, isize size);
 
@@ -250,6 +266,43 @@ gb_internal bool  platform_virtual_memory_commit_internal(void *data, isize comm
 		global_platform_memory_total_usage.fetch_add(total_size);
 		return pmblock;
 	}
+	// NOTE: Large pages need the "Lock pages in memory" privilege, which is held by the account but
+	// must still be enabled on the token of the process
+	gb_internal bool platform_virtual_memory_enable_large_pages(void) {
+		SIZE_T large_page_size = GetLargePageMinimum();
+		if (large_page_size == 0) {
+			return false;
+		}
+		HANDLE token = nullptr;
+		if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES|TOKEN_QUERY, &token)) {
+			return false;
+		}
+		defer (CloseHandle(token));
+
+		TOKEN_PRIVILEGES tp = {};
+		tp.PrivilegeCount = 1;
+		tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+		if (!LookupPrivilegeValueW(nullptr, L"SeLockMemoryPrivilege", &tp.Privileges[0].Luid)) {
+			return false;
+		}
+		// NOTE: succeeds even when the privilege is not held, which is only reported through the last error
+		if (!AdjustTokenPrivileges(token, FALSE, &tp, 0, nullptr, nullptr) || GetLastError() != ERROR_SUCCESS) {
+			return false;
+		}
+		LARGE_PAGE_SIZE = cast(isize)large_page_size;
+		return true;
+	}
+
+	gb_internal PlatformMemoryBlock *platform_virtual_memory_alloc_large(isize total_size) {
+		// NOTE: large pages are always committed and may fail when physical memory is fragmented,
+		// in which case the caller falls back to normal pages
+		void *mem = VirtualAlloc(0, total_size, MEM_RESERVE|MEM_COMMIT|MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (mem == nullptr) {
+			return nullptr;
+		}
+		global_platform_memory_total_usage.fetch_add(total_size);
+		return cast(PlatformMemoryBlock *)mem;
+	}
 	gb_internal void platform_virtual_memory_free(PlatformMemoryBlock *block) {
 		global_platform_memory_total_usage.fetch_sub(block->total_size);
 		GB_ASSERT(VirtualFree(block, 0, MEM_RELEASE));
@@ -307,6 +360,40 @@ gb_internal bool  platform_virtual_memory_commit_internal(void *data, isize comm
 	gb_internal PlatformMemoryBlock *platform_virtual_memory_alloc_uncommited(isize total_size) {
 		return platform_virtual_memory_alloc(total_size, false);
 	}
+
+	gb_internal bool platform_virtual_memory_enable_large_pages(void) {
+	#if defined(MADV_HUGEPAGE)
+		return true;
+	#else
+		return false;
+	#endif
+	}
+
+	gb_internal PlatformMemoryBlock *platform_virtual_memory_alloc_large(isize total_size) {
+	#if defined(MADV_HUGEPAGE)
+		// NOTE: mmap only guarantees the alignment of a normal page, so over-allocate and trim the ends
+		// so that every huge page of the block is fully within it
+		isize mapped_size = total_size + LARGE_PAGE_SIZE;
+		u8 *mem = cast(u8 *)mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+		if (mem == MAP_FAILED) {
+			return nullptr;
+		}
+		u8 *start = cast(u8 *)align_formula_ptr(mem, LARGE_PAGE_SIZE);
+		u8 *end   = start + total_size;
+		if (start != mem) {
+			munmap(mem, start - mem);
+		}
+		if (end != mem + mapped_size) {
+			munmap(end, (mem + mapped_size) - end);
+		}
+		// NOTE: only advice, the kernel may still back the block with normal pages
+		madvise(start, total_size, MADV_HUGEPAGE);
+		global_platform_memory_total_usage.fetch_add(total_size);
+		return cast(PlatformMemoryBlock *)start;
+	#else
+		return nullptr;
+	#endif
+	}
 	gb_internal void platform_virtual_memory_free(PlatformMemoryBlock *block) {
 		isize size = block->total_size;
 		global_platform_memory_total_usage.fetch_sub(size);
@@ -328,7 +415,7 @@ gb_internal bool  platform_virtual_memory_commit_internal(void *data, isize comm
 	}
 #endif
 
-gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit) {
+gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit, bool large_pages) {
 	isize const page_size = DEFAULT_PAGE_SIZE; 
 	
 	isize total_size     = size + gb_size_of(PlatformMemoryBlock);
@@ -336,15 +423,26 @@ gb_internal MemoryBlock *virtual_memory_alloc(isize size, bool commit) {
 	isize protect_offset = 0;
 	
 	bool do_protection = false;
-	{ // overflow protection
+	PlatformMemoryBlock *pmblock = nullptr;
+	if (large_pages && virtual_memory_large_pages) {
+		// NOTE: no guard page, as protecting it would split the last huge page; the block is instead
+		// rounded up to whole huge pages, all of which is usable
+		total_size = align_formula_isize(size + base_offset, LARGE_PAGE_SIZE);
+		pmblock = platform_virtual_memory_alloc_large(total_size);
+		if (pmblock != nullptr) {
+			size = total_size - base_offset;
+		}
+	}
+
+	if (pmblock == nullptr) { // overflow protection
 		isize rounded_size = align_formula_isize(size, page_size);
 		total_size     = rounded_size + 2*page_size;
 		base_offset    = page_size + rounded_size - size;
 		protect_offset = page_size + rounded_size;
 		do_protection  = true;
+
+		pmblock = platform_virtual_memory_alloc(total_size, commit);
 	}
-	
-	PlatformMemoryBlock *pmblock = platform_virtual_memory_alloc(total_size, commit);
 	GB_ASSERT_MSG(pmblock != nullptr, "Out of Virtual Memory, oh no...");
 	
 	pmblock->block.base = cast(u8 *)pmblock + base_offset;
@@ -520,6 +618,39 @@ gb_internal Arena *get_arena(ThreadArenaKind kind) {
 	return nullptr;
 }
 
+
+// NOTE: Bytes attributed to each compiler subsystem, only recorded with -show-more-timings
+enum MemorySubsystem : u8 {
+	MemorySubsystem_Tokens,
+	MemorySubsystem_Ast,
+	MemorySubsystem_Scopes,
+	MemorySubsystem_Entities,
+	MemorySubsystem_Types,
+
+	MemorySubsystem_COUNT,
+};
+
+gb_global char const *memory_subsystem_names[MemorySubsystem_COUNT] = {
+	"tokens",
+	"ast",
+	"scopes",
+	"entities",
+	"types",
+};
+
+gb_global bool global_memory_accounting;
+gb_global std::atomic<isize> global_memory_subsystem_bytes[MemorySubsystem_COUNT];
+
+gb_internal gb_inline void memory_account(MemorySubsystem subsystem, isize bytes) {
+	if (global_memory_accounting) {
+		global_memory_subsystem_bytes[subsystem].fetch_add(bytes, std::memory_order_relaxed);
+	}
+}
+
+gb_internal isize memory_subsystem_bytes(MemorySubsystem subsystem) {
+	return global_memory_subsystem_bytes[subsystem].load(std::memory_order_relaxed);
+}
+
 template <typename T>
 gb_internal T *arena_alloc_array(Arena *arena, isize count) {
 	return cast(T *)arena_alloc(arena, gb_size_of(T)*count, gb_align_of(T));
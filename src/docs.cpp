@@ -98,28 +98,25 @@ gb_internal GB_COMPARE_PROC(cmp_ast_package_by_name) {
 #include "docs_writer.cpp"
 
 gb_internal void print_doc_line(i32 indent, String const &data) {
-	while (indent --> 0) {
-		gb_printf("\t");
-	}
-	gb_file_write(gb_file_get_standard(gbFileStandard_Output), data.text, data.len);
-	gb_printf("\n");
+	OutputBuffer *out = stdout_buffer();
+	output_buffer_write_bytes(out, '\t', indent);
+	output_buffer_write_string(out, data);
+	output_buffer_write_byte(out, '\n');
 }
 
 gb_internal void print_doc_line(i32 indent, char const *fmt, ...) {
-	while (indent --> 0) {
-		gb_printf("\t");
-	}
+	OutputBuffer *out = stdout_buffer();
+	output_buffer_write_bytes(out, '\t', indent);
 	va_list va;
 	va_start(va, fmt);
-	gb_printf_va(fmt, va);
+	output_buffer_printf_va(out, fmt, va);
 	va_end(va);
-	gb_printf("\n");
+	output_buffer_write_byte(out, '\n');
 }
 gb_internal void print_doc_line_no_newline(i32 indent, String const &data) {
-	while (indent --> 0) {
-		gb_printf("\t");
-	}
-	gb_file_write(gb_file_get_standard(gbFileStandard_Output), data.text, data.len);
+	OutputBuffer *out = stdout_buffer();
+	output_buffer_write_bytes(out, '\t', indent);
+	output_buffer_write_string(out, data);
 }
 
 
@@ -219,7 +216,7 @@ gb_internal void print_doc_expr(Ast *expr) {
 	} else {
 		s = expr_to_string(expr);
 	}
-	gb_file_write(gb_file_get_standard(gbFileStandard_Output), s, gb_string_length(s));
+	output_buffer_write(stdout_buffer(), s, gb_string_length(s));
 	gb_string_free(s);
 }
 
@@ -243,7 +240,7 @@ gb_internal void print_doc_package(CheckerInfo *info, AstPackage *pkg) {
 		auto entities = array_make<Entity *>(heap_allocator(), 0, pkg->scope->elements.count);
 		defer (array_free(&entities));
 		for (auto const &entry : pkg->scope->elements) {
-			Entity *e = entry.value;
+			Entity *e = entry.value();
 			switch (e->kind) {
 			case Entity_Invalid:
 			case Entity_Builtin:
@@ -318,22 +315,22 @@ gb_internal void print_doc_package(CheckerInfo *info, AstPackage *pkg) {
 			print_doc_line_no_newline(2, e->token.string);
 			if (type_expr != nullptr) {
 				gbString t = expr_to_string(type_expr);
-				gb_printf(": %s ", t);
+				output_buffer_printf(stdout_buffer(), ": %s ", t);
 				gb_string_free(t);
 			} else {
-				gb_printf(" :");
+				output_buffer_write_string(stdout_buffer(), str_lit(" :"));
 			}
 			if (e->kind == Entity_Variable) {
 				if (init_expr != nullptr) {
-					gb_printf("= ");
+					output_buffer_write_string(stdout_buffer(), str_lit("= "));
 					print_doc_expr(init_expr);
 				}
 			} else {
-				gb_printf(": ");
+				output_buffer_write_string(stdout_buffer(), str_lit(": "));
 				print_doc_expr(init_expr);
 			}
 
-			gb_printf("\n");
+			output_buffer_write_byte(stdout_buffer(), '\n');
 
 			if (show_docs) {
 				print_doc_comment_group_string(3, docs);
@@ -412,5 +409,6 @@ gb_internal void generate_documentation(Checker *c) {
 		for_array(i, pkgs) {
 			print_doc_package(info, pkgs[i]);
 		}
+		output_buffer_flush(stdout_buffer());
 	}
 }
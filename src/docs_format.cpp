@@ -14,8 +14,8 @@ struct OdinDocVersionType {
 };
 
 #define OdinDocVersionType_Major 0
-#define OdinDocVersionType_Minor 3
-#define OdinDocVersionType_Patch 2
+#define OdinDocVersionType_Minor 4
+#define OdinDocVersionType_Patch 0
 
 struct OdinDocHeaderBase {
 	u8                 magic[8];
@@ -283,6 +283,37 @@ struct OdinDocPkg {
 };
 
 
+enum OdinDocSectionKind : u32 {
+	OdinDocSection_Invalid  = 0,
+	OdinDocSection_Files    = 1,
+	OdinDocSection_Pkgs     = 2,
+	OdinDocSection_Entities = 3,
+	OdinDocSection_Types    = 4,
+	OdinDocSection_Strings  = 5,
+	OdinDocSection_Blob     = 6, // every other array, including `pkg_index`
+};
+
+#define OdinDocSectionVersion 1
+
+// NOTE: Every section is one contiguous byte range of the file, so a reader can map the file
+// and only touch the sections it needs. `version` changes whenever the layout of a section's
+// items changes, independently of the file version.
+struct OdinDocSection {
+	OdinDocSectionKind kind;
+	u32                version;
+	u32                offset; // in bytes from the start of the file
+	u32                size;   // in bytes
+};
+
+// NOTE: The top level entities of a package (its `entries`) are stored contiguously in
+// `entities`, so one package can be read without looking at any other package
+struct OdinDocPkgIndexEntry {
+	u32                fullpath_hash; // fnv32a of the package's fullpath
+	OdinDocPkgIndex    pkg;
+	OdinDocEntityIndex first_entity;
+	u32                entity_count;
+};
+
 struct OdinDocHeader {
 	OdinDocHeaderBase base;
 
@@ -290,5 +321,8 @@ struct OdinDocHeader {
 	OdinDocArray<OdinDocPkg>    pkgs;
 	OdinDocArray<OdinDocEntity> entities;
 	OdinDocArray<OdinDocType>   types;
+
+	OdinDocArray<OdinDocSection>       sections;
+	OdinDocArray<OdinDocPkgIndexEntry> pkg_index; // sorted by `fullpath_hash`
 };
 
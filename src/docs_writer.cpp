@@ -28,6 +28,12 @@ struct OdinDocWriter {
 
 	StringMap<OdinDocString> string_cache;
 
+	// NOTE: The rendered text does not depend on the pass, so it is produced once (mostly by
+	// odin_doc_render_package_strings on the thread pool) and reused by both passes
+	PtrMap<Ast *,          String> expr_strings;
+	PtrMap<Ast *,          String> short_expr_strings;
+	PtrMap<CommentGroup *, String> comment_strings;
+
 	OrderedInsertPtrMap<AstFile *,    OdinDocFileIndex>     file_cache;
 	OrderedInsertPtrMap<AstPackage *, OdinDocPkgIndex>      pkg_cache;
 	OrderedInsertPtrMap<Entity *,     OdinDocEntityIndex>   entity_cache;
@@ -40,6 +46,9 @@ struct OdinDocWriter {
 
 	OdinDocWriterItemTracker<u8> strings;
 	OdinDocWriterItemTracker<u8> blob;
+
+	OdinDocArray<OdinDocSection>       sections;
+	OdinDocArray<OdinDocPkgIndexEntry> pkg_index;
 };
 
 gb_internal OdinDocEntityIndex odin_doc_add_entity(OdinDocWriter *w, Entity *e);
@@ -56,7 +65,11 @@ gb_internal void odin_doc_writer_prepare(OdinDocWriter *w) {
 	debugf("odin_doc_writer_prepare\n");
 	w->state = OdinDocWriterState_Preparing;
 
-	string_map_init(&w->string_cache);
+	string_map_init(&w->string_cache, 1<<16);
+
+	map_init(&w->expr_strings,       1<<16);
+	map_init(&w->short_expr_strings, 1<<4);
+	map_init(&w->comment_strings,    1<<16);
 
 	map_init(&w->file_cache,        1<<10);
 	map_init(&w->pkg_cache,         1<<10);
@@ -77,6 +90,9 @@ gb_internal void odin_doc_writer_destroy(OdinDocWriter *w) {
 	gb_free(heap_allocator(), w->data);
 
 	string_map_destroy(&w->string_cache);
+	map_destroy(&w->expr_strings);
+	map_destroy(&w->short_expr_strings);
+	map_destroy(&w->comment_strings);
 	map_destroy(&w->file_cache);
 	map_destroy(&w->pkg_cache);
 	map_destroy(&w->entity_cache);
@@ -158,6 +174,9 @@ gb_internal void odin_doc_writer_end_writing(OdinDocWriter *w) {
 	odin_doc_writer_assign_tracker(&h->pkgs,     w->pkgs);
 	odin_doc_writer_assign_tracker(&h->entities, w->entities);
 	odin_doc_writer_assign_tracker(&h->types,    w->types);
+
+	h->sections  = w->sections;
+	h->pkg_index = w->pkg_index;
 }
 
 template <typename T>
@@ -210,7 +229,8 @@ gb_internal OdinDocString odin_doc_write_string_without_cache(OdinDocWriter *w,
 }
 
 gb_internal OdinDocString odin_doc_write_string(OdinDocWriter *w, String const &str) {
-	OdinDocString *c = string_map_get(&w->string_cache, str);
+	StringHashKey key = string_hash_string(str);
+	OdinDocString *c = string_map_get(&w->string_cache, key);
 	if (c != nullptr) {
 		if (w->state == OdinDocWriterState_Writing) {
 			GB_ASSERT(from_string(&w->header->base, *c) == str);
@@ -220,7 +240,7 @@ gb_internal OdinDocString odin_doc_write_string(OdinDocWriter *w, String const &
 
 	OdinDocString res = odin_doc_write_string_without_cache(w, str);
 
-	string_map_set(&w->string_cache, str, res);
+	string_map_set(&w->string_cache, key, res);
 
 	return res;
 }
@@ -385,16 +405,34 @@ gb_internal OdinDocString odin_doc_pkg_doc_string(OdinDocWriter *w, AstPackage *
 	return odin_doc_write_string_without_cache(w, str);
 }
 
-gb_internal OdinDocString odin_doc_comment_group_string(OdinDocWriter *w, CommentGroup *g) {
-	if (g == nullptr) {
-		return {};
-	}
+gb_internal String odin_doc_render_comment_group_string(CommentGroup *g) {
 	auto buf = array_make<u8>(heap_allocator(), 0, 0);
 
 	odin_doc_append_comment_group_string(&buf, g);
 
 	String str = string_intern_string(make_string(buf.data, buf.count));
 	array_free(&buf);
+	return str;
+}
+
+gb_internal String odin_doc_render_expr_string(Ast *expr, bool use_shorthand) {
+	gbString s = write_expr_to_string(gb_string_make(heap_allocator(), ""), expr, use_shorthand);
+	String str = string_intern_string(make_string(cast(u8 *)s, gb_string_length(s)));
+	gb_string_free(s);
+	return str;
+}
+
+gb_internal OdinDocString odin_doc_comment_group_string(OdinDocWriter *w, CommentGroup *g) {
+	if (g == nullptr) {
+		return {};
+	}
+	String str = {};
+	if (String *found = map_get(&w->comment_strings, g)) {
+		str = *found;
+	} else {
+		str = odin_doc_render_comment_group_string(g);
+		map_set(&w->comment_strings, g, str);
+	}
 	return odin_doc_write_string_without_cache(w, str);
 }
 
@@ -402,14 +440,16 @@ gb_internal OdinDocString odin_doc_expr_string(OdinDocWriter *w, Ast *expr, bool
 	if (expr == nullptr) {
 		return {};
 	}
-	gbString s = write_expr_to_string(
-		gb_string_make(heap_allocator(), ""),
-		expr,
-		use_shorthand || (build_context.cmd_doc_flags & CmdDocFlag_Short)
-	);
-	String str = string_intern_string(make_string(cast(u8 *)s, gb_string_length(s)));
-	gb_string_free(s);
+	use_shorthand = use_shorthand || (build_context.cmd_doc_flags & CmdDocFlag_Short);
 
+	auto *cache = use_shorthand ? &w->short_expr_strings : &w->expr_strings;
+	String str = {};
+	if (String *found = map_get(cache, expr)) {
+		str = *found;
+	} else {
+		str = odin_doc_render_expr_string(expr, use_shorthand);
+		map_set(cache, expr, str);
+	}
 	return odin_doc_write_string(w, str);
 }
 
@@ -797,6 +837,49 @@ gb_internal OdinDocTypeIndex odin_doc_type(OdinDocWriter *w, Type *type, bool ca
 	}
 	return type_index;
 }
+gb_internal void odin_doc_entity_comments(Entity *e, CommentGroup **comment_, CommentGroup **docs_) {
+	CommentGroup *comment = nullptr;
+	CommentGroup *docs = nullptr;
+	if (e->decl_info != nullptr) {
+		comment = e->decl_info->comment;
+		docs = e->decl_info->docs;
+	}
+	if (e->kind == Entity_Variable) {
+		if (!comment) { comment          = e->Variable.comment; }
+		if (!docs)    { docs             = e->Variable.docs; }
+	} else if (e->kind == Entity_Constant) {
+		if (!comment) { comment          = e->Constant.comment; }
+		if (!docs)    { docs             = e->Constant.docs; }
+	}
+	*comment_ = comment;
+	*docs_ = docs;
+}
+
+// Returns the expression whose text becomes the entity's `init_string`, if there is one
+gb_internal Ast *odin_doc_entity_init_string_expr(Entity *e, Ast *init_expr, bool *use_shorthand_) {
+	*use_shorthand_ = false;
+	if (init_expr) {
+		if (e->kind == Entity_Variable) {
+			Ast *expr = init_expr;
+			if (expr->kind == Ast_CompoundLit) {
+				if (expr->CompoundLit.elems.count > 512) {
+					*use_shorthand_ = true;
+				}
+			}
+		}
+		return init_expr;
+	}
+	if (e->kind == Entity_Constant) {
+		if (e->Constant.flags & EntityConstantFlag_ImplicitEnumValue) {
+			return nullptr;
+		}
+		return e->Constant.param_value.original_ast_expr;
+	} else if (e->kind == Entity_Variable) {
+		return e->Variable.param_value.original_ast_expr;
+	}
+	return nullptr;
+}
+
 gb_internal OdinDocEntityIndex odin_doc_add_entity(OdinDocWriter *w, Entity *e) {
 	if (e == nullptr) {
 		return 0;
@@ -826,16 +909,8 @@ gb_internal OdinDocEntityIndex odin_doc_add_entity(OdinDocWriter *w, Entity *e)
 		type_expr = e->decl_info->type_expr;
 		init_expr = e->decl_info->init_expr;
 		decl_node = e->decl_info->decl_node;
-		comment = e->decl_info->comment;
-		docs = e->decl_info->docs;
-	}
-	if (e->kind == Entity_Variable) {
-		if (!comment) { comment          = e->Variable.comment; }
-		if (!docs)    { docs             = e->Variable.docs; }
-	} else if (e->kind == Entity_Constant) {
-		if (!comment) { comment          = e->Constant.comment; }
-		if (!docs)    { docs             = e->Constant.docs; }
 	}
+	odin_doc_entity_comments(e, &comment, &docs);
 
 	String name = e->token.string;
 	String link_name = {};
@@ -925,34 +1000,15 @@ gb_internal OdinDocEntityIndex odin_doc_add_entity(OdinDocWriter *w, Entity *e)
 	}
 
 	OdinDocString init_string = {};
-	if (init_expr) {
-		bool use_shorthand = false;
-		if (e->kind == Entity_Variable) {
-			Ast *expr = init_expr;
-			if (expr->kind == Ast_CompoundLit) {
-				if (expr->CompoundLit.elems.count > 512) {
-					use_shorthand = true;
-				}
-			}
-		}
-		init_string = odin_doc_expr_string(w, init_expr, use_shorthand);
-	} else {
-		if (e->kind == Entity_Constant) {
-			if (e->Constant.flags & EntityConstantFlag_ImplicitEnumValue) {
-				init_string = {}; // Blank
-			} else if (e->Constant.param_value.original_ast_expr) {
-				init_string = odin_doc_expr_string(w, e->Constant.param_value.original_ast_expr);
-			} else {
-				gbString s = exact_value_to_string(e->Constant.value);
-				String str = string_intern_string(make_string(cast(u8 *)s, gb_string_length(s)));
-				gb_string_free(s);
-				init_string = odin_doc_write_string(w, str);
-			}
-		} else if (e->kind == Entity_Variable) {
-			if (e->Variable.param_value.original_ast_expr) {
-				init_string = odin_doc_expr_string(w, e->Variable.param_value.original_ast_expr);
-			}
-		}
+	bool use_shorthand = false;
+	if (Ast *init_string_expr = odin_doc_entity_init_string_expr(e, init_expr, &use_shorthand)) {
+		init_string = odin_doc_expr_string(w, init_string_expr, use_shorthand);
+	} else if (init_expr == nullptr && e->kind == Entity_Constant &&
+	           (e->Constant.flags & EntityConstantFlag_ImplicitEnumValue) == 0) {
+		gbString s = exact_value_to_string(e->Constant.value);
+		String str = string_intern_string(make_string(cast(u8 *)s, gb_string_length(s)));
+		gb_string_free(s);
+		init_string = odin_doc_write_string(w, str);
 	}
 
 	doc_entity.kind = kind;
@@ -1049,6 +1105,35 @@ gb_internal void odin_doc_update_entities(OdinDocWriter *w) {
 
 
 
+gb_internal bool odin_doc_is_pkg_entry(AstPackage *pkg, Entity *e) {
+	switch (e->kind) {
+	case Entity_Invalid:
+	case Entity_Nil:
+	case Entity_Label:
+		return false;
+	case Entity_Constant:
+	case Entity_Variable:
+	case Entity_TypeName:
+	case Entity_Procedure:
+	case Entity_ProcGroup:
+	case Entity_ImportName:
+	case Entity_LibraryName:
+	case Entity_Builtin:
+		// Fine
+		break;
+	}
+	if (e->pkg != pkg) {
+		return false;
+	}
+	if (!is_entity_exported(e, true)) {
+		return false;
+	}
+	if (e->token.string.len == 0) {
+		return false;
+	}
+	return true;
+}
+
 gb_internal OdinDocArray<OdinDocScopeEntry> odin_doc_add_pkg_entries(OdinDocWriter *w, AstPackage *pkg) {
 	if (pkg->scope == nullptr) {
 		return {};
@@ -1067,30 +1152,8 @@ gb_internal OdinDocArray<OdinDocScopeEntry> odin_doc_add_pkg_entries(OdinDocWrit
 			continue;
 		}
 		auto interned = pkg->scope->elements.keys[i];
-		Entity *e = pkg->scope->elements.slots[i].value;
-		switch (e->kind) {
-		case Entity_Invalid:
-		case Entity_Nil:
-		case Entity_Label:
-			continue;
-		case Entity_Constant:
-		case Entity_Variable:
-		case Entity_TypeName:
-		case Entity_Procedure:
-		case Entity_ProcGroup:
-		case Entity_ImportName:
-		case Entity_LibraryName:
-		case Entity_Builtin:
-			// Fine
-			break;
-		}
-		if (e->pkg != pkg) {
-			continue;
-		}
-		if (!is_entity_exported(e, true)) {
-			continue;
-		}
-		if (e->token.string.len == 0) {
+		Entity *e = pkg->scope->elements.slots[i].value();
+		if (!odin_doc_is_pkg_entry(pkg, e)) {
 			continue;
 		}
 
@@ -1104,11 +1167,8 @@ gb_internal OdinDocArray<OdinDocScopeEntry> odin_doc_add_pkg_entries(OdinDocWrit
 }
 
 
-gb_internal void odin_doc_write_docs(OdinDocWriter *w) {
-	debugf("odin_doc_write_docs %s", w->state ? "preparing" : "writing");
-
+gb_internal Array<AstPackage *> odin_doc_packages_to_write(OdinDocWriter *w) {
 	auto pkgs = array_make<AstPackage *>(heap_allocator(), 0, w->info->packages.count);
-	defer (array_free(&pkgs));
 	for (auto const &entry : w->info->packages) {
 		AstPackage *pkg = entry.value;
 		if (build_context.cmd_doc_flags & CmdDocFlag_AllPackages) {
@@ -1121,9 +1181,149 @@ gb_internal void odin_doc_write_docs(OdinDocWriter *w) {
 			}
 		}
 	}
-
-	debugf("odin_doc_update_entities sort pkgs %s\n", w->state ? "preparing" : "writing");
 	array_sort(pkgs, cmp_ast_package_by_name);
+	return pkgs;
+}
+
+
+struct OdinDocRenderedExpr {
+	Ast *  expr;
+	bool   use_shorthand;
+	String str;
+};
+
+struct OdinDocRenderedComment {
+	CommentGroup *group;
+	String        str;
+};
+
+struct OdinDocPackageStrings {
+	AstPackage *pkg;
+	Array<OdinDocRenderedExpr>    exprs;
+	Array<OdinDocRenderedComment> comments;
+};
+
+gb_internal void odin_doc_render_comment(OdinDocPackageStrings *ps, CommentGroup *g) {
+	if (g != nullptr) {
+		array_add(&ps->comments, OdinDocRenderedComment{g, odin_doc_render_comment_group_string(g)});
+	}
+}
+
+// NOTE: Renders the strings of a package's top level entities (the bulk of the work of writing
+// its entries) without touching the writer, so that packages can be done in parallel
+gb_internal WORKER_TASK_PROC(odin_doc_render_package_strings_worker_proc) {
+	OdinDocPackageStrings *ps = cast(OdinDocPackageStrings *)data;
+	AstPackage *pkg = ps->pkg;
+	if (pkg->scope == nullptr) {
+		return 0;
+	}
+
+	bool short_flag = (build_context.cmd_doc_flags & CmdDocFlag_Short) != 0;
+	for (isize i = 0; i < pkg->scope->elements.cap; i++) {
+		if (!pkg->scope->elements.slots[i].hash) {
+			continue;
+		}
+		Entity *e = pkg->scope->elements.slots[i].value();
+		if (!odin_doc_is_pkg_entry(pkg, e)) {
+			continue;
+		}
+
+		CommentGroup *comment = nullptr;
+		CommentGroup *docs = nullptr;
+		odin_doc_entity_comments(e, &comment, &docs);
+		odin_doc_render_comment(ps, comment);
+		odin_doc_render_comment(ps, docs);
+
+		Ast *init_expr = e->decl_info != nullptr ? e->decl_info->init_expr : nullptr;
+		bool use_shorthand = false;
+		if (Ast *expr = odin_doc_entity_init_string_expr(e, init_expr, &use_shorthand)) {
+			use_shorthand = use_shorthand || short_flag;
+			array_add(&ps->exprs, OdinDocRenderedExpr{expr, use_shorthand, odin_doc_render_expr_string(expr, use_shorthand)});
+		}
+
+		if (e->type != nullptr) {
+			// NOTE: the canonical hash is cached on the type itself
+			Type *type = e->type;
+			if (type->kind == Type_Named && type->Named.type_name->TypeName.is_type_alias) {
+				type = type->Named.base;
+			}
+			type_hash_canonical_type(type);
+		}
+	}
+	return 0;
+}
+
+gb_internal void odin_doc_render_package_strings(OdinDocWriter *w) {
+	auto pkgs = odin_doc_packages_to_write(w);
+	defer (array_free(&pkgs));
+
+	auto package_strings = slice_make<OdinDocPackageStrings>(heap_allocator(), pkgs.count);
+	defer (gb_free(heap_allocator(), package_strings.data));
+
+	for_array(i, pkgs) {
+		OdinDocPackageStrings *ps = &package_strings[i];
+		ps->pkg = pkgs[i];
+		array_init(&ps->exprs,    heap_allocator());
+		array_init(&ps->comments, heap_allocator());
+		thread_pool_add_task(odin_doc_render_package_strings_worker_proc, ps);
+	}
+	thread_pool_wait();
+
+	// NOTE: merged in package order; the rendered text only depends on its key
+	for (OdinDocPackageStrings &ps : package_strings) {
+		for (OdinDocRenderedExpr const &r : ps.exprs) {
+			map_set(r.use_shorthand ? &w->short_expr_strings : &w->expr_strings, r.expr, r.str);
+		}
+		for (OdinDocRenderedComment const &r : ps.comments) {
+			map_set(&w->comment_strings, r.group, r.str);
+		}
+		array_free(&ps.exprs);
+		array_free(&ps.comments);
+	}
+}
+
+
+gb_internal GB_COMPARE_PROC(odin_doc_pkg_index_entry_cmp) {
+	OdinDocPkgIndexEntry const *x = cast(OdinDocPkgIndexEntry const *)a;
+	OdinDocPkgIndexEntry const *y = cast(OdinDocPkgIndexEntry const *)b;
+	if (x->fullpath_hash != y->fullpath_hash) {
+		return x->fullpath_hash < y->fullpath_hash ? -1 : +1;
+	}
+	return x->pkg < y->pkg ? -1 : x->pkg > y->pkg;
+}
+
+template <typename T>
+gb_internal OdinDocSection odin_doc_section(OdinDocSectionKind kind, OdinDocWriterItemTracker<T> const &t) {
+	OdinDocSection section = {};
+	section.kind    = kind;
+	section.version = OdinDocSectionVersion;
+	section.offset  = cast(u32)t.offset;
+	section.size    = cast(u32)(t.cap*gb_size_of(T));
+	return section;
+}
+
+// NOTE: the trackers' offsets are only known once writing, but the table takes the same
+// amount of space in both passes
+gb_internal void odin_doc_write_sections(OdinDocWriter *w) {
+	OdinDocSection sections[6] = {
+		odin_doc_section(OdinDocSection_Files,    w->files),
+		odin_doc_section(OdinDocSection_Pkgs,     w->pkgs),
+		odin_doc_section(OdinDocSection_Entities, w->entities),
+		odin_doc_section(OdinDocSection_Types,    w->types),
+		odin_doc_section(OdinDocSection_Strings,  w->strings),
+		odin_doc_section(OdinDocSection_Blob,     w->blob),
+	};
+	w->sections = odin_write_slice(w, sections, gb_count_of(sections));
+}
+
+gb_internal void odin_doc_write_docs(OdinDocWriter *w) {
+	debugf("odin_doc_write_docs %s", w->state ? "preparing" : "writing");
+
+	auto pkgs = odin_doc_packages_to_write(w);
+	defer (array_free(&pkgs));
+
+	auto pkg_index_entries = array_make<OdinDocPkgIndexEntry>(heap_allocator(), 0, pkgs.count);
+	defer (array_free(&pkg_index_entries));
 
 	for_array(i, pkgs) {
 		gbAllocator allocator = heap_allocator();
@@ -1169,7 +1369,14 @@ gb_internal void odin_doc_write_docs(OdinDocWriter *w) {
 		}
 
 		doc_pkg.files = odin_write_slice(w, file_indices.data, file_indices.count);
+
+		OdinDocPkgIndexEntry index_entry = {};
+		index_entry.fullpath_hash = fnv32a(pkg->fullpath.text, pkg->fullpath.len);
+		index_entry.pkg           = pkg_index;
+		index_entry.first_entity  = cast(u32)w->entities.len;
 		doc_pkg.entries = odin_doc_add_pkg_entries(w, pkg);
+		index_entry.entity_count  = cast(u32)w->entities.len - index_entry.first_entity;
+		array_add(&pkg_index_entries, index_entry);
 
 		if (dst) {
 			*dst = doc_pkg;
@@ -1177,6 +1384,10 @@ gb_internal void odin_doc_write_docs(OdinDocWriter *w) {
 	}
 
 	odin_doc_update_entities(w);
+
+	array_sort(pkg_index_entries, odin_doc_pkg_index_entry_cmp);
+	w->pkg_index = odin_write_slice(w, pkg_index_entries.data, pkg_index_entries.count);
+	odin_doc_write_sections(w);
 }
 
 
@@ -1208,6 +1419,7 @@ gb_internal void odin_doc_write(CheckerInfo *info, char const *filename) {
 	debugf("odin_doc_write %s\n", filename);
 
 	odin_doc_writer_prepare(w);
+	odin_doc_render_package_strings(w);
 	odin_doc_write_docs(w);
 
 	odin_doc_writer_start_writing(w);
@@ -75,6 +75,7 @@ enum EntityFlag : u64 {
 	EntityFlag_Init          = 1ull<<31,
 	EntityFlag_Subtype       = 1ull<<32,
 	EntityFlag_Fini          = 1ull<<33,
+	EntityFlag_Benchmark     = 1ull<<34,
 	
 	EntityFlag_CustomLinkName = 1ull<<40,
 	EntityFlag_CustomLinkage_Internal = 1ull<<41,
@@ -158,6 +159,19 @@ gb_internal TypeNameObjCMetadata *create_type_name_obj_c_metadata() {
 	return md;
 }
 
+// NOTE: The fields which only a few entities ever set are kept out of line, see `entity_cold`, so that
+// every other entity is smaller and more of them fit in the cache whilst checking
+struct EntityCold {
+	// TODO(bill): Cleanup how `using` works for entities
+	Entity *using_parent;
+	Ast *   using_expr;
+
+	Entity *aliased_of;
+
+	String  deprecated_message;
+	String  warning_message;
+};
+
 // An Entity is a named "thing" in the language
 struct Entity {
 	EntityKind  kind;
@@ -178,18 +192,12 @@ struct Entity {
 	AstFile *   file;
 	AstPackage *pkg;
 
-	// TODO(bill): Cleanup how `using` works for entities
-	Entity *    using_parent;
-	Ast *       using_expr;
-
-	Entity *    aliased_of;
+	std::atomic<EntityCold *> cold; // nullptr until one of its fields is set
 
 	std::atomic<struct lbModule *> code_gen_module;
 	std::atomic<struct lbProcedure *> code_gen_procedure;
 
 	u64         order_in_src;
-	String      deprecated_message;
-	String      warning_message;
 
 	// IMPORTANT NOTE(bill): This must be a discriminated union because of patching
 	// later entity kinds
@@ -257,8 +265,10 @@ struct Entity {
 			struct GenProcsData *gen_procs;
 			BlockingMutex gen_procs_mutex;
 			ProcedureOptimizationMode optimization_mode;
+			String  target_clones;
 
 			u64     fast_math_flags;
+			i64     max_stack_usage; // see `has_max_stack_usage`
 
 			bool    is_foreign                 : 1;
 			bool    is_export                  : 1;
@@ -273,9 +283,13 @@ struct Entity {
 			bool    no_sanitize_thread         : 1;
 			bool    is_objc_impl_or_import     : 1;
 			bool    is_objc_class_method       : 1;
+			bool    has_max_stack_usage        : 1;
 		} Procedure;
 		struct {
 			Array<Entity *> entities;
+			// NOTE: members whose first parameter only accepts arguments of exactly that type,
+			// used to skip candidates cheaply during overload resolution
+			PtrMap<Entity *, Type *> exact_first_params;
 		} ProcGroup;
 		struct {
 			i32 id;
@@ -302,6 +316,27 @@ struct Entity {
 	};
 };
 
+gb_global EntityCold const entity_cold_empty = {};
+
+// NOTE: Returns the cold fields of the entity for reading, which are all empty if none were ever set
+gb_internal EntityCold const *entity_cold_get(Entity *e) {
+	EntityCold *cold = e->cold.load(std::memory_order_acquire);
+	return cold ? cold : &entity_cold_empty;
+}
+
+// NOTE: Returns the cold fields of the entity for writing, allocating them on first use
+gb_internal EntityCold *entity_cold(Entity *e) {
+	EntityCold *cold = e->cold.load(std::memory_order_acquire);
+	if (cold == nullptr) {
+		EntityCold *new_cold = permanent_alloc_item<EntityCold>();
+		memory_account(MemorySubsystem_Entities, gb_size_of(EntityCold));
+		if (e->cold.compare_exchange_strong(cold, new_cold, std::memory_order_acq_rel)) {
+			cold = new_cold;
+		}
+	}
+	return cold;
+}
+
 gb_internal InternedString entity_interned_name(Entity *entity) {
 	auto name = entity->interned_name.load();
 	if (name.value == 0) {
@@ -356,6 +391,121 @@ gb_internal bool entity_has_deferred_procedure(Entity *e) {
 
 gb_global std::atomic<u64> global_entity_id;
 
+// NOTE: Maps the id of every entity back to the entity, which lets sets of entities be stored as
+// 32-bit ids, see `EntitySet`. The chunks are allocated as the ids are handed out
+enum : u64 {
+	ENTITY_TABLE_CHUNK_SHIFT = 16,
+	ENTITY_TABLE_CHUNK_SIZE  = 1ull<<ENTITY_TABLE_CHUNK_SHIFT,
+	ENTITY_TABLE_CHUNK_COUNT = 1ull<<14,
+};
+gb_global std::atomic<Entity **> global_entity_table[ENTITY_TABLE_CHUNK_COUNT];
+
+gb_internal void entity_table_add(Entity *e) {
+	u64 chunk_index = e->id >> ENTITY_TABLE_CHUNK_SHIFT;
+	GB_ASSERT_MSG(chunk_index < ENTITY_TABLE_CHUNK_COUNT, "Too many entities");
+
+	std::atomic<Entity **> *slot = &global_entity_table[chunk_index];
+	Entity **chunk = slot->load(std::memory_order_acquire);
+	if (chunk == nullptr) {
+		Entity **new_chunk = gb_alloc_array(heap_allocator(), Entity *, ENTITY_TABLE_CHUNK_SIZE);
+		if (slot->compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel)) {
+			chunk = new_chunk;
+		} else {
+			gb_free(heap_allocator(), new_chunk);
+		}
+	}
+	chunk[e->id & (ENTITY_TABLE_CHUNK_SIZE-1)] = e;
+}
+
+gb_internal Entity *entity_from_id(u32 id) {
+	Entity **chunk = global_entity_table[id >> ENTITY_TABLE_CHUNK_SHIFT].load(std::memory_order_acquire);
+	return chunk[id & (ENTITY_TABLE_CHUNK_SIZE-1)];
+}
+
+gb_internal gb_inline u32 scope_map_slot_id(Entity *e) {
+	return e ? cast(u32)e->id : 0;
+}
+
+
+gb_internal gb_inline u32 entity_set_hash(u32 id) {
+	id ^= id >> 16;
+	id *= 0x7feb352dU;
+	id ^= id >> 15;
+	id *= 0x846ca68bU;
+	id ^= id >> 16;
+	return id;
+}
+
+gb_internal void entity_set__insert(EntitySet *s, u32 id) {
+	u32 mask = s->capacity-1;
+	u32 hash_index = entity_set_hash(id) & mask;
+	while (s->keys[hash_index] != 0) {
+		hash_index = (hash_index+1)&mask;
+	}
+	s->keys[hash_index] = id;
+	s->count++;
+}
+
+gb_internal void entity_set_grow(EntitySet *s) {
+	u32 *old_keys = s->keys;
+	u32 old_capacity = s->capacity;
+
+	if (old_capacity == 0) {
+		s->keys = s->inline_keys;
+		s->capacity = ENTITY_SET_INLINE_CAP;
+	} else {
+		s->capacity = old_capacity<<1;
+		s->keys = gb_alloc_array(permanent_allocator(), u32, s->capacity);
+	}
+	gb_zero_size(s->keys, gb_size_of(u32)*s->capacity);
+
+	s->count = 0;
+	for (u32 i = 0; i < old_capacity; i++) {
+		if (old_keys[i] != 0) {
+			entity_set__insert(s, old_keys[i]);
+		}
+	}
+}
+
+gb_internal bool entity_set_update(EntitySet *s, Entity *e) {
+	GB_ASSERT(e != nullptr);
+	u32 id = cast(u32)e->id;
+	if (s->count != 0) {
+		u32 mask = s->capacity-1;
+		u32 hash_index = entity_set_hash(id) & mask;
+		for (;;) {
+			u32 key = s->keys[hash_index];
+			if (key == id) {
+				return true;
+			} else if (key == 0) {
+				break;
+			}
+			hash_index = (hash_index+1)&mask;
+		}
+	}
+
+	if (s->count >= s->capacity - (s->capacity>>2)) {
+		entity_set_grow(s);
+	}
+	entity_set__insert(s, id);
+	return false;
+}
+
+gb_internal void entity_set_add(EntitySet *s, Entity *e) {
+	entity_set_update(s, e);
+}
+
+gb_internal EntitySetIterator begin(EntitySet &set) noexcept {
+	u32 index = 0;
+	while (index < set.capacity && set.keys[index] == 0) {
+		index++;
+	}
+	return EntitySetIterator{&set, index};
+}
+gb_internal EntitySetIterator end(EntitySet &set) noexcept {
+	return EntitySetIterator{&set, set.capacity};
+}
+
 // NOTE(bill): This exists to allow for bulk allocations of entities all at once to improve performance for type generation
 #define INTERNAL_ENTITY_INIT(e_, kind_, scope_, token_, type_) do {                  \
 	(e_)->kind   = (kind_);                                                      \
@@ -364,6 +514,7 @@ gb_global std::atomic<u64> global_entity_id;
 	(e_)->token  = (token_);                                                     \
 	(e_)->type   = (type_);                                                      \
 	(e_)->id     = 1 + global_entity_id.fetch_add(1);                            \
+	entity_table_add((e_));                                                      \
 	if ((token_).pos.file_id) {                                                  \
 		e_->file = thread_unsafe_get_ast_file_from_id((token_).pos.file_id); \
 	}                                                                            \
@@ -372,6 +523,7 @@ gb_global std::atomic<u64> global_entity_id;
 
 gb_internal Entity *alloc_entity(EntityKind kind, Scope *scope, Token token, Type *type) {
 	Entity *entity = permanent_alloc_item<Entity>();
+	memory_account(MemorySubsystem_Entities, gb_size_of(Entity));
 	INTERNAL_ENTITY_INIT(entity, kind, scope, token, type);
 	entity_interned_name(entity);
 	return entity;
@@ -387,9 +539,10 @@ gb_internal Entity *alloc_entity_using_variable(Entity *parent, Token token, Typ
 	GB_ASSERT(parent != nullptr);
 	token.pos = parent->token.pos;
 	Entity *entity = alloc_entity(Entity_Variable, parent->scope, token, type);
-	entity->using_parent = parent;
+	EntityCold *cold = entity_cold(entity);
+	cold->using_parent = parent;
+	cold->using_expr = using_expr;
 	entity->parent_proc_decl.store(parent->parent_proc_decl, std::memory_order_relaxed);
-	entity->using_expr = using_expr;
 	entity->flags |= EntityFlag_Using;
 	entity->flags |= EntityFlag_Used;
 	entity->state = EntityState_Resolved;
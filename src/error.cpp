@@ -11,53 +11,97 @@ struct ErrorValue {
 	bool           seen_newline;
 };
 
+// NOTE: Each thread formats its errors into its own state and buffer, so reporting never serializes the
+// checker threads. The buffers are only merged (and sorted) once, in `print_all_errors`; the buffer's
+// mutex is therefore uncontended apart from then.
+struct ErrorThreadState {
+	ErrorValue         curr_error_value;
+	bool               curr_error_value_set;
+	bool               in_block;
+
+	BlockingMutex      mutex;
+	Array<ErrorValue>  error_values;
+
+	ErrorThreadState * next;
+};
+
 struct ErrorCollector {
 	// TokenPos prev; // no point collecting because of the mulithreaded nature
 	std::atomic<i64>  count;
 	std::atomic<i64>  warning_count;
-	std::atomic<bool> in_block;
 
-	RecursiveMutex    mutex;
+	BlockingMutex     mutex; // only used to merge the thread buffers
 	BlockingMutex     path_mutex;
 
-	Array<ErrorValue> error_values;
-	ErrorValue        curr_error_value;
-	std::atomic<bool> curr_error_value_set;
+	std::atomic<ErrorThreadState *> thread_states;
+
+	Array<ErrorValue> error_values; // merged and sorted
 };
 
 gb_global ErrorCollector global_error_collector;
 
+gb_global gb_thread_local ErrorThreadState *error_thread_state_;
+
+gb_internal ErrorThreadState *error_thread_state(void) {
+	ErrorThreadState *ts = error_thread_state_;
+	if (ts == nullptr) {
+		ts = gb_alloc_item(heap_allocator(), ErrorThreadState);
+		array_init(&ts->error_values, heap_allocator());
+
+		ErrorThreadState *head = global_error_collector.thread_states.load(std::memory_order_relaxed);
+		do {
+			ts->next = head;
+		} while (!global_error_collector.thread_states.compare_exchange_weak(head, ts));
+
+		error_thread_state_ = ts;
+	}
+	return ts;
+}
+
 
 gb_internal void push_error_value(TokenPos const &pos, ErrorValueKind kind = ErrorValue_Error) {
-	GB_ASSERT_MSG(global_error_collector.curr_error_value_set.load() == false, "Possible race condition in error handling system, please report this with an issue");
+	ErrorThreadState *ts = error_thread_state();
+	GB_ASSERT_MSG(ts->curr_error_value_set == false, "Possible race condition in error handling system, please report this with an issue");
 	ErrorValue ev = {kind, pos};
 	ev.msg.allocator = heap_allocator();
 
-	global_error_collector.curr_error_value = ev;
-	global_error_collector.curr_error_value_set.store(true);
+	ts->curr_error_value = ev;
+	ts->curr_error_value_set = true;
 }
 
 gb_internal void pop_error_value(void) {
-	mutex_lock(&global_error_collector.mutex);
-	if (global_error_collector.curr_error_value_set.load()) {
-		array_add(&global_error_collector.error_values, global_error_collector.curr_error_value);
-
-		global_error_collector.curr_error_value = {};
-		global_error_collector.curr_error_value_set.store(false);
+	ErrorThreadState *ts = error_thread_state();
+	if (ts->curr_error_value_set) {
+		mutex_lock(&ts->mutex);
+		array_add(&ts->error_values, ts->curr_error_value);
+		mutex_unlock(&ts->mutex);
+
+		ts->curr_error_value = {};
+		ts->curr_error_value_set = false;
 	}
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 
 gb_internal void try_pop_error_value(void) {
-	if (!global_error_collector.in_block.load()) {
+	if (!error_thread_state()->in_block) {
 		pop_error_value();
 	}
 }
 
 gb_internal ErrorValue *get_error_value(void) {
-	GB_ASSERT_MSG(global_error_collector.curr_error_value_set.load() == true, "Possible race condition in error handling system, please report this with an issue");
-	return &global_error_collector.curr_error_value;
+	ErrorThreadState *ts = error_thread_state();
+	GB_ASSERT_MSG(ts->curr_error_value_set == true, "Possible race condition in error handling system, please report this with an issue");
+	return &ts->curr_error_value;
+}
+
+// NOTE: Moves every thread's reported errors into `global_error_collector.error_values`
+gb_internal void merge_error_thread_buffers(void) {
+	for (ErrorThreadState *ts = global_error_collector.thread_states.load(); ts != nullptr; ts = ts->next) {
+		mutex_lock(&ts->mutex);
+		array_add_elems(&global_error_collector.error_values, ts->error_values.data, ts->error_values.count);
+		array_clear(&ts->error_values);
+		mutex_unlock(&ts->mutex);
+	}
 }
 
 
@@ -212,14 +256,12 @@ gb_internal ERROR_OUT_PROC(default_error_out_va) {
 gb_global ErrorOutProc *error_out_va = default_error_out_va;
 
 gb_internal void begin_error_block(void) {
-	mutex_lock(&global_error_collector.mutex);
-	global_error_collector.in_block.store(true);
+	error_thread_state()->in_block = true;
 }
 
 gb_internal void end_error_block(void) {
 	pop_error_value();
-	global_error_collector.in_block.store(false);
-	mutex_unlock(&global_error_collector.mutex);
+	error_thread_state()->in_block = false;
 }
 
 #define ERROR_BLOCK() begin_error_block(); defer (end_error_block())
@@ -534,7 +576,6 @@ gb_internal void error_out_coloured(char const *str, TerminalStyle style, Termin
 
 gb_internal void error_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
 	global_error_collector.count.fetch_add(1);
-	mutex_lock(&global_error_collector.mutex);
 	if (global_error_collector.count > MAX_ERROR_COLLECTOR_COUNT()) {
 		print_all_errors();
 		gb_exit(1);
@@ -559,7 +600,6 @@ gb_internal void error_va(TokenPos const &pos, TokenPos end, char const *fmt, va
 		show_error_on_line(pos, end);
 	}
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 gb_internal void warning_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
@@ -572,7 +612,6 @@ gb_internal void warning_va(TokenPos const &pos, TokenPos end, char const *fmt,
 	}
 
 	global_error_collector.warning_count.fetch_add(1);
-	mutex_lock(&global_error_collector.mutex);
 
 	push_error_value(pos, ErrorValue_Warning);
 
@@ -594,7 +633,6 @@ gb_internal void warning_va(TokenPos const &pos, TokenPos end, char const *fmt,
 		show_error_on_line(pos, end);
 	}
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 
@@ -604,7 +642,6 @@ gb_internal void error_line_va(char const *fmt, va_list va) {
 
 gb_internal void error_no_newline_va(TokenPos const &pos, char const *fmt, va_list va) {
 	global_error_collector.count.fetch_add(1);
-	mutex_lock(&global_error_collector.mutex);
 	if (global_error_collector.count.load() > MAX_ERROR_COLLECTOR_COUNT()) {
 		print_all_errors();
 		gb_exit(1);
@@ -630,13 +667,18 @@ gb_internal void error_no_newline_va(TokenPos const &pos, char const *fmt, va_li
 	}
 
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 
+// NOTE: Set by the parser of a file once it finds an invalid token, which fails the whole file. Every
+// syntax error of that file from then on only follows from the parser seeing the file end early.
+gb_global gb_thread_local i32 syntax_errors_muted_file_id;
+
 gb_internal void syntax_error_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
+	if (pos.file_id != 0 && pos.file_id == syntax_errors_muted_file_id) {
+		return;
+	}
 	global_error_collector.count.fetch_add(1);
-	mutex_lock(&global_error_collector.mutex);
 	if (global_error_collector.count > MAX_ERROR_COLLECTOR_COUNT()) {
 		print_all_errors();
 		gb_exit(1);
@@ -663,12 +705,13 @@ gb_internal void syntax_error_va(TokenPos const &pos, TokenPos end, char const *
 	}
 
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 gb_internal void syntax_error_with_verbose_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
+	if (pos.file_id != 0 && pos.file_id == syntax_errors_muted_file_id) {
+		return;
+	}
 	global_error_collector.count.fetch_add(1);
-	mutex_lock(&global_error_collector.mutex);
 	if (global_error_collector.count > MAX_ERROR_COLLECTOR_COUNT()) {
 		print_all_errors();
 		gb_exit(1);
@@ -697,11 +740,13 @@ gb_internal void syntax_error_with_verbose_va(TokenPos const &pos, TokenPos end,
 	}
 
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 
 gb_internal void syntax_warning_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
+	if (pos.file_id != 0 && pos.file_id == syntax_errors_muted_file_id) {
+		return;
+	}
 	if (global_warnings_as_errors()) {
 		syntax_error_va(pos, end, fmt, va);
 		return;
@@ -709,7 +754,6 @@ gb_internal void syntax_warning_va(TokenPos const &pos, TokenPos end, char const
 	if (global_ignore_warnings()) {
 		return;
 	}
-	mutex_lock(&global_error_collector.mutex);
 	global_error_collector.warning_count++;
 
 
@@ -734,7 +778,6 @@ gb_internal void syntax_warning_va(TokenPos const &pos, TokenPos end, char const
 	}
 
 	try_pop_error_value();
-	mutex_unlock(&global_error_collector.mutex);
 }
 
 
@@ -828,7 +871,16 @@ gb_internal void exit_with_errors(void) {
 gb_internal int error_value_cmp(void const *a, void const *b) {
 	ErrorValue *x = cast(ErrorValue *)a;
 	ErrorValue *y = cast(ErrorValue *)b;
-	return token_pos_cmp(x->pos, y->pos);
+	int cmp = token_pos_cmp(x->pos, y->pos);
+	if (cmp != 0) {
+		return cmp;
+	}
+	// NOTE: Errors at the same position may come from different threads, order them by their contents
+	// so that the output does not depend on the scheduling
+	if (x->kind != y->kind) {
+		return x->kind < y->kind ? -1 : +1;
+	}
+	return string_compare(String{x->msg.data, x->msg.count}, String{y->msg.data, y->msg.count});
 }
 
 gb_global String error_article_table[][2] = {
@@ -863,6 +915,11 @@ gb_internal String error_article(String context_name) {
 gb_internal bool errors_already_printed = false;
 
 gb_internal void print_all_errors(void) {
+	mutex_lock(&global_error_collector.mutex);
+	defer (mutex_unlock(&global_error_collector.mutex));
+
+	merge_error_thread_buffers();
+
 	if (errors_already_printed) {
 		if (global_error_collector.warning_count.load() == global_error_collector.error_values.count) {
 			for (ErrorValue &ev : global_error_collector.error_values) {
@@ -129,6 +129,41 @@ gb_internal ExactValue exact_value_bool(bool b) {
 	return result;
 }
 
+// NOTE: The buffer of the last constant string concatenation on this thread. Nothing can refer to the
+// bytes past the end of its result, so when the left operand of the next `+` is that result, which is
+// the case for every step of `"a" + b + c + ...`, the right operand is appended in place. An n-term
+// concatenation then copies O(n) bytes rather than O(n^2), and the buffers it leaves in the permanent
+// arena add up to at most twice the size of the final string.
+struct ExactValueStringBuffer {
+	u8 *  data;
+	isize len;
+	isize cap;
+};
+
+gb_global gb_thread_local ExactValueStringBuffer exact_value_string_buffer;
+
+gb_internal void *exact_value_concat_string_bytes(void const *x, isize x_size, void const *y, isize y_size) {
+	ExactValueStringBuffer *buf = &exact_value_string_buffer;
+	isize size = x_size+y_size;
+	if (x_size > 0 && x == buf->data && x_size == buf->len && size <= buf->cap) {
+		gb_memmove(buf->data+x_size, y, y_size);
+		buf->len = size;
+		return buf->data;
+	}
+
+	isize cap = gb_max(size, 64);
+	if (x_size > 0 && x == buf->data && x_size == buf->len) {
+		cap = gb_max(cap, 2*size); // NOTE: a chain which outgrew its buffer
+	}
+	u8 *data = gb_alloc_array(permanent_allocator(), u8, cap);
+	gb_memmove(data,        x, x_size);
+	gb_memmove(data+x_size, y, y_size);
+	buf->data = data;
+	buf->len  = size;
+	buf->cap  = cap;
+	return data;
+}
+
 gb_internal ExactValue exact_value_string(String string) {
 	ExactValue result = {ExactValue_String};
 	result.value_string = string;
@@ -198,7 +233,52 @@ gb_internal ExactValue exact_value_typeid(Type *type) {
 }
 
 
+// NOTE: Handles the common case of a literal which fits within a u64 (e.g. any of up to 19 decimal
+// digits) without going through the arbitrary precision digit by digit multiply and add
+gb_internal bool u64_from_integer_literal_fast(String const &string, u64 *value_) {
+	u64 base = 10;
+	isize i = 0;
+	if (string.len > 2 && string[0] == '0') {
+		switch (string[1]) {
+		case 'b': base = 2;  i = 2; break;
+		case 'o': base = 8;  i = 2; break;
+		case 'd': base = 10; i = 2; break;
+		case 'z': base = 12; i = 2; break;
+		case 'x': base = 16; i = 2; break;
+		case 'h': base = 16; i = 2; break;
+		}
+	}
+
+	u64 value = 0;
+	isize digit_count = 0;
+	for (; i < string.len; i++) {
+		Rune r = cast(Rune)string[i];
+		if (r == '_') {
+			continue;
+		}
+		u64 v = u64_digit_value(r);
+		if (v >= base) {
+			return false; // e.g. an exponent or a sign, leave it to the slow path
+		}
+		if (value > (U64_MAX - v)/base) {
+			return false;
+		}
+		value = value*base + v;
+		digit_count += 1;
+	}
+	if (digit_count == 0) {
+		return false;
+	}
+	*value_ = value;
+	return true;
+}
+
 gb_internal ExactValue exact_value_integer_from_string(String const &string) {
+	u64 fast_value = 0;
+	if (u64_from_integer_literal_fast(string, &fast_value)) {
+		return exact_value_u64(fast_value);
+	}
+
 	ExactValue result = {ExactValue_Integer};
 	result.value_integer = {0};
 	bool success;
@@ -211,7 +291,133 @@ gb_internal ExactValue exact_value_integer_from_string(String const &string) {
 
 
 
+// NOTE: Clinger's fast path: when the decimal significand fits within the 53 bits of an f64 and the
+// power of ten is exactly representable, a single multiplication or division is correctly rounded.
+// This covers the vast majority of float literals, anything else goes through `strtod`.
+gb_internal bool float_from_string_fast(String const &string, f64 *value_) {
+	gb_local_persist f64 const pow10[] = {
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+	u64 const MAX_EXACT_INTEGER = 1ull<<53;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+	// NOTE: Extended precision intermediates (e.g. x87) would round twice
+	return false;
+#endif
+
+	u64 mantissa = 0;
+	isize digit_count = 0; // significant digits, leading zeros are not counted
+	i64 exp10 = 0;
+	bool seen_digit = false;
+
+	isize i = 0;
+	for (bool in_fraction = false; i < string.len; i++) {
+		u8 c = string[i];
+		if (c == '_') {
+			continue;
+		}
+		if (c == '.') {
+			if (in_fraction) {
+				return false;
+			}
+			in_fraction = true;
+			continue;
+		}
+		if (c < '0' || c > '9') {
+			break;
+		}
+		seen_digit = true;
+		if (mantissa == 0 && c == '0') {
+			if (in_fraction) {
+				exp10 -= 1;
+			}
+			continue;
+		}
+		if (digit_count == 19) {
+			return false;
+		}
+		mantissa = mantissa*10 + (c - '0');
+		digit_count += 1;
+		if (in_fraction) {
+			exp10 -= 1;
+		}
+	}
+	if (!seen_digit) {
+		return false;
+	}
+
+	if (i < string.len && (string[i] == 'e' || string[i] == 'E')) {
+		i += 1;
+		bool negative = false;
+		if (i < string.len && (string[i] == '+' || string[i] == '-')) {
+			negative = string[i] == '-';
+			i += 1;
+		}
+		i64 exp = 0;
+		isize exp_digits = 0;
+		for (; i < string.len; i++) {
+			u8 c = string[i];
+			if (c == '_') {
+				continue;
+			}
+			if (c < '0' || c > '9') {
+				return false;
+			}
+			if (exp < 10000) {
+				exp = exp*10 + (c - '0');
+			}
+			exp_digits += 1;
+		}
+		if (exp_digits == 0) {
+			return false;
+		}
+		exp10 += negative ? -exp : exp;
+	}
+	if (i != string.len) {
+		return false;
+	}
+
+	if (mantissa == 0) {
+		*value_ = 0.0;
+		return true;
+	}
+	if (mantissa > MAX_EXACT_INTEGER) {
+		return false;
+	}
+
+	if (exp10 > 22 && exp10 <= 22+15) {
+		// NOTE: Move the excess of the power into the significand while it can still be exact
+		for (; exp10 > 22; exp10--) {
+			if (mantissa > MAX_EXACT_INTEGER/10) {
+				return false;
+			}
+			mantissa *= 10;
+		}
+	}
+	if (exp10 < -22 || exp10 > 22) {
+		return false;
+	}
+
+	f64 f = cast(f64)mantissa;
+	if (exp10 < 0) {
+		f /= pow10[-exp10];
+	} else {
+		f *= pow10[exp10];
+	}
+	*value_ = f;
+	return true;
+}
+
 gb_internal f64 float_from_string(String const &string, bool *success = nullptr) {
+	f64 fast_value = 0;
+	if (float_from_string_fast(string, &fast_value)) {
+		if (success != nullptr) {
+			*success = true;
+		}
+		return fast_value;
+	}
+
 	if (string.len < 128) {
 		char buf[128] = {};
 		isize n = 0;
@@ -788,6 +994,44 @@ gb_internal ExactValue exact_binary_operator_value(TokenKind op, ExactValue x, E
 	case ExactValue_Integer: {
 		BigInt const *a = &x.value_integer;
 		BigInt const *b = &y.value_integer;
+
+		i64 sa = 0;
+		i64 sb = 0;
+		if (big_int_get_small(a, &sa) && big_int_get_small(b, &sb)) {
+			// NOTE: Both values are below 2^MP_DIGIT_BIT in magnitude, so addition and subtraction
+			// cannot overflow an i64, anything else that might falls through to the BigInt path
+			switch (op) {
+			case Token_Add: return exact_value_i64(sa + sb);
+			case Token_Sub: return exact_value_i64(sa - sb);
+			case Token_Mul: {
+				u64 ua = cast(u64)(sa < 0 ? -sa : sa);
+				u64 ub = cast(u64)(sb < 0 ? -sb : sb);
+				if (ua == 0 || ub <= cast(u64)I64_MAX / ua) {
+					return exact_value_i64(sa * sb);
+				}
+				break;
+			}
+			case Token_QuoEq:
+				if (sb != 0) return exact_value_i64(sa / sb);
+				break;
+			case Token_Mod:
+				if (sb != 0) return exact_value_i64(sa % sb);
+				break;
+			case Token_ModMod:
+				if (sb != 0) return exact_value_i64(((sa % sb) + sb) % sb);
+				break;
+			case Token_And:
+			case Token_Or:
+			case Token_Xor:
+				if (sa >= 0 && sb >= 0) {
+					if (op == Token_And) return exact_value_i64(sa & sb);
+					if (op == Token_Or)  return exact_value_i64(sa | sb);
+					return exact_value_i64(sa ^ sb);
+				}
+				break;
+			}
+		}
+
 		BigInt c = {};
 		switch (op) {
 		case Token_Add:    big_int_add(&c, a, b); break;
@@ -909,26 +1153,19 @@ gb_internal ExactValue exact_binary_operator_value(TokenKind op, ExactValue x, E
 	case ExactValue_String: {
 		if (op != Token_Add) goto error;
 
-		// NOTE(bill): How do you minimize this over allocation?
 		String sx = x.value_string;
 		String sy = y.value_string;
-		isize len = sx.len+sy.len;
-		u8 *data = gb_alloc_array(permanent_allocator(), u8, len);
-		gb_memmove(data,        sx.text, sx.len);
-		gb_memmove(data+sx.len, sy.text, sy.len);
-		return exact_value_string(make_string(data, len));
+		u8 *data = cast(u8 *)exact_value_concat_string_bytes(sx.text, sx.len, sy.text, sy.len);
+		return exact_value_string(make_string(data, sx.len+sy.len));
 	}
 	case ExactValue_String16: {
 		if (op != Token_Add) goto error;
 
-		// NOTE(bill): How do you minimize this over allocation?
 		String16 sx = x.value_string16;
 		String16 sy = y.value_string16;
-		isize len = sx.len+sy.len;
-		u16 *data = gb_alloc_array(permanent_allocator(), u16, len);
-		gb_memmove(data,        sx.text, sx.len*gb_size_of(u16));
-		gb_memmove(data+sx.len, sy.text, sy.len*gb_size_of(u16));
-		return exact_value_string16(make_string16(data, len));
+		isize elem_size = gb_size_of(u16);
+		u16 *data = cast(u16 *)exact_value_concat_string_bytes(sx.text, sx.len*elem_size, sy.text, sy.len*elem_size);
+		return exact_value_string16(make_string16(data, sx.len+sy.len));
 	}
 	}
 
@@ -8,6 +8,9 @@ struct LinkerData {
 	String   output_base;
 	String   output_name;
 	bool     needs_system_library_linked;
+
+	StringMap<struct LinkerForeignAsm *> foreign_asm_files;
+	bool foreign_asm_queued;
 };
 
 gb_internal i32 system_exec_command_line_app(char const *name, char const *fmt, ...);
@@ -18,12 +21,93 @@ gb_internal void linker_enable_system_library_linking(LinkerData *ld) {
 	ld->needs_system_library_linked = true;
 }
 
+// NOTE: Persistent ThinLTO cache, the linker prunes it itself
+gb_internal String linker_thin_lto_cache_dir(void) {
+	if (build_context.lto_kind != LTO_Thin && build_context.lto_kind != LTO_Thin_Files) {
+		return {};
+	}
+	String dir = build_context.build_paths[BuildPath_Output].basename;
+	dir = concatenate_strings(permanent_allocator(), dir, str_lit("/.odin-cache"));
+	(void)check_if_exists_directory_otherwise_create(dir);
+	dir = concatenate_strings(permanent_allocator(), dir, str_lit("/thinlto"));
+	if (!check_if_exists_directory_otherwise_create(dir)) {
+		return {};
+	}
+	return dir;
+}
+
+// NOTE: Windows limits a command line to 32 KiB, so well before that the object files are
+// passed through a response file instead, which every supported linker (and clang) accepts
+#define LINKER_RESPONSE_FILE_THRESHOLD (8<<10)
+
+gb_internal gbString linker_object_files_argument(LinkerData *ld, String const &output_filename, gbString object_files) {
+	if (gb_string_length(object_files) < LINKER_RESPONSE_FILE_THRESHOLD) {
+		return object_files;
+	}
+
+	gbString rsp_path = gb_string_make(heap_allocator(), "");
+	rsp_path = gb_string_append_fmt(rsp_path, "%.*s.rsp", LIT(output_filename));
+
+	gbFile f = {};
+	if (gb_file_create(&f, rsp_path) != gbFileError_None) {
+		gb_string_free(rsp_path);
+		return object_files;
+	}
+	gb_file_write(&f, object_files, gb_string_length(object_files));
+	gb_file_close(&f);
+
+	array_add(&ld->output_temp_paths, make_string_c(rsp_path));
+
+	gb_string_clear(object_files);
+	return gb_string_append_fmt(object_files, "\"@%s\" ", rsp_path);
+}
+
+gb_internal bool linker_target_is_elf(void) {
+	switch (build_context.metrics.os) {
+	case TargetOs_linux:
+	case TargetOs_freebsd:
+	case TargetOs_openbsd:
+	case TargetOs_netbsd:
+		return !is_arch_wasm();
+	}
+	return false;
+}
+
+// NOTE: Release builds place every procedure and global in its own section on ELF targets, so that
+// the linker can remove the unreferenced ones and fold identical procedures
+gb_internal bool linker_uses_dead_section_elimination(void) {
+	if (build_context.optimization_level < 1) {
+		return false;
+	}
+	switch (build_context.build_mode) {
+	case BuildMode_Executable:
+	case BuildMode_DynamicLibrary:
+		return linker_target_is_elf();
+	}
+	return false;
+}
+
+// NOTE: -post-link-optimize needs every procedure in its own section even when nothing is removed,
+// so that a post-link optimizer such as BOLT can move them around
+gb_internal bool linker_uses_function_sections(void) {
+	return linker_uses_dead_section_elimination() || build_context.post_link_optimize;
+}
+
+// NOTE: lld and mold link in parallel, so give them the same thread budget as the rest of the compiler
+gb_internal bool linker_should_pass_thread_count(void) {
+	if (build_context.thread_count <= 1) {
+		return false;
+	}
+	return !string_contains_string(build_context.extra_linker_flags, str_lit("thread"));
+}
+
 gb_internal void linker_data_init(LinkerData *ld, CheckerInfo *info, String const &init_fullpath) {
 	gbAllocator ha = heap_allocator();
 	array_init(&ld->output_object_paths, ha);
 	array_init(&ld->output_temp_paths,   ha);
 	array_init(&ld->foreign_libraries,   ha, 0, 1024);
 	ptr_set_init(&ld->foreign_libraries_set, 1024);
+	string_map_init(&ld->foreign_asm_files);
 
 	ld->needs_system_library_linked = false;
 
@@ -53,6 +137,247 @@ gb_internal void linker_data_init(LinkerData *ld, CheckerInfo *info, String cons
 
 }
 
+// NOTE: Assembly files passed to `foreign import` are assembled into `.odin-cache/asm`, named after
+// a hash of their contents and of the assembler command line (assembler, format, target and flags),
+// so an unchanged file is not assembled again. They are queued on the thread pool while LLVM emits
+// its object files, and `linker_stage` only waits for them.
+struct LinkerForeignAsm {
+	String asm_file;
+	String obj_file;
+	String dir;
+	bool   cached; // false when the cache directory could not be created, see `remove_temp_files`
+	i32    result;
+};
+
+gb_internal String linker_foreign_asm_key(String lib) {
+	lib = string_trim_whitespace(lib);
+#if defined(GB_SYSTEM_WINDOWS)
+	if (build_context.metrics.os == TargetOs_windows) {
+		// NOTE: the MSVC path of `linker_stage` lower cases the library paths
+		lib = copy_string(permanent_allocator(), lib);
+		string_to_lower(&lib);
+	}
+#endif
+	return lib;
+}
+
+gb_internal bool linker_foreign_asm_uses_system_nasm(void) {
+#if defined(GB_SYSTEM_WINDOWS)
+	if (build_context.metrics.os == TargetOs_windows) {
+		return false;
+	}
+#endif
+	return build_context.metrics.os != TargetOs_darwin &&
+	       build_context.metrics.arch != TargetArch_riscv64 &&
+	       build_context.metrics.arch != TargetArch_arm64;
+}
+
+// NOTE: Called with empty paths to get the part of the command line that the cache key depends on
+gb_internal gbString linker_foreign_asm_command(gbString cmd, String const &asm_file, String const &obj_file, char const **name_) {
+#if defined(GB_SYSTEM_WINDOWS)
+	if (build_context.metrics.os == TargetOs_windows) {
+		String obj_format = str_lit("win64");
+	#if defined(GB_ARCH_32_BIT)
+		obj_format = str_lit("win32");
+	#endif
+		*name_ = "nasm";
+		return gb_string_append_fmt(cmd,
+			"\"%.*s\\bin\\nasm\\windows\\nasm.exe\" \"%.*s\" "
+			"-f \"%.*s\" "
+			"-o \"%.*s\" "
+			"%.*s "
+			"",
+			LIT(build_context.ODIN_ROOT), LIT(asm_file),
+			LIT(obj_format),
+			LIT(obj_file),
+			LIT(build_context.extra_assembler_flags)
+		);
+	}
+#endif
+
+	bool is_osx = build_context.metrics.os == TargetOs_darwin;
+
+	if (build_context.metrics.arch == TargetArch_riscv64 || (!is_osx && build_context.metrics.arch == TargetArch_arm64)) {
+		char const *clang_path = gb_get_env("ODIN_CLANG_PATH", permanent_allocator());
+		if (clang_path == NULL) {
+			clang_path = "clang";
+		}
+		*name_ = "clang";
+		return gb_string_append_fmt(cmd,
+			"%s \"%.*s\" "
+			"-c -o \"%.*s\" "
+			"-target %.*s %s"
+			"%.*s "
+			"",
+			clang_path,
+			LIT(asm_file),
+			LIT(obj_file),
+			LIT(build_context.metrics.target_triplet),
+			build_context.metrics.arch == TargetArch_riscv64 ? "-march=rv64gc " : "",
+			LIT(build_context.extra_assembler_flags)
+		);
+	} else if (is_osx) {
+		// `as` comes with MacOS.
+		*name_ = "as";
+		return gb_string_append_fmt(cmd,
+			"as \"%.*s\" "
+			"-o \"%.*s\" "
+			"%.*s "
+			"",
+			LIT(asm_file),
+			LIT(obj_file),
+			LIT(build_context.extra_assembler_flags)
+		);
+	}
+
+	String obj_format;
+	if (build_context.metrics.ptr_size == 8) {
+		obj_format = str_lit("elf64");
+	} else {
+		GB_ASSERT(build_context.metrics.ptr_size == 4);
+		obj_format = str_lit("elf32");
+	}
+
+	// Note(bumbread): I'm assuming nasm is installed on the host machine.
+	// Shipping binaries on unix-likes gets into the weird territorry of
+	// "which version of glibc" is it linked with.
+	*name_ = "nasm";
+	return gb_string_append_fmt(cmd,
+		"nasm \"%.*s\" "
+		"-f \"%.*s\" "
+		"-o \"%.*s\" "
+		"%.*s "
+		"",
+		LIT(asm_file),
+		LIT(obj_format),
+		LIT(obj_file),
+		LIT(build_context.extra_assembler_flags)
+	);
+}
+
+gb_internal String linker_foreign_asm_cache_dir(void) {
+	String dir = build_context.build_paths[BuildPath_Output].basename;
+	dir = concatenate_strings(permanent_allocator(), dir, str_lit("/.odin-cache"));
+	(void)check_if_exists_directory_otherwise_create(dir);
+	dir = concatenate_strings(permanent_allocator(), dir, str_lit("/asm"));
+	(void)check_if_exists_directory_otherwise_create(dir);
+	if (!gb_file_exists(alloc_cstring(permanent_allocator(), dir))) {
+		return {};
+	}
+	return dir;
+}
+
+gb_internal WORKER_TASK_PROC(linker_foreign_asm_worker_proc) {
+	LinkerForeignAsm *fa = cast(LinkerForeignAsm *)data;
+	char const *name = nullptr;
+
+	gbString key = linker_foreign_asm_command(gb_string_make(heap_allocator(), ""), {}, {}, &name);
+	defer (gb_string_free(key));
+
+	char const *asm_file_c = alloc_cstring(heap_allocator(), fa->asm_file);
+	defer (gb_free(heap_allocator(), cast(void *)asm_file_c));
+
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, asm_file_c);
+	defer (gb_file_free_contents(&fc));
+	String source = make_string(cast(u8 *)fc.data, fc.size);
+
+	u64 hash = xxh64(key, gb_string_length(key));
+	hash = xxh64(source.text, source.len, hash);
+
+	// NOTE: included files are not part of the hash, so such a file is always assembled again
+	bool reuse = fc.data != nullptr && !string_contains_string(source, str_lit("include"));
+
+	String dir = fa->cached ? fa->dir : temporary_directory(temporary_allocator());
+	String filename = filename_without_directory(fa->asm_file);
+	char const *ext = build_context.metrics.os == TargetOs_windows ? "obj" : "o";
+
+	gbString obj = gb_string_make(heap_allocator(), "");
+	obj = gb_string_append_fmt(obj, "%.*s/%.*s-%016llx.%s", LIT(dir), LIT(filename), cast(unsigned long long)hash, ext);
+	fa->obj_file = make_string_c(obj);
+
+	if (fa->cached && reuse && gb_file_exists(obj)) {
+		debugf("Reusing assembled %.*s\n", LIT(fa->asm_file));
+		return 0;
+	}
+
+	// NOTE: assemble next to the cached object and move it in place afterwards, so that a failed
+	// or interrupted run never leaves behind an object which would be reused
+	gbString tmp = gb_string_make(heap_allocator(), obj);
+	tmp = gb_string_appendc(tmp, ".tmp");
+	defer (gb_string_free(tmp));
+
+	gbString cmd = linker_foreign_asm_command(gb_string_make(heap_allocator(), ""), fa->asm_file, make_string_c(tmp), &name);
+	defer (gb_string_free(cmd));
+
+	fa->result = system_exec_command_line_app(name, "%s", cmd);
+	if (fa->result) {
+		gb_file_remove(tmp);
+		if (linker_foreign_asm_uses_system_nasm()) {
+			gb_printf_err("executing `nasm` to assemble foreing import of %.*s failed.\n\tSuggestion: `nasm` does not ship with the compiler and should be installed with your system's package manager.\n", LIT(fa->asm_file));
+		}
+		return 0;
+	}
+
+	gb_file_remove(obj);
+	if (!gb_file_move(tmp, obj)) {
+		gb_printf_err("Failed to move the assembled object of %.*s to %s\n", LIT(fa->asm_file), obj);
+		fa->result = 1;
+	}
+	return 0;
+}
+
+// NOTE: Called once the foreign libraries are known, before the LLVM object files are emitted
+gb_internal void linker_queue_foreign_assembly(LinkerData *ld) {
+	if (ld->foreign_asm_queued) {
+		return;
+	}
+	ld->foreign_asm_queued = true;
+	if (is_arch_wasm()) {
+		return;
+	}
+
+	String dir = {};
+
+	for (Entity *e : ld->foreign_libraries) {
+		GB_ASSERT(e->kind == Entity_LibraryName);
+		for (String lib : e->LibraryName.paths) {
+			lib = string_trim_whitespace(lib);
+			if (lib.len == 0 || !has_asm_extension(lib)) {
+				continue;
+			}
+			String key = linker_foreign_asm_key(lib);
+			if (string_map_get(&ld->foreign_asm_files, key)) {
+				continue;
+			}
+			if (ld->foreign_asm_files.count == 0) {
+				dir = linker_foreign_asm_cache_dir();
+			}
+			LinkerForeignAsm *fa = permanent_alloc_item<LinkerForeignAsm>();
+			fa->asm_file = lib;
+			fa->dir      = dir;
+			fa->cached   = dir.len != 0;
+			string_map_set(&ld->foreign_asm_files, key, fa);
+			thread_pool_add_task(linker_foreign_asm_worker_proc, fa);
+		}
+	}
+}
+
+gb_internal bool linker_is_cached_foreign_asm_object(LinkerData *ld, String const &path) {
+	for (auto const &entry : ld->foreign_asm_files) {
+		LinkerForeignAsm *fa = entry.value;
+		if (fa->cached && fa->obj_file == path) {
+			return true;
+		}
+	}
+	return false;
+}
+
+gb_internal LinkerForeignAsm *linker_foreign_asm_object(LinkerData *ld, String const &lib) {
+	LinkerForeignAsm **found = string_map_get(&ld->foreign_asm_files, linker_foreign_asm_key(lib));
+	GB_ASSERT_MSG(found != nullptr, "%.*s was not assembled", LIT(lib));
+	return *found;
+}
+
 gb_internal i32 linker_stage(LinkerData *gen) {
 	i32 result = 0;
 	Timings *timings = &global_timings;
@@ -60,6 +385,12 @@ gb_internal i32 linker_stage(LinkerData *gen) {
 	String output_filename = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
 	debugf("Linking %.*s\n", LIT(output_filename));
 
+	linker_queue_foreign_assembly(gen);
+	if (gen->foreign_asm_files.count != 0) {
+		timings_start_section(timings, str_lit("assemble foreign imports"));
+		thread_pool_wait();
+	}
+
 	// TOOD(Jeroen): Make a `build_paths[BuildPath_Object] to avoid `%.*s.o`.
 
 	if (is_arch_wasm()) {
@@ -72,6 +403,10 @@ gb_internal i32 linker_stage(LinkerData *gen) {
 		gbString inputs = gb_string_make(temporary_allocator(), "");
 		inputs = gb_string_append_fmt(inputs, "\"%.*s.o\"", LIT(output_filename));
 
+		// NOTE: an object file imported by multiple packages would otherwise define its symbols twice
+		StringSet input_set = {};
+		string_set_init(&input_set, 64);
+		defer (string_set_destroy(&input_set));
 
 		for (Entity *e : gen->foreign_libraries) {
 			GB_ASSERT(e->kind == Entity_LibraryName);
@@ -91,6 +426,9 @@ gb_internal i32 linker_stage(LinkerData *gen) {
 				if (!string_ends_with(lib, str_lit(".o"))) {
 					continue;
 				}
+				if (string_set_update(&input_set, lib)) {
+					continue;
+				}
 
 				inputs = gb_string_append_fmt(inputs, " \"%.*s\"", LIT(lib));
 			}
@@ -128,6 +466,23 @@ gb_internal i32 linker_stage(LinkerData *gen) {
 			lib_str,
 			extra_orca_flags);
 	#endif
+
+		if (result == 0 && build_context.wasm_opt) {
+			timings_start_section(timings, str_lit("wasm-opt"));
+
+			// NOTE: the features are taken from the `target_features` section which LLVM emits
+			char const *level = "-O1";
+			switch (build_context.optimization_level) {
+			case 1: level = "-Oz"; break;
+			case 2: level = "-O3"; break;
+			case 3: level = "-O4"; break;
+			}
+			result = system_exec_command_line_app("wasm-opt",
+				"wasm-opt \"%.*s\" -o \"%.*s\" %s %s",
+				LIT(output_filename), LIT(output_filename),
+				level,
+				build_has_debug_info() ? "-g" : "--strip-debug");
+		}
 		return result;
 	}
 
@@ -229,43 +584,11 @@ try_cross_linking:;
 
 					if (has_asm_extension(lib)) {
 						if (!string_set_update(&asm_files, lib)) {
-							String asm_file = lib;
-							String obj_file = {};
-							String temp_dir = temporary_directory(temporary_allocator());
-							if (temp_dir.len != 0) {
-								String filename = filename_without_directory(asm_file);
-
-								gbString str = gb_string_make(heap_allocator(), "");
-								str = gb_string_append_length(str, temp_dir.text, temp_dir.len);
-								str = gb_string_appendc(str, "/");
-								str = gb_string_append_length(str, filename.text, filename.len);
-								str = gb_string_append_fmt(str, "-%p.obj", asm_file.text);
-								obj_file = make_string_c(str);
-							} else {
-								obj_file = concatenate_strings(permanent_allocator(), asm_file, str_lit(".obj"));
-							}
-
-							String obj_format = str_lit("win64");
-						#if defined(GB_ARCH_32_BIT)
-							obj_format = str_lit("win32");
-						#endif
-
-							result = system_exec_command_line_app("nasm",
-								"\"%.*s\\bin\\nasm\\windows\\nasm.exe\" \"%.*s\" "
-								"-f \"%.*s\" "
-								"-o \"%.*s\" "
-								"%.*s "
-								"",
-								LIT(build_context.ODIN_ROOT), LIT(asm_file),
-								LIT(obj_format),
-								LIT(obj_file),
-								LIT(build_context.extra_assembler_flags)
-							);
-
-							if (result) {
-								return result;
+							LinkerForeignAsm *fa = linker_foreign_asm_object(gen, lib);
+							if (fa->result) {
+								return fa->result;
 							}
-							array_add(&gen->output_object_paths, obj_file);
+							array_add(&gen->output_object_paths, fa->obj_file);
 						}
 					} else if (!string_set_update(&min_libs_set, lib) ||
 					           !build_context.min_link_libs) {
@@ -303,15 +626,32 @@ try_cross_linking:;
 				}
 			}
 
-			if (build_context.ODIN_DEBUG) {
-				link_settings = gb_string_append_fmt(link_settings, " /DEBUG");
+			if (build_has_debug_info()) {
+				if (build_context.linker_choice == Linker_lld) {
+					// NOTE: Uses the `.debug$H` type hashes emitted by the backend to merge the type records
+					link_settings = gb_string_append_fmt(link_settings, " /DEBUG:GHASH");
+				} else {
+					link_settings = gb_string_append_fmt(link_settings, " /DEBUG");
+				}
+			}
+
+			if (build_context.deterministic && build_context.linker_choice != Linker_radlink) {
+				// NOTE: Otherwise the PE timestamp and the PDB signature differ between every link
+				link_settings = gb_string_append_fmt(link_settings, " /Brepro");
+			}
+
+			if (build_context.optimization_level >= 1 && build_context.build_mode != BuildMode_StaticLibrary &&
+			    build_context.linker_choice != Linker_radlink) {
+				// NOTE: /DEBUG turns identical COMDAT folding off by default, so request it explicitly
+				link_settings = gb_string_append_fmt(link_settings, " /OPT:ICF");
 			}
 
 			gbString object_files = gb_string_make(heap_allocator(), "");
-			defer (gb_string_free(object_files));
 			for (String const &object_path : gen->output_object_paths) {
 				object_files = gb_string_append_fmt(object_files, "\"%.*s\" ", LIT(object_path));
 			}
+			object_files = linker_object_files_argument(gen, output_filename, object_files);
+			defer (gb_string_free(object_files));
 
 			String vs_exe_path = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_VS_EXE]);
 			defer (gb_free(heap_allocator(), vs_exe_path.text));
@@ -323,6 +663,18 @@ try_cross_linking:;
 			defer (gb_string_free(lld_lto_flags));
 			if (build_context.lto_kind != LTO_None) {
 				lld_lto_flags = gb_string_append_fmt(lld_lto_flags, "/opt:lldltojobs=%d ", build_context.thread_count);
+
+				String cache_dir = linker_thin_lto_cache_dir();
+				if (cache_dir.len != 0) {
+					lld_lto_flags = gb_string_append_fmt(lld_lto_flags, "/lldltocache:\"%.*s\" ", LIT(cache_dir));
+				}
+
+				if (build_context.optimization_level == 1) {
+					lld_lto_flags = gb_string_appendc(lld_lto_flags, "/mllvm:-enable-merge-functions /mllvm:-enable-machine-outliner ");
+				}
+			}
+			if (linker_should_pass_thread_count()) {
+				lld_lto_flags = gb_string_append_fmt(lld_lto_flags, "/threads:%d ", build_context.thread_count);
 			}
 
 			switch (build_context.linker_choice) {
@@ -506,97 +858,11 @@ try_cross_linking:;
 						if (string_set_update(&asm_files, lib)) {
 							continue; // already handled
 						}
-						String asm_file = lib;
-						String obj_file = {};
-
-						String temp_dir = temporary_directory(temporary_allocator());
-						if (temp_dir.len != 0) {
-							String filename = filename_without_directory(asm_file);
-
-							gbString str = gb_string_make(heap_allocator(), "");
-							str = gb_string_append_length(str, temp_dir.text, temp_dir.len);
-							str = gb_string_appendc(str, "/");
-							str = gb_string_append_length(str, filename.text, filename.len);
-							str = gb_string_append_fmt(str, "-%p.o", asm_file.text);
-							obj_file = make_string_c(str);
-						} else {
-							obj_file = concatenate_strings(permanent_allocator(), asm_file, str_lit(".o"));
+						LinkerForeignAsm *fa = linker_foreign_asm_object(gen, lib);
+						if (fa->result) {
+							return fa->result;
 						}
-
-						String obj_format;
-						if (build_context.metrics.ptr_size == 8) {
-							if (is_osx) {
-								obj_format = str_lit("macho64");
-							} else {
-								obj_format = str_lit("elf64");
-							}
-						} else {
-							GB_ASSERT(build_context.metrics.ptr_size == 4);
-							if (is_osx) {
-								obj_format = str_lit("macho32");
-							} else {
-								obj_format = str_lit("elf32");
-							}
-						}
-
-						if (build_context.metrics.arch == TargetArch_riscv64) {
-							result = system_exec_command_line_app("clang",
-								"%s \"%.*s\" "
-								"-c -o \"%.*s\" "
-								"-target %.*s -march=rv64gc "
-								"%.*s "
-								"",
-								clang_path,
-								LIT(asm_file),
-								LIT(obj_file),
-								LIT(build_context.metrics.target_triplet),
-								LIT(build_context.extra_assembler_flags)
-							);
-						} else if (is_osx) {
-							// `as` comes with MacOS.
-							result = system_exec_command_line_app("as",
-								"as \"%.*s\" "
-								"-o \"%.*s\" "
-								"%.*s "
-								"",
-								LIT(asm_file),
-								LIT(obj_file),
-								LIT(build_context.extra_assembler_flags)
-							);
-						} else if (build_context.metrics.arch == TargetArch_arm64) {
-							result = system_exec_command_line_app("clang",
-								"%s \"%.*s\" "
-								"-c -o \"%.*s\" "
-								"-target %.*s "
-								"%.*s "
-								"",
-								clang_path,
-								LIT(asm_file),
-								LIT(obj_file),
-								LIT(build_context.metrics.target_triplet),
-								LIT(build_context.extra_assembler_flags)
-							);
-						} else {
-							// Note(bumbread): I'm assuming nasm is installed on the host machine.
-							// Shipping binaries on unix-likes gets into the weird territorry of
-							// "which version of glibc" is it linked with.
-							result = system_exec_command_line_app("nasm",
-								"nasm \"%.*s\" "
-								"-f \"%.*s\" "
-								"-o \"%.*s\" "
-								"%.*s "
-								"",
-								LIT(asm_file),
-								LIT(obj_format),
-								LIT(obj_file),
-								LIT(build_context.extra_assembler_flags)
-							);						
-							if (result) {
-								gb_printf_err("executing `nasm` to assemble foreing import of %.*s failed.\n\tSuggestion: `nasm` does not ship with the compiler and should be installed with your system's package manager.\n", LIT(asm_file));
-								return result;
-							}
-						}
-						array_add(&gen->output_object_paths, obj_file);
+						array_add(&gen->output_object_paths, fa->obj_file);
 					} else {
 						bool short_circuit = false;
 						if (string_ends_with(lib, str_lit(".framework"))) {
@@ -742,6 +1008,10 @@ try_cross_linking:;
 			for (String object_path : gen->output_object_paths) {
 				object_files = gb_string_append_fmt(object_files, "\"%.*s\" ", LIT(object_path));
 			}
+			if (build_context.build_mode != BuildMode_StaticLibrary) {
+				// NOTE: `ar` treats `@file` differently between implementations, so keep those inline
+				object_files = linker_object_files_argument(gen, output_filename, object_files);
+			}
 
 			gbString link_settings = gb_string_make_reserve(heap_allocator(), 32);
 
@@ -952,6 +1222,32 @@ try_cross_linking:;
 				link_settings = gb_string_appendc(link_settings, "-u ANativeActivity_onCreate ");
 			}
 
+			if (linker_uses_dead_section_elimination()) {
+				link_settings = gb_string_appendc(link_settings, "-Wl,--gc-sections ");
+				if (build_context.linker_choice == Linker_lld || build_context.linker_choice == Linker_mold) {
+					// NOTE: only procedures whose address is never taken (or is `unnamed_addr`) are folded
+					link_settings = gb_string_appendc(link_settings, "-Wl,--icf=safe ");
+				}
+			} else if (is_osx && build_context.optimization_level >= 1 && build_context.build_mode != BuildMode_StaticLibrary) {
+				// NOTE: Mach-O objects are already split per symbol through `.subsections_via_symbols`
+				link_settings = gb_string_appendc(link_settings, "-Wl,-dead_strip ");
+			}
+
+			if (build_context.post_link_optimize) {
+				link_settings = gb_string_appendc(link_settings, "-Wl,--emit-relocs ");
+			}
+			switch (build_context.debug_compression) {
+			case DebugCompression_Zlib:
+				link_settings = gb_string_appendc(link_settings, "-Wl,--compress-debug-sections=zlib ");
+				break;
+			case DebugCompression_Zstd:
+				link_settings = gb_string_appendc(link_settings, "-Wl,--compress-debug-sections=zstd ");
+				break;
+			}
+			if (build_context.symbol_ordering_file.len != 0) {
+				link_settings = gb_string_append_fmt(link_settings, "\"-Wl,--symbol-ordering-file=%.*s\" ", LIT(build_context.symbol_ordering_file));
+			}
+
 			if (!build_context.no_rpath) {
 				// Set the rpath to the $ORIGIN/@loader_path (the path of the executable),
 				// so that dynamic libraries are looked for at that path.
@@ -991,10 +1287,28 @@ try_cross_linking:;
 			link_command_line = gb_string_appendc(link_command_line, " -Wno-unused-command-line-argument ");
 
 			if (build_context.lto_kind != LTO_None) {
-				link_command_line = gb_string_appendc(link_command_line, " -flto=thin");
+				if (build_context.lto_kind == LTO_Full) {
+					link_command_line = gb_string_appendc(link_command_line, " -flto=full");
+				} else {
+					link_command_line = gb_string_appendc(link_command_line, " -flto=thin");
+				}
 				link_command_line = gb_string_append_fmt(link_command_line, " -flto-jobs=%d ", build_context.thread_count);
 
-				if (build_context.ODIN_DEBUG) {
+				String cache_dir = linker_thin_lto_cache_dir();
+				if (cache_dir.len != 0) {
+					if (is_osx) {
+						link_command_line = gb_string_append_fmt(link_command_line, " -Wl,-cache_path_lto,\"%.*s\" ", LIT(cache_dir));
+					} else {
+						link_command_line = gb_string_append_fmt(link_command_line, " -Wl,--thinlto-cache-dir=\"%.*s\" ", LIT(cache_dir));
+					}
+				}
+
+				if (build_context.optimization_level == 1) {
+					// NOTE: merges the procedures across modules, which the per module `mergefunc` cannot
+					link_command_line = gb_string_appendc(link_command_line, " -Wl,-mllvm,-enable-merge-functions -Wl,-mllvm,-enable-machine-outliner ");
+				}
+
+				if (build_has_debug_info()) {
 					link_command_line = gb_string_appendc(link_command_line, " -g ");
 				}
 
@@ -1018,9 +1332,15 @@ try_cross_linking:;
 
 			if (build_context.linker_choice == Linker_lld) {
 				link_command_line = gb_string_append_fmt(link_command_line, " -fuse-ld=lld");
+				if (linker_should_pass_thread_count()) {
+					link_command_line = gb_string_append_fmt(link_command_line, " -Wl,--threads=%d", build_context.thread_count);
+				}
 				result = system_exec_command_line_app("lld-link", link_command_line);
 			} else if (build_context.linker_choice == Linker_mold) {
 				link_command_line = gb_string_append_fmt(link_command_line, " -fuse-ld=mold");
+				if (linker_should_pass_thread_count()) {
+					link_command_line = gb_string_append_fmt(link_command_line, " -Wl,--thread-count=%d", build_context.thread_count);
+				}
 				result = system_exec_command_line_app("mold-link", link_command_line);
 			} else {
 				result = system_exec_command_line_app("ld-link", link_command_line);
@@ -1030,7 +1350,7 @@ try_cross_linking:;
 				return result;
 			}
 
-			if (is_osx && build_context.ODIN_DEBUG) {
+			if (is_osx && build_has_debug_info()) {
 				// NOTE: macOS links DWARF symbols dynamically. Dsymutil will map the stubs in the exe
 				// to the symbols in the object file
 				result = system_exec_command_line_app("dsymutil", "dsymutil \"%.*s\"", LIT(output_filename));
@@ -1039,6 +1359,23 @@ try_cross_linking:;
 					return result;
 				}
 			}
+
+			if (build_context.debug_split) {
+				String debug_filename = concatenate_strings(temporary_allocator(), output_filename, str_lit(".debug"));
+				result = system_exec_command_line_app("objcopy-only-keep-debug",
+					"objcopy --only-keep-debug \"%.*s\" \"%.*s\"",
+					LIT(output_filename), LIT(debug_filename));
+				if (result) {
+					return result;
+				}
+
+				result = system_exec_command_line_app("objcopy-strip-debug",
+					"objcopy --strip-debug --add-gnu-debuglink=\"%.*s\" \"%.*s\"",
+					LIT(debug_filename), LIT(output_filename));
+				if (result) {
+					return result;
+				}
+			}
 		}
 	}
 
@@ -1967,16 +1967,81 @@ gb_internal LB_ABI_INFO(lb_get_abi_info_internal) {
 }
 
 
+// NOTE: The number of scalar registers an aggregate is made of, or -1 if it is not made of scalars
+gb_internal i64 lb_abi_scalar_leaf_count(LLVMTypeRef type) {
+	switch (LLVMGetTypeKind(type)) {
+	case LLVMIntegerTypeKind:
+		return LLVMGetIntTypeWidth(type) > 64 ? 2 : 1;
+	case LLVMHalfTypeKind:
+	case LLVMFloatTypeKind:
+	case LLVMDoubleTypeKind:
+	case LLVMPointerTypeKind:
+		return 1;
+	case LLVMStructTypeKind: {
+		i64 count = 0;
+		unsigned field_count = LLVMCountStructElementTypes(type);
+		for (unsigned i = 0; i < field_count; i++) {
+			i64 n = lb_abi_scalar_leaf_count(LLVMStructGetTypeAtIndex(type, i));
+			if (n < 0) {
+				return -1;
+			}
+			count += n;
+		}
+		return count;
+	}
+	case LLVMArrayTypeKind: {
+		i64 n = lb_abi_scalar_leaf_count(OdinLLVMGetArrayElementType(type));
+		if (n < 0) {
+			return -1;
+		}
+		return n * cast(i64)LLVMGetArrayLength(type);
+	}
+	}
+	return -1;
+}
+
+// NOTE: -internal-odin-abi-registers; aggregates of up to 4 scalars (e.g. slices, strings, `Maybe(T)`,
+// and multiple return values such as `(T, bool)` or `(T, Error)`) are passed and returned in registers
+// as first class aggregates, which LLVM splits into one register per scalar. This is only done for the
+// Odin calling conventions, as every caller and callee is compiled by us and agree upon it.
+enum : i64 { LB_ODIN_ABI_MAX_REGISTER_AGGREGATE_SCALARS = 4 };
+
+gb_internal bool lb_odin_abi_is_register_aggregate(LLVMTypeRef type) {
+	LLVMTypeKind kind = LLVMGetTypeKind(type);
+	if (kind != LLVMStructTypeKind && kind != LLVMArrayTypeKind) {
+		return false;
+	}
+	if (lb_sizeof(type) == 0) {
+		return false;
+	}
+	i64 count = lb_abi_scalar_leaf_count(type);
+	return 0 < count && count <= LB_ODIN_ABI_MAX_REGISTER_AGGREGATE_SCALARS;
+}
+
 gb_internal LB_ABI_INFO(lb_get_abi_info) {
+	bool odin_abi_registers = build_context.internal_odin_abi_registers && is_calling_convention_odin(calling_convention);
+	bool return_in_registers = odin_abi_registers && return_is_defined && lb_odin_abi_is_register_aggregate(return_type);
+
 	lbFunctionType *ft = lb_get_abi_info_internal(
 		m,
 		arg_types, arg_count,
 		return_type, return_is_defined,
-		ALLOW_SPLIT_MULTI_RETURNS && return_is_tuple && is_calling_convention_odin(calling_convention),
+		ALLOW_SPLIT_MULTI_RETURNS && return_is_tuple && is_calling_convention_odin(calling_convention) && !return_in_registers,
 		calling_convention,
 		base_type(original_type)
 	);
 
+	if (odin_abi_registers) {
+		for (unsigned i = 0; i < arg_count; i++) {
+			if (ft->args[i].kind != lbArg_Ignore && lb_odin_abi_is_register_aggregate(arg_types[i])) {
+				ft->args[i] = lb_arg_type_direct(arg_types[i]);
+			}
+		}
+		if (return_in_registers) {
+			ft->ret = lb_arg_type_direct(return_type);
+		}
+	}
+
 
 	// NOTE(bill): this is handled here rather than when developing the type in `lb_type_internal_for_procedures_raw`
 	// This is to make it consistent when and how it is handled
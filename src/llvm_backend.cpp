@@ -179,8 +179,27 @@ gb_internal void lb_set_entity_from_other_modules_linkage_correctly(lbModule *ot
 	mpsc_enqueue(&other_module->gen->entities_to_correct_linkage, lbEntityCorrection{other_module, e, cname});
 }
 
-gb_internal void lb_correct_entity_linkage(lbGenerator *gen) {
+// NOTE: The corrections are gathered before the module passes, so that the ones applied to a module
+// are part of the key its object is cached under
+gb_internal void lb_gather_entity_linkage_corrections(lbGenerator *gen) {
+	array_init(&gen->linkage_corrections, heap_allocator());
 	for (lbEntityCorrection ec = {}; mpsc_dequeue(&gen->entities_to_correct_linkage, &ec); /**/) {
+		array_add(&gen->linkage_corrections, ec);
+
+		u64 h = gb_fnv64a(ec.cname, gb_strlen(ec.cname));
+		h ^= cast(u64)ec.e->kind;
+		if (ec.e->kind == Entity_Variable) {
+			h ^= (cast(u64)ec.e->Variable.is_export << 8) | (cast(u64)ec.e->Variable.is_foreign << 9);
+		} else if (ec.e->kind == Entity_Procedure) {
+			h ^= (cast(u64)ec.e->Procedure.is_export << 8) | (cast(u64)ec.e->Procedure.is_foreign << 9);
+		}
+		// NOTE: the order of the queue is not deterministic
+		ec.other_module->linkage_corrections_hash += h * 0x9e3779b97f4a7c15ull;
+	}
+}
+
+gb_internal void lb_correct_entity_linkage(lbGenerator *gen) {
+	for (lbEntityCorrection const &ec : gen->linkage_corrections) {
 		LLVMValueRef other_global = nullptr;
 		if (ec.e->kind == Entity_Variable) {
 			other_global = LLVMGetNamedGlobal(ec.other_module->mod, ec.cname);
@@ -202,6 +221,302 @@ gb_internal void lb_correct_entity_linkage(lbGenerator *gen) {
 	}
 }
 
+gb_internal bool lb_is_linkage_visible_outside_module(LLVMLinkage linkage) {
+	switch (linkage) {
+	case LLVMExternalLinkage:
+	case LLVMAvailableExternallyLinkage:
+	case LLVMLinkOnceAnyLinkage:
+	case LLVMLinkOnceODRLinkage:
+	case LLVMWeakAnyLinkage:
+	case LLVMWeakODRLinkage:
+	case LLVMCommonLinkage:
+	case LLVMDLLExportLinkage:
+		return true;
+	}
+	return false;
+}
+
+gb_internal void lb_set_shared_library_symbol_visibility(LLVMValueRef value, PtrSet<LLVMValueRef> *keep, StringSet *export_list, StringSet *exported_names) {
+	if (LLVMIsDeclaration(value)) {
+		return;
+	}
+	LLVMLinkage linkage = LLVMGetLinkage(value);
+	if (!lb_is_linkage_visible_outside_module(linkage)) {
+		return;
+	}
+	if (LLVMGetVisibility(value) != LLVMDefaultVisibility) {
+		return;
+	}
+	if (ptr_set_exists(keep, value)) {
+		return;
+	}
+
+	if (LLVMGetDLLStorageClass(value) == LLVMDLLExportStorageClass) {
+		if (export_list == nullptr) {
+			return;
+		}
+		size_t len = 0;
+		char const *cname = LLVMGetValueName2(value, &len);
+		String name = make_string(cast(u8 const *)cname, cast(isize)len);
+		if (string_set_exists(export_list, name)) {
+			string_set_add(exported_names, name);
+			return;
+		}
+		LLVMSetLinkage(value, LLVMExternalLinkage);
+		LLVMSetDLLStorageClass(value, LLVMDefaultStorageClass);
+	}
+	LLVMSetVisibility(value, LLVMHiddenVisibility);
+}
+
+// NOTE: a shared library only exports its @(export) symbols (or those named in -exported-symbols-file);
+// everything else which has to stay external to be shared between the modules is given hidden
+// visibility, which keeps it out of the dynamic symbol table and lets it be bound locally
+gb_internal void lb_apply_shared_library_visibility(lbGenerator *gen) {
+	if (build_context.build_mode != BuildMode_DynamicLibrary || is_arch_wasm()) {
+		return;
+	}
+
+	StringSet export_list = {};
+	StringSet exported_names = {};
+	bool has_export_list = build_context.exported_symbols_file.len != 0;
+	if (has_export_list) {
+		string_set_init(&export_list);
+		string_set_init(&exported_names);
+
+		char const *path = alloc_cstring(temporary_allocator(), build_context.exported_symbols_file);
+		gbFileContents fc = gb_file_read_contents(permanent_allocator(), false, path);
+		if (fc.data == nullptr) {
+			gb_printf_err("Failed to read -exported-symbols-file: %s\n", path);
+			gb_exit(1);
+		}
+
+		String_Iterator it = {make_string(cast(u8 const *)fc.data, fc.size), 0};
+		while (it.pos < it.str.len) {
+			String line = string_trim_whitespace(string_split_iterator(&it, '\n'));
+			if (line.len != 0 && line[0] != '#') {
+				string_set_add(&export_list, line);
+			}
+		}
+	}
+
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+
+		// NOTE: symbols with an explicit `linkage` keep their default visibility as they are
+		// usually required by name, e.g. the `-init`/`-fini` entry points of the runtime
+		PtrSet<LLVMValueRef> keep = {};
+		for (auto const &v : m->values) {
+			Entity *e = v.key;
+			if (e->flags & (EntityFlag_CustomLinkage_Strong|EntityFlag_CustomLinkage_Weak)) {
+				ptr_set_add(&keep, v.value.value);
+			}
+		}
+
+		StringSet *list = has_export_list ? &export_list : nullptr;
+		for (LLVMValueRef f = LLVMGetFirstFunction(m->mod); f != nullptr; f = LLVMGetNextFunction(f)) {
+			lb_set_shared_library_symbol_visibility(f, &keep, list, &exported_names);
+		}
+		for (LLVMValueRef g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+			lb_set_shared_library_symbol_visibility(g, &keep, list, &exported_names);
+		}
+
+		ptr_set_destroy(&keep);
+	}
+
+	if (has_export_list) {
+		for (String const &name : export_list) {
+			if (!string_set_exists(&exported_names, name)) {
+				gb_printf_err("Warning: '%.*s' is listed in -exported-symbols-file but is not an @(export) symbol\n", LIT(name));
+			}
+		}
+		string_set_destroy(&exported_names);
+		string_set_destroy(&export_list);
+	}
+}
+
+// NOTE: Done over every defined function rather than in `lb_create_procedure` so that the
+// procedures generated by the backend itself (startup, equality and hashing helpers, etc) are covered too
+gb_internal void lb_add_frame_pointers(lbGenerator *gen) {
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		for (LLVMValueRef f = LLVMGetFirstFunction(m->mod); f != nullptr; f = LLVMGetNextFunction(f)) {
+			if (LLVMCountBasicBlocks(f) != 0) {
+				lb_add_attribute_to_proc_with_string(m, f, str_lit("frame-pointer"), str_lit("all"));
+			}
+		}
+	}
+}
+
+gb_internal bool lb_is_module_empty(lbModule *m);
+
+struct lbModuleBitcode {
+	lbModule *          m;
+	LLVMMemoryBufferRef buffer;
+};
+
+gb_internal WORKER_TASK_PROC(lb_write_module_bitcode_worker_proc) {
+	lbModuleBitcode *bc = cast(lbModuleBitcode *)data;
+	bc->buffer = LLVMWriteBitcodeToMemoryBuffer(bc->m->mod);
+	return 0;
+}
+
+gb_internal bool lb_should_internalize_linked_entity(Entity *e) {
+	if (e->flags & (EntityFlag_CustomLinkage_Strong|EntityFlag_CustomLinkage_Weak|EntityFlag_CustomLinkage_LinkOnce)) {
+		return false;
+	}
+	switch (e->kind) {
+	case Entity_Procedure:
+		if (e->Procedure.is_export || e->Procedure.is_foreign) {
+			return false;
+		}
+		// NOTE: the same exception as in `lb_create_procedure` for single module builds
+		if (e->pkg != nullptr && e->pkg->kind == Package_Runtime &&
+		    (e->flags & EntityFlag_CustomLinkName) != 0 &&
+		    string_starts_with(e->Procedure.link_name, str_lit("__"))) {
+			return false;
+		}
+		return true;
+	case Entity_Variable:
+		return !e->Variable.is_export && !e->Variable.is_foreign;
+	}
+	return false;
+}
+
+// NOTE: With -internal-link-single-module, the procedures are generated into the usual separate modules
+// (and thus across all the threads), and then every module is linked into the default module straight
+// after the function passes, so that the module passes and object generation see a single build unit.
+// The modules live in separate LLVM contexts, so each is moved across through its bitcode.
+//
+// Afterwards, everything which only had to be external (or weak) to be shared between the modules
+// is given the internal linkage it would have had in a `-use-single-module` build.
+gb_internal void lb_link_into_single_module(lbGenerator *gen, bool do_threading) {
+	lbModule *dst = &gen->default_module;
+
+	// NOTE: these refer to the other modules so must be done before they are gone
+	lb_correct_entity_linkage(gen);
+
+	auto to_link = array_make<lbModuleBitcode>(heap_allocator(), 0, gen->modules.count);
+	defer (array_free(&to_link));
+
+	StringSet to_internalize = {};
+	string_set_init(&to_internalize);
+	defer (string_set_destroy(&to_internalize));
+
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		for (auto const &v : m->values) {
+			if (v.value.value == nullptr || !LLVMIsAGlobalValue(v.value.value) || LLVMIsDeclaration(v.value.value)) {
+				continue;
+			}
+			if (lb_should_internalize_linked_entity(v.key)) {
+				size_t len = 0;
+				char const *cname = LLVMGetValueName2(v.value.value, &len);
+				string_set_add(&to_internalize, copy_string(permanent_allocator(), make_string(cast(u8 const *)cname, cast(isize)len)));
+			}
+		}
+		// NOTE: the generated helpers, see `lb_set_generated_helper_linkage`
+		for (auto const &entry : m->gen_procs) {
+			lbProcedure *p = entry.value;
+			if (!LLVMIsDeclaration(p->value)) {
+				string_set_add(&to_internalize, p->name);
+			}
+		}
+
+		if (m != dst && !lb_is_module_empty(m)) {
+			array_add(&to_link, lbModuleBitcode{m, nullptr});
+		}
+	}
+
+	if (do_threading) {
+		for (lbModuleBitcode &bc : to_link) {
+			thread_pool_add_task(lb_write_module_bitcode_worker_proc, &bc);
+		}
+		thread_pool_wait();
+	} else {
+		for (lbModuleBitcode &bc : to_link) {
+			lb_write_module_bitcode_worker_proc(&bc);
+		}
+	}
+
+	auto parsed = array_make<LLVMModuleRef>(heap_allocator(), 0, to_link.count);
+	defer (array_free(&parsed));
+
+	for (lbModuleBitcode &bc : to_link) {
+		lbModule *m = bc.m;
+
+		LLVMModuleRef src = nullptr;
+		bool failed = LLVMParseBitcodeInContext2(dst->ctx, bc.buffer, &src);
+		LLVMDisposeMemoryBuffer(bc.buffer);
+		if (failed) {
+			gb_printf_err("LLVM Error: Unable to read back the module '%s' to be linked\n", m->module_name);
+			gb_exit(1);
+		}
+		array_add(&parsed, src);
+
+		for (i32 i = 0; i < lbFunctionPassManager_COUNT; i++) {
+			if (m->function_pass_managers[i] != nullptr) {
+				LLVMDisposePassManager(m->function_pass_managers[i]);
+				m->function_pass_managers[i] = nullptr;
+			}
+		}
+		LLVMDisposeModule(m->mod);
+		m->mod = LLVMModuleCreateWithNameInContext(m->module_name, m->ctx);
+
+		// NOTE: everything these refer to is now in `dst`
+		array_clear(&m->generated_procedures);
+		string_map_clear(&m->gen_procs);
+	}
+
+	// NOTE: Every link walks all of the types of the destination module, so linking each module
+	// straight into `dst` is quadratic. Linking them together pairwise first keeps that to O(n log n).
+	// The source module is always consumed by the linker.
+	while (parsed.count > 1) {
+		isize count = 0;
+		for (isize i = 0; i < parsed.count; i += 2) {
+			LLVMModuleRef a = parsed[i];
+			if (i+1 < parsed.count && LLVMLinkModules2(a, parsed[i+1])) {
+				gb_printf_err("LLVM Error: Unable to link the modules together into '%s'\n", dst->module_name);
+				gb_exit(1);
+			}
+			parsed[count++] = a;
+		}
+		parsed.count = count;
+	}
+	if (parsed.count != 0 && LLVMLinkModules2(dst->mod, parsed[0])) {
+		gb_printf_err("LLVM Error: Unable to link the modules together into '%s'\n", dst->module_name);
+		gb_exit(1);
+	}
+
+	auto const internalize = [&to_internalize](LLVMValueRef value) {
+		if (LLVMIsDeclaration(value)) {
+			return;
+		}
+		LLVMLinkage linkage = LLVMGetLinkage(value);
+		if (linkage == LLVMExternalLinkage) {
+			size_t len = 0;
+			char const *cname = LLVMGetValueName2(value, &len);
+			if (!string_set_exists(&to_internalize, make_string(cast(u8 const *)cname, cast(isize)len))) {
+				return;
+			}
+		} else if (linkage != LLVMWeakAnyLinkage) {
+			// NOTE: only `LLVM_SET_INTERNAL_WEAK_LINKAGE` produces weak definitions
+			return;
+		}
+		if (LLVMGetDLLStorageClass(value) == LLVMDLLExportStorageClass) {
+			return;
+		}
+		LLVMSetLinkage(value, LLVMInternalLinkage);
+		LLVMSetVisibility(value, LLVMDefaultVisibility);
+	};
+
+	for (LLVMValueRef f = LLVMGetFirstFunction(dst->mod); f != nullptr; f = LLVMGetNextFunction(f)) {
+		internalize(f);
+	}
+	for (LLVMValueRef g = LLVMGetFirstGlobal(dst->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+		internalize(g);
+	}
+}
+
 
 gb_internal void lb_emit_init_context(lbProcedure *p, lbAddr addr) {
 	TEMPORARY_ALLOCATOR_GUARD();
@@ -259,6 +574,41 @@ gb_internal String lb_internal_gen_name_from_type(char const *prefix, Type *type
 	return proc_name;
 }
 
+// NOTE: Returns true if `m` should define the generated helper `name`, otherwise another module
+// has already claimed it and `m` only needs an external declaration
+gb_internal bool lb_generated_helper_claim_definition(lbModule *m, String const &name) {
+	lbGenerator *gen = m->gen;
+	if (gen == nullptr || !gen->share_generated_helpers) {
+		return true;
+	}
+	u64 key = fnv64a(name.text, name.len);
+	if (!concurrent_map_set_if_not_previously_exists(&gen->generated_helper_owners, key, m)) {
+		return true;
+	}
+	lbModule *owner = nullptr;
+	concurrent_map_get(&gen->generated_helper_owners, key, &owner);
+	return owner == m;
+}
+
+gb_internal void lb_set_generated_helper_linkage(lbProcedure *p) {
+	lbGenerator *gen = p->module->gen;
+	if (gen != nullptr && gen->share_generated_helpers) {
+		LLVMSetLinkage(p->value, LLVMExternalLinkage);
+		LLVMSetVisibility(p->value, LLVMHiddenVisibility);
+	} else {
+		LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	}
+}
+
+gb_internal lbProcedure *lb_declare_generated_helper(lbModule *m, String const &name, Type *type) {
+	lbProcedure *p = lb_create_dummy_procedure(m, name, type);
+	string_map_set(&m->gen_procs, name, p);
+	LLVMSetLinkage(p->value, LLVMExternalLinkage);
+	LLVMSetVisibility(p->value, LLVMHiddenVisibility);
+	LLVMSetUnnamedAddress(p->value, LLVMGlobalUnnamedAddr);
+	return p;
+}
+
 gb_internal void lb_equal_proc_generate_body(lbModule *m, lbProcedure *p) {
 	Type *type = p->internal_gen_type;
 
@@ -267,7 +617,7 @@ gb_internal void lb_equal_proc_generate_body(lbModule *m, lbProcedure *p) {
 
 	lb_begin_procedure_body(p);
 
-	LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	lb_set_generated_helper_linkage(p);
 	// lb_add_attribute_to_proc(m, p->value, "readonly");
 	lb_add_attribute_to_proc(m, p->value, "nounwind");
 
@@ -291,7 +641,12 @@ gb_internal void lb_equal_proc_generate_body(lbModule *m, lbProcedure *p) {
 
 	lb_start_block(p, block_diff_ptr);
 
-	if (type->kind == Type_Struct) {
+	if (lb_simple_compare_can_use_wide_ops(type)) {
+		TEMPORARY_ALLOCATOR_GUARD();
+		lbValue ok = lb_simple_compare_wide_equal(p, type, lhs, rhs);
+		ok = lb_emit_conv(p, ok, t_bool);
+		LLVMBuildRet(p->builder, ok.value);
+	} else if (type->kind == Type_Struct) {
 		type_set_offsets(type);
 
 		lbBlock *block_false = lb_create_block(p, "bfalse");
@@ -405,9 +760,15 @@ gb_internal lbValue lb_equal_proc_for_type(lbModule *m, Type *type) {
 		GB_ASSERT(p != nullptr);
 		return {p->value, p->type};
 	}
+	if (!lb_generated_helper_claim_definition(m, proc_name)) {
+		lbProcedure *p = lb_declare_generated_helper(m, proc_name, t_equal_proc);
+		return {p->value, p->type};
+	}
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_equal_proc);
 	string_map_set(&m->gen_procs, proc_name, p);
+	// NOTE: the address of a generated helper is never meaningful, which allows identical ones to be folded
+	LLVMSetUnnamedAddress(p->value, LLVMGlobalUnnamedAddr);
 	p->internal_gen_type = type;
 	p->generate_body = lb_equal_proc_generate_body;
 
@@ -429,6 +790,157 @@ gb_internal lbValue lb_simple_compare_hash(lbProcedure *p, Type *type, lbValue d
 	return lb_emit_runtime_call(p, "default_hasher", args);
 }
 
+// NOTE: Simple compare types up to this size hash and compare with unrolled word-sized loads
+// rather than calling the byte-wise runtime procedures
+gb_global i64 const LB_SIMPLE_COMPARE_WIDE_MAX_SIZE = 128;
+
+gb_internal void lb_simple_compare_significant_bytes(Type *t, u8 *mask, i64 offset) {
+	t = core_type(t);
+	switch (t->kind) {
+	case Type_Struct:
+		if (!t->Struct.is_raw_union) {
+			type_set_offsets(t);
+			for_array(i, t->Struct.fields) {
+				lb_simple_compare_significant_bytes(t->Struct.fields[i]->type, mask, offset + t->Struct.offsets[i]);
+			}
+			return;
+		}
+		break;
+	case Type_Array:
+		{
+			i64 elem_size = type_size_of(t->Array.elem);
+			for (i64 i = 0; i < t->Array.count; i++) {
+				lb_simple_compare_significant_bytes(t->Array.elem, mask, offset + i*elem_size);
+			}
+		}
+		return;
+	case Type_EnumeratedArray:
+		{
+			i64 elem_size = type_size_of(t->EnumeratedArray.elem);
+			for (i64 i = 0; i < t->EnumeratedArray.count; i++) {
+				lb_simple_compare_significant_bytes(t->EnumeratedArray.elem, mask, offset + i*elem_size);
+			}
+		}
+		return;
+	}
+	gb_memset(mask + offset, 0xff, cast(isize)type_size_of(t));
+}
+
+gb_internal bool lb_simple_compare_can_use_wide_ops(Type *type) {
+	if (!is_type_simple_compare(type)) {
+		return false;
+	}
+	i64 size = type_size_of(type);
+	return 0 < size && size <= LB_SIMPLE_COMPARE_WIDE_MAX_SIZE;
+}
+
+struct lbSimpleCompareChunk {
+	i64 offset;
+	i64 size;
+	u64 mask; // significant bits of the chunk once loaded as an integer
+};
+
+// NOTE: Splits the type into 8/4/2/1 byte chunks, dropping those which are entirely padding
+gb_internal Array<lbSimpleCompareChunk> lb_simple_compare_chunks(Type *type) {
+	i64 size = type_size_of(type);
+	u8 *bytes = gb_alloc_array(temporary_allocator(), u8, size);
+	gb_zero_size(bytes, size);
+	lb_simple_compare_significant_bytes(type, bytes, 0);
+
+	auto chunks = array_make<lbSimpleCompareChunk>(temporary_allocator(), 0, size/8 + 3);
+	for (i64 offset = 0; offset < size; /**/) {
+		i64 n = 8;
+		while (n > size-offset) {
+			n >>= 1;
+		}
+		u64 mask = 0;
+		for (i64 i = 0; i < n; i++) {
+			if (bytes[offset+i]) {
+				i64 shift = build_context.endian_kind == TargetEndian_Big ? (n-1-i)*8 : i*8;
+				mask |= 0xffull << shift;
+			}
+		}
+		if (mask != 0) {
+			array_add(&chunks, lbSimpleCompareChunk{offset, n, mask});
+		}
+		offset += n;
+	}
+	return chunks;
+}
+
+gb_internal lbValue lb_simple_compare_load_chunk(lbProcedure *p, lbValue data, lbSimpleCompareChunk const &chunk) {
+	Type *chunk_type = nullptr;
+	switch (chunk.size) {
+	case 1: chunk_type = t_u8;  break;
+	case 2: chunk_type = t_u16; break;
+	case 4: chunk_type = t_u32; break;
+	case 8: chunk_type = t_u64; break;
+	default: GB_PANIC("invalid chunk size %lld", cast(long long)chunk.size); break;
+	}
+
+	lbValue ptr = lb_emit_ptr_offset(p, lb_emit_conv(p, data, t_u8_ptr), lb_const_int(p->module, t_uintptr, chunk.offset));
+	ptr = lb_emit_conv(p, ptr, alloc_type_pointer(chunk_type));
+
+	lbValue v = {};
+	v.type = chunk_type;
+	v.value = OdinLLVMBuildLoad(p, lb_type(p->module, chunk_type), ptr.value);
+	LLVMSetAlignment(v.value, 1);
+
+	v = lb_emit_conv(p, v, t_u64);
+	u64 full_mask = chunk.size == 8 ? ~0ull : (1ull << (chunk.size*8)) - 1;
+	if (chunk.mask != full_mask) {
+		v = lb_emit_arith(p, Token_And, v, lb_const_int(p->module, t_u64, chunk.mask), t_u64);
+	}
+	return v;
+}
+
+// NOTE: The result must follow the same rules as `runtime.default_hasher`: the top bit must be
+// clear (it is the tombstone bit) and zero is reserved for empty slots
+gb_internal lbValue lb_simple_compare_wide_hash(lbProcedure *p, Type *type, lbValue data, lbValue seed) {
+	lbModule *m = p->module;
+	auto chunks = lb_simple_compare_chunks(type);
+
+	lbValue k_mul = lb_const_int(m, t_u64, 0x9e3779b97f4a7c15ull);
+	lbValue k_shift = lb_const_int(m, t_u64, 32);
+
+	lbValue h = lb_emit_conv(p, seed, t_u64);
+	h = lb_emit_arith(p, Token_Add, h, lb_const_int(m, t_u64, 0xcbf29ce484222325ull), t_u64);
+	for (auto const &chunk : chunks) {
+		lbValue v = lb_simple_compare_load_chunk(p, data, chunk);
+		h = lb_emit_arith(p, Token_Xor, h, v, t_u64);
+		h = lb_emit_arith(p, Token_Mul, h, k_mul, t_u64);
+		h = lb_emit_arith(p, Token_Xor, h, lb_emit_arith(p, Token_Shr, h, k_shift, t_u64), t_u64);
+	}
+
+	// fmix64 so that the low bits, which pick the slot, depend on every input bit
+	lbValue k_fmix_shift = lb_const_int(m, t_u64, 33);
+	h = lb_emit_arith(p, Token_Xor, h, lb_emit_arith(p, Token_Shr, h, k_fmix_shift, t_u64), t_u64);
+	h = lb_emit_arith(p, Token_Mul, h, lb_const_int(m, t_u64, 0xff51afd7ed558ccdull), t_u64);
+	h = lb_emit_arith(p, Token_Xor, h, lb_emit_arith(p, Token_Shr, h, k_fmix_shift, t_u64), t_u64);
+	h = lb_emit_arith(p, Token_Mul, h, lb_const_int(m, t_u64, 0xc4ceb9fe1a85ec53ull), t_u64);
+	h = lb_emit_arith(p, Token_Xor, h, lb_emit_arith(p, Token_Shr, h, k_fmix_shift, t_u64), t_u64);
+
+	lbValue res = lb_emit_conv(p, h, t_uintptr);
+	u64 hash_mask = (1ull << (build_context.ptr_size*8 - 1)) - 1;
+	res = lb_emit_arith(p, Token_And, res, lb_const_int(m, t_uintptr, hash_mask), t_uintptr);
+
+	lbValue is_zero = lb_emit_conv(p, lb_emit_comp(p, Token_CmpEq, res, lb_const_int(m, t_uintptr, 0)), t_uintptr);
+	return lb_emit_arith(p, Token_Or, res, is_zero, t_uintptr);
+}
+
+gb_internal lbValue lb_simple_compare_wide_equal(lbProcedure *p, Type *type, lbValue lhs, lbValue rhs) {
+	lbModule *m = p->module;
+	auto chunks = lb_simple_compare_chunks(type);
+
+	lbValue diff = lb_const_int(m, t_u64, 0);
+	for (auto const &chunk : chunks) {
+		lbValue x = lb_simple_compare_load_chunk(p, lhs, chunk);
+		lbValue y = lb_simple_compare_load_chunk(p, rhs, chunk);
+		diff = lb_emit_arith(p, Token_Or, diff, lb_emit_arith(p, Token_Xor, x, y, t_u64), t_u64);
+	}
+	return lb_emit_comp(p, Token_CmpEq, diff, lb_const_int(m, t_u64, 0));
+}
+
 gb_internal void lb_add_callsite_force_inline(lbProcedure *p, lbValue ret_value) {
 	LLVMAddCallSiteAttribute(ret_value.value, LLVMAttributeIndex_FunctionIndex, lb_create_enum_attribute(p->module->ctx, "alwaysinline"));
 }
@@ -445,13 +957,18 @@ gb_internal lbValue lb_hasher_proc_for_type(lbModule *m, Type *type) {
 		GB_ASSERT(*found != nullptr);
 		return {(*found)->value, (*found)->type};
 	}
+	if (!lb_generated_helper_claim_definition(m, proc_name)) {
+		lbProcedure *p = lb_declare_generated_helper(m, proc_name, t_hasher_proc);
+		return {p->value, p->type};
+	}
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_hasher_proc);
 	string_map_set(&m->gen_procs, proc_name, p);
 	lb_begin_procedure_body(p);
 	defer (lb_end_procedure_body(p));
 
-	LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	lb_set_generated_helper_linkage(p);
+	LLVMSetUnnamedAddress(p->value, LLVMGlobalUnnamedAddr);
 	// lb_add_attribute_to_proc(m, p->value, "readonly");
 	lb_add_attribute_to_proc(m, p->value, "nounwind");
 
@@ -463,7 +980,12 @@ gb_internal lbValue lb_hasher_proc_for_type(lbModule *m, Type *type) {
 	lb_add_proc_attribute_at_index(p, 1+0, "nonnull");
 	// lb_add_proc_attribute_at_index(p, 1+0, "readonly");
 
-	if (is_type_simple_compare(type)) {
+	if (lb_simple_compare_can_use_wide_ops(type)) {
+		TEMPORARY_ALLOCATOR_GUARD();
+		lbValue res = lb_simple_compare_wide_hash(p, type, data, seed);
+		LLVMBuildRet(p->builder, res.value);
+		return {p->value, p->type};
+	} else if (is_type_simple_compare(type)) {
 		lbValue res = lb_simple_compare_hash(p, type, data, seed);
 		lb_add_callsite_force_inline(p, res);
 		LLVMBuildRet(p->builder, res.value);
@@ -644,43 +1166,232 @@ gb_internal lbValue lb_hasher_proc_for_type(lbModule *m, Type *type) {
 #define LLVM_SET_VALUE_NAME(value, name) LLVMSetValueName2((value), (name), gb_count_of((name))-1);
 
 
-gb_internal lbValue lb_map_get_proc_for_type(lbModule *m, Type *type) {
-	GB_ASSERT(!build_context.dynamic_map_calls);
-	type = base_type(type);
-	GB_ASSERT(type->kind == Type_Map);
-
-	String proc_name = lb_internal_gen_name_from_type("__$map_get", type);
-	lbProcedure **found = string_map_get(&m->gen_procs, proc_name);
-	if (found) {
-		GB_ASSERT(*found != nullptr);
-		return {(*found)->value, (*found)->type};
+// NOTE: Installing a handler replaces LLVM's own printing, so anything other than the
+// GlobalISel fallback notices and the -opt-remarks remarks is reported the same way LLVM would have
+// NOTE: LLVM reports a procedure whose stack frame is larger than its "warn-stack-size" as
+// "stack frame size (N) exceeds limit (L) in function 'name'", possibly prefixed with a location
+gb_internal bool lb_parse_stack_usage(String msg, lbStackUsage *res) {
+	String size_prefix = str_lit("stack frame size (");
+	String name_prefix = str_lit(" in function '");
+	isize size_index = string_index(msg, size_prefix);
+	isize name_index = string_index(msg, name_prefix);
+	if (size_index < 0 || name_index < 0 || !string_ends_with(msg, str_lit("'"))) {
+		return false;
 	}
+	u64 size = 0;
+	for (isize i = size_index+size_prefix.len; i < msg.len && gb_char_is_digit(cast(char)msg[i]); i++) {
+		size = size*10 + cast(u64)(msg[i]-'0');
+	}
+	res->name = substring(msg, name_index+name_prefix.len, msg.len-1);
+	res->size = size;
+	return true;
+}
 
-	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_map_get_proc);
-	string_map_set(&m->gen_procs, proc_name, p);
+gb_internal void lb_diagnostic_handler(LLVMDiagnosticInfoRef info, void *user_data) {
+	gb_unused(user_data);
+	char *desc = LLVMGetDiagInfoDescription(info);
+	defer (LLVMDisposeMessage(desc));
 
-	p->internal_gen_type = type;
+	String msg = make_string_c(desc);
+	String fallback_prefix = str_lit("Instruction selection used fallback path for ");
+	if (string_starts_with(msg, fallback_prefix)) {
+		String name = substring(msg, fallback_prefix.len, msg.len);
+		mpsc_enqueue(&global_isel_fallbacks, copy_string(permanent_allocator(), name));
+		return;
+	}
 
-	lb_begin_procedure_body(p);
-	defer (lb_end_procedure_body(p));
+	lbStackUsage stack_usage = {};
+	if (lb_parse_stack_usage(msg, &stack_usage)) {
+		stack_usage.name = copy_string(permanent_allocator(), stack_usage.name);
+		mpsc_enqueue(&global_stack_usages, stack_usage);
+		return;
+	}
 
-	LLVMSetLinkage(p->value, LLVMInternalLinkage);
-	lb_add_attribute_to_proc(m, p->value, "nounwind");
-	if (build_context.ODIN_DEBUG) {
-		lb_add_attribute_to_proc(m, p->value, "noinline");
+	switch (LLVMGetDiagInfoSeverity(info)) {
+	case LLVMDSRemark:
+		if (build_context.opt_remarks.len != 0) {
+			mpsc_enqueue(&global_opt_remarks, copy_string(permanent_allocator(), msg));
+		}
+		break;
+	case LLVMDSError:
+		gb_printf_err("LLVM error: %s\n", desc);
+		gb_exit(1);
+		break;
+	case LLVMDSWarning:
+		gb_printf_err("LLVM warning: %s\n", desc);
+		break;
+	default:
+		break;
 	}
+}
 
-	LLVMValueRef x = LLVMGetParam(p->value, 0);
-	LLVMValueRef y = LLVMGetParam(p->value, 1);
-	LLVMValueRef z = LLVMGetParam(p->value, 2);
-	lbValue map_ptr = {x, t_rawptr};
-	lbValue h       = {y, t_uintptr};
-	lbValue key_ptr = {z, t_rawptr};
+gb_internal void lb_print_isel_fallbacks(void) {
+	isize count = global_isel_fallbacks.count.load(std::memory_order_relaxed);
+	if (count == 0) {
+		return;
+	}
+	gb_printf_err("\nGlobalISel fell back to SelectionDAG for %td procedure%s\n", count, count == 1 ? "" : "s");
+	for (String name = {}; mpsc_dequeue(&global_isel_fallbacks, &name); /**/) {
+		if (build_context.show_more_timings) {
+			gb_printf_err("\t%.*s\n", LIT(name));
+		}
+	}
+}
 
-	LLVM_SET_VALUE_NAME(h.value, "hash");
+struct lbOptRemark {
+	String file;
+	i32    line;
+	i32    column;
+	String message;
+};
 
-	lb_add_proc_attribute_at_index(p, 1+0, "nonnull");
-	lb_add_proc_attribute_at_index(p, 1+0, "readonly");
+// NOTE: LLVM prints the location of a remark as "file:line:column: ", or "<unknown>:0:0: "
+// when the instruction has no debug location, and the file may itself contain colons
+gb_internal lbOptRemark lb_parse_opt_remark(String desc) {
+	lbOptRemark r = {};
+	r.message = desc;
+	for (isize i = 0; i+1 < desc.len; i++) {
+		if (desc[i] != ':' || desc[i+1] != ' ') {
+			continue;
+		}
+		isize column_end = i;
+		isize column_start = column_end;
+		while (column_start > 0 && gb_char_is_digit(desc[column_start-1])) {
+			column_start -= 1;
+		}
+		if (column_start == column_end || column_start == 0 || desc[column_start-1] != ':') {
+			continue;
+		}
+		isize line_end = column_start-1;
+		isize line_start = line_end;
+		while (line_start > 0 && gb_char_is_digit(desc[line_start-1])) {
+			line_start -= 1;
+		}
+		if (line_start == line_end || line_start == 0 || desc[line_start-1] != ':') {
+			continue;
+		}
+		r.file    = substring(desc, 0, line_start-1);
+		r.line    = cast(i32)u64_from_string(substring(desc, line_start, line_end));
+		r.column  = cast(i32)u64_from_string(substring(desc, column_start, column_end));
+		r.message = substring(desc, i+2, desc.len);
+		if (r.file == "<unknown>") {
+			r.file = {};
+		}
+		break;
+	}
+	return r;
+}
+
+gb_internal int lb_opt_remark_cmp(void const *a, void const *b) {
+	lbOptRemark const *x = cast(lbOptRemark const *)a;
+	lbOptRemark const *y = cast(lbOptRemark const *)b;
+	if (int cmp = string_compare(x->file, y->file)) {
+		return cmp;
+	}
+	if (x->line != y->line) {
+		return x->line < y->line ? -1 : +1;
+	}
+	if (x->column != y->column) {
+		return x->column < y->column ? -1 : +1;
+	}
+	return string_compare(x->message, y->message);
+}
+
+gb_internal void lb_print_opt_remarks(void) {
+	if (build_context.opt_remarks.len == 0) {
+		return;
+	}
+
+	auto remarks = array_make<lbOptRemark>(heap_allocator(), 0, global_opt_remarks.count.load(std::memory_order_relaxed));
+	defer (array_free(&remarks));
+	for (String desc = {}; mpsc_dequeue(&global_opt_remarks, &desc); /**/) {
+		array_add(&remarks, lb_parse_opt_remark(desc));
+	}
+	gb_sort_array(remarks.data, remarks.count, lb_opt_remark_cmp);
+
+	// NOTE: the same remark is emitted once per module for a procedure inlined into several of them
+	isize count = 0;
+	for (lbOptRemark const &r : remarks) {
+		if (count > 0 && lb_opt_remark_cmp(&remarks[count-1], &r) == 0) {
+			continue;
+		}
+		remarks[count++] = r;
+	}
+	remarks.count = count;
+
+	if (build_context.opt_remarks_file.len != 0) {
+		char const *path = alloc_cstring(temporary_allocator(), build_context.opt_remarks_file);
+		gbFile f = {};
+		if (gb_file_create(&f, path) != gbFileError_None) {
+			gb_printf_err("Failed to create -opt-remarks-file: %s\n", path);
+			return;
+		}
+		defer (gb_file_close(&f));
+
+		gb_fprintf(&f, "[");
+		for_array(i, remarks) {
+			lbOptRemark const &r = remarks[i];
+			gb_fprintf(&f, "%s\n\t{\"file\": ", i == 0 ? "" : ",");
+			trace__write_json_string(&f, r.file);
+			gb_fprintf(&f, ", \"line\": %d, \"column\": %d, \"message\": ", r.line, r.column);
+			trace__write_json_string(&f, r.message);
+			gb_fprintf(&f, "}");
+		}
+		gb_fprintf(&f, "\n]\n");
+		return;
+	}
+
+	for (lbOptRemark const &r : remarks) {
+		if (r.file.len != 0) {
+			gb_printf_err("%.*s(%d:%d) Remark: %.*s\n", LIT(r.file), r.line, r.column, LIT(r.message));
+		} else {
+			gb_printf_err("Remark: %.*s\n", LIT(r.message));
+		}
+	}
+}
+
+gb_internal lbValue lb_map_get_proc_for_type(lbModule *m, Type *type) {
+	GB_ASSERT(!build_context.dynamic_map_calls);
+	type = base_type(type);
+	GB_ASSERT(type->kind == Type_Map);
+
+	String proc_name = lb_internal_gen_name_from_type("__$map_get", type);
+	lbProcedure **found = string_map_get(&m->gen_procs, proc_name);
+	if (found) {
+		GB_ASSERT(*found != nullptr);
+		return {(*found)->value, (*found)->type};
+	}
+	if (!lb_generated_helper_claim_definition(m, proc_name)) {
+		lbProcedure *p = lb_declare_generated_helper(m, proc_name, t_map_get_proc);
+		return {p->value, p->type};
+	}
+
+	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_map_get_proc);
+	string_map_set(&m->gen_procs, proc_name, p);
+
+	p->internal_gen_type = type;
+
+	lb_begin_procedure_body(p);
+	defer (lb_end_procedure_body(p));
+
+	lb_set_generated_helper_linkage(p);
+	LLVMSetUnnamedAddress(p->value, LLVMGlobalUnnamedAddr);
+	lb_add_attribute_to_proc(m, p->value, "nounwind");
+	if (build_context.ODIN_DEBUG) {
+		lb_add_attribute_to_proc(m, p->value, "noinline");
+	}
+
+	LLVMValueRef x = LLVMGetParam(p->value, 0);
+	LLVMValueRef y = LLVMGetParam(p->value, 1);
+	LLVMValueRef z = LLVMGetParam(p->value, 2);
+	lbValue map_ptr = {x, t_rawptr};
+	lbValue h       = {y, t_uintptr};
+	lbValue key_ptr = {z, t_rawptr};
+
+	LLVM_SET_VALUE_NAME(h.value, "hash");
+
+	lb_add_proc_attribute_at_index(p, 1+0, "nonnull");
+	lb_add_proc_attribute_at_index(p, 1+0, "readonly");
 
 	lb_add_proc_attribute_at_index(p, 1+2, "nonnull");
 	lb_add_proc_attribute_at_index(p, 1+2, "readonly");
@@ -833,13 +1544,18 @@ gb_internal lbValue lb_map_set_proc_for_type(lbModule *m, Type *type) {
 		GB_ASSERT(*found != nullptr);
 		return {(*found)->value, (*found)->type};
 	}
+	if (!lb_generated_helper_claim_definition(m, proc_name)) {
+		lbProcedure *p = lb_declare_generated_helper(m, proc_name, t_map_set_proc);
+		return {p->value, p->type};
+	}
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_map_set_proc);
 	string_map_set(&m->gen_procs, proc_name, p);
 	lb_begin_procedure_body(p);
 	defer (lb_end_procedure_body(p));
 
-	LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	lb_set_generated_helper_linkage(p);
+	LLVMSetUnnamedAddress(p->value, LLVMGlobalUnnamedAddr);
 	lb_add_attribute_to_proc(m, p->value, "nounwind");
 	if (build_context.ODIN_DEBUG) {
 		lb_add_attribute_to_proc(m, p->value, "noinline");
@@ -1097,6 +1813,82 @@ gb_internal lbValue lb_gen_map_key_hash(lbProcedure *p, lbValue const &map_ptr,
 	return hashed_key;
 }
 
+gb_internal bool lb_map_key_has_inline_get_fast_path(Type *key_type) {
+	Type *k = core_type(key_type);
+	if (type_size_of(k) > build_context.ptr_size) {
+		return false;
+	}
+	return is_type_integer(k) ||
+	       is_type_enum(k) ||
+	       is_type_pointer(k) ||
+	       is_type_multi_pointer(k) ||
+	       is_type_typeid(k);
+}
+
+// NOTE: Emits the first probe of `__$map_get` at the call site: if the desired slot holds the
+// same hash and key, the value pointer is used directly, otherwise fall back to the full lookup
+gb_internal lbValue lb_map_get_inline_first_probe(lbProcedure *p, Type *map_type, lbValue map_ptr, lbValue hash, lbValue key_ptr) {
+	lbModule *m = p->module;
+
+	lbBlock *probe_block = lb_create_block(p, "map.get.probe");
+	lbBlock *key_block   = lb_create_block(p, "map.get.key");
+	lbBlock *hit_block   = lb_create_block(p, "map.get.hit");
+	lbBlock *miss_block  = lb_create_block(p, "map.get.miss");
+	lbBlock *done_block  = lb_create_block(p, "map.get.done");
+
+	lbAddr res = lb_add_local_generated(p, t_rawptr, true);
+
+	lbValue map = lb_emit_load(p, lb_emit_conv(p, map_ptr, t_raw_map_ptr));
+	lbValue length = lb_map_len(p, map);
+	lb_emit_if(p, lb_emit_comp(p, Token_CmpEq, length, lb_const_nil(m, t_int)), done_block, probe_block);
+
+	lb_start_block(p, probe_block);
+	lbValue capacity = lb_map_cap(p, map);
+	lbValue mask = lb_emit_conv(p, lb_emit_arith(p, Token_Sub, capacity, lb_const_int(m, t_int, 1), t_int), t_uintptr);
+	lbValue pos = lb_emit_arith(p, Token_And, hash, mask, t_uintptr);
+
+	lbValue ks = lb_map_data_uintptr(p, map);
+	lbValue vs = lb_map_cell_index_static(p, map_type->Map.key, ks, capacity);
+	lbValue hs = lb_map_cell_index_static(p, map_type->Map.value, vs, capacity);
+	hs = lb_emit_conv(p, hs, alloc_type_pointer(t_uintptr));
+
+	lbValue element_hash = lb_emit_load(p, lb_emit_ptr_offset(p, hs, pos));
+	lb_emit_if(p, lb_emit_comp(p, Token_CmpEq, element_hash, hash), key_block, miss_block);
+
+	lb_start_block(p, key_block);
+	{
+		Type *key_ptr_type = alloc_type_pointer(map_type->Map.key);
+		lbValue element_key = lb_map_cell_index_static(p, map_type->Map.key, ks, pos);
+		element_key = lb_emit_conv(p, element_key, key_ptr_type);
+		lbValue key = lb_emit_load(p, lb_emit_conv(p, key_ptr, key_ptr_type));
+		lbValue cond = lb_emit_comp(p, Token_CmpEq, lb_emit_load(p, element_key), key);
+		lb_emit_if(p, cond, hit_block, miss_block);
+	}
+
+	lb_start_block(p, hit_block);
+	{
+		lbValue element_value = lb_map_cell_index_static(p, map_type->Map.value, vs, pos);
+		lb_addr_store(p, res, lb_emit_conv(p, element_value, t_rawptr));
+		lb_emit_jump(p, done_block);
+	}
+
+	lb_start_block(p, miss_block);
+	{
+		TEMPORARY_ALLOCATOR_GUARD();
+		lbValue map_get_proc = lb_map_get_proc_for_type(m, map_type);
+
+		auto args = array_make<lbValue>(temporary_allocator(), 3);
+		args[0] = lb_emit_conv(p, map_ptr, t_rawptr);
+		args[1] = hash;
+		args[2] = key_ptr;
+		lb_addr_store(p, res, lb_emit_call(p, map_get_proc, args));
+		lb_emit_jump(p, done_block);
+	}
+
+	lb_start_block(p, done_block);
+	return lb_addr_load(p, res);
+}
+
 gb_internal lbValue lb_internal_dynamic_map_get_ptr(lbProcedure *p, lbValue const &map_ptr, lbValue const &key) {
 	TEMPORARY_ALLOCATOR_GUARD();
 
@@ -1115,6 +1907,8 @@ gb_internal lbValue lb_internal_dynamic_map_get_ptr(lbProcedure *p, lbValue cons
 		args[3] = key_ptr;
 
 		ptr = lb_emit_runtime_call(p, "__dynamic_map_get", args);
+	} else if (build_context.optimization_level > 0 && lb_map_key_has_inline_get_fast_path(map_type->Map.key)) {
+		ptr = lb_map_get_inline_first_probe(p, map_type, map_ptr, hash, key_ptr);
 	} else {
 		lbValue map_get_proc = lb_map_get_proc_for_type(p->module, map_type);
 
@@ -2026,6 +2820,24 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_verification_worker_proc) {
 }
 
 gb_internal bool lb_init_global_var(lbModule *m, lbProcedure *p, Entity *e, Ast *init_expr, lbGlobalVariable &var) {
+	if (init_expr != nullptr && !var.is_initialized && !is_type_any(e->type)) {
+		auto cc = LB_CONST_CONTEXT_DEFAULT_NO_LOCAL;
+		cc.is_rodata = e->Variable.is_rodata;
+		cc.link_section = e->Variable.link_section;
+
+		LLVMValueRef init = nullptr;
+		if (lb_const_global_init_value(m, e->type, init_expr, cc, &init) &&
+		    LLVMTypeOf(init) == llvm_addr_type(m, var.var)) {
+			LLVMSetInitializer(var.var.value, init);
+			var.is_initialized = true;
+
+			if (e->Variable.is_rodata) {
+				LLVMSetGlobalConstant(var.var.value, true);
+			}
+			return true;
+		}
+	}
+
 	if (init_expr != nullptr)  {
 		lbValue init = lb_build_expr(p, init_expr);
 		if (init.value == nullptr) {
@@ -2107,14 +2919,13 @@ gb_internal bool lb_init_global_var(lbModule *m, lbProcedure *p, Entity *e, Ast
 gb_internal void lb_create_startup_runtime_generate_body(lbModule *m, lbProcedure *p) {
 	lb_begin_procedure_body(p);
 
-	lb_setup_type_info_data(m);
-
 	if (p->objc_names) {
 		LLVMBuildCall2(p->builder, lb_type_internal_for_procedures_raw(m, p->objc_names->type), p->objc_names->value, nullptr, 0, "");
 	}
 	Type *dummy_type = alloc_type_proc(nullptr, nullptr, 0, nullptr, 0, false, ProcCC_Odin);
 	LLVMTypeRef raw_dummy_type = lb_type_internal_for_procedures_raw(m, dummy_type);
 
+	isize dynamic_init_count = 0;
 	for (auto &var : *p->global_variables) {
 		if (var.is_initialized) {
 			continue;
@@ -2152,6 +2963,20 @@ gb_internal void lb_create_startup_runtime_generate_body(lbModule *m, lbProcedur
 		} else {
 			lb_init_global_var(m, p, e, init_expr, var);
 		}
+
+		if (build_context.show_global_init_report && var.init.value != nullptr) {
+			if (dynamic_init_count++ == 0) {
+				gb_printf("Global variables initialized at startup (size in bytes):\n");
+			}
+			gbString type_str = type_to_string(e->type);
+			gb_printf("%12lld  %s %.*s: %s\n",
+			          cast(long long)type_size_of(e->type),
+			          token_pos_to_string(e->token.pos), LIT(e->token.string), type_str);
+			gb_string_free(type_str);
+		}
+	}
+	if (dynamic_init_count > 0) {
+		gb_printf("%12lld total\n\n", cast(long long)dynamic_init_count);
 	}
 	CheckerInfo *info = m->gen->info;
 
@@ -2221,6 +3046,7 @@ gb_internal lbProcedure *lb_create_cleanup_runtime(lbModule *main_module) { // C
 
 gb_internal WORKER_TASK_PROC(lb_generate_procedures_and_types_per_module) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("lb_generate_procedures_and_types", make_string_c(m->module_name));
 	for (Entity *e : m->global_types_to_create) {
 		(void)lb_get_entity_name(m, e);
 		(void)lb_type(m, e->type);
@@ -2309,97 +3135,1068 @@ gb_internal void lb_create_global_procedures_and_types(lbGenerator *gen, Checker
 				// Do not generate declarations for foreign Objective-C methods. These are called indirectly through the Objective-C runtime.
 				continue;
 			}
-
-			array_add(&m->global_procedures_to_create, e);
-		} else if (e->kind == Entity_TypeName) {
-			array_add(&m->global_types_to_create, e);
+
+			array_add(&m->global_procedures_to_create, e);
+		} else if (e->kind == Entity_TypeName) {
+			array_add(&m->global_types_to_create, e);
+		}
+	}
+
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		array_sort(m->global_types_to_create, llvm_global_entity_cmp);
+		array_sort(m->global_procedures_to_create, llvm_global_entity_cmp);
+	}
+
+	if (do_threading) {
+		for (auto const &entry : gen->modules) {
+			lbModule *m = entry.value;
+			thread_pool_add_task(lb_generate_procedures_and_types_per_module, m);
+		}
+	} else {
+		for (auto const &entry : gen->modules) {
+			lbModule *m = entry.value;
+			lb_generate_procedures_and_types_per_module(m);
+		}
+
+	}
+
+	thread_pool_wait();
+}
+
+gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p);
+
+
+gb_internal bool lb_is_module_empty(lbModule *m) {
+	if (LLVMGetFirstFunction(m->mod) == nullptr &&
+	    LLVMGetFirstGlobal(m->mod) == nullptr) {
+		return true;
+	}
+	for (auto fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
+		if (LLVMGetFirstBasicBlock(fn) != nullptr) {
+			return false;
+		}
+	}
+
+	for (auto g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+		LLVMLinkage linkage = LLVMGetLinkage(g);
+		if (linkage == LLVMExternalLinkage ||
+		    linkage == LLVMWeakAnyLinkage) {
+			continue;
+		}
+		if (!LLVMIsExternallyInitialized(g)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// NOTE: A cheap estimate of how long the LLVM passes and emission of a module will take,
+// used to start the largest modules first
+gb_internal u64 lb_module_size_hint(lbModule *m) {
+	u64 size = 0;
+	for (auto fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
+		size += 1 + LLVMCountBasicBlocks(fn);
+	}
+	return size;
+}
+
+// NOTE: A rough and deliberately generous estimate of the peak memory of optimizing or emitting a
+// module, derived from the size hint (the number of procedures and basic blocks). It only needs to be
+// good enough to stop -max-memory from admitting too many large modules at once.
+gb_internal i64 lb_module_memory_estimate(u64 size_hint) {
+	i64 const base_bytes      = 16ll*1024*1024;
+	i64 const bytes_per_block = 32ll*1024;
+	return base_bytes + cast(i64)size_hint*bytes_per_block;
+}
+
+gb_global MemoryBudget lb_module_memory_budget;
+
+// NOTE: Every per-module task of the LLVM phases goes through here, so that -max-memory can hold back
+// the tasks which would not fit in the budget, and -pin-threads can give each task a core of its own
+gb_internal void lb_add_module_tasks(Slice<WorkerTaskWithSize> tasks) {
+	if (global_core_slots.free_cpus != nullptr) {
+		core_slots_wrap_tasks(&global_core_slots, tasks);
+	}
+	if (build_context.max_memory <= 0) {
+		thread_pool_add_tasks_largest_first(tasks);
+		return;
+	}
+	lb_module_memory_budget.limit = build_context.max_memory;
+	for (WorkerTaskWithSize &t : tasks) {
+		t.memory_estimate = lb_module_memory_estimate(t.size_hint);
+	}
+	thread_pool_add_tasks_within_memory_budget(&global_thread_pool, nullptr, &lb_module_memory_budget, tasks);
+}
+
+struct lbLLVMEmitWorker {
+	LLVMTargetMachineRef target_machine;
+	LLVMCodeGenFileType code_gen_file_type;
+	String filepath_obj;
+	lbModule *m;
+};
+
+// NOTE: Emits the object into memory and only writes it out when it differs from the object
+// already on disk, so an unchanged object is never rewritten (and rescanned) between builds
+gb_internal bool lb_emit_object_via_memory(LLVMTargetMachineRef target_machine, LLVMModuleRef mod, LLVMCodeGenFileType code_gen_file_type, String filepath, char **llvm_error) {
+	LLVMMemoryBufferRef buffer = nullptr;
+	if (LLVMTargetMachineEmitToMemoryBuffer(target_machine, mod, code_gen_file_type, llvm_error, &buffer)) {
+		return false;
+	}
+	defer (LLVMDisposeMemoryBuffer(buffer));
+
+	void const *data = LLVMGetBufferStart(buffer);
+	isize       size = cast(isize)LLVMGetBufferSize(buffer);
+
+	char const *filepath_c = cast(char const *)filepath.text;
+	{
+		gbFileContents prev = gb_file_read_contents(heap_allocator(), false, filepath_c);
+		defer (gb_file_free_contents(&prev));
+		if (prev.data != nullptr && prev.size == size && gb_memcompare(prev.data, data, size) == 0) {
+			debugf("Object file unchanged: %.*s\n", LIT(filepath));
+			return true;
+		}
+	}
+
+	gbFile f = {};
+	if (gb_file_create(&f, filepath_c) != gbFileError_None) {
+		*llvm_error = LLVMCreateMessage(cast(char *)"unable to create the object file");
+		return false;
+	}
+	defer (gb_file_close(&f));
+	if (!gb_file_write(&f, data, size)) {
+		*llvm_error = LLVMCreateMessage(cast(char *)"unable to write the object file");
+		return false;
+	}
+	return true;
+}
+
+gb_internal bool lb_emit_object(LLVMTargetMachineRef target_machine, LLVMModuleRef mod, LLVMCodeGenFileType code_gen_file_type, String filepath, char **llvm_error) {
+	if (build_context.emit_to_memory) {
+		return lb_emit_object_via_memory(target_machine, mod, code_gen_file_type, filepath, llvm_error);
+	}
+	return !LLVMTargetMachineEmitToFile(target_machine, mod, cast(char *)filepath.text, code_gen_file_type, llvm_error);
+}
+
+gb_internal gbString lb_cached_object_path(char const *prefix, u64 hash) {
+	BuildCacheData *bcd = &build_context.build_cache_data;
+	String ext = infer_object_extension_from_build_context();
+	gbString cached = gb_string_make(heap_allocator(), "");
+	cached = gb_string_append_fmt(cached, "%.*s/%s%016llx.%.*s", LIT(bcd->objects_dir), prefix, cast(unsigned long long)hash, LIT(ext));
+	return cached;
+}
+
+gb_internal void lb_store_cached_object(lbModule *m, char const *filepath_c, gbString cached) {
+	// NOTE: Copied under a unique name and then renamed, as another build may be storing the same object
+	gbString temp = gb_string_make(heap_allocator(), cached);
+	defer (gb_string_free(temp));
+	temp = gb_string_append_fmt(temp, ".%p.tmp", m);
+	if (!gb_file_copy(filepath_c, temp, false) || !gb_file_move(temp, cached)) {
+		gb_file_remove(temp);
+	}
+}
+
+// NOTE: An `.incbin`ed file is referenced by its path, so the IR of its module does not change with its contents
+gb_internal bool lb_module_object_cacheable(lbModule *m) {
+	return build_context.build_cache_data.objects_dir.len != 0 && m->incbin_data.count == 0 && !lb_gathers_stack_usage(m);
+}
+
+// NOTE: With -cached, the object of each module is also kept under a hash of its IR from before the module
+// passes (along with the pass pipeline and the linkage corrections which are applied to it afterwards). When
+// an edit does not change the IR of a module at all, e.g. formatting or a change to an unrelated package,
+// that module is then neither optimized nor emitted, see `lb_emit_object_cached`
+gb_internal bool lb_llvm_module_find_cached_object(lbModule *m, gbString passes_str) {
+	if (!lb_module_object_cacheable(m) ||
+	    build_context.lto_kind != LTO_None ||
+	    build_context.build_mode == BuildMode_Assembly ||
+	    build_context.build_mode == BuildMode_LLVM_IR ||
+	    build_context.keep_temp_files ||
+	    build_context.show_code_size ||
+	    build_context.build_diagnostics ||
+	    build_context.jit) {
+		return false;
+	}
+	BuildCacheData *bcd = &build_context.build_cache_data;
+
+	LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(m->mod);
+	u64 hash = xxh64(LLVMGetBufferStart(bitcode), cast(isize)LLVMGetBufferSize(bitcode), bcd->objects_config_hash);
+	LLVMDisposeMemoryBuffer(bitcode);
+	hash = xxh64(passes_str, gb_string_length(passes_str), hash);
+	hash = xxh64(&m->linkage_corrections_hash, gb_size_of(m->linkage_corrections_hash), hash);
+	m->unoptimized_object_hash = hash ? hash : 1;
+
+	gbString cached = lb_cached_object_path("u", m->unoptimized_object_hash);
+	if (!gb_file_exists(cached)) {
+		gb_string_free(cached);
+		return false;
+	}
+	m->unoptimized_cached_object = make_string_c(cached);
+	return true;
+}
+
+// NOTE: With -cached, the object of each module is kept in `.odin-cache/objects` under the hash of the module's
+// bitcode, so the packages which did not change, e.g. `base:runtime` and most of `core`, skip code generation
+// entirely and their previous object is copied into place instead
+gb_internal bool lb_emit_object_cached(lbModule *m, LLVMCodeGenFileType code_gen_file_type, String filepath, char **llvm_error) {
+	char const *filepath_c = cast(char const *)filepath.text;
+	if (m->unoptimized_cached_object.len != 0) {
+		char const *cached = cast(char const *)m->unoptimized_cached_object.text;
+		if (!gb_file_copy(cached, filepath_c, false)) {
+			// NOTE: the module has not been optimized, so it cannot be emitted instead
+			*llvm_error = LLVMCreateMessage(cast(char *)"unable to copy the cached object file");
+			return false;
+		}
+		debugf("Cache: unoptimized object hit %s for %.*s\n", cached, LIT(filepath));
+		return true;
+	}
+
+	if (!lb_module_object_cacheable(m) || code_gen_file_type != LLVMObjectFile) {
+		return lb_emit_object(m->target_machine, m->mod, code_gen_file_type, filepath, llvm_error);
+	}
+	BuildCacheData *bcd = &build_context.build_cache_data;
+
+	LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(m->mod);
+	u64 hash = xxh64(LLVMGetBufferStart(bitcode), cast(isize)LLVMGetBufferSize(bitcode), bcd->objects_config_hash);
+	LLVMDisposeMemoryBuffer(bitcode);
+
+	gbString cached = lb_cached_object_path("", hash);
+	defer (gb_string_free(cached));
+
+	if (gb_file_exists(cached) && gb_file_copy(cached, filepath_c, false)) {
+		debugf("Cache: object hit %s for %.*s\n", cached, LIT(filepath));
+	} else {
+		if (!lb_emit_object(m->target_machine, m->mod, code_gen_file_type, filepath, llvm_error)) {
+			return false;
+		}
+		lb_store_cached_object(m, filepath_c, cached);
+	}
+
+	if (m->unoptimized_object_hash != 0) {
+		gbString unoptimized = lb_cached_object_path("u", m->unoptimized_object_hash);
+		defer (gb_string_free(unoptimized));
+		lb_store_cached_object(m, filepath_c, unoptimized);
+	}
+	return true;
+}
+
+// NOTE: Nothing needs the LLVM state of a module once its object has been emitted, so it is released
+// straight away rather than at exit, keeping the peak memory of a separate module build to roughly
+// the modules which are still being optimized and emitted. -show-code-size maps the emitted symbols
+// back to their entities through the module's values afterwards, so that keeps everything alive.
+gb_internal void lb_release_module(lbModule *m) {
+	if (build_context.show_stats) {
+		lb_gather_module_stats(m);
+	}
+	if (build_context.show_code_size) {
+		return;
+	}
+
+	for (i32 i = 0; i < lbFunctionPassManager_COUNT; i++) {
+		if (m->function_pass_managers[i] != nullptr) {
+			LLVMDisposePassManager(m->function_pass_managers[i]);
+			m->function_pass_managers[i] = nullptr;
+		}
+	}
+	if (m->debug_builder != nullptr) {
+		LLVMDisposeDIBuilder(m->debug_builder);
+		m->debug_builder = nullptr;
+	}
+	if (m->const_dummy_builder != nullptr) {
+		LLVMDisposeBuilder(m->const_dummy_builder);
+		m->const_dummy_builder = nullptr;
+	}
+
+	LLVMDisposeModule(m->mod);
+	m->mod = nullptr;
+	LLVMDisposeTargetMachine(m->target_machine);
+	m->target_machine = nullptr;
+	LLVMContextDispose(m->ctx);
+	m->ctx = nullptr;
+
+	map_destroy(&m->types);
+	map_destroy(&m->struct_field_remapping);
+	map_destroy(&m->func_raw_types);
+	map_destroy(&m->values);
+	map_destroy(&m->soa_values);
+	string_map_destroy(&m->members);
+	string_map_destroy(&m->procedures);
+	map_destroy(&m->procedure_values);
+	string_map_destroy(&m->const_strings);
+	map_destroy(&m->function_type_map);
+	string_map_destroy(&m->gen_procs);
+	map_destroy(&m->debug_values);
+	map_destroy(&m->exact_value_compound_literal_addr_map);
+	array_free(&m->generated_procedures);
+}
+
+gb_internal i32 system_exec_argv(char const *name, char const **argv);
+
+gb_global std::atomic<bool> lb_thin_lto_summary_warned;
+
+// NOTE: The LLVM-C API can only write bitcode without a module summary, and the linker treats any module
+// without one as a regular (full) LTO module, whatever -flto= it is given. So for the thin modes, clang
+// (or ODIN_CLANG_PATH) rewrites the bitcode with the summary, which is what the ThinLTO importing and its
+// cache are keyed on. clang runs at -O0 as the ThinLTO pre-link pipeline has already been run.
+gb_internal bool lb_write_lto_bitcode(lbModule *m, String filepath_obj) {
+	char const *filepath_c = cast(char const *)filepath_obj.text;
+	if (build_context.lto_kind == LTO_Full) {
+		return LLVMWriteBitcodeToFile(m->mod, filepath_c) == 0;
+	}
+
+	TEMPORARY_ALLOCATOR_GUARD();
+	String prelink = concatenate_strings(temporary_allocator(), filepath_obj, str_lit(".prelink.bc"));
+	char const *prelink_c = alloc_cstring(temporary_allocator(), prelink);
+	if (LLVMWriteBitcodeToFile(m->mod, prelink_c)) {
+		return false;
+	}
+	defer (gb_file_remove(prelink_c));
+
+	char const *clang_path = gb_get_env("ODIN_CLANG_PATH", temporary_allocator());
+	if (clang_path == nullptr) {
+		clang_path = "clang";
+	}
+	char const *target_c = alloc_cstring(temporary_allocator(), build_context.metrics.target_triplet);
+	char const *argv[] = {
+		clang_path, "-c", "-flto=thin", "-O0",
+		"-Wno-override-module", "-Wno-unused-command-line-argument",
+		"-target", target_c,
+		"-x", "ir", prelink_c,
+		"-o", filepath_c,
+		nullptr,
+	};
+	if (system_exec_argv("clang", argv) == 0) {
+		return true;
+	}
+
+	if (!lb_thin_lto_summary_warned.exchange(true)) {
+		gb_printf_err("Warning: clang could not add the ThinLTO summaries to the bitcode, so the modules will be linked with full LTO (set ODIN_CLANG_PATH to the clang to use)\n");
+	}
+	return gb_file_copy(prelink_c, filepath_c, false);
+}
+
+gb_internal WORKER_TASK_PROC(lb_llvm_emit_worker_proc) {
+	GB_ASSERT(MULTITHREAD_OBJECT_GENERATION);
+
+	char *llvm_error = nullptr;
+
+	auto wd = cast(lbLLVMEmitWorker *)data;
+	TRACE_SCOPE("lb_llvm_emit", wd->filepath_obj);
+
+	if (build_context.lto_kind != LTO_None) {
+		if (!lb_write_lto_bitcode(wd->m, wd->filepath_obj)) {
+			gb_printf_err("Failed to write bitcode file: %.*s\n", LIT(wd->filepath_obj));
+			exit_with_errors();
+		}
+	} else if (!lb_emit_object_cached(wd->m, wd->code_gen_file_type, wd->filepath_obj, &llvm_error)) {
+		gb_printf_err("LLVM Error: %s\n", llvm_error);
+		exit_with_errors();
+	}
+	debugf("Generated File: %.*s\n", LIT(wd->filepath_obj));
+	lb_release_module(wd->m);
+	return 0;
+}
+
+
+gb_internal isize lb_count_instructions(LLVMValueRef fn) {
+	isize instruction_count = 0;
+	for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+		for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+			instruction_count += 1;
+		}
+	}
+	return instruction_count;
+}
+
+gb_internal void lb_gather_module_stats(lbModule *m) {
+	if (m->stats.gathered || m->mod == nullptr) {
+		return;
+	}
+	m->stats.gathered = true;
+	for (LLVMValueRef fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
+		if (!LLVMIsDeclaration(fn)) {
+			m->stats.functions += 1;
+			m->stats.instructions += lb_count_instructions(fn);
+		}
+	}
+	for (LLVMValueRef g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+		m->stats.globals += 1;
+	}
+}
+
+gb_internal void lb_record_polymorphic_instance(lbProcedure *p) {
+	lbPolymorphicInstance instance = {};
+	instance.ir_instructions = lb_count_instructions(p->value);
+
+	// NOTE: hash everything after the signature so that the differing names of the instantiations are ignored
+	char *text = LLVMPrintValueToString(p->value);
+	char *body = strchr(text, '{');
+	if (body != nullptr) {
+		instance.body_hash = xxh64(body, gb_strlen(body));
+	}
+	LLVMDisposeMessage(text);
+
+	concurrent_map_set(&global_polymorphic_instances, p->entity, instance);
+}
+
+gb_internal void lb_llvm_function_pass_per_function_internal(lbModule *module, lbProcedure *p, lbFunctionPassManagerKind pass_manager_kind = lbFunctionPassManager_default) {
+	LLVMPassManagerRef pass_manager = module->function_pass_managers[pass_manager_kind];
+	if (build_context.proc_cost_report && p != nullptr && p->entity != nullptr) {
+		isize instruction_count = lb_count_instructions(p->value);
+
+		u64 start = time_stamp_time_now();
+		lb_run_function_pass_manager(pass_manager, p, pass_manager_kind);
+		u64 pass_time = time_stamp_time_now() - start;
+
+		ProcCostInfo *info = proc_cost_info(p->entity);
+		info->ir_instructions.fetch_add(instruction_count, std::memory_order_relaxed);
+		info->pass_time.fetch_add(pass_time, std::memory_order_relaxed);
+	} else {
+		lb_run_function_pass_manager(pass_manager, p, pass_manager_kind);
+	}
+
+	if (build_context.polymorphic_report && p != nullptr && p->entity != nullptr &&
+	    p->entity->kind == Entity_Procedure && p->entity->Procedure.generated_from_polymorphic) {
+		lb_record_polymorphic_instance(p);
+	}
+}
+
+struct lbPolymorphicReportEntry {
+	Entity *         entity;
+	Array<Entity *> *instances;
+	isize            ir_instructions;
+	isize            identical;
+};
+
+struct lbPolymorphicReportInstance {
+	Entity *entity;
+	u64     body_hash;
+};
+
+gb_internal void lb_print_polymorphic_report(CheckerInfo *info, isize top_count) {
+	auto entries = array_make<lbPolymorphicReportEntry>(heap_allocator());
+	defer (array_free(&entries));
+
+	for (Entity *e : info->entities) {
+		lbPolymorphicReportEntry entry = {e};
+		if (e->kind == Entity_Procedure && e->Procedure.gen_procs != nullptr) {
+			entry.instances = &e->Procedure.gen_procs->procs;
+		} else if (e->kind == Entity_TypeName && e->type != nullptr && e->type->kind == Type_Named && e->type->Named.gen_types_data != nullptr) {
+			entry.instances = &e->type->Named.gen_types_data->types;
+		}
+		if (entry.instances == nullptr || entry.instances->count == 0) {
+			continue;
+		}
+		for (Entity *inst : *entry.instances) {
+			lbPolymorphicInstance instance = {};
+			if (concurrent_map_get(&global_polymorphic_instances, inst, &instance)) {
+				entry.ir_instructions += instance.ir_instructions;
+			}
+		}
+		array_add(&entries, entry);
+	}
+
+	gb_sort_array(entries.data, entries.count, [](void const *a, void const *b) -> int {
+		auto const *x = cast(lbPolymorphicReportEntry const *)a;
+		auto const *y = cast(lbPolymorphicReportEntry const *)b;
+		if (x->instances->count != y->instances->count) {
+			return x->instances->count < y->instances->count ? +1 : -1;
+		}
+		return x->ir_instructions < y->ir_instructions ? +1 : x->ir_instructions > y->ir_instructions ? -1 : 0;
+	});
+
+	gb_printf("Polymorphic instantiations (top %td of %td)\n", gb_min(top_count, entries.count), entries.count);
+	for (isize i = 0; i < gb_min(top_count, entries.count); i++) {
+		lbPolymorphicReportEntry *entry = &entries[i];
+		Entity *e = entry->entity;
+
+		gb_printf("\n\t%.*s (%s) - %td instantiations, %td instructions\n",
+		          LIT(e->token.string), token_pos_to_string(e->token.pos),
+		          entry->instances->count, entry->ir_instructions);
+
+		auto instances = array_make<lbPolymorphicReportInstance>(heap_allocator(), 0, entry->instances->count);
+		defer (array_free(&instances));
+
+		for (Entity *inst : *entry->instances) {
+			lbPolymorphicInstance instance = {};
+			bool found = concurrent_map_get(&global_polymorphic_instances, inst, &instance);
+
+			gbString params = type_to_string(inst->type);
+			if (found) {
+				gb_printf("\t\t%6td  %s\n", instance.ir_instructions, params);
+				if (instance.body_hash != 0) {
+					array_add(&instances, lbPolymorphicReportInstance{inst, instance.body_hash});
+				}
+			} else {
+				gb_printf("\t\t%6s  %s\n", "", params);
+			}
+			gb_string_free(params);
+		}
+
+		// NOTE: Instantiations whose lowered bodies are identical are candidates for merging
+		gb_sort_array(instances.data, instances.count, [](void const *a, void const *b) -> int {
+			u64 x = (cast(lbPolymorphicReportInstance const *)a)->body_hash;
+			u64 y = (cast(lbPolymorphicReportInstance const *)b)->body_hash;
+			return x < y ? -1 : x > y ? +1 : 0;
+		});
+		for (isize j = 0; j < instances.count; /**/) {
+			isize k = j+1;
+			while (k < instances.count && instances[k].body_hash == instances[j].body_hash) {
+				k += 1;
+			}
+			if (k-j > 1) {
+				gb_printf("\t\tidentical bodies:");
+				for (isize l = j; l < k; l++) {
+					gbString params = type_to_string(instances[l].entity->type);
+					gb_printf("%s %s", l == j ? "" : ",", params);
+					gb_string_free(params);
+				}
+				gb_printf("\n");
+			}
+			j = k;
+		}
+	}
+	gb_printf("\n");
+}
+
+struct lbCodeSizeSymbol {
+	char const *name;
+	char const *section;
+	u64         address;
+	u64         size;
+	bool        is_code;
+};
+
+struct lbCodeSizeEntry {
+	String  name;
+	Entity *entity;
+	u64     code;
+	u64     data;
+	isize   count;
+};
+
+gb_internal GB_COMPARE_PROC(lb_code_size_symbol_cmp) {
+	auto const *x = cast(lbCodeSizeSymbol const *)a;
+	auto const *y = cast(lbCodeSizeSymbol const *)b;
+	if (x->section != y->section) {
+		return x->section < y->section ? -1 : +1;
+	}
+	return x->address < y->address ? -1 : x->address > y->address ? +1 : 0;
+}
+
+gb_internal GB_COMPARE_PROC(lb_code_size_entry_cmp) {
+	auto const *x = cast(lbCodeSizeEntry const *)a;
+	auto const *y = cast(lbCodeSizeEntry const *)b;
+	u64 xs = x->code + x->data;
+	u64 ys = y->code + y->data;
+	return xs < ys ? +1 : xs > ys ? -1 : string_compare(x->name, y->name);
+}
+
+gb_internal bool lb_code_size_is_code_section(String const &name) {
+	return string_contains_string(name, str_lit("text")) || name == "CODE";
+}
+
+gb_internal bool lb_code_size_is_ignored_section(String const &name) {
+	return string_contains_string(name, str_lit("debug")) ||
+	       string_starts_with(name, str_lit(".rel")) ||
+	       string_starts_with(name, str_lit(".note")) ||
+	       string_starts_with(name, str_lit(".llvm")) ||
+	       name == ".comment" || name == ".symtab" || name == ".strtab" || name == ".shstrtab";
+}
+
+gb_internal void lb_code_size_add(StringMap<lbCodeSizeEntry> *map, String const &name, Entity *entity, lbCodeSizeSymbol const &sym) {
+	lbCodeSizeEntry *entry = string_map_get(map, name);
+	if (entry == nullptr) {
+		string_map_set(map, name, lbCodeSizeEntry{name, entity});
+		entry = string_map_get(map, name);
+	}
+	if (sym.is_code) {
+		entry->code += sym.size;
+	} else {
+		entry->data += sym.size;
+	}
+	entry->count += 1;
+}
+
+gb_internal void lb_code_size_print_entries(char const *title, StringMap<lbCodeSizeEntry> *map, isize top_count, bool show_count) {
+	auto entries = array_make<lbCodeSizeEntry>(heap_allocator(), 0, map->count);
+	defer (array_free(&entries));
+	for (auto const &entry : *map) {
+		array_add(&entries, entry.value);
+	}
+	array_sort(entries, lb_code_size_entry_cmp);
+
+	isize count = top_count > 0 ? gb_min(top_count, entries.count) : entries.count;
+	gb_printf("%s (top %td of %td):\n", title, count, entries.count);
+	gb_printf("%12s %12s %s %s\n", "code", "data", show_count ? "   count " : "", "name");
+	for (isize i = 0; i < count; i++) {
+		lbCodeSizeEntry const &e = entries[i];
+		if (show_count) {
+			gb_printf("%12llu %12llu %8td  %.*s", cast(unsigned long long)e.code, cast(unsigned long long)e.data, e.count, LIT(e.name));
+		} else {
+			gb_printf("%12llu %12llu  %.*s", cast(unsigned long long)e.code, cast(unsigned long long)e.data, LIT(e.name));
+		}
+		if (e.entity != nullptr && e.entity->token.pos.file_id != 0) {
+			gb_printf(" (%s)", token_pos_to_string(e.entity->token.pos));
+		}
+		gb_printf("\n");
+	}
+	gb_printf("\n");
+}
+
+// NOTE: The sizes are read back from the object files, so they are what was actually emitted after
+// all of the optimizations; the symbol names are the canonical names (see name_canonicalization.cpp)
+// which map back to the entities they were generated from
+gb_internal void lb_print_code_size_report(lbGenerator *gen, isize top_count) {
+	if (build_context.lto_kind != LTO_None) {
+		gb_printf("-show-code-size is not available with -lto, as the object files contain bitcode\n");
+		return;
+	}
+	gbAllocator a = heap_allocator();
+
+	StringMap<Entity *> entities = {};
+	string_map_init(&entities, 1<<12);
+	defer (string_map_destroy(&entities));
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		for (auto const &pe : m->procedures) {
+			lbProcedure *p = pe.value;
+			if (p->entity != nullptr && p->value != nullptr) {
+				size_t len = 0;
+				char const *name = LLVMGetValueName2(p->value, &len);
+				string_map_set(&entities, make_string(cast(u8 const *)name, cast(isize)len), p->entity);
+			}
+		}
+		for (auto const &ve : m->values) {
+			Entity *e = ve.key;
+			if (e->kind == Entity_Variable && ve.value.value != nullptr && LLVMIsAGlobalVariable(ve.value.value)) {
+				size_t len = 0;
+				char const *name = LLVMGetValueName2(ve.value.value, &len);
+				string_map_set(&entities, make_string(cast(u8 const *)name, cast(isize)len), e);
+			}
+		}
+	}
+
+	PtrMap<Entity *, Entity *> polymorphic_parents = {};
+	map_init(&polymorphic_parents);
+	defer (map_destroy(&polymorphic_parents));
+	for (Entity *e : gen->info->entities) {
+		if (e->kind == Entity_Procedure && e->Procedure.gen_procs != nullptr) {
+			for (Entity *inst : e->Procedure.gen_procs->procs) {
+				map_set(&polymorphic_parents, inst, e);
+			}
+		}
+	}
+
+	StringMap<lbCodeSizeEntry> packages    = {};
+	StringMap<lbCodeSizeEntry> procedures  = {};
+	StringMap<lbCodeSizeEntry> polymorphic = {};
+	StringMap<lbCodeSizeEntry> globals     = {};
+	string_map_init(&packages);
+	string_map_init(&procedures);
+	string_map_init(&polymorphic);
+	string_map_init(&globals);
+	defer ({
+		string_map_destroy(&packages);
+		string_map_destroy(&procedures);
+		string_map_destroy(&polymorphic);
+		string_map_destroy(&globals);
+	});
+
+	u64 total_code = 0;
+	u64 total_data = 0;
+	u64 rtti_size  = 0;
+
+	for (String const &path : gen->output_object_paths) {
+		char const *path_c = alloc_cstring(a, path);
+		defer (gb_free(a, cast(void *)path_c));
+
+		char *err = nullptr;
+		LLVMMemoryBufferRef buffer = nullptr;
+		if (LLVMCreateMemoryBufferWithContentsOfFile(path_c, &buffer, &err)) {
+			gb_printf_err("Failed to read the object file for -show-code-size: %s\n", err);
+			LLVMDisposeMessage(err);
+			continue;
+		}
+		LLVMBinaryRef binary = LLVMCreateBinary(buffer, nullptr, &err);
+		if (binary == nullptr) {
+			gb_printf_err("Failed to parse the object file for -show-code-size: %s\n", err);
+			LLVMDisposeMessage(err);
+			LLVMDisposeMemoryBuffer(buffer);
+			continue;
+		}
+		defer ({
+			LLVMDisposeBinary(binary);
+			LLVMDisposeMemoryBuffer(buffer);
+		});
+
+		LLVMSectionIteratorRef sections = LLVMObjectFileCopySectionIterator(binary);
+		for (/**/; !LLVMObjectFileIsSectionIteratorAtEnd(binary, sections); LLVMMoveToNextSection(sections)) {
+			char const *name_c = LLVMGetSectionName(sections);
+			String name = name_c ? make_string_c(name_c) : String{};
+			if (lb_code_size_is_ignored_section(name)) {
+				continue;
+			}
+			u64 size = LLVMGetSectionSize(sections);
+			if (lb_code_size_is_code_section(name)) {
+				total_code += size;
+			} else {
+				total_data += size;
+			}
+			if (name == ".odinti") {
+				rtti_size += size;
+			}
+		}
+		LLVMDisposeSectionIterator(sections);
+
+		// NOTE: ELF records the size of every symbol, others (e.g. Mach-O and COFF) do not, so the size of a
+		// symbol is the distance to the next symbol (or the end) of its section
+		LLVMBinaryType binary_type = LLVMBinaryGetType(binary);
+		bool has_symbol_sizes = binary_type == LLVMBinaryTypeELF32L || binary_type == LLVMBinaryTypeELF32B ||
+		                        binary_type == LLVMBinaryTypeELF64L || binary_type == LLVMBinaryTypeELF64B;
+
+		auto symbols = array_make<lbCodeSizeSymbol>(a);
+		defer (array_free(&symbols));
+
+		sections = LLVMObjectFileCopySectionIterator(binary);
+		LLVMSymbolIteratorRef syms = LLVMObjectFileCopySymbolIterator(binary);
+		for (/**/; !LLVMObjectFileIsSymbolIteratorAtEnd(binary, syms); LLVMMoveToNextSymbol(syms)) {
+			char const *name = LLVMGetSymbolName(syms);
+			if (name == nullptr || name[0] == 0) {
+				continue;
+			}
+			LLVMMoveToContainingSection(sections, syms);
+			if (LLVMObjectFileIsSectionIteratorAtEnd(binary, sections)) {
+				continue; // undefined or absolute
+			}
+			char const *section_c = LLVMGetSectionName(sections);
+			String section = section_c ? make_string_c(section_c) : String{};
+			if (lb_code_size_is_ignored_section(section)) {
+				continue;
+			}
+
+			lbCodeSizeSymbol sym = {};
+			sym.name    = name;
+			sym.section = section_c;
+			sym.address = LLVMGetSymbolAddress(syms);
+			sym.size    = LLVMGetSymbolSize(syms);
+			sym.is_code = lb_code_size_is_code_section(section);
+			if (!has_symbol_sizes) {
+				u64 end = LLVMGetSectionAddress(sections) + LLVMGetSectionSize(sections);
+				sym.size = end > sym.address ? end - sym.address : 0;
+			}
+			array_add(&symbols, sym);
+		}
+		LLVMDisposeSymbolIterator(syms);
+		LLVMDisposeSectionIterator(sections);
+
+		if (!has_symbol_sizes) {
+			array_sort(symbols, lb_code_size_symbol_cmp);
+			for (isize i = 0; i+1 < symbols.count; i++) {
+				lbCodeSizeSymbol &x = symbols[i];
+				lbCodeSizeSymbol const &y = symbols[i+1];
+				if (x.section == y.section) {
+					x.size = y.address - x.address;
+				}
+			}
+		}
+
+		for (lbCodeSizeSymbol const &sym : symbols) {
+			if (sym.size == 0) {
+				continue;
+			}
+			String name = make_string_c(sym.name);
+			Entity **found = string_map_get(&entities, name);
+			if (found == nullptr && name.len > 1 && name[0] == '_') {
+				found = string_map_get(&entities, substring(name, 1, name.len));
+			}
+			Entity *e = found ? *found : nullptr;
+
+			String pkg_name = str_lit("(compiler generated)");
+			if (e != nullptr && e->pkg != nullptr) {
+				pkg_name = e->pkg->name;
+			}
+			lb_code_size_add(&packages, pkg_name, nullptr, sym);
+
+			String canonical_name = copy_string(permanent_allocator(), name);
+			if (sym.is_code) {
+				lb_code_size_add(&procedures, canonical_name, e, sym);
+			} else {
+				lb_code_size_add(&globals, canonical_name, e, sym);
+			}
+
+			Entity **parent = e ? map_get(&polymorphic_parents, e) : nullptr;
+			if (parent != nullptr) {
+				Entity *pe = *parent;
+				String parent_name = pe->token.string;
+				if (pe->pkg != nullptr) {
+					parent_name = concatenate3_strings(permanent_allocator(), pe->pkg->name, str_lit("."), pe->token.string);
+				}
+				lb_code_size_add(&polymorphic, parent_name, pe, sym);
+			}
+		}
+	}
+
+	gb_printf("Generated code size (bytes):\n");
+	gb_printf("%12llu code\n", cast(unsigned long long)total_code);
+	gb_printf("%12llu data\n", cast(unsigned long long)total_data);
+	if (rtti_size != 0) {
+		gb_printf("%12llu of which is runtime type information (.odinti)\n", cast(unsigned long long)rtti_size);
+	}
+	gb_printf("\n");
+
+	lb_code_size_print_entries("Packages",                         &packages,    0,         false);
+	lb_code_size_print_entries("Procedures",                       &procedures,  top_count, false);
+	lb_code_size_print_entries("Polymorphic procedures (summed)",  &polymorphic, top_count, true);
+	lb_code_size_print_entries("Global data",                      &globals,     top_count, false);
+}
+
+struct lbStackUsageEntry {
+	Entity *entity;
+	String  name;
+	u64     frame;     // the largest stack frame of the procedure's LLVM functions
+	u64     worst;     // the frame plus the deepest chain of procedures it may call
+	bool    recursive; // the chain contains a cycle, so the worst case is unbounded
+	u8      state;     // 0 = unvisited, 1 = visiting, 2 = done
+};
+
+gb_internal lbStackUsageEntry *lb_stack_usage_entry(PtrMap<Entity *, lbStackUsageEntry *> *entries, Entity *e) {
+	lbStackUsageEntry **found = map_get(entries, e);
+	if (found != nullptr) {
+		return *found;
+	}
+	lbStackUsageEntry *entry = gb_alloc_item(permanent_allocator(), lbStackUsageEntry);
+	entry->entity = e;
+	entry->name   = e->token.string;
+	map_set(entries, e, entry);
+	return entry;
+}
+
+// NOTE: The checker's dependencies of a procedure are every procedure it refers to, which is a superset of
+// what it calls, so this overestimates; procedures which were inlined everywhere have no frame of their own
+// but their dependencies are still followed
+gb_internal void lb_stack_usage_compute_worst(PtrMap<Entity *, lbStackUsageEntry *> *entries, lbStackUsageEntry *entry) {
+	if (entry->state == 2) {
+		return;
+	}
+	entry->state = 1;
+	u64 deepest = 0;
+	DeclInfo *decl = entry->entity->decl_info;
+	if (decl != nullptr) {
+		for (Entity *dep : decl->deps) {
+			if (dep->kind != Entity_Procedure) {
+				continue;
+			}
+			lbStackUsageEntry *callee = lb_stack_usage_entry(entries, dep);
+			if (callee->state == 1) {
+				entry->recursive = true;
+				continue;
+			}
+			lb_stack_usage_compute_worst(entries, callee);
+			entry->recursive |= callee->recursive;
+			deepest = gb_max(deepest, callee->worst);
 		}
 	}
+	entry->worst = entry->frame + deepest;
+	entry->state = 2;
+}
 
-	for (auto const &entry : gen->modules) {
-		lbModule *m = entry.value;
-		array_sort(m->global_types_to_create, llvm_global_entity_cmp);
-		array_sort(m->global_procedures_to_create, llvm_global_entity_cmp);
-	}
+gb_internal GB_COMPARE_PROC(lb_stack_usage_frame_cmp) {
+	auto const *x = *cast(lbStackUsageEntry *const *)a;
+	auto const *y = *cast(lbStackUsageEntry *const *)b;
+	return x->frame < y->frame ? +1 : x->frame > y->frame ? -1 : string_compare(x->name, y->name);
+}
 
-	if (do_threading) {
-		for (auto const &entry : gen->modules) {
-			lbModule *m = entry.value;
-			thread_pool_add_task(lb_generate_procedures_and_types_per_module, m);
-		}
-	} else {
-		for (auto const &entry : gen->modules) {
-			lbModule *m = entry.value;
-			lb_generate_procedures_and_types_per_module(m);
+gb_internal GB_COMPARE_PROC(lb_stack_usage_worst_cmp) {
+	auto const *x = *cast(lbStackUsageEntry *const *)a;
+	auto const *y = *cast(lbStackUsageEntry *const *)b;
+	return x->worst < y->worst ? +1 : x->worst > y->worst ? -1 : string_compare(x->name, y->name);
+}
+
+gb_internal void lb_stack_usage_print_entries(char const *title, Array<lbStackUsageEntry *> const &entries, isize top_count) {
+	isize count = top_count > 0 ? gb_min(top_count, entries.count) : entries.count;
+	gb_printf("%s (top %td of %td):\n", title, count, entries.count);
+	gb_printf("%12s %12s  %s\n", "frame", "worst case", "name");
+	for (isize i = 0; i < count; i++) {
+		lbStackUsageEntry const *e = entries[i];
+		gb_printf("%12llu %11llu%c  %.*s", cast(unsigned long long)e->frame, cast(unsigned long long)e->worst, e->recursive ? '+' : ' ', LIT(e->name));
+		if (e->entity->token.pos.file_id != 0) {
+			gb_printf(" (%s)", token_pos_to_string(e->entity->token.pos));
 		}
+		gb_printf("\n");
+	}
+	gb_printf("\n");
+}
 
+// NOTE: Reports -show-stack-usage and warns about the procedures exceeding their @(max_stack_usage), which
+// is checked against the worst case of the procedure and everything it may call unless that is recursive
+gb_internal void lb_report_stack_usage(lbGenerator *gen, isize top_count) {
+	if (!build_context.show_stack_usage && !gen->info->has_max_stack_usage.load(std::memory_order_relaxed)) {
+		return;
+	}
+	if (build_context.lto_kind != LTO_None) {
+		gb_printf_err("-show-stack-usage and @(max_stack_usage) are not available with -lto, as the stack frames are only laid out at link time\n");
+		return;
 	}
 
-	thread_pool_wait();
-}
+	PtrMap<Entity *, lbStackUsageEntry *> entries = {};
+	map_init(&entries, 1<<10);
+	defer (map_destroy(&entries));
 
-gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p);
+	StringMap<Entity *> entities = {};
+	string_map_init(&entities, 1<<10);
+	defer (string_map_destroy(&entities));
 
+	auto sizes = array_make<lbStackUsage>(heap_allocator());
+	defer (array_free(&sizes));
 
-gb_internal bool lb_is_module_empty(lbModule *m) {
-	if (LLVMGetFirstFunction(m->mod) == nullptr &&
-	    LLVMGetFirstGlobal(m->mod) == nullptr) {
-		return true;
+	for (lbStackUsage su = {}; mpsc_dequeue(&global_stack_usages, &su); /**/) {
+		if (su.entity != nullptr) {
+			string_map_set(&entities, su.name, su.entity);
+			lbStackUsageEntry *entry = lb_stack_usage_entry(&entries, su.entity);
+			entry->name = su.name;
+		} else {
+			array_add(&sizes, su);
+		}
 	}
-	for (auto fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
-		if (LLVMGetFirstBasicBlock(fn) != nullptr) {
-			return false;
+	for (lbStackUsage const &su : sizes) {
+		Entity **found = string_map_get(&entities, su.name);
+		if (found != nullptr) {
+			lbStackUsageEntry *entry = lb_stack_usage_entry(&entries, *found);
+			entry->frame = gb_max(entry->frame, su.size);
 		}
 	}
 
-	for (auto g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
-		LLVMLinkage linkage = LLVMGetLinkage(g);
-		if (linkage == LLVMExternalLinkage ||
-		    linkage == LLVMWeakAnyLinkage) {
+	auto all = array_make<lbStackUsageEntry *>(heap_allocator(), 0, entries.count);
+	defer (array_free(&all));
+	for (auto const &entry : entries) {
+		array_add(&all, entry.value);
+	}
+	for (lbStackUsageEntry *entry : all) {
+		lb_stack_usage_compute_worst(&entries, entry);
+	}
+
+	for (lbStackUsageEntry *entry : all) {
+		Entity *e = entry->entity;
+		if (!e->Procedure.has_max_stack_usage) {
 			continue;
 		}
-		if (!LLVMIsExternallyInitialized(g)) {
-			return false;
+		u64 limit = cast(u64)e->Procedure.max_stack_usage;
+		if (entry->frame > limit) {
+			warning(e->token, "The stack frame of '%.*s' is %llu bytes, which exceeds @(max_stack_usage=%llu)",
+			        LIT(e->token.string), cast(unsigned long long)entry->frame, cast(unsigned long long)limit);
+		} else if (entry->recursive) {
+			warning(e->token, "'%.*s' may recurse, so its stack usage cannot be checked against @(max_stack_usage=%llu)",
+			        LIT(e->token.string), cast(unsigned long long)limit);
+		} else if (entry->worst > limit) {
+			warning(e->token, "'%.*s' may use up to %llu bytes of stack through the procedures it calls, which exceeds @(max_stack_usage=%llu)",
+			        LIT(e->token.string), cast(unsigned long long)entry->worst, cast(unsigned long long)limit);
 		}
 	}
-	return true;
-}
-
-struct lbLLVMEmitWorker {
-	LLVMTargetMachineRef target_machine;
-	LLVMCodeGenFileType code_gen_file_type;
-	String filepath_obj;
-	lbModule *m;
-};
 
-gb_internal WORKER_TASK_PROC(lb_llvm_emit_worker_proc) {
-	GB_ASSERT(MULTITHREAD_OBJECT_GENERATION);
+	if (!build_context.show_stack_usage) {
+		return;
+	}
 
-	char *llvm_error = nullptr;
+	// NOTE: only the procedures which were generated, not the ones merely depended upon
+	isize generated_count = 0;
+	for (lbStackUsageEntry *entry : all) {
+		if (string_map_get(&entities, entry->name) != nullptr) {
+			all[generated_count++] = entry;
+		}
+	}
+	all.count = generated_count;
 
-	auto wd = cast(lbLLVMEmitWorker *)data;
+	gb_printf("Stack usage (bytes), '+' marks a worst case which is unbounded due to recursion:\n\n");
+	array_sort(all, lb_stack_usage_frame_cmp);
+	lb_stack_usage_print_entries("Stack frames", all, top_count);
+	array_sort(all, lb_stack_usage_worst_cmp);
+	lb_stack_usage_print_entries("Worst case call chains", all, top_count);
+}
 
-	if (build_context.lto_kind != LTO_None) {
-		if (LLVMWriteBitcodeToFile(wd->m->mod, cast(char *)wd->filepath_obj.text)) {
-			gb_printf_err("Failed to write bitcode file: %.*s\n", LIT(wd->filepath_obj));
-			exit_with_errors();
+gb_internal void lb_add_allocation_site_procs(lbGenerator *gen, Entity *e, lbAllocationSiteKind kind) {
+	if (e->kind == Entity_ProcGroup) {
+		for (Entity *member : e->ProcGroup.entities) {
+			lb_add_allocation_site_procs(gen, member, kind);
 		}
-	} else if (LLVMTargetMachineEmitToFile(wd->target_machine, wd->m->mod, cast(char *)wd->filepath_obj.text, wd->code_gen_file_type, &llvm_error)) {
-		gb_printf_err("LLVM Error: %s\n", llvm_error);
-		exit_with_errors();
+	} else if (e->kind == Entity_Procedure) {
+		map_set(&gen->allocation_site_procs, e, kind);
+	}
+}
+
+// NOTE: The calls which are instrumented are those to the runtime's built-in allocation procedures (and the members of
+// their procedure groups), for polymorphic ones the original procedure is looked up, see `lb_emit_allocation_site_hook`
+gb_internal void lb_init_allocation_sites(lbGenerator *gen) {
+	if (!build_context.instrument_allocations) {
+		return;
+	}
+	Checker *c = gen->info->checker;
+	gen->allocation_site_hook = find_core_entity(c, str_lit("allocation_site_hook"));
+	map_init(&gen->allocation_site_procs);
+	mpsc_init(&gen->allocation_sites, heap_allocator());
+
+	struct {
+		char const *         name;
+		lbAllocationSiteKind kind;
+	} const procs[] = {
+		{"make",            lbAllocationSite_Make},
+		{"new",             lbAllocationSite_New},
+		{"new_clone",       lbAllocationSite_New},
+		{"append",          lbAllocationSite_Append},
+		{"non_zero_append", lbAllocationSite_Append},
+		{"delete",          lbAllocationSite_Delete},
+		{"free",            lbAllocationSite_Free},
+	};
+	for (auto const &proc : procs) {
+		lb_add_allocation_site_procs(gen, find_core_entity(c, make_string_c(proc.name)), proc.kind);
 	}
-	debugf("Generated File: %.*s\n", LIT(wd->filepath_obj));
-	return 0;
 }
 
+gb_internal GB_COMPARE_PROC(lb_allocation_site_cmp) {
+	auto const *x = cast(lbAllocationSite const *)a;
+	auto const *y = cast(lbAllocationSite const *)b;
+	return x->id < y->id ? -1 : x->id > y->id ? +1 : 0;
+}
 
-gb_internal void lb_llvm_function_pass_per_function_internal(lbModule *module, lbProcedure *p, lbFunctionPassManagerKind pass_manager_kind = lbFunctionPassManager_default) {
-	LLVMPassManagerRef pass_manager = module->function_pass_managers[pass_manager_kind];
-	lb_run_function_pass_manager(pass_manager, p, pass_manager_kind);
+// NOTE: One line per call site, "id<TAB>kind<TAB>procedure<TAB>file(line:column)", sorted by identifier
+gb_internal void lb_export_allocation_sites(lbGenerator *gen) {
+	if (build_context.allocation_sites_file.len == 0) {
+		return;
+	}
+
+	auto sites = array_make<lbAllocationSite>(heap_allocator(), 0, gen->allocation_sites.count.load(std::memory_order_relaxed));
+	defer (array_free(&sites));
+	for (lbAllocationSite site = {}; mpsc_dequeue(&gen->allocation_sites, &site); /**/) {
+		array_add(&sites, site);
+	}
+	array_sort(sites, lb_allocation_site_cmp);
+
+	char const *path = alloc_cstring(temporary_allocator(), build_context.allocation_sites_file);
+	gbFile f = {};
+	if (gb_file_create(&f, path) != gbFileError_None) {
+		gb_printf_err("Failed to create -allocation-sites-file: %s\n", path);
+		return;
+	}
+	defer (gb_file_close(&f));
+
+	OutputBuffer out = {};
+	output_buffer_init(&out, &f);
+	defer (output_buffer_destroy(&out));
+
+	for_array(i, sites) {
+		lbAllocationSite const &site = sites[i];
+		// NOTE: the same site is generated once for every instantiation or module it is inlined into
+		if (i > 0 && sites[i-1].id == site.id) {
+			continue;
+		}
+		output_buffer_printf(&out, "%016llx\t%s\t%.*s\t%s\n",
+		                     cast(unsigned long long)site.id, lb_allocation_site_kind_strings[site.kind],
+		                     LIT(site.procedure), token_pos_to_string(site.pos));
+	}
 }
 
 gb_internal WORKER_TASK_PROC(lb_llvm_function_pass_per_module) {
 	lbModule *m = cast(lbModule *)data;
+	TRACE_SCOPE("lb_llvm_function_pass", make_string_c(m->module_name));
 	{
 		GB_ASSERT(m->function_pass_managers[lbFunctionPassManager_default] == nullptr);
 
@@ -2450,6 +4247,9 @@ gb_internal WORKER_TASK_PROC(lb_llvm_function_pass_per_module) {
 
 	for (auto const &entry : m->gen_procs) {
 		lbProcedure *p = entry.value;
+		if (LLVMIsDeclaration(p->value)) {
+			continue; // defined by another module
+		}
 		if (string_starts_with(p->name, str_lit("__$map"))) {
 			lb_llvm_function_pass_per_function_internal(m, p, lbFunctionPassManager_none);
 		} else {
@@ -2464,19 +4264,71 @@ gb_internal WORKER_TASK_PROC(lb_llvm_function_pass_per_module) {
 void lb_remove_unused_functions_and_globals(lbGenerator *gen) {
 	for (auto &entry : gen->modules) {
 		lbModule *m = entry.value;
-		lb_run_remove_unused_function_pass(m);
-		lb_run_remove_unused_globals_pass(m);
+		lb_run_remove_unreachable_pass(m);
 	}
 }
 
 struct lbLLVMModulePassWorkerData {
 	lbModule *m;
 	LLVMTargetMachineRef target_machine;
-	bool do_threading;
 };
 
+// NOTE: The LLVM-C API cannot enable `-ffunction-sections`/`-fdata-sections` on the target machine,
+// so the equivalent unique ELF section names are assigned here directly. Combined with
+// `--gc-sections` this allows the linker to drop every unreferenced procedure and global.
+gb_internal void lb_assign_unique_sections(lbModule *m) {
+	for (LLVMValueRef f = LLVMGetFirstFunction(m->mod); f != nullptr; f = LLVMGetNextFunction(f)) {
+		if (LLVMIsDeclaration(f)) {
+			continue;
+		}
+		char const *section = LLVMGetSection(f);
+		if ((section != nullptr && section[0] != 0) || LLVMGetComdat(f) != nullptr) {
+			continue;
+		}
+		size_t name_len = 0;
+		char const *name = LLVMGetValueName2(f, &name_len);
+		if (name_len == 0) {
+			continue;
+		}
+		TEMPORARY_ALLOCATOR_GUARD();
+		gbString s = gb_string_make(temporary_allocator(), ".text.");
+		s = gb_string_append_length(s, name, name_len);
+		LLVMSetSection(f, s);
+	}
+
+	for (LLVMValueRef g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+		if (LLVMIsDeclaration(g) || LLVMIsThreadLocal(g)) {
+			continue;
+		}
+		char const *section = LLVMGetSection(g);
+		if ((section != nullptr && section[0] != 0) || LLVMGetComdat(g) != nullptr) {
+			continue;
+		}
+		size_t name_len = 0;
+		char const *name = LLVMGetValueName2(g, &name_len);
+		if (name_len == 0 || gb_strncmp(name, "llvm.", 5) == 0) {
+			continue;
+		}
+
+		char const *prefix = ".data.";
+		LLVMValueRef init = LLVMGetInitializer(g);
+		if (LLVMIsGlobalConstant(g)) {
+			// NOTE: a constant may contain pointers which need dynamic relocations when position independent
+			prefix = get_reloc_mode() == LLVMRelocStatic ? ".rodata." : ".data.rel.ro.";
+		} else if (init == nullptr || LLVMIsNull(init)) {
+			prefix = ".bss.";
+		}
+
+		TEMPORARY_ALLOCATOR_GUARD();
+		gbString s = gb_string_make(temporary_allocator(), prefix);
+		s = gb_string_append_length(s, name, name_len);
+		LLVMSetSection(g, s);
+	}
+}
+
 gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	auto wd = cast(lbLLVMModulePassWorkerData *)data;
+	TRACE_SCOPE("lb_llvm_module_pass", make_string_c(wd->m->module_name));
 
 	LLVMPassManagerRef module_pass_manager = LLVMCreatePassManager();
 	LLVMRunPassManager(module_pass_manager, wd->m->mod);
@@ -2487,7 +4339,40 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	LLVMPassBuilderOptionsRef pb_options = LLVMCreatePassBuilderOptions();
 	defer (LLVMDisposePassBuilderOptions(pb_options));
 
-	#include "llvm_backend_passes.cpp"
+	// NOTE: These run before the optimization pipeline so that the inliner, block placement,
+	// and switch lowering all see the profile (or the instrumentation counters)
+	switch (build_context.pgo_kind) {
+	case PGO_Generate:
+		array_add(&passes, "pgo-instr-gen");
+		array_add(&passes, "instrprof");
+		break;
+	case PGO_Use:
+		// NOTE: run on its own first, see below
+		array_add(&passes, "pgo-instr-use");
+		// NOTE: indirect calls to their most frequent targets become guarded direct calls, which can then be inlined
+		array_add(&passes, "pgo-icall-prom");
+		break;
+	}
+
+	if (build_context.lto_kind != LTO_None && build_context.optimization_level >= 1) {
+		// NOTE: With LTO, the modules only get the pre-link half of the pipeline here, the rest runs at link
+		// time once the modules have been merged (full) or their summaries combined (thin). The ThinLTO
+		// pre-link pipeline in particular leaves out the passes which would hurt importing across modules.
+		bool thin = build_context.lto_kind != LTO_Full;
+		switch (build_context.optimization_level) {
+		case 1: array_add(&passes, thin ? "thinlto-pre-link<Os>" : "lto-pre-link<Os>"); break;
+		case 2: array_add(&passes, thin ? "thinlto-pre-link<O2>" : "lto-pre-link<O2>"); break;
+		case 3: array_add(&passes, thin ? "thinlto-pre-link<O3>" : "lto-pre-link<O3>"); break;
+		}
+	} else {
+		#include "llvm_backend_passes.cpp"
+	}
+
+	if (build_context.optimization_level == 1) {
+		// NOTE: -o:size also merges the procedures which are identical once optimized, such as polymorphic
+		// instantiations and generated helpers for types of the same layout, keeping a thunk where the address is taken
+		array_add(&passes, "mergefunc");
+	}
 
 	// asan - Linux, Darwin, Windows
 	// msan - linux
@@ -2537,7 +4422,25 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 		}
 	}
 
-	LLVMErrorRef llvm_err = LLVMRunPasses(wd->m->mod, passes_str, wd->target_machine, pb_options);
+	if (lb_llvm_module_find_cached_object(wd->m, passes_str)) {
+		return 0;
+	}
+
+	char const *run_passes_str = passes_str;
+	LLVMErrorRef llvm_err = nullptr;
+	if (build_context.pgo_kind == PGO_Use) {
+		// NOTE: the profile is applied before the rest of the pipeline so that the hot cases of the
+		// type switches can be peeled with the weights it gives
+		GB_ASSERT(gb_strncmp(passes_str, "pgo-instr-use,", 14) == 0);
+		run_passes_str = passes_str + 14;
+		llvm_err = LLVMRunPasses(wd->m->mod, "pgo-instr-use", wd->target_machine, pb_options);
+		if (llvm_err == nullptr) {
+			lb_peel_hot_type_switch_cases(wd->m);
+		}
+	}
+	if (llvm_err == nullptr) {
+		llvm_err = LLVMRunPasses(wd->m->mod, run_passes_str, wd->target_machine, pb_options);
+	}
 
 	defer (LLVMConsumeError(llvm_err));
 	if (llvm_err != nullptr) {
@@ -2557,17 +4460,14 @@ gb_internal WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 		return 1;
 	}
 
-	if (LLVM_IGNORE_VERIFICATION) {
-		return 0;
-	}
-
-	if (wd->do_threading) {
-		thread_pool_add_task(lb_llvm_module_verification_worker_proc, wd->m);
-	} else {
-		lb_llvm_module_verification_worker_proc(wd->m);
+	if (linker_uses_function_sections()) {
+		lb_assign_unique_sections(wd->m);
 	}
 
-	return 0;
+	// NOTE: Verified within the same task straight after the passes rather than queued as a separate
+	// task, so a module is never traversed again once every other module is done, and a failure is
+	// reported as soon as that module has finished
+	return lb_llvm_module_verification_worker_proc(wd->m);
 }
 
 
@@ -2580,18 +4480,35 @@ gb_internal WORKER_TASK_PROC(lb_generate_procedures_worker_proc) {
 	return 0;
 }
 
+// NOTE: The type info table is only ever built into the default module, and only touches its context,
+// so it is built as part of that module's task rather than serially before any procedure generation
+gb_internal WORKER_TASK_PROC(lb_generate_type_info_and_procedures_worker_proc) {
+	lbModule *m = cast(lbModule *)data;
+	lb_setup_type_info_data(m);
+	return lb_generate_procedures_worker_proc(m);
+}
+
 gb_internal void lb_generate_procedures(lbGenerator *gen, bool do_threading) {
+	lbModule *default_module = &gen->default_module;
 	if (do_threading) {
+		// NOTE: Added first, as with a large type table it is usually the longest task
+		thread_pool_add_task(lb_generate_type_info_and_procedures_worker_proc, default_module);
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			thread_pool_add_task(lb_generate_procedures_worker_proc, m);
+			if (m != default_module) {
+				thread_pool_add_task(lb_generate_procedures_worker_proc, m);
+			}
 		}
 
 		thread_pool_wait();
 	} else {
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			lb_generate_procedures_worker_proc(m);
+			if (m == default_module) {
+				lb_generate_type_info_and_procedures_worker_proc(m);
+			} else {
+				lb_generate_procedures_worker_proc(m);
+			}
 		}
 	}
 }
@@ -2655,10 +4572,14 @@ gb_internal void lb_debug_info_complete_types_and_finalize(lbGenerator *gen) {
 
 gb_internal void lb_llvm_function_passes(lbGenerator *gen, bool do_threading) {
 	if (do_threading) {
+		auto tasks = slice_make<WorkerTaskWithSize>(temporary_allocator(), gen->modules.count);
+		isize task_count = 0;
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
-			thread_pool_add_task(lb_llvm_function_pass_per_module, m);
+			tasks[task_count++] = {lb_llvm_function_pass_per_module, m, lb_module_size_hint(m)};
 		}
+		tasks.count = task_count;
+		lb_add_module_tasks(tasks);
 		thread_pool_wait();
 	} else {
 		for (auto const &entry : gen->modules) {
@@ -2671,15 +4592,18 @@ gb_internal void lb_llvm_function_passes(lbGenerator *gen, bool do_threading) {
 
 gb_internal void lb_llvm_module_passes_and_verification(lbGenerator *gen, bool do_threading) {
 	if (do_threading) {
+		auto tasks = slice_make<WorkerTaskWithSize>(temporary_allocator(), gen->modules.count);
+		isize task_count = 0;
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
 			auto wd = permanent_alloc_item<lbLLVMModulePassWorkerData>();
 			wd->m = m;
 			wd->target_machine = m->target_machine;
-			wd->do_threading = true;
 
-			thread_pool_add_task(lb_llvm_module_pass_worker_proc, wd);
+			tasks[task_count++] = {lb_llvm_module_pass_worker_proc, wd, lb_module_size_hint(m)};
 		}
+		tasks.count = task_count;
+		lb_add_module_tasks(tasks);
 		thread_pool_wait();
 	} else {
 		for (auto const &entry : gen->modules) {
@@ -2687,7 +4611,6 @@ gb_internal void lb_llvm_module_passes_and_verification(lbGenerator *gen, bool d
 			auto wd = permanent_alloc_item<lbLLVMModulePassWorkerData>();
 			wd->m = m;
 			wd->target_machine = m->target_machine;
-			wd->do_threading = false;
 			lb_llvm_module_pass_worker_proc(wd);
 		}
 	}
@@ -2792,6 +4715,32 @@ gb_internal void lb_add_foreign_library_paths(lbGenerator *gen) {
 	}
 }
 
+// NOTE: The function passes, the removal of unused functions and globals, the module passes and the
+// verification only ever touch the module itself, so each module goes through all of them as one task rather
+// than every module waiting at a barrier between each phase
+gb_internal WORKER_TASK_PROC(lb_llvm_module_pipeline_worker_proc) {
+	auto wd = cast(lbLLVMModulePassWorkerData *)data;
+	lb_llvm_function_pass_per_module(wd->m);
+	lb_run_remove_unreachable_pass(wd->m);
+	return lb_llvm_module_pass_worker_proc(wd);
+}
+
+gb_internal void lb_llvm_module_pipeline(lbGenerator *gen) {
+	auto tasks = slice_make<WorkerTaskWithSize>(temporary_allocator(), gen->modules.count);
+	isize task_count = 0;
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		auto wd = permanent_alloc_item<lbLLVMModulePassWorkerData>();
+		wd->m = m;
+		wd->target_machine = m->target_machine;
+
+		tasks[task_count++] = {lb_llvm_module_pipeline_worker_proc, wd, lb_module_size_hint(m)};
+	}
+	tasks.count = task_count;
+	lb_add_module_tasks(tasks);
+	thread_pool_wait();
+}
+
 gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading) {
 	LLVMCodeGenFileType code_gen_file_type = LLVMObjectFile;
 	if (build_context.build_mode == BuildMode_Assembly) {
@@ -2802,6 +4751,8 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 	defer (LLVMDisposeMessage(llvm_error));
 
 	if (do_threading) {
+		auto tasks = slice_make<WorkerTaskWithSize>(temporary_allocator(), gen->modules.count);
+		isize task_count = 0;
 		for (auto const &entry : gen->modules) {
 			lbModule *m = entry.value;
 			if (lb_is_module_empty(m)) {
@@ -2818,8 +4769,10 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 			wd->code_gen_file_type = code_gen_file_type;
 			wd->filepath_obj = filepath_obj;
 			wd->m = m;
-			thread_pool_add_task(lb_llvm_emit_worker_proc, wd);
+			tasks[task_count++] = {lb_llvm_emit_worker_proc, wd, lb_module_size_hint(m)};
 		}
+		tasks.count = task_count;
+		lb_add_module_tasks(tasks);
 
 		thread_pool_wait(&global_thread_pool);
 	} else {
@@ -2839,17 +4792,18 @@ gb_internal bool lb_llvm_object_generation(lbGenerator *gen, bool do_threading)
 			TIME_SECTION_WITH_LEN(section_name, gb_string_length(section_name));
 
 			if (build_context.lto_kind != LTO_None) {
-				if (LLVMWriteBitcodeToFile(m->mod, cast(char *)filepath_obj.text)) {
+				if (!lb_write_lto_bitcode(m, filepath_obj)) {
 					gb_printf_err("Failed to write bitcode file: %.*s\n", LIT(filepath_obj));
 					exit_with_errors();
 					return false;
 				}
-			} else if (LLVMTargetMachineEmitToFile(m->target_machine, m->mod, cast(char *)filepath_obj.text, code_gen_file_type, &llvm_error)) {
+			} else if (!lb_emit_object_cached(m, code_gen_file_type, filepath_obj, &llvm_error)) {
 				gb_printf_err("LLVM Error: %s\n", llvm_error);
 				exit_with_errors();
 				return false;
 			}
 			debugf("Generated File: %.*s\n", LIT(filepath_obj));
+			lb_release_module(m);
 		}
 	}
 	return true;
@@ -2925,7 +4879,9 @@ gb_internal lbProcedure *lb_create_main_procedure(lbModule *m, lbProcedure *star
 	lb_emit_call(p, startup_runtime_value, {}, ProcInlining_none, ProcTailing_none);
 
 	if (build_context.command_kind == Command_test) {
-		Type *t_Internal_Test = find_type_in_pkg(m->info, str_lit("testing"), str_lit("Internal_Test"));
+		// NOTE: `testing.Internal_Benchmark` has the same layout as `testing.Internal_Test`
+		String internal_test_name = build_context.benchmark ? str_lit("Internal_Benchmark") : str_lit("Internal_Test");
+		Type *t_Internal_Test = find_type_in_pkg(m->info, str_lit("testing"), internal_test_name);
 		Type *array_type = alloc_type_array(t_Internal_Test, m->info->testing_procedures.count);
 		Type *slice_type = alloc_type_slice(t_Internal_Test);
 		lbAddr all_tests_array_addr = lb_add_global_generated_with_name(p->module, array_type, {}, str_lit("__$all_tests_array"));
@@ -2968,7 +4924,8 @@ gb_internal lbProcedure *lb_create_main_procedure(lbModule *m, lbProcedure *star
 		              lb_const_int(m, t_int, m->info->testing_procedures.count));
 
 
-		lbValue runner = lb_find_package_value(m, str_lit("testing"), str_lit("runner"));
+		String runner_name = build_context.benchmark ? str_lit("bench_runner") : str_lit("runner");
+		lbValue runner = lb_find_package_value(m, str_lit("testing"), runner_name);
 
 		TEMPORARY_ALLOCATOR_GUARD();
 		auto args = array_make<lbValue>(temporary_allocator(), 1);
@@ -3028,6 +4985,9 @@ gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 		return;
 	}
 
+	lb_procedure_scratch_begin(p);
+	defer (lb_procedure_scratch_end(p));
+
 	if (p->body != nullptr) { // Build Procedure
 		m->curr_procedure = p;
 		lb_begin_procedure_body(p);
@@ -3051,6 +5011,114 @@ gb_internal void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 }
 
 
+// NOTE: Every call to an Odin calling convention procedure passes the context pointer, even when the
+// callee never reads it. Procedures whose context parameter has no uses in their generated body (so
+// they neither read `context` nor pass it on to anything) get `undef` passed instead at every direct
+// call, which means the caller no longer needs to keep its context alive for that call. That can in
+// turn make the caller's own context parameter unused, so this is propagated up the call graph until
+// nothing changes. For procedures with internal linkage, LLVM's dead argument elimination then drops
+// the parameter entirely, giving them a context-free signature.
+//
+// This is done on the generated IR rather than the checker's dependency graph, as that does not see
+// the uses of the context which are introduced by the backend (e.g. map operations, dynamic literals).
+gb_internal void lb_elide_unused_context_pointers(lbGenerator *gen) {
+	PtrMap<LLVMValueRef, bool> candidates = {}; // true once elided
+	map_init(&candidates);
+	defer (map_destroy(&candidates));
+
+	Array<LLVMValueRef> worklist = {};
+	array_init(&worklist, heap_allocator());
+	defer (array_free(&worklist));
+
+	auto const context_param = [](LLVMValueRef func) -> LLVMValueRef {
+		unsigned param_count = LLVMCountParams(func);
+		if (param_count == 0) {
+			return nullptr;
+		}
+		LLVMValueRef param = LLVMGetParam(func, param_count-1);
+		if (LLVMGetTypeKind(LLVMTypeOf(param)) != LLVMPointerTypeKind) {
+			return nullptr;
+		}
+		return param;
+	};
+
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		for (lbProcedure *p : m->generated_procedures) {
+			Type *pt = base_type(p->type);
+			if (pt == nullptr || pt->kind != Type_Proc || pt->Proc.calling_convention != ProcCC_Odin) {
+				continue;
+			}
+			if (LLVMCountBasicBlocks(p->value) == 0) {
+				continue;
+			}
+			LLVMValueRef param = context_param(p->value);
+			if (param == nullptr) {
+				continue;
+			}
+			bool unused = LLVMGetFirstUse(param) == nullptr;
+			map_set(&candidates, p->value, unused);
+			if (unused) {
+				array_add(&worklist, p->value);
+			}
+		}
+	}
+
+	isize elided_calls = 0;
+	while (worklist.count != 0) {
+		LLVMValueRef func = array_pop(&worklist);
+		LLVMModuleRef func_mod = LLVMGetGlobalParent(func);
+
+		size_t name_len = 0;
+		char const *name = LLVMGetValueName2(func, &name_len);
+		if (name_len == 0) {
+			continue;
+		}
+
+		for (auto const &entry : gen->modules) {
+			lbModule *m = entry.value;
+			LLVMValueRef callee = func;
+			if (m->mod != func_mod) {
+				// NOTE: calls from other modules go through a declaration with the same name
+				callee = LLVMGetNamedFunction(m->mod, name);
+				if (callee == nullptr || LLVMCountBasicBlocks(callee) != 0) {
+					continue;
+				}
+			}
+			unsigned param_count = LLVMCountParams(callee);
+
+			for (LLVMUseRef use = LLVMGetFirstUse(callee); use != nullptr; use = LLVMGetNextUse(use)) {
+				LLVMValueRef call = LLVMGetUser(use);
+				if (!LLVMIsACallInst(call) || LLVMGetCalledValue(call) != callee) {
+					continue; // its address is taken, which is fine as it still accepts a context
+				}
+				unsigned arg_count = LLVMGetNumArgOperands(call);
+				if (arg_count != param_count) {
+					continue;
+				}
+				LLVMValueRef arg = LLVMGetOperand(call, arg_count-1);
+				if (LLVMIsUndef(arg)) {
+					continue;
+				}
+				LLVMSetOperand(call, arg_count-1, LLVMGetUndef(LLVMTypeOf(arg)));
+				elided_calls += 1;
+
+				if (!LLVMIsAArgument(arg)) {
+					continue;
+				}
+				LLVMValueRef caller = LLVMGetParamParent(arg);
+				bool *elided = map_get(&candidates, caller);
+				if (elided != nullptr && !*elided && arg == context_param(caller) && LLVMGetFirstUse(arg) == nullptr) {
+					*elided = true;
+					array_add(&worklist, caller);
+				}
+			}
+		}
+	}
+
+	debugf("Context pointers elided at %td calls\n", elided_calls);
+}
+
 gb_internal bool lb_generate_code(lbGenerator *gen) {
 	TIME_SECTION("LLVM Initializtion");
 
@@ -3115,6 +5183,32 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		LLVMInitializeNativeTarget();
 	}
 
+	{
+		// NOTE: The C API has no way to give the profile to the `pgo-instr-use` pass, nor to enable
+		// the optimization remarks or the MachineOutliner, so they are passed through LLVM's command line options
+		char const *args[6] = {"odin"};
+		int arg_count = 1;
+		if (build_context.optimization_level == 1) {
+			// NOTE: by default the outliner only runs on a few targets, and only for `minsize` procedures
+			args[arg_count++] = "-enable-machine-outliner";
+		}
+		if (build_context.pgo_kind == PGO_Use) {
+			args[arg_count++] = alloc_cstring(permanent_allocator(), concatenate_strings(temporary_allocator(), str_lit("-pgo-test-profile-file="), build_context.pgo_profile_path));
+		}
+		if (build_context.opt_remarks.len != 0) {
+			String filter = build_context.opt_remarks;
+			if (filter == "all") {
+				filter = str_lit(".*");
+			}
+			args[arg_count++] = alloc_cstring(permanent_allocator(), concatenate_strings(temporary_allocator(), str_lit("-pass-remarks="),          filter));
+			args[arg_count++] = alloc_cstring(permanent_allocator(), concatenate_strings(temporary_allocator(), str_lit("-pass-remarks-missed="),   filter));
+			args[arg_count++] = alloc_cstring(permanent_allocator(), concatenate_strings(temporary_allocator(), str_lit("-pass-remarks-analysis="), filter));
+		}
+		if (arg_count > 1) {
+			LLVMParseCommandLineOptions(arg_count, args, nullptr);
+		}
+	}
+
 	char const *target_triple = alloc_cstring(permanent_allocator(), build_context.metrics.target_triplet);
 	for (auto const &entry : gen->modules) {
 		LLVMSetTarget(entry.value->mod, target_triple);
@@ -3193,11 +5287,27 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		LLVMDisposeTargetData(data_layout);
 
 	#if LLVM_VERSION_MAJOR >= 18
-		if (build_context.fast_isel) {
+		switch (build_context.isel_kind) {
+		case ISel_Default:
+			if (code_gen_level == LLVMCodeGenLevelNone) {
+				LLVMSetTargetMachineFastISel(m->target_machine, true);
+			}
+			break;
+		case ISel_Fast:
 			LLVMSetTargetMachineFastISel(m->target_machine, true);
+			break;
+		case ISel_Global:
+			LLVMSetTargetMachineGlobalISel(m->target_machine, true);
+			LLVMSetTargetMachineGlobalISelAbort(m->target_machine, LLVMGlobalISelAbortDisableWithDiag);
+			LLVMContextSetDiagnosticHandler(m->ctx, lb_diagnostic_handler, m);
+			break;
 		}
 	#endif
 
+		if (build_context.opt_remarks.len != 0 || lb_gathers_stack_usage(m)) {
+			LLVMContextSetDiagnosticHandler(m->ctx, lb_diagnostic_handler, m);
+		}
+
 		array_add(&target_machines, target_machine);
 	}
 
@@ -3206,9 +5316,16 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		if (m->debug_builder) { // Debug Info
 			for (auto const &file_entry : info->files) {
 				AstFile *f = file_entry.value;
+				String filename = f->filename;
+				String directory = remap_path_prefix(f->directory);
+				if (!build_has_debug_info()) {
+					// NOTE: LLVM reports the remarks with just the file name, so use the full path to tell files apart
+					filename = f->fullpath;
+					directory = {};
+				}
 				LLVMMetadataRef res = LLVMDIBuilderCreateFile(m->debug_builder,
-					cast(char const *)f->filename.text, f->filename.len,
-					cast(char const *)f->directory.text, f->directory.len);
+					cast(char const *)filename.text, filename.len,
+					cast(char const *)directory.text, directory.len);
 				lb_set_llvm_metadata(m, f, res);
 			}
 
@@ -3239,12 +5356,20 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 			LLVMBool split_debug_inlining = build_context.build_mode == BuildMode_Assembly;
 			LLVMBool debug_info_for_profiling = false;
 
+			// NOTE: nothing is emitted when the debug info only exists for -opt-remarks
+			LLVMDWARFEmissionKind emission_kind = LLVMDWARFEmissionNone;
+			if (build_context.ODIN_DEBUG) {
+				emission_kind = LLVMDWARFEmissionFull;
+			} else if (build_context.debug_line_tables) {
+				emission_kind = LLVMDWARFEmissionLineTablesOnly;
+			}
+
 			m->debug_compile_unit = LLVMDIBuilderCreateCompileUnit(m->debug_builder, LLVMDWARFSourceLanguageC99,
 				lb_get_llvm_metadata(m, init_file),
 				producer, gb_string_length(producer),
 				is_optimized, "", 0,
 				1, split_name, gb_string_length(split_name),
-				LLVMDWARFEmissionFull,
+				emission_kind,
 				0, split_debug_inlining,
 				debug_info_for_profiling,
 				"", 0, // sys_root
@@ -3254,6 +5379,8 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 	}
 
+	lb_init_allocation_sites(gen);
+
 	TIME_SECTION("LLVM Global Variables");
 
 	if (!build_context.no_rtti) {
@@ -3291,6 +5418,12 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 			isize count = 0;
 			isize offsets_extra = 0;
 
+			// NOTE: -rtti:minimal; only the names, usings, and tags which are owned by a type need their own space
+			isize shared_count = lb_type_info_shared_member_count(m->info);
+			isize names_count  = shared_count;
+			isize usings_count = shared_count;
+			isize tags_count   = shared_count;
+
 			for (auto const &tt : m->info->type_info_types_hash_map) {
 				Type *t = tt.type;
 				if (t == nullptr) {
@@ -3317,6 +5450,28 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 					offsets_extra += t->BitField.fields.count;
 					break;
 				}
+
+				if (build_context.rtti_minimal) {
+					switch (t->kind) {
+					case Type_Struct:
+						if (lb_type_info_owns_member_names (m->info, t)) names_count  += t->Struct.fields.count;
+						if (lb_type_info_owns_member_usings(m->info, t)) usings_count += t->Struct.fields.count;
+						if (lb_type_info_owns_member_tags  (m->info, t)) tags_count   += t->Struct.fields.count;
+						break;
+					case Type_Tuple:
+						if (lb_type_info_owns_member_names (m->info, t)) names_count  += t->Tuple.variables.count;
+						break;
+					case Type_BitField:
+						if (lb_type_info_owns_member_names (m->info, t)) names_count  += t->BitField.fields.count;
+						if (lb_type_info_owns_member_tags  (m->info, t)) tags_count   += t->BitField.fields.count;
+						break;
+					}
+				}
+			}
+			if (!build_context.rtti_minimal) {
+				names_count  = count;
+				usings_count = count;
+				tags_count   = count;
 			}
 
 			auto const global_type_info_make = [](lbModule *m, char const *name, Type *elem_type, i64 count) -> lbAddr {
@@ -3330,10 +5485,14 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 			};
 
 			lb_global_type_info_member_types   = global_type_info_make(m, LB_TYPE_INFO_TYPES_NAME,   t_type_info_ptr, count);
-			lb_global_type_info_member_names   = global_type_info_make(m, LB_TYPE_INFO_NAMES_NAME,   t_string,        count);
+			lb_global_type_info_member_names   = global_type_info_make(m, LB_TYPE_INFO_NAMES_NAME,   t_string,        names_count);
 			lb_global_type_info_member_offsets = global_type_info_make(m, LB_TYPE_INFO_OFFSETS_NAME, t_uintptr,       count+offsets_extra);
-			lb_global_type_info_member_usings  = global_type_info_make(m, LB_TYPE_INFO_USINGS_NAME,  t_bool,          count);
-			lb_global_type_info_member_tags    = global_type_info_make(m, LB_TYPE_INFO_TAGS_NAME,    t_string,        count);
+			lb_global_type_info_member_usings  = global_type_info_make(m, LB_TYPE_INFO_USINGS_NAME,  t_bool,          usings_count);
+			lb_global_type_info_member_tags    = global_type_info_make(m, LB_TYPE_INFO_TAGS_NAME,    t_string,        tags_count);
+
+			lb_global_type_info_member_names_index  = shared_count;
+			lb_global_type_info_member_usings_index = shared_count;
+			lb_global_type_info_member_tags_index   = shared_count;
 		}
 	}
 
@@ -3472,9 +5631,13 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 		if (e->flags & EntityFlag_Require) {
 			lb_append_to_compiler_used(m, g.value);
+			if (linker_uses_dead_section_elimination()) {
+				// NOTE: only `llvm.used` marks the section as retained for `--gc-sections`
+				lb_append_to_used(m, g.value);
+			}
 		}
 
-		if (m->debug_builder) {
+		if (m->debug_builder && !lb_debug_line_tables_only()) {
 			String global_name = e->token.string;
 			if (global_name.len != 0 && global_name != "_") {
 				LLVMMetadataRef llvm_file = lb_get_llvm_metadata(m, e->file);
@@ -3559,7 +5722,7 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 
 	if (build_context.ODIN_DEBUG) {
 		for (auto const &entry : builtin_pkg->scope->elements) {
-			Entity *e = entry.value;
+			Entity *e = entry.value();
 			lb_add_debug_info_for_global_constant_from_entity(gen, e);
 		}
 	}
@@ -3587,10 +5750,17 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		lb_finalize_objc_names(gen, gen->objc_names);
 	}
 
-	if (build_context.ODIN_DEBUG) {
+	if (build_context.optimization_level > 0) {
+		TIME_SECTION("LLVM Context Pointer Elision");
+		lb_elide_unused_context_pointers(gen);
+	}
+
+	if (lb_generate_debug_info()) {
 		TIME_SECTION("LLVM Debug Info Complete Types and Finalize");
 		lb_debug_info_complete_types_and_finalize(gen);
+	}
 
+	if (build_context.ODIN_DEBUG) {
 		// Custom `.raddbg` section for its debugger
 		if (build_context.metrics.os == TargetOs_windows) {
 			lbModule *m = default_module;
@@ -3682,6 +5852,23 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 	}
 
+	TIME_SECTION("LLVM Add Foreign Library Paths");
+	lb_add_foreign_library_paths(gen);
+
+	TIME_SECTION("LLVM Shared Library Symbol Visibility");
+	lb_apply_shared_library_visibility(gen);
+
+	bool function_passes_done = false;
+	if (build_context.link_into_single_module && USE_SEPARATE_MODULES) {
+		// NOTE: the function passes are run over the `lbProcedure`s of each module, so must be done before linking
+		TIME_SECTION("LLVM Function Pass");
+		lb_llvm_function_passes(gen, do_threading && !lb_generate_debug_info());
+		function_passes_done = true;
+
+		TIME_SECTION("LLVM Link Into Single Module");
+		lb_link_into_single_module(gen, do_threading);
+	}
+
 	if (do_threading) {
 		isize non_empty_module_count = 0;
 		for (auto const &entry : gen->modules) {
@@ -3695,17 +5882,28 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 	}
 
-	TIME_SECTION("LLVM Add Foreign Library Paths");
-	lb_add_foreign_library_paths(gen);
+	if (build_context.profile_friendly) {
+		TIME_SECTION("LLVM Frame Pointers");
+		lb_add_frame_pointers(gen);
+	}
 
-	TIME_SECTION("LLVM Function Pass");
-	lb_llvm_function_passes(gen, do_threading && !build_context.ODIN_DEBUG);
+	lb_gather_entity_linkage_corrections(gen);
 
-	TIME_SECTION("LLVM Remove Unused Functions and Globals");
-	lb_remove_unused_functions_and_globals(gen);
+	if (do_threading && !lb_generate_debug_info()) {
+		TIME_SECTION("LLVM Function Pass, Remove Unused, Module Pass and Verification");
+		lb_llvm_module_pipeline(gen);
+	} else {
+		if (!function_passes_done) {
+			TIME_SECTION("LLVM Function Pass");
+			lb_llvm_function_passes(gen, do_threading && !lb_generate_debug_info());
+		}
 
-	TIME_SECTION("LLVM Module Pass and Verification");
-	lb_llvm_module_passes_and_verification(gen, do_threading);
+		TIME_SECTION("LLVM Remove Unused Functions and Globals");
+		lb_remove_unused_functions_and_globals(gen);
+
+		TIME_SECTION("LLVM Module Pass and Verification");
+		lb_llvm_module_passes_and_verification(gen, do_threading);
+	}
 
 	TIME_SECTION("LLVM Correct Entity Linkage");
 	lb_correct_entity_linkage(gen);
@@ -3753,12 +5951,18 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 	if (gen->used_module_count > 1) {
 		label_object_generation = gb_string_append_fmt(label_object_generation, " (%td used modules)", gen->used_module_count);
 	}
+	if (build_context.jit) {
+		// NOTE: The modules are handed to the JIT as they are, see `lb_jit_run`
+		return true;
+	}
+
 	TIME_SECTION_WITH_LEN(label_object_generation, gb_string_length(label_object_generation));
 	
 	if (build_context.ignore_llvm_build) {
 		gb_printf_err("LLVM object generation has been ignored!\n");
 		return false;
 	}
+	linker_queue_foreign_assembly(gen);
 	if (!lb_llvm_object_generation(gen, do_threading)) {
 		return false;
 	}
@@ -3810,7 +6014,18 @@ gb_internal bool lb_generate_code(lbGenerator *gen) {
 		}
 	}
 
+	if (build_context.pgo_kind == PGO_Generate) {
+		// NOTE: links the profile runtime which writes the counters out at exit
+		if (!build_context.extra_linker_flags.text) {
+			build_context.extra_linker_flags = str_lit("-fprofile-instr-generate");
+		} else {
+			build_context.extra_linker_flags = concatenate_strings(permanent_allocator(), build_context.extra_linker_flags, str_lit(" -fprofile-instr-generate"));
+		}
+	}
+
 	array_sort(gen->foreign_libraries, foreign_library_cmp);
 
 	return true;
 }
+
+#include "llvm_backend_jit.cpp"
@@ -10,12 +10,18 @@
 
 #include <llvm-c/Core.h>
 #include <llvm-c/ExecutionEngine.h>
+#include <llvm-c/LLJIT.h>
+#include <llvm-c/Orc.h>
 #include <llvm-c/Target.h>
 #include <llvm-c/Analysis.h>
 #include <llvm-c/Object.h>
 #include <llvm-c/BitWriter.h>
+#include <llvm-c/BitReader.h>
+#include <llvm-c/Linker.h>
+#include <llvm-c/Comdat.h>
 #include <llvm-c/DebugInfo.h>
 #include <llvm-c/Transforms/PassBuilder.h>
+#include <llvm-c/Support.h>
 
 
 
@@ -88,6 +94,20 @@ struct lbIncompleteDebugType {
 
 typedef Slice<i32> lbStructFieldRemapping;
 
+struct lbStructLayoutSlot {
+	i32 field_index;   // -1 for padding
+	i64 padding_size;
+	i64 padding_align;
+};
+
+// NOTE: How a struct is lowered, which only depends on the Odin type. It is computed once per generator and
+// shared by every module, each of which only creates the LLVMTypeRefs of the slots within its own context
+struct lbStructLayout {
+	Slice<lbStructLayoutSlot> slots;
+	lbStructFieldRemapping    field_remapping;
+	bool                      requires_packing;
+};
+
 enum lbFunctionPassManagerKind {
 	lbFunctionPassManager_default,
 	lbFunctionPassManager_default_without_memcpy,
@@ -101,9 +121,26 @@ struct lbPadType {
 	LLVMTypeRef type;
 };
 
+// NOTE: A lowered constant aggregate (*Ast_CompoundLit or the data of a constant string) which
+// does not depend on where it is used, so it can be reused rather than lowered again
+struct lbConstAggregate {
+	Type *       type;
+	Type *       value_type;
+	LLVMValueRef value;
+};
+
+// NOTE: Only recorded with -show-stats, just before the LLVM state of the module is released
+struct lbModuleStats {
+	bool  gathered;
+	isize functions; // with a body
+	isize instructions;
+	isize globals;
+};
+
 struct lbModule {
 	LLVMModuleRef mod;
 	LLVMContextRef ctx;
+	LLVMOrcThreadSafeContextRef jit_context; // -jit, owns `ctx`
 
 	Checker *checker;
 
@@ -115,6 +152,7 @@ struct lbModule {
 	CheckerInfo *info;
 	AstPackage *pkg; // possibly associated
 	AstFile *file;   // possibly associated
+	i32 partition_index; // > 0 for the extra modules of a partitioned file, see `lb_partition_file_procedures`
 	char const *module_name;
 
 	PtrMap<u64/*type hash*/, LLVMTypeRef>  types;                  // mutex: types_mutex
@@ -138,6 +176,8 @@ struct lbModule {
 
 	StringMap<LLVMValueRef>   const_strings;
 	String16Map<LLVMValueRef> const_string16s;
+	PtrMap<void *, LLVMValueRef> incbin_data; // Key: LoadFileCache.data.text
+	PtrMap<u64, LLVMValueRef> source_code_locations; // Key: hash of the file, procedure, line and column
 
 	PtrMap<u64/*type hash*/, struct lbFunctionType *> function_type_map;
 
@@ -170,11 +210,20 @@ struct lbModule {
 	PtrMap<u64/*type hash*/, lbAddr> map_info_map;      // address of runtime.Map_Cell_Info
 
 	PtrMap<Ast *, lbAddr> exact_value_compound_literal_addr_map; // Key: Ast_CompoundLit
+	PtrMap<void *, lbConstAggregate> const_aggregate_cache; // multi-map, Key: Ast_CompoundLit or string data
 
 	LLVMPassManagerRef function_pass_managers[lbFunctionPassManager_COUNT];
 
 	BlockingMutex pad_types_mutex;
 	Array<lbPadType> pad_types;
+
+	lbModuleStats stats;
+
+	// NOTE: With -cached, the object of the module is also looked up by a hash of its IR before the module
+	// passes, see `lb_llvm_module_find_cached_object`
+	u64    linkage_corrections_hash; // of the corrections which will be applied to this module
+	u64    unoptimized_object_hash;  // 0 if the module is not cached by its unoptimized IR
+	String unoptimized_cached_object; // set on a hit, the module is then neither optimized nor emitted
 };
 
 struct lbEntityCorrection {
@@ -191,6 +240,56 @@ struct lbObjCGlobal {
 	Type *    class_impl_type;  // This is set when the class has the objc_implement attribute set to true.
 };
 
+// NOTE: Only recorded with -internal-polymorphic-report, measured after the function passes
+struct lbPolymorphicInstance {
+	isize ir_instructions;
+	u64   body_hash;
+};
+
+gb_global ConcurrentPtrMap<Entity *, lbPolymorphicInstance> global_polymorphic_instances;
+
+// NOTE: Names of the procedures for which -isel:global fell back to SelectionDAG
+gb_global MPSCQueue<String> global_isel_fallbacks;
+
+// NOTE: Raw descriptions of the remarks enabled with -opt-remarks, "file:line:column: message"
+gb_global MPSCQueue<String> global_opt_remarks;
+
+struct lbStackUsage {
+	String  name;   // the LLVM name of the procedure
+	Entity *entity; // set when the procedure is created
+	u64     size;   // set when LLVM reports its stack frame
+};
+
+// NOTE: For -show-stack-usage and @(max_stack_usage), see `lb_gathers_stack_usage`
+gb_global MPSCQueue<lbStackUsage> global_stack_usages;
+
+// NOTE: Matches `runtime.Allocation_Site_Kind`
+enum lbAllocationSiteKind : u8 {
+	lbAllocationSite_Make,
+	lbAllocationSite_New,
+	lbAllocationSite_Append,
+	lbAllocationSite_Delete,
+	lbAllocationSite_Free,
+
+	lbAllocationSite_COUNT,
+};
+
+gb_global char const *lb_allocation_site_kind_strings[lbAllocationSite_COUNT] = {
+	"make",
+	"new",
+	"append",
+	"delete",
+	"free",
+};
+
+// NOTE: A call site instrumented by -instrument-allocations, see `lb_emit_allocation_site_hook`
+struct lbAllocationSite {
+	u64                  id;
+	lbAllocationSiteKind kind;
+	String               procedure;
+	TokenPos             pos;
+};
+
 struct lbGenerator : LinkerData {
 	CheckerInfo *info;
 
@@ -200,6 +299,10 @@ struct lbGenerator : LinkerData {
 
 	lbModule *equal_module;
 
+	// NOTE: -internal-partition-modules, the procedures of a file which is too large for a single module
+	// are spread across several, see `lb_partition_file_procedures`
+	PtrMap<Entity *, lbModule *> procedure_partitions;
+
 	isize used_module_count;
 
 	lbProcedure *startup_runtime;
@@ -207,10 +310,35 @@ struct lbGenerator : LinkerData {
 	lbProcedure *objc_names;
 
 	MPSCQueue<lbEntityCorrection> entities_to_correct_linkage;
+	Array<lbEntityCorrection>     linkage_corrections; // see `lb_gather_entity_linkage_corrections`
+
+	// NOTE: -instrument-allocations, see `lb_init_allocation_sites`
+	Entity *                               allocation_site_hook;
+	PtrMap<Entity *, lbAllocationSiteKind> allocation_site_procs;
+	MPSCQueue<lbAllocationSite>            allocation_sites;
+
 	MPSCQueue<lbObjCGlobal> objc_selectors;
 	MPSCQueue<lbObjCGlobal> objc_classes;
 	MPSCQueue<lbObjCGlobal> objc_ivars;
 	MPSCQueue<String> raddebug_section_strings;
+
+	// NOTE: With separate modules, only the first module to need the debug definition of a named
+	// record type emits it, every other module emits a declaration which the debugger resolves
+	bool share_debug_types;
+	ConcurrentPtrMap<u64/*type hash*/, lbModule *> debug_type_owners;
+
+	// NOTE: With separate modules, generated helpers (equal, hasher, map get/set procedures) are only
+	// defined by the first module to need them, every other module declares them externally
+	bool share_generated_helpers;
+	ConcurrentPtrMap<u64/*name hash*/, lbModule *> generated_helper_owners;
+
+	// NOTE: Large `#load`ed files which are embedded with `.incbin`, see `LOAD_FILE_LARGE_SIZE`
+	PtrMap<void *, LoadFileCache *> incbin_files; // Key: LoadFileCache.data.text
+	std::atomic<u32> incbin_index;
+
+	ConcurrentPtrMap<Type *, lbStructLayout *> struct_layouts; // see `lb_get_struct_layout`
+
+	ConcurrentPtrMap<u64/*signature hash*/, struct lbFunctionTypeMemo *> function_type_memo; // see `lb_get_abi_info_memoized`
 };
 
 
@@ -263,6 +391,7 @@ struct lbDefer {
 	isize       context_stack_count;
 	lbBlock *   block;
 	TokenPos    pos;
+	lbBlock *   return_cleanup; // shared by the returns which run this defer, see `lb_return_cleanup_block`
 	union {
 		Ast *stmt;
 		struct {
@@ -272,6 +401,12 @@ struct lbDefer {
 	};
 };
 
+// NOTE: Within the body of a range loop, `index` is known to be within the bounds of `array`
+struct lbRangeFact {
+	Entity *index;
+	Entity *array;
+};
+
 struct lbTargetList {
 	lbTargetList *prev;
 	bool          is_block;
@@ -342,6 +477,7 @@ struct lbProcedure {
 	lbBlock *        curr_block;
 	lbTargetList *   target_list;
 	PtrMap<Entity *, lbValue> direct_parameters;
+	PtrSet<Entity *> locals_written_before_read; // `x: T` locals which need no zeroing, see `lb_scan_for_locals_written_before_read`
 	bool             in_multi_assignment;
 	Array<LLVMValueRef> raw_input_parameters;
 
@@ -357,6 +493,13 @@ struct lbProcedure {
 	LLVMValueRef temp_callee_return_struct_memory;
 	Ast *curr_stmt;
 
+	// NOTE: Used once the defers of too many returns would have been duplicated, see `lb_emit_defers_and_return`
+	isize        return_defers_inlined;
+	lbBlock *    shared_return_block;
+	LLVMValueRef shared_return_value;
+
+	ArenaTemp scratch; // released once the procedure has been generated, see lb_scratch_allocator
+
 	Array<Scope *>       scope_stack;
 	Array<lbContextData> context_stack;
 
@@ -368,11 +511,17 @@ struct lbProcedure {
 
 	Array<lbValue> asan_stack_locals;
 
+	Array<lbRangeFact> range_facts; // see lb_push_range_fact
+
 	void (*generate_body)(lbModule *m, lbProcedure *p);
 	Array<lbGlobalVariable> *global_variables;
 	lbProcedure *objc_names;
 
 	Type *internal_gen_type; // map_set, map_get, etc.
+
+	// @(target_clones="...")
+	Slice<lbProcedure *> target_clones; // on the dispatcher, [0] is the baseline
+	TargetClone          target_clone;  // on each clone
 };
 
 
@@ -391,7 +540,10 @@ gb_internal LLVMAttributeRef lb_create_enum_attribute_with_type(LLVMContextRef c
 gb_internal void lb_add_proc_attribute_at_index(lbProcedure *p, isize index, char const *name, u64 value);
 gb_internal void lb_add_proc_attribute_at_index(lbProcedure *p, isize index, char const *name);
 gb_internal void lb_add_nocapture_proc_attribute_at_index(lbProcedure *p, isize index);
-gb_internal lbProcedure *lb_create_procedure(lbModule *module, Entity *entity, bool ignore_body=false);
+gb_internal lbProcedure *lb_create_procedure(lbModule *module, Entity *entity, bool ignore_body=false, TargetClone const *target_clone=nullptr);
+gb_internal void lb_generate_target_clones_dispatcher(lbModule *m, lbProcedure *p);
+
+gb_internal void lb_gather_module_stats(lbModule *m);
 
 
 gb_internal LLVMTypeRef lb_type(lbModule *m, Type *type);
@@ -399,6 +551,8 @@ gb_internal LLVMTypeRef llvm_get_element_type(LLVMTypeRef type);
 
 gb_internal lbBlock *lb_create_block(lbProcedure *p, char const *name, bool append=false);
 
+gb_internal gbAllocator lb_scratch_allocator(lbProcedure *p);
+
 struct lbConstContext {
 	bool   allow_local;
 	bool   is_rodata;
@@ -414,6 +568,7 @@ gb_internal lbValue lb_const_undef(lbModule *m, Type *type);
 gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, Type *value_type=nullptr, lbConstContext cc = LB_CONST_CONTEXT_DEFAULT);
 gb_internal lbValue lb_const_bool(lbModule *m, Type *type, bool value);
 gb_internal lbValue lb_const_int(lbModule *m, Type *type, u64 value);
+gb_internal LLVMValueRef lb_const_low_bits_mask(LLVMTypeRef type, u64 bit_count);
 
 
 gb_internal lbAddr lb_addr(lbValue addr);
@@ -450,6 +605,7 @@ gb_internal lbValue lb_emit_arith(lbProcedure *p, TokenKind op, lbValue lhs, lbV
 gb_internal lbValue lb_emit_byte_swap(lbProcedure *p, lbValue value, Type *end_type);
 gb_internal void lb_emit_defer_stmts(lbProcedure *p, lbDeferExitKind kind, lbBlock *block, TokenPos pos);
 gb_internal void lb_emit_defer_stmts(lbProcedure *p, lbDeferExitKind kind, lbBlock *block, Ast *node);
+gb_internal void lb_emit_defers_and_return(lbProcedure *p, LLVMValueRef ret_val, TokenPos pos);
 gb_internal lbValue lb_emit_transmute(lbProcedure *p, lbValue value, Type *t);
 gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue right);
 gb_internal lbValue lb_emit_call(lbProcedure *p, lbValue value, Array<lbValue> const &args, ProcInlining inlining = ProcInlining_none, ProcTailing tailing = ProcTailing_none, lbValue *sret_dst = nullptr);
@@ -526,6 +682,8 @@ gb_internal lbValue lb_gen_map_cell_info_ptr(lbModule *m, Type *type);
 gb_internal lbValue lb_gen_map_info_ptr(lbModule *m, Type *map_type);
 
 gb_internal lbValue lb_internal_dynamic_map_get_ptr(lbProcedure *p, lbValue const &map_ptr, lbValue const &key);
+gb_internal bool    lb_simple_compare_can_use_wide_ops(Type *type);
+gb_internal lbValue lb_simple_compare_wide_equal(lbProcedure *p, Type *type, lbValue lhs, lbValue rhs);
 gb_internal void    lb_internal_dynamic_map_set(lbProcedure *p, lbValue const &map_ptr, Type *map_type, lbValue const &map_key, lbValue const &map_value, Ast *node);
 gb_internal lbValue lb_dynamic_map_reserve(lbProcedure *p, lbValue const &map_ptr, isize const capacity, TokenPos const &pos);
 
@@ -575,6 +733,7 @@ gb_internal void lb_emit_init_context(lbProcedure *p, lbAddr addr);
 gb_internal lbBranchBlocks lb_lookup_branch_blocks(lbProcedure *p, Ast *ident);
 
 gb_internal lbStructFieldRemapping lb_get_struct_remapping(lbModule *m, Type *t);
+gb_internal lbStructLayout *lb_get_struct_layout(lbModule *m, Type *type);
 gb_internal LLVMTypeRef lb_type_padding_filler(lbModule *m, i64 padding, i64 padding_align);
 
 gb_internal LLVMValueRef llvm_basic_shuffle(lbProcedure *p, LLVMValueRef vector, LLVMValueRef mask);
@@ -621,6 +780,8 @@ gb_internal String lb_internal_gen_name_from_type(char const *prefix, Type *type
 gb_internal void lb_set_metadata_custom_u64(lbModule *m, LLVMValueRef v_ref, String name, u64 value);
 gb_internal u64 lb_get_metadata_custom_u64(lbModule *m, LLVMValueRef v_ref, String name);
 
+gb_internal void lb_diagnostic_handler(LLVMDiagnosticInfoRef info, void *user_data);
+
 #define LB_STARTUP_RUNTIME_PROC_NAME   "__$startup_runtime"
 #define LB_CLEANUP_RUNTIME_PROC_NAME   "__$cleanup_runtime"
 #define LB_TYPE_INFO_DATA_NAME       "__$type_info_data"
@@ -630,6 +791,8 @@ gb_internal u64 lb_get_metadata_custom_u64(lbModule *m, LLVMValueRef v_ref, Stri
 #define LB_TYPE_INFO_USINGS_NAME     "__$type_info_usings_data"
 #define LB_TYPE_INFO_TAGS_NAME       "__$type_info_tags_data"
 
+#define LB_TYPE_SWITCH_METADATA      "odin.type_switch"
+
 
 
 enum lbCallingConventionKind : unsigned {
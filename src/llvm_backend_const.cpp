@@ -340,8 +340,16 @@ gb_internal lbValue lb_expr_untyped_const_to_typed(lbModule *m, Ast *expr, Type
 }
 
 
-gb_internal lbValue lb_const_source_code_location_const(lbModule *m, String const &procedure_, TokenPos const &pos) {
-	String file = get_file_path_string(pos.file_id);
+struct lbSourceCodeLocationFields {
+	String file;
+	String procedure;
+	i32    line;
+	i32    column;
+};
+
+// NOTE: The values as they are stored, which depend on `-source-code-locations`
+gb_internal lbSourceCodeLocationFields lb_source_code_location_fields(String const &procedure_, TokenPos const &pos) {
+	String file = remap_path_prefix(get_file_path_string(pos.file_id));
 	String procedure = procedure_;
 
 	i32 line   = pos.line;
@@ -369,11 +377,15 @@ gb_internal lbValue lb_const_source_code_location_const(lbModule *m, String cons
 		break;
 	}
 
+	return lbSourceCodeLocationFields{file, procedure, line, column};
+}
+
+gb_internal lbValue lb_const_source_code_location_const(lbModule *m, lbSourceCodeLocationFields const &loc) {
 	LLVMValueRef fields[4] = {};
-	fields[0]/*file*/      = lb_find_or_add_entity_string(m, file, false).value;
-	fields[1]/*line*/      = lb_const_int(m, t_i32, line).value;
-	fields[2]/*column*/    = lb_const_int(m, t_i32, column).value;
-	fields[3]/*procedure*/ = lb_find_or_add_entity_string(m, procedure, false).value;
+	fields[0]/*file*/      = lb_find_or_add_entity_string(m, loc.file, false).value;
+	fields[1]/*line*/      = lb_const_int(m, t_i32, loc.line).value;
+	fields[2]/*column*/    = lb_const_int(m, t_i32, loc.column).value;
+	fields[3]/*procedure*/ = lb_find_or_add_entity_string(m, loc.procedure, false).value;
 
 	lbValue res = {};
 	res.value = llvm_const_named_struct(m, t_source_code_location, fields, gb_count_of(fields));
@@ -381,6 +393,10 @@ gb_internal lbValue lb_const_source_code_location_const(lbModule *m, String cons
 	return res;
 }
 
+gb_internal lbValue lb_const_source_code_location_const(lbModule *m, String const &procedure, TokenPos const &pos) {
+	return lb_const_source_code_location_const(m, lb_source_code_location_fields(procedure, pos));
+}
+
 
 gb_internal lbValue lb_emit_source_code_location_const(lbProcedure *p, String const &procedure, TokenPos const &pos) {
 	lbModule *m = p->module;
@@ -399,21 +415,46 @@ gb_internal lbValue lb_emit_source_code_location_const(lbProcedure *p, Ast *node
 	return lb_emit_source_code_location_const(p, proc_name, pos);
 }
 
-gb_internal String lb_source_code_location_gen_name(String const &procedure, TokenPos const &pos) {
-	gbString s = gb_string_make(permanent_allocator(), "scl$[");
+// NOTE: Every bounds check, assertion, and allocator call needs one of these, so they are pooled per module:
+// all the uses of a location within a module share a single global, and the file and procedure name
+// strings are shared through `const_strings`
+gb_internal lbValue lb_const_source_code_location_as_global_ptr(lbModule *m, String const &procedure, TokenPos const &pos) {
+	lbSourceCodeLocationFields loc = lb_source_code_location_fields(procedure, pos);
+
+	u64 key = xxh64(loc.file.text, loc.file.len, 0x5c1);
+	key = xxh64(loc.procedure.text, loc.procedure.len, key);
+	key ^= (cast(u64)cast(u32)loc.line << 32) | cast(u64)cast(u32)loc.column;
+	key = key ? key : 1;
 
-	s = gb_string_append_length(s, procedure.text, procedure.len);
-	if (pos.offset != 0) {
-		s = gb_string_append_fmt(s, "%d", pos.offset);
-	} else {
-		s = gb_string_append_fmt(s, "%d_%d", pos.line, pos.column);
+	lbValue res = {};
+	res.type = alloc_type_pointer(t_source_code_location);
+
+	LLVMValueRef *found = map_get(&m->source_code_locations, key);
+	if (found) {
+		res.value = *found;
+		return res;
 	}
-	s = gb_string_appendc(s, "]");
 
-	return make_string(cast(u8 const *)s, gb_string_length(s));
+	lbValue value = lb_const_source_code_location_const(m, loc);
+
+	u32 id = m->global_array_index.fetch_add(1);
+	gbString name = gb_string_make(temporary_allocator(), "scl$");
+	name = gb_string_appendc(name, m->module_name);
+	name = gb_string_append_fmt(name, "$%x", id);
+
+	res.value = LLVMAddGlobal(m->mod, LLVMTypeOf(value.value), name);
+	LLVMSetInitializer(res.value, value.value);
+	lb_make_global_private_const(res.value);
+
+	map_set(&m->source_code_locations, key, res.value);
+	return res;
 }
 
-gb_internal String lb_source_code_location_gen_name(lbProcedure *p, Ast *node) {
+gb_internal lbValue lb_emit_source_code_location_as_global_ptr(lbProcedure *p, String const &procedure, TokenPos const &pos) {
+	return lb_const_source_code_location_as_global_ptr(p->module, procedure, pos);
+}
+
+gb_internal lbValue lb_emit_source_code_location_as_global_ptr(lbProcedure *p, Ast *node) {
 	String proc_name = {};
 	if (p->entity) {
 		proc_name = p->entity->token.string;
@@ -422,30 +463,7 @@ gb_internal String lb_source_code_location_gen_name(lbProcedure *p, Ast *node) {
 	if (node) {
 		pos = ast_token(node).pos;
 	}
-	return lb_source_code_location_gen_name(proc_name, pos);
-}
-
-
-
-gb_internal lbValue lb_emit_source_code_location_as_global_ptr(lbProcedure *p, String const &procedure, TokenPos const &pos) {
-	lbValue loc = lb_emit_source_code_location_const(p, procedure, pos);
-	lbAddr addr = lb_add_global_generated_with_name(p->module, loc.type, loc, lb_source_code_location_gen_name(procedure, pos));
-	lb_make_global_private_const(addr);
-	return addr.addr;
-}
-
-gb_internal lbValue lb_const_source_code_location_as_global_ptr(lbModule *m, String const &procedure, TokenPos const &pos) {
-	lbValue loc = lb_const_source_code_location_const(m, procedure, pos);
-	lbAddr addr = lb_add_global_generated_with_name(m, loc.type, loc, lb_source_code_location_gen_name(procedure, pos));
-	lb_make_global_private_const(addr);
-	return addr.addr;
-}
-
-gb_internal lbValue lb_emit_source_code_location_as_global_ptr(lbProcedure *p, Ast *node) {
-	lbValue loc = lb_emit_source_code_location_const(p, node);
-	lbAddr addr = lb_add_global_generated_with_name(p->module, loc.type, loc, lb_source_code_location_gen_name(p, node));
-	lb_make_global_private_const(addr);
-	return addr.addr;
+	return lb_const_source_code_location_as_global_ptr(p->module, proc_name, pos);
 }
 
 
@@ -496,6 +514,104 @@ gb_internal LLVMValueRef lb_build_constant_array_values(lbModule *m, Type *type,
 	return llvm_const_array(m, lb_type(m, elem_type), values, cast(unsigned int)count);
 }
 
+// NOTE: Lookup tables, e.g. `[65536]u8{...}` or `[]f32{...}`, are evaluated straight into a packed buffer
+// and become a single constant data array, rather than going through `lb_const_value` for every element
+gb_internal bool lb_const_packed_numeric_array(lbModule *m, Type *elem_type, i64 count, Ast *value_compound, LLVMValueRef *value_) {
+	Type *et = core_type(base_enum_type(elem_type));
+	if (et->kind != Type_Basic || is_type_endian_specific(et)) {
+		return false;
+	}
+	bool is_float = false;
+	switch (et->Basic.kind) {
+	case Basic_f32:
+	case Basic_f64:
+		is_float = true;
+		break;
+	default:
+		if ((et->Basic.flags & BasicFlag_Integer) == 0 || is_type_boolean(et)) {
+			return false;
+		}
+		break;
+	}
+	i64 elem_size = type_size_of(et);
+	if (elem_size != 1 && elem_size != 2 && elem_size != 4 && elem_size != 8) {
+		return false;
+	}
+
+	ast_node(cl, CompoundLit, value_compound);
+	GB_ASSERT(cl->elems.count <= count);
+	for (Ast *elem : cl->elems) {
+		ExactValue v = elem->tav.value;
+		if (elem->tav.mode != Addressing_Constant || (v.kind != ExactValue_Integer && v.kind != ExactValue_Float)) {
+			return false;
+		}
+	}
+
+	TEMPORARY_ALLOCATOR_GUARD();
+	isize size = cast(isize)(count*elem_size);
+	u8 *data = gb_alloc_array(temporary_allocator(), u8, size);
+	gb_zero_size(data, size);
+
+	// NOTE: the buffer is in the host's byte order, which is what LLVM expects for raw constant data
+	for_array(i, cl->elems) {
+		ExactValue v = cl->elems[i]->tav.value;
+		u8 *dst = data + i*elem_size;
+		if (is_float) {
+			f64 f = exact_value_to_f64(v);
+			if (elem_size == 4) {
+				f32 f32_ = cast(f32)f;
+				gb_memmove(dst, &f32_, 4);
+			} else {
+				gb_memmove(dst, &f, 8);
+			}
+			continue;
+		}
+		u64 x = is_type_unsigned(et) ? exact_value_to_u64(v) : cast(u64)exact_value_to_i64(v);
+		switch (elem_size) {
+		case 1: { u8  y = cast(u8) x; gb_memmove(dst, &y, 1); } break;
+		case 2: { u16 y = cast(u16)x; gb_memmove(dst, &y, 2); } break;
+		case 4: { u32 y = cast(u32)x; gb_memmove(dst, &y, 4); } break;
+		case 8: {                     gb_memmove(dst, &x, 8); } break;
+		}
+	}
+
+	LLVMTypeRef llvm_elem_type = lb_type(m, elem_type);
+#if LLVM_VERSION_MAJOR >= 21
+	*value_ = LLVMConstDataArray(llvm_elem_type, cast(char const *)data, cast(size_t)size);
+#else
+	if (elem_size == 1) {
+		*value_ = LLVMConstStringInContext2(m->ctx, cast(char const *)data, cast(size_t)size, true /*DontNullTerminate*/);
+		return true;
+	}
+	// NOTE: without `LLVMConstDataArray`, the elements still skip `lb_const_value`
+	LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, cast(isize)count);
+	for (i64 i = 0; i < count; i++) {
+		u8 const *src = data + i*elem_size;
+		if (is_float) {
+			f64 f = 0;
+			if (elem_size == 4) {
+				f32 f32_ = 0;
+				gb_memmove(&f32_, src, 4);
+				f = f32_;
+			} else {
+				gb_memmove(&f, src, 8);
+			}
+			values[i] = LLVMConstReal(llvm_elem_type, f);
+			continue;
+		}
+		u64 x = 0;
+		switch (elem_size) {
+		case 2: { u16 y = 0; gb_memmove(&y, src, 2); x = y; } break;
+		case 4: { u32 y = 0; gb_memmove(&y, src, 4); x = y; } break;
+		case 8: {            gb_memmove(&x, src, 8);        } break;
+		}
+		values[i] = LLVMConstInt(llvm_elem_type, x, false);
+	}
+	*value_ = LLVMConstArray(llvm_elem_type, values, cast(unsigned)count);
+#endif
+	return true;
+}
+
 gb_internal LLVMValueRef lb_big_int_to_llvm(lbModule *m, Type *original_type, BigInt const *a) {
 	if (big_int_is_zero(a)) {
 		return LLVMConstNull(lb_type(m, original_type));
@@ -787,7 +903,65 @@ gb_internal lbValue lb_const_value_bit_field(lbModule *m, Type *type, Ast *value
 }
 
 
+// NOTE: Constant slices get their own backing global (or stack memory) for each use, so they
+// must never be shared between uses
+gb_internal bool lb_const_type_contains_slice(Type *t) {
+	t = core_type(t);
+	switch (t->kind) {
+	case Type_Slice:
+		return true;
+	case Type_Array:
+		return lb_const_type_contains_slice(t->Array.elem);
+	case Type_EnumeratedArray:
+		return lb_const_type_contains_slice(t->EnumeratedArray.elem);
+	case Type_Struct:
+		for (Entity *f : t->Struct.fields) {
+			if (lb_const_type_contains_slice(f->type)) {
+				return true;
+			}
+		}
+		return false;
+	case Type_Union:
+		for (Type *v : t->Union.variants) {
+			if (lb_const_type_contains_slice(v)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	return false;
+}
+
+gb_internal lbValue lb_const_value_uncached(lbModule *m, Type *type, ExactValue value, Type *value_type, lbConstContext cc);
+
 gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, Type *value_type, lbConstContext cc) {
+	void *key = nullptr;
+	if (value.kind == ExactValue_Compound) {
+		key = value.value_compound;
+	} else if (value.kind == ExactValue_String && value.value_string.len > 0 && is_type_u8_array(core_type(default_type(type)))) {
+		// NOTE: mostly `#load` data
+		key = value.value_string.text;
+	}
+	if (key == nullptr || lb_const_type_contains_slice(type)) {
+		return lb_const_value_uncached(m, type, value, value_type, cc);
+	}
+
+	for (auto *entry = multi_map_find_first(&m->const_aggregate_cache, key);
+	     entry != nullptr;
+	     entry = multi_map_find_next(&m->const_aggregate_cache, entry)) {
+		if (entry->value.type == type && entry->value.value_type == value_type) {
+			return lbValue{entry->value.value, default_type(type)};
+		}
+	}
+
+	lbValue res = lb_const_value_uncached(m, type, value, value_type, cc);
+	if (res.value != nullptr && LLVMIsConstant(res.value)) {
+		multi_map_insert(&m->const_aggregate_cache, key, lbConstAggregate{type, value_type, res.value});
+	}
+	return res;
+}
+
+gb_internal lbValue lb_const_value_uncached(lbModule *m, Type *type, ExactValue value, Type *value_type, lbConstContext cc) {
 	if (cc.allow_local) {
 		cc.is_rodata = false;
 	}
@@ -1590,6 +1764,10 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, Ty
 				// Assume that compound value is an array literal
 				GB_ASSERT_MSG(elem_count <= type->Array.count, "%td <= %td", elem_count, type->Array.count);
 
+				if (lb_const_packed_numeric_array(m, elem_type, type->Array.count, value.value_compound, &res.value)) {
+					return res;
+				}
+
 				LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, cast(isize)type->Array.count);
 
 				isize elem_index = 0;
@@ -1700,7 +1878,7 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, Ty
 					}
 				}
 
-				res.value = lb_build_constant_array_values(m, type, elem_type, cast(isize)type->Array.count, values, cc);
+				res.value = lb_build_constant_array_values(m, type, elem_type, cast(isize)type->EnumeratedArray.count, values, cc);
 				return res;
 			}
 		} else if (is_type_fixed_capacity_dynamic_array(type)) {
@@ -2278,3 +2456,134 @@ gb_internal lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, Ty
 
 	return lb_const_nil(m, original_type);
 }
+
+
+// NOTE: Folds the initializer of a global variable which the checker could not evaluate into a constant,
+// e.g. a compound literal containing procedures or the addresses of other global variables, so that it
+// does not need to be stored by `__$startup_runtime`
+gb_internal bool lb_const_global_init_value(lbModule *m, Type *type, Ast *expr, lbConstContext cc, LLVMValueRef *value_, isize depth=0) {
+	if (expr == nullptr || depth > 32) {
+		return false;
+	}
+	expr = unparen_expr(expr);
+	TypeAndValue tav = type_and_value_of_expr(expr);
+	if (tav.mode == Addressing_Invalid || tav.type == nullptr) {
+		return false;
+	}
+
+	if (is_type_untyped_nil(tav.type)) {
+		*value_ = LLVMConstNull(lb_type(m, type));
+		return true;
+	}
+	if (tav.value.kind != ExactValue_Invalid) {
+		if (!elem_type_can_be_constant(type)) {
+			return false;
+		}
+		*value_ = lb_const_value(m, type, tav.value, tav.type, cc).value;
+		return *value_ != nullptr;
+	}
+
+	// NOTE: Anything which needs a conversion is left to the startup procedure
+	if (!are_types_identical(default_type(tav.type), type)) {
+		return false;
+	}
+
+	Type *bt = base_type(type);
+	switch (expr->kind) {
+	case Ast_Ident: {
+		Entity *e = entity_of_node(expr);
+		if (e != nullptr && e->kind == Entity_Procedure && !is_type_polymorphic(e->type)) {
+			*value_ = lb_find_procedure_value_from_entity(m, e).value;
+			return *value_ != nullptr;
+		}
+		return false;
+	}
+
+	case Ast_UnaryExpr: {
+		if (expr->UnaryExpr.op.kind != Token_And) {
+			return false;
+		}
+		Ast *operand = unparen_expr(expr->UnaryExpr.expr);
+		if (operand->kind != Ast_Ident) {
+			return false;
+		}
+		Entity *e = entity_of_node(operand);
+		if (e == nullptr || e->kind != Entity_Variable ||
+		    e->scope == nullptr || (e->scope->flags & ScopeFlag_File) == 0 ||
+		    e->Variable.thread_local_model.len != 0) {
+			return false;
+		}
+		rw_mutex_shared_lock(&m->values_mutex);
+		lbValue *found = map_get(&m->values, e);
+		rw_mutex_shared_unlock(&m->values_mutex);
+		if (found == nullptr) {
+			return false;
+		}
+		*value_ = found->value;
+		return true;
+	}
+
+	case Ast_CompoundLit: {
+		Slice<Ast *> const &elems = expr->CompoundLit.elems;
+		if (bt->kind == Type_Struct) {
+			if (bt->Struct.is_raw_union || bt->Struct.soa_kind != StructSoa_None || is_type_polymorphic(bt)) {
+				return false;
+			}
+			isize field_count = bt->Struct.fields.count;
+			LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, field_count);
+			for_array(i, elems) {
+				Ast *elem = elems[i];
+				isize index = i;
+				if (elem->kind == Ast_FieldValue) {
+					Ast *name = elem->FieldValue.field;
+					if (name->kind != Ast_Ident) {
+						return false;
+					}
+					Selection sel = lookup_field(type, name->Ident.interned, false);
+					if (sel.entity == nullptr || sel.index.count != 1) {
+						return false;
+					}
+					index = sel.index[0];
+					elem = elem->FieldValue.value;
+				}
+				if (index < 0 || index >= field_count) {
+					return false;
+				}
+				Type *ft = bt->Struct.fields[index]->type;
+				if (!lb_const_global_init_value(m, ft, elem, cc, &values[index], depth+1)) {
+					return false;
+				}
+			}
+			for (isize i = 0; i < field_count; i++) {
+				if (values[i] == nullptr) {
+					values[i] = LLVMConstNull(lb_type(m, bt->Struct.fields[i]->type));
+				}
+			}
+			*value_ = llvm_const_named_struct(m, type, values, field_count);
+			return true;
+		} else if (bt->kind == Type_Array) {
+			isize count = cast(isize)bt->Array.count;
+			if (elems.count > count) {
+				return false;
+			}
+			LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+			for_array(i, elems) {
+				if (elems[i]->kind == Ast_FieldValue) {
+					return false;
+				}
+				if (!lb_const_global_init_value(m, bt->Array.elem, elems[i], cc, &values[i], depth+1)) {
+					return false;
+				}
+			}
+			LLVMTypeRef elem_type = lb_type(m, bt->Array.elem);
+			for (isize i = elems.count; i < count; i++) {
+				values[i] = LLVMConstNull(elem_type);
+			}
+			*value_ = llvm_const_array(m, elem_type, values, count);
+			return true;
+		}
+		return false;
+	}
+	}
+	return false;
+}
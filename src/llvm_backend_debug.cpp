@@ -94,6 +94,10 @@ gb_internal LLVMMetadataRef lb_debug_type_internal_proc(lbModule *m, Type *type)
 	unsigned const ptr_bits = cast(unsigned)(8*build_context.ptr_size); */
 
 	GB_ASSERT(type->kind == Type_Proc);
+	if (lb_debug_line_tables_only()) {
+		return LLVMDIBuilderCreateSubroutineType(m->debug_builder, nullptr, nullptr, 0, type->Proc.diverging ? LLVMDIFlagNoReturn : LLVMDIFlagZero);
+	}
+
 	unsigned parameter_count = 1;
 	for (i32 i = 0; i < type->Proc.param_count; i++) {
 		Entity *e = type->Proc.params->Tuple.variables[i];
@@ -189,6 +193,31 @@ gb_internal LLVMMetadataRef lb_debug_basic_struct(lbModule *m, String const &nam
 	return LLVMDIBuilderCreateStructType(m->debug_builder, scope, cast(char const *)name.text, name.len, file, 1, size_in_bits, align_in_bits, LLVMDIFlagZero, nullptr, elements, element_count, 0, nullptr, "", 0);
 }
 
+// NOTE: Returns true if `m` should emit the full definition of `type`, otherwise a declaration
+// is enough as another module has already claimed the definition
+gb_internal bool lb_debug_type_claim_definition(lbModule *m, Type *type) {
+	lbGenerator *gen = m->gen;
+	if (gen == nullptr || !gen->share_debug_types || type->kind != Type_Named) {
+		return true;
+	}
+	u64 key = type_hash_canonical_type(type);
+	if (!concurrent_map_set_if_not_previously_exists(&gen->debug_type_owners, key, m)) {
+		return true;
+	}
+	lbModule *owner = nullptr;
+	concurrent_map_get(&gen->debug_type_owners, key, &owner);
+	return owner == m;
+}
+
+// NOTE: The canonical name doubles as the ODR identifier, which ties the declarations in the other
+// modules to the single definition
+gb_internal String lb_debug_type_identifier(lbModule *m, Type *type, String const &name) {
+	if (m->gen != nullptr && m->gen->share_debug_types && type->kind == Type_Named) {
+		return name;
+	}
+	return {};
+}
+
 gb_internal LLVMMetadataRef lb_debug_struct(lbModule *m, Type *type, Type *bt, String name, LLVMMetadataRef scope, LLVMMetadataRef file, unsigned line) {
 	GB_ASSERT(bt->kind == Type_Struct);
 
@@ -202,6 +231,18 @@ gb_internal LLVMMetadataRef lb_debug_struct(lbModule *m, Type *type, Type *bt, S
 	u64 size_in_bits = 8*type_size_of(bt);
 	u32 align_in_bits = 8*cast(u32)type_align_of(bt);
 
+	String identifier = lb_debug_type_identifier(m, type, name);
+	if (!lb_debug_type_claim_definition(m, type)) {
+		LLVMMetadataRef decl = LLVMDIBuilderCreateForwardDecl(
+			m->debug_builder, tag,
+			cast(char const *)name.text, cast(size_t)name.len,
+			scope, file, line, 0, size_in_bits, align_in_bits,
+			cast(char const *)identifier.text, cast(size_t)identifier.len
+		);
+		lb_set_llvm_metadata(m, type, decl);
+		return decl;
+	}
+
 	LLVMMetadataRef temp_forward_decl = LLVMDIBuilderCreateReplaceableCompositeType(
 		m->debug_builder, tag,
 		cast(char const *)name.text, cast(size_t)name.len,
@@ -248,7 +289,7 @@ gb_internal LLVMMetadataRef lb_debug_struct(lbModule *m, Type *type, Type *bt, S
 			LLVMDIFlagZero,
 			elements, element_count,
 			0,
-			"", 0
+			cast(char const *)identifier.text, cast(size_t)identifier.len
 		);
 	} else {
 		 final_decl = LLVMDIBuilderCreateStructType(
@@ -261,7 +302,7 @@ gb_internal LLVMMetadataRef lb_debug_struct(lbModule *m, Type *type, Type *bt, S
 			elements, element_count,
 			0,
 			nullptr,
-			"", 0
+			cast(char const *)identifier.text, cast(size_t)identifier.len
 		);
 	}
 
@@ -481,6 +522,18 @@ gb_internal LLVMMetadataRef lb_debug_union(lbModule *m, Type *type, String name,
 	u64 size_in_bits = 8*type_size_of(bt);
 	u32 align_in_bits = 8*cast(u32)type_align_of(bt);
 
+	String identifier = lb_debug_type_identifier(m, type, name);
+	if (!lb_debug_type_claim_definition(m, type)) {
+		LLVMMetadataRef decl = LLVMDIBuilderCreateForwardDecl(
+			m->debug_builder, DW_TAG_union_type,
+			cast(char const *)name.text, cast(size_t)name.len,
+			scope, file, line, 0, size_in_bits, align_in_bits,
+			cast(char const *)identifier.text, cast(size_t)identifier.len
+		);
+		lb_set_llvm_metadata(m, type, decl);
+		return decl;
+	}
+
 	LLVMMetadataRef temp_forward_decl = LLVMDIBuilderCreateReplaceableCompositeType(
 		m->debug_builder, DW_TAG_union_type,
 		cast(char const *)name.text, cast(size_t)name.len,
@@ -548,7 +601,7 @@ gb_internal LLVMMetadataRef lb_debug_union(lbModule *m, Type *type, String name,
 		elements,
 		element_count,
 		0,
-		"", 0
+		cast(char const *)identifier.text, cast(size_t)identifier.len
 	);
 
 	LLVMMetadataReplaceAllUsesWith(temp_forward_decl, final_decl);
@@ -1190,7 +1243,7 @@ gb_internal LLVMMetadataRef lb_debug_type(lbModule *m, Type *type) {
 }
 
 gb_internal void lb_add_debug_local_variable(lbProcedure *p, LLVMValueRef ptr, Type *type, Token const &token) {
-	if (p->debug_info == nullptr) {
+	if (p->debug_info == nullptr || lb_debug_line_tables_only()) {
 		return;
 	}
 	if (type == nullptr) {
@@ -1256,7 +1309,7 @@ gb_internal void lb_add_debug_local_variable(lbProcedure *p, LLVMValueRef ptr, T
 }
 
 gb_internal void lb_add_debug_param_variable(lbProcedure *p, LLVMValueRef ptr, Type *type, Token const &token, unsigned arg_number, lbBlock *block) {
-	if (p->debug_info == nullptr) {
+	if (p->debug_info == nullptr || lb_debug_line_tables_only()) {
 		return;
 	}
 	if (type == nullptr) {
@@ -1321,7 +1374,7 @@ gb_internal void lb_add_debug_param_variable(lbProcedure *p, LLVMValueRef ptr, T
 
 
 gb_internal void lb_add_debug_context_variable(lbProcedure *p, lbAddr const &ctx) {
-	if (!p->debug_info || !p->body) {
+	if (!p->debug_info || !p->body || lb_debug_line_tables_only()) {
 		return;
 	}
 	LLVMMetadataRef loc = LLVMGetCurrentDebugLocation2(p->builder);
@@ -1461,7 +1514,7 @@ gb_internal void lb_add_debug_info_for_global_constant_from_entity(lbGenerator *
 gb_internal void lb_add_debug_label(lbProcedure *p, Ast *label, lbBlock *target) {
 // NOTE(tf2spi): LLVM-C DILabel API used only existed for major versions 20+
 #if LLVM_VERSION_MAJOR >= 20
-	if (p == nullptr || p->debug_info == nullptr) {
+	if (p == nullptr || p->debug_info == nullptr || lb_debug_line_tables_only()) {
 		return;
 	}
 	if (target == nullptr || label == nullptr || label->kind != Ast_Label) {
@@ -938,6 +938,16 @@ gb_internal lbValue lb_emit_outer_product(lbProcedure *p, lbValue a, lbValue b,
 
 }
 
+// NOTE: Stores a whole column (or row for #row_major) vector starting at the element (row, column)
+gb_internal void lb_emit_matrix_store_vector(lbProcedure *p, lbValue matrix_ptr, LLVMValueRef vector, unsigned row, unsigned column) {
+	lbValue dst = lb_emit_matrix_epi(p, matrix_ptr, row, column);
+	Type *elem = base_type(type_deref(matrix_ptr.type))->Matrix.elem;
+
+	LLVMValueRef ptr = LLVMBuildPointerCast(p->builder, dst.value, LLVMPointerType(LLVMTypeOf(vector), 0), "");
+	LLVMValueRef store = LLVMBuildStore(p->builder, vector, ptr);
+	LLVMSetAlignment(store, cast(unsigned)type_align_of(elem));
+}
+
 gb_internal lbValue lb_emit_matrix_mul(lbProcedure *p, lbValue lhs, lbValue rhs, Type *type) {
 	// TODO(bill): Handle edge case for f16 types on x86(-64) platforms
 
@@ -1015,37 +1025,23 @@ gb_internal lbValue lb_emit_matrix_mul(lbProcedure *p, lbValue lhs, lbValue rhs,
 			}
 
 
-			auto x_rows = slice_make<LLVMValueRef>(permanent_allocator(), outer_rows);
-			auto y_columns = slice_make<LLVMValueRef>(permanent_allocator(), outer_columns);
-
+			// NOTE: Each column of the result is a linear combination of the columns of `x`, which keeps
+			// every step a vertical multiply and add rather than a horizontal reduction per element
+			auto x_columns  = slice_make<LLVMValueRef>(permanent_allocator(), inner);
 			auto mask_elems = slice_make<LLVMValueRef>(permanent_allocator(), inner);
-			for (unsigned i = 0; i < outer_rows; i++) {
-				for (unsigned j = 0; j < inner; j++) {
-					unsigned offset = x_stride*j + i;
-					mask_elems[j] = do_u32(p, offset);
-				}
-
-				// transpose mask
-				LLVMValueRef mask = LLVMConstVector(mask_elems.data, inner);
-				LLVMValueRef row = llvm_basic_shuffle(p, x_vector, mask);
-				x_rows[i] = row;
-			}
-
-			for (unsigned i = 0; i < outer_columns; i++) {
-				LLVMValueRef mask = llvm_mask_iota(p->module, y_stride*i, inner);
-				LLVMValueRef column = llvm_basic_shuffle(p, y_vector, mask);
-				y_columns[i] = column;
+			for (unsigned k = 0; k < inner; k++) {
+				LLVMValueRef mask = llvm_mask_iota(p->module, x_stride*k, outer_rows);
+				x_columns[k] = llvm_basic_shuffle(p, x_vector, mask);
 			}
 
 			lbAddr res = lb_add_local_generated(p, type, false);
-			for_array(i, x_rows) {
-				LLVMValueRef x_row = x_rows[i];
-				for_array(j, y_columns) {
-					LLVMValueRef y_column = y_columns[j];
-					LLVMValueRef elem = llvm_vector_dot(p, x_row, y_column);
-					lbValue dst = lb_emit_matrix_epi(p, res.addr, i, j);
-					LLVMBuildStore(p->builder, elem, dst.value);
+			for (unsigned j = 0; j < outer_columns; j++) {
+				for (unsigned k = 0; k < inner; k++) {
+					LLVMValueRef mask = llvm_mask_same(p->module, y_stride*j + k, outer_rows);
+					mask_elems[k] = llvm_basic_shuffle(p, y_vector, mask);
 				}
+				LLVMValueRef z_column = llvm_vector_mul_pairwise_reduce_add(p, x_columns, mask_elems);
+				lb_emit_matrix_store_vector(p, res.addr, z_column, 0, j);
 			}
 			return lb_addr_load(p, res);
 		} else { // #row_major
@@ -1100,37 +1096,22 @@ gb_internal lbValue lb_emit_matrix_mul(lbProcedure *p, lbValue lhs, lbValue rhs,
 				return lb_addr_load(p, res);
 			}
 
-			auto x_rows = slice_make<LLVMValueRef>(permanent_allocator(), outer_rows);
-			auto y_columns = slice_make<LLVMValueRef>(permanent_allocator(), outer_columns);
-
-			for (unsigned i = 0; i < outer_rows; i++) {
-				LLVMValueRef mask = llvm_mask_iota(p->module, x_stride*i, inner);
-				LLVMValueRef row = llvm_basic_shuffle(p, x_vector, mask);
-				x_rows[i] = row;
-			}
-
+			// NOTE: Each row of the result is a linear combination of the rows of `y`
+			auto y_rows     = slice_make<LLVMValueRef>(permanent_allocator(), inner);
 			auto mask_elems = slice_make<LLVMValueRef>(permanent_allocator(), inner);
-			for (unsigned i = 0; i < outer_columns; i++) {
-				for (unsigned j = 0; j < inner; j++) {
-					unsigned offset = x_stride*j + i;
-					mask_elems[j] = do_u32(p, offset);
-				}
-
-				// transpose mask
-				LLVMValueRef mask = LLVMConstVector(mask_elems.data, inner);
-				LLVMValueRef column = llvm_basic_shuffle(p, y_vector, mask);
-				y_columns[i] = column;
+			for (unsigned k = 0; k < inner; k++) {
+				LLVMValueRef mask = llvm_mask_iota(p->module, y_stride*k, outer_columns);
+				y_rows[k] = llvm_basic_shuffle(p, y_vector, mask);
 			}
 
 			lbAddr res = lb_add_local_generated(p, type, false);
-			for_array(i, x_rows) {
-				LLVMValueRef x_row = x_rows[i];
-				for_array(j, y_columns) {
-					LLVMValueRef y_column = y_columns[j];
-					LLVMValueRef elem = llvm_vector_dot(p, x_row, y_column);
-					lbValue dst = lb_emit_matrix_epi(p, res.addr, i, j);
-					LLVMBuildStore(p->builder, elem, dst.value);
+			for (unsigned i = 0; i < outer_rows; i++) {
+				for (unsigned k = 0; k < inner; k++) {
+					LLVMValueRef mask = llvm_mask_same(p->module, x_stride*i + k, outer_columns);
+					mask_elems[k] = llvm_basic_shuffle(p, x_vector, mask);
 				}
+				LLVMValueRef z_row = llvm_vector_mul_pairwise_reduce_add(p, mask_elems, y_rows);
+				lb_emit_matrix_store_vector(p, res.addr, z_row, i, 0);
 			}
 			return lb_addr_load(p, res);
 		}
@@ -2073,6 +2054,34 @@ gb_internal lbValue lb_build_binary_in(lbProcedure *p, lbValue left, lbValue rig
 	return {};
 }
 
+// NOTE: Like `binary_expr_chain_left` but the chain also stops at constant and matrix operands, which
+// are handled by `lb_build_expr` as normal
+gb_internal Ast *lb_binary_expr_chain_left(Ast *expr) {
+	Ast *left = binary_expr_chain_left(expr);
+	if (left == nullptr || left->tav.value.kind != ExactValue_Invalid ||
+	    is_type_matrix(left->BinaryExpr.left->tav.type) || is_type_matrix(left->BinaryExpr.right->tav.type)) {
+		return nullptr;
+	}
+	return left;
+}
+
+gb_internal lbValue lb_build_binary_expr_chain(lbProcedure *p, Ast *expr) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto spine = array_make<Ast *>(temporary_allocator(), 0, 16);
+	for (Ast *e = expr; e != nullptr; e = lb_binary_expr_chain_left(e)) {
+		array_add(&spine, e);
+	}
+
+	lbValue left = lb_build_expr(p, spine[spine.count-1]->BinaryExpr.left);
+	for (isize i = spine.count-1; i >= 0; i--) {
+		ast_node(be, BinaryExpr, spine[i]);
+		Type *type = default_type(type_of_expr(spine[i]));
+		lbValue right = lb_build_expr(p, be->right);
+		left = lb_emit_arith(p, be->op.kind, left, right, type);
+	}
+	return left;
+}
+
 gb_internal lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 	ast_node(be, BinaryExpr, expr);
 
@@ -2096,6 +2105,9 @@ gb_internal lbValue lb_build_binary_expr(lbProcedure *p, Ast *expr) {
 	case Token_Or:
 	case Token_Xor:
 	case Token_AndNot: {
+		if (lb_binary_expr_chain_left(expr) != nullptr) {
+			return lb_build_binary_expr_chain(p, expr);
+		}
 		Type *type = default_type(tv.type);
 		lbValue left = lb_build_expr(p, be->left);
 		lbValue right = lb_build_expr(p, be->right);
@@ -3330,12 +3342,16 @@ gb_internal lbValue lb_compare_records(lbProcedure *p, TokenKind op_kind, lbValu
 		// 	return res;
 		// }
 
-		// TODO(bill): Test to see if this is actually faster!!!!
-		auto args = array_make<lbValue>(temporary_allocator(), 3);
-		args[0] = lb_emit_conv(p, left_ptr, t_rawptr);
-		args[1] = lb_emit_conv(p, right_ptr, t_rawptr);
-		args[2] = lb_const_int(p->module, t_int, type_size_of(type));
-		res = lb_emit_runtime_call(p, "memory_equal", args);
+		if (lb_simple_compare_can_use_wide_ops(type)) {
+			res = lb_emit_conv(p, lb_simple_compare_wide_equal(p, type, left_ptr, right_ptr), t_bool);
+		} else {
+			// TODO(bill): Test to see if this is actually faster!!!!
+			auto args = array_make<lbValue>(temporary_allocator(), 3);
+			args[0] = lb_emit_conv(p, left_ptr, t_rawptr);
+			args[1] = lb_emit_conv(p, right_ptr, t_rawptr);
+			args[2] = lb_const_int(p->module, t_int, type_size_of(type));
+			res = lb_emit_runtime_call(p, "memory_equal", args);
+		}
 	} else {
 		lbValue value = lb_equal_proc_for_type(p->module, type);
 		auto args = array_make<lbValue>(temporary_allocator(), 2);
@@ -3436,7 +3452,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 
 
 		// TODO(bill): Test to see if this is actually faster!!!!
-		auto args = array_make<lbValue>(permanent_allocator(), 3);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 3);
 		args[0] = lb_emit_conv(p, lhs, t_rawptr);
 		args[1] = lb_emit_conv(p, rhs, t_rawptr);
 		args[2] = lb_const_int(p->module, t_int, type_size_of(tl));
@@ -3487,7 +3503,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 		} else {
 			if (is_type_simple_compare(tl) && (op_kind == Token_CmpEq || op_kind == Token_NotEq)) {
 				// TODO(bill): Test to see if this is actually faster!!!!
-				auto args = array_make<lbValue>(permanent_allocator(), 3);
+				auto args = array_make<lbValue>(lb_scratch_allocator(p), 3);
 				args[0] = lb_emit_conv(p, lhs, t_rawptr);
 				args[1] = lb_emit_conv(p, rhs, t_rawptr);
 				args[2] = lb_const_int(p->module, t_int, type_size_of(tl));
@@ -3538,7 +3554,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 			}
 			GB_ASSERT(runtime_procedure != nullptr);
 
-			auto args = array_make<lbValue>(permanent_allocator(), 2);
+			auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 			args[0] = left;
 			args[1] = right;
 			return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3561,7 +3577,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 		}
 		GB_ASSERT(runtime_procedure != nullptr);
 
-		auto args = array_make<lbValue>(permanent_allocator(), 2);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 		args[0] = left;
 		args[1] = right;
 		return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3583,7 +3599,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 			}
 			GB_ASSERT(runtime_procedure != nullptr);
 
-			auto args = array_make<lbValue>(permanent_allocator(), 2);
+			auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 			args[0] = left;
 			args[1] = right;
 			return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3606,7 +3622,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 		}
 		GB_ASSERT(runtime_procedure != nullptr);
 
-		auto args = array_make<lbValue>(permanent_allocator(), 2);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 		args[0] = left;
 		args[1] = right;
 		return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3637,7 +3653,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 		}
 		GB_ASSERT(runtime_procedure != nullptr);
 
-		auto args = array_make<lbValue>(permanent_allocator(), 2);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 		args[0] = left;
 		args[1] = right;
 		return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3668,7 +3684,7 @@ gb_internal lbValue lb_emit_comp(lbProcedure *p, TokenKind op_kind, lbValue left
 		}
 		GB_ASSERT(runtime_procedure != nullptr);
 
-		auto args = array_make<lbValue>(permanent_allocator(), 2);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 		args[0] = left;
 		args[1] = right;
 		return lb_emit_runtime_call(p, runtime_procedure, args);
@@ -3960,7 +3976,7 @@ gb_internal lbValue lb_emit_comp_against_nil(lbProcedure *p, TokenKind op_kind,
 		{
 			Type *u = bit_set_to_int(bt);
 			if (is_type_array(u)) {
-				auto args = array_make<lbValue>(permanent_allocator(), 2);
+				auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 				lbValue lhs = lb_address_from_load_or_generate_local(p, x);
 				args[0] = lb_emit_conv(p, lhs, t_rawptr);
 				args[1] = lb_const_int(p->module, t_int, type_size_of(t));
@@ -4082,7 +4098,7 @@ gb_internal lbValue lb_emit_comp_against_nil(lbProcedure *p, TokenKind op_kind,
 				}
 			}
 		} else if (is_type_struct(t)) {
-			auto args = array_make<lbValue>(permanent_allocator(), 2);
+			auto args = array_make<lbValue>(lb_scratch_allocator(p), 2);
 			lbValue lhs = lb_address_from_load_or_generate_local(p, x);
 			args[0] = lb_emit_conv(p, lhs, t_rawptr);
 			args[1] = lb_const_int(p->module, t_int, type_size_of(t));
@@ -4272,7 +4288,7 @@ gb_internal lbValue lb_build_unary_and(lbProcedure *p, Ast *expr) {
 					}
 
 					lbValue ok = lb_emit_comp(p, Token_CmpEq, src_tag, dst_tag);
-					auto args = array_make<lbValue>(permanent_allocator(), arg_count);
+					auto args = array_make<lbValue>(lb_scratch_allocator(p), arg_count);
 					args[0] = ok;
 
 					lb_set_file_line_col(p, array_slice(args, 1, args.count), pos);
@@ -4309,7 +4325,7 @@ gb_internal lbValue lb_build_unary_and(lbProcedure *p, Ast *expr) {
 
 					lbValue id = lb_typeid(p->module, type);
 					lbValue ok = lb_emit_comp(p, Token_CmpEq, any_id, id);
-					auto args = array_make<lbValue>(permanent_allocator(), arg_count);
+					auto args = array_make<lbValue>(lb_scratch_allocator(p), arg_count);
 					args[0] = ok;
 
 					lb_set_file_line_col(p, array_slice(args, 1, args.count), pos);
@@ -4412,10 +4428,9 @@ gb_internal lbValue lb_build_expr_internal(lbProcedure *p, Ast *expr) {
 
 	expr = unparen_expr(expr);
 
-	TokenPos expr_pos = ast_token(expr).pos;
 	TypeAndValue tv = type_and_value_of_expr(expr);
 	Type *type = type_of_expr(expr);
-	GB_ASSERT_MSG(tv.mode != Addressing_Invalid, "invalid expression '%s' (tv.mode = %d, tv.type = %s) @ %s\n Current Proc: %.*s : %s", expr_to_string(expr), tv.mode, type_to_string(tv.type), token_pos_to_string(expr_pos), LIT(p->name), type_to_string(p->type));
+	GB_ASSERT_MSG(tv.mode != Addressing_Invalid, "invalid expression '%s' (tv.mode = %d, tv.type = %s) @ %s\n Current Proc: %.*s : %s", expr_to_string(expr), tv.mode, type_to_string(tv.type), token_pos_to_string(ast_token(expr).pos), LIT(p->name), type_to_string(p->type));
 
 
 	if (tv.value.kind != ExactValue_Invalid) {
@@ -4775,7 +4790,8 @@ gb_internal lbAddr lb_get_soa_variable_addr(lbProcedure *p, Entity *e) {
 gb_internal lbValue lb_get_using_variable(lbProcedure *p, Entity *e) {
 	GB_ASSERT(e->kind == Entity_Variable && e->flags & EntityFlag_Using);
 	InternedString interned = entity_interned_name(e);
-	Entity *parent = e->using_parent;
+	EntityCold const *cold = entity_cold_get(e);
+	Entity *parent = cold->using_parent;
 	Selection sel = lookup_field(parent->type, interned, false);
 	GB_ASSERT(sel.entity != nullptr);
 	lbValue *pv = map_get(&p->module->values, parent);
@@ -4791,8 +4807,8 @@ gb_internal lbValue lb_get_using_variable(lbProcedure *p, Entity *e) {
 	} else if (pv != nullptr) {
 		v = *pv;
 	} else {
-		GB_ASSERT_MSG(e->using_expr != nullptr, "%.*s", LIT(e->token.string));
-		v = lb_build_addr_ptr(p, e->using_expr);
+		GB_ASSERT_MSG(cold->using_expr != nullptr, "%.*s", LIT(e->token.string));
+		v = lb_build_addr_ptr(p, cold->using_expr);
 	}
 	GB_ASSERT(v.value != nullptr);
 	GB_ASSERT_MSG(is_soa || parent->type == type_deref(v.type), "%s %s", type_to_string(parent->type), type_to_string(v.type));
@@ -5141,7 +5157,7 @@ gb_internal lbAddr lb_build_addr_index_expr(lbProcedure *p, Ast *expr) {
 		lbValue elem = lb_emit_array_ep(p, array, index);
 
 		auto index_tv = type_and_value_of_expr(ie->index);
-		if (index_tv.mode != Addressing_Constant) {
+		if (index_tv.mode != Addressing_Constant && !lb_range_fact_proves_in_bounds(p, ie->expr, ie->index)) {
 			lbValue len = lb_const_int(p->module, t_int, t->Array.count);
 			lb_emit_bounds_check(p, ast_token(ie->index), index, len);
 		}
@@ -5211,8 +5227,10 @@ gb_internal lbAddr lb_build_addr_index_expr(lbProcedure *p, Ast *expr) {
 		}
 		lbValue elem = lb_slice_elem(p, slice);
 		lbValue index = lb_emit_conv(p, lb_build_expr(p, ie->index), t_int);
-		lbValue len = lb_slice_len(p, slice);
-		lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		if (!lb_range_fact_proves_in_bounds(p, ie->expr, ie->index)) {
+			lbValue len = lb_slice_len(p, slice);
+			lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		}
 		lbValue v = lb_emit_ptr_offset(p, elem, index);
 		return lb_addr(v);
 	}
@@ -5240,9 +5258,11 @@ gb_internal lbAddr lb_build_addr_index_expr(lbProcedure *p, Ast *expr) {
 			dynamic_array = lb_emit_load(p, dynamic_array);
 		}
 		lbValue elem = lb_dynamic_array_elem(p, dynamic_array);
-		lbValue len = lb_dynamic_array_len(p, dynamic_array);
 		lbValue index = lb_emit_conv(p, lb_build_expr(p, ie->index), t_int);
-		lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		if (!lb_range_fact_proves_in_bounds(p, ie->expr, ie->index)) {
+			lbValue len = lb_dynamic_array_len(p, dynamic_array);
+			lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		}
 		lbValue v = lb_emit_ptr_offset(p, elem, index);
 		return lb_addr(v);
 	}
@@ -5291,7 +5311,9 @@ gb_internal lbAddr lb_build_addr_index_expr(lbProcedure *p, Ast *expr) {
 		len = lb_string_len(p, str);
 
 		index = lb_emit_conv(p, lb_build_expr(p, ie->index), t_int);
-		lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		if (!lb_range_fact_proves_in_bounds(p, ie->expr, ie->index)) {
+			lb_emit_bounds_check(p, ast_token(ie->index), index, len);
+		}
 
 		return lb_addr(lb_emit_ptr_offset(p, elem, index));
 	}
@@ -5899,6 +5921,76 @@ gb_internal void lb_build_addr_struct_compound_lit_populate(lbProcedure *p, Ast
 	}
 }
 
+enum {LB_MAP_CONST_TABLE_MIN_COUNT = 4};
+
+// NOTE: The hash of a key depends on the seed which is derived from the address of the map's
+// allocation, so the hash table itself cannot be laid out at compile time. Instead, when every key
+// and value is constant, they are stored as two read-only arrays and inserted by a single loop,
+// rather than emitting a hash and an insertion call for every entry.
+gb_internal bool lb_build_map_compound_lit_from_table(lbProcedure *p, lbAddr v, Type *type, Ast *expr) {
+	ast_node(cl, CompoundLit, expr);
+	Type *bt = base_type(type);
+	GB_ASSERT(bt->kind == Type_Map);
+
+	isize count = cl->elems.count;
+	if (count < LB_MAP_CONST_TABLE_MIN_COUNT) {
+		return false;
+	}
+	Type *key_type   = bt->Map.key;
+	Type *value_type = bt->Map.value;
+	for (Ast *elem : cl->elems) {
+		ast_node(fv, FieldValue, elem);
+		if (!lb_is_elem_const(fv->field, key_type) || !lb_is_elem_const(fv->value, value_type)) {
+			return false;
+		}
+	}
+
+	lbModule *m = p->module;
+	Type *keys_type   = alloc_type_array(key_type,   count);
+	Type *values_type = alloc_type_array(value_type, count);
+
+	LLVMValueRef *keys   = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+	LLVMValueRef *values = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+	for_array(i, cl->elems) {
+		ast_node(fv, FieldValue, cl->elems[i]);
+		keys[i]   = lb_const_value(m, key_type,   fv->field->tav.value).value;
+		values[i] = lb_const_value(m, value_type, fv->value->tav.value).value;
+	}
+
+	auto const add_table = [m](Type *t, LLVMValueRef *elems, isize count, char const *prefix) -> lbValue {
+		LLVMValueRef init = llvm_const_array(m, lb_type(m, base_array_type(t)), elems, count);
+
+		u32 id = m->global_array_index.fetch_add(1);
+		gbString str = gb_string_make(temporary_allocator(), prefix);
+		str = gb_string_appendc(str, m->module_name);
+		str = gb_string_append_fmt(str, "$%x", id);
+
+		LLVMValueRef g = LLVMAddGlobal(m->mod, LLVMTypeOf(init), str);
+		LLVMSetInitializer(g, init);
+		LLVMSetLinkage(g, LLVMPrivateLinkage);
+		LLVMSetUnnamedAddress(g, LLVMGlobalUnnamedAddr);
+		LLVMSetGlobalConstant(g, true);
+		LLVMSetAlignment(g, cast(unsigned)type_align_of(t));
+
+		lbValue res = {};
+		res.value = LLVMConstPointerCast(g, lb_type(m, alloc_type_pointer(t)));
+		res.type = alloc_type_pointer(t);
+		return res;
+	};
+	lbValue keys_ptr   = add_table(keys_type,   keys,   count, "cmk$");
+	lbValue values_ptr = add_table(values_type, values, count, "cmv$");
+
+	lbValue err = lb_dynamic_map_reserve(p, v.addr, 2*count, ast_token(expr).pos);
+	gb_unused(err);
+
+	auto loop_data = lb_loop_start(p, count, t_int);
+	lbValue key   = lb_emit_load(p, lb_emit_array_ep(p, keys_ptr,   loop_data.idx));
+	lbValue value = lb_emit_load(p, lb_emit_array_ep(p, values_ptr, loop_data.idx));
+	lb_internal_dynamic_map_set(p, v.addr, type, key, value, expr);
+	lb_loop_end(p, loop_data);
+	return true;
+}
+
 gb_internal lbAddr lb_build_addr_compound_lit(lbProcedure *p, Ast *expr) {
 	ast_node(cl, CompoundLit, expr);
 
@@ -5989,16 +6081,16 @@ gb_internal lbAddr lb_build_addr_compound_lit(lbProcedure *p, Ast *expr) {
 			}
 		}
 
-		if (!any_fields_different_endian &&
-		    fields.count == bt->BitField.fields.count) {
+		if (!any_fields_different_endian) {
 			// SINGLE INTEGER BACKING ONLY
 
 			Type *backing_type = core_type(bt->BitField.backing_type);
 			GB_ASSERT(is_type_integer(backing_type) ||
 			          (is_type_array(backing_type) && is_type_integer(backing_type->Array.elem)));
 
-			// NOTE(bill): all fields are present
-			// this means no masking is necessary since on write, the bits will be overridden
+			// NOTE(bill): no masking is necessary since on write, the bits will be overridden
+			// NOTE: `v` starts zeroed, so the fields which are not given stay zero and a literal with only
+			// some of the fields is still assembled and written in one go
 
 			lbValue dst_byte_ptr = lb_emit_conv(p, v.addr, t_u8_ptr);
 			u64 total_bit_size = cast(u64)(8*type_size_of(bt));
@@ -6044,6 +6136,7 @@ gb_internal lbAddr lb_build_addr_compound_lit(lbProcedure *p, Ast *expr) {
 				u64 curr_bit_offset = 0;
 				for (isize i = 0; i < fields.count; i++) {
 					auto const &f = fields[i];
+					curr_bit_offset = f.bit_offset;
 
 					LLVMValueRef val = values[i].value;
 					LLVMTypeRef vt = lb_type(p->module, values[i].type);
@@ -6129,6 +6222,10 @@ gb_internal lbAddr lb_build_addr_compound_lit(lbProcedure *p, Ast *expr) {
 		}
 		GB_ASSERT(expr->file()->feature_flags & OptInFeatureFlag_DynamicLiterals || build_context.dynamic_literals);
 
+		if (lb_build_map_compound_lit_from_table(p, v, type, expr)) {
+			break;
+		}
+
 		lbValue err = lb_dynamic_map_reserve(p, v.addr, 2*cl->elems.count, pos);
 		gb_unused(err);
 
@@ -16,11 +16,29 @@ gb_global isize lb_global_type_info_member_offsets_index = 0;
 gb_global isize lb_global_type_info_member_usings_index  = 0;
 gb_global isize lb_global_type_info_member_tags_index    = 0;
 
+// NOTE: -opt-remarks needs the debug locations to map the remarks back to the source,
+// but does not emit them unless -debug or -debug:lines is set
+gb_internal bool lb_generate_debug_info(void) {
+	return build_has_debug_info() || build_context.opt_remarks.len != 0;
+}
+
+// NOTE: Only the compile units, procedures and line locations, without any types or variables
+gb_internal bool lb_debug_line_tables_only(void) {
+	return !build_context.ODIN_DEBUG;
+}
+
 gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	lbModule *m = cast(lbModule *)data;
 	Checker *c = m->checker;
 	m->info = &c->info;
 
+	mutex_set_name(&m->types_mutex,                "lbModule.types_mutex");
+	mutex_set_name(&m->func_raw_types_mutex,       "lbModule.func_raw_types_mutex");
+	mutex_set_name(&m->values_mutex,               "lbModule.values_mutex");
+	mutex_set_name(&m->generated_procedures_mutex, "lbModule.generated_procedures_mutex");
+	mutex_set_name(&m->debug_values_mutex,         "lbModule.debug_values_mutex");
+	mutex_set_name(&m->pad_types_mutex,            "lbModule.pad_types_mutex");
+
 
 	String name = build_context.build_paths[BuildPath_Output].name;
 	gbString module_name = gb_string_make(heap_allocator(), "");
@@ -38,6 +56,9 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 		}
 		String filename = filename_from_path(m->file->filename);
 		module_name = gb_string_append_length(module_name, filename.text, filename.len);
+		if (m->partition_index > 0) {
+			module_name = gb_string_append_fmt(module_name, "-%d", m->partition_index);
+		}
 	} else if (m->pkg) {
 		if (gb_string_length(module_name)) {
 			module_name = gb_string_appendc(module_name, "-");
@@ -57,7 +78,12 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	}
 
 	m->module_name = module_name;
-	m->ctx = LLVMContextCreate();
+	if (build_context.jit) {
+		m->jit_context = LLVMOrcCreateNewThreadSafeContext();
+		m->ctx = LLVMOrcThreadSafeContextGetContext(m->jit_context);
+	} else {
+		m->ctx = LLVMContextCreate();
+	}
 	m->mod = LLVMModuleCreateWithNameInContext(m->module_name, m->ctx);
 	// m->debug_builder = nullptr;
 	if (build_context.no_plt) {
@@ -67,12 +93,20 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 			LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), 1, true)));
 	}
 	
+	if (build_context.profile_friendly) {
+		// NOTE: 2 == all, for the functions LLVM creates itself
+		LLVMAddModuleFlag(m->mod,
+			LLVMModuleFlagBehaviorWarning,
+			"frame-pointer", 13,
+			LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), 2, true)));
+	}
+
 	LLVMAddModuleFlag(m->mod,
 		LLVMModuleFlagBehaviorWarning,
 		"PIC Level", 9, 
 		LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), get_reloc_mode(), true)));
 
-	if (build_context.ODIN_DEBUG) {
+	if (lb_generate_debug_info()) {
 		enum {DEBUG_METADATA_VERSION = 3};
 
 		LLVMMetadataRef debug_ref = LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), DEBUG_METADATA_VERSION, true));
@@ -84,6 +118,14 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 				LLVMModuleFlagBehaviorWarning,
 				"CodeView", 8,
 				LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), 1, true)));
+			if (build_context.linker_choice == Linker_lld) {
+				// NOTE: Emit the global type hashes (`.debug$H`) so that lld-link with `/DEBUG:GHASH`
+				// can merge the type records of each object without hashing them itself
+				LLVMAddModuleFlag(m->mod,
+					LLVMModuleFlagBehaviorWarning,
+					"CodeViewGHash", 13,
+					LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), 1, true)));
+			}
 			break;
 
 		case TargetOs_darwin:
@@ -106,6 +148,8 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	string_map_init(&m->members);
 	string_map_init(&m->procedures);
 	string_map_init(&m->const_strings);
+	map_init(&m->incbin_data);
+	map_init(&m->source_code_locations);
 	string16_map_init(&m->const_string16s);
 	map_init(&m->function_type_map);
 	string_map_init(&m->gen_procs);
@@ -132,6 +176,7 @@ gb_internal WORKER_TASK_PROC(lb_init_module_worker_proc) {
 	map_init(&m->map_info_map, 0);
 	map_init(&m->map_cell_info_map, 0);
 	map_init(&m->exact_value_compound_literal_addr_map, 1024);
+	map_init(&m->const_aggregate_cache, 0);
 
 	array_init(&m->pad_types, heap_allocator());
 
@@ -149,6 +194,174 @@ gb_internal void lb_init_module(lbModule *m, bool do_threading) {
 	}
 }
 
+struct lbModuleCostModel {
+	PtrMap<AstFile *, i64>    file_costs;
+	PtrMap<AstPackage *, i64> package_costs;
+	i64 total_cost;
+	i64 budget;
+};
+
+// NOTE: The estimated cost of a file is its token count plus a weight per procedure body,
+// which is a cheap proxy for how much IR the file will produce
+gb_internal void lb_module_cost_model_init(lbModuleCostModel *cm, Checker *c) {
+	i64 const PROCEDURE_COST = 64;
+
+	map_init(&cm->file_costs,    c->info.files.count);
+	map_init(&cm->package_costs, c->info.packages.count);
+
+	for (auto const &entry : c->info.files) {
+		AstFile *f = entry.value;
+		map_set(&cm->file_costs, f, cast(i64)f->token_count);
+	}
+	for (Entity *e : c->info.entities) {
+		if (e->kind != Entity_Procedure || e->file == nullptr) {
+			continue;
+		}
+		if (e->Procedure.is_foreign) {
+			continue;
+		}
+		i64 *found = map_get(&cm->file_costs, e->file);
+		if (found) {
+			*found += PROCEDURE_COST;
+		}
+	}
+
+	cm->total_cost = 0;
+	for (auto const &entry : cm->file_costs) {
+		AstFile *f = entry.key;
+		i64 *pkg_cost = map_get(&cm->package_costs, f->pkg);
+		if (pkg_cost) {
+			*pkg_cost += entry.value;
+		} else {
+			map_set(&cm->package_costs, f->pkg, entry.value);
+		}
+		cm->total_cost += entry.value;
+	}
+
+	// NOTE: A package which costs more than an even share of the work across the threads
+	// would end up as the single straggler in the pass and emit phases
+	isize thread_count = gb_max(build_context.thread_count, 1);
+	cm->budget = gb_max(cm->total_cost / thread_count, 1);
+}
+
+gb_internal void lb_module_cost_model_destroy(lbModuleCostModel *cm) {
+	map_destroy(&cm->file_costs);
+	map_destroy(&cm->package_costs);
+}
+
+gb_internal bool lb_module_cost_model_should_split(lbModuleCostModel *cm, AstPackage *pkg) {
+	// NOTE: even a package of a single file is worth splitting, as its procedures are then partitioned
+	i64 *found = map_get(&cm->package_costs, pkg);
+	return found && *found > cm->budget;
+}
+
+struct lbProcedurePartitionCost {
+	Entity *entity;
+	i64     cost;
+};
+
+gb_internal int lb_procedure_partition_cost_cmp(void const *a, void const *b) {
+	auto x = cast(lbProcedurePartitionCost const *)a;
+	auto y = cast(lbProcedurePartitionCost const *)b;
+	if (x->cost != y->cost) {
+		return x->cost > y->cost ? -1 : +1;
+	}
+	return i32_cmp(x->entity->token.pos.offset, y->entity->token.pos.offset);
+}
+
+// NOTE: A single file can still be too large for one module to keep up with the rest, and as each
+// module has its own LLVMContext, its procedures cannot be passed over by several threads at once.
+// Instead its procedures are spread across extra modules for that file, the largest first into the
+// least loaded one, and every other entity of the file stays in the file's own module.
+gb_internal void lb_partition_file_procedures(lbGenerator *gen, lbModuleCostModel *cm, lbModule *file_module, bool do_threading) {
+	i64 const BYTES_PER_TOKEN = 4;
+
+	AstFile *file = file_module->file;
+	i64 *found = map_get(&cm->file_costs, file);
+	if (found == nullptr || *found <= cm->budget) {
+		return;
+	}
+	i64 file_cost = *found;
+
+	isize thread_count = gb_max(build_context.thread_count, 1);
+	isize partition_count = gb_min(cast(isize)((file_cost + cm->budget - 1) / cm->budget), thread_count);
+	if (partition_count <= 1) {
+		return;
+	}
+
+	auto procs = array_make<lbProcedurePartitionCost>(heap_allocator(), 0, 64);
+	defer (array_free(&procs));
+
+	i64 procs_cost = 0;
+	for (Entity *e : gen->info->entities) {
+		if (e->file != file) {
+			continue;
+		}
+		if (e->flags & EntityFlag_CustomLinkage_Internal) {
+			// NOTE: it could not be referenced from the other modules
+			return;
+		}
+		if (e->kind != Entity_Procedure || e->Procedure.is_foreign || e->decl_info == nullptr) {
+			continue;
+		}
+		if (is_type_polymorphic(e->type)) {
+			continue;
+		}
+		Ast *pl = e->decl_info->proc_lit;
+		if (pl == nullptr || pl->kind != Ast_ProcLit || pl->ProcLit.body == nullptr) {
+			continue;
+		}
+		Ast *body = pl->ProcLit.body;
+		i64 body_bytes = ast_end_token(body).pos.offset - ast_token(body).pos.offset;
+
+		lbProcedurePartitionCost pc = {};
+		pc.entity = e;
+		pc.cost   = 64 + gb_max(body_bytes, 0)/BYTES_PER_TOKEN;
+		array_add(&procs, pc);
+		procs_cost += pc.cost;
+	}
+	if (procs.count < 2) {
+		return;
+	}
+	partition_count = gb_min(partition_count, procs.count);
+
+	auto partitions = slice_make<lbModule *>(heap_allocator(), partition_count);
+	auto loads      = slice_make<i64>(heap_allocator(), partition_count);
+	defer (gb_free(heap_allocator(), partitions.data));
+	defer (gb_free(heap_allocator(), loads.data));
+
+	partitions[0] = file_module;
+	loads[0] = gb_max(file_cost - procs_cost, 0);
+	for (isize i = 1; i < partition_count; i++) {
+		auto m = permanent_alloc_item<lbModule>();
+		m->file = file;
+		m->pkg  = file_module->pkg;
+		m->gen  = gen;
+		m->checker = file_module->checker;
+		m->partition_index = cast(i32)i;
+		m->polymorphic_module = file_module->polymorphic_module;
+		map_set(&gen->modules, cast(void *)m, m); // point to itself just add it to the list
+		lb_init_module(m, do_threading);
+		partitions[i] = m;
+	}
+
+	gb_sort_array(procs.data, procs.count, lb_procedure_partition_cost_cmp);
+	for (lbProcedurePartitionCost const &pc : procs) {
+		isize best = 0;
+		for (isize i = 1; i < partition_count; i++) {
+			if (loads[i] < loads[best]) {
+				best = i;
+			}
+		}
+		loads[best] += pc.cost;
+		if (best != 0) {
+			map_set(&gen->procedure_partitions, pc.entity, partitions[best]);
+		}
+	}
+
+	debugf("Partitioning file '%.*s' into %td modules\n", LIT(file->filename), partition_count);
+}
+
 gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 	if (global_error_collector.count != 0) {
 		return false;
@@ -170,9 +383,32 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 
 	map_init(&gen->modules, gen->info->packages.count*2);
 	map_init(&gen->modules_through_ctx, gen->info->packages.count*2);
+	concurrent_map_init(&gen->struct_layouts);
+	if (USE_SEPARATE_MODULES) {
+		concurrent_map_init(&gen->function_type_memo);
+	}
+
+	if (USE_SEPARATE_MODULES && build_context.ODIN_DEBUG && build_context.optimization_level <= 0 && build_context.lto_kind == LTO_None) {
+		gen->share_debug_types = true;
+		concurrent_map_init(&gen->debug_type_owners);
+	}
+
+	if (USE_SEPARATE_MODULES) {
+		gen->share_generated_helpers = true;
+		concurrent_map_init(&gen->generated_helper_owners);
+	}
 
 	if (USE_SEPARATE_MODULES) {
 		bool module_per_file = build_context.module_per_file && (build_context.optimization_level <= 0 || build_context.lto_kind != LTO_None);
+
+		lbModuleCostModel cost_model = {};
+		if (build_context.partition_modules) {
+			lb_module_cost_model_init(&cost_model, c);
+		}
+		defer (if (build_context.partition_modules) {
+			lb_module_cost_model_destroy(&cost_model);
+		});
+
 		for (auto const &entry : gen->info->packages) {
 			AstPackage *pkg = entry.value;
 			auto m = permanent_alloc_item<lbModule>();
@@ -197,28 +433,12 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 
 			bool allow_for_per_file = pkg->kind == Package_Runtime || module_per_file;
 
-			#if 0
-			if (!allow_for_per_file) {
-				if (pkg->files.count >= 20) {
-					isize proc_count = 0;
-					for (Entity *e : gen->info->entities) {
-						if (e->kind != Entity_Procedure) {
-							continue;
-						}
-						if (e->Procedure.is_foreign) {
-							continue;
-						}
-						if (e->pkg == pkg) {
-							proc_count += 1;
-						}
-					}
-
-					if (proc_count >= 300) {
-						allow_for_per_file = true;
-					}
+			if (!allow_for_per_file && build_context.partition_modules) {
+				allow_for_per_file = lb_module_cost_model_should_split(&cost_model, pkg);
+				if (allow_for_per_file) {
+					debugf("Partitioning package '%.*s' into per file modules\n", LIT(pkg->name));
 				}
 			}
-			#endif
 
 			if (!allow_for_per_file) {
 				continue;
@@ -247,6 +467,10 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 
 					lb_init_module(pm, do_threading);
 				}
+
+				if (build_context.partition_modules) {
+					lb_partition_file_procedures(gen, &cost_model, m, do_threading);
+				}
 			}
 		}
 
@@ -273,7 +497,17 @@ gb_internal bool lb_init_generator(lbGenerator *gen, Checker *c) {
 		map_set(&gen->modules_through_ctx, ctx, m);
 	}
 
+	for (auto const &entry : gen->info->load_file_cache) {
+		LoadFileCache *cache = entry.value;
+		if (cache->data.len >= LOAD_FILE_LARGE_SIZE) {
+			map_set(&gen->incbin_files, cast(void *)cache->data.text, cache);
+		}
+	}
+
 	mpsc_init(&gen->entities_to_correct_linkage, heap_allocator());
+	mpsc_init(&global_isel_fallbacks, heap_allocator());
+	mpsc_init(&global_opt_remarks, heap_allocator());
+	mpsc_init(&global_stack_usages, heap_allocator());
 	mpsc_init(&gen->objc_selectors, heap_allocator());
 	mpsc_init(&gen->objc_classes, heap_allocator());
 	mpsc_init(&gen->objc_ivars, heap_allocator());
@@ -533,6 +767,10 @@ gb_internal lbModule *lb_module_of_entity_internal(lbGenerator *gen, Entity *e,
 		if (mod) {
 			return mod;
 		}
+		found = map_get(&gen->procedure_partitions, e);
+		if (found) {
+			return *found;
+		}
 	}
 	if (e->file) {
 		found = map_get(&gen->modules, cast(void *)e->file);
@@ -704,7 +942,7 @@ gb_internal lbValue lb_build_addr_ptr(lbProcedure *p, Ast *expr) {
 }
 
 gb_internal void lb_set_file_line_col(lbProcedure *p, Array<lbValue> arr, TokenPos pos) {
-	String file = get_file_path_string(pos.file_id);
+	String file = remap_path_prefix(get_file_path_string(pos.file_id));
 	i32 line    = pos.line;
 	i32 col     = pos.column;
 
@@ -775,6 +1013,30 @@ gb_internal bool lb_bounds_check_short_circuit(lbProcedure *p, lbValue index, lb
 	return false;
 }
 
+// NOTE: Whether `array_expr[index_expr]` is known to be within bounds from an enclosing range loop,
+// see lb_push_range_fact
+gb_internal bool lb_range_fact_proves_in_bounds(lbProcedure *p, Ast *array_expr, Ast *index_expr) {
+	if (p->range_facts.count == 0) {
+		return false;
+	}
+	array_expr = unparen_expr(array_expr);
+	index_expr = unparen_expr(index_expr);
+	if (array_expr->kind != Ast_Ident || index_expr->kind != Ast_Ident) {
+		return false;
+	}
+	Entity *array = entity_of_node(array_expr);
+	Entity *index = entity_of_node(index_expr);
+	if (array == nullptr || index == nullptr) {
+		return false;
+	}
+	for (lbRangeFact const &fact : p->range_facts) {
+		if (fact.array == array && fact.index == index) {
+			return true;
+		}
+	}
+	return false;
+}
+
 gb_internal void lb_emit_bounds_check(lbProcedure *p, Token token, lbValue index, lbValue len) {
 	if (lb_bounds_check_short_circuit(p, index, len)) {
 		return;
@@ -1088,6 +1350,34 @@ gb_internal void lb_copy_bits(lbProcedure *p,
 	}
 }
 
+// NOTE: On a little-endian target, bit `i` of a bit_field is bit `i` of its storage read as one integer, so
+// when that storage is a power of two in size a field is read with a single load of that word followed by a
+// shift and mask (and written with a read-modify-write of it), rather than gathering and scattering the bytes
+// it spans one at a time as `lb_copy_bits` does. Returns nullptr when `lb_copy_bits` has to be used.
+gb_internal LLVMTypeRef lb_bit_field_word_type(lbModule *m, lbAddr const &addr) {
+	if (build_context.endian_kind != TargetEndian_Little ||
+	    is_type_different_to_arch_endianness(addr.bitfield.type)) {
+		return nullptr;
+	}
+	if (LLVMGetTypeKind(lb_type(m, addr.bitfield.type)) != LLVMIntegerTypeKind) {
+		return nullptr;
+	}
+	i64 size = type_size_of(type_deref(addr.addr.type));
+	switch (size) {
+	case 1: case 2: case 4: case 8: case 16:
+		return LLVMIntTypeInContext(m->ctx, cast(unsigned)(8*size));
+	}
+	return nullptr;
+}
+
+gb_internal unsigned lb_bit_field_word_alignment(lbProcedure *p, lbAddr const &addr) {
+	LLVMValueRef ptr = addr.addr.value;
+	if (LLVMIsAInstruction(ptr) && lb_get_metadata_custom_u64(p->module, ptr, ODIN_METADATA_IS_PACKED) != 0) {
+		return 1;
+	}
+	return cast(unsigned)type_align_of(type_deref(addr.addr.type));
+}
+
 gb_internal void lb_addr_store(lbProcedure *p, lbAddr addr, lbValue value) {
 	if (addr.addr.value == nullptr) {
 		return;
@@ -1104,6 +1394,34 @@ gb_internal void lb_addr_store(lbProcedure *p, lbAddr addr, lbValue value) {
 	}
 
 	if (addr.kind == lbAddr_BitField) {
+		LLVMTypeRef word_type = lb_bit_field_word_type(p->module, addr);
+		if (word_type != nullptr && LLVMGetTypeKind(LLVMTypeOf(value.value)) == LLVMIntegerTypeKind) {
+			unsigned align = lb_bit_field_word_alignment(p, addr);
+			unsigned word_bits = LLVMGetIntTypeWidth(word_type);
+			u64 bit_offset = cast(u64)addr.bitfield.bit_offset;
+			u64 bit_size   = cast(u64)addr.bitfield.bit_size;
+
+			LLVMValueRef v = value.value;
+			if (LLVMGetIntTypeWidth(LLVMTypeOf(v)) > word_bits) {
+				v = LLVMBuildTrunc(p->builder, v, word_type, "");
+			} else {
+				v = LLVMBuildZExt(p->builder, v, word_type, "");
+			}
+			v = LLVMBuildAnd(p->builder, v, lb_const_low_bits_mask(word_type, bit_size), "");
+			if (bit_offset != 0) {
+				v = LLVMBuildShl(p->builder, v, LLVMConstInt(word_type, bit_offset, false), "");
+			}
+
+			LLVMValueRef field_mask = LLVMBuildShl(p->builder, lb_const_low_bits_mask(word_type, bit_size), LLVMConstInt(word_type, bit_offset, false), "");
+			LLVMValueRef word = OdinLLVMBuildLoadAligned(p, word_type, addr.addr.value, align);
+			word = LLVMBuildAnd(p->builder, word, LLVMBuildNot(p->builder, field_mask, ""), "");
+			word = LLVMBuildOr(p->builder, word, v, "");
+
+			LLVMValueRef store = LLVMBuildStore(p->builder, word, addr.addr.value);
+			LLVMSetAlignment(store, align);
+			return;
+		}
+
 		lbValue dst = addr.addr;
 		lbValue src = {};
 		if (is_type_endian_big(addr.bitfield.type)) {
@@ -1396,6 +1714,41 @@ gb_internal lbValue lb_addr_load(lbProcedure *p, lbAddr const &addr) {
 	GB_ASSERT(addr.addr.value != nullptr);
 
 	if (addr.kind == lbAddr_BitField) {
+		LLVMTypeRef word_type = lb_bit_field_word_type(p->module, addr);
+		if (word_type != nullptr) {
+			Type *t = addr.bitfield.type;
+			Type *ct = core_type(t);
+			LLVMTypeRef field_type = lb_type(p->module, t);
+			unsigned word_bits = LLVMGetIntTypeWidth(word_type);
+			u64 bit_offset = cast(u64)addr.bitfield.bit_offset;
+			u64 bit_size   = cast(u64)addr.bitfield.bit_size;
+
+			LLVMValueRef word = OdinLLVMBuildLoadAligned(p, word_type, addr.addr.value, lb_bit_field_word_alignment(p, addr));
+			if (!is_type_unsigned(ct) && !is_type_boolean(ct)) {
+				// NOTE: Move the field to the top of the word so the arithmetic shift sign extends it
+				u64 top_shift = word_bits - bit_offset - bit_size;
+				if (top_shift != 0) {
+					word = LLVMBuildShl(p->builder, word, LLVMConstInt(word_type, top_shift, false), "");
+				}
+				word = LLVMBuildAShr(p->builder, word, LLVMConstInt(word_type, word_bits - bit_size, false), "");
+				if (LLVMGetIntTypeWidth(field_type) > word_bits) {
+					word = LLVMBuildSExt(p->builder, word, field_type, "");
+				}
+			} else {
+				if (bit_offset != 0) {
+					word = LLVMBuildLShr(p->builder, word, LLVMConstInt(word_type, bit_offset, false), "");
+				}
+				word = LLVMBuildAnd(p->builder, word, lb_const_low_bits_mask(word_type, bit_size), "");
+				if (LLVMGetIntTypeWidth(field_type) > word_bits) {
+					word = LLVMBuildZExt(p->builder, word, field_type, "");
+				}
+			}
+			if (LLVMGetIntTypeWidth(field_type) < word_bits) {
+				word = LLVMBuildTrunc(p->builder, word, field_type, "");
+			}
+			return lbValue{word, t};
+		}
+
 		Type *ct = core_type(addr.bitfield.type);
 		bool do_mask = false;
 		if (is_type_unsigned(ct) || is_type_boolean(ct)) {
@@ -1775,6 +2128,157 @@ gb_internal String lb_get_entity_name(lbModule *m, Entity *e) {
 }
 
 
+// NOTE: The ABI classification of a procedure signature, as computed by the first module which needed it.
+// The classifiers only depend on the Odin signature, so every other module (each with its own LLVM context)
+// copies the result over to its own context instead of classifying the signature again.
+struct lbFunctionTypeMemo {
+	lbModule *      module;
+	lbFunctionType *ft;
+	LLVMTypeRef *   arg_types; // the classifier's inputs within `module`
+	unsigned        arg_count;
+	LLVMTypeRef     return_type;
+};
+
+gb_internal LLVMTypeRef lb_function_type_memo_copy_type(lbModule *m, lbFunctionTypeMemo *memo, LLVMTypeRef *arg_types, LLVMTypeRef return_type, LLVMTypeRef src, bool *ok) {
+	if (src == nullptr || !*ok) {
+		return nullptr;
+	}
+	for (unsigned i = 0; i < memo->arg_count; i++) {
+		if (memo->arg_types[i] == src) {
+			return arg_types[i];
+		}
+	}
+	if (memo->return_type == src) {
+		return return_type;
+	}
+
+	LLVMContextRef ctx = m->ctx;
+	switch (LLVMGetTypeKind(src)) {
+	case LLVMVoidTypeKind:     return LLVMVoidTypeInContext(ctx);
+	case LLVMIntegerTypeKind:  return LLVMIntTypeInContext(ctx, LLVMGetIntTypeWidth(src));
+	case LLVMHalfTypeKind:     return LLVMHalfTypeInContext(ctx);
+	case LLVMBFloatTypeKind:   return LLVMBFloatTypeInContext(ctx);
+	case LLVMFloatTypeKind:    return LLVMFloatTypeInContext(ctx);
+	case LLVMDoubleTypeKind:   return LLVMDoubleTypeInContext(ctx);
+	case LLVMX86_FP80TypeKind: return LLVMX86FP80TypeInContext(ctx);
+	case LLVMFP128TypeKind:    return LLVMFP128TypeInContext(ctx);
+	case LLVMPointerTypeKind:  return LLVMPointerTypeInContext(ctx, LLVMGetPointerAddressSpace(src));
+	case LLVMArrayTypeKind:
+		return llvm_array_type(lb_function_type_memo_copy_type(m, memo, arg_types, return_type, LLVMGetElementType(src), ok), LLVMGetArrayLength2(src));
+	case LLVMVectorTypeKind:
+		return LLVMVectorType(lb_function_type_memo_copy_type(m, memo, arg_types, return_type, LLVMGetElementType(src), ok), LLVMGetVectorSize(src));
+	case LLVMStructTypeKind:
+		if (LLVMIsLiteralStruct(src)) {
+			unsigned count = LLVMCountStructElementTypes(src);
+			LLVMTypeRef *elems = gb_alloc_array(temporary_allocator(), LLVMTypeRef, count);
+			for (unsigned i = 0; i < count; i++) {
+				elems[i] = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, LLVMStructGetTypeAtIndex(src, i), ok);
+			}
+			return LLVMStructTypeInContext(ctx, elems, count, LLVMIsPackedStruct(src));
+		}
+		break;
+	}
+	// NOTE: e.g. a named struct which is not one of the inputs, the caller classifies the signature itself
+	*ok = false;
+	return nullptr;
+}
+
+gb_internal LLVMAttributeRef lb_function_type_memo_copy_attribute(lbModule *m, lbFunctionTypeMemo *memo, LLVMTypeRef *arg_types, LLVMTypeRef return_type, LLVMAttributeRef src, bool *ok) {
+	if (src == nullptr || !*ok) {
+		return nullptr;
+	}
+	if (LLVMIsTypeAttribute(src)) {
+		LLVMTypeRef type = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, LLVMGetTypeAttributeValue(src), ok);
+		return LLVMCreateTypeAttribute(m->ctx, LLVMGetEnumAttributeKind(src), type);
+	}
+	if (LLVMIsEnumAttribute(src)) {
+		return LLVMCreateEnumAttribute(m->ctx, LLVMGetEnumAttributeKind(src), LLVMGetEnumAttributeValue(src));
+	}
+	unsigned key_len = 0, value_len = 0;
+	char const *key   = LLVMGetStringAttributeKind(src, &key_len);
+	char const *value = LLVMGetStringAttributeValue(src, &value_len);
+	return LLVMCreateStringAttribute(m->ctx, key, key_len, value, value_len);
+}
+
+gb_internal bool lb_function_type_memo_copy_arg(lbModule *m, lbFunctionTypeMemo *memo, LLVMTypeRef *arg_types, LLVMTypeRef return_type, lbArgType const &src, lbArgType *dst) {
+	bool ok = true;
+	*dst = src;
+	dst->type            = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, src.type,      &ok);
+	dst->cast_type       = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, src.cast_type, &ok);
+	dst->pad_type        = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, src.pad_type,  &ok);
+	dst->attribute       = lb_function_type_memo_copy_attribute(m, memo, arg_types, return_type, src.attribute,       &ok);
+	dst->align_attribute = lb_function_type_memo_copy_attribute(m, memo, arg_types, return_type, src.align_attribute, &ok);
+	return ok;
+}
+
+gb_internal lbFunctionType *lb_function_type_memo_copy(lbModule *m, lbFunctionTypeMemo *memo, LLVMTypeRef *arg_types, unsigned arg_count, LLVMTypeRef return_type) {
+	if (memo->arg_count != arg_count || (memo->return_type == nullptr) != (return_type == nullptr)) {
+		return nullptr;
+	}
+	lbFunctionType const *src = memo->ft;
+
+	lbFunctionType *ft = permanent_alloc_item<lbFunctionType>();
+	ft->ctx = m->ctx;
+	ft->calling_convention = src->calling_convention;
+	ft->original_arg_count = src->original_arg_count;
+	array_init(&ft->args, lb_function_type_args_allocator(), src->args.count);
+	for_array(i, src->args) {
+		if (!lb_function_type_memo_copy_arg(m, memo, arg_types, return_type, src->args[i], &ft->args[i])) {
+			return nullptr;
+		}
+	}
+	if (!lb_function_type_memo_copy_arg(m, memo, arg_types, return_type, src->ret, &ft->ret)) {
+		return nullptr;
+	}
+	if (src->multiple_return_original_type != nullptr) {
+		bool ok = true;
+		ft->multiple_return_original_type = lb_function_type_memo_copy_type(m, memo, arg_types, return_type, src->multiple_return_original_type, &ok);
+		if (!ok) {
+			return nullptr;
+		}
+	}
+	return ft;
+}
+
+// NOTE: Bindings with thousands of foreign procedures only use a handful of different signatures, and with
+// separate modules each one used to be classified again by every module which used it
+gb_internal lbFunctionType *lb_get_abi_info_memoized(lbModule *m, LLVMTypeRef *arg_types, unsigned arg_count, LLVMTypeRef return_type, bool return_is_defined, bool return_is_tuple, ProcCallingConvention calling_convention, Type *original_type) {
+	lbGenerator *gen = m->gen;
+	if (!USE_SEPARATE_MODULES || gen == nullptr) {
+		return lb_get_abi_info(m, arg_types, arg_count, return_type, return_is_defined, return_is_tuple, calling_convention, original_type);
+	}
+
+	u64 key = type_hash_canonical_type(original_type) ^ (cast(u64)calling_convention * 0x9e3779b97f4a7c15ull);
+	if (key == 0) {
+		key = 1;
+	}
+
+	lbFunctionTypeMemo *memo = nullptr;
+	if (concurrent_map_get(&gen->function_type_memo, key, &memo) && memo->module != m) {
+		TEMPORARY_ALLOCATOR_GUARD();
+		lbFunctionType *ft = lb_function_type_memo_copy(m, memo, arg_types, arg_count, return_type);
+		if (ft != nullptr) {
+			return ft;
+		}
+	}
+
+	lbFunctionType *ft = lb_get_abi_info(m, arg_types, arg_count, return_type, return_is_defined, return_is_tuple, calling_convention, original_type);
+	if (memo == nullptr) {
+		memo = permanent_alloc_item<lbFunctionTypeMemo>();
+		memo->module      = m;
+		// NOTE: A snapshot, the caller still adjusts `ft` afterwards (e.g. for `#by_ptr` parameters)
+		memo->ft          = permanent_alloc_item<lbFunctionType>();
+		*memo->ft         = *ft;
+		memo->ft->args    = array_clone(permanent_allocator(), ft->args);
+		memo->arg_types   = gb_alloc_array(permanent_allocator(), LLVMTypeRef, arg_count);
+		memo->arg_count   = arg_count;
+		memo->return_type = return_type;
+		gb_memmove_array(memo->arg_types, arg_types, arg_count);
+		concurrent_map_set_if_not_previously_exists(&gen->function_type_memo, key, memo);
+	}
+	return ft;
+}
+
 gb_internal LLVMTypeRef lb_type_internal_for_procedures_raw(lbModule *m, Type *type) {
 	Type *original_type = type;
 	type = base_type(original_type);
@@ -1863,7 +2367,7 @@ gb_internal LLVMTypeRef lb_type_internal_for_procedures_raw(lbModule *m, Type *t
 		}
 	}
 	GB_ASSERT(param_index == param_count);
-	lbFunctionType *ft = lb_get_abi_info(m, params, param_count, ret, ret != nullptr, return_is_tuple, type->Proc.calling_convention, type);
+	lbFunctionType *ft = lb_get_abi_info_memoized(m, params, param_count, ret, ret != nullptr, return_is_tuple, type->Proc.calling_convention, type);
 	{
 		for_array(j, ft->args) {
 			auto arg = ft->args[j];
@@ -1989,6 +2493,68 @@ gb_internal LLVMTypeRef lb_type_internal_union_block_type(lbModule *m, Type *typ
 }
 
 
+gb_internal lbStructLayout *lb_get_struct_layout(lbModule *m, Type *type) {
+	GB_ASSERT(type->kind == Type_Struct && !type->Struct.is_raw_union);
+	lbGenerator *gen = m->gen;
+
+	lbStructLayout *layout = nullptr;
+	if (concurrent_map_get(&gen->struct_layouts, type, &layout)) {
+		return layout;
+	}
+
+	type_set_offsets(type);
+
+	layout = permanent_alloc_item<lbStructLayout>();
+	layout->requires_packing = type->Struct.is_packed;
+	slice_init(&layout->field_remapping, permanent_allocator(), type->Struct.fields.count);
+
+	auto slots = array_make<lbStructLayoutSlot>(temporary_allocator(), 0, type->Struct.fields.count*2 + 2);
+	if (are_struct_fields_reordered(type)) {
+		// NOTE(bill, 2021-10-02): Minor hack to enforce `llvm_const_named_struct` usage correctly
+		array_add(&slots, lbStructLayoutSlot{-1, 0, type_align_of(type)});
+	}
+
+	i64 prev_offset = 0;
+	for (i32 field_index : struct_fields_index_by_increasing_offset(temporary_allocator(), type)) {
+		Entity *field = type->Struct.fields[field_index];
+		i64 offset = type->Struct.offsets[field_index];
+		GB_ASSERT(offset >= prev_offset);
+
+		i64 padding = offset - prev_offset;
+		if (padding != 0) {
+			array_add(&slots, lbStructLayoutSlot{-1, padding, type_align_of(field->type)});
+		}
+
+		layout->field_remapping[field_index] = cast(i32)slots.count;
+
+		Type *field_type = field->type;
+		if (is_type_proc(field_type)) {
+			field_type = t_rawptr; // see `lb_type_internal`
+		}
+
+		// max_field_align might misalign items in a way that requires packing
+		// so check the alignment of all fields to see if packing is required.
+		layout->requires_packing = layout->requires_packing || ((offset % type_align_of(field_type)) != 0);
+
+		array_add(&slots, lbStructLayoutSlot{field_index, 0, 0});
+
+		prev_offset = offset + type_size_of(field->type);
+	}
+
+	i64 end_padding = type_size_of(type)-prev_offset;
+	if (end_padding > 0) {
+		array_add(&slots, lbStructLayoutSlot{-1, end_padding, 1});
+	}
+
+	layout->slots = slice_clone_from_array(permanent_allocator(), slots);
+
+	if (!concurrent_map_set_if_not_previously_exists(&gen->struct_layouts, type, layout)) {
+		// NOTE: Another module computed it at the same time, use theirs so every module agrees
+		concurrent_map_get(&gen->struct_layouts, type, &layout);
+	}
+	return layout;
+}
+
 gb_internal LLVMTypeRef lb_type_internal(lbModule *m, Type *type) {
 	LLVMContextRef ctx = m->ctx;
 	i64 size = type_size_of(type); // Check size
@@ -2441,52 +3007,26 @@ gb_internal LLVMTypeRef lb_type_internal(lbModule *m, Type *type) {
 				return struct_type;
 			}
 
-			lbStructFieldRemapping field_remapping = {};
-			slice_init(&field_remapping, permanent_allocator(), type->Struct.fields.count);
+			lbStructLayout *layout = lb_get_struct_layout(m, type);
+			requires_packing = layout->requires_packing;
 
 			m->internal_type_level += 1;
 			defer (m->internal_type_level -= 1);
 
-			auto fields = array_make<LLVMTypeRef>(temporary_allocator(), 0, type->Struct.fields.count*2 + 2);
-			if (are_struct_fields_reordered(type)) {
-				// NOTE(bill, 2021-10-02): Minor hack to enforce `llvm_const_named_struct` usage correctly
-				LLVMTypeRef padding_type = lb_type_padding_filler(m, 0, type_align_of(type));
-				array_add(&fields, padding_type);
-			}
-
-			i64 prev_offset = 0;
-			for (i32 field_index : struct_fields_index_by_increasing_offset(temporary_allocator(), type)) {
-				Entity *field = type->Struct.fields[field_index];
-				i64 offset = type->Struct.offsets[field_index];
-				GB_ASSERT(offset >= prev_offset);
-
-				i64 padding = offset - prev_offset;
-				if (padding != 0) {
-					LLVMTypeRef padding_type = lb_type_padding_filler(m, padding, type_align_of(field->type));
-					array_add(&fields, padding_type);
+			auto fields = array_make<LLVMTypeRef>(temporary_allocator(), layout->slots.count);
+			for_array(i, layout->slots) {
+				lbStructLayoutSlot const &slot = layout->slots[i];
+				if (slot.field_index < 0) {
+					fields[i] = lb_type_padding_filler(m, slot.padding_size, slot.padding_align);
+					continue;
 				}
-
-				field_remapping[field_index] = cast(i32)fields.count;
-
-				Type *field_type = field->type;
+				Type *field_type = type->Struct.fields[slot.field_index]->type;
 				if (is_type_proc(field_type)) {
 					// NOTE(bill, 2022-11-23): Prevent type cycle declaration (e.g. vtable) of procedures
 					// because LLVM is dumb with procedure types
 					field_type = t_rawptr;
 				}
-
-				// max_field_align might misalign items in a way that requires packing
-				// so check the alignment of all fields to see if packing is required.
-				requires_packing = requires_packing || ((offset % type_align_of(field_type)) != 0);
-
-				array_add(&fields, lb_type(m, field_type));
-
-				prev_offset = offset + type_size_of(field->type);
-			}
-
-			i64 end_padding = full_type_size-prev_offset;
-			if (end_padding > 0) {
-				array_add(&fields, lb_type_padding_filler(m, end_padding, 1));
+				fields[i] = lb_type(m, field_type);
 			}
 
 			for_array(i, fields) {
@@ -2494,8 +3034,8 @@ gb_internal LLVMTypeRef lb_type_internal(lbModule *m, Type *type) {
 			}
 
 			LLVMTypeRef struct_type = LLVMStructTypeInContext(ctx, fields.data, cast(unsigned)fields.count, requires_packing);
-			map_set(&m->struct_field_remapping, cast(void *)struct_type, field_remapping);
-			map_set(&m->struct_field_remapping, cast(void *)type, field_remapping);
+			map_set(&m->struct_field_remapping, cast(void *)struct_type, layout->field_remapping);
+			map_set(&m->struct_field_remapping, cast(void *)type, layout->field_remapping);
 			#if 0
 			GB_ASSERT_MSG(lb_sizeof(struct_type) == full_type_size,
 			              "(%lld) %s vs (%lld) %s",
@@ -2803,6 +3343,12 @@ gb_internal bool lb_proc_has_attribute(lbModule *m, LLVMValueRef proc_value, cha
 	return ref != nullptr;
 }
 
+// NOTE: The stack frame size of every procedure is only known after instruction selection, so it is
+// gathered from LLVM's "warn-stack-size" diagnostics, and objects are then never taken from the cache
+gb_internal bool lb_gathers_stack_usage(lbModule *m) {
+	return build_context.show_stack_usage || m->info->has_max_stack_usage.load(std::memory_order_relaxed);
+}
+
 gb_internal void lb_add_attribute_to_proc_with_string(lbModule *m, LLVMValueRef proc_value, String const &name, String const &value) {
 	LLVMAttributeRef attr = lb_create_string_attribute(m->ctx, name, value);
 	LLVMAddAttributeAtIndex(proc_value, LLVMAttributeIndex_FunctionIndex, attr);
@@ -2844,6 +3390,31 @@ gb_internal void lb_add_edge(lbBlock *from, lbBlock *to) {
 }
 
 
+// NOTE: The scratch memory of a procedure lives on the temporary arena of the thread which is
+// generating it, and it is all released at once when the procedure has been generated.
+// Anything allocated from it must not outlive the procedure's body generation (e.g. call
+// argument arrays, block lists, block names); LLVM copies everything it is handed.
+gb_internal void lb_procedure_scratch_begin(lbProcedure *p) {
+	GB_ASSERT(p->scratch.arena == nullptr);
+	p->scratch = arena_temp_begin(get_arena(ThreadArena_Temporary));
+}
+
+gb_internal void lb_procedure_scratch_end(lbProcedure *p) {
+	GB_ASSERT(p->scratch.arena != nullptr);
+	arena_temp_end(p->scratch);
+	p->scratch = {};
+}
+
+gb_internal gbAllocator lb_scratch_allocator(lbProcedure *p) {
+	if (p != nullptr && p->scratch.arena != nullptr) {
+		return arena_allocator(p->scratch.arena);
+	}
+	// NOTE: procedures which are not generated through `lb_generate_procedure`
+	// (e.g. the startup procedures and the generated helpers) keep what they allocate
+	return permanent_allocator();
+}
+
+
 gb_internal lbBlock *lb_create_block(lbProcedure *p, char const *name, bool append) {
 	lbBlock *b = permanent_alloc_item<lbBlock>();
 	b->block = LLVMCreateBasicBlockInContext(p->module->ctx, name);
@@ -3055,10 +3626,116 @@ general_end:;
 
 
 
+// NOTE: Embeds the contents of a large `#load`ed file with the assembler's `.incbin` directive, so
+// that the data never has to be copied into (and hashed by) LLVM. Like the constant string
+// globals, the data is NUL terminated. Returns nullptr if `str` is not the exact contents of such
+// a file or the object format is not handled, in which case the data must be emitted as normal.
+gb_internal LLVMValueRef lb_find_or_add_incbin_data(lbModule *m, String const &str, i64 alignment) {
+	if (str.len < LOAD_FILE_LARGE_SIZE || alignment > 16) {
+		return nullptr;
+	}
+	if (build_context.deterministic) {
+		// NOTE: `.incbin` needs the absolute path of the file within the object
+		return nullptr;
+	}
+	LoadFileCache **found_cache = map_get(&m->gen->incbin_files, cast(void *)str.text);
+	if (found_cache == nullptr || (*found_cache)->data.len != str.len) {
+		return nullptr;
+	}
+	LLVMValueRef *found = map_get(&m->incbin_data, cast(void *)str.text);
+	if (found != nullptr) {
+		return *found;
+	}
+
+	char const *section = nullptr;
+	char const *symbol_prefix = "";
+	switch (build_context.metrics.os) {
+	case TargetOs_windows:
+		if (build_context.metrics.arch == TargetArch_i386) {
+			return nullptr;
+		}
+		section = ".section .rdata,\"dr\"";
+		break;
+	case TargetOs_darwin:
+		section = ".section __TEXT,__const";
+		symbol_prefix = "_";
+		break;
+	case TargetOs_linux:
+	case TargetOs_freebsd:
+	case TargetOs_openbsd:
+	case TargetOs_netbsd:
+		section = nullptr; // per symbol, see below
+		break;
+	default:
+		return nullptr;
+	}
+
+	u32 id = m->gen->incbin_index.fetch_add(1);
+	gbString name = gb_string_make(permanent_allocator(), "");
+	name = gb_string_append_fmt(name, "__odin_incbin_%u", id);
+
+	gbString path = gb_string_make(temporary_allocator(), "");
+	String fullpath = (*found_cache)->path;
+	for (isize i = 0; i < fullpath.len; i++) {
+		u8 c = fullpath[i];
+		if (c == '\\') {
+			c = '/';
+		} else if (c == '"') {
+			path = gb_string_appendc(path, "\\");
+		}
+		path = gb_string_append_length(path, &c, 1);
+	}
+
+	gbString asm_str = gb_string_make(temporary_allocator(), "");
+	if (section != nullptr) {
+		asm_str = gb_string_append_fmt(asm_str, "%s\n", section);
+	} else {
+		asm_str = gb_string_append_fmt(asm_str, ".section .rodata.%s,\"a\",%%progbits\n", name);
+	}
+	asm_str = gb_string_append_fmt(asm_str, ".p2align 4\n");
+	asm_str = gb_string_append_fmt(asm_str, "%s%s:\n", symbol_prefix, name);
+	asm_str = gb_string_append_fmt(asm_str, ".incbin \"%s\"\n", path);
+	asm_str = gb_string_append_fmt(asm_str, ".byte 0\n");
+	asm_str = gb_string_append_fmt(asm_str, ".text\n");
+	LLVMAppendModuleInlineAsm(m->mod, asm_str, gb_string_length(asm_str));
+
+	LLVMTypeRef type = LLVMArrayType(LLVMInt8TypeInContext(m->ctx), cast(unsigned)(str.len+1));
+	LLVMValueRef global_data = LLVMAddGlobal(m->mod, type, name);
+	LLVMSetLinkage(global_data, LLVMExternalLinkage);
+	if (build_context.metrics.os != TargetOs_windows) {
+		LLVMSetVisibility(global_data, LLVMHiddenVisibility);
+	}
+	LLVMSetGlobalConstant(global_data, true);
+	LLVMSetAlignment(global_data, 16);
+
+	LLVMValueRef indices[2] = {llvm_zero(m), llvm_zero(m)};
+	LLVMValueRef ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
+	map_set(&m->incbin_data, cast(void *)str.text, ptr);
+	return ptr;
+}
+
+// NOTE: The string data is NUL terminated, so once its address is not significant, LLVM places it within
+// the SHF_MERGE|SHF_STRINGS `.rodata.str*` sections on ELF (`__cstring` on Darwin), where the linker keeps
+// a single copy of every string across all of the object files. This matters for -use-separate-modules,
+// where the same format strings, error messages, and type names are otherwise repeated by every module.
+// A string within a custom link section must stay where it was put.
+gb_internal void lb_make_global_string_data_mergeable(LLVMValueRef global_data, bool custom_link_section) {
+	if (!custom_link_section) {
+		LLVMSetUnnamedAddress(global_data, LLVMGlobalUnnamedAddr);
+	}
+}
+
 gb_internal LLVMValueRef lb_find_or_add_entity_string_ptr(lbModule *m, String const &str, bool custom_link_section) {
 	StringHashKey key = {};
 	LLVMValueRef *found = nullptr;
 
+	if (!custom_link_section) {
+		LLVMValueRef incbin_ptr = lb_find_or_add_incbin_data(m, str, 1);
+		if (incbin_ptr != nullptr) {
+			return incbin_ptr;
+		}
+	}
+
 	if (!custom_link_section) {
 		key = string_hash_string(str);
 		found = string_map_get(&m->const_strings, key);
@@ -3083,6 +3760,7 @@ gb_internal LLVMValueRef lb_find_or_add_entity_string_ptr(lbModule *m, String co
 		LLVMSetInitializer(global_data, data);
 		lb_make_global_private_const(global_data);
 		LLVMSetAlignment(global_data, 1);
+		lb_make_global_string_data_mergeable(global_data, custom_link_section);
 
 		LLVMValueRef ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
 		if (!custom_link_section) {
@@ -3135,6 +3813,7 @@ gb_internal LLVMValueRef lb_find_or_add_entity_string16_ptr(lbModule *m, String1
 	LLVMSetInitializer(global_data, data);
 	lb_make_global_private_const(global_data);
 	LLVMSetAlignment(global_data, 2);
+	lb_make_global_string_data_mergeable(global_data, custom_link_section);
 
 	LLVMValueRef ptr = LLVMConstInBoundsGEP2(type, global_data, indices, 2);
 	if (!custom_link_section) {
@@ -3160,6 +3839,28 @@ gb_internal lbValue lb_find_or_add_entity_string(lbModule *m, String const &str,
 
 gb_internal lbValue lb_find_or_add_entity_string_byte_slice_with_type(lbModule *m, String const &str, Type *slice_type) {
 	GB_ASSERT(is_type_slice(slice_type));
+
+	{
+		Type *elem = base_type(slice_type)->Slice.elem;
+		i64 align = gb_max(type_align_of(elem), MINIMUM_SLICE_ALIGNMENT);
+		LLVMValueRef ptr = lb_find_or_add_incbin_data(m, str, align);
+		if (ptr != nullptr) {
+			i64 sz = type_size_of(elem);
+			GB_ASSERT(sz > 0);
+			if (!is_type_u8_slice(slice_type)) {
+				ptr = LLVMConstPointerCast(ptr, lb_type(m, alloc_type_pointer(elem)));
+			}
+
+			LLVMValueRef len = LLVMConstInt(lb_type(m, t_int), str.len/sz, true);
+			LLVMValueRef values[2] = {ptr, len};
+
+			lbValue res = {};
+			res.value = llvm_const_named_struct(m, slice_type, values, 2);
+			res.type = slice_type;
+			return res;
+		}
+	}
+
 	LLVMValueRef indices[2] = {llvm_zero(m), llvm_zero(m)};
 	LLVMValueRef data = LLVMConstStringInContext(m->ctx,
 		cast(char const *)str.text,
@@ -3405,10 +4106,21 @@ gb_internal lbValue lb_generate_anonymous_proc_lit(lbModule *m, String const &pr
 
 	// NOTE(bill): Generate a new name
 	// parent$count
-	isize name_len = prefix_name.len + 6 + 11;
+	isize name_len = prefix_name.len + 6 + 11 + 9;
 	char *name_text = gb_alloc_array(permanent_allocator(), char, name_len);
 	static std::atomic<i32> name_id;
-	name_len = gb_snprintf(name_text, name_len, "%.*s$anon-%d", LIT(prefix_name), 1+name_id.fetch_add(1));
+	if (build_context.deterministic) {
+		// NOTE: The count depends upon the order in which the modules' threads reach each literal,
+		// the position within the file does not
+		AstFile *f = expr->file();
+		u32 file_hash = 0;
+		if (f != nullptr) {
+			file_hash = cast(u32)xxh64(f->filename.text, f->filename.len, f->pkg ? xxh64(f->pkg->name.text, f->pkg->name.len) : 0);
+		}
+		name_len = gb_snprintf(name_text, name_len, "%.*s$anon-%08x-%d", LIT(prefix_name), file_hash, pos.offset);
+	} else {
+		name_len = gb_snprintf(name_text, name_len, "%.*s$anon-%d", LIT(prefix_name), 1+name_id.fetch_add(1));
+	}
 	String name = make_string((u8 *)name_text, name_len-1);
 
 	Type *type = type_of_expr(expr);
@@ -3641,17 +4353,38 @@ gb_internal lbValue lb_build_cond(lbProcedure *p, Ast *cond, lbBlock *true_block
 	case_end;
 
 	case_ast_node(be, BinaryExpr, cond);
-		if (be->op.kind == Token_CmpAnd) {
-			lbBlock *block = lb_create_block(p, "cmp.and");
-			lb_build_cond(p, be->left, block, false_block);
-			lb_start_block(p, block);
-			lb_build_cond(p, be->right, true_block, false_block);
-			return no_comptime_short_circuit;
-		} else if (be->op.kind == Token_CmpOr) {
-			lbBlock *block = lb_create_block(p, "cmp.or");
-			lb_build_cond(p, be->left, true_block, block);
-			lb_start_block(p, block);
-			lb_build_cond(p, be->right, true_block, false_block);
+		TokenKind op = be->op.kind;
+		if (op == Token_CmpAnd || op == Token_CmpOr) {
+			// NOTE: A left-deep chain such as `a && b && c && ...` is lowered without recursing per operand.
+			// For `&&` each left operand jumps to the block of the next right operand when true, and for
+			// `||` when false.
+			TEMPORARY_ALLOCATOR_GUARD();
+			auto spine = array_make<Ast *>(temporary_allocator(), 0, 16);
+			auto blocks = array_make<lbBlock *>(temporary_allocator(), 0, 16);
+			for (Ast *e = cond; ; e = e->BinaryExpr.left) {
+				array_add(&spine, e);
+				array_add(&blocks, lb_create_block(p, op == Token_CmpAnd ? "cmp.and" : "cmp.or"));
+				Ast *left = e->BinaryExpr.left;
+				if (left->kind != Ast_BinaryExpr || left->BinaryExpr.op.kind != op) {
+					break;
+				}
+			}
+
+			isize last = spine.count-1;
+			if (op == Token_CmpAnd) {
+				lb_build_cond(p, spine[last]->BinaryExpr.left, blocks[last], false_block);
+			} else {
+				lb_build_cond(p, spine[last]->BinaryExpr.left, true_block, blocks[last]);
+			}
+			for (isize i = last; i >= 0; i--) {
+				lbBlock *next = i == 0 ? nullptr : blocks[i-1];
+				lb_start_block(p, blocks[i]);
+				if (op == Token_CmpAnd) {
+					lb_build_cond(p, spine[i]->BinaryExpr.right, next ? next : true_block, false_block);
+				} else {
+					lb_build_cond(p, spine[i]->BinaryExpr.right, true_block, next ? next : false_block);
+				}
+			}
 			return no_comptime_short_circuit;
 		}
 	case_end;
@@ -0,0 +1,267 @@
+// NOTE: `odin run -jit` hands the optimized modules straight to an ORC LLJIT instance and calls `main`
+// within the compiler's own process, skipping the object emission and the linking entirely.
+//
+// Compared to running an executable:
+//     * there is no platform runtime to set up thread local storage, so `@(thread_local)` variables
+//       are shared between every thread of the program
+//     * foreign imports of assembly files are not supported, nor static libraries on Windows
+//     * only the host target can be run (checked in main.cpp)
+
+gb_internal bool lb_jit_check_error(LLVMErrorRef err, char const *what) {
+	if (err == nullptr) {
+		return true;
+	}
+	char *msg = LLVMGetErrorMessage(err);
+	gb_printf_err("JIT Error: %s: %s\n", what, msg);
+	LLVMDisposeErrorMessage(msg);
+	return false;
+}
+
+gb_internal bool lb_jit_add_dynamic_library(LLVMOrcLLJITRef jit, LLVMOrcJITDylibRef jd, char const *path) {
+	LLVMOrcDefinitionGeneratorRef generator = nullptr;
+	LLVMErrorRef err = LLVMOrcCreateDynamicLibrarySearchGeneratorForPath(&generator, path, LLVMOrcLLJITGetGlobalPrefix(jit), nullptr, nullptr);
+	if (err != nullptr) {
+		LLVMConsumeError(err);
+		return false;
+	}
+	LLVMOrcJITDylibAddGenerator(jd, generator);
+	return true;
+}
+
+// NOTE: Mirrors how the linker stage treats each of the `LibraryName.paths`
+gb_internal bool lb_jit_add_foreign_library(LLVMOrcLLJITRef jit, LLVMOrcJITDylibRef jd, String const &lib) {
+	TEMPORARY_ALLOCATOR_GUARD();
+	char const *lib_c = alloc_cstring(temporary_allocator(), lib);
+
+	if (has_asm_extension(lib)) {
+		gb_printf_err("JIT Error: foreign imports of assembly files are not supported with -jit: %s\n", lib_c);
+		return false;
+	}
+
+	if (string_ends_with(lib, str_lit(".o")) || string_ends_with(lib, str_lit(".obj"))) {
+		LLVMMemoryBufferRef buffer = nullptr;
+		char *msg = nullptr;
+		if (LLVMCreateMemoryBufferWithContentsOfFile(lib_c, &buffer, &msg)) {
+			gb_printf_err("JIT Error: %s: %s\n", lib_c, msg);
+			LLVMDisposeMessage(msg);
+			return false;
+		}
+		return lb_jit_check_error(LLVMOrcLLJITAddObjectFile(jit, jd, buffer), lib_c);
+	}
+
+	if (string_ends_with(lib, str_lit(".lib"))) {
+		// NOTE: Usually the import library of a DLL of the same name
+		String dll = concatenate_strings(temporary_allocator(), remove_extension_from_path(lib), str_lit(".dll"));
+		if (lb_jit_add_dynamic_library(jit, jd, alloc_cstring(temporary_allocator(), dll))) {
+			return true;
+		}
+	}
+	if (string_ends_with(lib, str_lit(".a")) || string_ends_with(lib, str_lit(".lib"))) {
+	#if defined(GB_SYSTEM_WINDOWS)
+		// NOTE: the bundled LLVM-C.dll does not export LLVMOrcCreateStaticLibrarySearchGeneratorForPath
+		gb_printf_err("JIT Error: static libraries are not supported with -jit on Windows: %s\n", lib_c);
+		return false;
+	#else
+		LLVMOrcDefinitionGeneratorRef generator = nullptr;
+		LLVMErrorRef err = LLVMOrcCreateStaticLibrarySearchGeneratorForPath(&generator, LLVMOrcLLJITGetObjLinkingLayer(jit), lib_c, LLVMOrcLLJITGetTripleString(jit));
+		if (!lb_jit_check_error(err, lib_c)) {
+			return false;
+		}
+		LLVMOrcJITDylibAddGenerator(jd, generator);
+		return true;
+	#endif
+	}
+
+	if (string_ends_with(lib, str_lit(".framework"))) {
+		String name = remove_extension_from_path(last_path_element(lib));
+		String path = lib;
+		if (string_index_byte(lib, '/') < 0) {
+			path = concatenate_strings(temporary_allocator(), str_lit("/System/Library/Frameworks/"), lib);
+		}
+		path = concatenate3_strings(temporary_allocator(), path, str_lit("/"), name);
+		if (lb_jit_add_dynamic_library(jit, jd, alloc_cstring(temporary_allocator(), path))) {
+			return true;
+		}
+		gb_printf_err("JIT Error: failed to load the framework %s\n", lib_c);
+		return false;
+	}
+
+	if (string_ends_with(lib, str_lit(".so")) || string_contains_string(lib, str_lit(".so.")) ||
+	    string_ends_with(lib, str_lit(".dylib")) || string_ends_with(lib, str_lit(".dll"))) {
+		if (lb_jit_add_dynamic_library(jit, jd, lib_c)) {
+			return true;
+		}
+		gb_printf_err("JIT Error: failed to load the dynamic library %s\n", lib_c);
+		return false;
+	}
+
+	if (lib == str_lit("System.framework") || lib == str_lit("System") || lib == str_lit("c")) {
+		return true; // already part of the compiler's process
+	}
+
+	// NOTE: A system library name (e.g. `m` or `pthread`), found through the dynamic loader's search paths
+	char const *candidates[] = {"lib%s.so", "lib%s.dylib", "%s.dll"};
+	for (char const *fmt : candidates) {
+		gbString path = gb_string_make(temporary_allocator(), "");
+		path = gb_string_append_fmt(path, fmt, lib_c);
+		if (lb_jit_add_dynamic_library(jit, jd, path)) {
+			return true;
+		}
+	}
+	gb_printf_err("JIT Error: failed to find the system library %s\n", lib_c);
+	return false;
+}
+
+struct lbJitPerfMapEntry {
+	u64    address;
+	String name;
+};
+
+gb_internal GB_COMPARE_PROC(lb_jit_perf_map_entry_cmp) {
+	lbJitPerfMapEntry const *x = cast(lbJitPerfMapEntry const *)a;
+	lbJitPerfMapEntry const *y = cast(lbJitPerfMapEntry const *)b;
+	return x->address < y->address ? -1 : x->address > y->address;
+}
+
+// NOTE: perf symbolizes JIT code through `/tmp/perf-<pid>.map`, with one `START SIZE name` line per function.
+// The C API does not expose the sizes of the emitted functions so each one is taken to extend up to the
+// next known function (capped), and internal procedures are not found by name so they are not listed.
+gb_internal void lb_jit_write_perf_map(LLVMOrcLLJITRef jit, Array<String> const &names) {
+#if defined(GB_SYSTEM_UNIX)
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto entries = array_make<lbJitPerfMapEntry>(heap_allocator(), 0, names.count);
+	defer (array_free(&entries));
+	for (String const &name : names) {
+		LLVMOrcExecutorAddress address = 0;
+		LLVMErrorRef err = LLVMOrcLLJITLookup(jit, &address, alloc_cstring(temporary_allocator(), name));
+		if (err != nullptr) {
+			LLVMConsumeError(err);
+			continue;
+		}
+		array_add(&entries, lbJitPerfMapEntry{cast(u64)address, name});
+	}
+	if (entries.count == 0) {
+		return;
+	}
+	array_sort(entries, lb_jit_perf_map_entry_cmp);
+
+	char path[64] = {};
+	gb_snprintf(path, gb_size_of(path), "/tmp/perf-%d.map", cast(int)getpid());
+	gbFile f = {};
+	if (gb_file_create(&f, path) != gbFileError_None) {
+		gb_printf_err("JIT Error: failed to create the perf map %s\n", path);
+		return;
+	}
+	defer (gb_file_close(&f));
+
+	u64 const MAX_SIZE = 1<<16;
+	for_array(i, entries) {
+		lbJitPerfMapEntry const &e = entries[i];
+		u64 size = MAX_SIZE;
+		if (i+1 < entries.count) {
+			size = gb_min(entries[i+1].address - e.address, MAX_SIZE);
+		}
+		if (size == 0) {
+			continue;
+		}
+		gb_fprintf(&f, "%llx %llx %.*s\n", cast(unsigned long long)e.address, cast(unsigned long long)size, LIT(e.name));
+	}
+#endif
+}
+
+// Returns the exit code of the program
+gb_internal i32 lb_jit_run(lbGenerator *gen, Array<String> const &run_args) {
+	LLVMOrcJITTargetMachineBuilderRef target_machine_builder = nullptr;
+	if (!lb_jit_check_error(LLVMOrcJITTargetMachineBuilderDetectHost(&target_machine_builder), "detecting the host")) {
+		return 1;
+	}
+	LLVMOrcLLJITBuilderRef builder = LLVMOrcCreateLLJITBuilder();
+	LLVMOrcLLJITBuilderSetJITTargetMachineBuilder(builder, target_machine_builder);
+
+	// NOTE: Never disposed, the program's threads may still be running once `main` returns
+	LLVMOrcLLJITRef jit = nullptr;
+	if (!lb_jit_check_error(LLVMOrcCreateLLJIT(&jit, builder), "creating the JIT")) {
+		return 1;
+	}
+	LLVMOrcJITDylibRef jd = LLVMOrcLLJITGetMainJITDylib(jit);
+
+	{ // e.g. libc, which the compiler itself is linked against
+		LLVMOrcDefinitionGeneratorRef generator = nullptr;
+		LLVMErrorRef err = LLVMOrcCreateDynamicLibrarySearchGeneratorForProcess(&generator, LLVMOrcLLJITGetGlobalPrefix(jit), nullptr, nullptr);
+		if (!lb_jit_check_error(err, "searching the process' symbols")) {
+			return 1;
+		}
+		LLVMOrcJITDylibAddGenerator(jd, generator);
+	}
+
+	StringSet seen_libs = {};
+	string_set_init(&seen_libs);
+	defer (string_set_destroy(&seen_libs));
+	for (Entity *e : gen->foreign_libraries) {
+		GB_ASSERT(e->kind == Entity_LibraryName);
+		for (String lib : e->LibraryName.paths) {
+			lib = string_trim_whitespace(lib);
+			if (lib.len == 0 || string_set_update(&seen_libs, lib)) {
+				continue;
+			}
+			if (!lb_jit_add_foreign_library(jit, jd, lib)) {
+				return 1;
+			}
+		}
+	}
+
+	auto perf_map_names = array_make<String>(heap_allocator());
+	defer (array_free(&perf_map_names));
+
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		if (lb_is_module_empty(m)) {
+			continue;
+		}
+		if (build_context.profile_friendly) {
+			for (LLVMValueRef f = LLVMGetFirstFunction(m->mod); f != nullptr; f = LLVMGetNextFunction(f)) {
+				LLVMLinkage linkage = LLVMGetLinkage(f);
+				if (LLVMCountBasicBlocks(f) == 0 || linkage == LLVMInternalLinkage || linkage == LLVMPrivateLinkage) {
+					continue;
+				}
+				size_t len = 0;
+				char const *name = LLVMGetValueName2(f, &len);
+				array_add(&perf_map_names, copy_string(heap_allocator(), make_string(cast(u8 const *)name, cast(isize)len)));
+			}
+		}
+		for (LLVMValueRef g = LLVMGetFirstGlobal(m->mod); g != nullptr; g = LLVMGetNextGlobal(g)) {
+			if (LLVMIsThreadLocal(g)) {
+				LLVMSetThreadLocal(g, false);
+			}
+		}
+
+		// NOTE: The thread safe module takes the ownership of the module, and shares the context's
+		LLVMOrcThreadSafeModuleRef tsm = LLVMOrcCreateNewThreadSafeModule(m->mod, m->jit_context);
+		LLVMOrcDisposeThreadSafeContext(m->jit_context);
+		m->mod = nullptr;
+		m->jit_context = nullptr;
+		if (!lb_jit_check_error(LLVMOrcLLJITAddLLVMIRModule(jit, jd, tsm), m->module_name)) {
+			return 1;
+		}
+	}
+
+	LLVMOrcExecutorAddress main_address = 0;
+	if (!lb_jit_check_error(LLVMOrcLLJITLookup(jit, &main_address, "main"), "looking up main")) {
+		return 1;
+	}
+	if (build_context.profile_friendly) {
+		lb_jit_write_perf_map(jit, perf_map_names);
+	}
+
+	String exe_name = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
+	auto argv = array_make<char *>(heap_allocator(), 0, run_args.count+2);
+	array_add(&argv, cast(char *)alloc_cstring(heap_allocator(), exe_name));
+	for (String const &arg : run_args) {
+		array_add(&argv, cast(char *)alloc_cstring(heap_allocator(), arg));
+	}
+	array_add(&argv, cast(char *)nullptr);
+
+	typedef int (*lbJitMainProc)(int argc, char **argv);
+	lbJitMainProc main_proc = cast(lbJitMainProc)cast(uintptr)main_address;
+	return cast(i32)main_proc(cast(int)(argv.count-1), argv.data);
+}
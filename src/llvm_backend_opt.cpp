@@ -249,13 +249,33 @@ gb_internal LLVMValueRef lb_run_instrumentation_pass_insert_call(lbProcedure *p,
 }
 
 
+gb_internal i64 lb_count_instructions(LLVMValueRef func, i64 limit) {
+	i64 count = 0;
+	for (LLVMBasicBlockRef bb = LLVMGetFirstBasicBlock(func); bb != nullptr; bb = LLVMGetNextBasicBlock(bb)) {
+		for (LLVMValueRef instr = LLVMGetFirstInstruction(bb); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+			if (++count >= limit) {
+				return count;
+			}
+		}
+	}
+	return count;
+}
+
+gb_internal void lb_add_attribute_to_proc_with_string(lbModule *m, LLVMValueRef proc_value, String const &name, String const &value);
+
+// NOTE: The number of NOPs needed for a call (or a jump to a trampoline) to be patched in at runtime
+gb_internal String lb_patchable_function_entry_nop_count(void) {
+	switch (build_context.metrics.arch) {
+	case TargetArch_amd64:
+	case TargetArch_i386:
+		return str_lit("5"); // `call rel32`, in single byte NOPs
+	default:
+		return str_lit("2"); // e.g. `mov x9, lr; bl <target>` on arm64
+	}
+}
+
 gb_internal void lb_run_instrumentation_pass(lbProcedure *p) {
 	lbModule *m = p->module;
-	Entity *enter = m->info->instrumentation_enter_entity;
-	Entity *exit  = m->info->instrumentation_exit_entity;
-	if (enter == nullptr || exit == nullptr) {
-		return;
-	}
 	if (!(p->entity &&
 	      p->entity->kind == Entity_Procedure &&
 	      p->entity->Procedure.has_instrumentation)) {
@@ -264,6 +284,24 @@ gb_internal void lb_run_instrumentation_pass(lbProcedure *p) {
 
 #define LLVM_V_NAME(x) x, cast(unsigned)(gb_count_of(x)-1)
 
+	if (build_context.instrumentation_min_size > 0 &&
+	    lb_count_instructions(p->value, build_context.instrumentation_min_size) < build_context.instrumentation_min_size) {
+		LLVMRemoveStringAttributeAtIndex(p->value, LLVMAttributeIndex_FunctionIndex, LLVM_V_NAME("instrument-function-entry"));
+		LLVMRemoveStringAttributeAtIndex(p->value, LLVMAttributeIndex_FunctionIndex, LLVM_V_NAME("instrument-function-exit"));
+		return;
+	}
+
+	if (build_context.instrumentation_mode == InstrumentationMode_Patchable) {
+		lb_add_attribute_to_proc_with_string(m, p->value, str_lit("patchable-function-entry"), lb_patchable_function_entry_nop_count());
+		return;
+	}
+
+	Entity *enter = m->info->instrumentation_enter_entity;
+	Entity *exit  = m->info->instrumentation_exit_entity;
+	if (enter == nullptr || exit == nullptr) {
+		return;
+	}
+
 	LLVMBuilderRef dummy_builder = LLVMCreateBuilderInContext(m->ctx);
 	defer (LLVMDisposeBuilder(dummy_builder));
 
@@ -391,99 +429,238 @@ gb_internal void lb_append_to_used(lbModule *m, LLVMValueRef value) {
 	lb_append_to_llvm_used_list(m, value, "llvm.used");
 }
 
-gb_internal void lb_run_remove_unused_function_pass(lbModule *m) {
-	isize removal_count = 0;
-	isize pass_count = 0;
-	isize const max_pass_count = 10;
+enum {
+	LB_TYPE_SWITCH_MAX_HOT_CASES = 4,
+	LB_TYPE_SWITCH_HOT_CASE_DIV  = 8, // a case is hot when it is taken at least 1/8th of the time
+};
+
+struct lbSwitchCaseWeight {
+	unsigned successor;
+	u64      weight;
+};
+
+gb_internal GB_COMPARE_PROC(lb_switch_case_weight_cmp) {
+	auto const *x = cast(lbSwitchCaseWeight const *)a;
+	auto const *y = cast(lbSwitchCaseWeight const *)b;
+	if (x->weight != y->weight) {
+		return x->weight > y->weight ? -1 : +1;
+	}
+	return x->successor < y->successor ? -1 : x->successor > y->successor ? +1 : 0;
+}
 
-	// Custom remove dead function pass (for internal linkage functions)
-	for (; pass_count < max_pass_count; pass_count++) {
-		bool was_dead = false;
-		for (LLVMValueRef func = LLVMGetFirstFunction(m->mod);
-		     func != nullptr;
-		     /**/
-		     ) {
-		     	LLVMValueRef curr_func = func;
-		     	func = LLVMGetNextFunction(func);
-
-			LLVMUseRef first_use = LLVMGetFirstUse(curr_func);
-			if (first_use != nullptr)  {
+// NOTE: A type switch is a `switch` on the tag of the union (or typeid of the `any`), which becomes a jump table
+// or a tree of comparisons no matter how skewed the profile is, and LLVM only ever peels a single case off it
+// when that case dominates. Once `pgo-instr-use` has put the profile's weights on these switches, the few
+// cases which take most of the weight are compared against first, each a direct branch to its body which the
+// block placement then lays out in line, and the switch is only reached by the rest.
+gb_internal void lb_peel_hot_type_switch_cases(lbModule *m) {
+	unsigned type_switch_kind = LLVMGetMDKindIDInContext(m->ctx, LB_TYPE_SWITCH_METADATA, gb_size_of(LB_TYPE_SWITCH_METADATA)-1);
+	unsigned prof_kind        = LLVMGetMDKindIDInContext(m->ctx, "prof", 4);
+
+	LLVMBuilderRef builder = LLVMCreateBuilderInContext(m->ctx);
+	defer (LLVMDisposeBuilder(builder));
+
+	for (LLVMValueRef fn = LLVMGetFirstFunction(m->mod); fn != nullptr; fn = LLVMGetNextFunction(fn)) {
+		for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(fn); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+			LLVMValueRef sw = LLVMGetBasicBlockTerminator(block);
+			if (sw == nullptr || !LLVMIsASwitchInst(sw) || LLVMGetMetadata(sw, type_switch_kind) == nullptr) {
 				continue;
 			}
-			String name = {};
-			name.text = cast(u8 *)LLVMGetValueName2(curr_func, cast(size_t *)&name.len);
+			LLVMSetMetadata(sw, type_switch_kind, nullptr);
 
-			if (LLVMIsDeclaration(curr_func)) {
-				// Ignore for the time being
+			LLVMValueRef prof = LLVMGetMetadata(sw, prof_kind);
+			unsigned successor_count = LLVMGetNumSuccessors(sw);
+			if (prof == nullptr || successor_count <= 3) {
 				continue;
 			}
-			LLVMLinkage linkage = LLVMGetLinkage(curr_func);
-			if (linkage != LLVMInternalLinkage) {
+
+			TEMPORARY_ALLOCATOR_GUARD();
+			unsigned operand_count = LLVMGetMDNodeNumOperands(prof);
+			LLVMValueRef *operands = gb_alloc_array(temporary_allocator(), LLVMValueRef, operand_count);
+			LLVMGetMDNodeOperands(prof, operands);
+
+			// NOTE: `!{!"branch_weights", [!"expected",] i32 <default>, i32 <case 0>, ...}`
+			unsigned first_weight = 0;
+			while (first_weight < operand_count && !LLVMIsAConstantInt(operands[first_weight])) {
+				first_weight += 1;
+			}
+			if (operand_count - first_weight != successor_count) {
 				continue;
 			}
 
-			Entity **found = map_get(&m->procedure_values, curr_func);
-			if (found && *found) {
-				Entity *e = *found;
-				bool is_required = (e->flags & EntityFlag_Require) == EntityFlag_Require;
-				if (is_required) {
-					lb_append_to_compiler_used(m, curr_func);
-					continue;
-				}
+			auto cases = slice_make<lbSwitchCaseWeight>(temporary_allocator(), successor_count-1);
+			u64 total = LLVMConstIntGetZExtValue(operands[first_weight]);
+			for (unsigned i = 1; i < successor_count; i++) {
+				u64 weight = LLVMConstIntGetZExtValue(operands[first_weight+i]);
+				cases[i-1] = {i, weight};
+				total += weight;
 			}
+			if (total == 0) {
+				continue;
+			}
+			gb_sort_array(cases.data, cases.count, lb_switch_case_weight_cmp);
 
-			llvm_delete_function(curr_func);
-			was_dead = true;
-			removal_count += 1;
-		}
-		if (!was_dead) {
-			break;
+			isize hot_count = 0;
+			while (hot_count < gb_min(cases.count, LB_TYPE_SWITCH_MAX_HOT_CASES) &&
+			       cases[hot_count].weight >= total/LB_TYPE_SWITCH_HOT_CASE_DIV) {
+				hot_count += 1;
+			}
+			if (hot_count == 0) {
+				continue;
+			}
+
+			// NOTE: every successor gets a new predecessor, which is only simple to do when none of them has a phi
+			bool has_phi = false;
+			for (unsigned i = 0; i < successor_count && !has_phi; i++) {
+				LLVMValueRef first = LLVMGetFirstInstruction(LLVMGetSuccessor(sw, i));
+				has_phi = first != nullptr && LLVMIsAPHINode(first);
+			}
+			if (has_phi) {
+				continue;
+			}
+
+			LLVMValueRef cond = LLVMGetOperand(sw, 0);
+			LLVMBasicBlockRef dispatch = LLVMAppendBasicBlockInContext(m->ctx, fn, "typeswitch.dispatch");
+			LLVMInstructionRemoveFromParent(sw);
+			LLVMPositionBuilderAtEnd(builder, dispatch);
+			LLVMInsertIntoBuilder(builder, sw);
+
+			LLVMPositionBuilderAtEnd(builder, block);
+			u64 remaining = total;
+			for (isize i = 0; i < hot_count; i++) {
+				lbSwitchCaseWeight const &c = cases[i];
+				// NOTE: the operands of a switch are the condition and default, then a value and destination per case
+				LLVMValueRef case_value = LLVMGetOperand(sw, 2*c.successor);
+				LLVMBasicBlockRef next = dispatch;
+				if (i+1 < hot_count) {
+					next = LLVMInsertBasicBlockInContext(m->ctx, dispatch, "typeswitch.hot");
+				}
+
+				LLVMValueRef is_case = LLVMBuildICmp(builder, LLVMIntEQ, cond, case_value, "");
+				LLVMValueRef br = LLVMBuildCondBr(builder, is_case, LLVMGetSuccessor(sw, c.successor), next);
+
+				remaining -= c.weight;
+				LLVMMetadataRef weights[3] = {
+					LLVMMDStringInContext2(m->ctx, "branch_weights", 14),
+					LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), gb_min(c.weight,  cast(u64)UINT32_MAX), false)),
+					LLVMValueAsMetadata(LLVMConstInt(LLVMInt32TypeInContext(m->ctx), gb_min(remaining, cast(u64)UINT32_MAX), false)),
+				};
+				LLVMSetMetadata(br, prof_kind, LLVMMetadataAsValue(m->ctx, LLVMMDNodeInContext2(m->ctx, weights, gb_count_of(weights))));
+
+				LLVMPositionBuilderAtEnd(builder, next);
+			}
 		}
 	}
 }
 
+// NOTE: Removes the internal functions and globals which cannot be reached from anything externally visible
+// (or required) in one walk over the module, rather than repeatedly removing whatever has no uses left, which
+// is quadratic in long chains and can never remove dead cycles. Each reachable definition is visited once,
+// and the operands of its instructions (or its initializer) mark what it refers to.
+gb_internal void lb_run_remove_unreachable_pass(lbModule *m) {
+	auto const is_candidate = [](LLVMValueRef v) -> bool {
+		return LLVMGetLinkage(v) == LLVMInternalLinkage && !LLVMIsDeclaration(v);
+	};
+	auto const is_required = [m](LLVMValueRef v) -> bool {
+		Entity **found = map_get(&m->procedure_values, v);
+		return found && *found && ((*found)->flags & EntityFlag_Require) == EntityFlag_Require;
+	};
+	auto const may_refer_to_globals = [](LLVMValueRef v) -> bool {
+		return LLVMIsAGlobalValue(v) || LLVMIsAConstantExpr(v) ||
+		       LLVMIsAConstantStruct(v) || LLVMIsAConstantArray(v) || LLVMIsAConstantVector(v) ||
+		       LLVMIsABlockAddress(v);
+	};
+
+	PtrSet<LLVMValueRef> live = {};
+	ptr_set_init(&live, 1024);
+	defer (ptr_set_destroy(&live));
+
+	auto worklist = array_make<LLVMValueRef>(heap_allocator(), 0, 1024);
+	defer (array_free(&worklist));
+	auto required = array_make<LLVMValueRef>(heap_allocator());
+	defer (array_free(&required));
+
+	auto const mark = [&](LLVMValueRef v) {
+		if (v != nullptr && !ptr_set_update(&live, v)) {
+			array_add(&worklist, v);
+		}
+	};
+
+	for (LLVMValueRef func = LLVMGetFirstFunction(m->mod); func != nullptr; func = LLVMGetNextFunction(func)) {
+		if (!is_candidate(func)) {
+			mark(func);
+		} else if (is_required(func)) {
+			mark(func);
+			array_add(&required, func);
+		}
+	}
+	for (LLVMValueRef global = LLVMGetFirstGlobal(m->mod); global != nullptr; global = LLVMGetNextGlobal(global)) {
+		if (!is_candidate(global) || is_required(global)) {
+			mark(global);
+		}
+	}
+	for (LLVMValueRef alias = LLVMGetFirstGlobalAlias(m->mod); alias != nullptr; alias = LLVMGetNextGlobalAlias(alias)) {
+		mark(alias);
+	}
 
-gb_internal void lb_run_remove_unused_globals_pass(lbModule *m) {
-	isize removal_count = 0;
-	isize pass_count = 0;
-	isize const max_pass_count = 10;
-	// Custom remove dead function pass
-	for (; pass_count < max_pass_count; pass_count++) {
-		bool was_dead = false;	
-		for (LLVMValueRef global = LLVMGetFirstGlobal(m->mod);
-		     global != nullptr;
-		     /**/
-		     ) {
-		     	LLVMValueRef curr_global = global;
-		     	global = LLVMGetNextGlobal(global);
-		     	
-			LLVMUseRef first_use = LLVMGetFirstUse(curr_global);
-			if (first_use != nullptr)  {
-				continue;
-			}
-			String name = {};
-			name.text = cast(u8 *)LLVMGetValueName2(curr_global, cast(size_t *)&name.len);
-						
-			LLVMLinkage linkage = LLVMGetLinkage(curr_global);
-			if (linkage != LLVMInternalLinkage) {
-				continue;
+	while (worklist.count > 0) {
+		LLVMValueRef v = array_pop(&worklist);
+		if (LLVMIsAFunction(v)) {
+			for (LLVMBasicBlockRef block = LLVMGetFirstBasicBlock(v); block != nullptr; block = LLVMGetNextBasicBlock(block)) {
+				for (LLVMValueRef instr = LLVMGetFirstInstruction(block); instr != nullptr; instr = LLVMGetNextInstruction(instr)) {
+					int operand_count = LLVMGetNumOperands(instr);
+					for (int i = 0; i < operand_count; i++) {
+						LLVMValueRef op = LLVMGetOperand(instr, i);
+						if (op != nullptr && may_refer_to_globals(op)) {
+							mark(op);
+						}
+					}
+				}
 			}
-			
-			Entity **found = map_get(&m->procedure_values, curr_global);
-			if (found && *found) {
-				Entity *e = *found;
-				bool is_required = (e->flags & EntityFlag_Require) == EntityFlag_Require;
-				if (is_required) {
-					continue;
+		} else if (LLVMIsAGlobalVariable(v)) {
+			mark(LLVMGetInitializer(v));
+		} else if (LLVMIsAGlobalAlias(v)) {
+			mark(LLVMAliasGetAliasee(v));
+		} else {
+			int operand_count = LLVMGetNumOperands(v);
+			for (int i = 0; i < operand_count; i++) {
+				LLVMValueRef op = LLVMGetOperand(v, i);
+				if (op != nullptr && may_refer_to_globals(op)) {
+					mark(op);
 				}
 			}
+		}
+	}
 
-			LLVMDeleteGlobal(curr_global);
-			was_dead = true;
-			removal_count += 1;
+	auto dead = array_make<LLVMValueRef>(heap_allocator());
+	defer (array_free(&dead));
+	for (LLVMValueRef func = LLVMGetFirstFunction(m->mod); func != nullptr; func = LLVMGetNextFunction(func)) {
+		if (is_candidate(func) && !ptr_set_exists(&live, func)) {
+			array_add(&dead, func);
 		}
-		if (!was_dead) {
-			break;
+	}
+	for (LLVMValueRef global = LLVMGetFirstGlobal(m->mod); global != nullptr; global = LLVMGetNextGlobal(global)) {
+		if (is_candidate(global) && !ptr_set_exists(&live, global)) {
+			array_add(&dead, global);
+		}
+	}
+
+	// NOTE: Only dead code (or constants only used by dead code) can still refer to a dead value, and the
+	// uses have to be gone before anything can be deleted, as they may refer to each other
+	for (LLVMValueRef v : dead) {
+		LLVMReplaceAllUsesWith(v, LLVMGetUndef(LLVMTypeOf(v)));
+	}
+	for (LLVMValueRef v : dead) {
+		if (LLVMIsAFunction(v)) {
+			llvm_delete_function(v);
+		} else {
+			LLVMDeleteGlobal(v);
+		}
+	}
+
+	for (LLVMValueRef func : required) {
+		if (LLVMGetFirstUse(func) == nullptr) {
+			lb_append_to_compiler_used(m, func);
 		}
 	}
 }
@@ -67,7 +67,7 @@ gb_internal void lb_mem_copy_non_overlapping(lbProcedure *p, lbValue dst, lbValu
 }
 
 
-gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body) {
+gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body, TargetClone const *target_clone) {
 	GB_ASSERT(entity != nullptr);
 	GB_ASSERT(entity->kind == Entity_Procedure);
 	// Skip codegen for unspecialized polymorphic procedures
@@ -92,6 +92,9 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	} else {
 		link_name = lb_get_entity_name(m, entity);
 	}
+	if (target_clone != nullptr) {
+		link_name = concatenate3_strings(permanent_allocator(), link_name, str_lit("."), target_clone->name);
+	}
 
 	{
 		StringHashKey key = string_hash_string(link_name);
@@ -105,8 +108,12 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	lbProcedure *p = permanent_alloc_item<lbProcedure>();
 
 	p->module = m;
-	entity->code_gen_module = m;
-	entity->code_gen_procedure = p;
+	if (target_clone == nullptr) {
+		entity->code_gen_module = m;
+		entity->code_gen_procedure = p;
+	} else {
+		p->target_clone = *target_clone;
+	}
 	p->entity = entity;
 	p->name = link_name;
 
@@ -122,9 +129,16 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	p->inlining       = pl->inlining;
 	p->tailing        = pl->tailing;
 	p->is_foreign     = entity->Procedure.is_foreign;
-	p->is_export      = entity->Procedure.is_export;
+	p->is_export      = entity->Procedure.is_export && target_clone == nullptr;
 	p->is_entry_point = false;
 
+	bool is_target_clones_dispatcher = !ignore_body && target_clone == nullptr && entity->Procedure.target_clones.len != 0;
+	if (is_target_clones_dispatcher) {
+		// NOTE: the body is generated once per clone, this procedure only forwards to the clone selected at run time
+		p->body = nullptr;
+		p->generate_body = lb_generate_target_clones_dispatcher;
+	}
+
 	gbAllocator a = heap_allocator();
 	p->children.allocator          = a;
 	p->defer_stmts.allocator       = a;
@@ -133,6 +147,7 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	p->context_stack.allocator     = a;
 	p->scope_stack.allocator       = a;
 	p->asan_stack_locals.allocator = a;
+	p->range_facts.allocator       = a;
 	// map_init(&p->selector_values,  0);
 	// map_init(&p->selector_addr,    0);
 	// map_init(&p->tuple_fix_map,    0);
@@ -212,6 +227,13 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 		break;
 	}
 
+	if (!entity->Procedure.is_foreign && lb_gathers_stack_usage(m)) {
+		// NOTE: LLVM reports every stack frame larger than "warn-stack-size" to the diagnostic handler,
+		// which is how the frame sizes are gathered, see `lb_diagnostic_handler`
+		lb_add_attribute_to_proc_with_string(m, p->value, str_lit("warn-stack-size"), str_lit("0"));
+		mpsc_enqueue(&global_stack_usages, lbStackUsage{p->name, entity, 0});
+	}
+
 	if (pt->Proc.enable_target_feature.len != 0) {
 		gbString feature_str = gb_string_make(temporary_allocator(), "");
 
@@ -234,6 +256,9 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 
 		lb_add_attribute_to_proc_with_string(m, p->value, make_string_c("target-features"), make_string_c(feature_str));
 	}
+	if (target_clone != nullptr && target_clone->llvm_features.len != 0) {
+		lb_add_attribute_to_proc_with_string(m, p->value, make_string_c("target-features"), target_clone->llvm_features);
+	}
 
 	if (entity->flags & EntityFlag_Cold) {
 		lb_add_attribute_to_proc(m, p->value, "cold");
@@ -307,18 +332,30 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 		}
 	}
 
+	if (pt->Proc.calling_convention == ProcCC_Odin && !p->is_foreign) {
+		// NOTE: a procedure never writes through its incoming context pointer, since assigning to
+		// 'context' first copies it into a new local (see lb_addr_store). Marking it as readonly
+		// lets LLVM forward a known 'context.allocator' across calls and devirtualize it
+		unsigned context_ptr_index = LLVMCountParams(p->value);
+		lb_add_proc_attribute_at_index(p, context_ptr_index, "readonly");
+	}
+
 	if (ignore_body) {
 		p->body = nullptr;
 		LLVMSetLinkage(p->value, LLVMExternalLinkage);
 	}
 
 	lb_set_linkage_from_entity_flags(p->module, p->value, entity->flags);
+	if (target_clone != nullptr) {
+		LLVMSetLinkage(p->value, LLVMInternalLinkage);
+	}
 
 	// With LTO on all platforms, required procedures with external linkage need to be added to
 	// llvm.used to survive linker-level dead code elimination. This is necessary because
 	// LLVM may generate implicit calls to runtime builtins (e.g., __extendhfsf2 for f16
 	// conversions) during instruction lowering, after the IR is finalized.
-	if (build_context.lto_kind != LTO_None) {
+	// The same applies to `--gc-sections`, where `llvm.used` marks the section as retained.
+	if (build_context.lto_kind != LTO_None || linker_uses_dead_section_elimination()) {
 		if (entity->flags & EntityFlag_Require) {
 			LLVMLinkage linkage = LLVMGetLinkage(p->value);
 			if (linkage != LLVMInternalLinkage) {
@@ -394,7 +431,7 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 		}
 	}
 
-	if (p->body && entity->Procedure.has_instrumentation) {
+	if (p->body && entity->Procedure.has_instrumentation && build_context.instrumentation_mode == InstrumentationMode_Calls) {
 		Entity *instrumentation_enter = m->info->instrumentation_enter_entity;
 		Entity *instrumentation_exit  = m->info->instrumentation_exit_entity;
 		if (instrumentation_enter && instrumentation_exit) {
@@ -407,13 +444,189 @@ gb_internal lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool i
 	}
 
 	lbValue proc_value = {p->value, p->type};
-	lb_add_entity(m, entity,  proc_value);
+	if (target_clone == nullptr) {
+		lb_add_entity(m, entity, proc_value);
+	}
 	lb_add_member(m, p->name, proc_value);
 	lb_add_procedure_value(m, p);
 
+	if (is_target_clones_dispatcher) {
+		auto clones = array_make<lbProcedure *>(permanent_allocator(), 0, 4);
+
+		TargetClone baseline = {str_lit("default")};
+		array_add(&clones, lb_create_procedure(m, entity, false, &baseline));
+
+		String_Iterator it = {entity->Procedure.target_clones, 0};
+		for (;;) {
+			String target = string_trim_whitespace(string_split_iterator(&it, ','));
+			if (target == "") break;
+			TargetClone clone = {};
+			bool ok = target_clone_parse(target, &clone, nullptr);
+			GB_ASSERT(ok);
+			array_add(&clones, lb_create_procedure(m, entity, false, &clone));
+		}
+
+		p->target_clones = slice_from_array(clones);
+		for (lbProcedure *clone : p->target_clones) {
+			mpsc_enqueue(&m->procedures_to_generate, clone);
+		}
+	}
+
 	return p;
 }
 
+gb_internal void lb_target_clones__cpuid(LLVMBuilderRef b, LLVMContextRef ctx, u32 leaf, LLVMValueRef regs[4]) {
+	LLVMTypeRef i32 = LLVMInt32TypeInContext(ctx);
+	LLVMTypeRef ret_types[4] = {i32, i32, i32, i32};
+	LLVMTypeRef param_types[2] = {i32, i32};
+	LLVMTypeRef func_type = LLVMFunctionType(LLVMStructTypeInContext(ctx, ret_types, 4, false), param_types, 2, false);
+	LLVMValueRef the_asm = llvm_get_inline_asm(func_type, str_lit("cpuid"), str_lit("={ax},={bx},={cx},={dx},{ax},{cx}"), true);
+
+	LLVMValueRef args[2] = {LLVMConstInt(i32, leaf, false), LLVMConstInt(i32, 0, false)};
+	LLVMValueRef res = LLVMBuildCall2(b, func_type, the_asm, args, 2, "");
+	for (unsigned i = 0; i < 4; i++) {
+		regs[i] = LLVMBuildExtractValue(b, res, i, "");
+	}
+}
+
+// NOTE: Selects the clone on the first call and caches it, then every call forwards to it.
+// An ELF ifunc would avoid the indirect call but the procedure's value must remain a function
+// for the rest of the backend, so a lazily resolved dispatcher is used on every target.
+gb_internal void lb_generate_target_clones_dispatcher(lbModule *m, lbProcedure *p) {
+	GB_ASSERT(p->target_clones.count > 0);
+
+	LLVMContextRef ctx = m->ctx;
+	LLVMTypeRef i32      = LLVMInt32TypeInContext(ctx);
+	LLVMTypeRef ptr_type = LLVMPointerTypeInContext(ctx, 0);
+	LLVMTypeRef fn_type  = LLVMGlobalGetValueType(p->value);
+	unsigned ptr_align   = cast(unsigned)build_context.ptr_size;
+
+	char const *resolved_name = alloc_cstring(temporary_allocator(), concatenate_strings(temporary_allocator(), p->name, str_lit(".resolved")));
+	LLVMValueRef resolved = LLVMAddGlobal(m->mod, ptr_type, resolved_name);
+	LLVMSetLinkage(resolved, LLVMInternalLinkage);
+	LLVMSetInitializer(resolved, LLVMConstNull(ptr_type));
+	LLVMSetAlignment(resolved, ptr_align);
+
+	LLVMBuilderRef b = LLVMCreateBuilderInContext(ctx);
+	defer (LLVMDisposeBuilder(b));
+
+	LLVMBasicBlockRef entry_block   = LLVMAppendBasicBlockInContext(ctx, p->value, "entry");
+	LLVMBasicBlockRef resolve_block = LLVMAppendBasicBlockInContext(ctx, p->value, "resolve");
+	LLVMBasicBlockRef xgetbv_block  = LLVMAppendBasicBlockInContext(ctx, p->value, "xgetbv");
+	LLVMBasicBlockRef select_block  = LLVMAppendBasicBlockInContext(ctx, p->value, "select");
+	LLVMBasicBlockRef call_block    = LLVMAppendBasicBlockInContext(ctx, p->value, "call");
+
+	LLVMPositionBuilderAtEnd(b, entry_block);
+	LLVMValueRef cached = LLVMBuildLoad2(b, ptr_type, resolved, "");
+	LLVMSetOrdering(cached, LLVMAtomicOrderingMonotonic);
+	LLVMSetAlignment(cached, ptr_align);
+	LLVMBuildCondBr(b, LLVMBuildIsNull(b, cached, ""), resolve_block, call_block);
+
+	LLVMPositionBuilderAtEnd(b, resolve_block);
+	LLVMValueRef regs[TargetCloneReg_COUNT] = {};
+	{
+		LLVMValueRef leaf0[4], leaf1[4], leaf7[4], ext0[4], ext1[4];
+		lb_target_clones__cpuid(b, ctx, 0, leaf0);
+		lb_target_clones__cpuid(b, ctx, 1, leaf1);
+		lb_target_clones__cpuid(b, ctx, 7, leaf7);
+		lb_target_clones__cpuid(b, ctx, 0x80000000u, ext0);
+		lb_target_clones__cpuid(b, ctx, 0x80000001u, ext1);
+
+		// NOTE: leaves above the maximum supported leaf return unrelated data, so they are masked out
+		LLVMValueRef all_bits = LLVMConstInt(i32, ~0u, false);
+		LLVMValueRef no_bits  = LLVMConstInt(i32, 0, false);
+		LLVMValueRef has_leaf7 = LLVMBuildICmp(b, LLVMIntUGE, leaf0[0], LLVMConstInt(i32, 7, false), "");
+		LLVMValueRef has_ext1  = LLVMBuildICmp(b, LLVMIntUGE, ext0[0], LLVMConstInt(i32, 0x80000001u, false), "");
+		LLVMValueRef leaf7_mask = LLVMBuildSelect(b, has_leaf7, all_bits, no_bits, "");
+		LLVMValueRef ext1_mask  = LLVMBuildSelect(b, has_ext1,  all_bits, no_bits, "");
+
+		regs[TargetCloneReg_Leaf1_ECX] = leaf1[2];
+		regs[TargetCloneReg_Leaf1_EDX] = leaf1[3];
+		regs[TargetCloneReg_Leaf7_EBX] = LLVMBuildAnd(b, leaf7[1], leaf7_mask, "");
+		regs[TargetCloneReg_Leaf7_ECX] = LLVMBuildAnd(b, leaf7[2], leaf7_mask, "");
+		regs[TargetCloneReg_Ext1_ECX]  = LLVMBuildAnd(b, ext1[2], ext1_mask, "");
+	}
+	// NOTE: xgetbv faults unless the OS has enabled it (osxsave)
+	LLVMValueRef osxsave = LLVMBuildAnd(b, regs[TargetCloneReg_Leaf1_ECX], LLVMConstInt(i32, 1u<<27, false), "");
+	LLVMBuildCondBr(b, LLVMBuildIsNotNull(b, osxsave, ""), xgetbv_block, select_block);
+
+	LLVMPositionBuilderAtEnd(b, xgetbv_block);
+	LLVMValueRef xcr0 = nullptr;
+	{
+		LLVMTypeRef ret_types[2] = {i32, i32};
+		LLVMTypeRef func_type = LLVMFunctionType(LLVMStructTypeInContext(ctx, ret_types, 2, false), &i32, 1, false);
+		LLVMValueRef the_asm = llvm_get_inline_asm(func_type, str_lit("xgetbv"), str_lit("={ax},={dx},{cx}"), true);
+		LLVMValueRef arg = LLVMConstInt(i32, 0, false);
+		xcr0 = LLVMBuildExtractValue(b, LLVMBuildCall2(b, func_type, the_asm, &arg, 1, ""), 0, "");
+	}
+	LLVMBuildBr(b, select_block);
+
+	LLVMPositionBuilderAtEnd(b, select_block);
+	{
+		LLVMValueRef xcr0_phi = LLVMBuildPhi(b, i32, "");
+		LLVMValueRef incoming_values[2] = {LLVMConstInt(i32, 0, false), xcr0};
+		LLVMBasicBlockRef incoming_blocks[2] = {resolve_block, xgetbv_block};
+		LLVMAddIncoming(xcr0_phi, incoming_values, incoming_blocks, 2);
+		regs[TargetCloneReg_XCR0] = xcr0_phi;
+	}
+
+	// NOTE: the targets are tried in the order they were written, falling back to the baseline
+	LLVMValueRef selected = p->target_clones[0]->value;
+	for (isize i = p->target_clones.count-1; i >= 1; i--) {
+		TargetClone const &clone = p->target_clones[i]->target_clone;
+		LLVMValueRef ok = LLVMConstInt(LLVMInt1TypeInContext(ctx), 1, false);
+		for (isize r = 0; r < TargetCloneReg_COUNT; r++) {
+			if (clone.masks[r] == 0) {
+				continue;
+			}
+			LLVMValueRef mask = LLVMConstInt(i32, clone.masks[r], false);
+			LLVMValueRef has = LLVMBuildICmp(b, LLVMIntEQ, LLVMBuildAnd(b, regs[r], mask, ""), mask, "");
+			ok = LLVMBuildAnd(b, ok, has, "");
+		}
+		selected = LLVMBuildSelect(b, ok, p->target_clones[i]->value, selected, "");
+	}
+	LLVMValueRef store = LLVMBuildStore(b, selected, resolved);
+	LLVMSetOrdering(store, LLVMAtomicOrderingMonotonic);
+	LLVMSetAlignment(store, ptr_align);
+	LLVMBuildBr(b, call_block);
+
+	LLVMPositionBuilderAtEnd(b, call_block);
+	LLVMValueRef target = LLVMBuildPhi(b, ptr_type, "");
+	{
+		LLVMValueRef incoming_values[2] = {cached, selected};
+		LLVMBasicBlockRef incoming_blocks[2] = {entry_block, select_block};
+		LLVMAddIncoming(target, incoming_values, incoming_blocks, 2);
+	}
+
+	unsigned param_count = LLVMCountParams(p->value);
+	LLVMValueRef *args = gb_alloc_array(temporary_allocator(), LLVMValueRef, param_count);
+	for (unsigned i = 0; i < param_count; i++) {
+		args[i] = LLVMGetParam(p->value, i);
+	}
+	LLVMValueRef call = LLVMBuildCall2(b, fn_type, target, args, param_count, "");
+	LLVMSetInstructionCallConv(call, LLVMGetFunctionCallConv(p->value));
+	LLVMSetTailCall(call, true);
+
+	// NOTE: ABI attributes such as sret and byval must also be present at the call site
+	for (unsigned idx = LLVMAttributeReturnIndex; idx <= param_count; idx++) {
+		unsigned attr_count = LLVMGetAttributeCountAtIndex(p->value, idx);
+		if (attr_count == 0) {
+			continue;
+		}
+		LLVMAttributeRef *attrs = gb_alloc_array(temporary_allocator(), LLVMAttributeRef, attr_count);
+		LLVMGetAttributesAtIndex(p->value, idx, attrs);
+		for (unsigned j = 0; j < attr_count; j++) {
+			LLVMAddCallSiteAttribute(call, idx, attrs[j]);
+		}
+	}
+
+	if (LLVMGetTypeKind(LLVMGetReturnType(fn_type)) == LLVMVoidTypeKind) {
+		LLVMBuildRetVoid(b);
+	} else {
+		LLVMBuildRet(b, call);
+	}
+}
+
 gb_internal lbProcedure *lb_create_dummy_procedure(lbModule *m, String link_name, Type *type) {
 	{
 		lbValue *found = string_map_get(&m->members, link_name);
@@ -442,6 +655,7 @@ gb_internal lbProcedure *lb_create_dummy_procedure(lbModule *m, String link_name
 	p->branch_blocks.allocator     = a;
 	p->context_stack.allocator     = a;
 	p->asan_stack_locals.allocator = a;
+	p->range_facts.allocator       = a;
 	map_init(&p->tuple_fix_map, 0);
 
 
@@ -1136,7 +1350,7 @@ gb_internal lbValue lb_emit_call(lbProcedure *p, lbValue value, Array<lbValue> c
 	lbValue result = {};
 
 	isize ignored_args = 0;
-	auto processed_args = array_make<lbValue>(permanent_allocator(), 0, args.count);
+	auto processed_args = array_make<lbValue>(lb_scratch_allocator(p), 0, args.count);
 
 	{
 
@@ -2797,7 +3011,7 @@ gb_internal lbValue lb_build_builtin_simd_proc(lbProcedure *p, Ast *expr, TypeAn
 			case BuiltinProc_simd_masked_expand_load:
 				arg_count = 3;
 				type_count = 1;
-				args[0] = ptr;
+				args[0] = ptr; align_idx = 0;
 				args[1] = mask;
 				args[2] = val;
 				break;
@@ -2806,15 +3020,17 @@ gb_internal lbValue lb_build_builtin_simd_proc(lbProcedure *p, Ast *expr, TypeAn
 				arg_count = 3;
 				type_count = 1;
 				args[0] = val;
-				args[1] = ptr;
+				args[1] = ptr; align_idx = 1;
 				args[2] = mask;
 				break;
 			}
 
 			res.value = lb_call_intrinsic(p, name, args, arg_count, types, type_count);
 			if (align_idx >= 0) {
+				// NOTE: The alignment is a call site attribute on the pointer parameter, where the
+				// parameter attribute indices start after the return value
 				LLVMAttributeRef align_attr = lb_create_enum_attribute(p->module->ctx, "align", alignment);
-				LLVMAddAttributeAtIndex(res.value, align_idx, align_attr);
+				LLVMAddCallSiteAttribute(res.value, cast(LLVMAttributeIndex)(1 + align_idx), align_attr);
 			}
 			return res;
 
@@ -4788,6 +5004,60 @@ gb_internal void lb_add_values_to_array(lbProcedure *p, Array<lbValue> *args, lb
 	}
 }
 
+// NOTE: A call to one of the runtime's allocation procedures (see `lb_init_allocation_sites`) is preceded by
+// a call to `runtime.allocation_site_hook` when it is set, the identifier of the site is a hash of its location
+// so that it is the same for every instantiation or inlined copy of it, and stable between builds
+gb_internal void lb_emit_allocation_site_hook(lbProcedure *p, Ast *expr, Entity *proc_entity) {
+	lbGenerator *gen = p->module->gen;
+	if (proc_entity == nullptr || proc_entity->kind != Entity_Procedure || gen->allocation_site_hook == nullptr) {
+		return;
+	}
+	if (p->entity != nullptr) {
+		// NOTE: the runtime's own allocations are not attributed to the user's code
+		if (p->entity->pkg != nullptr && p->entity->pkg->kind == Package_Runtime) {
+			return;
+		}
+		if (p->entity->kind == Entity_Procedure && !p->entity->Procedure.has_instrumentation) {
+			return;
+		}
+	}
+
+	DeclInfo *decl = proc_entity->decl_info;
+	if (decl != nullptr && decl->para_poly_original != nullptr) {
+		proc_entity = decl->para_poly_original;
+	}
+	lbAllocationSiteKind *kind = map_get(&gen->allocation_site_procs, proc_entity);
+	if (kind == nullptr) {
+		return;
+	}
+
+	String procedure = p->entity ? p->entity->token.string : String{};
+	TokenPos pos = ast_token(expr).pos;
+	lbSourceCodeLocationFields loc = lb_source_code_location_fields(procedure, pos);
+	u64 id = xxh64(loc.file.text, loc.file.len, cast(u64)*kind);
+	id = xxh64(loc.procedure.text, loc.procedure.len, id);
+	i32 line_column[2] = {loc.line, loc.column};
+	id = xxh64(line_column, gb_size_of(line_column), id);
+	mpsc_enqueue(&gen->allocation_sites, lbAllocationSite{id, *kind, procedure, pos});
+
+	lbValue hook = lb_emit_load(p, lb_find_value_from_entity(p->module, gen->allocation_site_hook));
+	lbBlock *call_block = lb_create_block(p, "alloc_site.hook");
+	lbBlock *done_block = lb_create_block(p, "alloc_site.done");
+	lb_emit_if(p, lb_emit_comp_against_nil(p, Token_NotEq, hook), call_block, done_block);
+
+	lb_start_block(p, call_block);
+	Type *hook_type = base_type(hook.type);
+	GB_ASSERT(hook_type->kind == Type_Proc && hook_type->Proc.param_count == 3);
+	auto args = array_make<lbValue>(temporary_allocator(), 3);
+	args[0] = lb_const_int(p->module, t_u64, id);
+	args[1] = lb_const_int(p->module, hook_type->Proc.params->Tuple.variables[1]->type, *kind);
+	args[2] = lb_emit_source_code_location_as_global_ptr(p, procedure, pos);
+	lb_emit_call(p, hook, args);
+	lb_emit_jump(p, done_block);
+
+	lb_start_block(p, done_block);
+}
+
 gb_internal lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr, lbValue *sret_dst) {
 	lbModule *m = p->module;
 
@@ -4830,6 +5100,10 @@ gb_internal lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr, lbVal
 		}
 	}
 
+	if (build_context.instrument_allocations) {
+		lb_emit_allocation_site_hook(p, expr, proc_entity);
+	}
+
 	if (proc_expr->tav.mode == Addressing_Constant) {
 		ExactValue v = proc_expr->tav.value;
 		switch (v.kind) {
@@ -4869,7 +5143,7 @@ gb_internal lbValue lb_build_call_expr_internal(lbProcedure *p, Ast *expr, lbVal
 
 	GB_ASSERT(ce->split_args != nullptr);
 
-	auto args = array_make<lbValue>(permanent_allocator(), 0, pt->param_count);
+	auto args = array_make<lbValue>(lb_scratch_allocator(p), 0, pt->param_count);
 
 	bool vari_expand = (ce->ellipsis.pos.line != 0);
 	bool is_c_vararg = pt->c_vararg;
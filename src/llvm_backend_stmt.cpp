@@ -1,6 +1,8 @@
 #define LB_ENABLE_BASIC_RVO    true
 #define LB_ENABLE_ADVANCED_RVO build_context.enable_rvo
 
+#define LB_RETURN_DEFER_INLINE_LIMIT 8
+
 // NOTE(bill): @RVO Check if a call expression returns by sret with a return type matching dst_type.
 // Returns the callee's function type if eligible for copy elision, nullptr otherwise.
 gb_internal lbFunctionType *lb_call_sret_eligible(lbProcedure *p, Ast *call_expr, Type *dst_type) {
@@ -123,6 +125,186 @@ done_scanning:
 	}
 }
 
+// NOTE: Conservative check for whether `node` may refer to `e`. Unknown node kinds are
+// assumed to mention it. Nested procedure literals cannot capture locals so they are skipped.
+gb_internal bool lb_expr_mentions_entity(Ast *node, Entity *e) {
+	if (node == nullptr) {
+		return false;
+	}
+	if (is_ast_type(node)) {
+		return false;
+	}
+	switch (node->kind) {
+	case Ast_Ident:
+		return entity_of_node(node) == e;
+	case Ast_Implicit:
+	case Ast_Uninit:
+	case Ast_BasicLit:
+	case Ast_BasicDirective:
+	case Ast_ProcLit:
+	case Ast_ImplicitSelectorExpr:
+		return false;
+	case Ast_Ellipsis:      return lb_expr_mentions_entity(node->Ellipsis.expr, e);
+	case Ast_TagExpr:       return lb_expr_mentions_entity(node->TagExpr.expr, e);
+	case Ast_UnaryExpr:     return lb_expr_mentions_entity(node->UnaryExpr.expr, e);
+	case Ast_ParenExpr:     return lb_expr_mentions_entity(node->ParenExpr.expr, e);
+	case Ast_SelectorExpr:  return lb_expr_mentions_entity(node->SelectorExpr.expr, e);
+	case Ast_DerefExpr:     return lb_expr_mentions_entity(node->DerefExpr.expr, e);
+	case Ast_OrReturnExpr:  return lb_expr_mentions_entity(node->OrReturnExpr.expr, e);
+	case Ast_OrBranchExpr:  return lb_expr_mentions_entity(node->OrBranchExpr.expr, e);
+	case Ast_TypeAssertion: return lb_expr_mentions_entity(node->TypeAssertion.expr, e);
+	case Ast_TypeCast:      return lb_expr_mentions_entity(node->TypeCast.expr, e);
+	case Ast_AutoCast:      return lb_expr_mentions_entity(node->AutoCast.expr, e);
+	case Ast_FieldValue:    return lb_expr_mentions_entity(node->FieldValue.value, e);
+	case Ast_BinaryExpr:
+		return lb_expr_mentions_entity(node->BinaryExpr.left, e) ||
+		       lb_expr_mentions_entity(node->BinaryExpr.right, e);
+	case Ast_SelectorCallExpr:
+		return lb_expr_mentions_entity(node->SelectorCallExpr.expr, e) ||
+		       lb_expr_mentions_entity(node->SelectorCallExpr.call, e);
+	case Ast_IndexExpr:
+		return lb_expr_mentions_entity(node->IndexExpr.expr, e) ||
+		       lb_expr_mentions_entity(node->IndexExpr.index, e);
+	case Ast_MatrixIndexExpr:
+		return lb_expr_mentions_entity(node->MatrixIndexExpr.expr, e) ||
+		       lb_expr_mentions_entity(node->MatrixIndexExpr.row_index, e) ||
+		       lb_expr_mentions_entity(node->MatrixIndexExpr.column_index, e);
+	case Ast_SliceExpr:
+		return lb_expr_mentions_entity(node->SliceExpr.expr, e) ||
+		       lb_expr_mentions_entity(node->SliceExpr.low, e) ||
+		       lb_expr_mentions_entity(node->SliceExpr.high, e);
+	case Ast_TernaryIfExpr:
+		return lb_expr_mentions_entity(node->TernaryIfExpr.x, e) ||
+		       lb_expr_mentions_entity(node->TernaryIfExpr.cond, e) ||
+		       lb_expr_mentions_entity(node->TernaryIfExpr.y, e);
+	case Ast_TernaryWhenExpr:
+		return lb_expr_mentions_entity(node->TernaryWhenExpr.x, e) ||
+		       lb_expr_mentions_entity(node->TernaryWhenExpr.cond, e) ||
+		       lb_expr_mentions_entity(node->TernaryWhenExpr.y, e);
+	case Ast_OrElseExpr:
+		return lb_expr_mentions_entity(node->OrElseExpr.x, e) ||
+		       lb_expr_mentions_entity(node->OrElseExpr.y, e);
+	case Ast_CompoundLit:
+		for (Ast *elem : node->CompoundLit.elems) {
+			if (lb_expr_mentions_entity(elem, e)) {
+				return true;
+			}
+		}
+		return false;
+	case Ast_CallExpr:
+		if (lb_expr_mentions_entity(node->CallExpr.proc, e)) {
+			return true;
+		}
+		for (Ast *arg : node->CallExpr.args) {
+			if (lb_expr_mentions_entity(arg, e)) {
+				return true;
+			}
+		}
+		return false;
+	}
+	return true;
+}
+
+// NOTE: Scan for `x: T` followed by straight-line statements which assign the whole of `x`
+// before anything could read it or take its address, e.g. `x: T; n := f(); x = g(n)`.
+// Such locals do not need to be zeroed in `lb_add_local`. This is purely a frontend analysis;
+// any statement which could branch, or any use of `x` other than as the plain left-hand side
+// of a full `=` assignment, ends the scan conservatively.
+gb_internal bool lb_local_is_written_before_read(Slice<Ast *> const &stmts, isize decl_index, Entity *e) {
+	if (e->flags & EntityFlag_Using) {
+		return false;
+	}
+	for (isize i = decl_index+1; i < stmts.count; i++) {
+		Ast *stmt = stmts[i];
+		switch (stmt->kind) {
+		case Ast_EmptyStmt:
+			continue;
+		case Ast_ExprStmt:
+			if (lb_expr_mentions_entity(stmt->ExprStmt.expr, e)) {
+				return false;
+			}
+			continue;
+		case Ast_ValueDecl: {
+			AstValueDecl *vd = &stmt->ValueDecl;
+			if (!vd->is_mutable) {
+				continue;
+			}
+			for (Ast *value : vd->values) {
+				if (lb_expr_mentions_entity(value, e)) {
+					return false;
+				}
+			}
+			continue;
+		}
+		case Ast_AssignStmt: {
+			AstAssignStmt *as = &stmt->AssignStmt;
+			for (Ast *rhs : as->rhs) {
+				if (lb_expr_mentions_entity(rhs, e)) {
+					return false;
+				}
+			}
+			isize written_index = -1;
+			for_array(j, as->lhs) {
+				Ast *lhs = unparen_expr(as->lhs[j]);
+				if (lhs->kind == Ast_Ident && entity_of_node(lhs) == e) {
+					if (written_index >= 0) {
+						return false;
+					}
+					written_index = j;
+				} else if (lb_expr_mentions_entity(lhs, e)) {
+					return false;
+				}
+			}
+			if (written_index < 0) {
+				continue;
+			}
+			if (as->op.kind != Token_Eq) {
+				return false;
+			}
+
+			// NOTE: The stored value must be of the exact same type, otherwise the store
+			// may only write part of the memory (e.g. a variant into a union)
+			Type *value_type = nullptr;
+			if (as->rhs.count == as->lhs.count) {
+				value_type = type_of_expr(as->rhs[written_index]);
+			} else if (as->rhs.count == 1) {
+				Type *tuple = type_of_expr(as->rhs[0]);
+				if (tuple != nullptr && tuple->kind == Type_Tuple && written_index < tuple->Tuple.variables.count) {
+					value_type = tuple->Tuple.variables[written_index]->type;
+				}
+			}
+			return value_type != nullptr && are_types_identical(value_type, e->type);
+		}
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+gb_internal void lb_scan_for_locals_written_before_read(lbProcedure *p, Slice<Ast *> const &stmts) {
+	for_array(i, stmts) {
+		Ast *stmt = stmts[i];
+		if (stmt->kind != Ast_ValueDecl) {
+			continue;
+		}
+		AstValueDecl *vd = &stmt->ValueDecl;
+		if (!vd->is_mutable || vd->values.count != 0) {
+			continue;
+		}
+		for (Ast *name : vd->names) {
+			if (is_blank_ident(name)) {
+				continue;
+			}
+			Entity *e = entity_of_node(name);
+			if (e != nullptr && e->kind == Entity_Variable && (e->flags & EntityFlag_Static) == 0 &&
+			    lb_local_is_written_before_read(stmts, i, e)) {
+				ptr_set_add(&p->locals_written_before_read, e);
+			}
+		}
+	}
+}
+
 gb_internal void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 	if (vd == nullptr || vd->is_mutable) {
 		return;
@@ -237,6 +419,7 @@ gb_internal void lb_build_stmt_list(lbProcedure *p, Slice<Ast *> const &stmts) {
 		case_end;
 		}
 	}
+	lb_scan_for_locals_written_before_read(p, stmts);
 	for (Ast *stmt : stmts) {
 		lb_build_stmt(p, stmt);
 	}
@@ -375,9 +558,28 @@ gb_internal void lb_build_when_stmt(lbProcedure *p, AstWhenStmt *ws) {
 
 
 
+// NOTE: `elems` points to the first element; the address is computed without `inbounds` since
+// it may be past the end of the data, which is fine as a prefetch never faults
+gb_internal void lb_emit_range_prefetch(lbProcedure *p, lbValue elems, Type *elem_type, lbValue idx, i64 distance, bool is_reverse) {
+	lbModule *m = p->module;
+	lbValue offset = lb_emit_arith(p, is_reverse ? Token_Sub : Token_Add, idx, lb_const_int(m, t_int, distance), t_int);
+
+	LLVMValueRef indices[1] = {offset.value};
+	LLVMValueRef ptr = LLVMBuildGEP2(p->builder, lb_type(m, elem_type), elems.value, indices, 1, "");
+
+	LLVMTypeRef types[1] = {lb_type(m, t_rawptr)};
+	LLVMTypeRef llvm_i32 = lb_type(m, t_i32);
+	LLVMValueRef args[4] = {};
+	args[0] = ptr;
+	args[1] = LLVMConstInt(llvm_i32, 0, false); // read
+	args[2] = LLVMConstInt(llvm_i32, 3, false); // keep in all cache levels
+	args[3] = LLVMConstInt(llvm_i32, 1, false); // data cache
+	lb_call_intrinsic(p, "llvm.prefetch", args, gb_count_of(args), types, gb_count_of(types));
+}
+
 gb_internal void lb_build_range_indexed(lbProcedure *p, lbValue expr, Type *val_type, lbValue count_ptr,
                                         lbValue *val_, lbValue *idx_, lbBlock **loop_, lbBlock **done_,
-                                        bool is_reverse, i64 unroll_count=0) {
+                                        bool is_reverse, i64 unroll_count=0, i64 prefetch_distance=0) {
 	lbModule *m = p->module;
 
 	lbValue count = {};
@@ -469,6 +671,35 @@ gb_internal void lb_build_range_indexed(lbProcedure *p, lbValue expr, Type *val_
 	lb_start_block(p, body);
 
 	idx = lb_addr_load(p, index);
+	if (prefetch_distance > 0) {
+		lbValue elems = {};
+		Type *elem_type = nullptr;
+		switch (expr_type->kind) {
+		case Type_Array:
+			elem_type = expr_type->Array.elem;
+			elems = lb_emit_conv(p, expr, alloc_type_pointer(elem_type));
+			break;
+		case Type_EnumeratedArray:
+			elem_type = expr_type->EnumeratedArray.elem;
+			elems = lb_emit_conv(p, expr, alloc_type_pointer(elem_type));
+			break;
+		case Type_FixedCapacityDynamicArray:
+			elem_type = expr_type->FixedCapacityDynamicArray.elem;
+			elems = lb_emit_conv(p, lb_emit_struct_ep(p, expr, 0), alloc_type_pointer(elem_type));
+			break;
+		case Type_Slice:
+			elem_type = expr_type->Slice.elem;
+			elems = lb_slice_elem(p, expr);
+			break;
+		case Type_DynamicArray:
+			elem_type = expr_type->DynamicArray.elem;
+			elems = lb_emit_load(p, lb_emit_struct_ep(p, expr, 0));
+			break;
+		}
+		if (elem_type != nullptr) {
+			lb_emit_range_prefetch(p, elems, elem_type, idx, prefetch_distance, is_reverse);
+		}
+	}
 	switch (expr_type->kind) {
 	case Type_Array: {
 		if (val_type != nullptr) {
@@ -595,6 +826,17 @@ gb_internal void lb_build_range_map(lbProcedure *p, lbValue expr, Type *val_type
 	lbAddr index = lb_add_local_generated(p, t_int, false);
 	lb_addr_store(p, index, lb_const_int(m, t_int, cast(u64)-1));
 
+	// NOTE: Whilst the map is at least a quarter full, the loop itself just checks the next cell. Below
+	// that, the runtime finds the next occupied cell several cells at a time, so that iterating a sparse
+	// map (e.g. one with a high capacity after many deletions) is not bound by its capacity. This is
+	// decided once, before the loop, so that the loop can be unswitched on it.
+	lbValue is_sparse = {};
+	{
+		lbValue map_value = lb_emit_load(p, expr);
+		lbValue quarter_cap = lb_emit_arith(p, Token_Shr, lb_map_cap(p, map_value), lb_const_int(m, t_int, 2), t_int);
+		is_sparse = lb_emit_comp(p, Token_Lt, lb_map_len(p, map_value), quarter_cap);
+	}
+
 	loop = lb_create_block(p, "for.index.loop");
 	lb_emit_jump(p, loop);
 	lb_start_block(p, loop);
@@ -622,8 +864,26 @@ gb_internal void lb_build_range_map(lbProcedure *p, lbValue expr, Type *val_type
 	// since it will always be packed without padding into the cells
 	lbValue hash = lb_emit_load(p, lb_emit_ptr_offset(p, hs, idx));
 
+	lbBlock *skip = lb_create_block(p, "for.index.skip");
 	lbValue hash_cond = lb_map_hash_is_valid(p, hash);
-	lb_emit_if(p, hash_cond, body, loop);
+	lb_emit_if(p, hash_cond, body, skip);
+
+	lb_start_block(p, skip);
+	{
+		lbBlock *skip_scan = lb_create_block(p, "for.index.skip_scan");
+
+		lb_emit_if(p, is_sparse, skip_scan, loop);
+
+		lb_start_block(p, skip_scan);
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 3);
+		args[0] = lb_emit_conv(p, hs, t_rawptr);
+		args[1] = lb_emit_arith(p, Token_Add, idx, lb_const_int(m, t_int, 1), t_int);
+		args[2] = capacity;
+		lbValue next = lb_emit_runtime_call(p, "map_next_valid_hash", args);
+		lb_addr_store(p, index, lb_emit_arith(p, Token_Sub, next, lb_const_int(m, t_int, 1), t_int));
+		lb_emit_jump(p, loop);
+	}
+
 	lb_start_block(p, body);
 
 
@@ -640,6 +900,58 @@ gb_internal void lb_build_range_map(lbProcedure *p, lbValue expr, Type *val_type
 
 
 
+// NOTE: Decodes the rune at the start of `str` (or at the end when reversed), with an inline fast path
+// for a single code unit rune (ASCII for UTF-8, a non-surrogate for UTF-16) so that the common case
+// needs neither the runtime call nor its string argument
+gb_internal void lb_emit_range_string_decode(lbProcedure *p, lbValue str_elem, lbValue str_len, lbValue unit_ptr,
+                                             bool is_string16, bool is_reverse, lbValue *rune_, lbValue *len_) {
+	lbModule *m = p->module;
+
+	lbAddr rune_addr = lb_add_local_generated(p, t_rune, false);
+	lbAddr len_addr  = lb_add_local_generated(p, t_int, false);
+
+	lbBlock *fast = lb_create_block(p, "for.string.fast");
+	lbBlock *slow = lb_create_block(p, "for.string.slow");
+	lbBlock *done = lb_create_block(p, "for.string.decoded");
+
+	lbValue unit = lb_emit_load(p, unit_ptr);
+	lbValue cond = {};
+	if (is_string16) {
+		// unit < 0xd800 || unit >= 0xe000
+		lbValue x = lb_emit_arith(p, Token_Sub, unit, lb_const_int(m, t_u16, 0xd800), t_u16);
+		cond = lb_emit_comp(p, Token_GtEq, x, lb_const_int(m, t_u16, 0x800));
+	} else {
+		cond = lb_emit_comp(p, Token_Lt, unit, lb_const_int(m, t_u8, 0x80));
+	}
+	lb_emit_if(p, cond, fast, slow);
+
+	lb_start_block(p, fast);
+	lb_addr_store(p, rune_addr, lb_emit_conv(p, unit, t_rune));
+	lb_addr_store(p, len_addr, lb_const_int(m, t_int, 1));
+	lb_emit_jump(p, done);
+
+	lb_start_block(p, slow);
+	{
+		char const *decoder = nullptr;
+		auto args = array_make<lbValue>(lb_scratch_allocator(p), 1);
+		if (is_string16) {
+			decoder = is_reverse ? "string16_decode_last_rune" : "string16_decode_rune";
+			args[0] = lb_emit_string16(p, str_elem, str_len);
+		} else {
+			decoder = is_reverse ? "string_decode_last_rune" : "string_decode_rune";
+			args[0] = lb_emit_string(p, str_elem, str_len);
+		}
+		lbValue rune_and_len = lb_emit_runtime_call(p, decoder, args);
+		lb_addr_store(p, rune_addr, lb_emit_struct_ev(p, rune_and_len, 0));
+		lb_addr_store(p, len_addr, lb_emit_struct_ev(p, rune_and_len, 1));
+	}
+	lb_emit_jump(p, done);
+
+	lb_start_block(p, done);
+	*rune_ = lb_addr_load(p, rune_addr);
+	*len_  = lb_addr_load(p, len_addr);
+}
+
 gb_internal void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_type,
                                        lbValue *val_, lbValue *idx_, lbBlock **loop_, lbBlock **done_,
                                        bool is_reverse) {
@@ -716,15 +1028,13 @@ gb_internal void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_t
 	lb_start_block(p, body);
 
 
-	lbValue rune_and_len = {};
+	lbValue rune = {};
+	lbValue len  = {};
 	if (!is_reverse) {
 		lbValue str_elem = lb_emit_ptr_offset(p, lb_string_elem(p, expr), offset);
 		lbValue str_len  = lb_emit_arith(p, Token_Sub, count, offset, t_int);
-		auto args = array_make<lbValue>(permanent_allocator(), 1);
-		args[0] = lb_emit_string(p, str_elem, str_len);
 
-		rune_and_len = lb_emit_runtime_call(p, "string_decode_rune", args);
-		lbValue len  = lb_emit_struct_ev(p, rune_and_len, 1);
+		lb_emit_range_string_decode(p, str_elem, str_len, str_elem, false, false, &rune, &len);
 		lb_addr_store(p, offset_, lb_emit_arith(p, Token_Add, offset, len, t_int));
 
 		idx = offset;
@@ -732,11 +1042,9 @@ gb_internal void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_t
 		// NOTE(bill): REVERSED LOGIC
 		lbValue str_elem = lb_string_elem(p, expr);
 		lbValue str_len  = offset;
-		auto args = array_make<lbValue>(permanent_allocator(), 1);
-		args[0] = lb_emit_string(p, str_elem, str_len);
+		lbValue last     = lb_emit_ptr_offset(p, str_elem, lb_emit_arith(p, Token_Sub, offset, lb_const_int(m, t_int, 1), t_int));
 
-		rune_and_len = lb_emit_runtime_call(p, "string_decode_last_rune", args);
-		lbValue len  = lb_emit_struct_ev(p, rune_and_len, 1);
+		lb_emit_range_string_decode(p, str_elem, str_len, last, false, true, &rune, &len);
 		lb_addr_store(p, offset_, lb_emit_arith(p, Token_Sub, offset, len, t_int));
 
 		idx = lb_addr_load(p, offset_);
@@ -744,7 +1052,7 @@ gb_internal void lb_build_range_string(lbProcedure *p, lbValue expr, Type *val_t
 
 
 	if (val_type != nullptr) {
-		val = lb_emit_struct_ev(p, rune_and_len, 0);
+		val = rune;
 	}
 
 	if (val_)  *val_  = val;
@@ -830,15 +1138,13 @@ gb_internal void lb_build_range_string16(lbProcedure *p, lbValue expr, Type *val
 	lb_start_block(p, body);
 
 
-	lbValue rune_and_len = {};
+	lbValue rune = {};
+	lbValue len  = {};
 	if (!is_reverse) {
 		lbValue str_elem = lb_emit_ptr_offset(p, lb_string_elem(p, expr), offset);
 		lbValue str_len  = lb_emit_arith(p, Token_Sub, count, offset, t_int);
-		auto args = array_make<lbValue>(permanent_allocator(), 1);
-		args[0] = lb_emit_string16(p, str_elem, str_len);
 
-		rune_and_len = lb_emit_runtime_call(p, "string16_decode_rune", args);
-		lbValue len  = lb_emit_struct_ev(p, rune_and_len, 1);
+		lb_emit_range_string_decode(p, str_elem, str_len, str_elem, true, false, &rune, &len);
 		lb_addr_store(p, offset_, lb_emit_arith(p, Token_Add, offset, len, t_int));
 
 		idx = offset;
@@ -846,11 +1152,9 @@ gb_internal void lb_build_range_string16(lbProcedure *p, lbValue expr, Type *val
 		// NOTE(bill): REVERSED LOGIC
 		lbValue str_elem = lb_string_elem(p, expr);
 		lbValue str_len  = offset;
-		auto args = array_make<lbValue>(permanent_allocator(), 1);
-		args[0] = lb_emit_string16(p, str_elem, str_len);
+		lbValue last     = lb_emit_ptr_offset(p, str_elem, lb_emit_arith(p, Token_Sub, offset, lb_const_int(m, t_int, 1), t_int));
 
-		rune_and_len = lb_emit_runtime_call(p, "string16_decode_last_rune", args);
-		lbValue len  = lb_emit_struct_ev(p, rune_and_len, 1);
+		lb_emit_range_string_decode(p, str_elem, str_len, last, true, true, &rune, &len);
 		lb_addr_store(p, offset_, lb_emit_arith(p, Token_Sub, offset, len, t_int));
 
 		idx = lb_addr_load(p, offset_);
@@ -858,7 +1162,7 @@ gb_internal void lb_build_range_string16(lbProcedure *p, lbValue expr, Type *val
 
 
 	if (val_type != nullptr) {
-		val = lb_emit_struct_ev(p, rune_and_len, 0);
+		val = rune;
 	}
 
 	if (val_)  *val_  = val;
@@ -881,6 +1185,87 @@ gb_internal Ast *lb_strip_and_prefix(Ast *ident) {
 
 
 
+// NOTE: Range facts let the indexing in the common loop shapes skip the bounds check at codegen time,
+// rather than leaving it for LLVM to maybe remove:
+//
+//     for v, i in x      { x[i] }
+//     for i in 0..<len(x) { x[i] }
+//
+// This is only sound while neither the index nor the length of `x` can change within the loop. Loop
+// variables (without `&`) and procedure parameters cannot be assigned to (or have their address taken),
+// and the length of a fixed array is part of its type, so only those are considered.
+gb_internal bool lb_push_range_fact(lbProcedure *p, Ast *index_val, Ast *array_expr) {
+	if (lb_bounds_check_disabled(p)) {
+		return false;
+	}
+	if (index_val == nullptr || index_val->kind != Ast_Ident || is_blank_ident(index_val)) {
+		return false;
+	}
+	array_expr = unparen_expr(array_expr);
+	if (array_expr == nullptr || array_expr->kind != Ast_Ident) {
+		return false;
+	}
+
+	Entity *index = entity_of_node(index_val);
+	Entity *array = entity_of_node(array_expr);
+	if (index == nullptr || index->kind != Entity_Variable || (index->flags & EntityFlag_Value) == 0) {
+		return false;
+	}
+	if (array == nullptr || array->kind != Entity_Variable || (array->flags & EntityFlag_Using) != 0) {
+		return false;
+	}
+
+	Type *t = base_type(array->type);
+	bool is_immutable = false;
+	switch (t->kind) {
+	case Type_Array:
+		is_immutable = true;
+		break;
+	case Type_Slice:
+	case Type_DynamicArray:
+		is_immutable = (array->flags & EntityFlag_Param) != 0;
+		break;
+	case Type_Basic:
+		is_immutable = (array->flags & EntityFlag_Param) != 0 && t->Basic.kind == Basic_string;
+		break;
+	}
+	if (!is_immutable) {
+		return false;
+	}
+
+	array_add(&p->range_facts, lbRangeFact{index, array});
+	return true;
+}
+
+gb_internal void lb_pop_range_fact(lbProcedure *p, bool pushed) {
+	if (pushed) {
+		array_pop(&p->range_facts);
+	}
+}
+
+// NOTE: `for i in lo..<len(x)` where `lo` is a non-negative constant
+gb_internal bool lb_push_range_fact_for_interval(lbProcedure *p, AstBinaryExpr *node, Ast *val0) {
+	if (node->op.kind != Token_RangeHalf) {
+		return false;
+	}
+	TypeAndValue lower = type_and_value_of_expr(node->left);
+	if (lower.mode != Addressing_Constant ||
+	    lower.value.kind != ExactValue_Integer ||
+	    big_int_is_neg(&lower.value.value_integer)) {
+		return false;
+	}
+
+	Ast *upper = unparen_expr(node->right);
+	if (upper == nullptr || upper->kind != Ast_CallExpr || upper->CallExpr.args.count != 1) {
+		return false;
+	}
+	Entity *proc = entity_of_node(unparen_expr(upper->CallExpr.proc));
+	if (proc == nullptr || proc->kind != Entity_Builtin || proc->Builtin.id != BuiltinProc_len) {
+		return false;
+	}
+	return lb_push_range_fact(p, val0, upper->CallExpr.args[0]);
+}
+
 gb_internal void lb_build_range_interval(lbProcedure *p, AstBinaryExpr *node,
                                          AstRangeStmt *rs, Scope *scope) {
 	bool ADD_EXTRA_WRAPPING_CHECK = true;
@@ -979,7 +1364,9 @@ gb_internal void lb_build_range_interval(lbProcedure *p, AstBinaryExpr *node,
 
 		lb_push_target_list(p, rs->label, done, continue_block, nullptr);
 
+		bool pushed_range_fact = val0_type != nullptr && lb_push_range_fact_for_interval(p, node, val0);
 		lb_build_stmt(p, rs->body);
+		lb_pop_range_fact(p, pushed_range_fact);
 
 		lb_close_scope(p, lbDeferExit_Default, nullptr, node->left);
 		lb_pop_target_list(p);
@@ -1081,7 +1468,7 @@ gb_internal void lb_build_range_tuple(lbProcedure *p, AstRangeStmt *rs, Scope *s
 
 	i32 value_count = cast(i32)et->Tuple.variables.count;
 
-	lbValue *values = gb_alloc_array(permanent_allocator(), lbValue, value_count);
+	lbValue *values = gb_alloc_array(lb_scratch_allocator(p), lbValue, value_count);
 
 	lb_open_scope(p, scope);
 
@@ -1163,6 +1550,17 @@ gb_internal void lb_build_range_stmt_struct_soa(lbProcedure *p, AstRangeStmt *rs
 	if (is_type_pointer(lb_addr_type(array))) {
 		array = lb_addr(lb_addr_load(p, array));
 	}
+	Type *soa_type = base_type(lb_addr_type(array));
+	GB_ASSERT(is_type_soa_struct(soa_type));
+	if (soa_type->Struct.soa_kind == StructSoa_Slice) {
+		// NOTE: The field pointers are read from a local copy of the #soa slice (which is evaluated
+		// once, just like a normal slice), so stores through them in the body cannot be assumed to
+		// modify the pointers themselves and they can be hoisted out of the loop, which is what allows
+		// the field accesses to be vectorized.
+		lbAddr snapshot = lb_add_local_generated(p, lb_addr_type(array), false);
+		lb_addr_store(p, snapshot, lb_addr_load(p, array));
+		array = snapshot;
+	}
 	lbValue count = lb_soa_struct_len(p, lb_addr_load(p, array));
 
 
@@ -1241,6 +1639,31 @@ gb_internal void lb_build_range_stmt_struct_soa(lbProcedure *p, AstRangeStmt *rs
 	}
 	lb_start_block(p, body);
 
+	if (rs->prefetch_distance > 0) {
+		lbValue idx = lb_addr_load(p, index);
+		isize field_count = soa_type->Struct.fields.count;
+		if (soa_type->Struct.soa_kind == StructSoa_Slice) {
+			field_count -= 1;
+		} else if (soa_type->Struct.soa_kind == StructSoa_Dynamic) {
+			field_count -= 3;
+		}
+		for (isize i = 0; i < field_count; i++) {
+			Type *field_type = base_type(soa_type->Struct.fields[i]->type);
+			lbValue field = lb_emit_struct_ep(p, array.addr, cast(i32)i);
+			Type *elem_type = nullptr;
+			if (field_type->kind == Type_Array) {
+				elem_type = field_type->Array.elem;
+				field = lb_emit_conv(p, field, alloc_type_pointer(elem_type));
+			} else {
+				GB_ASSERT(field_type->kind == Type_MultiPointer);
+				elem_type = field_type->MultiPointer.elem;
+				field = lb_emit_load(p, field);
+			}
+			if (type_size_of(elem_type) > 0) {
+				lb_emit_range_prefetch(p, field, elem_type, idx, rs->prefetch_distance, is_reverse);
+			}
+		}
+	}
 
 	if (val_types[0]) {
 		Entity *e = entity_of_node(val0);
@@ -1267,6 +1690,70 @@ gb_internal void lb_build_range_stmt_struct_soa(lbProcedure *p, AstRangeStmt *rs
 
 }
 
+// NOTE: A bit_set wider than a register (e.g. `bit_set[0..<128]`) is iterated one 64-bit word at a
+// time, so that each step is a single register wide `tzcnt` and clear of the lowest set bit rather
+// than the multi-word sequences which LLVM produces for the whole wide integer
+gb_internal void lb_build_range_wide_bit_set(lbProcedure *p, Type *et, Type *mask, lbValue initial_mask, bool is_reverse,
+                                             lbValue *val_, lbBlock **loop_, lbBlock **done_) {
+	lbModule *m = p->module;
+	Type *elem = et->BitSet.elem;
+	i64 word_count = type_size_of(mask)/8;
+	GB_ASSERT(type_size_of(mask) % 8 == 0);
+
+	lbAddr bits_addr  = lb_add_local_generated(p, mask,   false);
+	lbAddr word_index = lb_add_local_generated(p, t_int,  false);
+	lbAddr word_addr  = lb_add_local_generated(p, t_u64,  false);
+	lb_addr_store(p, bits_addr, initial_mask);
+	lb_addr_store(p, word_index, lb_const_int(m, t_int, 0));
+	lb_addr_store(p, word_addr, lb_emit_conv(p, initial_mask, t_u64));
+
+	lbBlock *loop      = lb_create_block(p, "for.bit_set.loop");
+	lbBlock *body      = lb_create_block(p, "for.bit_set.body");
+	lbBlock *next_word = lb_create_block(p, "for.bit_set.next_word");
+	lbBlock *load_word = lb_create_block(p, "for.bit_set.load_word");
+	lbBlock *done      = lb_create_block(p, "for.bit_set.done");
+
+	lb_emit_jump(p, loop);
+	lb_start_block(p, loop);
+	lbValue word = lb_addr_load(p, word_addr);
+	lb_emit_if(p, lb_emit_comp(p, Token_NotEq, word, lb_const_int(m, t_u64, 0)), body, next_word);
+
+	lb_start_block(p, next_word);
+	lbValue index = lb_emit_arith(p, Token_Add, lb_addr_load(p, word_index), lb_const_int(m, t_int, 1), t_int);
+	lb_addr_store(p, word_index, index);
+	lb_emit_if(p, lb_emit_comp(p, Token_Lt, index, lb_const_int(m, t_int, word_count)), load_word, done);
+
+	lb_start_block(p, load_word);
+	{
+		lbValue shift = lb_emit_conv(p, lb_emit_arith(p, Token_Mul, index, lb_const_int(m, t_int, 64), t_int), mask);
+		LLVMValueRef shifted = LLVMBuildLShr(p->builder, lb_addr_load(p, bits_addr).value, shift.value, "");
+		lbValue next = {LLVMBuildTrunc(p->builder, shifted, lb_type(m, t_u64), ""), t_u64};
+		lb_addr_store(p, word_addr, next);
+	}
+	lb_emit_jump(p, loop);
+
+	lb_start_block(p, body);
+	LLVMValueRef cttz_args[2] = {word.value, LLVMConstInt(LLVMInt1TypeInContext(m->ctx), 1, false)}; // the word is never zero here
+	LLVMTypeRef cttz_types[1] = {lb_type(m, t_u64)};
+	lbValue tz = {lb_call_intrinsic(p, "llvm.cttz", cttz_args, gb_count_of(cttz_args), cttz_types, gb_count_of(cttz_types)), t_u64};
+
+	lbValue bit = lb_emit_arith(p, Token_Mul, lb_addr_load(p, word_index), lb_const_int(m, t_int, 64), t_int);
+	bit = lb_emit_arith(p, Token_Add, bit, lb_emit_conv(p, tz, t_int), t_int);
+	lbValue val = lb_emit_conv(p, bit, elem);
+	if (is_reverse) {
+		val = lb_emit_arith(p, Token_Sub, lb_const_int(m, elem, et->BitSet.lower + 8*type_size_of(mask) - 1), val, elem);
+	} else {
+		val = lb_emit_arith(p, Token_Add, val, lb_const_int(m, elem, et->BitSet.lower), elem);
+	}
+
+	lbValue reduce_val = lb_emit_arith(p, Token_Sub, word, lb_const_int(m, t_u64, 1), t_u64);
+	lb_addr_store(p, word_addr, lb_emit_arith(p, Token_And, word, reduce_val, t_u64));
+
+	*val_  = val;
+	*loop_ = loop;
+	*done_ = done;
+}
+
 gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *scope) {
 	Ast *expr = unparen_expr(rs->expr);
 
@@ -1361,7 +1848,7 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 
 			lbAddr count_ptr = lb_add_local_generated(p, t_int, false);
 			lb_addr_store(p, count_ptr, lb_const_int(p->module, t_int, et->Array.count));
-			lb_build_range_indexed(p, array, val0_type, count_ptr.addr, &val, &key, &loop, &done, rs->reverse);
+			lb_build_range_indexed(p, array, val0_type, count_ptr.addr, &val, &key, &loop, &done, rs->reverse, 0, rs->prefetch_distance);
 			break;
 		}
 		case Type_EnumeratedArray: {
@@ -1371,7 +1858,7 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 			}
 			lbAddr count_ptr = lb_add_local_generated(p, t_int, false);
 			lb_addr_store(p, count_ptr, lb_const_int(p->module, t_int, et->EnumeratedArray.count));
-			lb_build_range_indexed(p, array, val0_type, count_ptr.addr, &val, &key, &loop, &done, rs->reverse);
+			lb_build_range_indexed(p, array, val0_type, count_ptr.addr, &val, &key, &loop, &done, rs->reverse, 0, rs->prefetch_distance);
 			break;
 		}
 		case Type_FixedCapacityDynamicArray: {
@@ -1380,7 +1867,7 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 				array = lb_emit_load(p, array);
 			}
 			lbValue count_ptr = lb_emit_struct_ep(p, array, 1);
-			lb_build_range_indexed(p, array, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse);
+			lb_build_range_indexed(p, array, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse, 0, rs->prefetch_distance);
 			break;
 		}
 		case Type_DynamicArray: {
@@ -1390,7 +1877,7 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 				array = lb_emit_load(p, array);
 			}
 			count_ptr = lb_emit_struct_ep(p, array, 1);
-			lb_build_range_indexed(p, array, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse);
+			lb_build_range_indexed(p, array, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse, 0, rs->prefetch_distance);
 			break;
 		}
 		case Type_Slice: {
@@ -1403,7 +1890,7 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 				count_ptr = lb_add_local_generated(p, t_int, false).addr;
 				lb_emit_store(p, count_ptr, lb_slice_len(p, slice));
 			}
-			lb_build_range_indexed(p, slice, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse);
+			lb_build_range_indexed(p, slice, val0_type, count_ptr, &val, &key, &loop, &done, rs->reverse, 0, rs->prefetch_distance);
 			break;
 		}
 		case Type_Basic: {
@@ -1446,6 +1933,11 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 				initial_mask = lb_emit_reverse_bits(p, initial_mask, mask);
 			}
 
+			if (type_size_of(mask) > 8) {
+				lb_build_range_wide_bit_set(p, et, mask, initial_mask, rs->reverse, &val, &loop, &done);
+				break;
+			}
+
 			lbAddr remaining = lb_add_local_generated(p, mask, false);
 			lb_addr_store(p, remaining, initial_mask);
 
@@ -1493,7 +1985,13 @@ gb_internal void lb_build_range_stmt(lbProcedure *p, AstRangeStmt *rs, Scope *sc
 
 	lb_push_target_list(p, rs->label, done, loop, nullptr);
 
+	bool pushed_range_fact = false;
+	if (!is_map && tav.mode != Addressing_Type && val1_type != nullptr) {
+		// NOTE: for v, i in x
+		pushed_range_fact = lb_push_range_fact(p, val1, expr);
+	}
 	lb_build_stmt(p, rs->body);
+	lb_pop_range_fact(p, pushed_range_fact);
 
 	lb_close_scope(p, lbDeferExit_Default, nullptr, rs->body);
 	lb_pop_target_list(p);
@@ -1819,10 +2317,39 @@ gb_internal void lb_build_unroll_range_stmt(lbProcedure *p, AstUnrollRangeStmt *
 	lb_close_scope(p, lbDeferExit_Default, nullptr, rs->body);
 }
 
+// NOTE: Constant integer ranges are expanded into individual cases up to this many values in total,
+// so that LLVM can lower them into a jump table or lookup table rather than a chain of comparisons
+gb_global i64 const LB_SWITCH_MAX_EXPANDED_RANGE_CASES = 512;
+
+gb_internal bool lb_switch_range_case_bounds(Ast *expr, i64 *lo_, i64 *count_) {
+	ast_node(ie, BinaryExpr, expr);
+	TypeAndValue lhs = type_and_value_of_expr(ie->left);
+	TypeAndValue rhs = type_and_value_of_expr(ie->right);
+	if (lhs.mode != Addressing_Constant || rhs.mode != Addressing_Constant) {
+		return false;
+	}
+	if (lhs.value.kind != ExactValue_Integer || rhs.value.kind != ExactValue_Integer) {
+		return false;
+	}
+	i64 lo = exact_value_to_i64(lhs.value);
+	i64 hi = exact_value_to_i64(rhs.value);
+	i64 count = hi - lo;
+	if (ie->op.kind != Token_RangeHalf) {
+		count += 1;
+	}
+	if (count <= 0 || count > LB_SWITCH_MAX_EXPANDED_RANGE_CASES) {
+		return false;
+	}
+	if (lo_)    *lo_    = lo;
+	if (count_) *count_ = count;
+	return true;
+}
+
 gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, bool *default_found_) {
 	if (ss->tag == nullptr) {
 		return false;
 	}
+	i64 expanded_range_cases = 0;
 	bool is_typeid = false;
 	TypeAndValue tv = type_and_value_of_expr(ss->tag);
 	if (is_type_integer(core_type(tv.type))) {
@@ -1834,6 +2361,12 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 		return false;
 	}
 
+	// NOTE: the checker only rejects duplicate single values, and only records the endpoints of a range,
+	// so overlapping ranges are allowed (the first case matching wins). Every value of the jump table must
+	// be distinct, so such a switch remains a comparison chain.
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto values = array_make<i64>(temporary_allocator(), 0, 16);
+
 	ast_node(body, BlockStmt, ss->body);
 	for (Ast *clause : body->stmts) {
 		ast_node(cc, CaseClause, clause);
@@ -1846,7 +2379,19 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 		for (Ast *expr : cc->list) {
 			expr = unparen_expr(expr);
 			if (is_ast_range(expr)) {
-				return false;
+				i64 lo = 0;
+				i64 count = 0;
+				if (is_typeid || !lb_switch_range_case_bounds(expr, &lo, &count)) {
+					return false;
+				}
+				expanded_range_cases += count;
+				if (expanded_range_cases > LB_SWITCH_MAX_EXPANDED_RANGE_CASES) {
+					return false;
+				}
+				for (i64 i = 0; i < count; i++) {
+					array_add(&values, lo + i);
+				}
+				continue;
 			}
 			if (expr->tav.mode == Addressing_Type) {
 				GB_ASSERT(is_typeid);
@@ -1859,6 +2404,7 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 			if (!is_type_integer(core_type(tv.type))) {
 				return false;
 			}
+			array_add(&values, exact_value_to_i64(tv.value));
 		}
 
 	}
@@ -1867,9 +2413,103 @@ gb_internal bool lb_switch_stmt_can_be_trivial_jump_table(AstSwitchStmt *ss, boo
 		return false;
 	}
 
+	if (expanded_range_cases > 0) {
+		gb_sort_array(values.data, values.count, gb_i64_cmp(0));
+		for (isize i = 1; i < values.count; i++) {
+			if (values[i-1] == values[i]) {
+				return false;
+			}
+		}
+	}
+
 	return true;
 }
 
+enum { LB_SWITCH_MIN_STRING_DISPATCH_CASES = 4 };
+
+gb_internal bool lb_switch_stmt_can_be_string_dispatch(AstSwitchStmt *ss) {
+	if (ss->tag == nullptr) {
+		return false;
+	}
+	Type *tag_type = type_and_value_of_expr(ss->tag).type;
+	if (!is_type_string(tag_type) || is_type_cstring(tag_type) || is_type_string16(tag_type)) {
+		return false;
+	}
+
+	isize case_count = 0;
+	ast_node(body, BlockStmt, ss->body);
+	for (Ast *clause : body->stmts) {
+		ast_node(cc, CaseClause, clause);
+		for (Ast *expr : cc->list) {
+			expr = unparen_expr(expr);
+			if (is_ast_range(expr)) {
+				return false;
+			}
+			TypeAndValue tv = type_and_value_of_expr(expr);
+			if (tv.mode != Addressing_Constant || tv.value.kind != ExactValue_String) {
+				return false;
+			}
+			case_count += 1;
+		}
+	}
+	return case_count >= LB_SWITCH_MIN_STRING_DISPATCH_CASES;
+}
+
+struct lbSwitchStringCase {
+	isize len;
+	isize clause_index;
+	Ast * expr;
+};
+
+// NOTE: Switches on the length first, then only compares against the cases of that length
+gb_internal LLVMValueRef lb_build_switch_string_dispatch(lbProcedure *p, AstSwitchStmt *ss, lbValue tag, Slice<lbBlock *> const &body_blocks, lbBlock *miss) {
+	ast_node(body, BlockStmt, ss->body);
+
+	auto cases = array_make<lbSwitchStringCase>(temporary_allocator(), 0, body->stmts.count);
+	for_array(i, body->stmts) {
+		ast_node(cc, CaseClause, body->stmts[i]);
+		for (Ast *expr : cc->list) {
+			expr = unparen_expr(expr);
+			String str = type_and_value_of_expr(expr).value.value_string;
+			array_add(&cases, lbSwitchStringCase{str.len, i, expr});
+		}
+	}
+
+	// NOTE: insertion sort keeps the cases of the same length in source order
+	for (isize i = 1; i < cases.count; i++) {
+		for (isize j = i; j > 0 && cases[j-1].len > cases[j].len; j--) {
+			gb_swap(lbSwitchStringCase, cases[j-1], cases[j]);
+		}
+	}
+
+	unsigned len_count = 0;
+	for_array(i, cases) {
+		if (i == 0 || cases[i].len != cases[i-1].len) {
+			len_count += 1;
+		}
+	}
+
+	lbValue len = lb_string_len(p, tag);
+	LLVMValueRef switch_instr = LLVMBuildSwitch(p->builder, len.value, miss->block, len_count);
+
+	for (isize i = 0; i < cases.count; /**/) {
+		isize curr_len = cases[i].len;
+		lbBlock *len_block = lb_create_block(p, "switch.string.len");
+		LLVMAddCase(switch_instr, lb_const_int(p->module, t_int, cast(u64)curr_len).value, len_block->block);
+		lb_start_block(p, len_block);
+
+		for (; i < cases.count && cases[i].len == curr_len; i++) {
+			lbBlock *next = lb_create_block(p, "switch.string.next");
+			lbValue cond = lb_emit_comp(p, Token_CmpEq, tag, lb_build_expr(p, cases[i].expr));
+			lb_emit_if(p, cond, body_blocks[cases[i].clause_index], next);
+			lb_start_block(p, next);
+		}
+		lb_emit_jump(p, miss);
+	}
+
+	return switch_instr;
+}
+
 
 gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *scope) {
 	lb_open_scope(p, scope);
@@ -1902,8 +2542,9 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 
 	bool default_found = false;
 	bool is_trivial = lb_switch_stmt_can_be_trivial_jump_table(ss, &default_found);
+	bool is_string_dispatch = !is_trivial && lb_switch_stmt_can_be_string_dispatch(ss);
 
-	auto body_blocks = slice_make<lbBlock *>(permanent_allocator(), body->stmts.count);
+	auto body_blocks = slice_make<lbBlock *>(lb_scratch_allocator(p), body->stmts.count);
 	for_array(i, body->stmts) {
 		Ast *clause = body->stmts[i];
 		ast_node(cc, CaseClause, clause);
@@ -1911,7 +2552,7 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		char const *block_name = cc->list.count == 0 ? "switch.default.body" : "switch.case.body";
 
 		if (is_trivial && cc->list.count >= 1) {
-			gbString bn = gb_string_make(heap_allocator(), "switch.case.");
+			gbString bn = gb_string_make(lb_scratch_allocator(p), "switch.case.");
 
 			Ast *first = cc->list[0];
 			if (first->tav.mode == Addressing_Type) {
@@ -1927,9 +2568,13 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 					bn = gb_string_appendc(bn, "..");
 				}
 
-				Ast *expr = cc->list[i];
+				Ast *expr = unparen_expr(cc->list[i]);
 				if (expr->tav.mode == Addressing_Type) {
 					bn = write_type_to_string(bn, expr->tav.type, false);
+				} else if (is_ast_range(expr)) {
+					bn = write_exact_value_to_string(bn, type_and_value_of_expr(expr->BinaryExpr.left).value, 1024);
+					bn = gb_string_append_length(bn, expr->BinaryExpr.op.string.text, expr->BinaryExpr.op.string.len);
+					bn = write_exact_value_to_string(bn, type_and_value_of_expr(expr->BinaryExpr.right).value, 1024);
 				} else {
 					ExactValue value = expr->tav.value;
 					if (is_type_rune(expr->tav.type) && value.kind == ExactValue_Integer) {
@@ -1958,7 +2603,13 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		isize num_cases = 0;
 		for (Ast *clause : body->stmts) {
 			ast_node(cc, CaseClause, clause);
-			num_cases += cc->list.count;
+			for (Ast *expr : cc->list) {
+				i64 count = 1;
+				if (is_ast_range(unparen_expr(expr))) {
+					lb_switch_range_case_bounds(unparen_expr(expr), nullptr, &count);
+				}
+				num_cases += cast(isize)count;
+			}
 		}
 
 		LLVMBasicBlockRef end_block = done->block;
@@ -1967,6 +2618,8 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 		}
 
 		switch_instr = LLVMBuildSwitch(p->builder, tag.value, end_block, cast(unsigned)num_cases);
+	} else if (is_string_dispatch) {
+		switch_instr = lb_build_switch_string_dispatch(p, ss, tag, body_blocks, default_block ? default_block : done);
 	}
 
 
@@ -2002,6 +2655,21 @@ gb_internal void lb_build_switch_stmt(lbProcedure *p, AstSwitchStmt *ss, Scope *
 			expr = unparen_expr(expr);
 
 			if (switch_instr != nullptr) {
+				if (is_string_dispatch) {
+					// NOTE: already dispatched by lb_build_switch_string_dispatch
+					continue;
+				}
+				if (is_ast_range(expr)) {
+					i64 lo = 0;
+					i64 count = 0;
+					bool ok = lb_switch_range_case_bounds(expr, &lo, &count);
+					GB_ASSERT(ok);
+					for (i64 j = 0; j < count; j++) {
+						LLVMAddCase(switch_instr, lb_const_int(p->module, tag.type, cast(u64)(lo + j)).value, body->block);
+					}
+					continue;
+				}
+
 				lbValue on_val = {};
 				if (expr->tav.mode == Addressing_Type) {
 					GB_ASSERT(is_type_typeid(tag.type));
@@ -2139,6 +2807,45 @@ gb_internal void lb_type_case_body(lbProcedure *p, Ast *label, Ast *clause, lbBl
 	lb_emit_jump(p, done);
 }
 
+enum {LB_TYPE_SWITCH_HASH_MIN_CASES = 8};
+
+struct lbTypeSwitchHash {
+	u32 shift;
+	u32 bits;
+};
+
+// NOTE: A typeid is a 64-bit hash of the type, so the cases of an `any` type switch are sparse and
+// a `switch` on them becomes a tree of comparisons. Instead, find a window of bits of the typeids
+// which is distinct for every case, switch on that densely, and then compare against the one
+// typeid which could be in that bucket.
+gb_internal bool lb_type_switch_find_hash(Slice<u64> const &ids, lbTypeSwitchHash *hash_) {
+	u32 min_bits = cast(u32)ceil_log2(cast(u32)ids.count);
+	u32 width = cast(u32)(8*type_size_of(t_typeid));
+
+	for (u32 bits = min_bits; bits <= gb_min(min_bits+3, 16u); bits++) {
+		TEMPORARY_ALLOCATOR_GUARD();
+		u64 mask = (1ull<<bits) - 1;
+		bool *seen = gb_alloc_array(temporary_allocator(), bool, 1ull<<bits);
+		for (u32 shift = 0; shift + bits <= width; shift++) {
+			gb_zero_size(seen, gb_size_of(bool) << bits);
+			bool ok = true;
+			for (u64 id : ids) {
+				u64 bucket = (id >> shift) & mask;
+				if (seen[bucket]) {
+					ok = false;
+					break;
+				}
+				seen[bucket] = true;
+			}
+			if (ok) {
+				*hash_ = {shift, bits};
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 gb_internal void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss) {
 	lbModule *m = p->module;
 	lb_open_scope(p, ss->scope);
@@ -2198,14 +2905,42 @@ gb_internal void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss
 	}
 
 
+	// NOTE: A union's tag is already dense, so LLVM lowers the `switch` on it to a jump table
+	bool use_typeid_hash = false;
+	lbTypeSwitchHash typeid_hash = {};
+	if (switch_kind == TypeSwitch_Any && num_cases >= LB_TYPE_SWITCH_HASH_MIN_CASES) {
+		auto ids = slice_make<u64>(temporary_allocator(), num_cases);
+		isize id_count = 0;
+		for (Ast *clause : body->stmts) {
+			ast_node(cc, CaseClause, clause);
+			for (Ast *type_expr : cc->list) {
+				Type *case_type = type_of_expr(type_expr);
+				ids[id_count++] = is_type_untyped_nil(case_type) ? 0 : type_hash_canonical_type(default_type(case_type));
+			}
+		}
+		GB_ASSERT(id_count == num_cases);
+		use_typeid_hash = lb_type_switch_find_hash(ids, &typeid_hash);
+	}
+
 	LLVMValueRef switch_instr = nullptr;
 	if (type_size_of(parent_base_type) == 0) {
 		GB_ASSERT(tag.value == nullptr);
 		switch_instr = LLVMBuildSwitch(p->builder, lb_const_bool(p->module, t_llvm_bool, false).value, else_block->block, cast(unsigned)num_cases);
+	} else if (use_typeid_hash) {
+		GB_ASSERT(tag.value != nullptr);
+		LLVMTypeRef tag_type = LLVMTypeOf(tag.value);
+		LLVMValueRef bucket = LLVMBuildLShr(p->builder, tag.value, LLVMConstInt(tag_type, typeid_hash.shift, false), "");
+		bucket = LLVMBuildAnd(p->builder, bucket, LLVMConstInt(tag_type, (1ull<<typeid_hash.bits) - 1, false), "");
+		switch_instr = LLVMBuildSwitch(p->builder, bucket, else_block->block, cast(unsigned)num_cases);
 	} else {
 		GB_ASSERT(tag.value != nullptr);
 		switch_instr = LLVMBuildSwitch(p->builder, tag.value, else_block->block, cast(unsigned)num_cases);
 	}
+	if (build_context.pgo_kind == PGO_Use && tag.value != nullptr) {
+		// NOTE: the most frequent cases are tested ahead of this switch once the profile is known,
+		// see `lb_peel_hot_type_switch_cases`
+		lb_set_metadata_custom_u64(m, switch_instr, str_lit(LB_TYPE_SWITCH_METADATA), 1);
+	}
 
 	bool all_by_reference = false;
 	for (Ast *clause : body->stmts) {
@@ -2276,7 +3011,7 @@ gb_internal void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss
 
 		if (!are_types_identical(case_entity->type, parent_base_type)) {
 			gbString canonical_name = temp_canonical_string(case_entity->type);
-			gbString bn = gb_string_make(heap_allocator(), "typeswitch.case.");
+			gbString bn = gb_string_make(lb_scratch_allocator(p), "typeswitch.case.");
 			bn = gb_string_append_length(bn, canonical_name, gb_string_length(canonical_name));
 			body_name = cast(char const *)bn;
 		}
@@ -2309,7 +3044,17 @@ gb_internal void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss
 				}
 			}
 			GB_ASSERT(on_val.value != nullptr);
-			LLVMAddCase(switch_instr, on_val.value, body->block);
+			if (use_typeid_hash) {
+				u64 id = LLVMConstIntGetZExtValue(on_val.value);
+				u64 bucket = (id >> typeid_hash.shift) & ((1ull<<typeid_hash.bits) - 1);
+
+				lbBlock *check = lb_create_block(p, "typeswitch.check");
+				LLVMAddCase(switch_instr, LLVMConstInt(LLVMTypeOf(tag.value), bucket, false), check->block);
+				lb_start_block(p, check);
+				lb_emit_if(p, lb_emit_comp(p, Token_CmpEq, tag, on_val), body, else_block);
+			} else {
+				LLVMAddCase(switch_instr, on_val.value, body->block);
+			}
 		}
 
 
@@ -2475,7 +3220,7 @@ gb_internal void lb_build_assignment(lbProcedure *p, Array<lbAddr> &lvals, Slice
 		return;
 	}
 
-	auto inits = array_make<lbValue>(permanent_allocator(), 0, lvals.count);
+	auto inits = array_make<lbValue>(lb_scratch_allocator(p), 0, lvals.count);
 
 	for (Ast *rhs : values) {
 		lbValue init = lb_build_expr(p, rhs);
@@ -2526,13 +3271,7 @@ gb_internal void lb_build_return_stmt_internal(lbProcedure *p, lbValue res, Toke
 			LLVMBuildStore(p->builder, LLVMConstNull(p->abi_function_type->ret.type), p->return_ptr.addr.value);
 		}
 
-		lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-
-		// Check for terminator in the defer stmts
-		LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
-		if (!lb_is_instr_terminating(instr)) {
-			LLVMBuildRetVoid(p->builder);
-		}
+		lb_emit_defers_and_return(p, nullptr, pos);
 	} else {
 		LLVMValueRef ret_val = res.value;
 		LLVMTypeRef ret_type = p->abi_function_type->ret.type;
@@ -2556,13 +3295,7 @@ gb_internal void lb_build_return_stmt_internal(lbProcedure *p, lbValue res, Toke
 			ret_val = OdinLLVMBuildTransmute(p, ret_val, ret_type);
 		}
 
-		lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-
-		// Check for terminator in the defer stmts
-		LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
-		if (!lb_is_instr_terminating(instr)) {
-			LLVMBuildRet(p->builder, ret_val);
-		}
+		lb_emit_defers_and_return(p, ret_val, pos);
 	}
 }
 gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return_results, TokenPos pos) {
@@ -2573,13 +3306,7 @@ gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return
 	if (return_count == 0) {
 		// No return values
 
-		lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-		
-		// Check for terminator in the defer stmts
-		LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
-		if (!lb_is_instr_terminating(instr)) {
-			LLVMBuildRetVoid(p->builder);
-		}
+		lb_emit_defers_and_return(p, nullptr, pos);
 		return;
 	}
 
@@ -2620,11 +3347,7 @@ gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return
 				if (ret_expr->kind == Ast_Ident) {
 					Entity *ret_e = entity_of_node(ret_expr);
 					if (ret_e == p->sret_rvo_entity) {
-						lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-						LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
-						if (!lb_is_instr_terminating(instr)) {
-							LLVMBuildRetVoid(p->builder);
-						}
+						lb_emit_defers_and_return(p, nullptr, pos);
 						return;
 					}
 				}
@@ -2652,7 +3375,7 @@ gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return
 		}
 
 	} else {
-		auto results = array_make<lbValue>(permanent_allocator(), 0, return_count);
+		auto results = array_make<lbValue>(lb_scratch_allocator(p), 0, return_count);
 
 		if (res_count != 0) {
 			for (isize res_index = 0; res_index < res_count; res_index++) {
@@ -2721,8 +3444,7 @@ gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return
 				GB_ASSERT(result_values.count-1 == result_eps.count);
 				lb_addr_store(p, p->return_ptr, result_values[result_values.count-1]);
 
-				lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-				LLVMBuildRetVoid(p->builder);
+				lb_emit_defers_and_return(p, nullptr, pos);
 				return;
 			} else {
 				return lb_build_return_stmt_internal(p, result_values[result_values.count-1], pos);
@@ -2745,8 +3467,7 @@ gb_internal void lb_build_return_stmt(lbProcedure *p, Slice<Ast *> const &return
 				for_array(i, result_eps) {
 					lb_emit_store(p, result_eps[i], result_values[i]);
 				}
-				lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
-				LLVMBuildRetVoid(p->builder);
+				lb_emit_defers_and_return(p, nullptr, pos);
 				return;
 			}
 
@@ -3076,7 +3797,7 @@ gb_internal void lb_build_assign_stmt(lbProcedure *p, AstAssignStmt *as) {
 			}
 		}
 
-		auto lvals = array_make<lbAddr>(permanent_allocator(), 0, as->lhs.count);
+		auto lvals = array_make<lbAddr>(lb_scratch_allocator(p), 0, as->lhs.count);
 
 		for (Ast *lhs : as->lhs) {
 			lbAddr lval = {};
@@ -3257,6 +3978,10 @@ gb_internal void lb_build_stmt(lbProcedure *p, Ast *node) {
 					Entity *e = entity_of_node(name);
 					// bool zero_init = true; // Always do it
 					bool zero_init = values.count == 0;
+					if (ptr_set_exists(&p->locals_written_before_read, e)) {
+						ptr_set_remove(&p->locals_written_before_read, e);
+						zero_init = false;
+					}
 					lvals[i] = lb_add_local(p, e->type, e, zero_init);
 				}
 			}
@@ -3438,6 +4163,18 @@ gb_internal void lb_build_defer_stmt(lbProcedure *p, lbDefer const &d) {
 	}
 }
 
+gb_internal void lb_emit_asan_unpoison_stack_locals(lbProcedure *p) {
+	// TODO(lucas): In LLVM 21 use the 'use-after-scope' asan option which does this for us.
+	for_array(i, p->asan_stack_locals) {
+		lbValue local = p->asan_stack_locals[i];
+
+		auto args = array_make<lbValue>(temporary_allocator(), 2);
+		args[0] = lb_emit_conv(p, local, t_rawptr);
+		args[1] = lb_const_int(p->module, t_int, type_size_of(local.type->Pointer.elem));
+		lb_emit_runtime_call(p, "__asan_unpoison_memory_region", args);
+	}
+}
+
 gb_internal void lb_emit_defer_stmts(lbProcedure *p, lbDeferExitKind kind, lbBlock *block, TokenPos pos) {
 	TokenPos prev_token_pos = p->branch_location_pos;
 	if (p->uses_branch_location) {
@@ -3445,16 +4182,8 @@ gb_internal void lb_emit_defer_stmts(lbProcedure *p, lbDeferExitKind kind, lbBlo
 	}
 	defer (p->branch_location_pos = prev_token_pos);
 
-	// TODO(lucas): In LLVM 21 use the 'use-after-scope' asan option which does this for us.
 	if (kind == lbDeferExit_Return) {
-		for_array(i, p->asan_stack_locals) {
-			lbValue local = p->asan_stack_locals[i];
-
-			auto args = array_make<lbValue>(temporary_allocator(), 2);
-			args[0] = lb_emit_conv(p, local, t_rawptr);
-			args[1] = lb_const_int(p->module, t_int, type_size_of(local.type->Pointer.elem));
-			lb_emit_runtime_call(p, "__asan_unpoison_memory_region", args);
-		}
+		lb_emit_asan_unpoison_stack_locals(p);
 	}
 
 	isize count = p->defer_stmts.count;
@@ -3497,6 +4226,92 @@ gb_internal void lb_emit_defer_stmts(lbProcedure *p, lbDeferExitKind kind, lbBlo
 	return lb_emit_defer_stmts(p, kind, block, pos);
 }
 
+// NOTE: Returns the block which runs the first `defer_count` defers, innermost first, and then returns
+// from the procedure. Each defer builds its block once, which every later return running it jumps to
+gb_internal lbBlock *lb_return_cleanup_block(lbProcedure *p, isize defer_count) {
+	lbBlock *prev_block = p->curr_block;
+
+	if (defer_count == 0) {
+		if (p->shared_return_block == nullptr) {
+			p->shared_return_block = lb_create_block(p, "return.shared");
+			lb_start_block(p, p->shared_return_block);
+			if (p->shared_return_value != nullptr) {
+				LLVMTypeRef ret_type = LLVMGetAllocatedType(p->shared_return_value);
+				LLVMBuildRet(p->builder, OdinLLVMBuildLoad(p, ret_type, p->shared_return_value));
+			} else {
+				LLVMBuildRetVoid(p->builder);
+			}
+			lb_start_block(p, prev_block);
+		}
+		return p->shared_return_block;
+	}
+
+	if (p->defer_stmts[defer_count-1].return_cleanup == nullptr) {
+		lbBlock *b = lb_create_block(p, "defer.return");
+		p->defer_stmts[defer_count-1].return_cleanup = b;
+
+		// NOTE: Copied as building the defer may add (and then pop) defers of its own
+		lbDefer d = p->defer_stmts[defer_count-1];
+		lb_start_block(p, b);
+		lb_build_defer_stmt(p, d);
+
+		// Check for terminator in the defer stmt
+		LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
+		if (!lb_is_instr_terminating(instr)) {
+			lb_emit_jump(p, lb_return_cleanup_block(p, defer_count-1));
+		}
+		lb_start_block(p, prev_block);
+	}
+	return p->defer_stmts[defer_count-1].return_cleanup;
+}
+
+// NOTE: Runs the defers for a return and returns `ret_val`, or nothing when it is nullptr.
+//
+// Every return runs every active defer, so duplicating them into each return grows as the number of
+// returns times the number of defers. Once a procedure has duplicated `LB_RETURN_DEFER_INLINE_LIMIT`
+// defers, further returns store their value and jump into a chain of blocks shared between returns.
+gb_internal void lb_emit_defers_and_return(lbProcedure *p, LLVMValueRef ret_val, TokenPos pos) {
+	isize defer_count = p->defer_stmts.count;
+	bool shared = defer_count > 0 &&
+	              !p->uses_branch_location && // NOTE: the defers depend on the position of each return
+	              p->return_defers_inlined + defer_count > LB_RETURN_DEFER_INLINE_LIMIT;
+
+	if (!shared) {
+		p->return_defers_inlined += defer_count;
+		lb_emit_defer_stmts(p, lbDeferExit_Return, nullptr, pos);
+
+		// Check for terminator in the defer stmts
+		LLVMValueRef instr = LLVMGetLastInstruction(p->curr_block->block);
+		if (!lb_is_instr_terminating(instr)) {
+			if (ret_val != nullptr) {
+				LLVMBuildRet(p->builder, ret_val);
+			} else {
+				LLVMBuildRetVoid(p->builder);
+			}
+		}
+		return;
+	}
+
+	lb_emit_asan_unpoison_stack_locals(p);
+
+	if (ret_val != nullptr) {
+		LLVMTypeRef ret_type = LLVMTypeOf(ret_val);
+		if (p->shared_return_value == nullptr) {
+			GB_ASSERT(p->shared_return_block == nullptr);
+			p->shared_return_value = llvm_alloca(p, ret_type, lb_alignof(ret_type), "");
+		}
+		GB_ASSERT(LLVMGetAllocatedType(p->shared_return_value) == ret_type);
+		LLVMBuildStore(p->builder, ret_val, p->shared_return_value);
+	} else {
+		GB_ASSERT(p->shared_return_value == nullptr);
+	}
+
+	// NOTE: Like a `ret`, this leaves the current block terminated rather than clearing it
+	lbBlock *cleanup = lb_return_cleanup_block(p, defer_count);
+	lb_add_edge(p->curr_block, cleanup);
+	LLVMBuildBr(p->builder, cleanup->block);
+}
+
 
 gb_internal void lb_add_defer_node(lbProcedure *p, isize scope_index, Ast *stmt) {
 	Type *pt = base_type(p->type);
@@ -3507,6 +4322,7 @@ gb_internal void lb_add_defer_node(lbProcedure *p, isize scope_index, Ast *stmt)
 
 	lbDefer *d = array_add_and_get(&p->defer_stmts);
 	d->kind = lbDefer_Node;
+	d->return_cleanup = nullptr;
 	d->scope_index = scope_index;
 	d->context_stack_count = p->context_stack.count;
 	d->block = p->curr_block;
@@ -3523,6 +4339,7 @@ gb_internal void lb_add_defer_proc(lbProcedure *p, isize scope_index, lbValue de
 
 	lbDefer *d = array_add_and_get(&p->defer_stmts);
 	d->kind = lbDefer_Proc;
+	d->return_cleanup = nullptr;
 	d->scope_index = p->scope_index;
 	d->block = p->curr_block;
 	d->pos   = pos;
@@ -162,6 +162,79 @@ gb_internal lbValue lb_type_info_member_tags_offset(lbModule *m, isize count, i6
 	return offset;
 }
 
+// NOTE: -rtti:minimal; the member names, usings, and tags which are not needed all point to the same run of
+// zero values at the start of each array (see `lb_type_info_shared_member_count`), rather than each type having its own
+gb_internal lbValue lb_type_info_member_shared_offset(lbModule *m, lbAddr const &array) {
+	GB_ASSERT(m == &m->gen->default_module);
+	return lb_const_array_epi(m, array.addr, 0);
+}
+
+gb_internal bool lb_type_info_owns_member_names(CheckerInfo *info, Type *t) {
+	if (!build_context.rtti_minimal) {
+		return true;
+	}
+	return type_set_exists(&info->min_dep_type_info_root_set, t);
+}
+
+gb_internal bool lb_type_info_owns_member_usings(CheckerInfo *info, Type *t) {
+	GB_ASSERT(t->kind == Type_Struct);
+	if (!build_context.rtti_minimal) {
+		return true;
+	}
+	if (!lb_type_info_owns_member_names(info, t)) {
+		return false;
+	}
+	for (Entity *f : t->Struct.fields) {
+		if (f->flags & EntityFlag_Using) {
+			return true;
+		}
+	}
+	return false;
+}
+
+gb_internal bool lb_type_info_owns_member_tags(CheckerInfo *info, Type *t) {
+	if (!build_context.rtti_minimal) {
+		return true;
+	}
+	if (!lb_type_info_owns_member_names(info, t)) {
+		return false;
+	}
+	String const *tags = nullptr;
+	isize count = 0;
+	switch (t->kind) {
+	case Type_Struct:   tags = t->Struct.tags;   count = t->Struct.fields.count;   break;
+	case Type_BitField: tags = t->BitField.tags; count = t->BitField.fields.count; break;
+	default: GB_PANIC("Invalid type for member tags"); break;
+	}
+	if (tags != nullptr) {
+		for (isize i = 0; i < count; i++) {
+			if (tags[i].len > 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+gb_internal isize lb_type_info_shared_member_count(CheckerInfo *info) {
+	if (!build_context.rtti_minimal) {
+		return 0;
+	}
+	isize count = 0;
+	for (auto const &tt : info->type_info_types_hash_map) {
+		Type *t = tt.type;
+		if (t == nullptr) {
+			continue;
+		}
+		switch (t->kind) {
+		case Type_Struct:   count = gb_max(count, t->Struct.fields.count);   break;
+		case Type_Tuple:    count = gb_max(count, t->Tuple.variables.count); break;
+		case Type_BitField: count = gb_max(count, t->BitField.fields.count); break;
+		}
+	}
+	return count;
+}
+
 gb_internal LLVMTypeRef *lb_setup_modified_types_for_type_info(lbModule *m, isize max_type_info_count) {
 	LLVMTypeRef *element_types = gb_alloc_array(heap_allocator(), LLVMTypeRef, max_type_info_count);
 	defer (gb_free(heap_allocator(), element_types));
@@ -216,6 +289,94 @@ gb_internal LLVMTypeRef *lb_setup_modified_types_for_type_info(lbModule *m, isiz
 	return modified_types;
 }
 
+// NOTE: Enums with fewer fields than this are scanned linearly by the runtime, so the lookup tables are not worth their size
+enum {LB_ENUM_LOOKUP_MIN_FIELDS = 8};
+
+struct lbEnumLookupValue {
+	i64 value;
+	i32 index;
+};
+
+struct lbEnumLookupName {
+	String name;
+	i32    index;
+};
+
+gb_internal GB_COMPARE_PROC(lb_enum_lookup_value_cmp) {
+	auto const *x = cast(lbEnumLookupValue const *)a;
+	auto const *y = cast(lbEnumLookupValue const *)b;
+	if (x->value != y->value) {
+		return x->value < y->value ? -1 : +1;
+	}
+	// NOTE: the first of any fields sharing a value is the one found, as with a linear scan
+	return x->index < y->index ? -1 : x->index > y->index ? +1 : 0;
+}
+
+gb_internal GB_COMPARE_PROC(lb_enum_lookup_name_cmp) {
+	auto const *x = cast(lbEnumLookupName const *)a;
+	auto const *y = cast(lbEnumLookupName const *)b;
+	return string_compare(x->name, y->name);
+}
+
+gb_internal LLVMValueRef lb_type_info_enum_index_slice(lbModule *m, String prefix, i64 entry_index, i32 const *indices, isize count) {
+	lbValue array = lb_generate_global_array(m, t_i32, count, prefix, entry_index);
+	LLVMValueRef *elems = gb_alloc_array(temporary_allocator(), LLVMValueRef, count);
+	for (isize i = 0; i < count; i++) {
+		elems[i] = LLVMConstInt(lb_type(m, t_i32), cast(u64)cast(i64)indices[i], true);
+	}
+	LLVMSetInitializer(array.value, llvm_const_array(m, lb_type(m, t_i32), elems, cast(unsigned)count));
+	LLVMSetGlobalConstant(array.value, true);
+	lb_set_odin_rtti_section(array.value);
+	return llvm_const_slice(m, lbValue{array.value, alloc_type_pointer(t_i32)}, lb_const_int(m, t_int, count));
+}
+
+// NOTE: Fills in the `min_value`, `value_lookup`, `value_order` and `name_order` fields of `runtime.Type_Info_Enum`.
+// An enum whose values are dense enough gets a table indexed directly by `value - min_value`, any other gets its
+// field indices sorted by value to be binary searched, and every one gets its field indices sorted by name.
+gb_internal void lb_setup_type_info_enum_lookup(lbModule *m, i64 entry_index, Array<Entity *> const &fields, LLVMValueRef const *value_values, LLVMValueRef *vals) {
+	isize count = fields.count;
+	auto values = slice_make<lbEnumLookupValue>(temporary_allocator(), count);
+	auto names  = slice_make<lbEnumLookupName>(temporary_allocator(), count);
+	for (isize i = 0; i < count; i++) {
+		values[i] = {LLVMConstIntGetSExtValue(value_values[i]), cast(i32)i};
+		names[i]  = {fields[i]->token.string, cast(i32)i};
+	}
+	gb_sort_array(values.data, count, lb_enum_lookup_value_cmp);
+	gb_sort_array(names.data,  count, lb_enum_lookup_name_cmp);
+
+	i64 min_value = values[0].value;
+	u64 range = cast(u64)values[count-1].value - cast(u64)min_value;
+
+	Type *slice_type = alloc_type_slice(t_i32);
+	vals[0] = LLVMConstInt(lb_type(m, t_type_info_enum_value), cast(u64)min_value, true);
+	vals[1] = LLVMConstNull(lb_type(m, slice_type));
+	vals[2] = LLVMConstNull(lb_type(m, slice_type));
+
+	if (range < 2*cast(u64)count) {
+		isize lookup_count = cast(isize)range + 1;
+		i32 *lookup = gb_alloc_array(temporary_allocator(), i32, lookup_count);
+		for (isize i = 0; i < lookup_count; i++) {
+			lookup[i] = -1;
+		}
+		for (isize i = count-1; i >= 0; i--) {
+			lookup[cast(u64)values[i].value - cast(u64)min_value] = values[i].index;
+		}
+		vals[1] = lb_type_info_enum_index_slice(m, str_lit("$enum_value_lookup"), entry_index, lookup, lookup_count);
+	} else {
+		i32 *order = gb_alloc_array(temporary_allocator(), i32, count);
+		for (isize i = 0; i < count; i++) {
+			order[i] = values[i].index;
+		}
+		vals[2] = lb_type_info_enum_index_slice(m, str_lit("$enum_value_order"), entry_index, order, count);
+	}
+
+	i32 *name_order = gb_alloc_array(temporary_allocator(), i32, count);
+	for (isize i = 0; i < count; i++) {
+		name_order[i] = names[i].index;
+	}
+	vals[3] = lb_type_info_enum_index_slice(m, str_lit("$enum_name_order"), entry_index, name_order, count);
+}
+
 gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_type_info_data_entity_count) { // NOTE(bill): Setup type_info data
 	auto const &ADD_GLOBAL_TYPE_INFO_ENTRY = [](lbModule *m, LLVMTypeRef type, isize index) -> LLVMValueRef {
 		char name[64] = {};
@@ -697,8 +858,10 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 			tag_type = t_type_info_parameters;
 			i64 type_offset = 0;
 			i64 name_offset = 0;
+			bool owns_names = lb_type_info_owns_member_names(info, t);
 			lbValue memory_types = lb_type_info_member_types_offset(m, t->Tuple.variables.count, &type_offset);
-			lbValue memory_names = lb_type_info_member_names_offset(m, t->Tuple.variables.count, &name_offset);
+			lbValue memory_names = owns_names ? lb_type_info_member_names_offset(m, t->Tuple.variables.count, &name_offset)
+			                                  : lb_type_info_member_shared_offset(m, lb_global_type_info_member_names);
 
 			for_array(i, t->Tuple.variables) {
 				// NOTE(bill): offset is not used for tuples
@@ -708,7 +871,7 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 				lbValue type_info = lb_const_ptr_offset(m, memory_types, index);
 
 				lb_global_type_info_member_types_values[type_offset+i] = get_type_info_ptr(m, f->type);
-				if (f->token.string.len > 0) {
+				if (owns_names && f->token.string.len > 0) {
 					lb_global_type_info_member_names_values[name_offset+i] = lb_const_string(m, f->token.string).value;
 				}
 			}
@@ -735,7 +898,7 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 				// GB_ASSERT_MSG(type_size_of(t_type_info_enum_value) == 16, "%lld == 16", cast(long long)type_size_of(t_type_info_enum_value));
 
 
-				LLVMValueRef vals[3] = {};
+				LLVMValueRef vals[7] = {};
 				vals[0] = get_type_info_ptr(m, t->Enum.base_type);
 				if (t->Enum.fields.count > 0) {
 					auto fields = t->Enum.fields;
@@ -768,9 +931,15 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 
 					vals[1] = llvm_const_slice(m, lbValue{name_array.value,  alloc_type_pointer(t_string)},               v_count);
 					vals[2] = llvm_const_slice(m, lbValue{value_array.value, alloc_type_pointer(t_type_info_enum_value)}, v_count);
-				} else {
-					vals[1] = LLVMConstNull(lb_type(m, base_type(t_type_info_enum)->Struct.fields[1]->type));
-					vals[2] = LLVMConstNull(lb_type(m, base_type(t_type_info_enum)->Struct.fields[2]->type));
+
+					if (fields.count >= LB_ENUM_LOOKUP_MIN_FIELDS) {
+						lb_setup_type_info_enum_lookup(m, cast(i64)entry_index, fields, value_values, vals+3);
+					}
+				}
+				for (isize i = 1; i < gb_count_of(vals); i++) {
+					if (vals[i] == nullptr) {
+						vals[i] = LLVMConstNull(lb_type(m, base_type(t_type_info_enum)->Struct.fields[i]->type));
+					}
 				}
 
 
@@ -837,6 +1006,7 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 				if (t->Struct.is_raw_union)   flags |= 1<<1;
 				if (t->Struct.is_all_or_none) flags |= 1<<2;
 				if (t->Struct.custom_align)   flags |= 1<<3;
+				if (t->Struct.is_reorder)     flags |= 1<<5;
 
 				vals[6] = lb_const_int(m, t_u8, flags).value;
 				if (is_type_comparable(t) && !is_type_simple_compare(t)) {
@@ -865,11 +1035,18 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 				i64 usings_offset  = 0;
 				i64 tags_offset    = 0;
 
+				bool owns_names  = lb_type_info_owns_member_names (info, t);
+				bool owns_usings = lb_type_info_owns_member_usings(info, t);
+				bool owns_tags   = lb_type_info_owns_member_tags  (info, t);
+
 				lbValue memory_types   = lb_type_info_member_types_offset  (m, count, &types_offset);
-				lbValue memory_names   = lb_type_info_member_names_offset  (m, count, &names_offset);
+				lbValue memory_names   = owns_names  ? lb_type_info_member_names_offset (m, count, &names_offset)
+				                                     : lb_type_info_member_shared_offset(m, lb_global_type_info_member_names);
 				lbValue memory_offsets = lb_type_info_member_offsets_offset(m, count, &offsets_offset);
-				lbValue memory_usings  = lb_type_info_member_usings_offset (m, count, &usings_offset);
-				lbValue memory_tags    = lb_type_info_member_tags_offset   (m, count, &tags_offset);
+				lbValue memory_usings  = owns_usings ? lb_type_info_member_usings_offset(m, count, &usings_offset)
+				                                     : lb_type_info_member_shared_offset(m, lb_global_type_info_member_usings);
+				lbValue memory_tags    = owns_tags   ? lb_type_info_member_tags_offset  (m, count, &tags_offset)
+				                                     : lb_type_info_member_shared_offset(m, lb_global_type_info_member_tags);
 
 				type_set_offsets(t); // NOTE(bill): Just incase the offsets have not been set yet
 				for (isize source_index = 0; source_index < count; source_index++) {
@@ -885,13 +1062,15 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 
 					lb_global_type_info_member_types_values[types_offset+source_index]     = get_type_info_ptr(m, f->type);
 					lb_global_type_info_member_offsets_values[offsets_offset+source_index] = lb_const_int(m, t_uintptr, foffset).value;
-					lb_global_type_info_member_usings_values[usings_offset+source_index]   = lb_const_bool(m, t_bool, (f->flags&EntityFlag_Using) != 0).value;
+					if (owns_usings) {
+						lb_global_type_info_member_usings_values[usings_offset+source_index] = lb_const_bool(m, t_bool, (f->flags&EntityFlag_Using) != 0).value;
+					}
 
-					if (f->token.string.len > 0) {
+					if (owns_names && f->token.string.len > 0) {
 						lb_global_type_info_member_names_values[names_offset+source_index] = lb_const_string(m, f->token.string).value;
 					}
 
-					if (t->Struct.tags != nullptr) {
+					if (owns_tags && t->Struct.tags != nullptr) {
 						String tag_string = t->Struct.tags[source_index];
 						if (tag_string.len > 0) {
 							lb_global_type_info_member_tags_values[tags_offset+source_index] = lb_const_string(m, tag_string).value;
@@ -1008,11 +1187,15 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 					i64 bit_sizes_offset   = 0;
 					i64 bit_offsets_offset = 0;
 					i64 tags_offset        = 0;
-					lbValue memory_names       = lb_type_info_member_names_offset  (m, count, &names_offset);
+					bool owns_names = lb_type_info_owns_member_names(info, t);
+					bool owns_tags  = lb_type_info_owns_member_tags (info, t);
+					lbValue memory_names       = owns_names ? lb_type_info_member_names_offset (m, count, &names_offset)
+					                                        : lb_type_info_member_shared_offset(m, lb_global_type_info_member_names);
 					lbValue memory_types       = lb_type_info_member_types_offset  (m, count, &types_offset);
 					lbValue memory_bit_sizes   = lb_type_info_member_offsets_offset(m, count, &bit_sizes_offset);
 					lbValue memory_bit_offsets = lb_type_info_member_offsets_offset(m, count, &bit_offsets_offset);
-					lbValue memory_tags        = lb_type_info_member_tags_offset   (m, count, &tags_offset);
+					lbValue memory_tags        = owns_tags  ? lb_type_info_member_tags_offset  (m, count, &tags_offset)
+					                                        : lb_type_info_member_shared_offset(m, lb_global_type_info_member_tags);
 
 					u64 bit_offset = 0;
 					for (isize source_index = 0; source_index < count; source_index++) {
@@ -1020,7 +1203,7 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 						u64 bit_size = cast(u64)t->BitField.bit_sizes[source_index];
 
 						lbValue index = lb_const_int(m, t_int, source_index);
-						if (f->token.string.len > 0) {
+						if (owns_names && f->token.string.len > 0) {
 							lb_global_type_info_member_names_values[names_offset+source_index] = lb_const_string(m, f->token.string).value;
 						}
 
@@ -1029,7 +1212,7 @@ gb_internal void lb_setup_type_info_data_giant_array(lbModule *m, i64 global_typ
 						lb_global_type_info_member_offsets_values[bit_sizes_offset+source_index] = lb_const_int(m, t_uintptr, bit_size).value;
 						lb_global_type_info_member_offsets_values[bit_offsets_offset+source_index] = lb_const_int(m, t_uintptr, bit_offset).value;
 
-						if (t->BitField.tags) {
+						if (owns_tags && t->BitField.tags) {
 							String tag = t->BitField.tags[source_index];
 							if (tag.len > 0) {
 								lb_global_type_info_member_tags_values[tags_offset+source_index] = lb_const_string(m, tag).value;
@@ -1053,6 +1053,11 @@ gb_internal lbValue lb_address_from_load_if_readonly_parameter(lbProcedure *p, l
 gb_internal lbStructFieldRemapping lb_get_struct_remapping(lbModule *m, Type *t) {
 	t = base_type(t);
 
+	if (t->kind == Type_Struct && !t->Struct.is_raw_union) {
+		// NOTE: Shared by every module, so neither the LLVM type nor the module's lock are needed
+		return lb_get_struct_layout(m, t)->field_remapping;
+	}
+
 	LLVMTypeRef struct_type = lb_type(m, t);
 
 	mutex_lock(&m->types_mutex);
@@ -2365,6 +2370,66 @@ gb_internal void lb_set_wasm_export_attributes(LLVMValueRef value, String export
 }
 
 
+// NOTE: Emits the module flags from which LLVM produces the `__objc_imageinfo` section, which is
+// what makes the Objective-C runtime process the `__objc_selrefs` of an image
+gb_internal void lb_add_objc_image_info(lbModule *m) {
+	LLVMTypeRef i32 = LLVMInt32TypeInContext(m->ctx);
+	char const *section = "__DATA,__objc_imageinfo,regular,no_dead_strip";
+
+	LLVMAddModuleFlag(m->mod,
+		LLVMModuleFlagBehaviorError,
+		"Objective-C Version", 19,
+		LLVMValueAsMetadata(LLVMConstInt(i32, 2, false)));
+	LLVMAddModuleFlag(m->mod,
+		LLVMModuleFlagBehaviorError,
+		"Objective-C Image Info Version", 30,
+		LLVMValueAsMetadata(LLVMConstInt(i32, 0, false)));
+	LLVMAddModuleFlag(m->mod,
+		LLVMModuleFlagBehaviorError,
+		"Objective-C Image Info Section", 30,
+		LLVMMDStringInContext2(m->ctx, section, gb_strlen(section)));
+	LLVMAddModuleFlag(m->mod,
+		LLVMModuleFlagBehaviorOverride,
+		"Objective-C Garbage Collection", 30,
+		LLVMValueAsMetadata(LLVMConstInt(i32, 0, false)));
+}
+
+// NOTE: Selector references are emitted the same way as clang does, as a pointer to the name in
+// `__objc_methname` placed in `__objc_selrefs`, which dyld fixes up when loading the image.
+// This avoids registering every selector with `sel_registerName` at startup.
+gb_internal lbAddr lb_add_objc_static_selector_ref(lbModule *m, String const &name, char const *global_name) {
+	if (m->objc_selectors.count == 0) {
+		lb_add_objc_image_info(m);
+	}
+
+	LLVMValueRef name_data = LLVMConstStringInContext(m->ctx, cast(char const *)name.text, cast(unsigned)name.len, false);
+	LLVMTypeRef name_type = LLVMTypeOf(name_data);
+
+	gbString name_global_name = gb_string_make(temporary_allocator(), "__$objc_methname::");
+	name_global_name = gb_string_append_length(name_global_name, name.text, name.len);
+
+	LLVMValueRef name_global = LLVMAddGlobal(m->mod, name_type, name_global_name);
+	LLVMSetInitializer(name_global, name_data);
+	lb_make_global_private_const(name_global);
+	LLVMSetUnnamedAddress(name_global, LLVMGlobalUnnamedAddr);
+	LLVMSetAlignment(name_global, 1);
+	LLVMSetSection(name_global, "__TEXT,__objc_methname,cstring_literals");
+
+	LLVMTypeRef t = lb_type(m, t_objc_SEL);
+	lbValue g = {};
+	g.value = LLVMAddGlobal(m->mod, t, global_name);
+	g.type = alloc_type_pointer(t_objc_SEL);
+	LLVMSetInitializer(g.value, name_global);
+	LLVMSetLinkage(g.value, LLVMInternalLinkage);
+	LLVMSetExternallyInitialized(g.value, true);
+	LLVMSetAlignment(g.value, cast(unsigned)build_context.ptr_size);
+	LLVMSetSection(g.value, "__DATA,__objc_selrefs,literal_pointers,no_dead_strip");
+
+	lbAddr addr = lb_addr(g);
+	string_map_set(&m->objc_selectors, name, addr);
+	return addr;
+}
+
 gb_internal lbAddr lb_handle_objc_find_or_register_selector(lbProcedure *p, String const &name) {
 	lbModule *m = p->module;
 	lbAddr *found = string_map_get(&m->objc_selectors, name);
@@ -2377,6 +2442,10 @@ gb_internal lbAddr lb_handle_objc_find_or_register_selector(lbProcedure *p, Stri
 	gbString global_name = gb_string_make(permanent_allocator(), "__$objc_SEL::");
 	global_name = gb_string_append_length(global_name, name.text, name.len);
 
+	if (build_context.metrics.os == TargetOs_darwin) {
+		return lb_add_objc_static_selector_ref(m, name, global_name);
+	}
+
 	LLVMTypeRef t = lb_type(m, t_objc_SEL);
 	lbValue g = {};
 	g.value = LLVMAddGlobal(m->mod, t, global_name);
@@ -16,7 +16,19 @@ gb_global ThreadPool global_thread_pool;
 gb_internal void init_global_thread_pool(void) {
 	isize thread_count = gb_max(build_context.thread_count, 1);
 	isize worker_count = thread_count; // +1
-	thread_pool_init(&global_thread_pool, worker_count, "ThreadPoolWorker");
+
+	CpuTopology const *topology = nullptr;
+	if (build_context.pin_threads) {
+		if (cpu_topology_init(&global_cpu_topology)) {
+			topology = &global_cpu_topology;
+			core_slots_init(&global_core_slots, topology);
+			debugf("Pinning %td workers to %td logical CPUs, %td physical cores and %td NUMA nodes\n",
+			       worker_count, topology->cpus.count, topology->core_count, topology->node_count);
+		} else {
+			gb_printf_err("Warning: -pin-threads is not available, the threads will not be pinned\n");
+		}
+	}
+	thread_pool_init(&global_thread_pool, worker_count, "ThreadPoolWorker", topology);
 }
 gb_internal bool thread_pool_add_task(WorkerTaskProc *proc, void *data) {
 	return thread_pool_add_task(&global_thread_pool, proc, data);
@@ -24,6 +36,13 @@ gb_internal bool thread_pool_add_task(WorkerTaskProc *proc, void *data) {
 gb_internal void thread_pool_wait(void) {
 	thread_pool_wait(&global_thread_pool);
 }
+gb_internal void thread_pool_add_tasks_largest_first(Slice<WorkerTaskWithSize> tasks) {
+	thread_pool_add_tasks_largest_first(&global_thread_pool, nullptr, tasks);
+}
+template <typename T>
+gb_internal void array_sort_parallel(Array<T> &array, gbCompareProc compare_proc) {
+	array_sort_parallel(&global_thread_pool, array, compare_proc);
+}
 
 
 gb_internal i64 PRINT_PEAK_USAGE(void) {
@@ -40,6 +59,26 @@ gb_internal i64 PRINT_PEAK_USAGE(void) {
 	return 0;
 }
 
+gb_internal void print_memory_subsystem_usage(void) {
+	if (!global_memory_accounting) {
+		return;
+	}
+	isize total = 0;
+	for (isize i = 0; i < MemorySubsystem_COUNT; i++) {
+		total += memory_subsystem_bytes(cast(MemorySubsystem)i);
+	}
+
+	gb_printf("\n");
+	gb_printf("Memory by Subsystem:\n");
+	for (isize i = 0; i < MemorySubsystem_COUNT; i++) {
+		isize bytes = memory_subsystem_bytes(cast(MemorySubsystem)i);
+		gb_printf("\t%-10s %10.3f MiB (%5.1f%%)\n", memory_subsystem_names[i],
+		          cast(f64)bytes / cast(f64)(1024ll * 1024ll),
+		          total ? 100.0*cast(f64)bytes/cast(f64)total : 0.0);
+	}
+	gb_printf("\t%-10s %10.3f MiB\n", "total", cast(f64)total / cast(f64)(1024ll * 1024ll));
+}
+
 
 gb_global BlockingMutex debugf_mutex;
 
@@ -71,6 +110,7 @@ gb_global Timings global_timings = {0};
 #include "parser.cpp"
 #include "checker.cpp"
 #include "docs.cpp"
+#include "symbol_index.cpp"
 
 #include "cached.cpp"
 
@@ -185,6 +225,70 @@ gb_internal i32 system_exec_command_line_app(char const *name, char const *fmt,
 extern char **environ;
 #endif
 
+// NOTE: Runs `argv[0]`, searched for within PATH, with `argv` passed along as they are rather than through a
+// shell, so nothing within them is ever interpreted. Unlike `system_exec_command_line_app`, this is not
+// affected by -print-linker-flags.
+gb_internal i32 system_exec_argv(char const *name, char const **argv) {
+	if (build_context.show_system_calls) {
+		gb_printf_err("[SYSTEM CALL] %s\n", name);
+		for (isize i = 0; argv[i] != nullptr; i++) {
+			gb_printf_err(i == 0 ? "%s" : " \"%s\"", argv[i]);
+		}
+		gb_printf_err("\n\n");
+	}
+
+#if defined(GB_SYSTEM_WINDOWS)
+	// NOTE: _spawnvp joins the arguments with spaces, so any containing spaces or quotes need quoting
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto quoted = array_make<char const *>(temporary_allocator(), 0, 16);
+	for (isize i = 0; argv[i] != nullptr; i++) {
+		char const *arg = argv[i];
+		if (arg[0] != 0 && strpbrk(arg, " \t\"") == nullptr) {
+			array_add(&quoted, arg);
+			continue;
+		}
+		gbString q = gb_string_make(temporary_allocator(), "\"");
+		isize backslashes = 0;
+		for (char const *c = arg; *c; c++) {
+			if (*c == '\\') {
+				backslashes += 1;
+			} else {
+				if (*c == '"') {
+					for (isize j = 0; j < backslashes+1; j++) {
+						q = gb_string_appendc(q, "\\");
+					}
+				}
+				backslashes = 0;
+			}
+			q = gb_string_append_length(q, c, 1);
+		}
+		for (isize j = 0; j < backslashes; j++) {
+			q = gb_string_appendc(q, "\\");
+		}
+		q = gb_string_appendc(q, "\"");
+		array_add(&quoted, cast(char const *)q);
+	}
+	array_add(&quoted, cast(char const *)nullptr);
+	return cast(i32)_spawnvp(_P_WAIT, argv[0], quoted.data);
+#else
+	pid_t pid = 0;
+	if (posix_spawnp(&pid, argv[0], nullptr, nullptr, cast(char *const *)argv, environ) != 0) {
+		gb_printf_err("Failed to execute command: %s: %s\n", argv[0], strerror(errno));
+		return -1;
+	}
+	int status = 0;
+	while (waitpid(pid, &status, 0) < 0) {
+		if (errno != EINTR) {
+			return -1;
+		}
+	}
+	if (WIFEXITED(status)) {
+		return WEXITSTATUS(status);
+	}
+	return -1;
+#endif
+}
+
 int run_subprocess(const char *name, const char **args) {
 #if defined(GB_SYSTEM_WINDOWS)
 	return (int)_spawnv(_P_WAIT, name, args);
@@ -302,15 +406,18 @@ gb_internal void usage(String argv0, String argv1 = {}) {
 	print_usage_line(0, "Commands:");
 	print_usage_line(1, "build             Compiles directory of .odin files, as an executable.");
 	print_usage_line(1, "                  One must contain the program's entry point, all must be in the same package.");
+	print_usage_line(1, "build-many        Compiles several directories of .odin files, each as its own executable.");
 	print_usage_line(1, "run               Same as 'build', but also then runs the newly compiled executable.");
 	print_usage_line(1, "bundle            Bundles a directory in a specific layout for that platform.");
 	print_usage_line(1, "check             Parses and type checks a directory of .odin files.");
 	print_usage_line(1, "strip-semicolon   Parses, type checks, and removes unneeded semicolons from the entire program.");
 	print_usage_line(1, "test              Builds and runs procedures with the attribute @(test) in the initial package.");
+	print_usage_line(1, "bench             Builds and runs procedures with the attribute @(benchmark) in the initial package.");
 	print_usage_line(1, "doc               Generates documentation from a directory of .odin files.");
 	print_usage_line(1, "version           Prints version.");
 	print_usage_line(1, "report            Prints information useful to reporting a bug.");
 	print_usage_line(1, "root              Prints the root path where Odin looks for the builtin collections.");
+	print_usage_line(1, "demangle          Turns the symbol names of Odin procedures into readable names.");
 	print_usage_line(0, "");
 	print_usage_line(0, "For further details on a command, invoke command help:");
 	print_usage_line(1, "e.g. `odin build -help` or `odin help build`");
@@ -327,22 +434,35 @@ enum BuildFlagKind {
 	BuildFlag_ShowTimings,
 	BuildFlag_ShowUnused,
 	BuildFlag_ShowUnusedWithLocation,
+	BuildFlag_CheckFile,
 	BuildFlag_ShowMoreTimings,
+	BuildFlag_ShowPerfCounters,
+	BuildFlag_ShowStats,
+	BuildFlag_ShowLockContention,
 	BuildFlag_ShowImportGraph,
 	BuildFlag_ExportTimings,
 	BuildFlag_ExportTimingsFile,
 	BuildFlag_ExportDependencies,
 	BuildFlag_ExportDependenciesFile,
+	BuildFlag_ExportSymbolIndex,
+	BuildFlag_ExportedSymbolsFile,
 	BuildFlag_ShowSystemCalls,
 	BuildFlag_ThreadCount,
+	BuildFlag_MaxMemory,
+	BuildFlag_LargePages,
+	BuildFlag_PinThreads,
 	BuildFlag_KeepTempFiles,
 	BuildFlag_Collection,
 	BuildFlag_Define,
 	BuildFlag_BuildMode,
 	BuildFlag_KeepExecutable,
+	BuildFlag_Jit,
 	BuildFlag_Target,
+	BuildFlag_InternalOutputSuffix,
 	BuildFlag_Subtarget,
 	BuildFlag_Debug,
+	BuildFlag_DebugSplit,
+	BuildFlag_CompressDebugSections,
 	BuildFlag_DisableAssert,
 	BuildFlag_NoBoundsCheck,
 	BuildFlag_WebkitSwitchWorkaround,
@@ -360,6 +480,12 @@ enum BuildFlagKind {
 	BuildFlag_DidYouMeanLimit,
 
 	BuildFlag_ShowDefineables,
+	BuildFlag_ShowUnrollReport,
+	BuildFlag_ShowGlobalInitReport,
+	BuildFlag_ShowCodeSize,
+	BuildFlag_ShowStackUsage,
+	BuildFlag_WasmOpt,
+	BuildFlag_UnrollBudget,
 	BuildFlag_ExportDefineables,
 	BuildFlag_IgnoreUnusedDefineables,
 
@@ -399,9 +525,12 @@ enum BuildFlagKind {
 	BuildFlag_StrictStyle,
 	BuildFlag_ForeignErrorProcedures,
 	BuildFlag_NoRTTI,
+	BuildFlag_RTTI,
 	BuildFlag_DynamicMapCalls,
 	BuildFlag_ObfuscateSourceCodeLocations,
 	BuildFlag_SourceCodeLocations,
+	BuildFlag_Deterministic,
+	BuildFlag_PathPrefixMap,
 
 	BuildFlag_Compact,
 	BuildFlag_GlobalDefinitions,
@@ -410,6 +539,7 @@ enum BuildFlagKind {
 	BuildFlag_Short,
 	BuildFlag_InSourceOrder,
 	BuildFlag_AllPackages,
+	BuildFlag_TestShards,
 	BuildFlag_DocFormat,
 
 	BuildFlag_IgnoreWarnings,
@@ -436,19 +566,41 @@ enum BuildFlagKind {
 	// internal use only
 	BuildFlag_InternalFastISel,
 	BuildFlag_InternalIgnoreLazy,
+	BuildFlag_InternalAstStats,
 	BuildFlag_InternalIgnoreLLVMBuild,
 	BuildFlag_InternalIgnorePanic,
 	BuildFlag_InternalModulePerFile,
+	BuildFlag_InternalPartitionModules,
+	BuildFlag_InternalLinkSingleModule,
+	BuildFlag_InternalEmitToMemory,
+	BuildFlag_InternalProcCostReport,
+	BuildFlag_InternalPolymorphicReport,
 	BuildFlag_InternalCached,
+	BuildFlag_InternalCacheRemote,
+	BuildFlag_InternalCacheRemoteReadOnly,
+	BuildFlag_InternalMmapFiles,
 	BuildFlag_InternalNoInline,
 	BuildFlag_InternalByValue,
 	BuildFlag_InternalWeakMonomorphization,
 	BuildFlag_InternalLLVMVerification,
 	BuildFlag_InternalLLVMNoSROA,
 	BuildFlag_InternalEnableRVO,
+	BuildFlag_InternalOdinAbiRegisters,
 
 	BuildFlag_Sanitize,
+	BuildFlag_InstrumentationMode,
+	BuildFlag_InstrumentationFilter,
+	BuildFlag_InstrumentationMinSize,
+	BuildFlag_InstrumentAllocations,
+	BuildFlag_AllocationSitesFile,
 	BuildFlag_LTO,
+	BuildFlag_PGO,
+	BuildFlag_ISel,
+	BuildFlag_OptRemarks,
+	BuildFlag_OptRemarksFile,
+	BuildFlag_PostLinkOptimize,
+	BuildFlag_SymbolOrderingFile,
+	BuildFlag_ProfileFriendly,
 
 #if defined(GB_SYSTEM_WINDOWS)
 	BuildFlag_IgnoreVsSearch,
@@ -471,6 +623,7 @@ enum BuildFlagParamKind {
 	BuildFlagParam_Integer,
 	BuildFlagParam_Float,
 	BuildFlagParam_String,
+	BuildFlagParam_OptionalString, // `-flag` or `-flag:<string>`
 
 	BuildFlagParam_COUNT,
 };
@@ -543,6 +696,40 @@ gb_internal ExactValue build_param_to_exact_value(String name, String param) {
 	return value;
 }
 
+// Parses a size in bytes with an optional K, M or G suffix (KB/KiB etc. are accepted too), all powers of 1024
+gb_internal bool parse_memory_size(String s, i64 *size_) {
+	isize i = 0;
+	i64 size = 0;
+	for (; i < s.len && gb_char_is_digit(s[i]); i++) {
+		if (size > (I64_MAX - 9) / 10) {
+			return false;
+		}
+		size = size*10 + (s[i] - '0');
+	}
+	if (i == 0) {
+		return false;
+	}
+	String suffix = substring(s, i, s.len);
+	i64 scale = 1;
+	if (suffix.len != 0 && !str_eq_ignore_case(suffix, "B")) {
+		switch (gb_char_to_upper(suffix[0])) {
+		case 'K': scale = 1ll<<10; break;
+		case 'M': scale = 1ll<<20; break;
+		case 'G': scale = 1ll<<30; break;
+		default:  return false;
+		}
+		String rest = substring(suffix, 1, suffix.len);
+		if (rest.len != 0 && !str_eq_ignore_case(rest, "B") && !str_eq_ignore_case(rest, "iB")) {
+			return false;
+		}
+	}
+	if (size > I64_MAX / scale) {
+		return false;
+	}
+	*size_ = size*scale;
+	return true;
+}
+
 // Writes a did-you-mean message for formerly deprecated flags.
 gb_internal void did_you_mean_flag(String flag) {
 	gbAllocator a = heap_allocator();
@@ -557,6 +744,23 @@ gb_internal void did_you_mean_flag(String flag) {
 	gb_printf_err("Unknown flag: '%.*s'\n", LIT(flag));
 }
 
+// NOTE: For `-show-lock-contention`, the mutexes within other structures are named where they are initialized
+gb_internal void name_global_mutexes(void) {
+	mutex_set_name(&global_memory_block_mutex,              "global_memory_block_mutex");
+	mutex_set_name(&string_buffer_mutex,                    "string_buffer_mutex");
+	mutex_set_name(&fullpath_mutex,                         "fullpath_mutex");
+	mutex_set_name(&global_files_mutex,                     "global_files_mutex");
+	mutex_set_name(&g_type_mutex,                           "g_type_mutex");
+	mutex_set_name(&global_type_name_objc_metadata_mutex,   "global_type_name_objc_metadata_mutex");
+	mutex_set_name(&global_error_collector.mutex,           "ErrorCollector.mutex");
+	mutex_set_name(&global_error_collector.path_mutex,      "ErrorCollector.path_mutex");
+	for (PaddedMutex &m : g_string_interner->mutexes) {
+		mutex_set_name(&m.m, "StringInterner.mutexes");
+	}
+	mutex_set_name(&g_string_interner->arena_mutex.m,       "StringInterner.arena_mutex");
+	mutex_set_name(&lb_module_memory_budget.mutex,          "lb_module_memory_budget.mutex");
+}
+
 gb_internal bool parse_build_flags(Array<String> args) {
 	auto build_flags = array_make<BuildFlag>(heap_allocator(), 0, BuildFlag_COUNT);
 	add_flag(&build_flags, BuildFlag_Help,                    str_lit("help"),                      BuildFlagParam_None,    Command_all);
@@ -565,23 +769,36 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_OptimizationMode,        str_lit("o"),                         BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ShowTimings,             str_lit("show-timings"),              BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowMoreTimings,         str_lit("show-more-timings"),         BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowPerfCounters,        str_lit("show-perf-counters"),        BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowStats,               str_lit("show-stats"),                BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowLockContention,      str_lit("show-lock-contention"),      BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowImportGraph,         str_lit("show-import-graph"),         BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportTimings,           str_lit("export-timings"),            BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportTimingsFile,       str_lit("export-timings-file"),       BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportDependencies,      str_lit("export-dependencies"),       BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ExportDependenciesFile,  str_lit("export-dependencies-file"),  BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_ExportSymbolIndex,       str_lit("export-symbol-index"),       BuildFlagParam_String,  Command__does_check);
+	add_flag(&build_flags, BuildFlag_ExportedSymbolsFile,     str_lit("exported-symbols-file"),     BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_ShowUnused,              str_lit("show-unused"),               BuildFlagParam_None,    Command_check);
 	add_flag(&build_flags, BuildFlag_ShowUnusedWithLocation,  str_lit("show-unused-with-location"), BuildFlagParam_None,    Command_check);
+	add_flag(&build_flags, BuildFlag_CheckFile,               str_lit("check-file"),                BuildFlagParam_String,  Command_check);
 	add_flag(&build_flags, BuildFlag_ShowSystemCalls,         str_lit("show-system-calls"),         BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_ThreadCount,             str_lit("thread-count"),              BuildFlagParam_Integer, Command_all);
+	add_flag(&build_flags, BuildFlag_MaxMemory,               str_lit("max-memory"),                BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_LargePages,              str_lit("large-pages"),               BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_PinThreads,              str_lit("pin-threads"),               BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_KeepTempFiles,           str_lit("keep-temp-files"),           BuildFlagParam_None,    Command__does_build | Command_strip_semicolon);
 	add_flag(&build_flags, BuildFlag_Collection,              str_lit("collection"),                BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_Define,                  str_lit("define"),                    BuildFlagParam_String,  Command__does_check, true);
 	add_flag(&build_flags, BuildFlag_BuildMode,               str_lit("build-mode"),                BuildFlagParam_String,  Command__does_build); // Commands_build is not used to allow for a better error message
 	add_flag(&build_flags, BuildFlag_KeepExecutable,          str_lit("keep-executable"),           BuildFlagParam_None,    Command__does_build | Command_test);
+	add_flag(&build_flags, BuildFlag_Jit,                     str_lit("jit"),                       BuildFlagParam_None,    Command_run | Command_test);
 	add_flag(&build_flags, BuildFlag_Target,                  str_lit("target"),                    BuildFlagParam_String,  Command__does_check);
+	add_flag(&build_flags, BuildFlag_InternalOutputSuffix,    str_lit("internal-output-suffix"),    BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_Subtarget,               str_lit("subtarget"),                 BuildFlagParam_String,  Command__does_check);
-	add_flag(&build_flags, BuildFlag_Debug,                   str_lit("debug"),                     BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_Debug,                   str_lit("debug"),                     BuildFlagParam_OptionalString, Command__does_check);
+	add_flag(&build_flags, BuildFlag_DebugSplit,              str_lit("debug-split"),               BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_CompressDebugSections,   str_lit("compress-debug-sections"),   BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_DisableAssert,           str_lit("disable-assert"),            BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_NoBoundsCheck,           str_lit("no-bounds-check"),           BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_WebkitSwitchWorkaround,  str_lit("webkit-switch-workaround"),  BuildFlagParam_None,    Command__does_check);
@@ -600,6 +817,12 @@ gb_internal bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_DidYouMeanLimit,         str_lit("did-you-mean-limit"),        BuildFlagParam_Integer, Command__does_check);
 
 	add_flag(&build_flags, BuildFlag_ShowDefineables,         str_lit("show-defineables"),          BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowUnrollReport,        str_lit("show-unroll-report"),        BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_ShowGlobalInitReport,    str_lit("show-global-init-report"),   BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_ShowCodeSize,            str_lit("show-code-size"),            BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_ShowStackUsage,          str_lit("show-stack-usage"),          BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_WasmOpt,                 str_lit("wasm-opt"),                  BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_UnrollBudget,            str_lit("unroll-budget"),             BuildFlagParam_Integer, Command__does_check);
 	add_flag(&build_flags, BuildFlag_ExportDefineables,       str_lit("export-defineables"),        BuildFlagParam_String,  Command__does_check);
 	add_flag(&build_flags, BuildFlag_IgnoreUnusedDefineables, str_lit("ignore-unused-defineables"), BuildFlagParam_None,    Command__does_check);
 
@@ -640,15 +863,19 @@ gb_internal bool parse_build_flags(Array<String> args) {
 
 	add_flag(&build_flags, BuildFlag_NoRTTI,                  str_lit("no-rtti"),                   BuildFlagParam_None,    Command__does_check);
 	add_flag(&build_flags, BuildFlag_NoRTTI,                  str_lit("disallow-rtti"),             BuildFlagParam_None,    Command__does_check);
+	add_flag(&build_flags, BuildFlag_RTTI,                    str_lit("rtti"),                      BuildFlagParam_String,  Command__does_check);
 
 	add_flag(&build_flags, BuildFlag_DynamicMapCalls,         str_lit("dynamic-map-calls"),         BuildFlagParam_None,    Command__does_check);
 
 	add_flag(&build_flags, BuildFlag_ObfuscateSourceCodeLocations, str_lit("obfuscate-source-code-locations"), BuildFlagParam_None,    Command__does_build);
 	add_flag(&build_flags, BuildFlag_SourceCodeLocations, 		str_lit("source-code-locations"), 		BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_Deterministic,           str_lit("deterministic"),             BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_PathPrefixMap,           str_lit("path-prefix-map"),           BuildFlagParam_String,  Command__does_build, true);
 
 	add_flag(&build_flags, BuildFlag_Short,                   str_lit("short"),                     BuildFlagParam_None,    Command_doc);
 	add_flag(&build_flags, BuildFlag_InSourceOrder,           str_lit("in-source-order"),           BuildFlagParam_None,    Command_doc);
 	add_flag(&build_flags, BuildFlag_AllPackages,             str_lit("all-packages"),              BuildFlagParam_None,    Command_doc | Command_test | Command_build);
+	add_flag(&build_flags, BuildFlag_TestShards,              str_lit("test-shards"),               BuildFlagParam_None,    Command_test);
 	add_flag(&build_flags, BuildFlag_DocFormat,               str_lit("doc-format"),                BuildFlagParam_None,    Command_doc);
 
 	add_flag(&build_flags, BuildFlag_IgnoreWarnings,          str_lit("ignore-warnings"),           BuildFlagParam_None,    Command_all);
@@ -674,20 +901,42 @@ gb_internal bool parse_build_flags(Array<String> args) {
 
 	add_flag(&build_flags, BuildFlag_InternalFastISel,        str_lit("internal-fast-isel"),        BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalIgnoreLazy,      str_lit("internal-ignore-lazy"),      BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalAstStats,        str_lit("internal-ast-stats"),        BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalIgnoreLLVMBuild, str_lit("internal-ignore-llvm-build"),BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalIgnorePanic,     str_lit("internal-ignore-panic"),     BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalModulePerFile,   str_lit("internal-module-per-file"),  BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalPartitionModules, str_lit("internal-partition-modules"), BuildFlagParam_None,   Command_all);
+	add_flag(&build_flags, BuildFlag_InternalLinkSingleModule, str_lit("internal-link-single-module"), BuildFlagParam_None,  Command_all);
+	add_flag(&build_flags, BuildFlag_InternalEmitToMemory,    str_lit("internal-emit-to-memory"),   BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalProcCostReport,  str_lit("internal-proc-cost-report"), BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalPolymorphicReport, str_lit("internal-polymorphic-report"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalCached,          str_lit("internal-cached"),           BuildFlagParam_None,    Command_all);
+	add_flag(&build_flags, BuildFlag_InternalCacheRemote,     str_lit("internal-cache-remote"),     BuildFlagParam_String,  Command_all);
+	add_flag(&build_flags, BuildFlag_InternalCacheRemoteReadOnly, str_lit("internal-cache-remote-read-only"), BuildFlagParam_None, Command_all);
+	add_flag(&build_flags, BuildFlag_InternalMmapFiles,       str_lit("internal-mmap-files"),       BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalNoInline,        str_lit("internal-no-inline"),        BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalByValue,         str_lit("internal-by-value"),         BuildFlagParam_None,    Command_all);
 	add_flag(&build_flags, BuildFlag_InternalWeakMonomorphization, str_lit("internal-weak-monomorphization"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalLLVMVerification, str_lit("internal-ignore-llvm-verification"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalLLVMNoSROA,      str_lit("internal-llvm-no-sroa"), BuildFlagParam_None, Command_all);
 	add_flag(&build_flags, BuildFlag_InternalEnableRVO,       str_lit("internal-enable-rvo"), BuildFlagParam_None, Command_all);
+	add_flag(&build_flags, BuildFlag_InternalOdinAbiRegisters, str_lit("internal-odin-abi-registers"), BuildFlagParam_None, Command_all);
 
 
 	add_flag(&build_flags, BuildFlag_Sanitize,                str_lit("sanitize"),                  BuildFlagParam_String,  Command__does_build, true);
+	add_flag(&build_flags, BuildFlag_InstrumentationMode,     str_lit("instrumentation-mode"),      BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_InstrumentationFilter,   str_lit("instrumentation-filter"),    BuildFlagParam_String,  Command__does_build, true);
+	add_flag(&build_flags, BuildFlag_InstrumentationMinSize,  str_lit("instrumentation-min-size"),  BuildFlagParam_Integer, Command__does_build);
+	add_flag(&build_flags, BuildFlag_InstrumentAllocations,   str_lit("instrument-allocations"),    BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_AllocationSitesFile,     str_lit("allocation-sites-file"),     BuildFlagParam_String,  Command__does_build);
 	add_flag(&build_flags, BuildFlag_LTO,                     str_lit("lto"),                       BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_PGO,                     str_lit("pgo"),                       BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_ISel,                    str_lit("isel"),                      BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_OptRemarks,              str_lit("opt-remarks"),               BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_OptRemarksFile,          str_lit("opt-remarks-file"),          BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_PostLinkOptimize,        str_lit("post-link-optimize"),        BuildFlagParam_None,    Command__does_build);
+	add_flag(&build_flags, BuildFlag_SymbolOrderingFile,      str_lit("symbol-ordering-file"),      BuildFlagParam_String,  Command__does_build);
+	add_flag(&build_flags, BuildFlag_ProfileFriendly,         str_lit("profile-friendly"),          BuildFlagParam_None,    Command__does_build);
 
 
 #if defined(GB_SYSTEM_WINDOWS)
@@ -766,6 +1015,8 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							gb_printf_err("Flag '%.*s' was not expecting a parameter '%.*s'\n", LIT(name), LIT(param));
 							bad_flags = true;
 						}
+					} else if (param.len == 0 && bf.param_kind == BuildFlagParam_OptionalString) {
+						ok = true;
 					} else if (param.len == 0) {
 						gb_printf_err("Flag missing for '%.*s'\n", LIT(name));
 						bad_flags = true;
@@ -794,7 +1045,8 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlagParam_Float: {
 							value = exact_value_float_from_string(param);
 						} break;
-						case BuildFlagParam_String: {
+						case BuildFlagParam_String:
+						case BuildFlagParam_OptionalString: {
 							value = exact_value_string(param);
 							if (value.kind == ExactValue_String) {
 								String s = value.value_string;
@@ -843,6 +1095,13 @@ gb_internal bool parse_build_flags(Array<String> args) {
 								ok = false;
 							}
 							break;
+						case BuildFlagParam_OptionalString:
+							if (value.kind != ExactValue_Invalid && value.kind != ExactValue_String) {
+								gb_printf_err("%.*s expected a string, got %.*s\n", LIT(name), LIT(param));
+								bad_flags = true;
+								ok = false;
+							}
+							break;
 						}
 
 						if (ok) switch (bf.kind) {
@@ -906,11 +1165,48 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							build_context.show_unused_with_location = true;
 							break;
 						}
+						case BuildFlag_CheckFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (!is_build_flag_path_valid(path)) {
+								gb_printf_err("Invalid -check-file:<filename> path, got %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							path = path_to_full_path(heap_allocator(), path);
+							if (!gb_file_exists(cast(char const *)path.text)) {
+								gb_printf_err("Invalid -check-file:<filename> path, file does not exist: %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							build_context.check_file = path;
+							break;
+						}
 						case BuildFlag_ShowMoreTimings:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_timings = true;
 							build_context.show_more_timings = true;
 							break;
+						case BuildFlag_ShowPerfCounters:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+						#if defined(GB_SYSTEM_LINUX)
+							build_context.show_timings = true;
+							build_context.show_perf_counters = true;
+						#else
+							gb_printf_err("-show-perf-counters is only supported on Linux\n");
+							bad_flags = true;
+						#endif
+							break;
+						case BuildFlag_ShowStats:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_timings = true;
+							build_context.show_stats = true;
+							break;
+						case BuildFlag_ShowLockContention:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_timings = true;
+							build_context.show_lock_contention = true;
+							break;
 						case BuildFlag_ShowImportGraph:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_import_graph = true;
@@ -924,11 +1220,14 @@ gb_internal bool parse_build_flags(Array<String> args) {
 								build_context.export_timings_format = TimingsExportJson;
 							} else if (value.value_string == "csv") {
 								build_context.export_timings_format = TimingsExportCSV;
+							} else if (value.value_string == "trace") {
+								build_context.export_timings_format = TimingsExportTrace;
 							} else {
 								gb_printf_err("Invalid export format for -export-timings:<string>, got %.*s\n", LIT(value.value_string));
 								gb_printf_err("Valid export formats:\n");
 								gb_printf_err("\tjson\n");
 								gb_printf_err("\tcsv\n");
+								gb_printf_err("\ttrace\n");
 								bad_flags = true;
 							}
 
@@ -976,11 +1275,73 @@ gb_internal bool parse_build_flags(Array<String> args) {
 
 							break;
 						}
+						case BuildFlag_ExportSymbolIndex: {
+							GB_ASSERT(value.kind == ExactValue_String);
+
+							String export_path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(export_path)) {
+								build_context.export_symbol_index_file = path_to_full_path(heap_allocator(), export_path);
+							} else {
+								gb_printf_err("Invalid -export-symbol-index path, got %.*s\n", LIT(export_path));
+								bad_flags = true;
+							}
+
+							break;
+						}
+						case BuildFlag_ExportedSymbolsFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+
+							String path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(path)) {
+								build_context.exported_symbols_file = path_to_full_path(heap_allocator(), path);
+							} else {
+								gb_printf_err("Invalid -exported-symbols-file path, got %.*s\n", LIT(path));
+								bad_flags = true;
+							}
+
+							break;
+						}
 						case BuildFlag_ShowDefineables: {
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_defineables = true;
 							break;
 						}
+						case BuildFlag_ShowUnrollReport: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_unroll_report = true;
+							break;
+						}
+						case BuildFlag_ShowGlobalInitReport: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_global_init_report = true;
+							break;
+						}
+						case BuildFlag_ShowCodeSize: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_code_size = true;
+							break;
+						}
+						case BuildFlag_ShowStackUsage: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.show_stack_usage = true;
+							break;
+						}
+						case BuildFlag_WasmOpt: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.wasm_opt = true;
+							break;
+						}
+						case BuildFlag_UnrollBudget: {
+							GB_ASSERT(value.kind == ExactValue_Integer);
+							i64 budget = big_int_to_i64(&value.value_integer);
+							if (budget <= 0) {
+								gb_printf_err("-%.*s must be greater than 0\n", LIT(bf.name));
+								bad_flags = true;
+							} else {
+								build_context.unroll_budget = budget;
+							}
+							break;
+						}
 						case BuildFlag_ExportDefineables: {
 							GB_ASSERT(value.kind == ExactValue_String);
 
@@ -1015,6 +1376,33 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							break;
 						}
+						case BuildFlag_LargePages:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							if (platform_virtual_memory_enable_large_pages()) {
+								virtual_memory_large_pages = true;
+							} else {
+								gb_printf_err("Warning: -large-pages is not available, normal pages will be used\n");
+								#if defined(GB_SYSTEM_WINDOWS)
+								gb_printf_err("\tThe 'Lock pages in memory' privilege is required\n");
+								#endif
+							}
+							break;
+						case BuildFlag_PinThreads:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.pin_threads = true;
+							break;
+						case BuildFlag_MaxMemory: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							i64 size = 0;
+							if (!parse_memory_size(string_trim_whitespace(value.value_string), &size) || size <= 0) {
+								gb_printf_err("Invalid size for -max-memory:<size>, got %.*s\n", LIT(value.value_string));
+								gb_printf_err("Expected a positive number of bytes with an optional K, M or G suffix, e.g. 8G\n");
+								bad_flags = true;
+							} else {
+								build_context.max_memory = size;
+							}
+							break;
+						}
 						case BuildFlag_KeepTempFiles: {
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.keep_temp_files = true;
@@ -1143,6 +1531,27 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							String str = value.value_string;
 							bool found = false;
 
+							if (string_contains_char(str, ',')) {
+								array_init(&build_context.multiple_targets, heap_allocator());
+								String_Iterator it = {str, 0};
+								for (String target = string_split_iterator(&it, ','); target.len != 0; target = string_split_iterator(&it, ',')) {
+									target = string_trim_whitespace(target);
+									found = false;
+									for (isize i = 0; i < gb_count_of(named_targets); i++) {
+										if (str_eq_ignore_case(target, named_targets[i].name)) {
+											found = true;
+											array_add(&build_context.multiple_targets, named_targets[i].name);
+											break;
+										}
+									}
+									if (!found) {
+										gb_printf_err("Unknown target '%.*s' in -target:%.*s\n", LIT(target), LIT(str));
+										bad_flags = true;
+									}
+								}
+								break;
+							}
+
 							for (isize i = 0; i < gb_count_of(named_targets); i++) {
 								if (str_eq_ignore_case(str, named_targets[i].name)) {
 									found = true;
@@ -1187,6 +1596,11 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							break;
 						}
 
+						case BuildFlag_InternalOutputSuffix:
+							GB_ASSERT(value.kind == ExactValue_String);
+							build_context.output_suffix = value.value_string;
+							break;
+
 						case BuildFlag_Subtarget:
 							if (selected_target_metrics == nullptr) {
 								gb_printf_err("-target must be set before -subtarget is used\n");
@@ -1270,10 +1684,36 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlag_KeepExecutable:
 							build_context.keep_executable = true;
 							break;
+						case BuildFlag_Jit:
+							build_context.jit = true;
+							break;
 
 						case BuildFlag_Debug:
-							build_context.ODIN_DEBUG = true;
+							if (value.kind == ExactValue_Invalid) {
+								build_context.ODIN_DEBUG = true;
+							} else if (value.value_string == "lines") {
+								build_context.debug_line_tables = true;
+							} else {
+								gb_printf_err("-debug:<string> options are 'lines'\n");
+								bad_flags = true;
+							}
+							break;
+						case BuildFlag_DebugSplit:
+							build_context.debug_split = true;
+							break;
+						case BuildFlag_CompressDebugSections: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String str = string_trim_whitespace(value.value_string);
+							if (str_eq_ignore_case(str, str_lit("zlib"))) {
+								build_context.debug_compression = DebugCompression_Zlib;
+							} else if (str_eq_ignore_case(str, str_lit("zstd"))) {
+								build_context.debug_compression = DebugCompression_Zstd;
+							} else {
+								gb_printf_err("-compress-debug-sections:<string> options are 'zlib' and 'zstd'\n");
+								bad_flags = true;
+							}
 							break;
+						}
 						case BuildFlag_DisableAssert:
 							build_context.ODIN_DISABLE_ASSERT = true;
 							break;
@@ -1516,6 +1956,21 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							build_context.no_rtti = true;
 							break;
+						case BuildFlag_RTTI: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String v = value.value_string;
+							if (v == "full") {
+								build_context.rtti_minimal = false;
+							} else if (v == "minimal") {
+								build_context.rtti_minimal = true;
+							} else {
+								gb_printf_err("-rtti flag expected one of the following\n");
+								gb_printf_err("\tfull\n");
+								gb_printf_err("\tminimal\n");
+								bad_flags = true;
+							}
+							break;
+						}
 						case BuildFlag_DynamicMapCalls:
 							build_context.dynamic_map_calls = true;
 							break;
@@ -1540,6 +1995,23 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							break;
 
+						case BuildFlag_Deterministic:
+							build_context.deterministic = true;
+							break;
+
+						case BuildFlag_PathPrefixMap: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String str = value.value_string;
+							isize eq = string_index_byte(str, '=');
+							if (eq <= 0) {
+								gb_printf_err("-path-prefix-map expects '<old>=<new>', got '%.*s'\n", LIT(str));
+								bad_flags = true;
+								break;
+							}
+							add_path_prefix_map(substring(str, 0, eq), substring(str, eq+1, str.len));
+							break;
+						}
+
 						case BuildFlag_DefaultToNilAllocator:
 							if (build_context.ODIN_DEFAULT_TO_PANIC_ALLOCATOR) {
 								gb_printf_err("'-default-to-panic-allocator' cannot be used with '-default-to-nil-allocator'\n");
@@ -1571,6 +2043,9 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							build_context.cmd_doc_flags |= CmdDocFlag_AllPackages;
 				   			build_context.test_all_packages = true;
 							break;
+						case BuildFlag_TestShards:
+							build_context.test_shards = true;
+							break;
 						case BuildFlag_DocFormat:
 							build_context.cmd_doc_flags |= CmdDocFlag_DocFormat;
 							break;
@@ -1682,11 +2157,14 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							break;
 
 						case BuildFlag_InternalFastISel:
-							build_context.fast_isel = true;
+							build_context.isel_kind = ISel_Fast;
 							break;
 						case BuildFlag_InternalIgnoreLazy:
 							build_context.ignore_lazy = true;
 							break;
+						case BuildFlag_InternalAstStats:
+							build_context.ast_stats = true;
+							break;
 						case BuildFlag_InternalIgnoreLLVMBuild:
 							build_context.ignore_llvm_build = true;
 							break;
@@ -1697,10 +2175,44 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							build_context.module_per_file = true;
 							build_context.use_separate_modules = true;
 							break;
+						case BuildFlag_InternalPartitionModules:
+							build_context.partition_modules = true;
+							build_context.use_separate_modules = true;
+							break;
+						case BuildFlag_InternalLinkSingleModule:
+							build_context.link_into_single_module = true;
+							build_context.use_separate_modules = true;
+							break;
+						case BuildFlag_InternalEmitToMemory:
+							build_context.emit_to_memory = true;
+							break;
+						case BuildFlag_InternalProcCostReport:
+							build_context.proc_cost_report = true;
+							break;
+						case BuildFlag_InternalPolymorphicReport:
+							build_context.polymorphic_report = true;
+							concurrent_map_init(&global_polymorphic_instances);
+							break;
 						case BuildFlag_InternalCached:
 							build_context.cached = true;
 							build_context.use_separate_modules = true;
 							break;
+						case BuildFlag_InternalCacheRemote:
+							GB_ASSERT(value.kind == ExactValue_String);
+							build_context.cached = true;
+							build_context.use_separate_modules = true;
+							build_context.build_cache_data.remote_url = value.value_string;
+							break;
+						case BuildFlag_InternalCacheRemoteReadOnly:
+							build_context.build_cache_data.remote_read_only = true;
+							break;
+						case BuildFlag_InternalMmapFiles:
+							// NOTE: tokenize directly from memory mapped source files instead of copying them
+							// `strip-semicolon` overwrites the source files, so it must always copy
+							if (build_context.command_kind != Command_strip_semicolon) {
+								build_context.copy_file_contents = false;
+							}
+							break;
 						case BuildFlag_InternalNoInline:
 							build_context.internal_no_inline = true;
 							break;
@@ -1719,6 +2231,9 @@ gb_internal bool parse_build_flags(Array<String> args) {
 						case BuildFlag_InternalEnableRVO:
 							build_context.enable_rvo = true;
 							break;
+						case BuildFlag_InternalOdinAbiRegisters:
+							build_context.internal_odin_abi_registers = true;
+							break;
 
 
 						case BuildFlag_Sanitize:
@@ -1741,6 +2256,77 @@ gb_internal bool parse_build_flags(Array<String> args) {
 							}
 							break;
 
+						case BuildFlag_InstrumentationMode:
+							GB_ASSERT(value.kind == ExactValue_String);
+							if (str_eq_ignore_case(value.value_string, str_lit("calls"))) {
+								build_context.instrumentation_mode = InstrumentationMode_Calls;
+							} else if (str_eq_ignore_case(value.value_string, str_lit("patchable"))) {
+								build_context.instrumentation_mode = InstrumentationMode_Patchable;
+							} else {
+								gb_printf_err("-instrumentation-mode:<string> options are 'calls' and 'patchable'\n");
+								bad_flags = true;
+							}
+							break;
+
+						case BuildFlag_InstrumentationFilter:
+							{
+								GB_ASSERT(value.kind == ExactValue_String);
+								if (build_context.instrumentation_filters.allocator.proc == nullptr) {
+									array_init(&build_context.instrumentation_filters, heap_allocator());
+								}
+								String_Iterator it = {value.value_string, 0};
+								for (;;) {
+									String pattern = string_split_iterator(&it, ',');
+									if (pattern.len == 0) {
+										break;
+									}
+									pattern = string_trim_whitespace(pattern);
+
+									InstrumentationFilter filter = {};
+									if (pattern.len > 0 && pattern[0] == '!') {
+										filter.exclude = true;
+										pattern = substring(pattern, 1, pattern.len);
+									}
+									if (pattern.len == 0) {
+										gb_printf_err("-%.*s expects a non-empty pattern\n", LIT(name));
+										bad_flags = true;
+										continue;
+									}
+									filter.pattern = pattern;
+									array_add(&build_context.instrumentation_filters, filter);
+								}
+							}
+							break;
+
+						case BuildFlag_InstrumentationMinSize: {
+							GB_ASSERT(value.kind == ExactValue_Integer);
+							i64 size = big_int_to_i64(&value.value_integer);
+							if (size < 0) {
+								gb_printf_err("-%.*s must be 0 or greater\n", LIT(bf.name));
+								bad_flags = true;
+							} else {
+								build_context.instrumentation_min_size = size;
+							}
+							break;
+						}
+
+						case BuildFlag_InstrumentAllocations:
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.instrument_allocations = true;
+							break;
+
+						case BuildFlag_AllocationSitesFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (!is_build_flag_path_valid(path)) {
+								gb_printf_err("Invalid -allocation-sites-file path, got %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							build_context.allocation_sites_file = path;
+							break;
+						}
+
 						case BuildFlag_LTO:
 							GB_ASSERT(value.kind == ExactValue_String);
 							if (str_eq_ignore_case(value.value_string, str_lit("thin"))) {
@@ -1767,35 +2353,141 @@ gb_internal bool parse_build_flags(Array<String> args) {
 										bad_flags = true;
 									}
 								}
+							} else if (str_eq_ignore_case(value.value_string, str_lit("full"))) {
+								build_context.lto_kind = LTO_Full;
+								if (build_context.linker_choice == Linker_Invalid || build_context.linker_choice == Linker_Default) {
+									build_context.linker_choice = Linker_lld;
+								}
+								if (!build_context.use_separate_modules) {
+									build_context.use_separate_modules = true;
+									if (build_context.use_single_module) {
+										gb_printf_err("-linker:<string> cannot be used with -use-single-module\n");
+										bad_flags = true;
+									}
+								}
 							} else {
-								gb_printf_err("-lto:<string> options are 'thin' and 'thin-files'\n");
+								gb_printf_err("-lto:<string> options are 'thin', 'thin-files', and 'full'\n");
 								bad_flags = true;
 							}
 							break;
 
-
-					#if defined(GB_SYSTEM_WINDOWS)
-						case BuildFlag_IgnoreVsSearch: {
-							GB_ASSERT(value.kind == ExactValue_Invalid);
-							build_context.ignore_microsoft_magic = true;
-							break;
-						}
-						case BuildFlag_ResourceFile: {
+						case BuildFlag_PGO: {
 							GB_ASSERT(value.kind == ExactValue_String);
-							String path = value.value_string;
-							path = string_trim_whitespace(path);
-							if (is_build_flag_path_valid(path)) {
-								bool is_resource = string_ends_with(path, str_lit(".rc")) || string_ends_with(path, str_lit(".res"));
-								if(!is_resource) {
-									gb_printf_err("Invalid -resource path %.*s, missing .rc or .res file\n", LIT(path));
+							String str = string_trim_whitespace(value.value_string);
+							String use_prefix = str_lit("use=");
+							if (str_eq_ignore_case(str, str_lit("generate"))) {
+								build_context.pgo_kind = PGO_Generate;
+							} else if (string_starts_with(str, use_prefix)) {
+								String path = substring(str, use_prefix.len, str.len);
+								if (!is_build_flag_path_valid(path)) {
+									gb_printf_err("Invalid -pgo:use=<filename> path, got %.*s\n", LIT(path));
 									bad_flags = true;
 									break;
-								} else if (!gb_file_exists((const char *)path.text)) {
-									gb_printf_err("Invalid -resource path %.*s, file does not exist.\n", LIT(path));
+								}
+								path = path_to_full_path(heap_allocator(), path);
+								if (!gb_file_exists(cast(char const *)path.text)) {
+									gb_printf_err("Invalid -pgo:use=<filename> path, file does not exist: %.*s\n", LIT(path));
 									bad_flags = true;
 									break;
 								}
-								build_context.resource_filepath = path;
+								build_context.pgo_kind = PGO_Use;
+								build_context.pgo_profile_path = path;
+							} else {
+								gb_printf_err("-pgo:<string> options are 'generate' and 'use=<filename>'\n");
+								bad_flags = true;
+							}
+							break;
+						}
+
+						case BuildFlag_ProfileFriendly:
+							build_context.profile_friendly = true;
+							break;
+
+						case BuildFlag_ISel: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String str = string_trim_whitespace(value.value_string);
+							if (str_eq_ignore_case(str, str_lit("default"))) {
+								build_context.isel_kind = ISel_Default;
+							} else if (str_eq_ignore_case(str, str_lit("fast"))) {
+								build_context.isel_kind = ISel_Fast;
+							} else if (str_eq_ignore_case(str, str_lit("global"))) {
+								build_context.isel_kind = ISel_Global;
+							} else {
+								gb_printf_err("-isel:<string> options are 'default', 'fast', and 'global'\n");
+								bad_flags = true;
+							}
+							break;
+						}
+
+						case BuildFlag_OptRemarks: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String str = string_trim_whitespace(value.value_string);
+							if (str.len == 0) {
+								gb_printf_err("-opt-remarks:<string> expects 'all' or a regular expression matching the names of the LLVM passes\n");
+								bad_flags = true;
+								break;
+							}
+							build_context.opt_remarks = str;
+							break;
+						}
+
+						case BuildFlag_OptRemarksFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (!is_build_flag_path_valid(path)) {
+								gb_printf_err("Invalid -opt-remarks-file path, got %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							build_context.opt_remarks_file = path;
+							break;
+						}
+
+						case BuildFlag_PostLinkOptimize:
+							build_context.post_link_optimize = true;
+							break;
+
+						case BuildFlag_SymbolOrderingFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (!is_build_flag_path_valid(path)) {
+								gb_printf_err("Invalid -symbol-ordering-file path, got %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							path = path_to_full_path(heap_allocator(), path);
+							if (!gb_file_exists(cast(char const *)path.text)) {
+								gb_printf_err("Invalid -symbol-ordering-file path, file does not exist: %.*s\n", LIT(path));
+								bad_flags = true;
+								break;
+							}
+							build_context.symbol_ordering_file = path;
+							break;
+						}
+
+
+					#if defined(GB_SYSTEM_WINDOWS)
+						case BuildFlag_IgnoreVsSearch: {
+							GB_ASSERT(value.kind == ExactValue_Invalid);
+							build_context.ignore_microsoft_magic = true;
+							break;
+						}
+						case BuildFlag_ResourceFile: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = value.value_string;
+							path = string_trim_whitespace(path);
+							if (is_build_flag_path_valid(path)) {
+								bool is_resource = string_ends_with(path, str_lit(".rc")) || string_ends_with(path, str_lit(".res"));
+								if(!is_resource) {
+									gb_printf_err("Invalid -resource path %.*s, missing .rc or .res file\n", LIT(path));
+									bad_flags = true;
+									break;
+								} else if (!gb_file_exists((const char *)path.text)) {
+									gb_printf_err("Invalid -resource path %.*s, file does not exist.\n", LIT(path));
+									bad_flags = true;
+									break;
+								}
+								build_context.resource_filepath = path;
 								build_context.has_resource = true;
 							} else {
 								gb_printf_err("Invalid -resource path, got %.*s\n", LIT(path));
@@ -1935,6 +2627,15 @@ gb_internal bool parse_build_flags(Array<String> args) {
 		bad_flags = true;
 	}
 
+	global_memory_accounting = build_context.show_more_timings || build_context.export_timings_format == TimingsExportJson;
+	global_trace_enabled = build_context.export_timings_format == TimingsExportTrace;
+	global_perf_counters_enabled = build_context.show_perf_counters;
+	if (build_context.show_lock_contention) {
+		lock_contention_enable();
+		name_global_mutexes();
+	}
+	perf_counters_open_for_thread();
+
 
 	if (build_context.export_dependencies_format != DependenciesExportUnspecified && build_context.print_linker_flags) {
 		gb_printf_err("-export-dependencies cannot be used with -print-linker-flags\n");
@@ -1950,11 +2651,244 @@ gb_internal bool parse_build_flags(Array<String> args) {
 		bad_flags = true;
 	}
 
+	if (build_context.check_file.len != 0 && build_context.show_unused) {
+		gb_printf_err("`-check-file` cannot be used with `-show-unused` or `-show-unused-with-location`.\n");
+		bad_flags = true;
+	}
+
+	if (build_context.test_shards && !build_context.test_all_packages) {
+		gb_printf_err("`-test-shards` can only be used together with `-all-packages`.\n");
+		bad_flags = true;
+	}
+
+	if (build_context.test_shards && build_context.benchmark) {
+		gb_printf_err("`-test-shards` cannot be used with `odin bench` as the benchmarks would be run in parallel.\n");
+		bad_flags = true;
+	}
+
 	if (build_context.did_you_mean_limit == 0) build_context.did_you_mean_limit = DEFAULT_DID_YOU_MEAN_LIMIT;
 
 	return !bad_flags;
 }
 
+// NOTE: Counts for -show-stats, so that how each stage scales with the size of the program can be
+// compared between builds rather than only how long it took
+struct CompilerStatsModule {
+	char const *name;
+	isize       functions;
+	isize       instructions;
+	isize       globals;
+};
+
+struct CompilerStats {
+	isize packages;
+	isize files;
+	isize tokens;
+	isize ast_nodes[Ast_COUNT];
+	isize entities[Entity_Count];
+	isize types[Type_Count];
+	isize scopes;
+	isize polymorphic_procedures;
+	isize polymorphic_types;
+	isize min_dep_entities;
+	isize type_info_entries;
+
+	Array<CompilerStatsModule> modules;
+	i64                        object_bytes;
+};
+
+gb_global CompilerStats global_compiler_stats;
+
+gb_internal void gather_compiler_stats(Checker *c) {
+	CompilerStats *s = &global_compiler_stats;
+	Parser *p = c->parser;
+	s->packages = p->packages.count;
+	s->files    = 0;
+	s->tokens   = p->total_token_count;
+	for (AstPackage *pkg : p->packages) {
+		s->files += pkg->files.count;
+	}
+
+	for (isize i = 0; i < Ast_COUNT; i++) {
+		s->ast_nodes[i] = global_ast_node_counts[i].load(std::memory_order_relaxed);
+	}
+	for (isize i = 0; i < Type_Count; i++) {
+		s->types[i] = global_type_counts[i].load(std::memory_order_relaxed);
+	}
+	s->scopes = global_scope_count.load(std::memory_order_relaxed);
+
+	gb_zero_array(s->entities, Entity_Count);
+	s->polymorphic_procedures = 0;
+	s->polymorphic_types      = 0;
+	s->min_dep_entities       = 0;
+	u64 entity_count = global_entity_id.load(std::memory_order_acquire);
+	for (u64 id = 1; id <= entity_count; id++) {
+		Entity *e = entity_from_id(cast(u32)id);
+		if (e == nullptr) {
+			continue;
+		}
+		s->entities[e->kind] += 1;
+		if (e->min_dep_count.load(std::memory_order_relaxed) > 0) {
+			s->min_dep_entities += 1;
+		}
+		if (e->kind == Entity_Procedure && e->Procedure.gen_procs != nullptr) {
+			s->polymorphic_procedures += e->Procedure.gen_procs->procs.count;
+		} else if (e->kind == Entity_TypeName && e->type != nullptr && e->type->kind == Type_Named &&
+		           e->type->Named.type_name == e && e->type->Named.gen_types_data != nullptr) {
+			s->polymorphic_types += e->type->Named.gen_types_data->types.count;
+		}
+	}
+	s->type_info_entries = cast(isize)c->info.min_dep_type_info_set.count;
+}
+
+// NOTE: Called once the code has been generated, as the objects are removed after linking
+gb_internal void gather_compiler_stats_from_generator(lbGenerator *gen) {
+	CompilerStats *s = &global_compiler_stats;
+	array_init(&s->modules, heap_allocator(), 0, gen->modules.count);
+	for (auto const &entry : gen->modules) {
+		lbModule *m = entry.value;
+		lb_gather_module_stats(m);
+		if (m->stats.functions == 0 && m->stats.globals == 0) {
+			continue;
+		}
+		CompilerStatsModule sm = {};
+		sm.name         = m->module_name;
+		sm.functions    = m->stats.functions;
+		sm.instructions = m->stats.instructions;
+		sm.globals      = m->stats.globals;
+		array_add(&s->modules, sm);
+	}
+	array_sort(s->modules, [](void const *a, void const *b) -> int {
+		isize x = (cast(CompilerStatsModule const *)a)->instructions;
+		isize y = (cast(CompilerStatsModule const *)b)->instructions;
+		return x < y ? +1 : x > y ? -1 : 0;
+	});
+
+	s->object_bytes = 0;
+	for (String const &path : gen->output_object_paths) {
+		gbFile f = {};
+		char const *path_c = alloc_cstring(heap_allocator(), path);
+		if (gb_file_open(&f, path_c) == gbFileError_None) {
+			s->object_bytes += gb_file_size(&f);
+			gb_file_close(&f);
+		}
+		gb_free(heap_allocator(), cast(void *)path_c);
+	}
+}
+
+gb_internal void print_compiler_stats(void) {
+	CompilerStats *s = &global_compiler_stats;
+
+	isize total_ast_nodes = 0;
+	isize total_entities  = 0;
+	isize total_types     = 0;
+	for (isize i = 0; i < Ast_COUNT;    i++) { total_ast_nodes += s->ast_nodes[i]; }
+	for (isize i = 0; i < Entity_Count; i++) { total_entities  += s->entities[i];  }
+	for (isize i = 0; i < Type_Count;   i++) { total_types     += s->types[i];     }
+
+	gb_printf("\nCompiler Statistics\n");
+	gb_printf("\tpackages:                %td\n", s->packages);
+	gb_printf("\tfiles:                   %td\n", s->files);
+	gb_printf("\ttokens:                  %td\n", s->tokens);
+	gb_printf("\tAST nodes:               %td\n", total_ast_nodes);
+	gb_printf("\tentities:                %td\n", total_entities);
+	gb_printf("\ttypes:                   %td\n", total_types);
+	gb_printf("\tscopes:                  %td\n", s->scopes);
+	gb_printf("\tpolymorphic procedures:  %td\n", s->polymorphic_procedures);
+	gb_printf("\tpolymorphic types:       %td\n", s->polymorphic_types);
+	gb_printf("\tmin dep entities:        %td\n", s->min_dep_entities);
+	gb_printf("\ttype info entries:       %td\n", s->type_info_entries);
+	if (s->modules.count != 0) {
+		isize functions    = 0;
+		isize instructions = 0;
+		isize globals      = 0;
+		for (CompilerStatsModule const &sm : s->modules) {
+			functions    += sm.functions;
+			instructions += sm.instructions;
+			globals      += sm.globals;
+		}
+		gb_printf("\tLLVM modules:            %td\n", s->modules.count);
+		gb_printf("\tLLVM functions:          %td\n", functions);
+		gb_printf("\tLLVM instructions:       %td\n", instructions);
+		gb_printf("\tLLVM globals:            %td\n", globals);
+		gb_printf("\tobject bytes:            %lld\n", cast(long long)s->object_bytes);
+	}
+
+	// NOTE: The counts come first, as gb_printf does not pad left-justified strings
+	gb_printf("\n\t%12s  %s\n", "count", "AST node kind");
+	for (isize i = 0; i < Ast_COUNT; i++) {
+		if (s->ast_nodes[i] != 0) {
+			gb_printf("\t%12td  %.*s\n", s->ast_nodes[i], LIT(ast_strings[i]));
+		}
+	}
+	gb_printf("\n\t%12s  %s\n", "count", "entity kind");
+	for (isize i = 0; i < Entity_Count; i++) {
+		if (s->entities[i] != 0) {
+			gb_printf("\t%12td  %.*s\n", s->entities[i], LIT(entity_strings[i]));
+		}
+	}
+	gb_printf("\n\t%12s  %s\n", "count", "type kind");
+	for (isize i = 0; i < Type_Count; i++) {
+		if (s->types[i] != 0) {
+			gb_printf("\t%12td  %.*s\n", s->types[i], LIT(type_strings[i]));
+		}
+	}
+	if (s->modules.count != 0) {
+		gb_printf("\n\t%10s %14s %10s  %s\n", "functions", "instructions", "globals", "LLVM module");
+		for (CompilerStatsModule const &sm : s->modules) {
+			gb_printf("\t%10td %14td %10td  %s\n", sm.functions, sm.instructions, sm.globals, sm.name);
+		}
+	}
+}
+
+gb_internal void compiler_stats_export_json(gbFile *f) {
+	CompilerStats *s = &global_compiler_stats;
+
+	gb_fprintf(f, "\t\"stats\": {\n");
+	gb_fprintf(f, "\t\t\"packages\": %td,\n", s->packages);
+	gb_fprintf(f, "\t\t\"files\": %td,\n", s->files);
+	gb_fprintf(f, "\t\t\"tokens\": %td,\n", s->tokens);
+	gb_fprintf(f, "\t\t\"scopes\": %td,\n", s->scopes);
+	gb_fprintf(f, "\t\t\"polymorphic_procedures\": %td,\n", s->polymorphic_procedures);
+	gb_fprintf(f, "\t\t\"polymorphic_types\": %td,\n", s->polymorphic_types);
+	gb_fprintf(f, "\t\t\"min_dep_entities\": %td,\n", s->min_dep_entities);
+	gb_fprintf(f, "\t\t\"type_info_entries\": %td,\n", s->type_info_entries);
+	gb_fprintf(f, "\t\t\"object_bytes\": %lld,\n", cast(long long)s->object_bytes);
+
+	// NOTE: The markers between the groups of node kinds have no name and are never allocated
+	gb_fprintf(f, "\t\t\"ast_nodes\": {");
+	char const *sep = "";
+	for (isize i = 0; i < Ast_COUNT; i++) {
+		if (ast_strings[i].len != 0) {
+			gb_fprintf(f, "%s\"%.*s\": %td", sep, LIT(ast_strings[i]), s->ast_nodes[i]);
+			sep = ", ";
+		}
+	}
+	gb_fprintf(f, "},\n");
+
+	gb_fprintf(f, "\t\t\"entities\": {");
+	for (isize i = 0; i < Entity_Count; i++) {
+		gb_fprintf(f, "%s\"%.*s\": %td", i ? ", " : "", LIT(entity_strings[i]), s->entities[i]);
+	}
+	gb_fprintf(f, "},\n");
+
+	gb_fprintf(f, "\t\t\"types\": {");
+	for (isize i = 0; i < Type_Count; i++) {
+		gb_fprintf(f, "%s\"%.*s\": %td", i ? ", " : "", LIT(type_strings[i]), s->types[i]);
+	}
+	gb_fprintf(f, "},\n");
+
+	gb_fprintf(f, "\t\t\"modules\": [\n");
+	for_array(i, s->modules) {
+		CompilerStatsModule const &sm = s->modules[i];
+		gb_fprintf(f, "\t\t\t{\"name\": \"%s\", \"functions\": %td, \"instructions\": %td, \"globals\": %td}%s\n",
+		    sm.name, sm.functions, sm.instructions, sm.globals, i+1 < s->modules.count ? "," : "");
+	}
+	gb_fprintf(f, "\t\t]\n");
+
+	gb_fprintf(f, "\t},\n");
+}
+
 gb_internal void timings_export_all(Timings *t, Checker *c, bool timings_are_finalized = false) {
 	GB_ASSERT((!(build_context.export_timings_format == TimingsExportUnspecified) && build_context.export_timings_file.len > 0));
 
@@ -2008,25 +2942,40 @@ gb_internal void timings_export_all(Timings *t, Checker *c, bool timings_are_fin
 		gb_fprintf(&f, "\t\t{\"name\": \"total_files\",     \"count\": %td},\n", files);
 		gb_fprintf(&f, "\t\t{\"name\": \"total_lines\",     \"count\": %td},\n", lines);
 		gb_fprintf(&f, "\t\t{\"name\": \"total_tokens\",    \"count\": %td},\n", tokens);
-		gb_fprintf(&f, "\t\t{\"name\": \"total_file_size\", \"count\": %td},\n", total_file_size);
+		gb_fprintf(&f, "\t\t{\"name\": \"total_file_size\", \"count\": %td}\n", total_file_size);
 
 		gb_fprintf(&f, "\t],\n");
 
+		// NOTE: No trailing commas, so that the output is valid JSON for tools such as `tests/benchmark/compiler`
+		if (global_memory_accounting) {
+			gb_fprintf(&f, "\t\"memory\": [\n");
+			for (isize i = 0; i < MemorySubsystem_COUNT; i++) {
+				gb_fprintf(&f, "\t\t{\"name\": \"%s\", \"bytes\": %td}%s\n",
+				    memory_subsystem_names[i], memory_subsystem_bytes(cast(MemorySubsystem)i),
+				    i+1 < MemorySubsystem_COUNT ? "," : "");
+			}
+			gb_fprintf(&f, "\t],\n");
+		}
+
+		if (build_context.show_stats) {
+			compiler_stats_export_json(&f);
+		}
+
 		gb_fprintf(&f, "\t\"timings\": [\n");
 
 		t->total_time_seconds = time_stamp_as_s(t->total, t->freq);
 		f64 total_time = time_stamp(t->total, t->freq, unit);
 
-		gb_fprintf(&f, "\t\t{\"name\": \"%.*s\", \"millis\": %.3f},\n",
+		gb_fprintf(&f, "\t\t{\"name\": \"%.*s\", \"millis\": %.3f}",
 		    LIT(t->total.label), total_time);
 
 		for (TimeStamp const &ts : t->sections) {
 			f64 section_time = time_stamp(ts, t->freq, unit);
-			gb_fprintf(&f, "\t\t{\"name\": \"%.*s\", \"millis\": %.3f},\n",
+			gb_fprintf(&f, ",\n\t\t{\"name\": \"%.*s\", \"millis\": %.3f}",
 			    LIT(ts.label), section_time);
 		}
 
-		gb_fprintf(&f, "\t],\n");
+		gb_fprintf(&f, "\n\t]\n");
 
 		gb_fprintf(&f, "}\n");
 	} else if (build_context.export_timings_format == TimingsExportCSV) {
@@ -2045,6 +2994,11 @@ gb_internal void timings_export_all(Timings *t, Checker *c, bool timings_are_fin
 			f64 section_time = time_stamp(ts, t->freq, unit);
 			gb_fprintf(&f, "\"%.*s\", %d\n", LIT(ts.label), int(section_time));
 		}
+	} else if (build_context.export_timings_format == TimingsExportTrace) {
+		/*
+			Chrome trace export, one track per thread
+		*/
+		timings_export_trace(t, &f);
 	}
 
 	gb_printf("Done.\n");
@@ -2104,7 +3058,7 @@ gb_internal void sort_defineables_and_remove_duplicates(Checker *c) {
 	if (c->info.defineables.count == 0) {
 		return;
 	}
-	gb_sort_array(c->info.defineables.data, c->info.defineables.count, defineables_cmp);
+	array_sort_parallel(c->info.defineables, defineables_cmp);
 
 	Defineable prev = c->info.defineables[0];
 	for (isize i = 1; i < c->info.defineables.count; ) {
@@ -2130,10 +3084,14 @@ gb_internal void export_defineables(Checker *c, String path) {
 	}
 	defer (gb_file_close(&f));
 
+	OutputBuffer out = {};
+	output_buffer_init(&out, &f);
+	defer (output_buffer_destroy(&out));
+
 	gbString docs = gb_string_make(heap_allocator(), "");
 	defer (gb_string_free(docs));
 
-	gb_fprintf(&f, "Defineable,Default Value,Docs,Location\n");
+	output_buffer_printf(&out, "Defineable,Default Value,Docs,Location\n");
 	for_array(i, c->info.defineables) {
 		Defineable *def = &c->info.defineables[i];
 
@@ -2153,54 +3111,92 @@ gb_internal void export_defineables(Checker *c, String path) {
 			docs = gb_string_appendc(docs, "\"");
 		}
 
-		gb_fprintf(&f,"%.*s,%.*s,%s,%.*s\n", LIT(def->name), LIT(def->default_value_str), docs, LIT(def->pos_str));
+		output_buffer_printf(&out, "%.*s,%.*s,%s,%.*s\n", LIT(def->name), LIT(def->default_value_str), docs, LIT(def->pos_str));
 	}
 }
 
 gb_internal void show_defineables(Checker *c) {
+	OutputBuffer *out = stdout_buffer();
 	for_array(i, c->info.defineables) {
 		Defineable *def = &c->info.defineables[i];
 		if (has_ansi_terminal_colours()) {
-			gb_printf("\x1b[0;90m");
+			output_buffer_printf(out, "\x1b[0;90m");
 		}
-		printf("%.*s\n", LIT(def->pos_str));
+		output_buffer_printf(out, "%.*s\n", LIT(def->pos_str));
 		if (def->docs) {
 			for (Token const &token : def->docs->list) {
-				gb_printf("%.*s\n", LIT(token.string));
+				output_buffer_printf(out, "%.*s\n", LIT(token.string));
 			}
 		}
 		if (has_ansi_terminal_colours()) {
-			gb_printf("\x1b[0m");
+			output_buffer_printf(out, "\x1b[0m");
 		}
-		gb_printf("%.*s :: %.*s\n\n", LIT(def->name), LIT(def->default_value_str));
+		output_buffer_printf(out, "%.*s :: %.*s\n\n", LIT(def->name), LIT(def->default_value_str));
+	}
+	output_buffer_flush(out);
+}
+
+gb_internal GB_COMPARE_PROC(unroll_report_cmp) {
+	UnrollReport *x = (UnrollReport *)a;
+	UnrollReport *y = (UnrollReport *)b;
+	if (x->expanded_nodes != y->expanded_nodes) {
+		return x->expanded_nodes > y->expanded_nodes ? -1 : +1;
 	}
+	return x->node < y->node ? -1 : x->node > y->node;
+}
+
+gb_internal void show_unroll_report(Checker *c) {
+	auto &reports = c->info.unroll_reports;
+	if (reports.count == 0) {
+		return;
+	}
+	gb_sort_array(reports.data, reports.count, unroll_report_cmp);
+
+	i64 total_expanded = 0;
+	gb_printf("'#unroll for' report (sizes in checked AST nodes):\n");
+	gb_printf("%12s %10s %12s  location\n", "expanded", "iterations", "body");
+	for_array(i, reports) {
+		UnrollReport const &r = reports[i];
+		// NOTE: bodies of polymorphic procedures are checked once per instantiation
+		if (i > 0 && reports[i-1].node == r.node && reports[i-1].expanded_nodes == r.expanded_nodes) {
+			continue;
+		}
+		total_expanded += r.expanded_nodes;
+
+		TokenPos pos = ast_token(r.node).pos;
+		gb_printf("%12lld %10lld %12lld  %s\n",
+		          cast(long long)r.expanded_nodes, cast(long long)r.iterations, cast(long long)r.body_nodes,
+		          token_pos_to_string(pos));
+	}
+	gb_printf("%12lld total\n\n", cast(long long)total_expanded);
 }
 
 gb_internal void show_import_graph(Checker *c) {
+	OutputBuffer *out = stdout_buffer();
 	Parser *p = c->parser;
 
-	gb_printf("digraph odin_import_graph {\n\tnode [shape=box];\n");
+	output_buffer_printf(out, "digraph odin_import_graph {\n\tnode [shape=box];\n");
 
 	int cluster_counter = 0;
 	for (LibraryCollections coll : library_collections) {
-		gb_printf("\tsubgraph cluster_%i {\n", cluster_counter);
-		gb_printf("\t\tlabel = \"%.*s\";\n", LIT(coll.name));
-		gb_printf("\t\tnode [style=filled, fillcolor=white];\n");
+		output_buffer_printf(out, "\tsubgraph cluster_%i {\n", cluster_counter);
+		output_buffer_printf(out, "\t\tlabel = \"%.*s\";\n", LIT(coll.name));
+		output_buffer_printf(out, "\t\tnode [style=filled, fillcolor=white];\n");
 		if (coll.name =="core") {
-			gb_printf("\t\tbgcolor = lightsalmon;\n");
+			output_buffer_printf(out, "\t\tbgcolor = lightsalmon;\n");
 		} else if (coll.name =="vendor") {
-			gb_printf("\t\tbgcolor = lightblue;\n");
+			output_buffer_printf(out, "\t\tbgcolor = lightblue;\n");
 		} else if (coll.name =="base") {
-			gb_printf("\t\tbgcolor = lightcoral;\n");
-			gb_printf("\t\tintrinsics;\n");
-			gb_printf("\t\tbuiltin;\n");
+			output_buffer_printf(out, "\t\tbgcolor = lightcoral;\n");
+			output_buffer_printf(out, "\t\tintrinsics;\n");
+			output_buffer_printf(out, "\t\tbuiltin;\n");
 		}
 		for (AstPackage *pkg : p->packages) {
 			if (string_starts_with(pkg->fullpath, coll.path)) {
-				gb_printf("\t\t\"%.*s\";\n", LIT(pkg->fullpath));
+				output_buffer_printf(out, "\t\t\"%.*s\";\n", LIT(pkg->fullpath));
 			}
 		}
-		gb_printf("\t}\n");
+		output_buffer_printf(out, "\t}\n");
 		cluster_counter += 1;
 	}
 
@@ -2234,12 +3230,13 @@ gb_internal void show_import_graph(Checker *c) {
 					path = imp->ImportDecl.package->fullpath;
 				}
 
-				gb_printf("\t\"%.*s\" -> \"%.*s\";\n", LIT(pkg->fullpath), LIT(path));
+				output_buffer_printf(out, "\t\"%.*s\" -> \"%.*s\";\n", LIT(pkg->fullpath), LIT(path));
 			}
 		}
 	}
 
-	gb_printf("}\n\n");
+	output_buffer_printf(out, "}\n\n");
+	output_buffer_flush(out);
 }
 
 gb_internal void show_timings(Checker *c, Timings *t) {
@@ -2262,7 +3259,16 @@ gb_internal void show_timings(Checker *c, Timings *t) {
 
 	timings_print_all(t);
 
+	gb_printf_err("\nThread Count: %td (%s)\n", build_context.thread_count, build_context.thread_count_reason);
+
+	if (build_context.show_stats) {
+		gather_compiler_stats(c);
+		print_compiler_stats();
+	}
+
 	PRINT_PEAK_USAGE();
+	print_memory_subsystem_usage();
+	lb_print_isel_fallbacks();
 
 	if (!(build_context.export_timings_format == TimingsExportUnspecified)) {
 		timings_export_all(t, c, true);
@@ -2376,6 +3382,12 @@ gb_internal GB_COMPARE_PROC(file_path_cmp) {
 	return string_compare(x->fullpath, y->fullpath);
 }
 
+gb_internal GB_COMPARE_PROC(package_path_cmp) {
+	AstPackage *x = *(AstPackage **)a;
+	AstPackage *y = *(AstPackage **)b;
+	return string_compare(x->fullpath, y->fullpath);
+}
+
 gb_internal void export_dependencies(Checker *c) {
 	GB_ASSERT(build_context.export_dependencies_format != DependenciesExportUnspecified);
 
@@ -2397,6 +3409,10 @@ gb_internal void export_dependencies(Checker *c) {
 	}
 	defer (gb_file_close(&f));
 
+	OutputBuffer out = {};
+	output_buffer_init(&out, &f);
+	defer (output_buffer_destroy(&out));
+
 
 	auto files = array_make<AstFile *>(heap_allocator());
 	for (AstPackage *pkg : p->packages) {
@@ -2415,13 +3431,13 @@ gb_internal void export_dependencies(Checker *c) {
 		}
 		array_add(&load_files, cache);
 	}
-	array_sort(files, file_cache_sort_cmp);
+	array_sort(load_files, file_cache_sort_cmp);
 
 	if (build_context.export_dependencies_format == DependenciesExportMake) {
 		String exe_name = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
 		defer (gb_free(heap_allocator(), exe_name.text));
 
-		gb_fprintf(&f, "%.*s:", LIT(exe_name));
+		output_buffer_printf(&out, "%.*s:", LIT(exe_name));
 
 		isize current_line_length = exe_name.len + 1;
 
@@ -2429,55 +3445,119 @@ gb_internal void export_dependencies(Checker *c) {
 			AstFile *file = files[i];
 			/* Arbitrary line break value. Maybe make this better? */
 			if (current_line_length >= 80-2) {
-				gb_file_write(&f, " \\\n ", 4);
+				output_buffer_write_string(&out, str_lit(" \\\n "));
 				current_line_length = 1;
 			}
 
-			gb_file_write(&f, " ", 1);
+			output_buffer_write_byte(&out, ' ');
 			current_line_length++;
 
 			for (isize k = 0; k < file->fullpath.len; k++) {
 				char part = file->fullpath.text[k];
 				if (part == ' ') {
-					gb_file_write(&f, "\\", 1);
+					output_buffer_write_byte(&out, '\\');
 					current_line_length++;
 				}
-				gb_file_write(&f, &part, 1);
+				output_buffer_write_byte(&out, part);
 				current_line_length++;
 			}
 		}
 
-		gb_fprintf(&f, "\n");
+		output_buffer_printf(&out, "\n");
 	} else if (build_context.export_dependencies_format == DependenciesExportJson) {
-		gb_fprintf(&f, "{\n");
+		output_buffer_printf(&out, "{\n");
 
-		gb_fprintf(&f, "\t\"source_files\": [\n");
+		output_buffer_printf(&out, "\t\"source_files\": [\n");
 
 		for_array(i, files) {
 			AstFile *file = files[i];
-			gb_fprintf(&f, "\t\t\"%.*s\"", LIT(file->fullpath));
+			output_buffer_printf(&out, "\t\t\"%.*s\"", LIT(file->fullpath));
 			if (i+1 < files.count) {
-				gb_fprintf(&f, ",");
+				output_buffer_printf(&out, ",");
 			}
-			gb_fprintf(&f, "\n");
+			output_buffer_printf(&out, "\n");
 		}
 
-		gb_fprintf(&f, "\t],\n");
+		output_buffer_printf(&out, "\t],\n");
 
-		gb_fprintf(&f, "\t\"load_files\": [\n");
+		output_buffer_printf(&out, "\t\"load_files\": [\n");
 
 		for_array(i, load_files) {
 			LoadFileCache *cache = load_files[i];
-			gb_fprintf(&f, "\t\t\"%.*s\"", LIT(cache->path));
+			output_buffer_printf(&out, "\t\t\"%.*s\"", LIT(cache->path));
 			if (i+1 < load_files.count) {
-				gb_fprintf(&f, ",");
+				output_buffer_printf(&out, ",");
 			}
-			gb_fprintf(&f, "\n");
+			output_buffer_printf(&out, "\n");
 		}
 
-		gb_fprintf(&f, "\t]\n");
+		output_buffer_printf(&out, "\t],\n");
 
-		gb_fprintf(&f, "}\n");
+		// NOTE: The exact import edges of each package, so that an external build system
+		// can tell which packages are affected by a change to any one of them
+		auto packages = array_make<AstPackage *>(heap_allocator(), 0, p->packages.count);
+		defer (array_free(&packages));
+		for (AstPackage *pkg : p->packages) {
+			array_add(&packages, pkg);
+		}
+		array_sort(packages, package_path_cmp);
+
+		output_buffer_printf(&out, "\t\"packages\": [\n");
+
+		for_array(i, packages) {
+			AstPackage *pkg = packages[i];
+
+			auto pkg_files = array_make<AstFile *>(heap_allocator(), 0, pkg->files.count);
+			defer (array_free(&pkg_files));
+			auto imports = array_make<String>(heap_allocator());
+			defer (array_free(&imports));
+
+			StringSet seen = {};
+			string_set_init(&seen);
+			defer (string_set_destroy(&seen));
+
+			for (AstFile *file : pkg->files) {
+				array_add(&pkg_files, file);
+				for (Ast *decl : file->imports) {
+					// NOTE: `base:builtin` and `base:intrinsics` have no package of their own
+					if (decl->kind != Ast_ImportDecl || decl->ImportDecl.package == nullptr) {
+						continue;
+					}
+					String path = decl->ImportDecl.package->fullpath;
+					if (path != pkg->fullpath && !string_set_update(&seen, path)) {
+						array_add(&imports, path);
+					}
+				}
+			}
+			array_sort(pkg_files, file_path_cmp);
+			array_sort(imports, string_cmp);
+
+			output_buffer_printf(&out, "\t\t{\n");
+			output_buffer_printf(&out, "\t\t\t\"name\": \"%.*s\",\n", LIT(pkg->name));
+			output_buffer_printf(&out, "\t\t\t\"path\": \"%.*s\",\n", LIT(pkg->fullpath));
+
+			output_buffer_printf(&out, "\t\t\t\"files\": [");
+			for_array(j, pkg_files) {
+				output_buffer_printf(&out, "%s\n\t\t\t\t\"%.*s\"", j > 0 ? "," : "", LIT(pkg_files[j]->fullpath));
+			}
+			output_buffer_printf(&out, "%s],\n", pkg_files.count > 0 ? "\n\t\t\t" : "");
+
+			output_buffer_printf(&out, "\t\t\t\"imports\": [");
+			for_array(j, imports) {
+				output_buffer_printf(&out, "%s\n\t\t\t\t\"%.*s\"", j > 0 ? "," : "", LIT(imports[j]));
+			}
+			output_buffer_printf(&out, "%s]\n", imports.count > 0 ? "\n\t\t\t" : "");
+
+			output_buffer_printf(&out, "\t\t}");
+			if (i+1 < packages.count) {
+				output_buffer_printf(&out, ",");
+			}
+			output_buffer_printf(&out, "\n");
+		}
+
+		output_buffer_printf(&out, "\t]\n");
+
+		output_buffer_printf(&out, "}\n");
 	}
 }
 
@@ -2565,6 +3645,9 @@ gb_internal void remove_temp_files(lbGenerator *gen) {
 		case BuildMode_StaticLibrary:
 		case BuildMode_DynamicLibrary:
 			for (String const &path : gen->output_object_paths) {
+				if (linker_is_cached_foreign_asm_object(gen, path)) {
+					continue;
+				}
 				gb_file_remove(cast(char const *)path.text);
 			}
 			break;
@@ -2573,6 +3656,95 @@ gb_internal void remove_temp_files(lbGenerator *gen) {
 }
 
 
+// NOTE: Only the whitespace separated words which look like canonical names are rewritten, so that
+// the output of e.g. `perf script` can be piped through as a whole. A trailing `+0x1f` offset is kept.
+gb_internal gbString demangle_line(gbString out, String line, bool strip_types) {
+	isize i = 0;
+	while (i < line.len) {
+		isize start = i;
+		while (i < line.len && gb_char_is_space(cast(char)line[i])) {
+			i += 1;
+		}
+		out = gb_string_append_length(out, line.text+start, i-start);
+
+		start = i;
+		while (i < line.len && !gb_char_is_space(cast(char)line[i])) {
+			i += 1;
+		}
+		String word = substring(line, start, i);
+		if (!string_contains_string(word, str_lit("::")) || string_index_byte(word, '<') >= 0) {
+			out = gb_string_append_length(out, word.text, word.len);
+			continue;
+		}
+
+		String offset = {};
+		isize plus = string_index_byte(word, '+');
+		if (plus > 0 && string_starts_with(substring(word, plus, word.len), str_lit("+0x"))) {
+			offset = substring(word, plus, word.len);
+			word = substring(word, 0, plus);
+		}
+		out = canonical_demangle_name(out, word, strip_types);
+		out = gb_string_append_length(out, offset.text, offset.len);
+	}
+	return out;
+}
+
+gb_internal int demangle_command(Array<String> const &args) {
+	bool strip_types = false;
+	isize name_count = 0;
+	for (isize i = 2; i < args.count; i++) {
+		if (args[i] == "-strip-types") {
+			strip_types = true;
+		} else if (string_starts_with(args[i], '-')) {
+			gb_printf_err("Unknown flag for 'demangle': '%.*s'\n", LIT(args[i]));
+			return 1;
+		} else {
+			name_count += 1;
+		}
+	}
+
+	if (name_count > 0) {
+		for (isize i = 2; i < args.count; i++) {
+			if (string_starts_with(args[i], '-')) {
+				continue;
+			}
+			gbString out = canonical_demangle_name(gb_string_make(heap_allocator(), ""), args[i], strip_types);
+			gb_printf("%s\n", out);
+			gb_string_free(out);
+		}
+		return 0;
+	}
+
+	// NOTE: Act as a filter over the standard input, flushing after every line
+	gbString line = gb_string_make(heap_allocator(), "");
+	gbString out = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(line));
+	defer (gb_string_free(out));
+	for (;;) {
+		int c = fgetc(stdin);
+		if (c != EOF && c != '\n') {
+			char ch = cast(char)c;
+			line = gb_string_append_length(line, &ch, 1);
+			continue;
+		}
+		if (c == EOF && gb_string_length(line) == 0) {
+			break;
+		}
+		gb_string_clear(out);
+		out = demangle_line(out, make_string(cast(u8 const *)line, gb_string_length(line)), strip_types);
+		fwrite(out, 1, gb_string_length(out), stdout);
+		if (c == '\n') {
+			fputc('\n', stdout);
+		}
+		fflush(stdout);
+		gb_string_clear(line);
+		if (c == EOF) {
+			break;
+		}
+	}
+	return 0;
+}
+
 gb_internal int print_show_help(String const arg0, String command, String optional_flag = {}) {
 	bool help_resolved = false;
 	bool printed_usage_header = false;
@@ -2604,6 +3776,13 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		print_usage_line(3, "odin build .                     Builds package in current directory.");
 		print_usage_line(3, "odin build <dir>                 Builds package in <dir>.");
 		print_usage_line(3, "odin build filename.odin -file   Builds single-file package, must contain entry point.");
+	} else if (command == "build-many") {
+		print_usage_header_once();
+		print_usage_line(1, "build-many   Compiles several directories of .odin files, each as its own executable.");
+		print_usage_line(2, "All of them are built with the same flags, concurrently.");
+		print_usage_line(2, "Each output is named after its package, so `-out` cannot be used.");
+		print_usage_line(2, "Examples:");
+		print_usage_line(3, "odin build-many tools/a tools/b -o:speed   Builds tools/a and tools/b.");
 	} else if (command == "run") {
 		print_usage_header_once();
 		print_usage_line(1, "run     Same as 'build', but also then runs the newly compiled executable.");
@@ -2622,6 +3801,16 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	} else if (command == "test") {
 		print_usage_header_once();
 		print_usage_line(1, "test    Builds and runs procedures with the attribute @(test) in the initial package.");
+	} else if (command == "bench") {
+		print_usage_header_once();
+		print_usage_line(1, "bench   Builds and runs procedures with the attribute @(benchmark) in the initial package.");
+		print_usage_line(2, "This is 'odin test' for benchmarks, built with '-o:speed' unless another '-o' is given.");
+		print_usage_line(2, "Each benchmark is run alone and timed by 'core:testing', which is configured with defines:");
+		print_usage_line(3, "-define:ODIN_BENCH_JSON_REPORT=<path>   Writes the results as JSON.");
+		print_usage_line(3, "-define:ODIN_BENCH_BASELINE=<path>      Compares against a previous JSON report and fails on regressions.");
+		print_usage_line(3, "-define:ODIN_BENCH_THRESHOLD=<percent>  How much slower than the baseline counts as a regression.");
+		print_usage_line(3, "-define:ODIN_BENCH_CPU=<n>              Pins the benchmarks to the given CPU.");
+		print_usage_line(2, "See 'core:testing' for the others.");
 	} else if (command == "doc") {
 		print_usage_header_once();
 		print_usage_line(1, "doc     Generates documentation from a directory of .odin files.");
@@ -2647,12 +3836,20 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	} else if (command == "root") {
 		print_usage_header_once();
 		print_usage_line(1, "root    Prints the root path where Odin looks for the builtin collections.");
+	} else if (command == "demangle") {
+		print_usage_header_once();
+		print_usage_line(1, "demangle [-strip-types] [symbols]   Turns the symbol names of Odin procedures into readable names.");
+		print_usage_line(2, "Without any symbols, the standard input is filtered instead, e.g. `perf script | odin demangle`.");
+		print_usage_line(2, "-strip-types drops the types of polymorphic procedures, which is useful to merge them in flamegraphs.");
+		print_usage_line(2, "Examples:");
+		print_usage_line(3, "fmt::[fmt.odin]::handle_tag                 -> fmt.handle_tag");
+		print_usage_line(3, "linux::syscall1:proc\"contextless\"(nr:uintptr)->(:int)   -> linux.syscall1 :: proc\"contextless\"(nr:uintptr) -> int");
 	}
 
 	bool doc             = command == "doc";
 	bool build           = command == "build";
-	bool run_or_build    = command == "run" || command == "build" || command == "test";
-	bool test_only       = command == "test";
+	bool run_or_build    = command == "run" || command == "build" || command == "test" || command == "bench";
+	bool test_only       = command == "test" || command == "bench";
 	bool strip_semicolon = command == "strip-semicolon";
 	bool check_only      = command == "check" || strip_semicolon;
 	bool check           = run_or_build || check_only;
@@ -2705,6 +3902,12 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		if (print_flag("-all-packages")) {
 			print_usage_line(2, "Tests all packages imported into the given initial package.");
 		}
+
+		if (print_flag("-test-shards")) {
+			print_usage_line(2, "Used together with -all-packages.");
+			print_usage_line(2, "Builds and runs a separate test executable for each package which contains tests, in parallel.");
+			print_usage_line(2, "Each executable is named after the output with the package name appended, and is cached independently with -cached.");
+		}
 	}
 
 	if (check) {
@@ -2764,6 +3967,24 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		if (print_flag("-debug")) {
 			print_usage_line(2, "Enables debug information, and defines the global constant ODIN_DEBUG to be 'true'. Sets -o:none by default.");
 		}
+
+		if (print_flag("-debug:lines")) {
+			print_usage_line(2, "Only emits the procedures and their line tables, which is enough to symbolize stack traces and profiles.");
+			print_usage_line(2, "Types and variables are not described. ODIN_DEBUG and the optimization level are left unchanged.");
+		}
+
+		if (print_flag("-debug-split")) {
+			print_usage_line(2, "Moves the debug information out of the linked executable into '<output>.debug' with 'objcopy', and adds a debug link to it.");
+			print_usage_line(2, "Requires -debug. Only on ELF targets, Windows and Darwin already keep it separate in a .pdb or .dSYM.");
+		}
+
+		if (print_flag("-compress-debug-sections:<string>")) {
+			print_usage_line(2, "Has the linker compress the debug sections of the output, which also applies to the file written by -debug-split.");
+			print_usage_line(2, "Requires -debug or -debug:lines. Only on ELF targets.");
+			print_usage_line(2, "Choices:");
+			print_usage_line(3, "zlib");
+			print_usage_line(3, "zstd    (needs lld, mold or GNU ld 2.40+, and a debugger which understands it)");
+		}
 	}
 
 	if (check) {
@@ -2841,7 +4062,7 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "Exports dependencies to one of a few formats. Requires `-export-dependencies-file`.");
 			print_usage_line(2, "Available options:");
 				print_usage_line(3, "-export-dependencies:make   Exports in Makefile format");
-				print_usage_line(3, "-export-dependencies:json   Exports in JSON format");
+				print_usage_line(3, "-export-dependencies:json   Exports in JSON format, including the files and the imported packages of each package");
 		}
 
 		if (print_flag("-export-dependencies-file:<filename>")) {
@@ -2849,11 +4070,18 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "Example: -export-dependencies-file:dependencies.d");
 		}
 
+		if (print_flag("-export-symbol-index:<filename>")) {
+			print_usage_line(2, "Exports a memory-mappable index of every definition and identifier use, for go-to-definition and find-references in tools.");
+			print_usage_line(2, "The format can be read with 'core:odin/symbol-index'.");
+			print_usage_line(2, "Example: -export-symbol-index:project.odin-sym");
+		}
+
 		if (print_flag("-export-timings:<format>")) {
 			print_usage_line(2, "Exports timings to one of a few formats. Requires `-show-timings` or `-show-more-timings`.");
 			print_usage_line(2, "Available options:");
 				print_usage_line(3, "-export-timings:json   Exports compile time stats to JSON.");
 				print_usage_line(3, "-export-timings:csv    Exports compile time stats to CSV.");
+				print_usage_line(3, "-export-timings:trace  Exports per-thread timelines in the Chrome trace event format.");
 		}
 
 		if (print_flag("-export-timings-file:<filename>")) {
@@ -2863,6 +4091,14 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	}
 
 	if (run_or_build) {
+		if (print_flag("-exported-symbols-file:<filename>")) {
+			print_usage_line(2, "Only used with `-build-mode:shared`.");
+			print_usage_line(2, "By default a shared library exports every @(export) symbol and hides everything else.");
+			print_usage_line(2, "This restricts the exported symbols to the @(export) names listed in the file, one per line.");
+			print_usage_line(2, "Empty lines and lines starting with '#' are ignored.");
+			print_usage_line(2, "Example: -exported-symbols-file:exports.txt");
+		}
+
 		if (print_flag("-extra-assembler-flags:<string>")) {
 		print_usage_line(2, "Adds extra assembler specific flags in a string.");
 		}
@@ -2936,6 +4172,26 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "If you build your program or test using `odin build`, the compiler does not automatically execute");
 			print_usage_line(2, "the resulting program, and this option is not applicable.");
 		}
+
+		if (print_flag("-jit")) {
+			print_usage_line(2, "Runs the program within the compiler's process through the LLVM JIT, instead of emitting object files and linking an executable.");
+			print_usage_line(2, "Only the host target is supported, and '@(thread_local)' variables are shared between every thread of the program.");
+			print_usage_line(2, "On Windows, foreign imports of static libraries are only supported when a matching .dll is next to the .lib.");
+		}
+	}
+
+	if (check) {
+		if (print_flag("-large-pages")) {
+			print_usage_line(2, "Backs the compiler's permanent arenas with huge pages, which reduces TLB misses on large programs.");
+			print_usage_line(2, "Uses MADV_HUGEPAGE on Linux, and MEM_LARGE_PAGES on Windows, which needs the 'Lock pages in memory' privilege.");
+			print_usage_line(2, "Falls back to normal pages when huge pages are not available.");
+		}
+
+		if (print_flag("-pin-threads")) {
+			print_usage_line(2, "Pins each worker thread to a logical CPU, one per physical core and alternating between the NUMA nodes first.");
+			print_usage_line(2, "The LLVM phases then run at most one task per physical core, rather than one on each of its SMT threads.");
+			print_usage_line(2, "Supported on Linux, and on Windows for the first 64 logical CPUs.");
+		}
 	}
 
 	if (run_or_build) {
@@ -2953,6 +4209,50 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "Choices:");
 			print_usage_line(3, "thin       (one module per package)");
 			print_usage_line(3, "thin-files (one module file)");
+			print_usage_line(3, "full       (all modules merged at link time, for maximum cross-module inlining)");
+			print_usage_line(2, "Thin modes keep a ThinLTO cache in `.odin-cache/thinlto` next to the output, so unchanged modules skip backend code generation when relinking.");
+			print_usage_line(2, "Thin modes run clang (or ODIN_CLANG_PATH) to add the ThinLTO summaries to the bitcode, without it they fall back to full LTO.");
+		}
+
+		if (print_flag("-pgo:<string>")) {
+			print_usage_line(2, "Builds with profile-guided optimization.");
+			print_usage_line(2, "Choices:");
+			print_usage_line(3, "generate          Instruments the program to write a raw profile (default.profraw, or $LLVM_PROFILE_FILE) when it exits.");
+			print_usage_line(3, "use=<filename>    Optimizes using a profile merged with `llvm-profdata merge`.");
+			print_usage_line(2, "Example: -pgo:use=program.profdata");
+		}
+
+		if (print_flag("-isel:<string>")) {
+			print_usage_line(2, "Selects the LLVM instruction selector.");
+			print_usage_line(2, "Choices:");
+			print_usage_line(3, "default    FastISel for -o:none and -o:minimal, SelectionDAG otherwise");
+			print_usage_line(3, "fast       FastISel, falling back to SelectionDAG for individual instructions it cannot handle");
+			print_usage_line(3, "global     GlobalISel, falling back to SelectionDAG for individual procedures; the fallbacks are listed by -show-timings");
+		}
+
+		if (print_flag("-opt-remarks:<string>")) {
+			print_usage_line(2, "Prints the remarks of the LLVM passes whose names match the given regular expression, at the Odin source location they refer to.");
+			print_usage_line(2, "This includes the optimizations which were done, those which were missed, and the analyses explaining why.");
+			print_usage_line(2, "'all' enables the remarks of every pass.");
+			print_usage_line(2, "Example: -opt-remarks:inline|loop-vectorize");
+		}
+
+		if (print_flag("-opt-remarks-file:<filename>")) {
+			print_usage_line(2, "Writes the -opt-remarks remarks as a JSON array to the given file instead of printing them.");
+			print_usage_line(2, "Example: -opt-remarks-file:remarks.json");
+		}
+
+		if (print_flag("-post-link-optimize")) {
+			print_usage_line(2, "Prepares the executable or shared library for a post-link optimizer such as BOLT.");
+			print_usage_line(2, "Every procedure is placed in its own section, even with -o:none, and the linker keeps the relocations with '--emit-relocs'.");
+			print_usage_line(2, "Only on ELF targets.");
+		}
+
+		if (print_flag("-symbol-ordering-file:<filename>")) {
+			print_usage_line(2, "Lays out the procedures in the order of the symbol names listed in the file, one per line, hottest first.");
+			print_usage_line(2, "Such a list is produced by BOLT ('--generate-link-sections'), Propeller or hfsort from a profile of the program.");
+			print_usage_line(2, "Requires -linker:lld or -linker:mold. Only on ELF targets.");
+			print_usage_line(2, "Example: -symbol-ordering-file:hot.txt");
 		}
 	}
 
@@ -2971,6 +4271,13 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	}
 
 	if (run_or_build) {
+		if (print_flag("-max-memory:<size>")) {
+			print_usage_line(2, "Limits the total estimated memory of the modules being optimized and emitted by LLVM at once.");
+			print_usage_line(2, "Modules are held back until they fit, and a module estimated above the limit is processed on its own.");
+			print_usage_line(2, "The size is in bytes, with an optional K, M or G suffix.");
+			print_usage_line(2, "Example: -max-memory:8G");
+		}
+
 		if (print_flag("-microarch:<string>")) {
 			print_usage_line(2, "Specifies the specific micro-architecture for the build in a string.");
 			print_usage_line(2, "Examples:");
@@ -3010,7 +4317,7 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		}
 	}
 
-	if (check && command != "test") {
+	if (check && command != "test" && command != "bench") {
 		if (print_flag("-no-entry-point")) {
 			print_usage_line(2, "Removes default requirement of an entry point (e.g. main procedure).");
 		}
@@ -3057,6 +4364,18 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "The default is -source-code-locations:normal.");
 		}
 
+		if (print_flag("-path-prefix-map:<old>=<new>")) {
+			print_usage_line(2, "Replaces the <old> prefix of the file paths stored in the output (source code locations, #file, #directory, and debug info) with <new>.");
+			print_usage_line(2, "May be given more than once, the last matching map is used.");
+			print_usage_line(2, "Example: -path-prefix-map:/home/ci/build/12345=.");
+		}
+
+		if (print_flag("-deterministic")) {
+			print_usage_line(2, "Produces the same output whatever the thread count and wherever the sources are located.");
+			print_usage_line(2, "Implies -path-prefix-map:<odin root>=odin and -path-prefix-map:<working directory>=.");
+			print_usage_line(2, "Large #load'ed files are embedded as normal data instead of by path, and anonymous procedures are named by their position.");
+		}
+
 
 		if (print_flag("-out:<filepath>")) {
 			print_usage_line(2, "Sets the file name of the outputted executable.");
@@ -3089,6 +4408,13 @@ gb_internal int print_show_help(String const arg0, String command, String option
 	}
 
 	if (run_or_build) {
+		if (print_flag("-profile-friendly")) {
+			print_usage_line(2, "Keeps the frame pointer in every procedure, including the ones generated by the compiler,");
+			print_usage_line(2, "so that profilers such as perf can unwind the stack without DWARF call frame information.");
+			print_usage_line(2, "With -jit, a perf map of the compiled procedures is written to /tmp/perf-<pid>.map.");
+			print_usage_line(2, "Use `odin demangle` to turn the symbol names into readable names.");
+		}
+
 		if (print_flag("-reloc-mode:<string>")) {
 			print_usage_line(2, "Specifies the reloc mode.");
 			print_usage_line(2, "Available options:");
@@ -3098,6 +4424,16 @@ gb_internal int print_show_help(String const arg0, String command, String option
 				print_usage_line(3, "-reloc-mode:dynamic-no-pic");
 		}
 
+		if (print_flag("-rtti:<string>")) {
+			print_usage_line(2, "Specifies how much runtime type information is generated.");
+			print_usage_line(2, "Available options:");
+				print_usage_line(3, "-rtti:full      (default)");
+				print_usage_line(3, "-rtti:minimal   Only types used directly through 'type_info_of', 'typeid_of' or 'any',");
+				print_usage_line(3, "                along with every type reachable from them as an element, field or");
+				print_usage_line(3, "                variant, keep their field names, 'using' flags and tags. Every other");
+				print_usage_line(3, "                type keeps its kind, size and name but has empty field names and tags.");
+		}
+
 		if (print_flag("-stack-protector:<string>")) {
 			print_usage_line(2, "Specifies the stack protector.");
 			print_usage_line(2, "Available options:");
@@ -3123,6 +4459,36 @@ gb_internal int print_show_help(String const arg0, String command, String option
 				print_usage_line(3, "-sanitize:memory");
 				print_usage_line(3, "-sanitize:thread");
 		}
+
+		if (print_flag("-instrumentation-mode:<string>")) {
+			print_usage_line(2, "Sets how procedures are instrumented.");
+			print_usage_line(2, "Available options:");
+			print_usage_line(3, "-instrumentation-mode:calls      Calls the @(instrumentation_enter) and @(instrumentation_exit) procedures. (default)");
+			print_usage_line(3, "-instrumentation-mode:patchable  Only emits a NOP sled at the entry of each procedure, listed in the __patchable_function_entries section.");
+			print_usage_line(3, "                                 These can be patched at runtime to enable tracing, and cost (next to) nothing otherwise.");
+		}
+
+		if (print_flag("-instrumentation-filter:<comma-separated-strings>")) {
+			print_usage_line(2, "Only instruments the procedures whose 'package.procedure' name matches one of the glob patterns, where '*' matches anything.");
+			print_usage_line(2, "Patterns prefixed with '!' exclude the procedures they match instead.");
+			print_usage_line(2, "Example: -instrumentation-filter:\"my_game.*,!my_game.math_*\"");
+		}
+
+		if (print_flag("-instrumentation-min-size:<integer>")) {
+			print_usage_line(2, "Only instruments the procedures with at least that many LLVM instructions before optimization.");
+		}
+
+		if (print_flag("-instrument-allocations")) {
+			print_usage_line(2, "Calls 'runtime.allocation_site_hook', when it is set, before every call to make, new, new_clone, append,");
+			print_usage_line(2, "non_zero_append, delete and free, with a static identifier for the call site and its source location.");
+			print_usage_line(2, "Procedures and files marked as no_instrumentation are skipped.");
+		}
+
+		if (print_flag("-allocation-sites-file:<filename>")) {
+			print_usage_line(2, "Writes the call sites of -instrument-allocations to the given file, one per line, as tab separated");
+			print_usage_line(2, "identifier, kind, procedure and source location, for symbolizing the identifiers offline.");
+			print_usage_line(2, "Example: -allocation-sites-file:alloc_sites.tsv");
+		}
 	}
 
 	if (doc) {
@@ -3158,6 +4524,40 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		if (print_flag("-show-more-timings")) {
 			print_usage_line(2, "Shows an advanced overview of the timings of different stages within the compiler in milliseconds.");
 		}
+
+		if (print_flag("-show-perf-counters")) {
+			print_usage_line(2, "Shows the timings along with the cycles, instructions, cache misses and context switches of each stage, summed over all threads.");
+			print_usage_line(2, "Only supported on Linux, through perf_event_open.");
+		}
+
+		if (print_flag("-show-stats")) {
+			print_usage_line(2, "Shows the timings along with counts of the files, tokens, AST nodes, entities, types, scopes and polymorphic instantiations,");
+			print_usage_line(2, "the entities and types in the minimum dependency set, and the functions, instructions and globals of each LLVM module.");
+			print_usage_line(2, "They are also written to the file given to -export-timings:json.");
+		}
+
+		if (print_flag("-show-lock-contention")) {
+			print_usage_line(2, "Shows the timings along with how often each mutex was acquired, how often a thread had to wait for it, and the total time spent waiting.");
+			print_usage_line(2, "Mutexes of the same kind, e.g. the type cache of every LLVM module, are summed together.");
+		}
+
+		if (print_flag("-show-unroll-report")) {
+			print_usage_line(2, "Shows every '#unroll for' loop with its iteration count and its expanded size in AST nodes, largest first.");
+		}
+
+		if (print_flag("-show-code-size")) {
+			print_usage_line(2, "Shows the machine code and data bytes of the generated object files per package, procedure,");
+			print_usage_line(2, "polymorphic procedure (summed over its instantiations), and the runtime type information.");
+		}
+
+		if (print_flag("-show-stack-usage")) {
+			print_usage_line(2, "Shows the stack frame size of every generated procedure, and a worst case estimate of the stack");
+			print_usage_line(2, "needed by each procedure including everything it may call (from the checker's dependency graph).");
+		}
+
+		if (print_flag("-show-global-init-report")) {
+			print_usage_line(2, "Shows every global variable whose initialization could not be done at compile time and runs at program startup.");
+		}
 	}
 
 	if (check_only) {
@@ -3167,6 +4567,10 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		if (print_flag("-show-unused-with-location")) {
 			print_usage_line(2, "Shows unused package declarations within the current project with the declarations source location.");
 		}
+		if (print_flag("-check-file:<filename>")) {
+			print_usage_line(2, "Only checks the procedure bodies declared within the given file, for editor diagnostics.");
+			print_usage_line(2, "Declarations elsewhere are still checked, but procedure bodies in other files are skipped.");
+		}
 	}
 
 	if (check) {
@@ -3228,6 +4632,8 @@ gb_internal int print_show_help(String const arg0, String command, String option
 				print_usage_line(3, "-target:linux_amd64");
 				print_usage_line(3, "-target:windows_amd64");
 				print_usage_line(3, "-target:\"?\" for a list");
+			print_usage_line(2, "A comma separated list builds each target with its own compiler process, concurrently.");
+			print_usage_line(2, "The outputs are suffixed with the target name, e.g. -target:linux_amd64,linux_arm64 produces foo_linux_amd64 and foo_linux_arm64.");
 		}
 
 		if (print_flag("-terse-errors")) {
@@ -3238,6 +4644,12 @@ gb_internal int print_show_help(String const arg0, String command, String option
 			print_usage_line(2, "Overrides the number of threads the compiler will use to compile with.");
 			print_usage_line(2, "Example: -thread-count:2");
 		}
+
+		if (print_flag("-unroll-budget:<integer>")) {
+			print_usage_line(2, "Warns about any '#unroll for' loop which expands to more than the given number of AST nodes.");
+			print_usage_line(2, "Nested loops are counted in their expanded form.");
+			print_usage_line(2, "Example: -unroll-budget:100000");
+		}
 	}
 
 	if (run_or_build) {
@@ -3330,6 +4742,15 @@ gb_internal int print_show_help(String const arg0, String command, String option
 		}
 	}
 
+	if (run_or_build) {
+		if (print_flag("-wasm-opt")) {
+			print_usage_line(2, "Runs Binaryen's 'wasm-opt' on the linked module of a wasm target, at the level implied by -o.");
+			print_usage_line(2, "'wasm-opt' must be in the PATH. The enabled wasm features are read from the module itself.");
+			print_usage_line(2, "The default -microarch already enables bulk-memory, so memory copies and fills lower to memory.copy and memory.fill.");
+			print_usage_line(2, "SIMD128 can be enabled with -target-features:\"simd128\".");
+		}
+	}
+
 	if (bundle) {
 		print_usage_line(0, "");
 		print_usage_line(1, "Android-specific flags");
@@ -3464,45 +4885,108 @@ struct StripSemicolonFile {
 	String new_fullpath;
 	AstFile *file;
 	i64 written;
+
+	bool generated;   // the temporary file was created
+	bool overwritten; // the original file has been replaced
+	bool failed;
 };
 
-gb_internal gbFileError write_file_with_stripped_tokens(gbFile *f, AstFile *file, i64 *written_) {
-	i64 written = 0;
-	gbFileError err = gbFileError_None;
+// NOTE: The file is assembled in memory and written with a single call, rather than
+// writing each run of bytes between tokens separately
+gb_internal bool build_file_with_stripped_tokens(AstFile *file, Array<u8> *buf) {
 	u8 const *file_data = file->tokenizer.start;
 	i32 prev_offset = 0;
 	i32 const end_offset = cast(i32)(file->tokenizer.end - file->tokenizer.start);
 	for (Token const &token : file->tokens) {
 		if (token.flags & (TokenFlag_Remove|TokenFlag_Replace)) {
 			i32 offset = token.pos.offset;
-			i32 to_write = offset-prev_offset;
-			if (!gb_file_write(f, file_data+prev_offset, to_write)) {
-				return gbFileError_Invalid;
-			}
-			written += to_write;
+			array_add_elems(buf, file_data+prev_offset, offset-prev_offset);
 			prev_offset = token_pos_end(token).offset;
 		}
 		if (token.flags & TokenFlag_Replace) {
 			if (token.kind == Token_Ellipsis) {
-				if (!gb_file_write(f, "..=", 3)) {
-					return gbFileError_Invalid;
-				}
-				written += 3;
+				array_add_elems(buf, cast(u8 const *)"..=", 3);
 			} else {
-				return gbFileError_Invalid;
+				return false;
 			}
 		}
 	}
 	if (end_offset > prev_offset) {
-		i32 to_write = end_offset-prev_offset;
-		if (!gb_file_write(f, file_data+prev_offset, end_offset-prev_offset)) {
-			return gbFileError_Invalid;
+		array_add_elems(buf, file_data+prev_offset, end_offset-prev_offset);
+	}
+	return true;
+}
+
+gb_internal WORKER_TASK_PROC(strip_semicolons_generate_worker_proc) {
+	StripSemicolonFile *file = cast(StripSemicolonFile *)data;
+	char const *filename = cast(char const *)file->new_fullpath.text;
+
+	auto buf = array_make<u8>(heap_allocator(), 0, file->file->tokenizer.end - file->file->tokenizer.start);
+	defer (array_free(&buf));
+	if (!build_file_with_stripped_tokens(file->file, &buf)) {
+		file->failed = true;
+		return 0;
+	}
+
+	gbFile f = {};
+	if (gb_file_create(&f, filename) != gbFileError_None) {
+		file->failed = true;
+		return 0;
+	}
+	file->generated = true;
+
+	debugf("Write file with stripped tokens: %s\n", filename);
+	if (!gb_file_write(&f, buf.data, buf.count)) {
+		file->failed = true;
+	}
+	if (gb_file_close(&f) != gbFileError_None) {
+		file->failed = true;
+	}
+	file->written = buf.count;
+	return 0;
+}
+
+gb_internal WORKER_TASK_PROC(strip_semicolons_replace_worker_proc) {
+	StripSemicolonFile *file = cast(StripSemicolonFile *)data;
+	char const *old_fullpath = cast(char const *)file->old_fullpath.text;
+	char const *old_fullpath_backup = cast(char const *)file->old_fullpath_backup.text;
+	char const *new_fullpath = cast(char const *)file->new_fullpath.text;
+
+	debugf("Copy '%s' to '%s'\n", old_fullpath, old_fullpath_backup);
+	if (!gb_file_copy(old_fullpath, old_fullpath_backup, false)) {
+		gb_printf_err("failed to copy '%s' to '%s'\n", old_fullpath, old_fullpath_backup);
+		file->failed = true;
+	} else {
+		debugf("Copy '%s' to '%s'\n", new_fullpath, old_fullpath);
+		if (!gb_file_copy(new_fullpath, old_fullpath, false)) {
+			gb_printf_err("failed to copy '%s' to '%s'\n", old_fullpath, new_fullpath);
+			debugf("Copy '%s' to '%s'\n", old_fullpath_backup, old_fullpath);
+			if (!gb_file_copy(old_fullpath_backup, old_fullpath, false)) {
+				gb_printf_err("failed to restore '%s' from '%s'\n", old_fullpath, old_fullpath_backup);
+			}
+			file->failed = true;
+		} else {
+			debugf("Remove '%s'\n", old_fullpath_backup);
+			if (!gb_file_remove(old_fullpath_backup)) {
+				gb_printf_err("failed to remove '%s'\n", old_fullpath_backup);
+			}
+			file->overwritten = true;
 		}
-		written += to_write;
 	}
 
-	if (written_) *written_ = written;
-	return err;
+	if (!build_context.keep_temp_files) {
+		debugf("Remove '%s'\n", new_fullpath);
+		GB_ASSERT_MSG(gb_file_remove(new_fullpath), "unable to delete file %s", new_fullpath);
+
+		debugf("Remove '%s'\n", old_fullpath_backup);
+		if (gb_file_exists(old_fullpath_backup) && !gb_file_remove(old_fullpath_backup)) {
+			if (file->overwritten) {
+				gb_printf_err("unable to delete file %s", old_fullpath_backup);
+				file->failed = true;
+			}
+		}
+	}
+	return 0;
 }
 
 gb_internal int strip_semicolons(Parser *parser) {
@@ -3535,104 +5019,46 @@ gb_internal int strip_semicolons(Parser *parser) {
 			String old_fullpath_backup = concatenate_strings(permanent_allocator(), fullpath_base, str_lit("~backup.odin-temp"));
 			String new_fullpath = concatenate_strings(permanent_allocator(), fullpath_base, str_lit("~temp.odin-temp"));
 
-			array_add(&generated_files, StripSemicolonFile{old_fullpath, old_fullpath_backup, new_fullpath, file});
+			StripSemicolonFile sf = {};
+			sf.old_fullpath        = old_fullpath;
+			sf.old_fullpath_backup = old_fullpath_backup;
+			sf.new_fullpath        = new_fullpath;
+			sf.file                = file;
+			array_add(&generated_files, sf);
 		}
 	}
 
 	gb_printf_err("File count to be stripped of unneeded tokens: %td\n", generated_files.count);
 
-
-	isize generated_count = 0;
-	bool failed = false;
-
+	// NOTE: every file is independent, so both the generation of the temporary files and
+	// the replacement of the originals are done on the thread pool
 	for (StripSemicolonFile &file : generated_files) {
-		char const *filename = cast(char const *)file.new_fullpath.text;
-		gbFileError err = gbFileError_None;
-		defer (if (err != gbFileError_None) {
-			failed = true;
-		});
-
-		gbFile f = {};
-		err = gb_file_create(&f, filename);
-		if (err) {
-			break;
-		}
-		defer (err = gb_file_close(&f));
-		generated_count += 1;
-
-		i64 written = 0;
-		defer (err = gb_file_truncate(&f, written));
+		thread_pool_add_task(strip_semicolons_generate_worker_proc, &file);
+	}
+	thread_pool_wait();
 
-		debugf("Write file with stripped tokens: %s\n", filename);
-		err = write_file_with_stripped_tokens(&f, file.file, &written);
-		if (err) {
-			break;
-		}
-		file.written = written;
+	bool failed = false;
+	for (StripSemicolonFile const &file : generated_files) {
+		failed |= file.failed;
 	}
 
 	if (failed) {
-		for (isize i = 0; i < generated_count; i++) {
-			auto *file = &generated_files[i];
-			char const *filename = nullptr;
-			filename = cast(char const *)file->new_fullpath.text;
-			GB_ASSERT_MSG(gb_file_remove(filename), "unable to delete file %s", filename);
+		for (StripSemicolonFile const &file : generated_files) {
+			if (file.generated) {
+				char const *filename = cast(char const *)file.new_fullpath.text;
+				GB_ASSERT_MSG(gb_file_remove(filename), "unable to delete file %s", filename);
+			}
 		}
 		return 1;
 	}
 
-	isize overwritten_files = 0;
-
-	for (StripSemicolonFile const &file : generated_files) {
-		char const *old_fullpath = cast(char const *)file.old_fullpath.text;
-		char const *old_fullpath_backup = cast(char const *)file.old_fullpath_backup.text;
-		char const *new_fullpath = cast(char const *)file.new_fullpath.text;
-
-		debugf("Copy '%s' to '%s'\n", old_fullpath, old_fullpath_backup);
-		if (!gb_file_copy(old_fullpath, old_fullpath_backup, false)) {
-			gb_printf_err("failed to copy '%s' to '%s'\n", old_fullpath, old_fullpath_backup);
-			failed = true;
-			break;
-		}
-
-		debugf("Copy '%s' to '%s'\n", new_fullpath, old_fullpath);
-
-		if (!gb_file_copy(new_fullpath, old_fullpath, false)) {
-			gb_printf_err("failed to copy '%s' to '%s'\n", old_fullpath, new_fullpath);
-			debugf("Copy '%s' to '%s'\n", old_fullpath_backup, old_fullpath);
-			if (!gb_file_copy(old_fullpath_backup, old_fullpath, false)) {
-				gb_printf_err("failed to restore '%s' from '%s'\n", old_fullpath, old_fullpath_backup);
-			}
-			failed = true;
-			break;
-		}
-
-		debugf("Remove '%s'\n", old_fullpath_backup);
-		if (!gb_file_remove(old_fullpath_backup)) {
-			gb_printf_err("failed to remove '%s'\n", old_fullpath_backup);
-		}
-
-		overwritten_files++;
+	for (StripSemicolonFile &file : generated_files) {
+		thread_pool_add_task(strip_semicolons_replace_worker_proc, &file);
 	}
+	thread_pool_wait();
 
-	if (!build_context.keep_temp_files) {
-		for_array(i, generated_files) {
-			auto *file = &generated_files[i];
-			char const *filename = nullptr;
-			filename = cast(char const *)file->new_fullpath.text;
-
-			debugf("Remove '%s'\n", filename);
-			GB_ASSERT_MSG(gb_file_remove(filename), "unable to delete file %s", filename);
-
-			filename = cast(char const *)file->old_fullpath_backup.text;
-			debugf("Remove '%s'\n", filename);
-			if (gb_file_exists(filename) && !gb_file_remove(filename)) {
-				if (i < overwritten_files) {
-					gb_printf_err("unable to delete file %s", filename);
-					failed = true;
-				}
-			}
-		}
+	for (StripSemicolonFile const &file : generated_files) {
+		failed |= file.failed;
 	}
 
 	gb_printf_err("Files stripped of unneeded token: %td\n", generated_files.count);
@@ -3714,6 +5140,226 @@ gb_internal void init_terminal(void) {
 	}
 }
 
+struct TestShard {
+	AstPackage *pkg;
+	gbString    cmd;
+	i32         exit_code;
+};
+
+gb_internal WORKER_TASK_PROC(test_shard_worker_proc) {
+	TestShard *shard = cast(TestShard *)data;
+	shard->exit_code = system_exec_command_line_app("test-shard", "%s", shard->cmd);
+	return 0;
+}
+
+gb_internal GB_COMPARE_PROC(test_shard_cmp) {
+	TestShard *x = (TestShard *)a;
+	TestShard *y = (TestShard *)b;
+	return string_compare(x->pkg->fullpath, y->pkg->fullpath);
+}
+
+// NOTE: Rather than building one executable for every test within `-all-packages`, this invokes
+// the compiler again on each package which contains tests. Every shard is an independent build,
+// so it can be cached on its own, and a shard starts running its tests as soon as it is built.
+gb_internal i32 run_test_shards(Checker *c, Array<String> const &args, Array<String> const &run_args) {
+	gbAllocator a = heap_allocator();
+
+	PtrSet<AstPackage *> seen = {};
+	defer (ptr_set_destroy(&seen));
+
+	auto shards = array_make<TestShard>(a, 0, 16);
+	defer (array_free(&shards));
+	for (Entity *e : c->info.testing_procedures) {
+		AstPackage *pkg = e->pkg;
+		if (pkg == nullptr || ptr_set_update(&seen, pkg)) {
+			continue;
+		}
+		TestShard shard = {};
+		shard.pkg = pkg;
+		array_add(&shards, shard);
+	}
+	if (shards.count == 0) {
+		gb_printf_err("No tests were found with -all-packages\n");
+		return 1;
+	}
+	array_sort(shards, test_shard_cmp);
+
+	Path out = build_context.build_paths[BuildPath_Output];
+	for (TestShard &shard : shards) {
+		Path shard_out = out;
+		shard_out.name = concatenate3_strings(a, out.name, str_lit("-"), shard.pkg->name);
+		String out_path = path_to_string(a, shard_out);
+
+		gbString cmd = gb_string_make(a, "");
+		cmd = gb_string_append_fmt(cmd, "\"%.*s\" test \"%.*s\"", LIT(args[0]), LIT(shard.pkg->fullpath));
+		for (isize i = 3; i < args.count; i++) {
+			String arg = args[i];
+			if (arg == "-all-packages" || arg == "-test-shards" || string_starts_with(arg, str_lit("-out:"))) {
+				continue;
+			}
+			cmd = gb_string_append_fmt(cmd, " \"%.*s\"", LIT(arg));
+		}
+		cmd = gb_string_append_fmt(cmd, " \"-out:%.*s\"", LIT(out_path));
+		if (run_args.count > 0) {
+			cmd = gb_string_appendc(cmd, " --");
+			for (String const &arg : run_args) {
+				cmd = gb_string_append_fmt(cmd, " \"%.*s\"", LIT(arg));
+			}
+		}
+		shard.cmd = cmd;
+	}
+
+	for (TestShard &shard : shards) {
+		thread_pool_add_task(test_shard_worker_proc, &shard);
+	}
+	thread_pool_wait();
+
+	i32 result = 0;
+	isize failed = 0;
+	for (TestShard &shard : shards) {
+		if (shard.exit_code != 0) {
+			gb_printf_err("Test shard for package '%.*s' failed (exit code %d): %.*s\n",
+			              LIT(shard.pkg->name), shard.exit_code, LIT(shard.pkg->fullpath));
+			result = shard.exit_code;
+			failed += 1;
+		}
+		gb_string_free(shard.cmd);
+	}
+	gb_printf("%td of %td test shards passed\n", shards.count-failed, shards.count);
+	return result;
+}
+
+struct SubBuild {
+	String   name;
+	gbString cmd;
+	i32      exit_code;
+};
+
+gb_internal WORKER_TASK_PROC(sub_build_worker_proc) {
+	SubBuild *build = cast(SubBuild *)data;
+	build->exit_code = system_exec_command_line_app("sub-build", "%s", build->cmd);
+	return 0;
+}
+
+gb_internal bool args_have_flag(Array<String> const &args, String const &prefix) {
+	for (String const &arg : args) {
+		if (string_starts_with(arg, prefix)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// NOTE: Runs every build as its own compiler process. At most one build per core runs at a time and
+// each is given its share of the cores, unless the user passed -thread-count themselves.
+gb_internal i32 run_sub_builds(Array<SubBuild> &builds, bool has_thread_count, char const *kind) {
+	gbAffinity affinity = {};
+	gb_affinity_init(&affinity);
+	char const *reason = nullptr;
+	isize core_count = default_thread_count(&affinity, &reason);
+	gb_affinity_destroy(&affinity);
+
+	isize worker_count = gb_clamp(builds.count, 1, core_count);
+	if (!has_thread_count) {
+		isize thread_count = gb_max(core_count / worker_count, 1);
+		for (SubBuild &build : builds) {
+			build.cmd = gb_string_append_fmt(build.cmd, " -thread-count:%td", thread_count);
+		}
+	}
+
+	thread_pool_init(&global_thread_pool, worker_count, "ThreadPoolWorker");
+	for (SubBuild &build : builds) {
+		thread_pool_add_task(sub_build_worker_proc, &build);
+	}
+	thread_pool_wait();
+	thread_pool_destroy(&global_thread_pool);
+
+	i32 result = 0;
+	isize failed = 0;
+	for (SubBuild &build : builds) {
+		if (build.exit_code != 0) {
+			gb_printf_err("Build for %s '%.*s' failed (exit code %d)\n", kind, LIT(build.name), build.exit_code);
+			result = build.exit_code;
+			failed += 1;
+		}
+		gb_string_free(build.cmd);
+	}
+	if (builds.count > 1) {
+		gb_printf_err("%td/%td %ss built successfully\n", builds.count-failed, builds.count, kind);
+	}
+	return result;
+}
+
+// NOTE: The parsed and checked state depends on the target throughout (`#+build` tags, `when` conditions,
+// type sizes), so -target:a,b,c invokes the compiler again for each target. Every output is suffixed
+// with its target name.
+gb_internal i32 build_multiple_targets(Array<String> const &args) {
+	gbAllocator a = heap_allocator();
+	Array<String> const &targets = build_context.multiple_targets;
+
+	if ((build_context.command_kind & (Command_build|Command_check)) == 0) {
+		gb_printf_err("Multiple targets can only be used with `odin build` and `odin check`\n");
+		return 1;
+	}
+
+	auto builds = array_make<SubBuild>(a, targets.count);
+	defer (array_free(&builds));
+	for_array(i, targets) {
+		SubBuild &build = builds[i];
+		build.name = targets[i];
+
+		gbString cmd = gb_string_make(a, "");
+		cmd = gb_string_append_fmt(cmd, "\"%.*s\" %.*s", LIT(args[0]), LIT(args[1]));
+		for (isize j = 2; j < args.count; j++) {
+			String arg = args[j];
+			if (string_starts_with(arg, str_lit("-target:"))) {
+				continue;
+			}
+			cmd = gb_string_append_fmt(cmd, " \"%.*s\"", LIT(arg));
+		}
+		cmd = gb_string_append_fmt(cmd, " -target:%.*s -internal-output-suffix:_%.*s", LIT(build.name), LIT(build.name));
+		build.cmd = cmd;
+	}
+
+	return run_sub_builds(builds, args_have_flag(args, str_lit("-thread-count:")), "target");
+}
+
+// NOTE: `odin build-many <dir>... [flags]` builds each package as an executable with the same flags.
+// The checker keeps its state in globals and the build context applies to the whole program, so the
+// packages cannot share one parse and check in-process; instead, each gets its own `odin build`.
+gb_internal i32 build_many_command(Array<String> const &args) {
+	gbAllocator a = heap_allocator();
+
+	isize package_count = 0;
+	for (isize i = 2; i < args.count && !string_starts_with(args[i], str_lit("-")); i++) {
+		package_count += 1;
+	}
+	if (package_count == 0) {
+		usage(args[0]);
+		return 1;
+	}
+	if (args_have_flag(args, str_lit("-out:"))) {
+		gb_printf_err("-out cannot be used with `odin build-many`, each output is named after its package\n");
+		return 1;
+	}
+
+	auto builds = array_make<SubBuild>(a, package_count);
+	defer (array_free(&builds));
+	for_array(i, builds) {
+		SubBuild &build = builds[i];
+		build.name = args[2+i];
+
+		gbString cmd = gb_string_make(a, "");
+		cmd = gb_string_append_fmt(cmd, "\"%.*s\" build \"%.*s\"", LIT(args[0]), LIT(build.name));
+		for (isize j = 2+package_count; j < args.count; j++) {
+			cmd = gb_string_append_fmt(cmd, " \"%.*s\"", LIT(args[j]));
+		}
+		build.cmd = cmd;
+	}
+
+	return run_sub_builds(builds, args_have_flag(args, str_lit("-thread-count:")), "package");
+}
+
 int main(int arg_count, char const **arg_ptr) {
 	if (arg_count < 2) {
 		usage(make_string_c(arg_ptr[0]));
@@ -3801,14 +5447,15 @@ int main(int arg_count, char const **arg_ptr) {
 	}
 
 	bool run_output = false;
-	if (command == "run" || command == "test") {
+	if (command == "run" || command == "test" || command == "bench") {
 		if (args.count < 3) {
 			usage(args[0]);
 			return 1;
 		}
 		build_context.command_kind = Command_run;
-		if (command == "test") {
+		if (command == "test" || command == "bench") {
 			build_context.command_kind = Command_test;
+			build_context.benchmark = command == "bench";
 		}
 
 		isize run_args_start_idx = -1;
@@ -3843,6 +5490,11 @@ int main(int arg_count, char const **arg_ptr) {
 		}
 		build_context.command_kind = Command_build;
 		init_filename = args[2];
+	} else if (command == "build-many") {
+		if (args.count >= 3 && (args[2] == "-help" || args[2] == "--help")) {
+			return print_show_help(args[0], command);
+		}
+		return build_many_command(args);
 	} else if (command == "check") {
 		if (args.count < 3) {
 			usage(args[0]);
@@ -3945,6 +5597,11 @@ int main(int arg_count, char const **arg_ptr) {
 		//               Further pull requests to add a newline will be closed without comment.
 		gb_printf("%.*s", LIT(odin_root_dir()));
 		return 0;
+	} else if (command == "demangle") {
+		if (args.count >= 3 && (args[2] == "-help" || args[2] == "--help")) {
+			return print_show_help(args[0], command);
+		}
+		return demangle_command(args);
 	} else if (command == "clear-cache") {
 		return try_clear_cache() ? 0 : 1;
 	} else {
@@ -3971,6 +5628,14 @@ int main(int arg_count, char const **arg_ptr) {
 		return print_show_help(args[0], command);
 	}
 
+	if (build_context.multiple_targets.count != 0) {
+		return build_multiple_targets(args);
+	}
+
+	// NOTE: Start reading the packages every build parses whilst the target is being set up
+	parser_prewarm_start(init_filename);
+	defer (parser_prewarm_finish());
+
 	if (build_context.bedrock) {
 		setup_bedrock_mode();
 	}
@@ -4074,6 +5739,34 @@ int main(int arg_count, char const **arg_ptr) {
 	// 	return 1;
 	// }
 	
+	if (build_context.exported_symbols_file.len != 0 && build_context.build_mode != BuildMode_DynamicLibrary) {
+		gb_printf_err("-exported-symbols-file requires -build-mode:shared\n");
+		return 1;
+	}
+
+	if (build_context.jit) {
+		if (build_context.cross_compiling) {
+			gb_printf_err("-jit can only run programs for the host target\n");
+			return 1;
+		}
+		if (build_context.build_mode != BuildMode_Executable) {
+			gb_printf_err("-jit requires -build-mode:exe\n");
+			return 1;
+		}
+		if (build_context.no_crt) {
+			gb_printf_err("-jit cannot be used with -no-crt\n");
+			return 1;
+		}
+		if (build_context.cached) {
+			gb_printf_err("-jit cannot be used with the build cache, there is no executable to cache\n");
+			return 1;
+		}
+		if (build_context.sanitizer_flags != 0) {
+			gb_printf_err("-jit cannot be used with -sanitize\n");
+			return 1;
+		}
+	}
+
 	// Warn about Windows i386 thread-local storage limitations
 	if (build_context.metrics.arch == TargetArch_i386 && build_context.metrics.os == TargetOs_windows) {
 		gb_printf_err("Warning: Thread-local storage is disabled on Windows i386.\n");
@@ -4141,7 +5834,7 @@ int main(int arg_count, char const **arg_ptr) {
 	// We've detected that the CPU doesn't support popcnt, or another reason to use `-microarch:native`,
 	// and that no custom microarch was chosen.
 	if (should_use_march_native() && march == get_default_microarchitecture()) {
-		if (command == "run" || command == "test") {
+		if (command == "run" || command == "test" || command == "bench") {
 			gb_printf_err("Error: Try using '-microarch:native' as Odin defaults to %.*s (close to Nehalem), and your CPU seems to be older.\n", LIT(march));
 			gb_exit(1);
 		} else if (command == "build") {
@@ -4230,6 +5923,7 @@ int main(int arg_count, char const **arg_ptr) {
 	}
 
 	TIME_SECTION("init thread pool");
+	parser_prewarm_finish();
 	init_global_thread_pool();
 	defer (thread_pool_destroy(&global_thread_pool));
 
@@ -4240,6 +5934,7 @@ int main(int arg_count, char const **arg_ptr) {
 	Parser * parser  = permanent_alloc_item<Parser>();
 	Checker *checker = permanent_alloc_item<Checker>();
 	bool failed_to_cache_parsing = false;
+	lbGenerator *jit_gen = nullptr;
 
 	MAIN_TIME_SECTION("parse files");
 
@@ -4264,7 +5959,8 @@ int main(int arg_count, char const **arg_ptr) {
 	init_checker(checker);
 	defer (destroy_checker(checker)); // this is here because of a `goto`
 
-	if (build_context.cached && parser->total_seen_load_directive_count.load() == 0) {
+	if (build_context.cached && !build_context.test_shards && parser->total_seen_load_directive_count.load() == 0) {
+		// NOTE: with -test-shards, each shard is cached on its own instead
 		MAIN_TIME_SECTION("check cached build (pre-semantic check)");
 		if (try_cached_build(checker, args)) {
 			goto end_of_code_gen;
@@ -4273,6 +5969,9 @@ int main(int arg_count, char const **arg_ptr) {
 
 	MAIN_TIME_SECTION("type check");
 	check_parsed_files(checker);
+	if (build_context.ast_stats) {
+		print_ast_memory_stats();
+	}
 	if (!build_context.ignore_unused_defineables) {
 		check_defines(&build_context, checker);
 	}
@@ -4284,6 +5983,15 @@ int main(int arg_count, char const **arg_ptr) {
 		print_all_errors();
 	}
 
+	if (build_context.show_unroll_report) {
+		show_unroll_report(checker);
+	}
+
+	if (build_context.command_kind == Command_test && build_context.test_shards) {
+		MAIN_TIME_SECTION("run test shards");
+		return run_test_shards(checker, args, run_args);
+	}
+
 	if (build_context.show_defineables || build_context.export_defineables_file != "") {
 		TEMPORARY_ALLOCATOR_GUARD();
 		temp_alloc_defineable_strings(checker);
@@ -4298,6 +6006,11 @@ int main(int arg_count, char const **arg_ptr) {
 		}
 	}
 
+	if (build_context.export_symbol_index_file.len != 0) {
+		MAIN_TIME_SECTION("export symbol index");
+		export_symbol_index(checker, build_context.export_symbol_index_file);
+	}
+
 	if (build_context.command_kind == Command_strip_semicolon) {
 		return strip_semicolons(parser);
 	}
@@ -4356,11 +6069,33 @@ int main(int arg_count, char const **arg_ptr) {
 			label_code_gen = gb_string_append_fmt(label_code_gen, " ( %4td modules )", gen->modules.count);
 		}
 		MAIN_TIME_SECTION_WITH_LEN(label_code_gen, gb_string_length(label_code_gen));
-		if (lb_generate_code(gen)) {
+		bool code_generated = lb_generate_code(gen);
+		if (build_context.show_stats) {
+			gather_compiler_stats_from_generator(gen);
+		}
+		if (build_context.proc_cost_report) {
+			print_proc_cost_report(50);
+		}
+		if (build_context.polymorphic_report) {
+			lb_print_polymorphic_report(&checker->info, 50);
+		}
+		lb_print_opt_remarks();
+		if (build_context.show_code_size && code_generated) {
+			lb_print_code_size_report(gen, 50);
+		}
+		if (code_generated) {
+			lb_report_stack_usage(gen, 50);
+			lb_export_allocation_sites(gen);
+		}
+		if (code_generated) {
 			switch (build_context.build_mode) {
 			case BuildMode_Executable:
 			case BuildMode_StaticLibrary:
 			case BuildMode_DynamicLibrary:
+				if (build_context.jit) {
+					jit_gen = gen; // NOTE: nothing to link, the modules are run in-process below
+					break;
+				}
 				i32 result = linker_stage(gen);
 				if (result) {
 					if (build_context.show_timings) {
@@ -4406,9 +6141,12 @@ end_of_code_gen:;
 			try_copy_executable_to_cache();
 		}
 
-		if (failed_to_cache_parsing) {
+		if (failed_to_cache_parsing || build_context.build_cache_data.remote_hit) {
 			write_cached_build(checker, args);
 		}
+		if (failed_to_cache_parsing) {
+			try_copy_executable_to_remote_cache();
+		}
 	}
 
 	if (build_context.show_timings) {
@@ -4418,7 +6156,13 @@ end_of_code_gen:;
 		show_import_graph(checker);
 	}
 
-	if (run_output) {
+	if (run_output && jit_gen != nullptr) {
+		i32 exit_code = lb_jit_run(jit_gen, run_args);
+		if (exit_code) {
+			gb_exit(exit_code);
+		}
+		return 0;
+	} else if (run_output) {
 		String exe_name = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Output]);
 		defer (gb_free(heap_allocator(), exe_name.text));
 
@@ -4443,7 +6187,7 @@ end_of_code_gen:;
 			char const *filename = cast(char const *)exe_name.text;
 			gb_file_remove(filename);
 
-			if (build_context.ODIN_DEBUG) {
+			if (build_has_debug_info()) {
 				if (build_context.metrics.os == TargetOs_windows || build_context.metrics.os == TargetOs_darwin) {
 					String symbol_path = path_to_string(heap_allocator(), build_context.build_paths[BuildPath_Symbols]);
 					defer (gb_free(heap_allocator(), symbol_path.text));
@@ -801,4 +801,155 @@ gb_internal Find_Result find_visual_studio_and_windows_sdk() {
 #endif
 
 	return r;
-}
\ No newline at end of file
+}
+
+// NOTE: Walking the registry, the COM setup API and the directories above takes hundreds of milliseconds,
+// so the result is cached in `%LOCALAPPDATA%\odin\msvc-<arch>.cache`. The cache is keyed by the compiler
+// version and every environment variable the search reads, and is invalidated whenever the Visual Studio
+// installer's instance state changes, which is a single comparison of the last write time of its directory.
+//
+// The file is plain text, one value per line:
+//
+//     odin-msvc-cache <version>
+//     <key>
+//     <instance state>
+//     windows_sdk_version
+//     windows_sdk_bin_path
+//     windows_sdk_um_library_path
+//     windows_sdk_ucrt_library_path
+//     vs_exe_path
+//     vs_library_path
+
+enum : int { MC_CACHE_VERSION = 1 };
+
+gb_internal String mc_cache_path(void) {
+	String local_app_data = mc_get_env(str_lit("LOCALAPPDATA"));
+	if (local_app_data.len == 0) {
+		return {};
+	}
+	String dir = mc_concat(local_app_data, str_lit("\\odin"));
+	{
+		String16 wdir = mc_string_to_wstring(dir);
+		CreateDirectoryW(cast(wchar_t const *)wdir.text, nullptr); // NOTE: fails harmlessly when it already exists
+		mc_free(wdir);
+	}
+	String arch = target_arch_names[build_context.metrics.arch];
+	return mc_concat(dir, str_lit("\\msvc-"), arch, str_lit(".cache"));
+}
+
+gb_internal u64 mc_cache_key(void) {
+	char const *env_names[] = {
+		"WindowsSDKVersion", "WindowsSDKLibVersion", "WindowsSdkDir", "UniversalCRTSdkDir",
+		"WindowsSdkBinPath", "WindowsSdkVerBinPath", "LIB", "VCToolsInstallDir", "Path",
+	};
+	u64 key = xxh64(ODIN_VERSION.text, ODIN_VERSION.len, MC_CACHE_VERSION);
+	String arch = target_arch_names[build_context.metrics.arch];
+	key = xxh64(arch.text, arch.len, key);
+	for (char const *name : env_names) {
+		String value = mc_get_env(make_string_c(name));
+		key = xxh64(value.text, value.len, key ^ cast(u64)value.len);
+		mc_free(value);
+	}
+	return key;
+}
+
+// NOTE: Every install, update, or removal of a Visual Studio instance rewrites the installer's state directory
+gb_internal u64 mc_cache_instance_state(void) {
+	String program_data = mc_get_env(str_lit("ProgramData"));
+	if (program_data.len == 0) {
+		return 0;
+	}
+	String instances = mc_concat(program_data, str_lit("\\Microsoft\\VisualStudio\\Packages\\_Instances"));
+	u64 state = cast(u64)gb_file_last_write_time(cast(char const *)instances.text);
+	mc_free(instances);
+	mc_free(program_data);
+	return state;
+}
+
+gb_internal bool mc_cache_read(String const &path, u64 key, u64 state, Find_Result *result) {
+	gbFileContents fc = gb_file_read_contents(mc_allocator, true, cast(char const *)path.text);
+	if (fc.data == nullptr) {
+		return false;
+	}
+	// NOTE: The strings of the result point into the contents, which are never freed
+	String data = make_string(cast(u8 const *)fc.data, fc.size);
+	String_Iterator it = {data, 0};
+
+	String lines[9] = {};
+	for (isize i = 0; i < gb_count_of(lines); i++) {
+		if (it.pos >= data.len) {
+			return false;
+		}
+		lines[i] = string_trim_whitespace(string_split_iterator(&it, '\n'));
+	}
+
+	gbString header = gb_string_make(temporary_allocator(), "");
+	header = gb_string_append_fmt(header, "odin-msvc-cache %d", MC_CACHE_VERSION);
+	if (lines[0] != make_string_c(header)) {
+		return false;
+	}
+	if (u64_from_string(lines[1]) != key || u64_from_string(lines[2]) != state) {
+		return false;
+	}
+
+	Find_Result r = {};
+	r.windows_sdk_version           = cast(int)u64_from_string(lines[3]);
+	r.windows_sdk_bin_path          = lines[4];
+	r.windows_sdk_um_library_path   = lines[5];
+	r.windows_sdk_ucrt_library_path = lines[6];
+	r.vs_exe_path                   = lines[7];
+	r.vs_library_path               = lines[8];
+
+	// NOTE: The strings need to be NUL terminated like the ones from the search
+	String *paths[] = {&r.windows_sdk_bin_path, &r.windows_sdk_um_library_path, &r.windows_sdk_ucrt_library_path, &r.vs_exe_path, &r.vs_library_path};
+	for (String *p : paths) {
+		*p = copy_string(mc_allocator, *p);
+	}
+
+	// e.g. a Windows SDK which was uninstalled without touching the Visual Studio instances
+	if (!gb_file_exists(cast(char const *)r.vs_library_path.text) ||
+	    !gb_file_exists(cast(char const *)r.windows_sdk_um_library_path.text)) {
+		return false;
+	}
+
+	*result = r;
+	return true;
+}
+
+gb_internal void mc_cache_write(String const &path, u64 key, u64 state, Find_Result const &r) {
+	gbFile f = {};
+	if (gb_file_create(&f, cast(char const *)path.text) != gbFileError_None) {
+		return;
+	}
+	defer (gb_file_close(&f));
+	gb_fprintf(&f, "odin-msvc-cache %d\n", MC_CACHE_VERSION);
+	gb_fprintf(&f, "0x%016llx\n", cast(unsigned long long)key);
+	gb_fprintf(&f, "0x%016llx\n", cast(unsigned long long)state);
+	gb_fprintf(&f, "%d\n", r.windows_sdk_version);
+	gb_fprintf(&f, "%.*s\n", LIT(r.windows_sdk_bin_path));
+	gb_fprintf(&f, "%.*s\n", LIT(r.windows_sdk_um_library_path));
+	gb_fprintf(&f, "%.*s\n", LIT(r.windows_sdk_ucrt_library_path));
+	gb_fprintf(&f, "%.*s\n", LIT(r.vs_exe_path));
+	gb_fprintf(&f, "%.*s\n", LIT(r.vs_library_path));
+}
+
+gb_internal Find_Result find_visual_studio_and_windows_sdk_cached() {
+	String path = mc_cache_path();
+	if (path.len == 0) {
+		return find_visual_studio_and_windows_sdk();
+	}
+	u64 key   = mc_cache_key();
+	u64 state = mc_cache_instance_state();
+
+	Find_Result r = {};
+	if (mc_cache_read(path, key, state, &r)) {
+		return r;
+	}
+
+	r = find_visual_studio_and_windows_sdk();
+	// NOTE: A failed search is never cached, so that it is retried once whatever was missing is installed
+	if (r.windows_sdk_version != 0 && r.vs_library_path.len != 0 && r.windows_sdk_um_library_path.len != 0) {
+		mc_cache_write(path, key, state, r);
+	}
+	return r;
+}
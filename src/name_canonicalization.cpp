@@ -545,6 +545,18 @@ gb_internal u64 type_hash_canonical_type(Type *type) {
 	return hash;
 }
 
+// NOTE: Unlike `type_hash_canonical_type`, this is not cached on the type, as it is used on
+// procedure types which are still being specialized
+gb_internal u64 type_hash_canonical_proc_params(Type *type) {
+	GB_ASSERT(type != nullptr && type->kind == Type_Proc);
+	TypeWriter w = {};
+	type_writer_make_hasher(&w, &w.hash_ctx);
+	write_canonical_params(&w, type->Proc.params);
+	write_canonical_params(&w, type->Proc.results);
+	u64 hash = typeid_hash_context_fini(&w.hash_ctx);
+	return hash ? hash : 1;
+}
+
 gb_internal String type_to_canonical_string(gbAllocator allocator, Type *type) {
 	TypeWriter w = {};
 	type_writer_make_string(&w, allocator);
@@ -915,6 +927,7 @@ gb_internal void write_type_to_canonical_string(TypeWriter *w, Type *type) {
 		if (type->Struct.is_packed)      type_writer_appendc(w, "#packed");
 		if (type->Struct.is_raw_union)   type_writer_appendc(w, "#raw_union");
 		if (type->Struct.is_all_or_none) type_writer_appendc(w, "#all_or_none");
+		if (type->Struct.is_reorder)     type_writer_appendc(w, "#reorder");
 		if (type->Struct.custom_min_field_align != 0) type_writer_append_fmt(w, "#min_field_align(%lld)", cast(long long)type->Struct.custom_min_field_align);
 		if (type->Struct.custom_max_field_align != 0) type_writer_append_fmt(w, "#max_field_align(%lld)", cast(long long)type->Struct.custom_max_field_align);
 		if (type->Struct.custom_align != 0)           type_writer_append_fmt(w, "#align(%lld)",           cast(long long)type->Struct.custom_align);
@@ -1025,3 +1038,144 @@ gb_internal void write_type_to_canonical_string(TypeWriter *w, Type *type) {
 
 	return;
 }
+
+
+gb_internal bool canonical_demangle_is_digits(String const &s, isize start, isize end) {
+	if (start >= end) {
+		return false;
+	}
+	for (isize i = start; i < end; i++) {
+		if (!gb_char_is_digit(cast(char)s[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// NOTE: Writes the `TYPE` of a polymorphic `pkg::foo:TYPE` with some spacing, returning where it ended
+gb_internal isize canonical_demangle_type(gbString *out, String const &name, isize i) {
+	isize depth = 0;
+	while (i < name.len) {
+		u8 c = name[i];
+		if (c == '(' || c == '[' || c == '{') {
+			depth += 1;
+		} else if (c == ')' || c == ']' || c == '}') {
+			depth -= 1;
+		} else if (c == '"') {
+			isize end = i+1;
+			while (end < name.len && name[end] != '"') {
+				end += 1;
+			}
+			*out = gb_string_append_length(*out, name.text+i, gb_min(end+1, name.len)-i);
+			i = end+1;
+			continue;
+		}
+
+		if (c == ':' && i+1 < name.len && name[i+1] == ':') {
+			if (depth == 0 && i > 0 && name[i-1] == ')') {
+				// `pkg::foo:TYPE::name`, a declaration nested within a polymorphic procedure
+				return i;
+			}
+			*out = gb_string_appendc(*out, ".");
+			i += 2;
+			continue;
+		}
+		if (c == '-' && i+1 < name.len && name[i+1] == '>') {
+			*out = gb_string_appendc(*out, " -> ");
+			i += 2;
+			// `->(:int)` is a single unnamed result
+			if (i+1 < name.len && name[i] == '(' && name[i+1] == ':') {
+				isize end = i+2;
+				isize result_depth = 1;
+				bool single = true;
+				for (; end < name.len && result_depth > 0; end++) {
+					if (name[end] == '(' || name[end] == '[') result_depth += 1;
+					if (name[end] == ')' || name[end] == ']') result_depth -= 1;
+					if (name[end] == ',' && result_depth == 1) single = false;
+				}
+				if (single && result_depth == 0) {
+					canonical_demangle_type(out, substring(name, i+2, end-1), 0);
+					i = end;
+				}
+			}
+			continue;
+		}
+		if (c == ',') {
+			*out = gb_string_appendc(*out, ", ");
+			i += 1;
+			continue;
+		}
+
+		*out = gb_string_append_length(*out, &c, 1);
+		i += 1;
+	}
+	return i;
+}
+
+// NOTE: Turns a canonical name (as used for the symbols) back into something closer to how it is
+// written in the source, e.g. for the stacks of a profiler:
+//     `fmt::[fmt.odin]::handle_tag`                        -> `fmt.handle_tag`
+//     `fmt::fmt_array.print_utf16-0`                         -> `fmt.fmt_array.print_utf16`
+//     `linux::syscall1:proc"contextless"(nr:uintptr)->(:int)` -> `linux.syscall1 :: proc"contextless"(nr:uintptr) -> int`
+// `strip_types` drops the types of polymorphic specializations entirely.
+gb_internal gbString canonical_demangle_name(gbString out, String const &name, bool strip_types) {
+	bool nested_proc = false;
+	isize i = 0;
+	while (i < name.len) {
+		u8 c = name[i];
+		if (c == ':' && i+1 < name.len && name[i+1] == ':') {
+			i += 2;
+			nested_proc = false;
+			if (i < name.len && name[i] == '[') {
+				// file private, `pkg::[file.odin]::name`
+				String rest = substring(name, i, name.len);
+				isize end = string_index_byte(rest, ']');
+				if (end >= 0 && i+end+2 < name.len && name[i+end+1] == ':' && name[i+end+2] == ':') {
+					i += end+3;
+				}
+			} else if (i < name.len && name[i] == '$' && canonical_demangle_is_digits(name, i+1, name.len)) {
+				// the scope index suffix, `pkg::parent::name::$4`
+				break;
+			}
+			out = gb_string_appendc(out, ".");
+			continue;
+		}
+		if (c == '$' && i+1 < name.len && name[i+1] == ':') {
+			// `llvm$::`, the prefix of the `llvm` package
+			i += 1;
+			continue;
+		}
+		if (c == ':') {
+			if (strip_types) {
+				isize depth = 0;
+				for (i += 1; i < name.len; i++) {
+					if (name[i] == '(' || name[i] == '[') depth += 1;
+					if (name[i] == ')' || name[i] == ']') depth -= 1;
+					if (depth == 0 && name[i] == ':' && i+1 < name.len && name[i+1] == ':' && name[i-1] == ')') {
+						break;
+					}
+				}
+			} else {
+				out = gb_string_appendc(out, " :: ");
+				i = canonical_demangle_type(&out, name, i+1);
+			}
+			continue;
+		}
+		if (c == '.') {
+			nested_proc = true;
+		} else if (c == '-' && nested_proc) {
+			// the numbering of a nested procedure, `parent.nested-0`
+			isize end = i+1;
+			while (end < name.len && gb_char_is_digit(cast(char)name[end])) {
+				end += 1;
+			}
+			if (end > i+1 && (end == name.len || name[end] == '.' || name[end] == ':')) {
+				i = end;
+				continue;
+			}
+		}
+		out = gb_string_append_length(out, &c, 1);
+		i += 1;
+	}
+	return out;
+}
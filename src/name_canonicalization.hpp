@@ -48,8 +48,10 @@ struct TypeWriter;
 gb_internal void     write_type_to_canonical_string(TypeWriter *w, Type *type);
 gb_internal void     write_canonical_entity_name(TypeWriter *w, Entity *e);
 gb_internal u64      type_hash_canonical_type(Type *type);
+gb_internal u64      type_hash_canonical_proc_params(Type *type);
 gb_internal String   type_to_canonical_string(gbAllocator allocator, Type *type);
 gb_internal gbString temp_canonical_string(Type *type);
+gb_internal gbString canonical_demangle_name(gbString out, String const &name, bool strip_types);
 
 
 gb_internal GB_COMPARE_PROC(type_info_pair_cmp);
@@ -0,0 +1,100 @@
+// NOTE: A growable buffer in front of a `gbFile` for emitters which produce a lot of small writes
+// (`odin doc`, `-show-import-graph`, `-export-dependencies`, etc), as `gb_printf` and `gb_file_write`
+// are a syscall each. Nothing is written until the buffer fills up or `output_buffer_flush` is called.
+struct OutputBuffer {
+	gbFile *file;
+	u8 *    data;
+	isize   len;
+	isize   cap;
+};
+
+enum {OUTPUT_BUFFER_DEFAULT_CAPACITY = 1<<16};
+
+gb_internal void output_buffer_init(OutputBuffer *b, gbFile *file, isize cap=OUTPUT_BUFFER_DEFAULT_CAPACITY) {
+	b->file = file;
+	b->data = gb_alloc_array(heap_allocator(), u8, cap);
+	b->len  = 0;
+	b->cap  = cap;
+}
+
+gb_internal void output_buffer_flush(OutputBuffer *b) {
+	if (b->len > 0) {
+		gb_file_write(b->file, b->data, b->len);
+		b->len = 0;
+	}
+}
+
+gb_internal void output_buffer_destroy(OutputBuffer *b) {
+	output_buffer_flush(b);
+	gb_free(heap_allocator(), b->data);
+	b->data = nullptr;
+	b->cap  = 0;
+}
+
+gb_internal void output_buffer_write(OutputBuffer *b, void const *data, isize len) {
+	if (b->len + len > b->cap) {
+		output_buffer_flush(b);
+		if (len >= b->cap) {
+			gb_file_write(b->file, data, len);
+			return;
+		}
+	}
+	gb_memmove(b->data + b->len, data, len);
+	b->len += len;
+}
+
+gb_internal void output_buffer_write_string(OutputBuffer *b, String const &s) {
+	output_buffer_write(b, s.text, s.len);
+}
+
+gb_internal void output_buffer_write_byte(OutputBuffer *b, u8 c) {
+	if (b->len >= b->cap) {
+		output_buffer_flush(b);
+	}
+	b->data[b->len++] = c;
+}
+
+gb_internal void output_buffer_write_bytes(OutputBuffer *b, u8 c, isize count) {
+	while (count --> 0) {
+		output_buffer_write_byte(b, c);
+	}
+}
+
+gb_internal void output_buffer_printf_va(OutputBuffer *b, char const *fmt, va_list va) {
+	for (isize attempt = 0; attempt < 2; attempt++) {
+		va_list va_save;
+		va_copy(va_save, va);
+		// NOTE: the returned length includes the NUL terminator, which is then overwritten by the next write
+		isize len = gb_snprintf_va(cast(char *)(b->data + b->len), b->cap - b->len, fmt, va_save);
+		va_end(va_save);
+		if (len > 0) {
+			b->len += len-1;
+			return;
+		}
+		if (b->len == 0) {
+			break;
+		}
+		output_buffer_flush(b);
+	}
+	// NOTE: too large for the buffer even when empty
+	gb_fprintf_va(b->file, fmt, va);
+}
+
+gb_internal void output_buffer_printf(OutputBuffer *b, char const *fmt, ...) {
+	va_list va;
+	va_start(va, fmt);
+	output_buffer_printf_va(b, fmt, va);
+	va_end(va);
+}
+
+// NOTE: Each thread gets its own standard output buffer so emitters never need to lock, the owner
+// must call `output_buffer_flush` before anything else can be written to the standard output
+gb_global gb_thread_local OutputBuffer stdout_output_buffer;
+
+gb_internal OutputBuffer *stdout_buffer(void) {
+	OutputBuffer *b = &stdout_output_buffer;
+	if (b->data == nullptr) {
+		output_buffer_init(b, gb_file_get_standard(gbFileStandard_Output));
+	}
+	return b;
+}
@@ -44,11 +44,89 @@ gb_internal bool file_allow_newline(AstFile *f) {
 	return !is_strict;
 }
 
+// NOTE: Built once after tokenization so that positions can be mapped to lines without rescanning the file
+gb_internal void ast_file_build_line_offsets(AstFile *f) {
+	u8 const *start = f->tokenizer.start;
+	u8 const *end   = f->tokenizer.end;
+
+	isize line_count = 1;
+	for (u8 const *s = start; s < end; s++) {
+		s = cast(u8 const *)memchr(s, '\n', end-s);
+		if (s == nullptr) {
+			break;
+		}
+		line_count += 1;
+	}
+
+	f->line_offsets = slice_make<i32>(ast_allocator(f), line_count);
+	f->line_offsets[0] = 0;
+	isize line = 1;
+	for (u8 const *s = start; s < end; s++) {
+		s = cast(u8 const *)memchr(s, '\n', end-s);
+		if (s == nullptr) {
+			break;
+		}
+		f->line_offsets[line++] = cast(i32)(s+1 - start);
+	}
+	GB_ASSERT(line == line_count);
+}
+
+// Returns the index into `line_offsets` of the line containing the byte offset, or -1 when the table is not available
+gb_internal isize ast_file_line_index_from_offset(AstFile *f, i32 offset) {
+	if (f == nullptr || f->line_offsets.count == 0) {
+		return -1;
+	}
+	isize lo = 0;
+	isize hi = f->line_offsets.count;
+	while (hi - lo > 1) {
+		isize mid = lo + (hi-lo)/2;
+		if (f->line_offsets[mid] <= offset) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// Derives the line and column (both starting at 1) of a byte offset within a file
+gb_internal bool ast_file_line_column_from_offset(AstFile *f, i32 offset, i32 *line_, i32 *column_) {
+	isize index = ast_file_line_index_from_offset(f, offset);
+	if (index < 0) {
+		return false;
+	}
+	u8 const *start = f->tokenizer.start;
+	u8 const *end   = f->tokenizer.end;
+	u8 const *ptr   = start + f->line_offsets[index];
+	u8 const *target = start + gb_min(cast(isize)offset, end-start);
+	if (index == 0 && end-ptr >= 3 && ptr[0] == 0xef && ptr[1] == 0xbb && ptr[2] == 0xbf) {
+		ptr += 3; // BOM
+	}
+
+	i32 column = 1;
+	while (ptr < target) {
+		if (*ptr & 0x80) {
+			ptr += utf8_decode(ptr, end-ptr, nullptr);
+		} else {
+			ptr += 1;
+		}
+		column += 1;
+	}
+	if (line_)   *line_   = cast(i32)(index+1);
+	if (column_) *column_ = column;
+	return true;
+}
+
 gb_internal Token token_end_of_line(AstFile *f, Token tok) {
 	u8 const *start = f->tokenizer.start + tok.pos.offset;
 	u8 const *s = start;
-	while (*s && *s != '\n' && s < f->tokenizer.end) {
-		s += 1;
+	isize line_index = ast_file_line_index_from_offset(f, tok.pos.offset);
+	if (line_index >= 0 && line_index+1 < f->line_offsets.count) {
+		s = f->tokenizer.start + f->line_offsets[line_index+1] - 1;
+	} else {
+		while (*s && *s != '\n' && s < f->tokenizer.end) {
+			s += 1;
+		}
 	}
 	tok.pos.column += cast(i32)(s - start) - 1;
 	return tok;
@@ -66,7 +144,18 @@ gb_internal gbString get_file_line_as_string(TokenPos const &pos, i32 *offset_)
 	}
 
 	isize offset = pos.offset;
-	if (pos.line != 0 && offset == 0) {
+	if (pos.line != 0 && offset == 0 && file->line_offsets.count != 0) {
+		offset = file->line_offsets[gb_clamp(pos.line, 1, file->line_offsets.count)-1];
+		for (i32 i = 1; i < pos.column && start+offset < end; i++) {
+			u8 *ptr = start+offset;
+			u8 c = *ptr;
+			if (c & 0x80) {
+				offset += utf8_decode(ptr, end-ptr, nullptr);
+			} else {
+				offset++;
+			}
+		}
+	} else if (pos.line != 0 && offset == 0) {
 		for (i32 i = 1; i < pos.line; i++) {
 			while (start+offset < end) {
 				u8 c = start[offset++];
@@ -96,29 +185,40 @@ gb_internal gbString get_file_line_as_string(TokenPos const &pos, i32 *offset_)
 	u8 *line_start = pos_offset;
 	u8 *line_end  = pos_offset;
 
-	if (offset > 0 && *line_start == '\n') {
-		// Prevent an error token that starts at the boundary of a line that
-		// leads to an empty line from advancing off its line.
-		line_start -= 1;
-	}
-	while (line_start >= start) {
-		if (*line_start == '\n') {
+	isize line_index = ast_file_line_index_from_offset(file, cast(i32)offset);
+	if (line_index >= 0) {
+		// NOTE: A token which starts on the newline itself belongs to the line it ends
+		line_start = start + file->line_offsets[line_index];
+		if (line_index+1 < file->line_offsets.count) {
+			line_end = start + file->line_offsets[line_index+1] - 1;
+		} else {
+			line_end = end;
+		}
+	} else {
+		if (offset > 0 && *line_start == '\n') {
+			// Prevent an error token that starts at the boundary of a line that
+			// leads to an empty line from advancing off its line.
+			line_start -= 1;
+		}
+		while (line_start >= start) {
+			if (*line_start == '\n') {
+				line_start += 1;
+				break;
+			}
+			line_start -= 1;
+		}
+		if (line_start == start - 1) {
+			// Prevent an error on the first line from stepping behind the boundary
+			// of the text.
 			line_start += 1;
-			break;
 		}
-		line_start -= 1;
-	}
-	if (line_start == start - 1) {
-		// Prevent an error on the first line from stepping behind the boundary
-		// of the text.
-		line_start += 1;
-	}
 
-	while (line_end < end) {
-		if (*line_end == '\n') {
-			break;
+		while (line_end < end) {
+			if (*line_end == '\n') {
+				break;
+			}
+			line_end += 1;
 		}
-		line_end += 1;
 	}
 	String the_line = make_string(line_start, line_end-line_start);
 	the_line = string_trim_whitespace(the_line);
@@ -136,7 +236,9 @@ gb_internal isize ast_node_size(AstKind kind) {
 
 }
 
-// gb_global std::atomic<isize> global_total_node_memory_allocated;
+// NOTE: Only recorded with -internal-ast-stats, used to measure the memory cost of the node layout, or -show-stats
+gb_global std::atomic<isize> global_ast_node_counts[Ast_COUNT];
+gb_global std::atomic<isize> global_ast_annotated_node_count;
 
 // NOTE(bill): And this below is why is I/we need a new language! Discriminated unions are a pain in C/C++
 gb_internal Ast *alloc_ast_node(AstFile *f, AstKind kind) {
@@ -146,11 +248,61 @@ gb_internal Ast *alloc_ast_node(AstFile *f, AstKind kind) {
 	node->kind = kind;
 	node->file_id = f ? f->id : 0;
 
-	// global_total_node_memory_allocated.fetch_add(size);
+	if (build_context.ast_stats || build_context.show_stats) {
+		global_ast_node_counts[kind].fetch_add(1, std::memory_order_relaxed);
+	}
+	memory_account(MemorySubsystem_Ast, size);
 
 	return node;
 }
 
+gb_internal void print_ast_memory_stats(void) {
+	struct AstKindStats {
+		AstKind kind;
+		isize   count;
+		isize   bytes;
+	};
+
+	AstKindStats stats[Ast_COUNT] = {};
+	isize total_count = 0;
+	isize total_bytes = 0;
+	for (isize i = 0; i < Ast_COUNT; i++) {
+		AstKind kind = cast(AstKind)i;
+		isize count = global_ast_node_counts[i].load(std::memory_order_relaxed);
+		stats[i].kind  = kind;
+		stats[i].count = count;
+		stats[i].bytes = count * align_formula_isize(ast_node_size(kind), 16);
+		total_count += stats[i].count;
+		total_bytes += stats[i].bytes;
+	}
+
+	gb_sort_array(stats, Ast_COUNT, [](void const *a, void const *b) -> int {
+		isize x = (cast(AstKindStats const *)a)->bytes;
+		isize y = (cast(AstKindStats const *)b)->bytes;
+		return x < y ? +1 : x > y ? -1 : 0;
+	});
+
+	isize annotated = global_ast_annotated_node_count.load(std::memory_order_relaxed);
+	isize tav_bytes = total_count * gb_size_of(TypeAndValue);
+	// NOTE: Estimate of keeping the TypeAndValue in a side table indexed by a 32-bit node index
+	isize side_table_bytes = annotated * (gb_size_of(TypeAndValue) + gb_size_of(u32));
+
+	gb_printf("AST memory statistics\n");
+	gb_printf("\tnodes:            %td\n", total_count);
+	gb_printf("\tnode bytes:       %td\n", total_bytes);
+	gb_printf("\tTypeAndValue:     %td bytes per node, %td bytes total\n", gb_size_of(TypeAndValue), tav_bytes);
+	gb_printf("\tannotated nodes:  %td (%.1f%%)\n", annotated, total_count ? 100.0*annotated/total_count : 0.0);
+	gb_printf("\tside table:       %td bytes (estimated)\n", side_table_bytes);
+	gb_printf("\n");
+	gb_printf("\t%-24s %12s %14s\n", "kind", "count", "bytes");
+	for (isize i = 0; i < Ast_COUNT; i++) {
+		if (stats[i].count == 0) {
+			break;
+		}
+		gb_printf("\t%-24.*s %12td %14td\n", LIT(ast_strings[stats[i].kind]), stats[i].count, stats[i].bytes);
+	}
+}
+
 gb_internal Ast *clone_ast(Ast *node, AstFile *f = nullptr);
 gb_internal Array<Ast *> clone_ast_array(Array<Ast *> const &array, AstFile *f) {
 	Array<Ast *> result = {};
@@ -184,8 +336,14 @@ gb_internal Ast *clone_ast(Ast *node, AstFile *f) {
 			f = node->thread_safe_file();
 		}
 	}
+	if (node->kind == Ast_ProcLit) {
+		// NOTE: The clone must see the real body and not the skipped placeholder
+		parse_lazy_proc_body(node);
+	}
 	Ast *n = alloc_ast_node(f, node->kind);
 	gb_memmove(n, node, ast_node_size(node->kind));
+	n->tav_writer.store(0, std::memory_order_relaxed);
+	n->untyped_index.store(0, std::memory_order_relaxed);
 
 	switch (n->kind) {
 	default: GB_PANIC("Unhandled Ast %.*s", LIT(ast_strings[n->kind])); break;
@@ -357,6 +515,7 @@ gb_internal Ast *clone_ast(Ast *node, AstFile *f) {
 		n->RangeStmt.vals  = clone_ast_array(n->RangeStmt.vals, f);
 		n->RangeStmt.expr  = clone_ast(n->RangeStmt.expr, f);
 		n->RangeStmt.body  = clone_ast(n->RangeStmt.body, f);
+		n->RangeStmt.prefetch = clone_ast(n->RangeStmt.prefetch, f);
 		break;
 	case Ast_UnrollRangeStmt:
 		n->UnrollRangeStmt.args = clone_ast_array(n->UnrollRangeStmt.args, f);
@@ -503,6 +662,26 @@ gb_internal Ast *clone_ast(Ast *node, AstFile *f) {
 	return n;
 }
 
+// NOTE: Clones a procedure literal but reuses `type` (an already cloned copy of its type)
+// rather than cloning the type a second time
+gb_internal Ast *clone_proc_lit_with_type(Ast *proc_lit, Ast *type) {
+	GB_ASSERT(proc_lit->kind == Ast_ProcLit);
+	AstFile *f = nullptr;
+	if (g_parsing_done.load(std::memory_order_relaxed)) {
+		f = proc_lit->file();
+	} else {
+		f = proc_lit->thread_safe_file();
+	}
+	parse_lazy_proc_body(proc_lit);
+
+	Ast *n = alloc_ast_node(f, Ast_ProcLit);
+	gb_memmove(n, proc_lit, ast_node_size(Ast_ProcLit));
+	n->ProcLit.type = type;
+	n->ProcLit.body = clone_ast(n->ProcLit.body, f);
+	n->ProcLit.where_clauses = clone_ast_array(n->ProcLit.where_clauses, f);
+	return n;
+}
+
 
 gb_internal void error(Ast *node, char const *fmt, ...) {
 	Token token = {};
@@ -1272,7 +1451,7 @@ gb_internal Ast *ast_fixed_capacity_dynamic_array_type(AstFile *f, Token token,
 }
 
 gb_internal Ast *ast_struct_type(AstFile *f, Token token, Slice<Ast *> fields, isize field_count,
-                     Ast *polymorphic_params, bool is_packed, bool is_raw_union, bool is_all_or_none, bool is_simple,
+                     Ast *polymorphic_params, bool is_packed, bool is_raw_union, bool is_all_or_none, bool is_simple, bool is_reorder,
                      Ast *align, Ast *min_field_align, Ast *max_field_align,
                      Token where_token, Array<Ast *> const &where_clauses) {
 	Ast *result = alloc_ast_node(f, Ast_StructType);
@@ -1284,6 +1463,7 @@ gb_internal Ast *ast_struct_type(AstFile *f, Token token, Slice<Ast *> fields, i
 	result->StructType.is_raw_union       = is_raw_union;
 	result->StructType.is_all_or_none     = is_all_or_none;
 	result->StructType.is_simple          = is_simple;
+	result->StructType.is_reorder         = is_reorder;
 	result->StructType.align              = align;
 	result->StructType.min_field_align    = min_field_align;
 	result->StructType.max_field_align    = max_field_align;
@@ -1431,15 +1611,103 @@ gb_internal Ast *ast_attribute(AstFile *f, Token token, Token open, Token close,
 }
 
 
+gb_internal gb_inline TokenLookahead *token_lookahead_at(AstFile *f, isize offset) {
+	GB_ASSERT(offset < f->lookahead_count);
+	return &f->lookahead[(f->lookahead_head + offset) & (f->lookahead_cap-1)];
+}
+
+// NOTE: Lexes until there are at least `count` tokens from `curr_token` onwards. Returns false if the
+// EOF is reached before that.
+gb_internal bool token_stream_fill(AstFile *f, isize count) {
+	while (f->lookahead_count < count) {
+		if (f->lookahead_count > 0 && token_lookahead_at(f, f->lookahead_count-1)->token.kind == Token_EOF) {
+			return false;
+		}
+		if (f->lookahead_count == f->lookahead_cap) {
+			isize new_cap = gb_max(f->lookahead_cap*2, 16);
+			TokenLookahead *new_lookahead = gb_alloc_array(ast_allocator(f), TokenLookahead, new_cap);
+			for (isize i = 0; i < f->lookahead_count; i++) {
+				new_lookahead[i] = *token_lookahead_at(f, i);
+			}
+			f->lookahead      = new_lookahead;
+			f->lookahead_cap  = new_cap;
+			f->lookahead_head = 0;
+		}
+
+		f->lookahead_count += 1;
+		TokenLookahead *la = token_lookahead_at(f, f->lookahead_count-1);
+
+		u64 start = build_context.show_more_timings ? time_stamp_time_now() : 0;
+		tokenizer_get_token_resumable(&f->tokenizer, &la->token);
+		if (build_context.show_more_timings) {
+			f->tokenize_ticks += time_stamp_time_now() - start;
+		}
+		la->state = tokenizer_state(&f->tokenizer);
+
+		if (la->token.kind == Token_Invalid) {
+			// NOTE: The whole file fails to parse, so end it here. Report it now as the parser may stop at
+			// the early end, and mute the errors which only follow from it
+			if (f->invalid_token_pos.line == 0) {
+				f->invalid_token_pos = la->token.pos;
+				syntax_error(la->token.pos, "Failed to parse file: %.*s; invalid token found in file", LIT(filename_without_directory(f->fullpath)));
+				syntax_errors_muted_file_id = f->id;
+			}
+			la->token.kind = Token_EOF;
+		}
+
+		isize index = f->curr_token_index + f->lookahead_count-1;
+		if (index >= f->token_count) {
+			f->token_count = index+1;
+			if (f->keep_tokens) {
+				array_add(&f->tokens, la->token);
+			}
+		}
+	}
+	return true;
+}
+
 gb_internal bool next_token0(AstFile *f) {
-	if (f->curr_token_index+1 < f->tokens.count) {
-		f->curr_token = f->tokens[++f->curr_token_index];
+	if (token_stream_fill(f, 2)) {
+		f->lookahead_head = (f->lookahead_head+1) & (f->lookahead_cap-1);
+		f->lookahead_count -= 1;
+		f->curr_token_index += 1;
+		f->curr_token = token_lookahead_at(f, 0)->token;
 		return true;
 	}
 	syntax_error(f->curr_token, "Token is EOF");
 	return false;
 }
 
+// NOTE: The token `offset` tokens after `curr_token`, including comments
+gb_internal Token token_stream_peek_raw(AstFile *f, isize offset) {
+	if (token_stream_fill(f, offset+1)) {
+		return token_lookahead_at(f, offset)->token;
+	}
+	return f->curr_token;
+}
+
+gb_internal TokenStreamMark token_stream_mark(AstFile *f) {
+	TokenStreamMark mark = {};
+	mark.index      = f->curr_token_index;
+	mark.prev_index = f->prev_token_index;
+	mark.token      = f->curr_token;
+	mark.prev_token = f->prev_token;
+	mark.state      = token_lookahead_at(f, 0)->state;
+	return mark;
+}
+
+// NOTE: Any token after the mark is lexed again, without reporting its errors again
+gb_internal void token_stream_rewind(AstFile *f, TokenStreamMark const &mark) {
+	tokenizer_restore_state(&f->tokenizer, mark.state);
+	f->lookahead_head   = 0;
+	f->lookahead_count  = 1;
+	f->lookahead[0]     = {mark.token, mark.state};
+	f->curr_token_index = mark.index;
+	f->prev_token_index = mark.prev_index;
+	f->curr_token       = mark.token;
+	f->prev_token       = mark.prev_token;
+}
+
 
 gb_internal Token consume_comment(AstFile *f, isize *end_line_) {
 	Token tok = f->curr_token;
@@ -1490,6 +1758,12 @@ gb_internal void consume_comment_groups(AstFile *f, Token prev) {
 	if (f->curr_token.kind != Token_Comment) {
 		return;
 	}
+	if (!f->keep_comments) {
+		while (f->curr_token.kind == Token_Comment) {
+			next_token0(f);
+		}
+		return;
+	}
 	CommentGroup *comment = nullptr;
 	isize end_line = 0;
 
@@ -1545,8 +1819,8 @@ gb_internal Token advance_token(AstFile *f) {
 
 
 gb_internal Token peek_token(AstFile *f) {
-	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
+	for (isize i = 1; token_stream_fill(f, i+1); i++) {
+		Token tok = token_lookahead_at(f, i)->token;
 		if (tok.kind == Token_Comment) {
 			continue;
 		}
@@ -1557,8 +1831,8 @@ gb_internal Token peek_token(AstFile *f) {
 
 gb_internal Token peek_token_n(AstFile *f, isize n) {
 	Token found = {};
-	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
+	for (isize i = 1; token_stream_fill(f, i+1); i++) {
+		Token tok = token_lookahead_at(f, i)->token;
 		if (tok.kind == Token_Comment) {
 			continue;
 		}
@@ -1703,7 +1977,9 @@ gb_internal Token expect_operator(AstFile *f) {
 	}
 	if (prev.kind == Token_Ellipsis) {
 		syntax_error(prev, "'..' for ranges are not allowed, did you mean '..<' or '..='?");
-		f->tokens[f->curr_token_index].flags |= TokenFlag_Replace;
+		if (f->keep_tokens) {
+			f->tokens[f->curr_token_index].flags |= TokenFlag_Replace;
+		}
 	}
 	
 	advance_token(f);
@@ -1818,8 +2094,8 @@ gb_internal Token expect_closing(AstFile *f, TokenKind kind, String const &conte
 
 gb_internal void assign_removal_flag_to_semicolon(AstFile *f) {
 	// NOTE(bill): this is used for rewriting files to strip unneeded semicolons
-	Token *prev_token = &f->tokens[f->prev_token_index];
-	Token *curr_token = &f->tokens[f->curr_token_index];
+	Token const *prev_token = &f->prev_token;
+	Token const *curr_token = &f->curr_token;
 	GB_ASSERT(prev_token->kind == Token_Semicolon);
 	if (prev_token->string != ";") {
 		return;
@@ -1843,7 +2119,9 @@ gb_internal void assign_removal_flag_to_semicolon(AstFile *f) {
 	if (build_context.strict_style || (ast_file_vet_flags(f) & VetFlag_Semicolon)) {
 		syntax_error(*prev_token, "Found unneeded semicolon");
 	}
-	prev_token->flags |= TokenFlag_Remove;
+	if (f->keep_tokens) {
+		f->tokens[f->prev_token_index].flags |= TokenFlag_Remove;
+	}
 }
 
 gb_internal void expect_semicolon(AstFile *f) {
@@ -1890,6 +2168,8 @@ gb_internal Ast *        parse_proc_type(AstFile *f, Token proc_token);
 gb_internal Array<Ast *> parse_stmt_list(AstFile *f);
 gb_internal Ast *        parse_stmt(AstFile *f);
 gb_internal Ast *        parse_body(AstFile *f);
+gb_internal bool         can_skip_proc_body(AstFile *f);
+gb_internal Ast *        skip_proc_body(AstFile *f);
 gb_internal Ast *        parse_do_body(AstFile *f, Token const &token, char const *msg);
 gb_internal Ast *        parse_block_stmt(AstFile *f, b32 is_when);
 
@@ -2118,11 +2398,7 @@ gb_internal Ast *convert_stmt_to_expr(AstFile *f, Ast *statement, String const &
 	}
 
 	syntax_error(f->curr_token, "Expected '%.*s', found a simple statement.", LIT(kind));
-	Token end = f->curr_token;
-	if (f->tokens.count < f->curr_token_index) {
-		end = f->tokens[f->curr_token_index+1];
-	}
-	return ast_bad_expr(f, f->curr_token, end);
+	return ast_bad_expr(f, f->curr_token, f->curr_token);
 }
 
 gb_internal Ast *convert_stmt_to_body(AstFile *f, Ast *stmt) {
@@ -2598,9 +2874,18 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 		} else if (f->curr_token.kind == Token_OpenBrace) {
 			Ast *curr_proc = f->curr_proc;
 			Ast *body = nullptr;
-			f->curr_proc = type;
-			body = parse_body(f);
-			f->curr_proc = curr_proc;
+			TokenStreamMark *lazy_body = nullptr;
+			if (curr_proc == nullptr && can_skip_proc_body(f)) {
+				lazy_body = gb_alloc_item(ast_allocator(f), TokenStreamMark);
+				*lazy_body = token_stream_mark(f);
+				body = skip_proc_body(f);
+			}
+			if (body == nullptr) {
+				lazy_body = nullptr;
+				f->curr_proc = type;
+				body = parse_body(f);
+				f->curr_proc = curr_proc;
+			}
 
 			// Apply the tags directly to the body rather than the type
 			if (tags & ProcTag_no_bounds_check) {
@@ -2616,7 +2901,9 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 				body->state_flags |= StateFlag_type_assert;
 			}
 
-			return ast_proc_lit(f, type, body, tags, where_token, where_clauses);
+			Ast *pl = ast_proc_lit(f, type, body, tags, where_token, where_clauses);
+			pl->ProcLit.lazy_body.store(lazy_body, std::memory_order_relaxed);
+			return pl;
 		} else if (allow_token(f, Token_do)) {
 			Ast *curr_proc = f->curr_proc;
 			Ast *body = nullptr;
@@ -2805,6 +3092,7 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 		bool is_all_or_none     = false;
 		bool is_raw_union       = false;
 		bool is_simple          = false;
+		bool is_reorder         = false;
 		Ast *align              = nullptr;
 		Ast *min_field_align    = nullptr;
 		Ast *max_field_align    = nullptr;
@@ -2896,6 +3184,11 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 					syntax_error(tag, "Duplicate struct tag '#%.*s'", LIT(tag.string));
 				}
 				is_simple = true;
+			} else if (tag.string == "reorder") {
+				if (is_reorder) {
+					syntax_error(tag, "Duplicate struct tag '#%.*s'", LIT(tag.string));
+				}
+				is_reorder = true;
 			} else {
 				syntax_error(tag, "Invalid struct tag '#%.*s'", LIT(tag.string));
 			}
@@ -2907,6 +3200,10 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 			is_all_or_none = false;
 			syntax_error(token, "'#raw_union' cannot also be '#all_or_none'");
 		}
+		if (is_reorder && (is_raw_union || is_packed)) {
+			syntax_error(token, "'%s' cannot also be '#reorder'", is_raw_union ? "#raw_union" : "#packed");
+			is_reorder = false;
+		}
 
 		Token where_token = {};
 		Array<Ast *> where_clauses = {};
@@ -2937,7 +3234,7 @@ gb_internal Ast *parse_operand(AstFile *f, bool lhs) {
 		parser_check_polymorphic_record_parameters(f, polymorphic_params);
 
 		return ast_struct_type(f, token, decls, name_count,
-		                       polymorphic_params, is_packed, is_raw_union, is_all_or_none, is_simple,
+		                       polymorphic_params, is_packed, is_raw_union, is_all_or_none, is_simple, is_reorder,
 		                       align, min_field_align, max_field_align,
 		                       where_token, where_clauses);
 	} break;
@@ -4703,6 +5000,123 @@ gb_internal Ast *parse_body(AstFile *f) {
 	return ast_block_stmt(f, stmts, open, close);
 }
 
+// NOTE: Only the top-level procedure bodies of '#+lazy' files are skipped, since those
+// procedures are only checked when they are used. The body is parsed on demand by
+// 'parse_lazy_proc_body' when it is first needed.
+gb_internal bool can_skip_proc_body(AstFile *f) {
+	if ((f->flags & AstFile_IsLazy) == 0) {
+		return false;
+	}
+	if (build_context.cached) {
+		// NOTE: '#load' directives within the bodies must be seen when recording the cache
+		return false;
+	}
+	switch (build_context.command_kind) {
+	case Command_strip_semicolon:
+	case Command_doc:
+		return false;
+	}
+	return true;
+}
+
+gb_internal Ast *skip_proc_body(AstFile *f) {
+	GB_ASSERT(f->curr_token.kind == Token_OpenBrace);
+	TokenStreamMark open_mark = token_stream_mark(f);
+	isize depth = 0;
+	for (;;) {
+		TokenKind kind = f->curr_token.kind;
+		if (kind == Token_OpenBrace) {
+			depth += 1;
+		} else if (kind == Token_CloseBrace) {
+			depth -= 1;
+			if (depth == 0) {
+				break;
+			}
+		} else if (kind == Token_EOF) {
+			// NOTE: Unbalanced braces, parse it normally to report the errors
+			token_stream_rewind(f, open_mark);
+			return nullptr;
+		}
+		next_token0(f);
+	}
+
+	Token open = open_mark.token;
+	Token close = expect_token(f, Token_CloseBrace);
+	return ast_block_stmt(f, {}, open, close);
+}
+
+gb_internal void parse_lazy_proc_body(Ast *proc_lit) {
+	GB_ASSERT(proc_lit->kind == Ast_ProcLit);
+	// NOTE: pairs with the release store once the body has been filled in, so that a thread
+	// which sees `nullptr` here also sees the parsed statements
+	if (proc_lit->ProcLit.lazy_body.load(std::memory_order_acquire) == nullptr) {
+		return;
+	}
+	AstFile *f = proc_lit->thread_safe_file();
+	GB_ASSERT(f != nullptr);
+
+	mutex_lock(&f->lazy_body_mutex);
+	defer (mutex_unlock(&f->lazy_body_mutex));
+
+	TokenStreamMark *open_mark = proc_lit->ProcLit.lazy_body.load(std::memory_order_relaxed);
+	if (open_mark == nullptr) {
+		return;
+	}
+
+	TokenStreamMark prev_mark      = token_stream_mark(f);
+	isize    prev_expr_level       = f->expr_level;
+	bool     prev_allow_newline    = f->allow_newline;
+	bool     prev_allow_range      = f->allow_range;
+	bool     prev_allow_in_expr    = f->allow_in_expr;
+	bool     prev_in_foreign_block = f->in_foreign_block;
+	bool     prev_allow_type       = f->allow_type;
+	bool     prev_in_when_stmt     = f->in_when_statement;
+	Ast *    prev_curr_proc        = f->curr_proc;
+	isize    prev_fix_count        = f->fix_count;
+	TokenPos prev_fix_prev_pos     = f->fix_prev_pos;
+	CommentGroup *prev_lead_comment = f->lead_comment;
+	CommentGroup *prev_line_comment = f->line_comment;
+	CommentGroup *prev_docs         = f->docs;
+
+	token_stream_rewind(f, *open_mark);
+	f->expr_level        = 0;
+	f->allow_newline     = false;
+	f->allow_range       = false;
+	f->allow_in_expr     = false;
+	f->in_foreign_block  = false;
+	f->allow_type        = false;
+	f->in_when_statement = false;
+	f->curr_proc         = proc_lit->ProcLit.type;
+	f->fix_count         = 0;
+	f->fix_prev_pos      = {};
+
+	Ast *parsed = parse_body(f);
+
+	token_stream_rewind(f, prev_mark);
+	f->expr_level        = prev_expr_level;
+	f->allow_newline     = prev_allow_newline;
+	f->allow_range       = prev_allow_range;
+	f->allow_in_expr     = prev_allow_in_expr;
+	f->in_foreign_block  = prev_in_foreign_block;
+	f->allow_type        = prev_allow_type;
+	f->in_when_statement = prev_in_when_stmt;
+	f->curr_proc         = prev_curr_proc;
+	f->fix_count         = prev_fix_count;
+	f->fix_prev_pos      = prev_fix_prev_pos;
+	f->lead_comment      = prev_lead_comment;
+	f->line_comment      = prev_line_comment;
+	f->docs              = prev_docs;
+
+	// NOTE: Fill in the placeholder in place so that any reference to the body stays valid
+	Ast *body = proc_lit->ProcLit.body;
+	GB_ASSERT(body != nullptr && body->kind == Ast_BlockStmt);
+	GB_ASSERT(parsed->kind == Ast_BlockStmt);
+	body->BlockStmt.stmts = parsed->BlockStmt.stmts;
+	body->BlockStmt.close = parsed->BlockStmt.close;
+
+	proc_lit->ProcLit.lazy_body.store(nullptr, std::memory_order_release);
+}
+
 gb_internal Ast *parse_do_body(AstFile *f, Token const &token, char const *msg) {
 	Token open, close;
 	isize prev_expr_level = f->expr_level;
@@ -4820,7 +5234,7 @@ if_else_chain:;
 			break;
 		default:
 			syntax_error(f->curr_token, "Expected if statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, token_stream_peek_raw(f, 1));
 			break;
 		}
 	}
@@ -4878,7 +5292,7 @@ gb_internal Ast *parse_when_stmt(AstFile *f) {
 		} break;
 		default:
 			syntax_error(f->curr_token, "Expected when statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, token_stream_peek_raw(f, 1));
 			break;
 		}
 	}
@@ -5556,6 +5970,24 @@ gb_internal Ast *parse_stmt(AstFile *f) {
 				syntax_error(token, "#reverse can only be applied to a 'for in' statement");
 			}
 			return for_stmt;
+		} else if (tag == "prefetch") {
+			Ast *distance = nullptr;
+			expect_token(f, Token_OpenParen);
+			f->expr_level++;
+			distance = parse_expr(f, false);
+			f->expr_level--;
+			expect_closing(f, Token_CloseParen, str_lit("#prefetch"));
+
+			Ast *for_stmt = parse_stmt(f);
+			if (for_stmt->kind == Ast_RangeStmt) {
+				if (for_stmt->RangeStmt.prefetch) {
+					syntax_error(token, "#prefetch already applied to a 'for in' statement");
+				}
+				for_stmt->RangeStmt.prefetch = distance;
+			} else {
+				syntax_error(token, "#prefetch can only be applied to a 'for in' statement");
+			}
+			return for_stmt;
 		} else if (tag == "include") {
 			syntax_error(token, "#include is not a valid import declaration kind. Did you mean 'import'?");
 			s = ast_bad_stmt(f, token, f->curr_token);
@@ -5706,7 +6138,104 @@ gb_internal Array<Ast *> parse_stmt_list(AstFile *f) {
 }
 
 
-gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, TokenPos *err_pos) {
+// NOTE: The packages which every build certainly parses (`base:runtime`, what it imports, and the
+// initial package itself) are read from disk on a background thread whilst the target and the build
+// paths are still being set up. `parse_packages` then takes the contents from here rather than
+// reading the files itself. Only reading is done ahead of time: whether a file is excluded and how it
+// is tokenized depends on the target, which is not known yet.
+struct ParserPrewarm {
+	ThreadPool            pool;
+	bool                  started;
+	BlockingMutex         mutex;
+	StringMap<LoadedFile> files;
+};
+
+gb_global ParserPrewarm parser_prewarm;
+
+gb_internal WORKER_TASK_PROC(parser_prewarm_worker_proc) {
+	String const FILE_EXT = str_lit(".odin");
+	String dir = *cast(String *)data;
+
+	Array<FileInfo> list = {};
+	ReadDirectoryError rd_err = read_directory_cached(dir, &list);
+	defer (array_free(&list));
+	if (rd_err != ReadDirectory_None) {
+		return 0;
+	}
+
+	for (FileInfo const &fi : list) {
+		if (fi.is_dir || path_extension(fi.name) != FILE_EXT) {
+			continue;
+		}
+		LoadedFile loaded_file = {};
+		char const *c_path = alloc_cstring(permanent_allocator(), fi.fullpath);
+		if (load_file_32(c_path, &loaded_file, build_context.copy_file_contents) != LoadedFile_None) {
+			// NOTE: any errors are reported when the file is actually parsed
+			continue;
+		}
+		String key = copy_string(permanent_allocator(), fi.fullpath);
+		mutex_lock(&parser_prewarm.mutex);
+		string_map_set(&parser_prewarm.files, key, loaded_file);
+		mutex_unlock(&parser_prewarm.mutex);
+	}
+	return 0;
+}
+
+gb_internal void parser_prewarm_add_dir(String const &dir) {
+	if (dir.len == 0) {
+		return;
+	}
+	String *data = permanent_alloc_item<String>();
+	*data = dir;
+	thread_pool_add_task(&parser_prewarm.pool, parser_prewarm_worker_proc, data);
+}
+
+gb_internal void parser_prewarm_start(String const &init_filename) {
+	if ((build_context.command_kind & Command__does_check) == 0) {
+		return;
+	}
+	string_map_init(&parser_prewarm.files);
+	thread_pool_init(&parser_prewarm.pool, 1, "ParserPrewarm");
+	parser_prewarm.started = true;
+
+	parser_prewarm_add_dir(get_fullpath_base_collection(permanent_allocator(), str_lit("runtime"), nullptr));
+	parser_prewarm_add_dir(get_fullpath_base_collection(permanent_allocator(), str_lit("sanitizer"), nullptr));
+	if (build_context.command_kind == Command_test) {
+		parser_prewarm_add_dir(get_fullpath_core_collection(permanent_allocator(), str_lit("testing"), nullptr));
+	}
+
+	if (init_filename.len != 0) {
+		String init_fullpath = path_to_full_path(permanent_allocator(), init_filename);
+		if (path_is_directory_cached(init_fullpath)) {
+			parser_prewarm_add_dir(init_fullpath);
+		}
+	}
+}
+
+// NOTE: Must be called before the global thread pool is initialized
+gb_internal void parser_prewarm_finish(void) {
+	if (!parser_prewarm.started) {
+		return;
+	}
+	parser_prewarm.started = false;
+	thread_pool_wait(&parser_prewarm.pool);
+	thread_pool_destroy(&parser_prewarm.pool);
+}
+
+// NOTE: `parser_prewarm.files` is no longer written to once parsing starts, so no lock is needed
+gb_internal bool parser_prewarmed_file(String const &fullpath, LoadedFile *loaded_file) {
+	LoadedFile *found = string_map_get(&parser_prewarm.files, fullpath);
+	if (found == nullptr) {
+		return false;
+	}
+	*loaded_file = *found;
+	return true;
+}
+
+
+gb_internal bool prescan_file_header_excludes_file(AstFile *f);
+
+gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath) {
 	GB_ASSERT(f != nullptr);
 	f->fullpath  = string_trim_whitespace(fullpath); // Just in case
 	f->filename  = remove_directory_from_path(f->fullpath);
@@ -5719,7 +6248,12 @@ gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, Tok
 	gb_zero_item(&f->tokenizer);
 	f->tokenizer.curr_file_id = f->id;
 
-	TokenizerInitError err = init_tokenizer_from_fullpath(&f->tokenizer, f->fullpath, build_context.copy_file_contents);
+	TokenizerInitError err = TokenizerInit_None;
+	if (parser_prewarmed_file(f->fullpath, &f->tokenizer.loaded_file)) {
+		init_tokenizer_with_data(&f->tokenizer, f->fullpath, f->tokenizer.loaded_file.data, cast(isize)f->tokenizer.loaded_file.size);
+	} else {
+		err = init_tokenizer_from_fullpath(&f->tokenizer, f->fullpath, build_context.copy_file_contents);
+	}
 	if (err != TokenizerInit_None) {
 		switch (err) {
 		case TokenizerInit_Empty:
@@ -5736,48 +6270,51 @@ gb_internal ParseFileError init_ast_file(AstFile *f, String const &fullpath, Tok
 
 	}
 
-	isize file_size = f->tokenizer.end - f->tokenizer.start;
+	if (err == TokenizerInit_None && prescan_file_header_excludes_file(f)) {
+		// NOTE: The file is loaded but never tokenized nor allocated any tokens for
+		return ParseFile_ExcludedByTag;
+	}
+
+	f->keep_comments = build_context.command_kind == Command_doc || build_context.export_defineables_file.len != 0;
+	f->keep_tokens = build_context.command_kind == Command_strip_semicolon;
+	if (f->keep_tokens) {
+		isize file_size = f->tokenizer.end - f->tokenizer.start;
 
-	// NOTE(bill): Determine allocation size required for tokens
-	isize token_cap = file_size/3ll;
-	isize pow2_cap = gb_max(cast(isize)prev_pow2(cast(i64)token_cap)/2, 16);
-	token_cap = ((token_cap + pow2_cap-1)/pow2_cap) * pow2_cap;
+		// NOTE(bill): Determine allocation size required for tokens
+		isize token_cap = file_size/3ll;
+		isize pow2_cap = gb_max(cast(isize)prev_pow2(cast(i64)token_cap)/2, 16);
+		token_cap = ((token_cap + pow2_cap-1)/pow2_cap) * pow2_cap;
 
-	isize init_token_cap = gb_max(token_cap, 16);
-	array_init(&f->tokens, ast_allocator(f), 0, gb_max(init_token_cap, 16));
+		array_init(&f->tokens, ast_allocator(f), 0, gb_max(token_cap, 16));
+	}
+
+	f->prev_token_index = 0;
+	f->curr_token_index = 0;
 
 	if (err == TokenizerInit_Empty) {
 		Token token = {Token_EOF};
 		token.pos.file_id = f->id;
 		token.pos.line    = 1;
 		token.pos.column  = 1;
-		array_add(&f->tokens, token);
-		return ParseFile_None;
-	}
-
-	u64 start = time_stamp_time_now();
-
-	for (;;) {
-		Token *token = array_add_and_get(&f->tokens);
-		tokenizer_get_token(&f->tokenizer, token);
-		if (token->kind == Token_Invalid) {
-			err_pos->line   = token->pos.line;
-			err_pos->column = token->pos.column;
-			return ParseFile_InvalidToken;
-		}
-
-		if (token->kind == Token_EOF) {
-			break;
+		f->lookahead       = gb_alloc_array(ast_allocator(f), TokenLookahead, 1);
+		f->lookahead_cap   = 1;
+		f->lookahead_count = 1;
+		f->lookahead[0].token = token;
+		f->token_count = 1;
+		if (f->keep_tokens) {
+			array_add(&f->tokens, token);
 		}
+	} else {
+		ast_file_build_line_offsets(f);
+		token_stream_fill(f, 1);
 	}
 
-	u64 end = time_stamp_time_now();
-	f->time_to_tokenize = cast(f64)(end-start)/cast(f64)time_stamp__freq();
-
-	f->prev_token_index = 0;
-	f->curr_token_index = 0;
-	f->prev_token = f->tokens[f->prev_token_index];
-	f->curr_token = f->tokens[f->curr_token_index];
+	f->first_token = token_lookahead_at(f, 0)->token;
+	f->prev_token  = f->first_token;
+	f->curr_token  = f->first_token;
+	if (err == TokenizerInit_Empty) {
+		return ParseFile_None;
+	}
 
 	array_init(&f->comments, ast_allocator(f), 0, 0);
 	array_init(&f->imports,  ast_allocator(f), 0, 0);
@@ -5798,6 +6335,10 @@ gb_internal bool init_parser(Parser *p) {
 	GB_ASSERT(p != nullptr);
 	string_set_init(&p->imported_files);
 	array_init(&p->packages, permanent_allocator());
+	mutex_set_name(&p->imported_files_mutex, "Parser.imported_files_mutex");
+	mutex_set_name(&p->packages_mutex,       "Parser.packages_mutex");
+	mutex_set_name(&p->file_decl_mutex,      "Parser.file_decl_mutex");
+	mutex_set_name(&p->file_error_mutex,     "Parser.file_error_mutex");
 	return true;
 }
 
@@ -5845,13 +6386,17 @@ gb_internal WORKER_TASK_PROC(parser_worker_proc) {
 }
 
 
-gb_internal void parser_add_file_to_process(Parser *p, AstPackage *pkg, FileInfo fi, TokenPos pos) {
+gb_internal ParserWorkerData *parser_make_file_to_process(Parser *p, AstPackage *pkg, FileInfo fi, TokenPos pos) {
 	ImportedFile f = {pkg, fi, pos, p->file_to_process_count++};
 	f.pos.file_id = cast(i32)(f.index+1);
 	auto wd = permanent_alloc_item<ParserWorkerData>();
 	wd->parser = p;
 	wd->imported_file = f;
-	thread_pool_add_task(parser_worker_proc, wd);
+	return wd;
+}
+
+gb_internal void parser_add_file_to_process(Parser *p, AstPackage *pkg, FileInfo fi, TokenPos pos) {
+	thread_pool_add_task(parser_worker_proc, parser_make_file_to_process(p, pkg, fi, pos));
 }
 
 gb_internal WORKER_TASK_PROC(foreign_file_worker_proc) {
@@ -5894,41 +6439,25 @@ gb_internal void parser_add_foreign_file_to_process(Parser *p, AstPackage *pkg,
 
 
 // NOTE(bill): Returns true if it's added
-gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const &rel_path, TokenPos pos, PackageKind kind = Package_Normal) {
-	String const FILE_EXT = str_lit(".odin");
-
-	MUTEX_GUARD_BLOCK(&p->imported_files_mutex) {
-		if (string_set_update(&p->imported_files, path)) {
-			return nullptr;
-		}
-	}
-
-	path = copy_string(permanent_allocator(), path);
-
-	AstPackage *pkg = permanent_alloc_item<AstPackage>();
-	pkg->kind = kind;
-	pkg->fullpath = path;
-	array_init(&pkg->files, permanent_allocator());
-	pkg->foreign_files.allocator = permanent_allocator();
-
-	// NOTE(bill): Single file initial package
-	if (kind == Package_Init && !path_is_directory(path) && string_ends_with(path, FILE_EXT)) {
-		FileInfo fi = {};
-		fi.name = filename_from_path(path);
-		fi.fullpath = path;
-		fi.size = get_file_size(path);
-		fi.is_dir = false;
+struct PackageDiscoveryWorkerData {
+	Parser *    parser;
+	AstPackage *pkg;
+	String      rel_path;
+	TokenPos    pos;
+};
 
-		array_reserve(&pkg->files, 1);
-		pkg->is_single_file = true;
-		parser_add_package(p, pkg);
-		parser_add_file_to_process(p, pkg, fi, pos);
-		return pkg;
-	}
+gb_internal WORKER_TASK_PROC(package_discovery_worker_proc) {
+	PackageDiscoveryWorkerData *wd = cast(PackageDiscoveryWorkerData *)data;
+	String const FILE_EXT = str_lit(".odin");
 
+	Parser *p           = wd->parser;
+	AstPackage *pkg     = wd->pkg;
+	String path         = pkg->fullpath;
+	String rel_path     = wd->rel_path;
+	TokenPos pos        = wd->pos;
 
 	Array<FileInfo> list = {};
-	ReadDirectoryError rd_err = read_directory(path, &list);
+	ReadDirectoryError rd_err = read_directory_cached(path, &list);
 	defer (array_free(&list));
 
 	if (list.count == 1) {
@@ -5939,27 +6468,27 @@ gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const
 	switch (rd_err) {
 	case ReadDirectory_InvalidPath:
 		syntax_error(pos, "Invalid path: %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	case ReadDirectory_NotExists:
 		syntax_error(pos, "Path does not exist: %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	case ReadDirectory_Permission:
 		syntax_error(pos, "Unknown error whilst reading path %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	case ReadDirectory_NotDir:
 		syntax_error(pos, "Expected a directory for a package, got a file: %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	case ReadDirectory_Empty:
 		syntax_error(pos, "Empty directory: %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	case ReadDirectory_Unknown:
 		syntax_error(pos, "Unknown error whilst reading path %.*s", LIT(rel_path));
-		return nullptr;
+		return 1;
 	}
 
 	if (string_ends_with(path, str_lit(".odin"))) {
 		error(pos, "'import' declarations cannot import directories with a .odin extension/suffix");
-		return nullptr;
+		return 1;
 	}
 
 	isize files_with_ext = 0;
@@ -5984,11 +6513,17 @@ gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const
 		if (build_context.command_kind == Command_test) {
 			error_line("\tSuggestion: Make an .odin file that imports packages to test and use the `-all-packages` flag.");
 		}
-		return nullptr;
+		return 1;
 	}
 
 
 	array_reserve(&pkg->files, files_to_reserve);
+
+	// NOTE: The files are submitted largest first (by their size on disk), so that a single large
+	// (e.g. generated) file is not started last and left as the one task the whole parse waits on,
+	// see `thread_pool_add_tasks_largest_first`
+	TEMPORARY_ALLOCATOR_GUARD();
+	auto file_tasks = array_make<WorkerTaskWithSize>(temporary_allocator(), 0, files_to_reserve);
 	for (FileInfo fi : list) {
 		String name = fi.name;
 		String ext = path_extension(name);
@@ -5996,7 +6531,11 @@ gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const
 			if (is_excluded_target_filename(name)) {
 				continue;
 			}
-			parser_add_file_to_process(p, pkg, fi, pos);
+			WorkerTaskWithSize t = {};
+			t.proc = parser_worker_proc;
+			t.data = parser_make_file_to_process(p, pkg, fi, pos);
+			t.size_hint = cast(u64)gb_max(fi.size, 0);
+			array_add(&file_tasks, t);
 		} else if (ext == ".S" || ext ==".s") {
 			if (is_excluded_target_filename(name)) {
 				continue;
@@ -6004,8 +6543,54 @@ gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const
 			parser_add_foreign_file_to_process(p, pkg, AstForeignFile_S, fi, pos);
 		}
 	}
+	thread_pool_add_tasks_largest_first(&global_thread_pool, nullptr, slice_from_array(file_tasks));
 
 	parser_add_package(p, pkg);
+	return 0;
+}
+
+// NOTE: The directory of a newly discovered package is read on the thread pool, so all of the packages
+// found whilst parsing (and the initial ones, e.g. with `-all-packages`) are listed concurrently.
+// Any errors are reported from that task; the package is only added to the parser once its directory
+// has been read successfully.
+gb_internal AstPackage *try_add_import_path(Parser *p, String path, String const &rel_path, TokenPos pos, PackageKind kind = Package_Normal) {
+	String const FILE_EXT = str_lit(".odin");
+
+	MUTEX_GUARD_BLOCK(&p->imported_files_mutex) {
+		if (string_set_update(&p->imported_files, path)) {
+			return nullptr;
+		}
+	}
+
+	path = copy_string(permanent_allocator(), path);
+
+	AstPackage *pkg = permanent_alloc_item<AstPackage>();
+	pkg->kind = kind;
+	pkg->fullpath = path;
+	array_init(&pkg->files, permanent_allocator());
+	pkg->foreign_files.allocator = permanent_allocator();
+
+	// NOTE(bill): Single file initial package
+	if (kind == Package_Init && !path_is_directory_cached(path) && string_ends_with(path, FILE_EXT)) {
+		FileInfo fi = {};
+		fi.name = filename_from_path(path);
+		fi.fullpath = path;
+		fi.size = get_file_size_cached(path);
+		fi.is_dir = false;
+
+		array_reserve(&pkg->files, 1);
+		pkg->is_single_file = true;
+		parser_add_package(p, pkg);
+		parser_add_file_to_process(p, pkg, fi, pos);
+		return pkg;
+	}
+
+	auto wd = permanent_alloc_item<PackageDiscoveryWorkerData>();
+	wd->parser   = p;
+	wd->pkg      = pkg;
+	wd->rel_path = copy_string(permanent_allocator(), rel_path);
+	wd->pos      = pos;
+	thread_pool_add_task(package_discovery_worker_proc, wd);
 
 	return pkg;
 }
@@ -6254,7 +6839,7 @@ gb_internal bool determine_path_from_string(BlockingMutex *file_mutex, Ast *node
 	if (has_windows_drive) {
 		*path = file_str;
 	} else {
-		String fullpath = string_trim_whitespace(get_fullpath_relative(permanent_allocator(), base_dir, file_str, nullptr));
+		String fullpath = string_trim_whitespace(get_fullpath_relative_interned(base_dir, file_str, nullptr));
 		*path = fullpath;
 	}
 	return true;
@@ -6818,11 +7403,137 @@ gb_internal bool parse_file_tag(const String &lc, const Token &tok, AstFile *f)
 	return true;
 }
 
+gb_internal bool is_exclusion_file_tag(String const &lc) {
+	return string_starts_with(lc, str_lit("build")) || // also covers 'build-project-name'
+	       string_starts_with(lc, str_lit("test")) ||
+	       string_starts_with(lc, str_lit("ignore"));
+}
+
+// NOTE: Scans the raw bytes before the package declaration for the file tags that can exclude the file
+// from this build, so that excluded files (e.g. other platforms' files in the core library) never get
+// tokenized. This only evaluates the tags when the header is well formed and would produce no errors of
+// its own, otherwise everything is left to `parse_file` so that it reports exactly what it always has.
+// If the file is not excluded, `f->exclusion_tags_checked` is set so that `parse_file` does not
+// evaluate (and possibly report errors for) those tags a second time.
+gb_internal bool prescan_file_header_excludes_file(AstFile *f) {
+	u8 *start = f->tokenizer.start;
+	u8 *end   = f->tokenizer.end;
+	u8 *curr  = start;
+	i32 line = 1;
+	u8 *line_start = start;
+
+	auto column_of = [&](u8 *ptr) -> i32 {
+		i32 column = 1;
+		for (u8 *c = line_start; c < ptr; c++) {
+			column += (*c & 0xc0) != 0x80; // count runes, not bytes
+		}
+		return column;
+	};
+
+	if (end-curr >= 3 && curr[0] == 0xef && curr[1] == 0xbb && curr[2] == 0xbf) {
+		curr += 3; // BOM
+		line_start = curr;
+	}
+
+	Array<Token> tags = array_make<Token>(temporary_allocator());
+
+	for (;;) {
+		if (curr >= end) {
+			return false;
+		}
+		u8 c = *curr;
+		if (c == '\n') {
+			curr += 1;
+			line += 1;
+			line_start = curr;
+		} else if (c == ' ' || c == '\t' || c == '\r') {
+			curr += 1;
+		} else if (c == '/' && curr+1 < end && curr[1] == '/') {
+			while (curr < end && *curr != '\n') {
+				curr += 1;
+			}
+		} else if (c == '/' && curr+1 < end && curr[1] == '*') {
+			curr += 2;
+			for (isize comment_scope = 1; comment_scope > 0; /**/) {
+				if (curr >= end) {
+					return false; // unterminated, let the tokenizer report it
+				}
+				if (curr[0] == '/' && curr+1 < end && curr[1] == '*') {
+					curr += 2;
+					comment_scope += 1;
+				} else if (curr[0] == '*' && curr+1 < end && curr[1] == '/') {
+					curr += 2;
+					comment_scope -= 1;
+				} else {
+					if (curr[0] == '\n') {
+						line += 1;
+						line_start = curr+1;
+					}
+					curr += 1;
+				}
+			}
+		} else if (c == '#' && curr+1 < end && curr[1] == '!') {
+			while (curr < end && *curr != '\n') {
+				curr += 1;
+			}
+		} else if (c == '#' && curr+1 < end && curr[1] == '+') {
+			Token tok = {Token_FileTag};
+			tok.pos.file_id = f->id;
+			tok.pos.offset  = cast(i32)(curr - start);
+			tok.pos.line    = line;
+			tok.pos.column  = column_of(curr);
+			u8 *tag_start = curr;
+			curr += 2;
+			while (curr < end && *curr != '\n' && *curr != '/') {
+				curr += 1;
+			}
+			tok.string = make_string(tag_start, curr - tag_start);
+			array_add(&tags, tok);
+		} else {
+			break;
+		}
+	}
+
+	String const package_keyword = str_lit("package");
+	if (end-curr <= package_keyword.len ||
+	    make_string(curr, package_keyword.len) != package_keyword ||
+	    (curr[package_keyword.len] != ' ' && curr[package_keyword.len] != '\t')) {
+		return false;
+	}
+	curr += package_keyword.len;
+	while (curr < end && (*curr == ' ' || *curr == '\t')) {
+		curr += 1;
+	}
+	u8 *name_start = curr;
+	while (curr < end && (gb_char_is_alphanumeric(cast(char)*curr) || *curr == '_')) {
+		curr += 1;
+	}
+	String package_name = make_string(name_start, curr - name_start);
+	if (package_name.len == 0 || gb_char_is_digit(cast(char)package_name[0]) ||
+	    (curr < end && *curr >= 0x80)) {
+		return false;
+	}
+	if (package_name == "_" || package_name == "runtime" || is_package_name_reserved(package_name)) {
+		// NOTE: `parse_file` reports these even for excluded files
+		return false;
+	}
+
+	for (Token const &tok : tags) {
+		String lt = string_trim_whitespace(substring(tok.string, 2, tok.string.len));
+		if (is_exclusion_file_tag(lt) && !parse_file_tag(lt, tok, f)) {
+			return true;
+		}
+	}
+
+	f->exclusion_tags_checked = true;
+	return false;
+}
+
 gb_internal bool parse_file(Parser *p, AstFile *f) {
-	if (f->tokens.count == 0) {
+	if (f->token_count == 0) {
 		return true;
 	}
-	if (f->tokens.count > 0 && f->tokens[0].kind == Token_EOF) {
+	if (f->first_token.kind == Token_EOF) {
 		return true;
 	}
 
@@ -6896,6 +7607,9 @@ gb_internal bool parse_file(Parser *p, AstFile *f) {
 		GB_ASSERT(tok.kind == Token_FileTag);
 		GB_ASSERT(string_starts_with(tok.string, str_lit("#+")));
 		String lt = string_trim_whitespace(substring(tok.string, 2, tok.string.len));
+		if (f->exclusion_tags_checked && is_exclusion_file_tag(lt)) {
+			continue;
+		}
 		if (parse_file_tag(lt, tok, f) == false) {
 			return false;
 		}
@@ -6932,6 +7646,8 @@ gb_internal bool parse_file(Parser *p, AstFile *f) {
 
 	u64 end = time_stamp_time_now();
 	f->time_to_parse = cast(f64)(end-start)/cast(f64)time_stamp__freq();
+	f->time_to_tokenize = cast(f64)f->tokenize_ticks/cast(f64)time_stamp__freq();
+	memory_account(MemorySubsystem_Tokens, f->lookahead_cap*gb_size_of(TokenLookahead) + f->tokens.capacity*gb_size_of(Token));
 
 	for (int i = 0; i < AstDelayQueue_COUNT; i++) {
 		array_init(f->delayed_decls_queues+i, ast_allocator(f), 0, f->delayed_decl_count);
@@ -6950,12 +7666,10 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 	AstFile *file = permanent_alloc_item<AstFile>();
 	file->pkg = pkg;
 	file->id = cast(i32)(imported_file.index+1);
-	TokenPos err_pos = {0};
-	ParseFileError err = init_ast_file(file, fi.fullpath, &err_pos);
-	err_pos.file_id = file->id;
+	ParseFileError err = init_ast_file(file, fi.fullpath);
 	file->last_error = err;
 
-	if (err != ParseFile_None) {
+	if (err != ParseFile_None && err != ParseFile_ExcludedByTag) {
 		if (err == ParseFile_EmptyFile) {
 			if (fi.fullpath == p->init_fullpath) {
 				syntax_error(pos, "Initial file is empty - %.*s\n", LIT(p->init_fullpath));
@@ -6975,9 +7689,6 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 			case ParseFile_NotFound:
 				syntax_error(pos, "Failed to parse file: %.*s; file cannot be found ('%.*s')", LIT(fi.name), LIT(fi.fullpath));
 				break;
-			case ParseFile_InvalidToken:
-				syntax_error(err_pos, "Failed to parse file: %.*s; invalid token found in file", LIT(fi.name));
-				break;
 			case ParseFile_EmptyFile:
 				syntax_error(pos, "Failed to parse file: %.*s; file contains no tokens", LIT(fi.name));
 				break;
@@ -7000,13 +7711,24 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 		}
 	}
 
+	if (err == ParseFile_ExcludedByTag) {
+		return ParseFile_None;
+	}
+
 	if (build_context.command_kind == Command_test) {
 		String name = file->fullpath;
 		name = remove_extension_from_path(name);
 	}
 
 
-	if (parse_file(p, file)) {
+	bool parsed = parse_file(p, file);
+	if (file->invalid_token_pos.line > 0) {
+		syntax_errors_muted_file_id = 0;
+		file->last_error = ParseFile_InvalidToken;
+		return ParseFile_InvalidToken;
+	}
+
+	if (parsed) {
 		MUTEX_GUARD_BLOCK(&pkg->files_mutex) {
 			array_add(&pkg->files, file);
 		}
@@ -7015,7 +7737,7 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 		if (pkg->name.len == 0) {
 			pkg->name = file->package_name;
 		} else if (pkg->name != file->package_name) {
-			if (file->tokens.count > 0 && file->tokens[0].kind != Token_EOF) {
+			if (file->token_count > 0 && file->first_token.kind != Token_EOF) {
 				Token tok = file->package_token;
 				tok.pos.file_id = file->id;
 				tok.pos.line = gb_max(tok.pos.line, 1);
@@ -7026,7 +7748,7 @@ gb_internal ParseFileError process_imported_file(Parser *p, ImportedFile importe
 		mutex_unlock(&pkg->name_mutex);
 
 		p->total_line_count.fetch_add(file->tokenizer.line_count);
-		p->total_token_count.fetch_add(file->tokens.count);
+		p->total_token_count.fetch_add(file->token_count);
 	}
 
 	return ParseFile_None;
@@ -7038,7 +7760,7 @@ gb_internal ParseFileError parse_packages(Parser *p, String init_filename) {
 
 	String init_fullpath = path_to_full_path(permanent_allocator(), init_filename);
 
-	if (!path_is_directory(init_fullpath)) {
+	if (!path_is_directory_cached(init_fullpath)) {
 		String const ext = str_lit(".odin");
 		if (!string_ends_with(init_fullpath, ext)) {
 			error({}, "Expected either a directory or a .odin file, got '%.*s'\n", LIT(init_filename));
@@ -7086,7 +7808,7 @@ gb_internal ParseFileError parse_packages(Parser *p, String init_filename) {
 
 		for (String const &path : build_context.extra_packages) {
 			String fullpath = path_to_full_path(permanent_allocator(), path); // LEAK?
-			if (!path_is_directory(fullpath)) {
+			if (!path_is_directory_cached(fullpath)) {
 				String const ext = str_lit(".odin");
 				if (!string_ends_with(fullpath, ext)) {
 					error({}, "Expected either a directory or a .odin file, got '%.*s'\n", LIT(fullpath));
@@ -66,6 +66,7 @@ enum ParseFileError {
 	ParseFile_GeneralError,
 	ParseFile_FileTooLarge,
 	ParseFile_DirectoryAlreadyExists,
+	ParseFile_ExcludedByTag, // NOTE: Not an error, the file's header tags exclude it from this build
 
 	ParseFile_Count,
 };
@@ -105,6 +106,21 @@ enum AstDelayQueueKind {
 	AstDelayQueue_COUNT,
 };
 
+// NOTE: A token which has been lexed ahead of the parser, along with the state of the tokenizer after it
+struct TokenLookahead {
+	Token          token;
+	TokenizerState state;
+};
+
+// NOTE: Enough to resume parsing from a token after it has left the lookahead, see 'token_stream_rewind'
+struct TokenStreamMark {
+	isize          index;
+	isize          prev_index;
+	Token          token;
+	Token          prev_token;
+	TokenizerState state;
+};
+
 struct AstFile {
 	i32          id;
 	u32          flags;
@@ -118,7 +134,29 @@ struct AstFile {
 	String       directory;
 
 	Tokenizer    tokenizer;
+	Slice<i32>   line_offsets; // byte offset of the start of each line, line N starts at `line_offsets[N-1]`
+
+	// NOTE: The parser pulls the tokens from the tokenizer on demand rather than lexing the whole file up
+	// front. `lookahead` is a ring buffer of the tokens from `curr_token` onwards which have been lexed so
+	// far, and only grows past its initial size for long runs of comments when peeking.
+	TokenLookahead *lookahead;
+	isize           lookahead_cap;   // power of two
+	isize           lookahead_head;  // ring index of `curr_token`
+	isize           lookahead_count;
+	isize           token_count;     // the number of tokens lexed so far, which is every token once at EOF
+	Token           first_token;
+	TokenPos        invalid_token_pos; // `line > 0` when an invalid token was found, which ends the file early
+	u64             tokenize_ticks;
+
+	// NOTE: Only filled when `keep_tokens` is set, for the features which need the whole token stream
+	// after parsing, e.g. `strip-semicolon`
 	Array<Token> tokens;
+	bool         keep_tokens;
+
+	// NOTE: Comment groups are only built when something reads them after parsing, e.g. `doc` and
+	// `-export-defineables`, otherwise comments are skipped like whitespace
+	bool         keep_comments;
+
 	isize        curr_token_index;
 	isize        prev_token_index;
 	Token        curr_token;
@@ -130,6 +168,7 @@ struct AstFile {
 	u64          feature_flags;
 	bool         vet_flags_set;
 	bool         feature_flags_set;
+	bool         exclusion_tags_checked; // '#+build', '#+test', etc were already evaluated by the header prescan
 
 	// >= 0: In Expression
 	// <  0: In Control Clause
@@ -164,6 +203,9 @@ struct AstFile {
 
 	std::atomic<isize> seen_load_directive_count;
 
+	// NOTE: Guards the parsing state when lazy procedure bodies are parsed on demand
+	BlockingMutex lazy_body_mutex;
+
 #define PARSER_MAX_FIX_COUNT 6
 	isize    fix_count;
 	TokenPos fix_prev_pos;
@@ -203,7 +245,6 @@ struct AstPackage {
 
 	BlockingMutex         files_mutex;
 	BlockingMutex         foreign_files_mutex;
-	BlockingMutex         type_and_value_mutex;
 	BlockingMutex         name_mutex;
 
 	// NOTE(bill): This must be a MPMCQueue
@@ -213,6 +254,8 @@ struct AstPackage {
 	Scope *   scope;
 	DeclInfo *decl_info;
 	bool      is_extra;
+
+	std::atomic<DidYouMeanIndex *> did_you_mean_index; // of `scope`, built for the first suggestion
 };
 
 
@@ -460,6 +503,7 @@ struct AstSplitArgs {
 		Token where_token; \
 		Slice<Ast *> where_clauses; \
 		DeclInfo *decl; \
+		std::atomic<struct TokenStreamMark *> lazy_body; /* non-null if the body has been skipped and is yet to be parsed */ \
 	}) \
 	AST_KIND(CompoundLit, "compound literal", struct { \
 		Ast *type; \
@@ -597,6 +641,8 @@ AST_KIND(_ComplexStmtBegin, "", bool) \
 		Ast *expr; \
 		Ast *body; \
 		bool reverse; \
+		Ast *prefetch; \
+		i64 prefetch_distance; \
 	}) \
 	AST_KIND(UnrollRangeStmt, "#unroll range statement", struct { \
 		Scope *scope; \
@@ -793,6 +839,7 @@ AST_KIND(_TypeBegin, "", bool) \
 		bool is_no_copy;            \
 		bool is_all_or_none;        \
 		bool is_simple;             \
+		bool is_reorder;            \
 	}) \
 	AST_KIND(UnionType, "union type", struct { \
 		Scope *scope; \
@@ -848,7 +895,7 @@ enum AstKind : u16 {
 };
 
 gb_global String const ast_strings[] = {
-	{cast(u8 *)"invalid node", gb_size_of("invalid node")},
+	{cast(u8 *)"invalid node", gb_size_of("invalid node")-1},
 #define AST_KIND(_kind_name_, name, ...) {cast(u8 *)name, gb_size_of(name)-1},
 	AST_KINDS
 #undef AST_KIND
@@ -868,19 +915,26 @@ gb_global isize const ast_variant_sizes[] = {
 };
 
 struct AstCommonStuff {
-	AstKind         kind; // u16
-	u8              state_flags;
-	std::atomic<u8> viral_state_flags;
-	i32             file_id;
-	TypeAndValue    tav; // NOTE(bill): Making this a pointer is slower
+	AstKind          kind; // u16
+	u8               state_flags;
+	std::atomic<u8>  viral_state_flags;
+	i32              file_id;
+	std::atomic<u32> untyped_index; // 1-based index into the owning `UntypedExprInfoMap`, 0 if none
+	std::atomic<u8>  tav_writer; // non-zero whilst `tav` is being written, see `add_type_and_value`
+	TypeAndValue     tav; // NOTE(bill): Making this a pointer is slower
 };
 
+// NOTE: `untyped_index` and `tav_writer` live in the padding before the 8 byte aligned `tav`, keep it that way
+static_assert(gb_size_of(AstCommonStuff) == 16 + gb_size_of(TypeAndValue), "Ast fields before `tav` must fit in 16 bytes");
+
 struct Ast {
-	AstKind         kind; // u16
-	u8              state_flags;
-	std::atomic<u8> viral_state_flags;
-	i32             file_id;
-	TypeAndValue    tav; // NOTE(bill): Making this a pointer is slower
+	AstKind          kind; // u16
+	u8               state_flags;
+	std::atomic<u8>  viral_state_flags;
+	i32              file_id;
+	std::atomic<u32> untyped_index; // 1-based index into the owning `UntypedExprInfoMap`, 0 if none
+	std::atomic<u8>  tav_writer; // non-zero whilst `tav` is being written, see `add_type_and_value`
+	TypeAndValue     tav; // NOTE(bill): Making this a pointer is slower
 
 	// IMPORTANT NOTE(bill): This must be at the end since the AST is allocated to be size of the variant
 	union {
@@ -935,9 +989,11 @@ gb_internal gb_inline gbAllocator ast_allocator(AstFile *f) {
 }
 
 gb_internal Ast *alloc_ast_node(AstFile *f, AstKind kind);
+gb_internal void parse_lazy_proc_body(Ast *proc_lit);
 
 gb_internal gbString expr_to_string(Ast *expression);
 gb_internal bool allow_field_separator(AstFile *f);
 
 
-gb_internal void parse_enforce_tabs(AstFile *f);
\ No newline at end of file
+gb_internal void parse_enforce_tabs(AstFile *f);
+gb_internal bool ast_file_line_column_from_offset(AstFile *f, i32 offset, i32 *line_, i32 *column_);
@@ -1,4 +1,8 @@
 gb_internal Token ast_token(Ast *node) {
+	while (node->kind == Ast_BinaryExpr) {
+		// NOTE: not recursive as chains such as `a | b | c | ...` can be thousands of operands deep
+		node = node->BinaryExpr.left;
+	}
 	switch (node->kind) {
 	case Ast_Ident:          return node->Ident.token;
 	case Ast_Implicit:       return node->Implicit;
@@ -16,7 +20,6 @@ gb_internal Token ast_token(Ast *node) {
 	case Ast_TagExpr:       return node->TagExpr.token;
 	case Ast_BadExpr:       return node->BadExpr.begin;
 	case Ast_UnaryExpr:     return node->UnaryExpr.op;
-	case Ast_BinaryExpr:    return ast_token(node->BinaryExpr.left);
 	case Ast_ParenExpr:     return node->ParenExpr.open;
 	case Ast_CallExpr:      return ast_token(node->CallExpr.proc);
 	case Ast_SelectorExpr:
@@ -123,6 +126,24 @@ gb_internal Token ast_token(Ast *node) {
 TokenPos token_pos_end(Token const &token) {
 	TokenPos pos = token.pos;
 	pos.offset += cast(i32)token.string.len;
+
+	bool is_ascii_line = true;
+	for (isize i = 0; i < token.string.len; i++) {
+		u8 c = token.string[i];
+		if (c == '\n' || (c & 0x80)) {
+			is_ascii_line = false;
+			break;
+		}
+	}
+	if (is_ascii_line) {
+		pos.column += cast(i32)token.string.len;
+		return pos;
+	}
+	// NOTE: e.g. raw strings spanning lines, derive the end position from the file's line offsets
+	if (pos.file_id > 0 && ast_file_line_column_from_offset(thread_safe_get_ast_file_from_id(pos.file_id), pos.offset, &pos.line, &pos.column)) {
+		return pos;
+	}
+
 	for (isize i = 0; i < token.string.len; i++) {
 		// TODO(bill): This assumes ASCII
 		char c = token.string[i];
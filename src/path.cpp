@@ -481,6 +481,73 @@ gb_internal ReadDirectoryError read_directory(String path, Array<FileInfo> *fi)
 #error Implement read_directory
 #endif
 
+// NOTE: Memoized file system queries for package discovery. The source tree is assumed not to change
+// whilst it is being compiled, so these are cached for the duration of the build. Directory listings
+// made through `read_directory_cached` record what they already know about their entries, which means
+// most queries on source files and package directories never reach the file system again.
+struct PathInfoCache {
+	RwMutex         mutex;
+	StringMap<bool> is_dir;
+	StringMap<i64>  size;
+};
+
+gb_global PathInfoCache g_path_info_cache;
+
+gb_internal void path_info_cache_add(String const &fullpath, bool is_dir, i64 size) {
+	String key = copy_string(permanent_allocator(), fullpath);
+	rw_mutex_lock(&g_path_info_cache.mutex);
+	string_map_set(&g_path_info_cache.is_dir, key, is_dir);
+	if (!is_dir) {
+		string_map_set(&g_path_info_cache.size, key, size);
+	}
+	rw_mutex_unlock(&g_path_info_cache.mutex);
+}
+
+gb_internal bool path_is_directory_cached(String path) {
+	rw_mutex_shared_lock(&g_path_info_cache.mutex);
+	bool *found = string_map_get(&g_path_info_cache.is_dir, path);
+	bool is_dir = found ? *found : false;
+	rw_mutex_shared_unlock(&g_path_info_cache.mutex);
+	if (found) {
+		return is_dir;
+	}
+
+	is_dir = path_is_directory(path);
+	String key = copy_string(permanent_allocator(), path);
+	rw_mutex_lock(&g_path_info_cache.mutex);
+	string_map_set(&g_path_info_cache.is_dir, key, is_dir);
+	rw_mutex_unlock(&g_path_info_cache.mutex);
+	return is_dir;
+}
+
+gb_internal i64 get_file_size_cached(String path) {
+	rw_mutex_shared_lock(&g_path_info_cache.mutex);
+	i64 *found = string_map_get(&g_path_info_cache.size, path);
+	i64 size = found ? *found : -1;
+	rw_mutex_shared_unlock(&g_path_info_cache.mutex);
+	if (found) {
+		return size;
+	}
+
+	size = get_file_size(path);
+	String key = copy_string(permanent_allocator(), path);
+	rw_mutex_lock(&g_path_info_cache.mutex);
+	string_map_set(&g_path_info_cache.size, key, size);
+	rw_mutex_unlock(&g_path_info_cache.mutex);
+	return size;
+}
+
+gb_internal ReadDirectoryError read_directory_cached(String path, Array<FileInfo> *fi) {
+	ReadDirectoryError err = read_directory(path, fi);
+	if (err == ReadDirectory_None || err == ReadDirectory_Empty) {
+		path_info_cache_add(path, true, 0);
+		for (FileInfo const &info : *fi) {
+			path_info_cache_add(info.fullpath, info.is_dir, info.size);
+		}
+	}
+	return err;
+}
+
 #if !defined(GB_SYSTEM_WINDOWS)
 gb_internal bool write_directory(String path) {
 	char const *pathname = (char *) path.text;
@@ -133,7 +133,33 @@ gb_internal void map__insert(PtrMap<K, V> *h, K key, V const &value) {
 
 template <typename K, typename V>
 gb_internal b32 map__full(PtrMap<K, V> *h) {
-	return 0.75f * h->capacity <= h->count;
+	return h->count >= h->capacity - (h->capacity>>2);
+}
+
+// NOTE: Probes for the key only once, returning its slot if present, otherwise the slot it would be
+// inserted into: the first tombstone passed, or else the empty slot which ended the probe
+template <typename K, typename V>
+gb_internal MapIndex map__find_slot(PtrMap<K, V> *h, K key, bool *found_) {
+	GB_ASSERT(h->capacity != 0);
+	u32 mask = h->capacity-1;
+	MapIndex index = ptr_map_hash_key(key) & mask;
+	MapIndex insert_index = MAP_SENTINEL;
+	for (u32 i = 0; i < h->capacity; i++) {
+		K entry_key = h->entries[index].key;
+		if (entry_key == key) {
+			*found_ = true;
+			return index;
+		} else if (!entry_key) {
+			*found_ = false;
+			return insert_index != MAP_SENTINEL ? insert_index : index;
+		} else if (entry_key == PtrMapConstant<K>::TOMBSTONE() && insert_index == MAP_SENTINEL) {
+			insert_index = index;
+		}
+		index = (index+1) & mask;
+	}
+	GB_ASSERT(insert_index != MAP_SENTINEL);
+	*found_ = false;
+	return insert_index;
 }
 
 template <typename K, typename V>
@@ -252,23 +278,28 @@ template <typename K, typename V>
 gb_internal void map_set(PtrMap<K, V> *h, K key, V const &value) {
 	GB_ASSERT(key != 0);
 	try_map_grow(h);
-	auto *found = map_get(h, key);
-	if (found) {
-		*found = value;
-		return;
+	bool found = false;
+	auto *entry = h->entries + map__find_slot(h, key, &found);
+	if (!found) {
+		entry->key = key;
+		h->count += 1;
 	}
-	map__insert(h, key, value);
+	entry->value = value;
 }
 
 // returns true if it previously existed
 template <typename K, typename V>
 gb_internal bool map_set_if_not_previously_exists(PtrMap<K, V> *h, K key, V const &value) {
+	GB_ASSERT(key != 0);
 	try_map_grow(h);
-	auto *found = map_get(h, key);
+	bool found = false;
+	auto *entry = h->entries + map__find_slot(h, key, &found);
 	if (found) {
 		return true;
 	}
-	map__insert(h, key, value);
+	entry->key   = key;
+	entry->value = value;
+	h->count += 1;
 	return false;
 }
 
@@ -880,3 +911,106 @@ template <typename K, typename V>
 gb_internal OrderedInsertPtrMapEntry<K, V> const *end(OrderedInsertPtrMap<K, V> const &m) {
 	return m.entries + m.count;
 }
+
+
+// NOTE: A PtrMap split into independently locked shards, for maps which are shared between the
+// checker threads. Each key always lives in the same shard, so the operations on a single key are
+// equivalent to a PtrMap guarded by one mutex, but threads working on different keys rarely contend.
+enum { CONCURRENT_PTR_MAP_SHARD_COUNT = 64 };
+
+template <typename K, typename V>
+struct alignas(MAP_CACHE_LINE_SIZE) ConcurrentPtrMapShard {
+	RwMutex      mutex;
+	PtrMap<K, V> map;
+};
+
+template <typename K, typename V>
+struct ConcurrentPtrMap {
+	ConcurrentPtrMapShard<K, V> shards[CONCURRENT_PTR_MAP_SHARD_COUNT];
+};
+
+template <typename K, typename V>
+gb_internal gb_inline ConcurrentPtrMapShard<K, V> *concurrent_map__shard(ConcurrentPtrMap<K, V> *h, K key) {
+	// NOTE: use the high bits as the low bits pick the slot within the shard's map
+	u32 hash = ptr_map_hash_key(cast(uintptr)key);
+	return &h->shards[(hash >> 26) & (CONCURRENT_PTR_MAP_SHARD_COUNT-1)];
+}
+
+template <typename K, typename V>
+gb_internal void concurrent_map_init(ConcurrentPtrMap<K, V> *h, isize capacity = 16*CONCURRENT_PTR_MAP_SHARD_COUNT) {
+	isize shard_capacity = gb_max(capacity / CONCURRENT_PTR_MAP_SHARD_COUNT, 16);
+	for (auto &shard : h->shards) {
+		map_init(&shard.map, shard_capacity);
+	}
+}
+
+template <typename K, typename V>
+gb_internal void concurrent_map_destroy(ConcurrentPtrMap<K, V> *h) {
+	for (auto &shard : h->shards) {
+		map_destroy(&shard.map);
+	}
+}
+
+// NOTE: The value is copied out whilst the shard is locked, rather than returning a pointer into the map
+template <typename K, typename V>
+gb_internal bool concurrent_map_get(ConcurrentPtrMap<K, V> *h, K key, V *value_) {
+	auto *shard = concurrent_map__shard(h, key);
+	rw_mutex_shared_lock(&shard->mutex);
+	V *found = map_get(&shard->map, key);
+	if (found && value_) {
+		*value_ = *found;
+	}
+	rw_mutex_shared_unlock(&shard->mutex);
+	return found != nullptr;
+}
+
+template <typename K, typename V>
+gb_internal void concurrent_map_set(ConcurrentPtrMap<K, V> *h, K key, V const &value) {
+	auto *shard = concurrent_map__shard(h, key);
+	rw_mutex_lock(&shard->mutex);
+	map_set(&shard->map, key, value);
+	rw_mutex_unlock(&shard->mutex);
+}
+
+// returns true if it previously existed
+template <typename K, typename V>
+gb_internal bool concurrent_map_set_if_not_previously_exists(ConcurrentPtrMap<K, V> *h, K key, V const &value) {
+	auto *shard = concurrent_map__shard(h, key);
+	rw_mutex_lock(&shard->mutex);
+	bool exists = map_set_if_not_previously_exists(&shard->map, key, value);
+	rw_mutex_unlock(&shard->mutex);
+	return exists;
+}
+
+template <typename K, typename V>
+gb_internal void concurrent_map_remove(ConcurrentPtrMap<K, V> *h, K key) {
+	auto *shard = concurrent_map__shard(h, key);
+	rw_mutex_lock(&shard->mutex);
+	map_remove(&shard->map, key);
+	rw_mutex_unlock(&shard->mutex);
+}
+
+// NOTE: Not thread-safe, only to be used once the threads sharing the map have finished with it
+template <typename K, typename V>
+gb_internal void concurrent_map_clear(ConcurrentPtrMap<K, V> *h) {
+	for (auto &shard : h->shards) {
+		map_clear(&shard.map);
+	}
+}
+
+template <typename K, typename V>
+gb_internal isize concurrent_map_count(ConcurrentPtrMap<K, V> *h) {
+	isize count = 0;
+	for (auto &shard : h->shards) {
+		count += shard.map.count;
+	}
+	return count;
+}
+
+template <typename K, typename V>
+gb_internal void concurrent_map_reserve(ConcurrentPtrMap<K, V> *h, isize capacity) {
+	isize shard_capacity = gb_max(capacity / CONCURRENT_PTR_MAP_SHARD_COUNT, 16);
+	for (auto &shard : h->shards) {
+		map_reserve(&shard.map, shard_capacity);
+	}
+}
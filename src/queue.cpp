@@ -34,17 +34,37 @@ gb_internal void mpsc_destroy(MPSCQueue<T> *q) {
 	GB_ASSERT(q->count.load() == 0);
 }
 
+// NOTE: Freed nodes are kept on a per-thread free list (per node type) and reused by the next
+// enqueue on that thread, rather than leaking. Being per-thread means no synchronization is needed,
+// and the consumer of one queue is commonly the producer of the next one.
+template <typename T>
+gb_internal MPSCNode<T> **mpsc__free_list(void) {
+	static gb_thread_local MPSCNode<T> *free_list = nullptr;
+	return &free_list;
+}
+
 template <typename T>
 gb_internal MPSCNode<T> *mpsc_alloc_node(MPSCQueue<T> *q, T const &value) {
-	// auto new_node = gb_alloc_item(heap_allocator(), MPSCNode<T>);
-	auto new_node = permanent_alloc_item<MPSCNode<T> >();
+	MPSCNode<T> **free_list = mpsc__free_list<T>();
+	MPSCNode<T> *new_node = *free_list;
+	if (new_node != nullptr) {
+		*free_list = new_node->next.load(std::memory_order_relaxed);
+	} else {
+		// auto new_node = gb_alloc_item(heap_allocator(), MPSCNode<T>);
+		new_node = permanent_alloc_item<MPSCNode<T> >();
+	}
 	new_node->value = value;
 	return new_node;
 }
 
 template <typename T>
 gb_internal void mpsc_free_node(MPSCQueue<T> *q, MPSCNode<T> *node) {
-	// TODO(bill): determine a good way to handle the freed nodes rather than letting them leak
+	if (node == &q->sentinel) {
+		return;
+	}
+	MPSCNode<T> **free_list = mpsc__free_list<T>();
+	node->next.store(*free_list, std::memory_order_relaxed);
+	*free_list = node;
 }
 
 template <typename T>
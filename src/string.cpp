@@ -293,6 +293,30 @@ gb_internal String string_split_iterator(String_Iterator *it, const char sep) {
 	return substring(it->str, start, end);
 }
 
+// NOTE: `*` matches any run of bytes (including none) and `?` matches any single byte
+gb_internal bool string_glob_match(String const &pattern, String const &str) {
+	isize p = 0, s = 0;
+	isize star_p = -1, star_s = 0;
+	while (s < str.len) {
+		if (p < pattern.len && (pattern[p] == '?' || pattern[p] == str[s])) {
+			p += 1;
+			s += 1;
+		} else if (p < pattern.len && pattern[p] == '*') {
+			star_p = p++;
+			star_s = s;
+		} else if (star_p >= 0) {
+			p = star_p+1;
+			s = ++star_s;
+		} else {
+			return false;
+		}
+	}
+	while (p < pattern.len && pattern[p] == '*') {
+		p += 1;
+	}
+	return p == pattern.len;
+}
+
 gb_internal gb_inline bool is_separator(u8 const &ch) {
 	return (ch == '/' || ch == '\\');
 }
@@ -420,7 +444,7 @@ gb_internal isize string_index(String const &s, String const &substr) {
 		return -1;
 	}
 	u32 pow = 1;
-	u32 hash = hash_str_rabin_karp(s, &pow);
+	u32 hash = hash_str_rabin_karp(substr, &pow);
 	u32 h = 0;
 	for (isize i = 0; i < n; i++) {
 		h = h*PRIME_RABIN_KARP + cast(u32)s.text[i];
@@ -13,8 +13,7 @@ struct String16HashKey {
 	}
 };
 gb_internal gb_inline u32 string_hash(String16 const &s) {
-	u32 res = fnv32a(s.text, s.len*gb_size_of(u16)) & 0x7fffffff;
-	return res | (res == 0);
+	return string_hash_fold(xxh64(s.text, s.len*gb_size_of(u16)));
 }
 
 gb_internal gb_inline String16HashKey string_hash_string(String16 const &s) {
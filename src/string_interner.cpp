@@ -110,55 +110,30 @@ bool InternedString::is_blank() const {
 	return this->value == g_interned_blank_ident.value;
 }
 
-gb_internal InternedString string_interner_insert(String str, u32 hash, u32 *new_hash_) {
-	StringInterner* interner = g_string_interner;
-	if (str.len == 0) {
-		if (new_hash_) *new_hash_ = string_hash(String{});
-		return {};
-	}
-
-	if (hash == 0) {
-		hash = string_hash(str);
-	}
-	if (new_hash_) *new_hash_ = hash;
-
-	u64 cell_idx = hash & interner->cell_mask;
-	StringInternCell *cell = &interner->cells[cell_idx];
-	while (true) {
-		StringInternCell *next = cell->next.load(std::memory_order_acquire);
-
+gb_internal InternedString string_interner__find(StringInternCell **cell_, String str, u32 hash, std::memory_order order) {
+	StringInternCell *cell = *cell_;
+	for (;;) {
 		for (i32 i = 0; i < STRING_INTERNER_CELL_WIDTH; i += 1) {
-			if (cell->hashes[i].load(std::memory_order_acquire) == hash) {
+			if (cell->hashes[i].load(order) == hash) {
 				String to_compare = string_interner_load(cell->offsets[i]);
 				if (to_compare == str) {
 					return cell->offsets[i];
 				}
 			}
 		}
+		StringInternCell *next = cell->next.load(order);
 		if (next == nullptr) {
 			break;
 		}
 		cell = next;
 	}
+	*cell_ = cell; // the last cell of the chain
+	return {};
+}
 
-	u64 mutex_cell = cell_idx & STRING_INTERNER_MUTEX_STRIPE_MASK;
-	PaddedMutex* m = &interner->mutexes[mutex_cell];
-	MUTEX_GUARD(&m->m);
-
-	StringInternCell *load_cell = nullptr;
-	while (cell) {
-		for (i32 i = 0; i < STRING_INTERNER_CELL_WIDTH; i += 1) {
-			if (cell->hashes[i].load(std::memory_order_relaxed) == hash) {
-				// string check
-				String to_compare = string_interner_load(cell->offsets[i]);
-				if (to_compare == str) {
-					return cell->offsets[i];
-				}
-			}
-		}
-		load_cell = cell;
-		cell = cell->next.load(std::memory_order_relaxed);
-	}
+// NOTE: `last_cell` must be the last cell of the chain and the caller must be the only one appending to it
+gb_internal InternedString string_interner__append(StringInternCell *last_cell, String str, u32 hash) {
+	StringInterner* interner = g_string_interner;
 
 	u64 data_to_allocate = 4 + str.len + 1;
 	u8 *data = cast(u8 *)string_interner_thread_local_arena_alloc(&g_interner_arena, data_to_allocate, 8);
@@ -168,13 +143,14 @@ gb_internal InternedString string_interner_insert(String str, u32 hash, u32 *new
 	data[4+str_len] = 0;
 	InternedString offset = { cast(u32)(cast(u8 *)data - cast(u8 *)interner) };
 
+	if (interner->track_count) {
+		interner->count.value.fetch_add(1, std::memory_order_relaxed);
+	}
+
 	for (i32 i = 0; i < STRING_INTERNER_CELL_WIDTH; i += 1) {
-		if (load_cell->hashes[i].load(std::memory_order_relaxed) == 0) {
-			load_cell->offsets[i] = offset;
-			load_cell->hashes[i].store(hash, std::memory_order_release);
-			if (interner->track_count) {
-				interner->count.value.fetch_add(1, std::memory_order_relaxed);
-			}
+		if (last_cell->hashes[i].load(std::memory_order_relaxed) == 0) {
+			last_cell->offsets[i] = offset;
+			last_cell->hashes[i].store(hash, std::memory_order_release);
 			return offset;
 		}
 	}
@@ -182,13 +158,59 @@ gb_internal InternedString string_interner_insert(String str, u32 hash, u32 *new
 	StringInternCell *new_cell = cast(StringInternCell *)string_interner_thread_local_arena_alloc(&g_interner_arena, gb_size_of(StringInternCell), STRING_INTERN_CACHE_LINE);
 	new_cell->offsets[0] = offset;
 	new_cell->hashes[0].store(hash, std::memory_order_relaxed);
-	load_cell->next.store(new_cell, std::memory_order_release);
+	last_cell->next.store(new_cell, std::memory_order_release);
+	return offset;
+}
 
-	if (interner->track_count) {
-		interner->count.value.fetch_add(1, std::memory_order_relaxed);
+gb_internal InternedString string_interner_insert(String str, u32 hash, u32 *new_hash_) {
+	StringInterner* interner = g_string_interner;
+	if (str.len == 0) {
+		if (new_hash_) *new_hash_ = string_hash(String{});
+		return {};
 	}
 
-	return offset;
+	if (hash == 0) {
+		hash = string_hash(str);
+	}
+	if (new_hash_) *new_hash_ = hash;
+
+	u64 cell_idx = hash & interner->cell_mask;
+	StringInternCell *cell = &interner->cells[cell_idx];
+	InternedString found = string_interner__find(&cell, str, hash, std::memory_order_acquire);
+	if (found.value != 0) {
+		return found;
+	}
+
+	u64 mutex_cell = cell_idx & STRING_INTERNER_MUTEX_STRIPE_MASK;
+	PaddedMutex* m = &interner->mutexes[mutex_cell];
+	MUTEX_GUARD(&m->m);
+
+	// NOTE: another thread may have appended to the chain since it was walked above
+	found = string_interner__find(&cell, str, hash, std::memory_order_relaxed);
+	if (found.value != 0) {
+		return found;
+	}
+	return string_interner__append(cell, str, hash);
+}
+
+// NOTE: Inserts the names which every compilation will intern anyway (keywords, builtins, attributes and
+// the common identifiers of `base:runtime`) in one go at startup. This must be called before any other
+// thread can use the interner, which is why no mutex is taken. Every later lookup of these names finds
+// them on the lock-free path of `string_interner_insert`, rather than the first parsing thread to see
+// one of them going through the striped mutexes.
+gb_internal void string_interner_preseed(String const *strings, isize count) {
+	StringInterner* interner = g_string_interner;
+	for (isize i = 0; i < count; i++) {
+		String str = strings[i];
+		if (str.len == 0) {
+			continue;
+		}
+		u32 hash = string_hash(str);
+		StringInternCell *cell = &interner->cells[hash & interner->cell_mask];
+		if (string_interner__find(&cell, str, hash, std::memory_order_relaxed).value == 0) {
+			string_interner__append(cell, str, hash);
+		}
+	}
 }
 
 gb_internal char const *string_intern_cstring(String str, u32 *hash_=nullptr) {
@@ -12,10 +12,18 @@ struct StringHashKey {
 		return this->string;
 	}
 };
-gb_internal gb_inline u32 string_hash(String const &s) {
-	u32 res = fnv32a(s.text, s.len) & 0x7fffffff;
+// NOTE: Shared by every string container and the string interner. The 64-bit hash is folded into
+// 31 bits, which is never zero (zero is used to mean an empty slot)
+gb_internal gb_inline u32 string_hash_fold(u64 h) {
+	u32 res = cast(u32)(h ^ (h >> 32)) & 0x7fffffff;
 	return res | (res == 0);
 }
+gb_internal gb_inline u64 string_hash64(String const &s) {
+	return xxh64(s.text, s.len);
+}
+gb_internal gb_inline u32 string_hash(String const &s) {
+	return string_hash_fold(string_hash64(s));
+}
 
 gb_internal gb_inline StringHashKey string_hash_string(String const &s) {
 	StringHashKey hash_key = {};
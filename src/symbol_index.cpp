@@ -0,0 +1,309 @@
+// Generates the symbol index for `-export-symbol-index:<filename>`
+//
+// The index is meant to be memory mapped and queried in place by tools (e.g. a language server), so
+// that go-to-definition and find-references do not require running the compiler again. Every table is
+// a flat array of fixed size little endian records, addressed by an offset from the start of the file.
+//
+//     go-to-definition: binary search `uses_by_pos` for the (file, offset) of the cursor, then
+//                       the use's `symbol` gives the definition's position
+//     find-references:  all uses of a symbol are contiguous in `uses`, see `first_use` and `use_count`
+//
+// The reader lives in `core:odin/symbol-index`.
+
+#define OdinSymbolIndexMagic "odinsym\0"
+
+enum : u32 { OdinSymbolIndexVersion = 1 };
+
+struct OdinSymbolIndexArray {
+	u32 offset;
+	u32 length;
+};
+
+using OdinSymbolIndexString = OdinSymbolIndexArray;
+
+struct OdinSymbolIndexPos {
+	u32 file; // index into `files`, 0 when the entity has no source position (e.g. builtins)
+	u32 line;
+	u32 column;
+	u32 offset;
+};
+
+enum OdinSymbolIndexSymbolFlag : u32 {
+	OdinSymbolIndexSymbolFlag_Global = 1<<0, // declared in a package or file scope
+};
+
+struct OdinSymbolIndexSymbol {
+	OdinSymbolIndexString name;
+	OdinSymbolIndexString pkg;
+	u32                   kind; // EntityKind
+	u32                   flags;
+	OdinSymbolIndexPos    pos;
+	u32                   first_use;
+	u32                   use_count;
+};
+
+struct OdinSymbolIndexUse {
+	u32                symbol;
+	u32                length; // in bytes
+	OdinSymbolIndexPos pos;
+};
+
+struct OdinSymbolIndexHeader {
+	u8  magic[8];
+	u32 version;
+	u32 total_size;
+
+	OdinSymbolIndexArray files;       // OdinSymbolIndexString, indexed by file id
+	OdinSymbolIndexArray symbols;     // OdinSymbolIndexSymbol
+	OdinSymbolIndexArray uses;        // OdinSymbolIndexUse, grouped by symbol and sorted by position
+	OdinSymbolIndexArray uses_by_pos; // u32 index into `uses`, sorted by (file, offset)
+	OdinSymbolIndexArray strings;     // blob which every OdinSymbolIndexString points into
+};
+
+
+gb_internal OdinSymbolIndexPos symbol_index_pos(TokenPos const &pos) {
+	OdinSymbolIndexPos p = {};
+	if (pos.file_id > 0 && pos.line > 0) {
+		p.file   = cast(u32)pos.file_id;
+		p.line   = cast(u32)pos.line;
+		p.column = cast(u32)pos.column;
+		p.offset = cast(u32)pos.offset;
+	}
+	return p;
+}
+
+gb_internal int symbol_index_pos_cmp(OdinSymbolIndexPos const &x, OdinSymbolIndexPos const &y) {
+	if (x.file != y.file) {
+		return x.file < y.file ? -1 : +1;
+	}
+	if (x.offset != y.offset) {
+		return x.offset < y.offset ? -1 : +1;
+	}
+	return 0;
+}
+
+gb_internal GB_COMPARE_PROC(symbol_index_use_cmp) {
+	OdinSymbolIndexUse const *x = cast(OdinSymbolIndexUse const *)a;
+	OdinSymbolIndexUse const *y = cast(OdinSymbolIndexUse const *)b;
+	if (x->symbol != y->symbol) {
+		return x->symbol < y->symbol ? -1 : +1;
+	}
+	return symbol_index_pos_cmp(x->pos, y->pos);
+}
+
+struct SymbolIndexPosKey {
+	OdinSymbolIndexPos pos;
+	u32                use;
+};
+
+gb_internal GB_COMPARE_PROC(symbol_index_pos_key_cmp) {
+	SymbolIndexPosKey const *x = cast(SymbolIndexPosKey const *)a;
+	SymbolIndexPosKey const *y = cast(SymbolIndexPosKey const *)b;
+	int cmp = symbol_index_pos_cmp(x->pos, y->pos);
+	if (cmp != 0) {
+		return cmp;
+	}
+	return x->use < y->use ? -1 : x->use > y->use ? +1 : 0;
+}
+
+struct SymbolIndexWriter {
+	Array<u8>      strings;
+	StringMap<u32> string_offsets;
+
+	Array<Entity *>       entities;
+	PtrMap<Entity *, u32> symbol_map;
+};
+
+gb_internal OdinSymbolIndexString symbol_index_write_string(SymbolIndexWriter *w, String const &str) {
+	OdinSymbolIndexString s = {};
+	if (str.len == 0) {
+		return s;
+	}
+	s.length = cast(u32)str.len;
+
+	u32 *found = string_map_get(&w->string_offsets, str);
+	if (found) {
+		s.offset = *found;
+		return s;
+	}
+	s.offset = cast(u32)w->strings.count;
+	array_add_elems(&w->strings, str.text, str.len);
+	string_map_set(&w->string_offsets, str, s.offset);
+	return s;
+}
+
+gb_internal u32 symbol_index_add_entity(SymbolIndexWriter *w, Entity *e) {
+	u32 *found = map_get(&w->symbol_map, e);
+	if (found) {
+		return *found;
+	}
+	u32 index = cast(u32)w->entities.count;
+	array_add(&w->entities, e);
+	map_set(&w->symbol_map, e, index);
+	return index;
+}
+
+gb_internal void symbol_index_append(Array<u8> *buf, u32 *offset_, void const *data, isize size) {
+	*offset_ = cast(u32)buf->count;
+	array_add_elems(buf, cast(u8 const *)data, size);
+}
+
+gb_internal void export_symbol_index(Checker *c, String const &filename) {
+	CheckerInfo *info = &c->info;
+	gbAllocator a = heap_allocator();
+
+	SymbolIndexWriter w = {};
+	array_init(&w.strings, a, 0, 1<<16);
+	string_map_init(&w.string_offsets, 1<<12);
+	array_init(&w.entities, a, 0, info->entities.count);
+	map_init(&w.symbol_map, info->entities.count);
+	defer ({
+		array_free(&w.strings);
+		string_map_destroy(&w.string_offsets);
+		array_free(&w.entities);
+		map_destroy(&w.symbol_map);
+	});
+
+	for (Entity *e : info->entities) {
+		symbol_index_add_entity(&w, e);
+	}
+
+	// NOTE: The uses also add the entities which are not in `info->entities`, e.g. local variables
+	auto uses = array_make<OdinSymbolIndexUse>(a, 0, info->entity_uses_queue.count.load());
+	defer (array_free(&uses));
+	for (EntityUse u = {}; mpsc_dequeue(&info->entity_uses_queue, &u); /**/) {
+		GB_ASSERT(u.identifier->kind == Ast_Ident);
+		Token const &token = u.identifier->Ident.token;
+
+		OdinSymbolIndexUse use = {};
+		use.symbol = symbol_index_add_entity(&w, u.entity);
+		use.length = cast(u32)token.string.len;
+		use.pos    = symbol_index_pos(token.pos);
+		if (use.pos.file != 0) {
+			array_add(&uses, use);
+		}
+	}
+
+	array_sort(uses, symbol_index_use_cmp);
+	{ // NOTE: The same identifier can be seen more than once, e.g. through `when` or polymorphic procedures
+		isize count = 0;
+		for (isize i = 0; i < uses.count; i++) {
+			if (count > 0 &&
+			    uses[count-1].symbol == uses[i].symbol &&
+			    symbol_index_pos_cmp(uses[count-1].pos, uses[i].pos) == 0) {
+				continue;
+			}
+			uses[count++] = uses[i];
+		}
+		uses.count = count;
+	}
+
+	auto symbols = array_make<OdinSymbolIndexSymbol>(a, w.entities.count);
+	defer (array_free(&symbols));
+	for_array(i, w.entities) {
+		Entity *e = w.entities[i];
+		OdinSymbolIndexSymbol *s = &symbols[i];
+		s->name = symbol_index_write_string(&w, e->token.string);
+		if (e->pkg != nullptr) {
+			s->pkg = symbol_index_write_string(&w, e->pkg->name);
+		}
+		s->kind = cast(u32)e->kind;
+		if (e->scope != nullptr && (e->scope->flags & (ScopeFlag_Pkg|ScopeFlag_File)) != 0) {
+			s->flags |= OdinSymbolIndexSymbolFlag_Global;
+		}
+		s->pos = symbol_index_pos(e->token.pos);
+	}
+	for_array(i, uses) {
+		OdinSymbolIndexSymbol *s = &symbols[uses[i].symbol];
+		if (s->use_count == 0) {
+			s->first_use = cast(u32)i;
+		}
+		s->use_count += 1;
+	}
+
+	auto pos_keys = array_make<SymbolIndexPosKey>(a, uses.count);
+	defer (array_free(&pos_keys));
+	for_array(i, uses) {
+		pos_keys[i] = {uses[i].pos, cast(u32)i};
+	}
+	array_sort(pos_keys, symbol_index_pos_key_cmp);
+	auto uses_by_pos = array_make<u32>(a, uses.count);
+	defer (array_free(&uses_by_pos));
+	for_array(i, pos_keys) {
+		uses_by_pos[i] = pos_keys[i].use;
+	}
+
+	auto files = array_make<OdinSymbolIndexString>(a, global_file_path_strings.count);
+	defer (array_free(&files));
+	for_array(i, files) {
+		files[i] = symbol_index_write_string(&w, get_file_path_string(cast(i32)i));
+	}
+
+
+	OdinSymbolIndexHeader header = {};
+	gb_memmove(header.magic, OdinSymbolIndexMagic, gb_size_of(header.magic));
+	header.version = OdinSymbolIndexVersion;
+
+	isize total_size = gb_size_of(header) +
+	                   files.count*gb_size_of(OdinSymbolIndexString) +
+	                   symbols.count*gb_size_of(OdinSymbolIndexSymbol) +
+	                   uses.count*gb_size_of(OdinSymbolIndexUse) +
+	                   uses_by_pos.count*gb_size_of(u32) +
+	                   w.strings.count;
+	if (total_size > cast(isize)U32_MAX) {
+		gb_printf_err("Failed to write the symbol index, it exceeds the maximum size of 4 GiB\n");
+		return;
+	}
+
+	Array<u8> buf = {};
+	array_init(&buf, a, 0, total_size);
+	defer (array_free(&buf));
+
+	u32 header_offset = 0;
+	symbol_index_append(&buf, &header_offset, &header, gb_size_of(header));
+
+	// NOTE: All of the strings are placed last, so their final offsets are known up front
+	u32 strings_base = cast(u32)(total_size - w.strings.count);
+	auto const rebase = [strings_base](OdinSymbolIndexString *s) {
+		if (s->length != 0) {
+			s->offset += strings_base;
+		}
+	};
+	for (OdinSymbolIndexString &s : files) {
+		rebase(&s);
+	}
+	for (OdinSymbolIndexSymbol &s : symbols) {
+		rebase(&s.name);
+		rebase(&s.pkg);
+	}
+
+	symbol_index_append(&buf, &header.files.offset,       files.data,       files.count*gb_size_of(OdinSymbolIndexString));
+	symbol_index_append(&buf, &header.symbols.offset,     symbols.data,     symbols.count*gb_size_of(OdinSymbolIndexSymbol));
+	symbol_index_append(&buf, &header.uses.offset,        uses.data,        uses.count*gb_size_of(OdinSymbolIndexUse));
+	symbol_index_append(&buf, &header.uses_by_pos.offset, uses_by_pos.data, uses_by_pos.count*gb_size_of(u32));
+	symbol_index_append(&buf, &header.strings.offset,     w.strings.data,   w.strings.count);
+	GB_ASSERT(header.strings.offset == strings_base);
+	GB_ASSERT(buf.count == total_size);
+
+	header.total_size         = cast(u32)total_size;
+	header.files.length       = cast(u32)files.count;
+	header.symbols.length     = cast(u32)symbols.count;
+	header.uses.length        = cast(u32)uses.count;
+	header.uses_by_pos.length = cast(u32)uses_by_pos.count;
+	header.strings.length     = cast(u32)w.strings.count;
+	gb_memmove(buf.data, &header, gb_size_of(header));
+
+	char const *filename_c = alloc_cstring(a, filename);
+	defer (gb_free(a, cast(void *)filename_c));
+
+	gbFile f = {};
+	gbFileError err = gb_file_open_mode(&f, gbFileMode_Write, filename_c);
+	if (err != gbFileError_None) {
+		gb_printf_err("Failed to write the symbol index to: %s\n", filename_c);
+		return;
+	}
+	defer (gb_file_close(&f));
+	if (gb_file_write(&f, buf.data, buf.count)) {
+		gb_file_truncate(&f, buf.count);
+	}
+}
@@ -12,16 +12,22 @@
 
 struct WorkerTask;
 struct ThreadPool;
+struct ThreadPoolTaskGroup;
 
 gb_global gb_thread_local Thread *current_thread;
 gb_internal Thread *get_current_thread(void) {
 	return current_thread;
 }
 
-gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char const *worker_name);
+struct CpuTopology;
+
+gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char const *worker_name, CpuTopology const *topology=nullptr);
 gb_internal void thread_pool_destroy(ThreadPool *pool);
 gb_internal bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data);
 gb_internal void thread_pool_wait(ThreadPool *pool);
+gb_internal bool thread_pool_add_task_to_group(ThreadPool *pool, ThreadPoolTaskGroup *group, WorkerTaskProc *proc, void *data);
+gb_internal void thread_pool_add_tasks(ThreadPool *pool, ThreadPoolTaskGroup *group, WorkerTask const *tasks, isize count);
+gb_internal void thread_pool_wait_group(ThreadPool *pool, ThreadPoolTaskGroup *group);
 
 enum GrabState {
 	Grab_Success = 0,
@@ -43,11 +49,276 @@ struct ThreadPool {
 	Futex tasks_left;
 };
 
+// NOTE: A group allows a phase to wait on only its own tasks, rather than every task in the pool,
+// so that independent phases can overlap. Groups may be nested: a task of a child group is also counted
+// by every ancestor, so waiting on a group also waits on the tasks of the groups made within it.
+struct ThreadPoolTaskGroup {
+	std::atomic<isize>   tasks_left;
+	ThreadPoolTaskGroup *parent;
+};
+
+gb_internal void thread_pool_group_add(ThreadPoolTaskGroup *group, isize count) {
+	for (; group != nullptr; group = group->parent) {
+		group->tasks_left.fetch_add(count, std::memory_order_release);
+	}
+}
+
+gb_internal void thread_pool_group_done(ThreadPoolTaskGroup *group) {
+	for (; group != nullptr; group = group->parent) {
+		group->tasks_left.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+// NOTE: The size hint is an estimate of the cost of the task, see 'thread_pool_add_tasks_largest_first'
+struct WorkerTaskWithSize {
+	WorkerTaskProc *proc;
+	void           *data;
+	u64             size_hint;
+	i64             memory_estimate; // in bytes, see 'thread_pool_add_tasks_within_memory_budget'
+};
+
 gb_internal isize current_thread_index(void) {
 	return current_thread ? current_thread->idx : 0;
 }
 
-gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char const *worker_name) {
+// NOTE: -pin-threads, one of the logical CPUs this process may run on
+struct CpuPlacement {
+	i32 cpu;  // the index of the logical CPU
+	i32 core; // the physical core, unique across packages
+	i32 node; // the NUMA node
+};
+
+// NOTE: The workers of the global pool are pinned to `cpus` in order. The first `core_count` entries are
+// on distinct physical cores and alternate between the NUMA nodes, and the SMT siblings follow in the same
+// order, so a pool smaller than the machine is spread over every core and node before doubling up.
+// A pinned worker also keeps its arenas on its own node, as their blocks are first touched by it.
+struct CpuTopology {
+	Slice<CpuPlacement> cpus;
+	isize               core_count;
+	isize               node_count;
+};
+
+gb_global CpuTopology global_cpu_topology;
+
+gb_internal int cpu_placement_cmp(void const *a, void const *b) {
+	auto x = cast(CpuPlacement const *)a;
+	auto y = cast(CpuPlacement const *)b;
+	return i32_cmp(x->cpu, y->cpu);
+}
+
+// NOTE: `cpus` is in the order of the logical CPUs, and is reordered as described on `CpuTopology`
+gb_internal void cpu_topology_order(CpuTopology *topo) {
+	Slice<CpuPlacement> cpus = topo->cpus;
+	gb_sort_array(cpus.data, cpus.count, cpu_placement_cmp);
+
+	// NOTE: the sort key is (SMT sibling rank, rank of the core within its node, node)
+	auto keys = slice_make<u64>(heap_allocator(), cpus.count);
+	auto smt_ranks = slice_make<u64>(heap_allocator(), cpus.count);
+	defer (gb_free(heap_allocator(), keys.data));
+	defer (gb_free(heap_allocator(), smt_ranks.data));
+
+	topo->core_count = 0;
+	topo->node_count = 0;
+	for_array(i, cpus) {
+		smt_ranks[i] = 0;
+		bool new_node = true;
+		for (isize j = 0; j < i; j++) {
+			smt_ranks[i] += cpus[j].core == cpus[i].core;
+			new_node = new_node && cpus[j].node != cpus[i].node;
+		}
+		topo->core_count += smt_ranks[i] == 0;
+		topo->node_count += new_node;
+	}
+	for_array(i, cpus) {
+		// NOTE: an SMT sibling shares the rank of its core, which is the rank of the first CPU of the core
+		u64 core_rank = 0;
+		for (isize j = 0; j < i; j++) {
+			if (smt_ranks[i] != 0 && cpus[j].core == cpus[i].core) {
+				core_rank = (keys[j] >> 24) & 0xffffff;
+				break;
+			}
+			core_rank += smt_ranks[j] == 0 && cpus[j].node == cpus[i].node;
+		}
+		keys[i] = (smt_ranks[i] << 48) | (core_rank << 24) | cast(u64)(cpus[i].node & 0xffffff);
+	}
+
+	// NOTE: an insertion sort keeps the logical order between equal keys
+	for (isize i = 1; i < cpus.count; i++) {
+		for (isize j = i; j > 0 && keys[j-1] > keys[j]; j--) {
+			gb_swap(u64, keys[j-1], keys[j]);
+			gb_swap(CpuPlacement, cpus[j-1], cpus[j]);
+		}
+	}
+}
+
+#if defined(GB_SYSTEM_LINUX)
+gb_internal i32 cpu_topology_read_i32(char const *path) {
+	FILE *f = fopen(path, "r");
+	if (f == nullptr) {
+		return -1;
+	}
+	int value = -1;
+	if (fscanf(f, "%d", &value) != 1) {
+		value = -1;
+	}
+	fclose(f);
+	return cast(i32)value;
+}
+
+// NOTE: Sets the node of every CPU in a list such as "0-15,32-47"
+gb_internal void cpu_topology_read_node_cpulist(CpuTopology *topo, char const *path, i32 node) {
+	FILE *f = fopen(path, "r");
+	if (f == nullptr) {
+		return;
+	}
+	int lo = 0, hi = 0;
+	for (;;) {
+		int n = fscanf(f, "%d", &lo);
+		if (n != 1) {
+			break;
+		}
+		hi = lo;
+		int c = fgetc(f);
+		if (c == '-') {
+			if (fscanf(f, "%d", &hi) != 1) {
+				break;
+			}
+			c = fgetc(f);
+		}
+		for (CpuPlacement &p : topo->cpus) {
+			if (lo <= p.cpu && p.cpu <= hi) {
+				p.node = node;
+			}
+		}
+		if (c != ',') {
+			break;
+		}
+	}
+	fclose(f);
+}
+#endif
+
+// NOTE: Returns false when the topology is not known on this platform
+gb_internal bool cpu_topology_init(CpuTopology *topo) {
+	gb_zero_item(topo);
+#if defined(GB_SYSTEM_LINUX)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, gb_size_of(set), &set) != 0) {
+		return false;
+	}
+	slice_init(&topo->cpus, heap_allocator(), CPU_COUNT(&set));
+	isize count = 0;
+	for (i32 cpu = 0; cpu < CPU_SETSIZE && count < topo->cpus.count; cpu++) {
+		if (!CPU_ISSET(cpu, &set)) {
+			continue;
+		}
+		char path[128] = {};
+		gb_snprintf(path, gb_size_of(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+		i32 package = gb_max(cpu_topology_read_i32(path), 0);
+		gb_snprintf(path, gb_size_of(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+		i32 core_id = cpu_topology_read_i32(path);
+
+		CpuPlacement p = {};
+		p.cpu  = cpu;
+		p.core = core_id < 0 ? -1-cpu : (package << 16) | core_id; // no SMT information, so a core of its own
+		p.node = 0;
+		topo->cpus[count++] = p;
+	}
+	topo->cpus.count = count;
+
+	for (i32 node = 0, missing = 0; missing < 8; node++) {
+		char path[128] = {};
+		gb_snprintf(path, gb_size_of(path), "/sys/devices/system/node/node%d/cpulist", node);
+		if (!gb_file_exists(path)) {
+			missing += 1;
+			continue;
+		}
+		cpu_topology_read_node_cpulist(topo, path, node);
+	}
+#elif defined(GB_SYSTEM_WINDOWS)
+	// NOTE: only the first processor group (at most 64 logical CPUs) is supported
+	DWORD_PTR process_mask = 0;
+	DWORD_PTR system_mask = 0;
+	if (!GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask)) {
+		return false;
+	}
+	DWORD length = 0;
+	GetLogicalProcessorInformation(nullptr, &length);
+	if (length == 0) {
+		return false;
+	}
+	auto infos = cast(SYSTEM_LOGICAL_PROCESSOR_INFORMATION *)gb_alloc(heap_allocator(), length);
+	defer (gb_free(heap_allocator(), infos));
+	if (!GetLogicalProcessorInformation(infos, &length)) {
+		return false;
+	}
+	isize info_count = length / gb_size_of(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+
+	slice_init(&topo->cpus, heap_allocator(), gb_count_set_bits(process_mask));
+	isize count = 0;
+	for (i32 cpu = 0; cpu < 8*gb_size_of(DWORD_PTR) && count < topo->cpus.count; cpu++) {
+		DWORD_PTR bit = cast(DWORD_PTR)1 << cpu;
+		if ((process_mask & bit) == 0) {
+			continue;
+		}
+		CpuPlacement p = {};
+		p.cpu  = cpu;
+		p.core = -1-cpu;
+		for (isize i = 0; i < info_count; i++) {
+			if ((infos[i].ProcessorMask & bit) == 0) {
+				continue;
+			}
+			if (infos[i].Relationship == RelationProcessorCore) {
+				p.core = cast(i32)i;
+			} else if (infos[i].Relationship == RelationNumaNode) {
+				p.node = cast(i32)infos[i].NumaNode.NodeNumber;
+			}
+		}
+		topo->cpus[count++] = p;
+	}
+	topo->cpus.count = count;
+#else
+	return false;
+#endif
+	if (topo->cpus.count == 0) {
+		return false;
+	}
+	cpu_topology_order(topo);
+	return true;
+}
+
+// NOTE: Pins the current thread to `cpu`, or lets it run on any CPU of the topology again when `cpu` is -1
+gb_internal bool thread_set_cpu_affinity(CpuTopology const *topo, i32 cpu) {
+#if defined(GB_SYSTEM_LINUX)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (cpu >= 0) {
+		CPU_SET(cpu, &set);
+	} else {
+		for (CpuPlacement const &p : topo->cpus) {
+			CPU_SET(p.cpu, &set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), gb_size_of(set), &set) == 0;
+#elif defined(GB_SYSTEM_WINDOWS)
+	DWORD_PTR mask = 0;
+	if (cpu >= 0) {
+		mask = cast(DWORD_PTR)1 << cpu;
+	} else {
+		for (CpuPlacement const &p : topo->cpus) {
+			mask |= cast(DWORD_PTR)1 << p.cpu;
+		}
+	}
+	return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+	gb_unused(topo);
+	gb_unused(cpu);
+	return false;
+#endif
+}
+
+gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char const *worker_name, CpuTopology const *topology) {
 	pool->threads_allocator = permanent_allocator();
 	slice_init(&pool->threads, pool->threads_allocator, worker_count + 1);
 
@@ -58,9 +329,14 @@ gb_internal void thread_pool_init(ThreadPool *pool, isize worker_count, char con
 	thread_init(pool, &pool->threads[0], 0);
 	current_thread = &pool->threads[0];
 
+	// NOTE: the main thread is left unpinned, as the processes it starts (e.g. the linker) inherit its affinity
 	for_array_off(i, 1, pool->threads) {
 		Thread *t = &pool->threads[i];
-		thread_init_and_start(pool, t, i);
+		i32 cpu = -1;
+		if (topology != nullptr) {
+			cpu = topology->cpus[(i-1) % topology->cpus.count].cpu;
+		}
+		thread_init_and_start(pool, t, i, cpu);
 	}
 }
 
@@ -85,30 +361,45 @@ TaskRingBuffer *task_ring_grow(TaskRingBuffer *ring, isize bottom, isize top) {
 	return new_ring;
 }
 
-void thread_pool_queue_push(Thread *thread, WorkerTask task) {
+// NOTE: Only the owner of the queue may write to it; the tasks are not counted in `tasks_left`
+void thread_pool_queue_write(Thread *thread, WorkerTask const *tasks, isize count) {
 	isize bot                = thread->queue.bottom.load(std::memory_order_relaxed);
 	isize top                = thread->queue.top.load(std::memory_order_acquire);
 	TaskRingBuffer *cur_ring   = thread->queue.ring.load(std::memory_order_relaxed);
 
-	isize size = bot - top;
-	if (size > (cur_ring->size - 1)) {
+	while (bot - top + count > cur_ring->size) {
 		// Queue is full
 		thread->queue.ring = task_ring_grow(thread->queue.ring, bot, top);
 		cur_ring = thread->queue.ring.load(std::memory_order_relaxed);
 	}
 
-	cur_ring->buffer[bot % cur_ring->size] = task;
-	TSAN_RELEASE(cur_ring->buffer[bot % cur_ring->size]);
+	for (isize i = 0; i < count; i++) {
+		cur_ring->buffer[(bot+i) % cur_ring->size] = tasks[i];
+		TSAN_RELEASE(cur_ring->buffer[(bot+i) % cur_ring->size]);
+	}
 	std::atomic_thread_fence(std::memory_order_release);
-	thread->queue.bottom.store(bot + 1, std::memory_order_relaxed);
+	thread->queue.bottom.store(bot + count, std::memory_order_relaxed);
+}
 
-	thread->pool->tasks_left.fetch_add(1, std::memory_order_release);
+gb_internal void thread_pool_wake_sleepers(ThreadPool *pool) {
 	i32 state = Someone_Waiting;
-	if (thread->pool->tasks_available.compare_exchange_strong(state, Nobody_Waiting)) {
-		futex_broadcast(&thread->pool->tasks_available);
+	if (pool->tasks_available.compare_exchange_strong(state, Nobody_Waiting)) {
+		futex_broadcast(&pool->tasks_available);
 	}
 }
 
+// NOTE: Pushes all of the tasks with one store of `bottom`, and only then counts them and wakes any
+// sleeping thread, so a burst of tasks touches the shared `tasks_left` and `tasks_available` once
+void thread_pool_queue_push_many(Thread *thread, WorkerTask const *tasks, isize count) {
+	thread_pool_queue_write(thread, tasks, count);
+	thread->pool->tasks_left.fetch_add(cast(i32)count, std::memory_order_release);
+	thread_pool_wake_sleepers(thread->pool);
+}
+
+void thread_pool_queue_push(Thread *thread, WorkerTask task) {
+	thread_pool_queue_push_many(thread, &task, 1);
+}
+
 GrabState thread_pool_queue_take(Thread *thread, WorkerTask *task) {
 	isize bot = thread->queue.bottom.load(std::memory_order_relaxed) - 1;
 	TaskRingBuffer *cur_ring = thread->queue.ring.load(std::memory_order_relaxed);
@@ -165,6 +456,30 @@ GrabState thread_pool_queue_steal(Thread *thread, WorkerTask *task) {
 	return ret;
 }
 
+// NOTE: Runs the task without counting it off `pool->tasks_left`; the caller publishes the completions of
+// a whole run of tasks with one `thread_pool_tasks_done` rather than every worker hitting the shared
+// counter once per task. The groups are still counted off straight away, as a waiter on a group may be
+// waiting on this very thread.
+gb_internal void thread_pool_do_task_deferred(ThreadPool *pool, WorkerTask const &task) {
+	task.do_work(task.data);
+	thread_pool_group_done(task.group);
+}
+
+gb_internal void thread_pool_tasks_done(ThreadPool *pool, isize count) {
+	if (count == 0) {
+		return;
+	}
+	i32 n = cast(i32)count;
+	if (pool->tasks_left.fetch_sub(n, std::memory_order_acq_rel) == n) {
+		futex_signal(&pool->tasks_left);
+	}
+}
+
+gb_internal void thread_pool_do_task(ThreadPool *pool, WorkerTask const &task) {
+	thread_pool_do_task_deferred(pool, task);
+	thread_pool_tasks_done(pool, 1);
+}
+
 gb_internal bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data) {
 	WorkerTask task = {};
 	task.do_work = proc;
@@ -174,15 +489,181 @@ gb_internal bool thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, vo
 	return true;
 }	
 
+gb_internal bool thread_pool_add_task_to_group(ThreadPool *pool, ThreadPoolTaskGroup *group, WorkerTaskProc *proc, void *data) {
+	GB_ASSERT(group != nullptr);
+	WorkerTask task = {};
+	task.do_work = proc;
+	task.data = data;
+	task.group = group;
+
+	thread_pool_group_add(group, 1);
+	thread_pool_queue_push(current_thread, task);
+	return true;
+}
+
+// NOTE: For producers which fan out many small tasks at once; `group` may be null
+gb_internal void thread_pool_add_tasks(ThreadPool *pool, ThreadPoolTaskGroup *group, WorkerTask const *tasks, isize count) {
+	if (count <= 0) {
+		return;
+	}
+	if (group != nullptr) {
+		for (isize i = 0; i < count; i++) {
+			GB_ASSERT(tasks[i].group == group);
+		}
+		thread_pool_group_add(group, count);
+	}
+	thread_pool_queue_push_many(current_thread, tasks, count);
+}
+
+gb_internal int worker_task_with_size_cmp(void const *a, void const *b) {
+	u64 x = (cast(WorkerTaskWithSize const *)a)->size_hint;
+	u64 y = (cast(WorkerTaskWithSize const *)b)->size_hint;
+	return x < y ? +1 : x > y ? -1 : 0;
+}
+
+// NOTE: Other threads steal from the top of the queue, i.e. in the order the tasks were pushed,
+// so pushing the largest tasks first means they are started first (longest-processing-time first).
+// This stops a single large task from being started last and ending up as the straggler.
+gb_internal void thread_pool_add_tasks_largest_first(ThreadPool *pool, ThreadPoolTaskGroup *group, Slice<WorkerTaskWithSize> tasks) {
+	gb_sort_array(tasks.data, tasks.count, worker_task_with_size_cmp);
+
+	TEMPORARY_ALLOCATOR_GUARD();
+	WorkerTask *worker_tasks = gb_alloc_array(temporary_allocator(), WorkerTask, tasks.count);
+	for_array(i, tasks) {
+		worker_tasks[i] = {tasks[i].proc, tasks[i].data, group};
+	}
+	thread_pool_add_tasks(pool, group, worker_tasks, tasks.count);
+}
+
+// NOTE: Bounds the total estimated memory of the tasks running at once. A task waits in
+// 'memory_budget_acquire' until its estimate fits in what is left of the limit. A task estimated
+// above the whole limit waits until nothing else is running, and then runs on its own.
+struct MemoryBudget {
+	BlockingMutex mutex;
+	Condition     cond;
+	i64           limit;
+	i64           in_use;
+};
+
+struct MemoryBudgetTask {
+	MemoryBudget   *budget;
+	WorkerTaskProc *proc;
+	void           *data;
+	i64             cost;
+};
+
+gb_internal void memory_budget_acquire(MemoryBudget *budget, i64 cost) {
+	mutex_lock(&budget->mutex);
+	while (budget->in_use + cost > budget->limit) {
+		condition_wait(&budget->cond, &budget->mutex);
+	}
+	budget->in_use += cost;
+	mutex_unlock(&budget->mutex);
+}
+
+gb_internal void memory_budget_release(MemoryBudget *budget, i64 cost) {
+	mutex_lock(&budget->mutex);
+	budget->in_use -= cost;
+	condition_broadcast(&budget->cond);
+	mutex_unlock(&budget->mutex);
+}
+
+gb_internal WORKER_TASK_PROC(memory_budget_task_proc) {
+	MemoryBudgetTask *t = cast(MemoryBudgetTask *)data;
+	memory_budget_acquire(t->budget, t->cost);
+	isize result = t->proc(t->data);
+	memory_budget_release(t->budget, t->cost);
+	return result;
+}
+
+// NOTE: Like 'thread_pool_add_tasks_largest_first', but a task only starts once its 'memory_estimate'
+// fits in the budget. The tasks must not add and wait on tasks of their own, as the thread waiting on
+// them could pick up another budgeted task and block whilst holding its own share of the budget.
+gb_internal void thread_pool_add_tasks_within_memory_budget(ThreadPool *pool, ThreadPoolTaskGroup *group, MemoryBudget *budget, Slice<WorkerTaskWithSize> tasks) {
+	GB_ASSERT(budget->limit > 0);
+	gb_sort_array(tasks.data, tasks.count, worker_task_with_size_cmp);
+
+	TEMPORARY_ALLOCATOR_GUARD();
+	MemoryBudgetTask *budget_tasks = gb_alloc_array(permanent_allocator(), MemoryBudgetTask, tasks.count);
+	WorkerTask *worker_tasks = gb_alloc_array(temporary_allocator(), WorkerTask, tasks.count);
+	for_array(i, tasks) {
+		WorkerTaskWithSize const &t = tasks[i];
+		budget_tasks[i] = {budget, t.proc, t.data, gb_clamp(t.memory_estimate, 0, budget->limit)};
+		worker_tasks[i] = {memory_budget_task_proc, &budget_tasks[i], group};
+	}
+	thread_pool_add_tasks(pool, group, worker_tasks, tasks.count);
+}
+
+// NOTE: -pin-threads, the LLVM phases are bound by memory rather than by the cores, and two of their tasks
+// on the SMT siblings of a core would mostly contend for its caches. Each task takes a whole physical core
+// and moves its thread onto it for as long as it runs, and waits whilst every core is taken.
+struct CoreSlots {
+	BlockingMutex mutex;
+	Condition     cond;
+	i32 *         free_cpus; // the first CPU of each free core
+	isize         free_count;
+};
+
+struct CoreSlotTask {
+	CoreSlots      *slots;
+	WorkerTaskProc *proc;
+	void           *data;
+};
+
+gb_global CoreSlots global_core_slots;
+
+gb_internal void core_slots_init(CoreSlots *slots, CpuTopology const *topo) {
+	slots->free_cpus  = gb_alloc_array(heap_allocator(), i32, topo->core_count);
+	slots->free_count = topo->core_count;
+	for (isize i = 0; i < topo->core_count; i++) {
+		// NOTE: reversed, so the cores are taken in the order of the topology
+		slots->free_cpus[topo->core_count-1-i] = topo->cpus[i].cpu;
+	}
+}
+
+gb_internal WORKER_TASK_PROC(core_slot_task_proc) {
+	CoreSlotTask *t = cast(CoreSlotTask *)data;
+	CoreSlots *slots = t->slots;
+
+	mutex_lock(&slots->mutex);
+	while (slots->free_count == 0) {
+		condition_wait(&slots->cond, &slots->mutex);
+	}
+	i32 cpu = slots->free_cpus[--slots->free_count];
+	mutex_unlock(&slots->mutex);
+
+	thread_set_cpu_affinity(&global_cpu_topology, cpu);
+	isize result = t->proc(t->data);
+	thread_set_cpu_affinity(&global_cpu_topology, current_thread->cpu);
+
+	mutex_lock(&slots->mutex);
+	slots->free_cpus[slots->free_count++] = cpu;
+	condition_signal(&slots->cond);
+	mutex_unlock(&slots->mutex);
+	return result;
+}
+
+// NOTE: The same restriction as 'thread_pool_add_tasks_within_memory_budget' applies to the tasks
+gb_internal void core_slots_wrap_tasks(CoreSlots *slots, Slice<WorkerTaskWithSize> tasks) {
+	CoreSlotTask *slot_tasks = gb_alloc_array(permanent_allocator(), CoreSlotTask, tasks.count);
+	for_array(i, tasks) {
+		slot_tasks[i] = {slots, tasks[i].proc, tasks[i].data};
+		tasks[i].proc = core_slot_task_proc;
+		tasks[i].data = &slot_tasks[i];
+	}
+}
+
 gb_internal void thread_pool_wait(ThreadPool *pool) {
 	WorkerTask task;
 
 	while (pool->tasks_left.load(std::memory_order_acquire)) {
 		// if we've got tasks on our queue, run them
+		isize finished_tasks = 0;
 		while (!thread_pool_queue_take(current_thread, &task)) {
-			task.do_work(task.data);
-			pool->tasks_left.fetch_sub(1, std::memory_order_release);
+			thread_pool_do_task_deferred(pool, task);
+			finished_tasks += 1;
 		}
+		thread_pool_tasks_done(pool, finished_tasks);
 
 		// is this mem-barriered enough?
 		// This *must* be executed in this order, so the futex wakes immediately
@@ -197,58 +678,236 @@ gb_internal void thread_pool_wait(ThreadPool *pool) {
 	}
 }
 
+// NOTE: Unlike 'thread_pool_wait', this only waits for the tasks of the group. Whilst waiting, it
+// helps with any task in the pool, including tasks which do not belong to the group.
+gb_internal void thread_pool_wait_group(ThreadPool *pool, ThreadPoolTaskGroup *group) {
+	WorkerTask task;
+
+	while (group->tasks_left.load(std::memory_order_acquire)) {
+		if (!thread_pool_queue_take(current_thread, &task)) {
+			thread_pool_do_task(pool, task);
+			continue;
+		}
+
+		bool did_work = false;
+		usize idx = cast(usize)current_thread->idx;
+		for_array(i, pool->threads) {
+			idx = (idx + 1) % cast(usize)pool->threads.count;
+			Thread *thread = &pool->threads.data[idx];
+			if (thread == current_thread) {
+				continue;
+			}
+			if (thread_pool_queue_steal(thread, &task) == Grab_Success) {
+				thread_pool_do_task(pool, task);
+				did_work = true;
+				break;
+			}
+		}
+
+		if (!did_work) {
+			yield_thread();
+		}
+	}
+}
+
+// NOTE: A parallel merge sort for the large arrays which need a deterministic order, e.g. the type info
+// table or the defineables. The chunks are sorted with `gb_sort` in parallel, then merged pairwise, with
+// every merge of a level running in parallel. The comparison must be a total order (as it must already be
+// for the result of `gb_sort` to be deterministic), and it must be safe to call from any thread.
+enum : isize {
+	PARALLEL_SORT_MIN_COUNT = 1<<14, // below this, `gb_sort` on a single thread is faster
+	PARALLEL_SORT_MIN_CHUNK = 1<<12,
+};
+
+struct ParallelSortTask {
+	u8 *           src;
+	u8 *           dst;
+	isize          lo, mid, hi; // in elements
+	isize          size;
+	gbCompareProc *compare_proc;
+};
+
+gb_internal WORKER_TASK_PROC(parallel_sort_chunk_proc) {
+	ParallelSortTask *t = cast(ParallelSortTask *)data;
+	gb_sort(t->src + t->lo*t->size, t->hi-t->lo, t->size, t->compare_proc);
+	return 0;
+}
+
+gb_internal WORKER_TASK_PROC(parallel_sort_merge_proc) {
+	ParallelSortTask *t = cast(ParallelSortTask *)data;
+	isize const size = t->size;
+	u8 const *a = t->src + t->lo*size;
+	u8 const *a_end = t->src + t->mid*size;
+	u8 const *b = a_end;
+	u8 const *b_end = t->src + t->hi*size;
+	u8 *out = t->dst + t->lo*size;
+	while (a < a_end && b < b_end) {
+		// NOTE: ties take from the left run
+		if (t->compare_proc(b, a) < 0) {
+			gb_memmove(out, b, size);
+			b += size;
+		} else {
+			gb_memmove(out, a, size);
+			a += size;
+		}
+		out += size;
+	}
+	gb_memmove(out, a, a_end-a);
+	out += a_end-a;
+	gb_memmove(out, b, b_end-b);
+	return 0;
+}
+
+gb_internal void sort_parallel(ThreadPool *pool, void *base, isize count, isize size, gbCompareProc compare_proc) {
+	isize thread_count = pool->threads.count;
+	if (count < PARALLEL_SORT_MIN_COUNT || thread_count <= 1) {
+		gb_sort(base, count, size, compare_proc);
+		return;
+	}
+
+	isize chunk_count = 1;
+	while (chunk_count < 2*thread_count && count/(chunk_count*2) >= PARALLEL_SORT_MIN_CHUNK) {
+		chunk_count *= 2;
+	}
+
+	u8 *temp = cast(u8 *)gb_alloc(heap_allocator(), count*size);
+	defer (gb_free(heap_allocator(), temp));
+	ParallelSortTask *tasks = gb_alloc_array(heap_allocator(), ParallelSortTask, chunk_count);
+	defer (gb_free(heap_allocator(), tasks));
+
+	u8 *src = cast(u8 *)base;
+	u8 *dst = temp;
+
+	ThreadPoolTaskGroup group = {};
+	for (isize i = 0; i < chunk_count; i++) {
+		ParallelSortTask *t = &tasks[i];
+		*t = {src, dst, count*i/chunk_count, 0, count*(i+1)/chunk_count, size, compare_proc};
+		thread_pool_add_task_to_group(pool, &group, parallel_sort_chunk_proc, t);
+	}
+	thread_pool_wait_group(pool, &group);
+
+	for (isize width = 1; width < chunk_count; width *= 2) {
+		isize merge_count = 0;
+		for (isize i = 0; i < chunk_count; i += 2*width) {
+			ParallelSortTask *t = &tasks[merge_count++];
+			*t = {src, dst, count*i/chunk_count, count*(i+width)/chunk_count, count*(i+2*width)/chunk_count, size, compare_proc};
+			thread_pool_add_task_to_group(pool, &group, parallel_sort_merge_proc, t);
+		}
+		thread_pool_wait_group(pool, &group);
+		gb_swap(u8 *, src, dst);
+	}
+
+	if (src != base) {
+		gb_memmove(base, src, count*size);
+	}
+}
+
+template <typename T>
+gb_internal void array_sort_parallel(ThreadPool *pool, Array<T> &array, gbCompareProc compare_proc) {
+	sort_parallel(pool, array.data, array.count, gb_size_of(T), compare_proc);
+}
+
+gb_internal void perf_counters_open_for_thread(void);
+
+// NOTE: An idle worker picks its first victim at random, so the thieves do not all start on the same
+// neighbour, and it takes up to half of the victim's queue at once (see `thread_pool_steal_half`). When
+// a full pass finds nothing to run, it backs off with an exponentially growing spin before trying
+// again, and goes to sleep after `THREAD_POOL_STEAL_BACKOFF_LIMIT` failed passes, rather than spinning
+// across every deque whilst a serial phase runs on the main thread.
+enum {
+	THREAD_POOL_STEAL_BATCH_MAX     = 32,
+	THREAD_POOL_STEAL_BACKOFF_LIMIT = 6, // at most 2^6 pauses between passes
+};
+
+gb_internal u32 thread_pool_random_next(u32 *state) {
+	// xorshift32
+	u32 x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+// NOTE: The tasks are only moved between queues, so they are not counted again
+gb_internal void thread_pool_steal_half(Thread *victim) {
+	isize top = victim->queue.top.load(std::memory_order_acquire);
+	isize bot = victim->queue.bottom.load(std::memory_order_acquire);
+	isize want = gb_min((bot - top)/2, cast(isize)THREAD_POOL_STEAL_BATCH_MAX);
+
+	WorkerTask batch[THREAD_POOL_STEAL_BATCH_MAX];
+	isize count = 0;
+	while (count < want && thread_pool_queue_steal(victim, &batch[count]) == Grab_Success) {
+		count += 1;
+	}
+	if (count > 0) {
+		thread_pool_queue_write(current_thread, batch, count);
+		thread_pool_wake_sleepers(current_thread->pool);
+	}
+}
+
 gb_internal THREAD_PROC(thread_pool_thread_proc) {
 	WorkerTask task;
 	current_thread = thread;
 	ThreadPool *pool = current_thread->pool;
+	if (current_thread->cpu >= 0) {
+		// NOTE: before anything is allocated, so the arenas of the thread end up on its NUMA node
+		thread_set_cpu_affinity(&global_cpu_topology, current_thread->cpu);
+	}
+	perf_counters_open_for_thread();
 	// debugf("worker id: %td\n", current_thread->idx);
 
+	u32 random_state = cast(u32)(current_thread->idx*0x9e3779b9u) | 1;
+	isize backoff = 0;
+
 	while (pool->running.load(std::memory_order_seq_cst)) {
 		// If we've got tasks to process, work through them
-		usize finished_tasks = 0;
-		i32 state;
+		isize finished_tasks = 0;
 
 		while (!thread_pool_queue_take(current_thread, &task)) {
-			task.do_work(task.data);
-			pool->tasks_left.fetch_sub(1, std::memory_order_release);
+			thread_pool_do_task_deferred(pool, task);
 
 			finished_tasks += 1;
 		}
-		if (finished_tasks > 0 && pool->tasks_left.load(std::memory_order_acquire) == 0) {
-			futex_signal(&pool->tasks_left);
+		thread_pool_tasks_done(pool, finished_tasks);
+		if (finished_tasks > 0) {
+			backoff = 0;
 		}
 
 		// If there's still work somewhere and we don't have it, steal it
 		if (pool->tasks_left.load(std::memory_order_acquire)) {
-			usize idx = cast(usize)current_thread->idx;
-			for_array(i, pool->threads) {
+			usize count = cast(usize)pool->threads.count;
+			usize idx = thread_pool_random_next(&random_state) % count;
+			for (usize i = 0; i < count; i++, idx = (idx + 1) % count) {
 				if (pool->tasks_left.load(std::memory_order_acquire) == 0) {
 					break;
 				}
 
-				idx = (idx + 1) % cast(usize)pool->threads.count;
-
-				Thread *thread = &pool->threads.data[idx];
-				WorkerTask task;
-
-				GrabState ret = thread_pool_queue_steal(thread, &task);
-				switch (ret) {
-				case Grab_Empty:
+				Thread *victim = &pool->threads.data[idx];
+				if (victim == current_thread) {
 					continue;
-				case Grab_Success:
-					task.do_work(task.data);
-					pool->tasks_left.fetch_sub(1, std::memory_order_release);
-
-					if (pool->tasks_left.load(std::memory_order_acquire) == 0) {
-						futex_signal(&pool->tasks_left);
-					}
+				}
 
-					/*fallthrough*/
-				case Grab_Failed:
+				if (thread_pool_queue_steal(victim, &task) == Grab_Success) {
+					thread_pool_steal_half(victim);
+					thread_pool_do_task(pool, task);
+					backoff = 0;
 					goto main_loop_continue;
 				}
+				// NOTE: On `Grab_Failed` another thief won the race for that task, so move on to the
+				// next victim rather than retrying the same contended deque
+			}
+
+			if (backoff < THREAD_POOL_STEAL_BACKOFF_LIMIT &&
+			    pool->tasks_left.load(std::memory_order_acquire)) {
+				for (isize i = 0; i < (1ll<<backoff); i++) {
+					yield_thread();
+				}
+				backoff += 1;
+				continue;
 			}
 		}
+		backoff = 0;
 
 		// if we've done all our work, and there's nothing to steal, go to sleep
 		pool->tasks_available.store(Someone_Waiting);
@@ -260,4 +919,3 @@ gb_internal THREAD_PROC(thread_pool_thread_proc) {
 
 	return 0;
 }
-
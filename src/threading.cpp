@@ -44,6 +44,7 @@ typedef WORKER_TASK_PROC(WorkerTaskProc);
 typedef struct WorkerTask {
 	WorkerTaskProc *do_work;
 	void           *data;
+	struct ThreadPoolTaskGroup *group;
 } WorkerTask;
 
 typedef struct TaskRingBuffer {
@@ -67,6 +68,7 @@ struct Thread {
 
 	isize idx;
 	isize stack_size;
+	i32   cpu; // the logical CPU the thread is pinned to, -1 when it is not, see `CpuTopology`
 
 	struct TaskQueue   queue;
 	struct ThreadPool *pool;
@@ -112,13 +114,93 @@ gb_internal void unpark_all(Parker *p);
 gb_internal u32  thread_current_id(void);
 
 gb_internal void thread_init                     (ThreadPool *pool, Thread *t, isize idx);
-gb_internal void thread_init_and_start           (ThreadPool *pool, Thread *t, isize idx);
+gb_internal void thread_init_and_start           (ThreadPool *pool, Thread *t, isize idx, i32 cpu=-1);
 gb_internal void thread_join_and_destroy(Thread *t);
 gb_internal void thread_set_name        (Thread *t, char const *name);
 
 gb_internal void yield_thread(void);
 gb_internal void yield_process(void);
 
+gb_internal u64 time_stamp_time_now(void);
+gb_internal u64 time_stamp__freq(void);
+
+// NOTE: Lock contention statistics, only gathered with `-show-lock-contention`
+//
+// Every mutex which is locked gets an entry keyed by its address, and mutexes which are given the same
+// name with `mutex_set_name` (e.g. the `types_mutex` of every `lbModule`) are merged in the report.
+// A mutex which is freed and whose memory is reused for another mutex shares the entry with it.
+gb_global bool lock_contention_enabled;
+
+struct LockContentionEntry {
+	std::atomic<void const *> mutex;
+	std::atomic<char const *> name;
+	std::atomic<u64>          acquisitions;
+	std::atomic<u64>          waits;
+	std::atomic<u64>          wait_time; // in time stamp units
+};
+
+enum : isize { LOCK_CONTENTION_TABLE_CAPACITY = 1<<20 };
+gb_global LockContentionEntry *lock_contention_table;   // LOCK_CONTENTION_TABLE_CAPACITY entries
+gb_global LockContentionEntry  lock_contention_overflow; // once the table is full
+
+// NOTE: Must be called before any other threads are started
+gb_internal void lock_contention_enable(void) {
+	// NOTE: The pages are only committed once touched, so a small program doesn't pay for the whole table
+	lock_contention_table = cast(LockContentionEntry *)calloc(LOCK_CONTENTION_TABLE_CAPACITY, gb_size_of(LockContentionEntry));
+	lock_contention_enabled = lock_contention_table != nullptr;
+}
+
+gb_internal LockContentionEntry *lock_contention_entry(void const *m) {
+	u64 h = cast(u64)cast(uintptr)m;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdull;
+	h ^= h >> 33;
+	for (isize i = 0; i < 256; i++) { // NOTE: bounded, the table is only a diagnostic
+		LockContentionEntry *e = &lock_contention_table[(h + i) & (LOCK_CONTENTION_TABLE_CAPACITY-1)];
+		void const *key = e->mutex.load(std::memory_order_acquire);
+		if (key == m) {
+			return e;
+		}
+		if (key == nullptr) {
+			if (e->mutex.compare_exchange_strong(key, m, std::memory_order_acq_rel) || key == m) {
+				return e;
+			}
+		}
+	}
+	return &lock_contention_overflow;
+}
+
+gb_internal void mutex_set_name(void const *m, char const *name) {
+	if (lock_contention_enabled) {
+		lock_contention_entry(m)->name.store(name, std::memory_order_relaxed);
+	}
+}
+
+gb_internal void lock_contention_record(void const *m, bool waited, u64 start) {
+	LockContentionEntry *e = lock_contention_entry(m);
+	e->acquisitions.fetch_add(1, std::memory_order_relaxed);
+	if (waited) {
+		e->waits.fetch_add(1, std::memory_order_relaxed);
+		e->wait_time.fetch_add(time_stamp_time_now() - start, std::memory_order_relaxed);
+	}
+}
+
+// NOTE: The adaptive spinning of the mutexes below: a mutex which was recently acquired by spinning is
+// allowed to spin for longer the next time, and one for which the spinning did not pay off goes to sleep
+// sooner. This suits the short critical sections, e.g. the type and value caches of `lbModule`.
+enum : i32 {
+	MUTEX_SPIN_MIN = 16,
+	MUTEX_SPIN_MAX = 1024,
+};
+
+gb_internal gb_inline i32 mutex_spin_limit(i32 spins) {
+	return gb_min(spins*2 + MUTEX_SPIN_MIN, MUTEX_SPIN_MAX);
+}
+
+gb_internal gb_inline i32 mutex_spin_update(i32 spins, i32 count) {
+	return spins + (count - spins)/8;
+}
+
 struct Wait_Signal {
 	Futex futex;
 };
@@ -182,27 +264,58 @@ struct MutexGuard {
 struct RecursiveMutex {
 	Futex owner;
 	i32   recursion;
+	Futex spins;   // adaptive spin count, see `mutex_spin_limit`
+	Futex waiters; // threads sleeping on `owner`
 };
 
-gb_internal void mutex_lock(RecursiveMutex *m) {
-	Futex tid;
-	tid.store(cast(i32)thread_current_id());
-	for (;;) {
-		i32 prev_owner = 0;
-		m->owner.compare_exchange_strong(prev_owner, tid, std::memory_order_acquire, std::memory_order_acquire);
-		if (prev_owner == 0 || prev_owner == tid) {
-			m->recursion++;
-			// inside the lock
-			return;
+gb_no_inline gb_internal void mutex_lock_slow(RecursiveMutex *m, i32 tid) {
+	u64 start = lock_contention_enabled ? time_stamp_time_now() : 0;
+	i32 spins = m->spins.load(std::memory_order_relaxed);
+	i32 limit = mutex_spin_limit(spins);
+	i32 count = 0;
+	for (;; count++) {
+		i32 prev_owner = m->owner.load(std::memory_order_relaxed);
+		if (prev_owner == 0 && m->owner.compare_exchange_weak(prev_owner, tid, std::memory_order_acquire, std::memory_order_relaxed)) {
+			break;
+		}
+		if (count < limit) {
+			yield_thread();
+			continue;
 		}
 
 		// NOTE(lucas): we are doing spin lock since futex signal is expensive on OSX. The recursive locks are
 		// very short lived so we don't hit this mega often and I see no perform regression on windows (with
 		// a performance uplift on OSX).
+		//
+		// NOTE: The unlock only signals when a thread has gone to sleep here, which is only after spinning
+		// did not pay off, so the uncontended unlock stays as cheap as it was.
+		m->waiters.fetch_add(1, std::memory_order_seq_cst);
+		prev_owner = m->owner.load(std::memory_order_seq_cst);
+		if (prev_owner != 0) {
+			futex_wait(&m->owner, prev_owner);
+		}
+		m->waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+	m->spins.store(mutex_spin_update(spins, count < limit ? count : 0), std::memory_order_relaxed);
+	m->recursion++;
+	if (lock_contention_enabled) {
+		lock_contention_record(m, true, start);
+	}
+}
 
-		//futex_wait(&m->owner, prev_owner);
-		yield_thread();
+gb_internal void mutex_lock(RecursiveMutex *m) {
+	i32 tid = cast(i32)thread_current_id();
+	i32 prev_owner = 0;
+	m->owner.compare_exchange_strong(prev_owner, tid, std::memory_order_acquire, std::memory_order_acquire);
+	if (prev_owner == 0 || prev_owner == tid) {
+		m->recursion++;
+		// inside the lock
+		if (lock_contention_enabled) {
+			lock_contention_record(m, false, 0);
+		}
+		return;
 	}
+	mutex_lock_slow(m, tid);
 }
 gb_internal bool mutex_try_lock(RecursiveMutex *m) {
 	Futex tid;
@@ -221,10 +334,12 @@ gb_internal void mutex_unlock(RecursiveMutex *m) {
 	if (m->recursion != 0) {
 		return;
 	}
-	m->owner.exchange(0, std::memory_order_release);
-	// NOTE(lucas): see comment about spin lock in mutex_lock above
-
-	// futex_signal(&m->owner);
+	// NOTE: seq_cst pairs with the sleeping side of `mutex_lock_slow`, either it sees the mutex as
+	// unlocked or this sees it waiting
+	m->owner.exchange(0, std::memory_order_seq_cst);
+	if (m->waiters.load(std::memory_order_seq_cst) != 0) {
+		futex_signal(&m->owner);
+	}
 	// outside the lock
 }
 
@@ -261,10 +376,24 @@ gb_internal void semaphore_wait(Semaphore *s) {
 }
 
 #if defined(GB_SYSTEM_WINDOWS)
+	// NOTE: SRW locks already spin adaptively before they sleep, so only the statistics are added here
 	struct BlockingMutex {
 		SRWLOCK srwlock;
 	};
+	gb_no_inline gb_internal void mutex_lock_slow(BlockingMutex *m) {
+		if (TryAcquireSRWLockExclusive(&m->srwlock)) {
+			lock_contention_record(m, false, 0);
+			return;
+		}
+		u64 start = time_stamp_time_now();
+		AcquireSRWLockExclusive(&m->srwlock);
+		lock_contention_record(m, true, start);
+	}
 	gb_internal void mutex_lock(BlockingMutex *m) {
+		if (lock_contention_enabled) {
+			mutex_lock_slow(m);
+			return;
+		}
 		AcquireSRWLockExclusive(&m->srwlock);
 	}
 	gb_internal bool mutex_try_lock(BlockingMutex *m) {
@@ -292,7 +421,25 @@ gb_internal void semaphore_wait(Semaphore *s) {
 		SRWLOCK srwlock;
 	};
 
+	gb_no_inline gb_internal void rw_mutex_lock_slow(RwMutex *m, bool shared) {
+		if (shared ? TryAcquireSRWLockShared(&m->srwlock) : TryAcquireSRWLockExclusive(&m->srwlock)) {
+			lock_contention_record(m, false, 0);
+			return;
+		}
+		u64 start = time_stamp_time_now();
+		if (shared) {
+			AcquireSRWLockShared(&m->srwlock);
+		} else {
+			AcquireSRWLockExclusive(&m->srwlock);
+		}
+		lock_contention_record(m, true, start);
+	}
+
 	gb_internal void rw_mutex_lock(RwMutex *m) {
+		if (lock_contention_enabled) {
+			rw_mutex_lock_slow(m, false);
+			return;
+		}
 		AcquireSRWLockExclusive(&m->srwlock);
 	}
 	gb_internal bool rw_mutex_try_lock(RwMutex *m) {
@@ -303,6 +450,10 @@ gb_internal void semaphore_wait(Semaphore *s) {
 	}
 
 	gb_internal void rw_mutex_shared_lock(RwMutex *m) {
+		if (lock_contention_enabled) {
+			rw_mutex_lock_slow(m, true);
+			return;
+		}
 		AcquireSRWLockShared(&m->srwlock);
 	}
 	gb_internal bool rw_mutex_try_shared_lock(RwMutex *m) {
@@ -328,6 +479,7 @@ gb_internal void semaphore_wait(Semaphore *s) {
 		// }
 		#endif
 		i32 state_;
+		i32 spins_; // adaptive spin count, see `mutex_spin_limit`
 
 		Futex &state() {
 			return *(Futex *)&this->state_;
@@ -335,29 +487,43 @@ gb_internal void semaphore_wait(Semaphore *s) {
 		Futex const &state() const {
 			return *(Futex const *)&this->state_;
 		}
+		Futex &spins() {
+			return *(Futex *)&this->spins_;
+		}
 	};
 
 	gb_no_inline gb_internal void mutex_lock_slow(BlockingMutex *m, i32 curr_state) {
+		u64 start = lock_contention_enabled ? time_stamp_time_now() : 0;
+
 		i32 new_state = curr_state;
-		for (i32 spin = 0; spin < 100; spin++) {
-			i32 state = Internal_Mutex_State_Unlocked;
-			bool ok = m->state().compare_exchange_weak(state, new_state, std::memory_order_acquire, std::memory_order_consume);
-			if (ok) {
+		i32 spins = m->spins().load(std::memory_order_relaxed);
+		i32 limit = mutex_spin_limit(spins);
+		for (i32 count = 0; count < limit; count++) {
+			i32 state = m->state().load(std::memory_order_relaxed);
+			if (state == Internal_Mutex_State_Unlocked &&
+			    m->state().compare_exchange_weak(state, new_state, std::memory_order_acquire, std::memory_order_relaxed)) {
+				m->spins().store(mutex_spin_update(spins, count), std::memory_order_relaxed);
+				if (lock_contention_enabled) {
+					lock_contention_record(m, true, start);
+				}
 				return;
 			}
 			if (state == Internal_Mutex_State_Waiting) {
+				// NOTE: Other threads are already asleep, so the lock is not about to become free
 				break;
 			}
-			for (i32 i = gb_min(spin+1, 32); i > 0; i--) {
-				yield_thread();
-			}
+			yield_thread();
 		}
+		m->spins().store(mutex_spin_update(spins, 0), std::memory_order_relaxed);
 
-		// Set just in case 100 iterations did not do it
+		// Set just in case the spinning did not do it
 		new_state = Internal_Mutex_State_Waiting;
 
 		for (;;) {
 			if (m->state().exchange(Internal_Mutex_State_Waiting, std::memory_order_acquire) == Internal_Mutex_State_Unlocked) {
+				if (lock_contention_enabled) {
+					lock_contention_record(m, true, start);
+				}
 				return;
 			}
 			futex_wait(&m->state(), new_state);
@@ -370,6 +536,8 @@ gb_internal void semaphore_wait(Semaphore *s) {
 		i32 v = m->state().exchange(Internal_Mutex_State_Locked, std::memory_order_acquire);
 		if (v != Internal_Mutex_State_Unlocked) {
 			mutex_lock_slow(m, v);
+		} else if (lock_contention_enabled) {
+			lock_contention_record(m, false, 0);
 		}
 		ANNOTATE_LOCK_POST(m);
 	}
@@ -637,12 +805,14 @@ gb_internal void thread_init(ThreadPool *pool, Thread *t, isize idx) {
 	t->queue.ring = task_ring_init(1 << 14);
 	t->pool = pool;
 	t->idx = idx;
+	t->cpu = -1;
 
 	thread_init_arenas(t);
 }
 
-gb_internal void thread_init_and_start(ThreadPool *pool, Thread *t, isize idx) {
+gb_internal void thread_init_and_start(ThreadPool *pool, Thread *t, isize idx, i32 cpu) {
 	thread_init(pool, t, idx);
+	t->cpu = cpu;
 	isize stack_size = 1 * 1024 * 1024; // 1 MiB (LLVM takes a lot of stack space)
 
 #if defined(GB_SYSTEM_WINDOWS)
@@ -1,7 +1,20 @@
+enum PerfCounterKind {
+	PerfCounter_Cycles,
+	PerfCounter_Instructions,
+	PerfCounter_CacheMisses,
+	PerfCounter_ContextSwitches,
+
+	PerfCounter_COUNT,
+};
+
 struct TimeStamp {
 	u64    start;
 	u64    finish;
 	String label;
+
+	// NOTE: Only recorded with -show-perf-counters
+	u64    perf_start [PerfCounter_COUNT];
+	u64    perf_finish[PerfCounter_COUNT];
 };
 
 struct Timings {
@@ -105,10 +118,92 @@ gb_internal u64 time_stamp__freq(void) {
 #endif
 }
 
+// NOTE: Hardware performance counters for -show-perf-counters, read through `perf_event_open` on Linux.
+// A counter only counts the thread which opened it, so every thread of the thread pool opens its own
+// and a reading is the sum over all of the threads.
+struct PerfCounterThread {
+	int                fds[PerfCounter_COUNT];
+	PerfCounterThread *next;
+};
+
+gb_global bool global_perf_counters_enabled;
+gb_global std::atomic<PerfCounterThread *> global_perf_counter_threads;
+
+char const *perf_counter_strings[PerfCounter_COUNT] = {"cycles", "instructions", "cache-misses", "ctx-switches"};
+
+#if defined(GB_SYSTEM_LINUX)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+gb_internal int perf_counter_open(u32 type, u64 config) {
+	struct perf_event_attr attr = {};
+	attr.size           = gb_size_of(attr);
+	attr.type           = type;
+	attr.config         = config;
+	attr.exclude_kernel = type == PERF_TYPE_HARDWARE;
+	attr.exclude_hv     = 1;
+
+	int fd = cast(int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	if (fd < 0 && !attr.exclude_kernel) {
+		// NOTE: A restrictive `perf_event_paranoid` only allows counting user space
+		attr.exclude_kernel = 1;
+		fd = cast(int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+	}
+	return fd;
+}
+#endif
+
+gb_internal void perf_counters_open_for_thread(void) {
+	if (!global_perf_counters_enabled) {
+		return;
+	}
+#if defined(GB_SYSTEM_LINUX)
+	PerfCounterThread *pt = gb_alloc_item(heap_allocator(), PerfCounterThread);
+	pt->fds[PerfCounter_Cycles]          = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	pt->fds[PerfCounter_Instructions]    = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	pt->fds[PerfCounter_CacheMisses]     = perf_counter_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	pt->fds[PerfCounter_ContextSwitches] = perf_counter_open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+
+	PerfCounterThread *head = global_perf_counter_threads.load(std::memory_order_relaxed);
+	do {
+		pt->next = head;
+	} while (!global_perf_counter_threads.compare_exchange_weak(head, pt, std::memory_order_release, std::memory_order_relaxed));
+#endif
+}
+
+gb_internal void perf_counters_read(u64 values[PerfCounter_COUNT]) {
+	gb_zero_size(values, gb_size_of(u64)*PerfCounter_COUNT);
+#if defined(GB_SYSTEM_LINUX)
+	for (PerfCounterThread *pt = global_perf_counter_threads.load(std::memory_order_acquire); pt != nullptr; pt = pt->next) {
+		for (isize i = 0; i < PerfCounter_COUNT; i++) {
+			u64 value = 0;
+			if (pt->fds[i] >= 0 && read(pt->fds[i], &value, gb_size_of(value)) == gb_size_of(value)) {
+				values[i] += value;
+			}
+		}
+	}
+#endif
+}
+
+gb_internal bool perf_counters_available(void) {
+	for (PerfCounterThread *pt = global_perf_counter_threads.load(std::memory_order_acquire); pt != nullptr; pt = pt->next) {
+		for (isize i = 0; i < PerfCounter_COUNT; i++) {
+			if (pt->fds[i] >= 0) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 gb_internal TimeStamp make_time_stamp(String const &label) {
 	TimeStamp ts = {0};
 	ts.start = time_stamp_time_now();
 	ts.label = label;
+	if (global_perf_counters_enabled) {
+		perf_counters_read(ts.perf_start);
+	}
 	return ts;
 }
 
@@ -124,7 +219,11 @@ gb_internal void timings_destroy(Timings *t) {
 
 gb_internal void timings__stop_current_section(Timings *t) {
 	if (t->sections.count > 0) {
-		t->sections[t->sections.count-1].finish = time_stamp_time_now();
+		TimeStamp *ts = &t->sections[t->sections.count-1];
+		ts->finish = time_stamp_time_now();
+		if (global_perf_counters_enabled) {
+			perf_counters_read(ts->perf_finish);
+		}
 	}
 }
 
@@ -152,6 +251,64 @@ gb_internal f64 time_stamp_as_us(TimeStamp const &ts, u64 freq) {
 #define TIME_SECTION_WITH_LEN(str, len)      do { debugf("[Section] %s\n", str); if (build_context.show_more_timings) timings_start_section(&global_timings, make_string((u8 *)str, len)); } while (0)
 
 
+// NOTE: Per-thread begin/end events, only recorded with -export-timings:trace
+struct TraceEvent {
+	u64         start;
+	u64         finish;
+	char const *name;
+	String      detail;
+};
+
+struct TraceThreadEvents {
+	Array<TraceEvent>  events;
+	isize              thread_index;
+	TraceThreadEvents *next;
+};
+
+gb_global bool global_trace_enabled;
+gb_global std::atomic<TraceThreadEvents *> global_trace_threads;
+gb_global gb_thread_local TraceThreadEvents *trace__current_thread_events;
+
+gb_internal void trace_add_event(char const *name, String const &detail, u64 start, u64 finish) {
+	TraceThreadEvents *te = trace__current_thread_events;
+	if (te == nullptr) {
+		te = gb_alloc_item(heap_allocator(), TraceThreadEvents);
+		array_init(&te->events, heap_allocator(), 0, 1024);
+		te->thread_index = current_thread ? current_thread->idx : 0;
+
+		TraceThreadEvents *head = global_trace_threads.load(std::memory_order_relaxed);
+		do {
+			te->next = head;
+		} while (!global_trace_threads.compare_exchange_weak(head, te, std::memory_order_release, std::memory_order_relaxed));
+
+		trace__current_thread_events = te;
+	}
+	array_add(&te->events, TraceEvent{start, finish, name, detail});
+}
+
+struct TraceScope {
+	u64         start;
+	char const *name;
+	String      detail;
+
+	TraceScope(char const *name_, String const &detail_) {
+		start = 0;
+		if (global_trace_enabled) {
+			name   = name_;
+			detail = detail_;
+			start  = time_stamp_time_now();
+		}
+	}
+	~TraceScope() {
+		if (global_trace_enabled && start != 0) {
+			trace_add_event(name, detail, start, time_stamp_time_now());
+		}
+	}
+};
+
+#define TRACE_SCOPE(name, detail) TraceScope trace__scope_(name, detail)
+
+
 enum TimingUnit {
 	TimingUnit_Second,
 	TimingUnit_Millisecond,
@@ -171,6 +328,121 @@ gb_internal f64 time_stamp(TimeStamp const &ts, u64 freq, TimingUnit unit) {
 	}
 }
 
+gb_internal void timings_print_perf_counter_row(String const &label, isize max_len, char const *spaces, TimeStamp const &ts) {
+	u64 delta[PerfCounter_COUNT] = {};
+	for (isize i = 0; i < PerfCounter_COUNT; i++) {
+		delta[i] = ts.perf_finish[i] >= ts.perf_start[i] ? ts.perf_finish[i] - ts.perf_start[i] : 0;
+	}
+	f64 ipc = delta[PerfCounter_Cycles] ? cast(f64)delta[PerfCounter_Instructions]/cast(f64)delta[PerfCounter_Cycles] : 0.0;
+	gb_printf_err("%.*s%.*s - %16llu %16llu %6.2f %14llu %12llu\n",
+	              LIT(label), cast(int)(max_len-label.len), spaces,
+	              cast(unsigned long long)delta[PerfCounter_Cycles],
+	              cast(unsigned long long)delta[PerfCounter_Instructions],
+	              ipc,
+	              cast(unsigned long long)delta[PerfCounter_CacheMisses],
+	              cast(unsigned long long)delta[PerfCounter_ContextSwitches]);
+}
+
+// NOTE: The counters are summed over every thread, so a section which is waiting on IO or on other
+// threads shows few cycles for its wall time, and a low IPC with many cache misses is memory bound
+gb_internal void timings_print_perf_counters(Timings *t, isize max_len, char const *spaces) {
+	gb_printf_err("\n");
+	if (!perf_counters_available()) {
+		gb_printf_err("Performance counters are not available (see /proc/sys/kernel/perf_event_paranoid)\n");
+		return;
+	}
+	gb_printf_err("%.*s   %16s %16s %6s %14s %12s\n", cast(int)max_len, spaces,
+	              perf_counter_strings[PerfCounter_Cycles],
+	              perf_counter_strings[PerfCounter_Instructions],
+	              "IPC",
+	              perf_counter_strings[PerfCounter_CacheMisses],
+	              perf_counter_strings[PerfCounter_ContextSwitches]);
+	timings_print_perf_counter_row(t->total.label, max_len, spaces, t->total);
+	for (TimeStamp const &ts : t->sections) {
+		timings_print_perf_counter_row(ts.label, max_len, spaces, ts);
+	}
+}
+
+struct LockContentionRow {
+	char const *name;
+	isize       mutexes;
+	u64         acquisitions;
+	u64         waits;
+	u64         wait_time;
+};
+
+gb_internal int lock_contention_row_cmp(void const *a, void const *b) {
+	LockContentionRow const *x = cast(LockContentionRow const *)a;
+	LockContentionRow const *y = cast(LockContentionRow const *)b;
+	if (x->wait_time != y->wait_time) {
+		return x->wait_time > y->wait_time ? -1 : +1;
+	}
+	if (x->acquisitions != y->acquisitions) {
+		return x->acquisitions > y->acquisitions ? -1 : +1;
+	}
+	return gb_strcmp(x->name, y->name);
+}
+
+// NOTE: The wait time is summed over every thread, so it can be larger than the wall time
+gb_internal void timings_print_lock_contention(u64 freq) {
+	auto rows = array_make<LockContentionRow>(heap_allocator(), 0, 64);
+	defer (array_free(&rows));
+
+	auto add_entry = [&rows](LockContentionEntry *e, char const *fallback_name) {
+		char const *name = e->name.load(std::memory_order_relaxed);
+		if (name == nullptr) {
+			name = fallback_name;
+		}
+		LockContentionRow *row = nullptr;
+		for (LockContentionRow &r : rows) {
+			if (gb_strcmp(r.name, name) == 0) {
+				row = &r;
+				break;
+			}
+		}
+		if (row == nullptr) {
+			array_add(&rows, LockContentionRow{name});
+			row = &rows[rows.count-1];
+		}
+		row->mutexes      += 1;
+		row->acquisitions += e->acquisitions.load(std::memory_order_relaxed);
+		row->waits        += e->waits.load(std::memory_order_relaxed);
+		row->wait_time    += e->wait_time.load(std::memory_order_relaxed);
+	};
+	for (isize i = 0; i < LOCK_CONTENTION_TABLE_CAPACITY; i++) {
+		LockContentionEntry *e = &lock_contention_table[i];
+		if (e->mutex.load(std::memory_order_relaxed) != nullptr) {
+			add_entry(e, "(unnamed)");
+		}
+	}
+	if (lock_contention_overflow.acquisitions.load(std::memory_order_relaxed) != 0) {
+		add_entry(&lock_contention_overflow, "(table full)");
+	}
+	array_sort(rows, lock_contention_row_cmp);
+
+	isize max_len = 5;
+	for (LockContentionRow const &r : rows) {
+		max_len = gb_max(max_len, gb_strlen(r.name));
+	}
+	max_len = gb_min(max_len, 64);
+	char const spaces[] = "                                                                ";
+
+	gb_printf_err("\nLock contention\n");
+	gb_printf_err("Mutex%.*s %8s %14s %12s %8s %12s\n", cast(int)(max_len-5), spaces, "Count", "Acquisitions", "Waits", "Waits%", "Wait Time");
+	for (LockContentionRow const &r : rows) {
+		isize name_len = gb_min(gb_strlen(r.name), max_len);
+		f64 wait_ms = 1000.0 * cast(f64)r.wait_time / cast(f64)freq;
+		f64 wait_percent = r.acquisitions ? 100.0 * cast(f64)r.waits / cast(f64)r.acquisitions : 0.0;
+		gb_printf_err("%.*s%.*s %8td %14llu %12llu %7.2f%% %9.3f ms\n",
+		              cast(int)name_len, r.name, cast(int)(max_len-name_len), spaces,
+		              r.mutexes,
+		              cast(unsigned long long)r.acquisitions,
+		              cast(unsigned long long)r.waits,
+		              wait_percent,
+		              wait_ms);
+	}
+}
+
 gb_internal void timings_print_all(Timings *t, TimingUnit unit = TimingUnit_Millisecond, bool timings_are_finalized = false) {
 	isize const SPACES_LEN = 256;
 	char SPACES[SPACES_LEN+1] = {0};
@@ -183,6 +455,9 @@ gb_internal void timings_print_all(Timings *t, TimingUnit unit = TimingUnit_Mill
 	if (!timings_are_finalized) {
 		timings__stop_current_section(t);
 		t->total.finish = time_stamp_time_now();
+		if (global_perf_counters_enabled) {
+			perf_counters_read(t->total.perf_finish);
+		}
 	}
 
 	isize max_len = gb_min(36, t->total.label.len);
@@ -214,4 +489,59 @@ gb_internal void timings_print_all(Timings *t, TimingUnit unit = TimingUnit_Mill
 		          timing_unit_strings[unit],
 		          100.0*section_time/total_time);
 	}
-}
\ No newline at end of file
+
+	if (global_perf_counters_enabled) {
+		timings_print_perf_counters(t, max_len, SPACES);
+	}
+	if (lock_contention_enabled) {
+		timings_print_lock_contention(t->freq);
+	}
+}
+gb_internal void trace__write_json_string(gbFile *f, String const &s) {
+	gb_fprintf(f, "\"");
+	for (isize i = 0; i < s.len; i++) {
+		u8 c = s[i];
+		if (c == '"' || c == '\\') {
+			gb_fprintf(f, "\\%c", c);
+		} else if (c < 0x20) {
+			gb_fprintf(f, "\\u%04x", c);
+		} else {
+			gb_fprintf(f, "%c", c);
+		}
+	}
+	gb_fprintf(f, "\"");
+}
+
+gb_internal void trace__write_event(gbFile *f, Timings *t, isize tid, String const &name, String const &detail, u64 start, u64 finish, bool *first) {
+	f64 to_us = 1000000.0/cast(f64)t->freq;
+	f64 ts  = cast(f64)(start  - t->total.start) * to_us;
+	f64 dur = cast(f64)(finish - start) * to_us;
+
+	gb_fprintf(f, "%s\n\t\t{\"ph\": \"X\", \"pid\": 1, \"tid\": %td, \"ts\": %.3f, \"dur\": %.3f, \"name\": ", *first ? "" : ",", tid, ts, dur);
+	trace__write_json_string(f, name);
+	if (detail.len > 0) {
+		gb_fprintf(f, ", \"args\": {\"detail\": ");
+		trace__write_json_string(f, detail);
+		gb_fprintf(f, "}");
+	}
+	gb_fprintf(f, "}");
+	*first = false;
+}
+
+// NOTE: Chrome trace event format, loadable in Perfetto or chrome://tracing
+gb_internal void timings_export_trace(Timings *t, gbFile *f) {
+	bool first = true;
+	gb_fprintf(f, "{\n\t\"displayTimeUnit\": \"ms\",\n\t\"traceEvents\": [");
+
+	for (TimeStamp const &ts : t->sections) {
+		trace__write_event(f, t, 0, ts.label, {}, ts.start, ts.finish, &first);
+	}
+
+	for (TraceThreadEvents *te = global_trace_threads.load(std::memory_order_acquire); te != nullptr; te = te->next) {
+		for (TraceEvent const &e : te->events) {
+			trace__write_event(f, t, te->thread_index, make_string_c(e.name), e.detail, e.start, e.finish, &first);
+		}
+	}
+
+	gb_fprintf(f, "\n\t]\n}\n");
+}
@@ -310,12 +310,50 @@ struct Tokenizer {
 	i32 error_count;
 
 	bool insert_semicolon;
+
+	// NOTE: Tokens before `lexed_until` are only ever lexed again when the parser resumes from an earlier
+	// token, which must not report the same errors twice, see 'tokenizer_get_token_resumable'
+	u8 * lexed_until;
+	bool relexing;
 	
 	LoadedFile loaded_file;
 };
 
+// NOTE: The part of the tokenizer which changes whilst lexing, enough to resume lexing after a token
+struct TokenizerState {
+	u8 * curr;
+	u8 * read_curr;
+	Rune curr_rune;
+	i32  column_minus_one;
+	i32  line_count;
+	bool insert_semicolon;
+};
+
+gb_internal TokenizerState tokenizer_state(Tokenizer const *t) {
+	TokenizerState s = {};
+	s.curr             = t->curr;
+	s.read_curr        = t->read_curr;
+	s.curr_rune        = t->curr_rune;
+	s.column_minus_one = t->column_minus_one;
+	s.line_count       = t->line_count;
+	s.insert_semicolon = t->insert_semicolon;
+	return s;
+}
+
+gb_internal void tokenizer_restore_state(Tokenizer *t, TokenizerState const &s) {
+	t->curr             = s.curr;
+	t->read_curr        = s.read_curr;
+	t->curr_rune        = s.curr_rune;
+	t->column_minus_one = s.column_minus_one;
+	t->line_count       = s.line_count;
+	t->insert_semicolon = s.insert_semicolon;
+}
+
 
 gb_internal void tokenizer_err(Tokenizer *t, char const *msg, ...) {
+	if (t->relexing) {
+		return;
+	}
 	va_list va;
 	i32 column = t->column_minus_one+1;
 	if (column < 1) {
@@ -335,6 +373,9 @@ gb_internal void tokenizer_err(Tokenizer *t, char const *msg, ...) {
 }
 
 gb_internal void tokenizer_err(Tokenizer *t, TokenPos const &pos, char const *msg, ...) {
+	if (t->relexing) {
+		return;
+	}
 	va_list va;
 	i32 column = t->column_minus_one+1;
 	if (column < 1) {
@@ -378,6 +419,150 @@ gb_internal void advance_to_next_rune(Tokenizer *t) {
 	}
 }
 
+// NOTE: Fast paths for long runs of plain ASCII bytes (comments, strings, identifiers, indentation).
+// A byte is "plain" if it cannot terminate the current construct; '\n', NUL and non-ASCII bytes are
+// never plain so that line counting and the UTF-8 validation in `advance_to_next_rune` are kept.
+enum TokenizerScanKind {
+	TokenizerScan_LineComment,
+	TokenizerScan_BlockComment,
+	TokenizerScan_String,
+	TokenizerScan_RawString,
+	TokenizerScan_Ident,
+	TokenizerScan_Whitespace,
+};
+
+#if defined(GB_CPU_X86)
+	#include <emmintrin.h>
+	#define TOKENIZER_SIMD_SSE2 1
+#elif defined(GB_CPU_ARM) && defined(GB_ARCH_64_BIT) && defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define TOKENIZER_SIMD_NEON 1
+#endif
+
+gb_internal gb_inline bool tokenizer_is_plain_byte(u8 c, TokenizerScanKind kind) {
+	if (c == '\n' || c == 0 || c >= 0x80) {
+		return false;
+	}
+	switch (kind) {
+	case TokenizerScan_LineComment:
+		return true;
+	case TokenizerScan_BlockComment:
+		return c != '/' && c != '*';
+	case TokenizerScan_String:
+		return c != '"' && c != '\\';
+	case TokenizerScan_RawString:
+		return c != '`';
+	case TokenizerScan_Ident:
+		return ('a' <= (c|0x20) && (c|0x20) <= 'z') || ('0' <= c && c <= '9') || c == '_';
+	case TokenizerScan_Whitespace:
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+	return false;
+}
+
+// Returns the first byte in [p, end) which is not plain for `kind`
+gb_internal u8 *tokenizer_scan_plain(u8 *p, u8 *end, TokenizerScanKind kind) {
+#if defined(TOKENIZER_SIMD_SSE2)
+	__m128i const newline = _mm_set1_epi8('\n');
+	__m128i const nul     = _mm_setzero_si128();
+	for (; end-p >= 16; p += 16) {
+		__m128i v = _mm_loadu_si128(cast(__m128i const *)p);
+		// NOTE: the sign bit of each byte is set for every non-ASCII byte
+		u32 special = cast(u32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, nul)));
+		special |= cast(u32)_mm_movemask_epi8(v);
+
+		switch (kind) {
+		case TokenizerScan_LineComment:
+			break;
+		case TokenizerScan_BlockComment:
+			special |= cast(u32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('/')), _mm_cmpeq_epi8(v, _mm_set1_epi8('*'))));
+			break;
+		case TokenizerScan_String:
+			special |= cast(u32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+			break;
+		case TokenizerScan_RawString:
+			special |= cast(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('`')));
+			break;
+		case TokenizerScan_Ident: {
+			__m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+			__m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a'-1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('z'+1)));
+			__m128i is_digit  = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0'-1)), _mm_cmplt_epi8(v, _mm_set1_epi8('9'+1)));
+			__m128i is_under  = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+			u32 plain = cast(u32)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(is_letter, is_digit), is_under));
+			special |= ~plain & 0xffff;
+		} break;
+		case TokenizerScan_Whitespace: {
+			__m128i is_space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+			is_space = _mm_or_si128(is_space, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+			special |= ~cast(u32)_mm_movemask_epi8(is_space) & 0xffff;
+		} break;
+		}
+
+		if (special != 0) {
+			return p + count_trailing_zeros(special);
+		}
+	}
+#elif defined(TOKENIZER_SIMD_NEON)
+	for (; end-p >= 16; p += 16) {
+		uint8x16_t v = vld1q_u8(p);
+		uint8x16_t special = vorrq_u8(vceqq_u8(v, vdupq_n_u8('\n')), vceqzq_u8(v));
+		special = vorrq_u8(special, vcgeq_u8(v, vdupq_n_u8(0x80)));
+
+		switch (kind) {
+		case TokenizerScan_LineComment:
+			break;
+		case TokenizerScan_BlockComment:
+			special = vorrq_u8(special, vorrq_u8(vceqq_u8(v, vdupq_n_u8('/')), vceqq_u8(v, vdupq_n_u8('*'))));
+			break;
+		case TokenizerScan_String:
+			special = vorrq_u8(special, vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\'))));
+			break;
+		case TokenizerScan_RawString:
+			special = vorrq_u8(special, vceqq_u8(v, vdupq_n_u8('`')));
+			break;
+		case TokenizerScan_Ident: {
+			uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+			uint8x16_t is_letter = vcleq_u8(vsubq_u8(lower, vdupq_n_u8('a')), vdupq_n_u8('z'-'a'));
+			uint8x16_t is_digit  = vcleq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8('9'-'0'));
+			uint8x16_t is_under  = vceqq_u8(v, vdupq_n_u8('_'));
+			special = vorrq_u8(special, vmvnq_u8(vorrq_u8(vorrq_u8(is_letter, is_digit), is_under)));
+		} break;
+		case TokenizerScan_Whitespace: {
+			uint8x16_t is_space = vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t')));
+			is_space = vorrq_u8(is_space, vceqq_u8(v, vdupq_n_u8('\r')));
+			special = vorrq_u8(special, vmvnq_u8(is_space));
+		} break;
+		}
+
+		if (vmaxvq_u8(special) != 0) {
+			break; // the scalar loop below finds the exact byte
+		}
+	}
+#endif
+	for (; p < end; p++) {
+		if (!tokenizer_is_plain_byte(*p, kind)) {
+			break;
+		}
+	}
+	return p;
+}
+
+// Moves the tokenizer to the last plain byte of the run following the current rune,
+// equivalent to calling `advance_to_next_rune` once per skipped byte.
+// The current rune itself must be plain for `kind`.
+gb_internal gb_inline void tokenizer_fast_forward(Tokenizer *t, TokenizerScanKind kind) {
+	if (cast(u32)t->curr_rune >= 0x80 || !tokenizer_is_plain_byte(cast(u8)t->curr_rune, kind)) {
+		return;
+	}
+	u8 *p = tokenizer_scan_plain(t->read_curr, t->end, kind);
+	if (p > t->read_curr) {
+		t->column_minus_one += cast(i32)(p - t->read_curr);
+		t->curr      = p-1;
+		t->read_curr = p;
+		t->curr_rune = p[-1];
+	}
+}
+
 gb_internal void init_tokenizer_with_data(Tokenizer *t, String const &fullpath, void const *data, isize size) {
 	t->fullpath = fullpath;
 	t->column_minus_one = -1;
@@ -651,6 +836,7 @@ gb_internal bool scan_escape(Tokenizer *t) {
 
 gb_internal gb_inline void tokenizer_skip_line(Tokenizer *t) {
 	while (t->curr_rune != '\n' && t->curr_rune != GB_RUNE_EOF) {
+		tokenizer_fast_forward(t, TokenizerScan_LineComment);
 		advance_to_next_rune(t);
 	}
 }
@@ -662,6 +848,7 @@ gb_internal gb_inline void tokenizer_skip_whitespace(Tokenizer *t, bool on_newli
 			case ' ':
 			case '\t':
 			case '\r':
+				tokenizer_fast_forward(t, TokenizerScan_Whitespace);
 				advance_to_next_rune(t);
 				continue;
 			}
@@ -674,6 +861,7 @@ gb_internal gb_inline void tokenizer_skip_whitespace(Tokenizer *t, bool on_newli
 			case ' ':
 			case '\t':
 			case '\r':
+				tokenizer_fast_forward(t, TokenizerScan_Whitespace);
 				advance_to_next_rune(t);
 				continue;
 			}
@@ -699,6 +887,7 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 	if (rune_is_letter(curr_rune)) {
 		token->kind = Token_Ident;
 		while (rune_is_letter_or_digit(t->curr_rune)) {
+			tokenizer_fast_forward(t, TokenizerScan_Ident);
 			advance_to_next_rune(t);
 		}
 
@@ -794,6 +983,7 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 			token->kind = Token_String;
 			if (curr_rune == '"') {
 				for (;;) {
+					tokenizer_fast_forward(t, TokenizerScan_String);
 					Rune r = t->curr_rune;
 					if (r == '\n' || r < 0) {
 						tokenizer_err(t, "String literal not terminated");
@@ -809,6 +999,7 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 				}
 			} else {
 				for (;;) {
+					tokenizer_fast_forward(t, TokenizerScan_RawString);
 					Rune r = t->curr_rune;
 					if (r < 0) {
 						tokenizer_err(t, "String literal not terminated");
@@ -988,6 +1179,7 @@ gb_internal void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 							comment_scope--;
 						}
 					} else {
+						tokenizer_fast_forward(t, TokenizerScan_BlockComment);
 						advance_to_next_rune(t);
 					}
 				}
@@ -1130,3 +1322,12 @@ semicolon_check:;
 
 	return;
 }
+
+// NOTE: Used when the tokenizer may be rewound with 'tokenizer_restore_state', the errors of any token which
+// is lexed again are not reported again
+gb_internal void tokenizer_get_token_resumable(Tokenizer *t, Token *token) {
+	t->relexing = t->read_curr < t->lexed_until;
+	tokenizer_get_token(t, token);
+	t->relexing = false;
+	t->lexed_until = gb_max(t->lexed_until, t->read_curr);
+}
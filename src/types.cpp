@@ -164,9 +164,12 @@ struct TypeStruct {
 	bool            is_raw_union                : 1;
 	bool            is_all_or_none              : 1;
 	bool            is_simple                   : 1;
+	bool            is_reorder                  : 1; // fields are sorted by alignment, see 'reorder_struct_fields'
 	bool            is_poly_specialized         : 1;
 
 	std::atomic<bool> are_offsets_being_processed;
+
+	std::atomic<struct StructFieldLookupTable *> field_lookup_table; // built lazily by `lookup_field_with_selection`
 };
 
 struct TypeUnion {
@@ -324,7 +327,7 @@ enum TypeKind {
 };
 
 gb_global String const type_strings[] = {
-	{cast(u8 *)"Invalid", gb_size_of("Invalid")},
+	{cast(u8 *)"Invalid", gb_size_of("Invalid")-1},
 #define TYPE_KIND(k, ...) {cast(u8 *)#k, gb_size_of(#k)-1},
 	TYPE_KINDS
 #undef TYPE_KIND
@@ -442,6 +445,13 @@ struct Selection {
 };
 gb_global Selection const empty_selection = {0};
 
+// NOTE: set once the checker has finished and every type's layout is final
+gb_global std::atomic<bool> g_type_layouts_frozen;
+
+gb_internal bool type_layouts_are_frozen(void) {
+	return g_type_layouts_frozen.load(std::memory_order_relaxed);
+}
+
 gb_internal Selection make_selection(Entity *entity, Array<i32> index, bool indirect) {
 	Selection s = {entity, index, indirect};
 	return s;
@@ -1014,8 +1024,15 @@ gb_internal void set_base_type(Type *t, Type *base) {
 }
 
 
+// NOTE: Only counted with -show-stats
+gb_global std::atomic<isize> global_type_counts[Type_Count];
+
 gb_internal Type *alloc_type(TypeKind kind) {
 	Type *t = permanent_alloc_item<Type>();
+	memory_account(MemorySubsystem_Types, gb_size_of(Type));
+	if (build_context.show_stats) {
+		global_type_counts[kind].fetch_add(1, std::memory_order_relaxed);
+	}
 	t->kind = kind;
 	t->cached_size  = -1;
 	t->cached_align = -1;
@@ -1023,6 +1040,53 @@ gb_internal Type *alloc_type(TypeKind kind) {
 }
 
 
+// NOTE: Structural types which are fully described by their kind, element type and count are
+// hash-consed, so every occurrence of e.g. `[]u8`, `^T` or `[4]f32` shares a single Type and
+// comparing them (and using them as map keys) only needs the pointer.
+gb_global ConcurrentPtrMap<u64, Type *> g_interned_types;
+
+gb_internal u64 type_intern_hash(TypeKind kind, Type *elem, i64 count) {
+	u64 data[3] = {cast(u64)kind, cast(u64)cast(uintptr)elem, cast(u64)count};
+	u64 hash = fnv64a(data, gb_size_of(data));
+	return hash ? hash : 1;
+}
+
+gb_internal bool type_intern_matches(Type *t, TypeKind kind, Type *elem, i64 count) {
+	if (t->kind != kind) {
+		return false;
+	}
+	switch (kind) {
+	case Type_Pointer:      return t->Pointer.elem == elem;
+	case Type_MultiPointer: return t->MultiPointer.elem == elem;
+	case Type_Slice:        return t->Slice.elem == elem;
+	case Type_DynamicArray: return t->DynamicArray.elem == elem;
+	case Type_Array:
+		return t->Array.elem == elem &&
+		       t->Array.count == count &&
+		       t->Array.generic_count == nullptr;
+	}
+	return false;
+}
+
+gb_internal Type *type_intern_find(u64 hash, TypeKind kind, Type *elem, i64 count) {
+	Type *found = nullptr;
+	if (concurrent_map_get(&g_interned_types, hash, &found) &&
+	    type_intern_matches(found, kind, elem, count)) {
+		return found;
+	}
+	return nullptr;
+}
+
+// Returns the canonical type, which is `t` unless another thread interned an identical type first
+gb_internal Type *type_intern_add(u64 hash, Type *t, Type *elem, i64 count) {
+	if (!concurrent_map_set_if_not_previously_exists(&g_interned_types, hash, t)) {
+		return t;
+	}
+	// NOTE: on a hash collision between different types, `t` just stays unique
+	Type *found = type_intern_find(hash, t->kind, elem, count);
+	return found ? found : t;
+}
+
 gb_internal Type *alloc_type_generic(Scope *scope, i64 id, InternedString interned_name, Type *specialized) {
 	Type *t = alloc_type(Type_Generic);
 	t->Generic.id = id;
@@ -1034,15 +1098,23 @@ gb_internal Type *alloc_type_generic(Scope *scope, i64 id, InternedString intern
 }
 
 gb_internal Type *alloc_type_pointer(Type *elem) {
+	u64 hash = type_intern_hash(Type_Pointer, elem, 0);
+	if (Type *found = type_intern_find(hash, Type_Pointer, elem, 0)) {
+		return found;
+	}
 	Type *t = alloc_type(Type_Pointer);
 	t->Pointer.elem = elem;
-	return t;
+	return type_intern_add(hash, t, elem, 0);
 }
 
 gb_internal Type *alloc_type_multi_pointer(Type *elem) {
+	u64 hash = type_intern_hash(Type_MultiPointer, elem, 0);
+	if (Type *found = type_intern_find(hash, Type_MultiPointer, elem, 0)) {
+		return found;
+	}
 	Type *t = alloc_type(Type_MultiPointer);
 	t->MultiPointer.elem = elem;
-	return t;
+	return type_intern_add(hash, t, elem, 0);
 }
 
 gb_internal Type *alloc_type_soa_pointer(Type *elem) {
@@ -1081,10 +1153,21 @@ gb_internal Type *alloc_type_array(Type *elem, i64 count, Type *generic_count =
 		t->Array.generic_count = generic_count;
 		return t;
 	}
+	if (count < 0) {
+		// NOTE: `[?]T` has its count filled in once the compound literal has been checked
+		Type *t = alloc_type(Type_Array);
+		t->Array.elem = elem;
+		t->Array.count = count;
+		return t;
+	}
+	u64 hash = type_intern_hash(Type_Array, elem, count);
+	if (Type *found = type_intern_find(hash, Type_Array, elem, count)) {
+		return found;
+	}
 	Type *t = alloc_type(Type_Array);
 	t->Array.elem = elem;
 	t->Array.count = count;
-	return t;
+	return type_intern_add(hash, t, elem, count);
 }
 
 gb_internal Type *alloc_type_matrix(Type *elem, i64 row_count, i64 column_count, Type *generic_row_count, Type *generic_column_count, bool is_row_major) {
@@ -1127,15 +1210,23 @@ gb_internal Type *alloc_type_enumerated_array(Type *elem, Type *index, ExactValu
 
 
 gb_internal Type *alloc_type_slice(Type *elem) {
+	u64 hash = type_intern_hash(Type_Slice, elem, 0);
+	if (Type *found = type_intern_find(hash, Type_Slice, elem, 0)) {
+		return found;
+	}
 	Type *t = alloc_type(Type_Slice);
 	t->Slice.elem = elem;
-	return t;
+	return type_intern_add(hash, t, elem, 0);
 }
 
 gb_internal Type *alloc_type_dynamic_array(Type *elem) {
+	u64 hash = type_intern_hash(Type_DynamicArray, elem, 0);
+	if (Type *found = type_intern_find(hash, Type_DynamicArray, elem, 0)) {
+		return found;
+	}
 	Type *t = alloc_type(Type_DynamicArray);
 	t->DynamicArray.elem = elem;
-	return t;
+	return type_intern_add(hash, t, elem, 0);
 }
 
 gb_internal Type *alloc_type_fixed_capacity_dynamic_array(Type *elem, i64 capacity, Type *generic_capacity = nullptr) {
@@ -3117,6 +3208,35 @@ gb_internal bool lookup_subtype_polymorphic_selection(Type *dst, Type *src, Sele
 
 gb_internal bool are_types_identical_internal(Type *x, Type *y, bool check_tuple_names);
 
+// NOTE: Per-thread direct-mapped cache of previous results for the large composite types which
+// are repeatedly compared during overload resolution. Only types which can no longer change
+// are cached: non-polymorphic procedure types, and structs whose fields have been checked.
+struct TypesIdenticalCacheEntry {
+	Type *x;
+	Type *y;
+	bool  identical;
+};
+enum : u32 {TYPES_IDENTICAL_CACHE_SIZE = 1024};
+gb_global gb_thread_local TypesIdenticalCacheEntry types_identical_cache[TYPES_IDENTICAL_CACHE_SIZE];
+
+gb_internal bool are_types_identical_cacheable(Type *t) {
+	switch (t->kind) {
+	case Type_Proc:
+		return !t->Proc.is_polymorphic;
+	case Type_Struct:
+		return !t->Struct.is_polymorphic && t->Struct.fields_wait_signal.futex.load(std::memory_order_acquire) != 0;
+	}
+	return false;
+}
+
+gb_internal TypesIdenticalCacheEntry *are_types_identical_cache_entry(Type *x, Type *y) {
+	u64 a = cast(u64)cast(uintptr)x;
+	u64 b = cast(u64)cast(uintptr)y;
+	u64 h = (a ^ (b * 0x9e3779b97f4a7c15ull)) >> 4;
+	h ^= h >> 32;
+	return &types_identical_cache[h & (TYPES_IDENTICAL_CACHE_SIZE-1)];
+}
+
 gb_internal bool are_types_identical(Type *x, Type *y) {
 	if (x == y) {
 		return true;
@@ -3143,6 +3263,22 @@ gb_internal bool are_types_identical(Type *x, Type *y) {
 		return false;
 	}
 
+	if (are_types_identical_cacheable(x) && are_types_identical_cacheable(y)) {
+		if (cast(uintptr)x > cast(uintptr)y) {
+			gb_swap(Type *, x, y);
+		}
+		TypesIdenticalCacheEntry *entry = are_types_identical_cache_entry(x, y);
+		if (entry->x == x && entry->y == y) {
+			return entry->identical;
+		}
+		bool identical = are_types_identical_internal(x, y, false);
+		// NOTE: the recursion may have reused the slot
+		entry->x = x;
+		entry->y = y;
+		entry->identical = identical;
+		return identical;
+	}
+
 	// MUTEX_GUARD(&g_type_mutex);
 	return are_types_identical_internal(x, y, false);
 }
@@ -3317,6 +3453,7 @@ gb_internal bool are_types_identical_internal(Type *x, Type *y, bool check_tuple
 		    x->Struct.fields.count   == y->Struct.fields.count &&
 		    x->Struct.is_packed      == y->Struct.is_packed &&
 		    x->Struct.is_all_or_none == y->Struct.is_all_or_none &&
+		    x->Struct.is_reorder     == y->Struct.is_reorder &&
 		    x->Struct.soa_kind == y->Struct.soa_kind &&
 		    x->Struct.soa_count == y->Struct.soa_count &&
 		    are_types_identical(x->Struct.soa_elem, y->Struct.soa_elem)) {
@@ -3753,6 +3890,126 @@ gb_internal Selection lookup_field_from_index(Type *type, i64 index) {
 gb_internal Entity *scope_lookup_current(Scope *s, InternedString name, u32 hash=0);
 gb_internal bool has_type_got_objc_class_attribute(Type *t);
 
+// NOTE: Resolving a field of a struct value walks its fields and every nested `using` field for each
+// selector expression. Structs with `using` fields (or many fields) instead get a table, built on
+// first use, from each field name to its flattened selection. The table is built in the same depth
+// first order as the walk, so the first match wins just like before. Anything the walk treats
+// specially (`using` of a non-struct, Objective-C classes, polymorphic or #soa of array structs)
+// is not flattened, and those structs keep using the walk.
+struct StructFieldLookupEntry {
+	Entity *   entity;
+	Slice<i32> index;
+	bool       indirect;
+};
+
+struct StructFieldLookupTable {
+	PtrMap<u64, StructFieldLookupEntry> entries; // key: InternedString
+};
+
+gb_global StructFieldLookupTable *const STRUCT_FIELD_LOOKUP_TABLE_NONE = cast(StructFieldLookupTable *)cast(uintptr)1;
+
+enum : isize {
+	STRUCT_FIELD_LOOKUP_TABLE_MIN_FIELD_COUNT = 8,  // structs without `using` fields and fewer fields than this are just walked
+	STRUCT_FIELD_LOOKUP_TABLE_MAX_DEPTH       = 32, // also guards against (erroneous) recursive `using` chains
+};
+
+enum StructFieldLookupTableResult {
+	StructFieldLookupTable_Ok,
+	StructFieldLookupTable_Unsupported, // the struct is always walked
+	StructFieldLookupTable_NotReady,    // a nested struct's fields are not known yet, try again later
+};
+
+gb_internal StructFieldLookupTableResult struct_field_lookup_table_add_fields(StructFieldLookupTable *table, Type *type, Array<i32> *index, bool indirect, isize depth) {
+	GB_ASSERT(type->kind == Type_Struct);
+	if (depth > STRUCT_FIELD_LOOKUP_TABLE_MAX_DEPTH) {
+		return StructFieldLookupTable_Unsupported;
+	}
+	if (type->Struct.soa_kind != StructSoa_None && is_type_array(type->Struct.soa_elem)) {
+		return StructFieldLookupTable_Unsupported;
+	}
+	// NOTE: Never wait on a nested struct here, as the walk may not have needed to look inside it
+	if (type->Struct.fields_wait_signal.futex.load() == 0) {
+		return StructFieldLookupTable_NotReady;
+	}
+
+	for_array(i, type->Struct.fields) {
+		Entity *f = type->Struct.fields[i];
+		if (f->kind != Entity_Variable || (f->flags & EntityFlag_Field) == 0) {
+			continue;
+		}
+		array_add(index, cast(i32)i);
+		defer (array_pop(index));
+
+		u64 key = entity_interned_name(f).value;
+		if (map_get(&table->entries, key) == nullptr) {
+			StructFieldLookupEntry entry = {};
+			entry.entity   = f;
+			entry.index    = slice_clone(permanent_allocator(), slice_from_array(*index));
+			entry.indirect = indirect;
+			map_set(&table->entries, key, entry);
+		}
+
+		if (f->flags & EntityFlag_Using) {
+			Type *original = type_deref(f->type);
+			bool is_ptr = original != f->type;
+			if (has_type_got_objc_class_attribute(original)) {
+				return StructFieldLookupTable_Unsupported;
+			}
+			Type *bt = base_type(original);
+			if (bt == nullptr || bt->kind != Type_Struct || is_type_polymorphic(bt)) {
+				return StructFieldLookupTable_Unsupported;
+			}
+			auto result = struct_field_lookup_table_add_fields(table, bt, index, indirect || is_ptr, depth+1);
+			if (result != StructFieldLookupTable_Ok) {
+				return result;
+			}
+		}
+	}
+	return StructFieldLookupTable_Ok;
+}
+
+gb_internal StructFieldLookupTable *struct_field_lookup_table(Type *type) {
+	GB_ASSERT(type->kind == Type_Struct);
+	StructFieldLookupTable *table = type->Struct.field_lookup_table.load(std::memory_order_acquire);
+	if (table != nullptr) {
+		return table != STRUCT_FIELD_LOOKUP_TABLE_NONE ? table : nullptr;
+	}
+
+	bool has_using = false;
+	for (Entity *f : type->Struct.fields) {
+		if (f->kind == Entity_Variable && (f->flags & (EntityFlag_Field|EntityFlag_Using)) == (EntityFlag_Field|EntityFlag_Using)) {
+			has_using = true;
+			break;
+		}
+	}
+
+	StructFieldLookupTable *new_table = STRUCT_FIELD_LOOKUP_TABLE_NONE;
+	if (has_using || type->Struct.fields.count >= STRUCT_FIELD_LOOKUP_TABLE_MIN_FIELD_COUNT) {
+		new_table = gb_alloc_item(permanent_allocator(), StructFieldLookupTable);
+		map_init(&new_table->entries, type->Struct.fields.count);
+
+		auto index = array_make<i32>(heap_allocator(), 0, 8);
+		defer (array_free(&index));
+		auto result = struct_field_lookup_table_add_fields(new_table, type, &index, false, 0);
+		if (result != StructFieldLookupTable_Ok) {
+			map_destroy(&new_table->entries);
+			if (result == StructFieldLookupTable_NotReady) {
+				return nullptr;
+			}
+			new_table = STRUCT_FIELD_LOOKUP_TABLE_NONE;
+		}
+	}
+
+	if (!type->Struct.field_lookup_table.compare_exchange_strong(table, new_table, std::memory_order_acq_rel)) {
+		// NOTE: Another thread built it first, both are identical
+		if (new_table != STRUCT_FIELD_LOOKUP_TABLE_NONE) {
+			map_destroy(&new_table->entries);
+		}
+		new_table = table;
+	}
+	return new_table != STRUCT_FIELD_LOOKUP_TABLE_NONE ? new_table : nullptr;
+}
+
 gb_internal Selection lookup_field_with_selection(Type *type_, InternedString field_name, bool is_type, Selection sel, bool allow_blank_ident) {
 	GB_ASSERT(type_ != nullptr);
 
@@ -3893,7 +4150,20 @@ gb_internal Selection lookup_field_with_selection(Type *type_, InternedString fi
 			return sel;
 		}
 		wait_signal_until_available(&type->Struct.fields_wait_signal);
-		isize field_count = type->Struct.fields.count;
+		StructFieldLookupTable *table = struct_field_lookup_table(type);
+		if (table != nullptr) {
+			StructFieldLookupEntry *found = map_get(&table->entries, cast(u64)field_name.value);
+			if (found != nullptr) {
+				for (i32 index : found->index) {
+					selection_add_index(&sel, index); // HACK(bill): Leaky memory
+				}
+				sel.entity = found->entity;
+				sel.indirect = sel.indirect || found->indirect;
+				return sel;
+			}
+		}
+
+		isize field_count = table != nullptr ? 0 : type->Struct.fields.count;
 		if (field_count != 0) for_array(i, type->Struct.fields) {
 			Entity *f = type->Struct.fields[i];
 			if (f->kind != Entity_Variable || (f->flags & EntityFlag_Field) == 0) {
@@ -4312,7 +4582,7 @@ gb_internal i64 type_size_of(Type *t) {
 		}
 		t->cached_size.store(size);
 		return size;
-	} else if (t->kind != Type_Named && t->cached_size >= 0) {
+	} else if ((t->kind != Type_Named || type_layouts_are_frozen()) && t->cached_size >= 0) {
 		return t->cached_size.load();
 	} else {
 		TypePath path{};
@@ -4331,7 +4601,7 @@ gb_internal i64 type_align_of(Type *t) {
 	if (t == nullptr) {
 		return 1;
 	}
-	if (t->kind != Type_Named && t->cached_align > 0) {
+	if ((t->kind != Type_Named || type_layouts_are_frozen()) && t->cached_align > 0) {
 		return t->cached_align.load();
 	}
 
@@ -4346,7 +4616,7 @@ gb_internal i64 type_align_of(Type *t) {
 }
 
 
-gb_internal i64 type_align_of_internal(Type *t, TypePath *path) {
+gb_internal i64 type_align_of_internal_uncached(Type *t, TypePath *path) {
 	GB_ASSERT(path != nullptr);
 	if (t->failure) {
 		return FAILURE_ALIGNMENT;
@@ -4604,7 +4874,7 @@ gb_internal bool type_set_offsets(Type *t) {
 	return false;
 }
 
-gb_internal i64 type_size_of_internal(Type *t, TypePath *path) {
+gb_internal i64 type_size_of_internal_uncached(Type *t, TypePath *path) {
 	if (t->failure) {
 		return FAILURE_SIZE;
 	}
@@ -4854,6 +5124,40 @@ gb_internal i64 type_size_of_internal(Type *t, TypePath *path) {
 	return build_context.ptr_size;
 }
 
+// NOTE: Once checking has finished, no type can change its layout any more, so every
+// intermediate size and alignment computed through the internal recursion is stored on
+// the type itself. Before that point a named type may still be resolved further, so
+// only the fully external queries are cached.
+gb_internal i64 type_size_of_internal(Type *t, TypePath *path) {
+	if (!type_layouts_are_frozen()) {
+		return type_size_of_internal_uncached(t, path);
+	}
+	i64 size = t->cached_size.load(std::memory_order_relaxed);
+	if (size >= 0) {
+		return size;
+	}
+	size = type_size_of_internal_uncached(t, path);
+	if (!t->failure && !path->failure) {
+		t->cached_size.store(size, std::memory_order_relaxed);
+	}
+	return size;
+}
+
+gb_internal i64 type_align_of_internal(Type *t, TypePath *path) {
+	if (!type_layouts_are_frozen()) {
+		return type_align_of_internal_uncached(t, path);
+	}
+	i64 align = t->cached_align.load(std::memory_order_relaxed);
+	if (align > 0) {
+		return align;
+	}
+	align = type_align_of_internal_uncached(t, path);
+	if (!t->failure && !path->failure) {
+		t->cached_align.store(align, std::memory_order_relaxed);
+	}
+	return align;
+}
+
 gb_internal i64 type_offset_of(Type *t, i64 index, Type **field_type_) {
 	t = base_type(t);
 	switch (t->kind) {
@@ -5507,6 +5811,7 @@ gb_internal gbString write_type_to_string(gbString str, Type *type, bool shortha
 		if (type->Struct.custom_align != 0) str = gb_string_append_fmt(str, " #align %d", cast(int)type->Struct.custom_align);
 		if (type->Struct.is_all_or_none)    str = gb_string_appendc(str, " #all_or_none");
 		if (type->Struct.is_simple)         str = gb_string_appendc(str, " #simple");
+		if (type->Struct.is_reorder)        str = gb_string_appendc(str, " #reorder");
 
 		str = gb_string_appendc(str, " {");
 
@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+# Benchmarks the compiler itself, rather than the code it generates.
+#
+# A corpus of synthetic programs, each stressing one part of the compiler, plus a few real programs
+# from this repository are checked and built with `-export-timings:json` across several thread
+# counts. The fastest of a number of runs is compared against a stored baseline, and the exit code
+# is non-zero if any total or phase regressed by more than the threshold.
+#
+#     make benchmark-compiler                                              # compare against the baseline
+#     ./build_odin.sh benchmark-compiler --save-baseline                   # store a new baseline
+#     python3 tests/benchmark/compiler/benchmark_compiler.py --help
+#
+# The baseline is machine specific, so it is not checked in. Store one from a known good commit
+# and then compare later commits on the same machine.
+
+import argparse
+import json
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT_DIR      = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "..", ".."))
+BENCH_DIR     = os.path.dirname(os.path.abspath(__file__))
+CORPUS_DIR    = os.path.join(BENCH_DIR, "build", "corpus")
+OUT_DIR       = os.path.join(BENCH_DIR, "build", "out")
+BASELINE_PATH = os.path.join(BENCH_DIR, "baseline.json")
+
+# Phases faster than this are too noisy to compare, in milliseconds
+NOISE_FLOOR_MS = 5.0
+
+NUMERIC_TYPES = ["i8", "i16", "i32", "i64", "u8", "u16", "u32", "u64", "f32", "f64"]
+
+
+def write_file(path, lines):
+	os.makedirs(os.path.dirname(path), exist_ok=True)
+	with open(path, "w") as f:
+		f.write("\n".join(lines))
+		f.write("\n")
+
+
+# Many parametric procedures and structs, each instantiated with every numeric type
+def generate_generics(dir, scale):
+	lines = ["package bench_generics", ""]
+	lines.append("Pair :: struct($A, $B: typeid) { a: A, b: B }")
+	lines.append("Vec  :: struct($N: int, $T: typeid) { e: [N]T }")
+	lines.append("")
+	count = 40*scale
+	for i in range(count):
+		lines.append(f"swap_{i} :: proc(p: Pair($A, $B)) -> Pair(B, A) {{ return {{p.b, p.a}} }}")
+		lines.append(f"sum_{i} :: proc(v: Vec($N, $T)) -> (s: T) {{ for x in v.e {{ s += x }}; return }}")
+		lines.append(f"scale_{i} :: proc(v: Vec($N, $T), k: T) -> (r: Vec(N, T)) {{ for x, j in v.e {{ r.e[j] = x*k }}; return }}")
+	lines.append("")
+	lines.append("main :: proc() {")
+	for i in range(count):
+		a = NUMERIC_TYPES[i % len(NUMERIC_TYPES)]
+		for j, b in enumerate(NUMERIC_TYPES):
+			n = 2 + (i + j) % 7
+			lines.append(f"\t{{ p := swap_{i}(Pair({a}, {b}){{1, 2}}); _ = p }}")
+			lines.append(f"\t{{ v: Vec({n}, {b}); _ = sum_{i}(scale_{i}(v, 3)) }}")
+	lines.append("}")
+	write_file(os.path.join(dir, "generics.odin"), lines)
+
+
+# A huge bindings file: structs, enums, constants and foreign procedure declarations
+def generate_bindings(dir, scale):
+	rng = random.Random(1234)
+	lines = ["package bench_bindings", "", "import \"core:c\"", "", "foreign import lib \"system:c\"", ""]
+	count = 500*scale
+	for i in range(count):
+		lines.append(f"BENCH_CONSTANT_{i} :: 0x{rng.getrandbits(32):08x}")
+	lines.append("")
+	for i in range(count // 4):
+		lines.append(f"Bench_Enum_{i} :: enum c.int {{")
+		for j in range(8):
+			lines.append(f"\tValue_{j} = {j*3 + i % 5},")
+		lines.append("}")
+		lines.append(f"Bench_Struct_{i} :: struct {{")
+		for j in range(12):
+			t = ["c.int", "c.float", "c.double", "rawptr", "cstring", f"Bench_Enum_{i}", "[4]u8"][(i + j) % 7]
+			lines.append(f"\tfield_{j}: {t},")
+		lines.append("}")
+		lines.append(f"Bench_Callback_{i} :: #type proc \"c\" (user: rawptr, value: ^Bench_Struct_{i}) -> c.int")
+	lines.append("")
+	lines.append("@(default_calling_convention=\"c\")")
+	lines.append("foreign lib {")
+	for i in range(count):
+		s = i % (count // 4)
+		lines.append(f"\tbench_function_{i} :: proc(a: c.int, b: ^Bench_Struct_{s}, cb: Bench_Callback_{s}, user: rawptr) -> Bench_Enum_{s} ---")
+	lines.append("}")
+	lines.append("")
+	lines.append("main :: proc() {")
+	lines.append("\tx: Bench_Struct_0")
+	lines.append("\t_ = x")
+	lines.append("}")
+	write_file(os.path.join(dir, "bindings.odin"), lines)
+
+
+# A long chain of packages, each importing the next one
+def generate_deep_imports(dir, scale):
+	depth = 16*scale
+	for i in range(depth):
+		lines = [f"package p{i}", ""]
+		if i+1 < depth:
+			lines.append(f"import next \"../p{i+1}\"")
+			lines.append("")
+		for j in range(40):
+			if i+1 < depth:
+				lines.append(f"value_{j} :: proc(x: int) -> int {{ return next.value_{j}(x) + {j} }}")
+			else:
+				lines.append(f"value_{j} :: proc(x: int) -> int {{ return x + {j} }}")
+			lines.append(f"Type_{j} :: struct {{ a: int, b: [{j+1}]f32 }}")
+		write_file(os.path.join(dir, f"p{i}", f"p{i}.odin"), lines)
+
+	lines = ["package bench_deep_imports", "", "import \"../p0\"", "", "main :: proc() {", "\tx := 0"]
+	for j in range(40):
+		lines.append(f"\tx += p0.value_{j}(x)")
+	lines.append("\t_ = x")
+	lines.append("}")
+	write_file(os.path.join(dir, "main", "main.odin"), lines)
+
+
+# Constant expressions, large constant arrays and compile-time evaluated `when` blocks
+def generate_constants(dir, scale):
+	lines = ["package bench_constants", ""]
+	count = 1000*scale
+	lines.append("C_0 :: 1")
+	for i in range(1, count):
+		lines.append(f"C_{i} :: (C_{i-1}*31 + {i}) % 1000003")
+	lines.append("")
+	lines.append(f"TABLE :: [{count}]int{{")
+	for i in range(count):
+		lines.append(f"\tC_{i},")
+	lines.append("}")
+	lines.append("")
+	for i in range(count // 10):
+		lines.append(f"S_{i} :: \"name_\" + \"{i}\" + \"_suffix\"")
+		lines.append(f"F_{i} :: {i}.5 * 1e3 / 7.0")
+		lines.append(f"when C_{i} % 2 == 0 {{ W_{i} :: S_{i} }} else {{ W_{i} :: \"odd\" }}")
+	lines.append("")
+	lines.append("table := TABLE")
+	lines.append("")
+	lines.append("main :: proc() {")
+	lines.append("\t_ = table[len(table)-1]")
+	for i in range(0, count // 10, 10):
+		lines.append(f"\t_ = W_{i}")
+		lines.append(f"\t_ = F_{i}")
+	lines.append("}")
+	write_file(os.path.join(dir, "constants.odin"), lines)
+
+
+# Many small procedures calling each other
+def generate_small_procs(dir, scale):
+	rng = random.Random(5678)
+	lines = ["package bench_small_procs", ""]
+	count = 2000*scale
+	for i in range(count):
+		if i == 0:
+			lines.append(f"small_{i} :: proc(x: int) -> int {{ return x + 1 }}")
+		else:
+			lines.append(f"small_{i} :: proc(x: int) -> int {{ if x > {i} {{ return small_{i-1}(x - 1) }}; return small_{rng.randrange(i)}(x) + {i} }}")
+	lines.append("")
+	lines.append("main :: proc() {")
+	lines.append(f"\t_ = small_{count-1}(0)")
+	lines.append("}")
+	write_file(os.path.join(dir, "small_procs.odin"), lines)
+
+
+GENERATED_CASES = [
+	# name,          generator,             package directory
+	("generics",     generate_generics,     ""),
+	("bindings",     generate_bindings,     ""),
+	("deep_imports", generate_deep_imports, "main"),
+	("constants",    generate_constants,    ""),
+	("small_procs",  generate_small_procs,  ""),
+]
+
+REAL_CASES = [
+	# name,        command, path relative to the root
+	("demo",       "build", "examples/demo"),
+	("core_all",   "check", "examples/all"),
+]
+
+
+def generate_corpus(scale):
+	cases = []
+	for name, generator, package in GENERATED_CASES:
+		dir = os.path.join(CORPUS_DIR, name)
+		shutil.rmtree(dir, ignore_errors=True)
+		generator(dir, scale)
+		path = os.path.join(dir, package) if package else dir
+		cases.append((name, "check", path))
+		cases.append((name, "build", path))
+	for name, command, path in REAL_CASES:
+		cases.append((name, command, os.path.join(ROOT_DIR, path)))
+	return cases
+
+
+def run_once(odin, command, path, threads, extra_flags):
+	os.makedirs(OUT_DIR, exist_ok=True)
+	fd, timings_path = tempfile.mkstemp(suffix=".json", dir=OUT_DIR)
+	os.close(fd)
+	try:
+		args = [odin, command, path,
+		        "-show-timings",
+		        "-export-timings:json",
+		        f"-export-timings-file:{timings_path}",
+		        f"-thread-count:{threads}"]
+		if command == "build":
+			args.append("-out:" + os.path.join(OUT_DIR, "bench_out"))
+		args += extra_flags
+
+		result = subprocess.run(args, cwd=ROOT_DIR, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+		if result.returncode != 0:
+			print(result.stderr, file=sys.stderr)
+			raise RuntimeError("'{}' failed with exit code {}".format(" ".join(args), result.returncode))
+
+		with open(timings_path) as f:
+			data = json.load(f)
+	finally:
+		os.remove(timings_path)
+
+	# The same phase label can appear more than once, e.g. when a section is restarted
+	timings = {}
+	for t in data["timings"]:
+		timings[t["name"]] = timings.get(t["name"], 0.0) + t["millis"]
+	return timings
+
+
+def run_benchmarks(odin, cases, thread_counts, runs, extra_flags):
+	results = {}
+	for name, command, path in cases:
+		for threads in thread_counts:
+			key = f"{name}/{command}/threads={threads}"
+			best = {}
+			for _ in range(runs):
+				for phase, millis in run_once(odin, command, path, threads, extra_flags).items():
+					best[phase] = min(best.get(phase, millis), millis)
+			results[key] = best
+			print(f"{key:<44} {best.get('Total Time', 0.0):10.3f} ms", flush=True)
+	return results
+
+
+def compare(baseline, results, threshold):
+	regressions = []
+	for key, phases in results.items():
+		base = baseline.get(key)
+		if base is None:
+			print(f"{key}: no baseline")
+			continue
+		for phase, millis in phases.items():
+			before = base.get(phase)
+			if before is None or max(before, millis) < NOISE_FLOOR_MS:
+				continue
+			change = (millis - before) / before if before > 0 else 0.0
+			if change > threshold and millis - before > NOISE_FLOOR_MS:
+				regressions.append((key, phase, before, millis, change))
+
+	if not regressions:
+		print(f"\nNo regressions above {100*threshold:.0f}% of the baseline")
+		return True
+
+	print(f"\nRegressions above {100*threshold:.0f}% of the baseline:")
+	for key, phase, before, after, change in sorted(regressions, key=lambda r: -r[4]):
+		print(f"\t{key:<44} {phase:<36} {before:10.3f} ms -> {after:10.3f} ms ({100*change:+.1f}%)")
+	return False
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Benchmark the Odin compiler against a stored baseline")
+	parser.add_argument("--odin",          default=os.path.join(ROOT_DIR, "odin"), help="the compiler to benchmark")
+	parser.add_argument("--baseline",      default=BASELINE_PATH,                  help="the baseline file to compare against or save to")
+	parser.add_argument("--save-baseline", action="store_true",                    help="store the results as the new baseline instead of comparing")
+	parser.add_argument("--threads",       default="",                             help="comma separated thread counts, defaults to 1, 4 and all cores")
+	parser.add_argument("--runs",          type=int,   default=3,                  help="runs per configuration, the fastest one is kept")
+	parser.add_argument("--scale",         type=int,   default=4,                  help="size multiplier for the synthetic programs")
+	parser.add_argument("--threshold",     type=float, default=0.10,               help="allowed slowdown as a fraction of the baseline")
+	parser.add_argument("--filter",        default="",                             help="only run the cases whose name contains this")
+	parser.add_argument("extra_flags",     nargs="*",                              help="extra flags passed to every compiler invocation")
+	args = parser.parse_args()
+
+	if not os.path.isfile(args.odin):
+		print(f"Compiler not found: {args.odin}", file=sys.stderr)
+		return 1
+
+	if args.threads:
+		thread_counts = [int(t) for t in args.threads.split(",")]
+	else:
+		thread_counts = sorted({1, min(4, os.cpu_count() or 1), os.cpu_count() or 1})
+
+	cases = [c for c in generate_corpus(args.scale) if args.filter in c[0]]
+	results = run_benchmarks(args.odin, cases, thread_counts, args.runs, args.extra_flags)
+
+	if args.save_baseline:
+		with open(args.baseline, "w") as f:
+			json.dump(results, f, indent="\t", sort_keys=True)
+		print(f"\nSaved the baseline to {args.baseline}")
+		return 0
+
+	if not os.path.isfile(args.baseline):
+		print(f"\nNo baseline at {args.baseline}, run with --save-baseline first", file=sys.stderr)
+		return 1
+	with open(args.baseline) as f:
+		baseline = json.load(f)
+	return 0 if compare(baseline, results, args.threshold) else 1
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,94 @@
+package test_internal
+
+import "base:intrinsics"
+import "base:runtime"
+import "core:testing"
+
+// NOTE: with -o:size and above, procedures which never use their context get `undef` passed for it at every direct
+// call, so these make sure the callers around them, and indirect calls through procedure values, still see theirs.
+// CI also runs this package with -o:speed.
+
+@(private="file")
+Counting_Allocator :: struct {
+	backing: runtime.Allocator,
+	count:   int,
+}
+
+@(private="file")
+counting_allocator_proc :: proc(allocator_data: rawptr, mode: runtime.Allocator_Mode,
+                                size, alignment: int,
+                                old_memory: rawptr, old_size: int, location := #caller_location) -> ([]byte, runtime.Allocator_Error) {
+	a := (^Counting_Allocator)(allocator_data)
+	if mode == .Alloc || mode == .Alloc_Non_Zeroed {
+		a.count += 1
+	}
+	return a.backing.procedure(a.backing.data, mode, size, alignment, old_memory, old_size, location)
+}
+
+@(private="file")
+ctx_free_add :: #force_no_inline proc(a, b: int) -> int {
+	return a + b
+}
+
+// NOTE: only calls a context-free procedure, so it becomes context-free as well
+@(private="file")
+ctx_free_chain :: #force_no_inline proc(x: int) -> int {
+	return ctx_free_add(x, x) + ctx_free_add(x, 1)
+}
+
+@(private="file")
+ctx_allocator_data :: #force_no_inline proc() -> rawptr {
+	return context.allocator.data
+}
+
+// NOTE: uses the context after calling a context-free procedure, so it must have been passed on intact
+@(private="file")
+ctx_alloc_after :: #force_no_inline proc(x: int) -> (res: ^int) {
+	y := ctx_free_chain(x)
+	res = new(int)
+	res^ = y
+	return
+}
+
+@(test)
+test_context_elision_direct :: proc(t: ^testing.T) {
+	counter := Counting_Allocator{backing = context.allocator}
+	context.allocator = {counting_allocator_proc, &counter}
+
+	testing.expect_value(t, ctx_free_add(2, 3), 5)
+	testing.expect_value(t, ctx_free_chain(4), 13)
+	testing.expect_value(t, ctx_allocator_data(), rawptr(&counter))
+
+	p := ctx_alloc_after(5)
+	testing.expect_value(t, p^, 16)
+	testing.expect_value(t, counter.count, 1)
+	free(p)
+
+	testing.expect_value(t, context.allocator.data, rawptr(&counter))
+}
+
+@(test)
+test_context_elision_indirect :: proc(t: ^testing.T) {
+	counter := Counting_Allocator{backing = context.allocator}
+	context.allocator = {counting_allocator_proc, &counter}
+
+	// NOTE: the volatile loads stop the optimizer from turning these back into direct calls
+	add   := ctx_free_add
+	chain := ctx_free_chain
+	data  := ctx_allocator_data
+	alloc := ctx_alloc_after
+
+	testing.expect_value(t, intrinsics.volatile_load(&add)(2, 3), 5)
+	testing.expect_value(t, intrinsics.volatile_load(&chain)(4), 13)
+	testing.expect_value(t, intrinsics.volatile_load(&data)(), rawptr(&counter))
+
+	procs := [?]proc(x: int) -> ^int{ctx_alloc_after, alloc}
+	for i in 0..<len(procs) {
+		p := intrinsics.volatile_load(&procs[i])(i)
+		testing.expect_value(t, p^, 3*i + 1)
+		free(p)
+	}
+	testing.expect_value(t, counter.count, 2)
+
+	testing.expect_value(t, context.allocator.data, rawptr(&counter))
+}
@@ -0,0 +1,191 @@
+package test_internal
+
+import "core:testing"
+
+@(private="file")
+wrap_u8 :: proc(a, b: u8) -> u8 {
+	return a*b + 7
+}
+
+@(private="file")
+wrap_i16 :: proc(x: i16) -> i16 {
+	y := x
+	for _ in 0..<4 {
+		y += 16000
+	}
+	return y
+}
+
+@(private="file")
+Point :: struct {
+	x, y: i32,
+	ok:   bool,
+}
+
+@(private="file")
+Colour :: enum u8 {Red, Green, Blue}
+
+@(private="file")
+squares :: proc() -> (res: [6]int) {
+	for i in 0..<len(res) {
+		res[i] = i*i
+	}
+	return
+}
+
+@(private="file")
+make_points :: proc() -> (res: [3]Point) {
+	for &p, i in res {
+		p = Point{x = i32(i), y = -i32(i)*10, ok = i%2 == 0}
+	}
+	return
+}
+
+@(private="file")
+colour_names :: proc() -> (res: [Colour]int) {
+	for c in Colour {
+		res[c] = 100 + int(c)
+	}
+	return
+}
+
+@(private="file")
+powers :: proc($N: int, base: $T) -> (res: [N]T) {
+	x := T(1)
+	for i in 0..<N {
+		res[i] = x
+		x *= base
+	}
+	return
+}
+
+@(private="file")
+fib :: proc(n: int) -> int {
+	if n < 2 {
+		return n
+	}
+	return fib(n-1) + fib(n-2)
+}
+
+@(private="file")
+sum_fib :: proc(n: int) -> (total: int) {
+	for i in 0..=n {
+		total += fib(i)
+	}
+	return
+}
+
+@(private="file")
+crc32_table :: proc() -> (table: [256]u32) {
+	for i in 0..<256 {
+		crc := u32(i)
+		for _ in 0..<8 {
+			crc = (crc >> 1) ~ (0xedb88320 if crc & 1 != 0 else 0)
+		}
+		table[i] = crc
+	}
+	return
+}
+
+@(private="file") EVAL_WRAP_U8   :: #eval(wrap_u8(200, 3))
+@(private="file") EVAL_WRAP_I16  :: #eval(wrap_i16(1000))
+@(private="file") EVAL_SQUARES   :: #eval(squares())
+@(private="file") EVAL_POINTS    :: #eval(make_points())
+@(private="file") EVAL_COLOURS   :: #eval(colour_names())
+@(private="file") EVAL_SUM_FIB   :: #eval(sum_fib(15))
+@(private="file") EVAL_POWERS    :: #eval(powers(6, i8(3)))
+@(rodata, private="file") eval_crc32_table := #eval(crc32_table())
+
+@(test)
+test_eval_integer_wrap :: proc(t: ^testing.T) {
+	// Integers wrap to the width of their type, like generated code does
+	testing.expect_value(t, EVAL_WRAP_U8,  u8(95))
+	testing.expect_value(t, EVAL_WRAP_I16, i16(-536))
+
+	a, b := u8(200), u8(3)
+	testing.expect_value(t, EVAL_WRAP_U8, wrap_u8(a, b))
+	x := i16(1000)
+	testing.expect_value(t, EVAL_WRAP_I16, wrap_i16(x))
+}
+
+@(test)
+test_eval_aggregates :: proc(t: ^testing.T) {
+	testing.expect_value(t, EVAL_SQUARES, [6]int{0, 1, 4, 9, 16, 25})
+
+	points := EVAL_POINTS
+	testing.expect_value(t, points[0], Point{0, 0, true})
+	testing.expect_value(t, points[1], Point{1, -10, false})
+	testing.expect_value(t, points[2], Point{2, -20, true})
+
+	colours := EVAL_COLOURS
+	testing.expect_value(t, colours[.Red],   100)
+	testing.expect_value(t, colours[.Green], 101)
+	testing.expect_value(t, colours[.Blue],  102)
+}
+
+@(test)
+test_eval_nested_calls :: proc(t: ^testing.T) {
+	testing.expect_value(t, EVAL_SUM_FIB, 1596)
+
+	table := crc32_table()
+	testing.expect_value(t, eval_crc32_table[1],   u32(0x77073096))
+	testing.expect_value(t, eval_crc32_table[255], u32(0x2d02ef8d))
+	testing.expect(t, eval_crc32_table == table)
+}
+
+@(test)
+test_eval_polymorphic_calls :: proc(t: ^testing.T) {
+	// The checker has already specialized the callee, and the wrap happens at the width of `T`
+	testing.expect_value(t, EVAL_POWERS, [6]i8{1, 3, 9, 27, 81, -13})
+	testing.expect_value(t, EVAL_POWERS, powers(6, i8(3)))
+}
+
+// NOTE: what `#eval` cannot evaluate is reported as an error, so those cases are only checked with
+//     odin check tests/internal -no-entry-point -define:TEST_EVAL_ERRORS=true
+// which is expected to report each case followed by its invalid declaration, 10 errors in total.
+TEST_EVAL_ERRORS :: #config(TEST_EVAL_ERRORS, false)
+
+when TEST_EVAL_ERRORS {
+	foreign import eval_libc "system:c"
+
+	@(default_calling_convention="c")
+	foreign eval_libc {
+		@(private="file")
+		labs :: proc(x: i64) -> i64 ---
+	}
+
+	@(private="file")
+	eval_spin :: proc() -> int {
+		n := 0
+		for {
+			n += 1
+		}
+	}
+
+	@(private="file")
+	eval_recurse :: proc(n: int) -> int {
+		return eval_recurse(n+1) + 1
+	}
+
+	@(private="file")
+	eval_divide :: proc(a, b: int) -> int {
+		return a / b
+	}
+
+	@(private="file")
+	eval_index :: proc(i: int) -> int {
+		arr := [4]int{1, 2, 3, 4}
+		return arr[i]
+	}
+
+	@(private="file") EVAL_STEP_LIMIT    :: #eval(eval_spin())
+	@(private="file") EVAL_DEPTH_LIMIT   :: #eval(eval_recurse(0))
+	@(private="file") EVAL_DIV_ZERO      :: #eval(eval_divide(1, 0))
+	@(private="file") EVAL_OUT_OF_BOUNDS :: #eval(eval_index(4))
+	@(private="file") EVAL_FOREIGN       :: #eval(labs(-1))
+
+	@(test)
+	test_eval_errors :: proc(t: ^testing.T) {
+		_ = EVAL_STEP_LIMIT + EVAL_DEPTH_LIMIT + EVAL_DIV_ZERO + EVAL_OUT_OF_BOUNDS + int(EVAL_FOREIGN)
+	}
+}
@@ -0,0 +1,31 @@
+package test_internal
+
+import "core:os"
+import "core:testing"
+
+// NOTE: files of at least 1 MiB (`LOAD_FILE_LARGE_SIZE`) are memory mapped by the compiler and embedded with `.incbin`
+// rather than as a constant, so compare them against the file as it is read at run time
+@(private="file") LOAD_LARGE_PATH :: ODIN_ROOT + "tests/core/assets/UCD/UnicodeData.txt"
+
+@(private="file") load_large_bytes  := #load("../core/assets/UCD/UnicodeData.txt")
+@(private="file") load_large_string := #load("../core/assets/UCD/UnicodeData.txt", string)
+
+@(test)
+test_load_large :: proc(t: ^testing.T) {
+	data, err := os.read_entire_file(LOAD_LARGE_PATH, context.allocator)
+	defer delete(data)
+	testing.expect_value(t, err, nil)
+	testing.expect(t, len(data) >= 1<<20)
+
+	testing.expect_value(t, len(load_large_bytes), len(data))
+	testing.expect(t, string(load_large_bytes) == string(data))
+
+	testing.expect_value(t, len(load_large_string), len(data))
+	testing.expect(t, load_large_string == string(data))
+
+	// NOTE: the same file within a procedure is a constant rather than a global
+	local := #load("../core/assets/UCD/UnicodeData.txt", string)
+	testing.expect_value(t, len(local), len(data))
+	testing.expect(t, local[:64] == string(data[:64]))
+	testing.expect(t, local[len(local)-64:] == string(data[len(data)-64:]))
+}
@@ -0,0 +1,104 @@
+package test_internal
+
+import "core:c/libc"
+import "core:testing"
+
+// NOTE: the bounds checks an enclosing range loop proves are skipped, these make sure the ones it
+// cannot prove are kept and the ones it does prove index correctly
+
+@(private="file")
+sum_param_slice :: proc(x: []int) -> (sum: int) {
+	for i in 0..<len(x) {
+		sum += x[i]
+	}
+	for i in 1..<len(x) {
+		sum += x[i] * 100
+	}
+	return
+}
+
+@(private="file")
+sum_param_dynamic :: proc(x: [dynamic]int) -> (sum: int) {
+	for v, i in x {
+		sum += x[i] * v
+	}
+	return
+}
+
+@(private="file")
+sum_param_string :: proc(s: string) -> (sum: int) {
+	for i in 0..<len(s) {
+		sum += int(s[i])
+	}
+	return
+}
+
+@(test)
+test_range_bounds_params :: proc(t: ^testing.T) {
+	backing := [?]int{1, 2, 3, 4, 5}
+	testing.expect_value(t, sum_param_slice(backing[:]), 15 + 1400)
+	testing.expect_value(t, sum_param_slice(backing[:1]), 1)
+	testing.expect_value(t, sum_param_slice(nil), 0)
+
+	d := make([dynamic]int, 0, 3, context.temp_allocator)
+	append(&d, 2, 3, 4)
+	testing.expect_value(t, sum_param_dynamic(d), 4 + 9 + 16)
+
+	testing.expect_value(t, sum_param_string("abc"), 97 + 98 + 99)
+	testing.expect_value(t, sum_param_string(""), 0)
+}
+
+@(test)
+test_range_bounds_reassigned_array :: proc(t: ^testing.T) {
+	// The length of a fixed array is part of its type, so reassigning it within the loop is fine
+	arr := [4]int{1, 2, 3, 4}
+	sum := 0
+	for i in 0..<len(arr) {
+		arr = {10, 20, 30, 40}
+		sum += arr[i]
+	}
+	testing.expect_value(t, sum, 10 + 20 + 30 + 40)
+}
+
+@(test)
+test_range_bounds_trap_local_slice :: proc(t: ^testing.T) {
+	testing.expect_signal(t, libc.SIGILL)
+
+	backing := [4]int{1, 2, 3, 4}
+	s := backing[:]
+	sum := 0
+	for i in 0..<len(s) {
+		if i == 2 {
+			s = s[:1]
+		}
+		sum += s[i]
+	}
+	testing.expect_value(t, sum, -1)
+}
+
+@(test)
+test_range_bounds_trap_other_array :: proc(t: ^testing.T) {
+	testing.expect_signal(t, libc.SIGILL)
+
+	arr   := [4]int{1, 2, 3, 4}
+	short := [2]int{5, 6}
+	sum := 0
+	for _, i in arr {
+		sum += short[i]
+	}
+	testing.expect_value(t, sum, -1)
+}
+
+@(test)
+test_range_bounds_trap_copied_index :: proc(t: ^testing.T) {
+	testing.expect_signal(t, libc.SIGILL)
+
+	arr := [4]int{1, 2, 3, 4}
+	sum := 0
+	for i in 0..<len(arr) {
+		j := i
+		j += 1
+		sum += arr[j]
+	}
+	testing.expect_value(t, sum, -1)
+}
@@ -1,5 +1,6 @@
 package test_internal
 
+import "base:runtime"
 import "core:fmt"
 import "core:testing"
 
@@ -44,3 +45,103 @@ rtti_test :: proc(t: ^testing.T) {
 	testing.expectf(t, g_s == EXPECTED_REPR, "Expected fmt.tprintf(\"%%s\", g_s)) to return \"%v\", got \"%v\"", EXPECTED_REPR, g_s)
 	testing.expectf(t, l_s == EXPECTED_REPR, "Expected fmt.tprintf(\"%%s\", l_s)) to return \"%v\", got \"%v\"", EXPECTED_REPR, l_s)
 }
+
+@(private="file")
+Dense_Enum :: enum i8 {
+	Zebra = -3, Apple, apple, Mango, Kiwi, Banana, Cherry, Date, Fig, Elderberry,
+}
+
+@(private="file")
+Sparse_Enum :: enum i32 {
+	A = -1_000_000, B = -70, C = 0, D = 9, E = 1_000, F = 77_777, G = 1_000_000, H = 2_000_000_000,
+}
+
+@(private="file")
+High_Enum :: enum u64 {
+	Zero = 0, One, Two, Three, Four, Five, Six,
+	Half = 0x8000_0000_0000_0000,
+	Max  = 0xFFFF_FFFF_FFFF_FFFF,
+}
+
+@(private="file")
+Duplicate_Enum :: enum {
+	A = 1, B = 2, C = 1, D = 3, E = 2, F = 4, G = 5, H = 6, I = 1,
+}
+
+@(private="file")
+Small_Enum :: enum {
+	X = 10, Y = -10, Z = 10,
+}
+
+@(private="file")
+expect_enum_lookup :: proc(t: ^testing.T, $E: typeid, loc := #caller_location) {
+	e := &type_info_of(E).variant.(runtime.Type_Info_Named).base.variant.(runtime.Type_Info_Enum)
+
+	// Every result must match that of a linear scan, which finds the first field with a value
+	for value, i in e.values {
+		first := i
+		for other, j in e.values {
+			if other == value {
+				first = j
+				break
+			}
+		}
+		index, ok := runtime.type_info_enum_index_of_value(e, value)
+		testing.expect(t, ok, loc=loc)
+		testing.expect_value(t, index, first, loc=loc)
+
+		index, ok = runtime.type_info_enum_index_of_name(e, e.names[i])
+		testing.expect(t, ok, loc=loc)
+		testing.expect_value(t, index, i, loc=loc)
+	}
+
+	for value in e.values {
+		for delta in ([]runtime.Type_Info_Enum_Value{-1, +1}) {
+			missing := value + delta
+			found := false
+			for other in e.values {
+				found ||= other == missing
+			}
+			if !found {
+				_, ok := runtime.type_info_enum_index_of_value(e, missing)
+				testing.expectf(t, !ok, "found %v which is not a value of %v", missing, typeid_of(E), loc=loc)
+			}
+		}
+	}
+	for name in ([]string{"", "a", "W", "Zebra_", "Aardvark", "zzz", "\xff"}) {
+		_, ok := runtime.type_info_enum_index_of_name(e, name)
+		testing.expectf(t, !ok, "found the name %q in %v", name, typeid_of(E), loc=loc)
+	}
+}
+
+@(test)
+test_enum_lookup_tables :: proc(t: ^testing.T) {
+	expect_enum_lookup(t, Dense_Enum)
+	expect_enum_lookup(t, Sparse_Enum)
+	expect_enum_lookup(t, High_Enum)
+	expect_enum_lookup(t, Duplicate_Enum)
+	expect_enum_lookup(t, Small_Enum)
+
+	enum_info :: proc($E: typeid) -> ^runtime.Type_Info_Enum {
+		return &type_info_of(E).variant.(runtime.Type_Info_Named).base.variant.(runtime.Type_Info_Enum)
+	}
+
+	// Which of the tables is generated depends on the number of fields and on how dense the values are
+	dense  := enum_info(Dense_Enum)
+	sparse := enum_info(Sparse_Enum)
+	high   := enum_info(High_Enum)
+	small  := enum_info(Small_Enum)
+	testing.expect_value(t, len(dense.value_lookup), len(Dense_Enum))
+	testing.expect_value(t, dense.min_value, -3)
+	testing.expect_value(t, len(sparse.value_lookup), 0)
+	testing.expect_value(t, len(sparse.value_order), len(Sparse_Enum))
+	testing.expect_value(t, len(high.value_order), len(High_Enum))
+	testing.expect_value(t, len(small.value_lookup), 0)
+	testing.expect_value(t, len(small.value_order), 0)
+	testing.expect_value(t, len(small.name_order), 0)
+
+	testing.expect_value(t, fmt.tprint(High_Enum.Max),  "Max")
+	testing.expect_value(t, fmt.tprint(High_Enum.Half), "Half")
+	testing.expect_value(t, fmt.tprint(Duplicate_Enum(2)), "B")
+	testing.expect_value(t, fmt.tprint(Sparse_Enum(10)), "%!(BAD ENUM VALUE=10)")
+}
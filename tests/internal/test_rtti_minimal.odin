@@ -0,0 +1,72 @@
+package test_internal
+
+import "core:encoding/json"
+import "core:fmt"
+import "core:testing"
+
+// NOTE: with -rtti:minimal only the types which are used directly keep their own member names, these make sure
+// the types nested within them keep theirs too, as printing or marshalling a value walks all of them.
+// CI also runs this package with -rtti:minimal.
+
+@(private="file")
+Rtti_Inner :: struct {
+	x, y: i32,
+}
+
+@(private="file")
+Rtti_Variant :: union {
+	Rtti_Inner,
+	bool,
+}
+
+@(private="file")
+Rtti_Outer :: struct {
+	name:    string,
+	inner:   Rtti_Inner,
+	ptr:     ^Rtti_Inner,
+	list:    []Rtti_Inner,
+	variant: Rtti_Variant,
+	table:   map[string]Rtti_Inner,
+}
+
+@(private="file")
+Rtti_Document :: struct {
+	name:    string,
+	inner:   Rtti_Inner,
+	list:    []Rtti_Inner,
+	variant: Rtti_Variant,
+	table:   map[string]Rtti_Inner,
+}
+
+@(test)
+test_rtti_nested_member_names :: proc(t: ^testing.T) {
+	inner := Rtti_Inner{3, 4}
+	list  := [?]Rtti_Inner{{5, 6}}
+	outer := Rtti_Outer{
+		name    = "a",
+		inner   = {1, 2},
+		ptr     = &inner,
+		list    = list[:],
+		variant = Rtti_Inner{7, 8},
+	}
+
+	// NOTE: only `Rtti_Outer` itself is passed as an `any`
+	testing.expect_value(t, fmt.tprintf("%v", outer),
+		"Rtti_Outer{name = \"a\", inner = Rtti_Inner{x = 1, y = 2}, ptr = &Rtti_Inner{x = 3, y = 4}, " +
+		"list = [Rtti_Inner{x = 5, y = 6}], variant = Rtti_Inner{x = 7, y = 8}, table = map[]}")
+}
+
+@(test)
+test_rtti_nested_member_names_json :: proc(t: ^testing.T) {
+	list := [?]Rtti_Inner{{5, 6}}
+	doc  := Rtti_Document{
+		name    = "a",
+		inner   = {1, 2},
+		list    = list[:],
+		variant = Rtti_Inner{7, 8},
+	}
+
+	data, err := json.marshal(doc, allocator = context.temp_allocator)
+	testing.expect_value(t, err, nil)
+	testing.expect_value(t, string(data), `{"name":"a","inner":{"x":1,"y":2},"list":[{"x":5,"y":6}],"variant":{"x":7,"y":8},"table":{}}`)
+}
@@ -0,0 +1,93 @@
+package test_internal
+
+import "core:testing"
+
+@(private="file")
+Reordered :: struct #reorder {
+	a: u8,
+	b: u64,
+	c: u16,
+	d: u32,
+	e: u8,
+}
+
+@(private="file")
+Declared :: struct {
+	a: u8,
+	b: u64,
+	c: u16,
+	d: u32,
+	e: u8,
+}
+
+@(private="file")
+Base :: struct {
+	tag: u8,
+}
+
+@(private="file")
+Derived :: struct #reorder {
+	x: u8,
+	y: u64,
+	#subtype base: Base,
+	z: u32,
+}
+
+@(test)
+test_struct_reorder_offsets :: proc(t: ^testing.T) {
+	// Descending alignment removes all of the padding between the fields
+	testing.expect_value(t, size_of(Reordered), 16)
+	testing.expect_value(t, size_of(Declared),  32)
+
+	testing.expect_value(t, offset_of(Reordered, b), 0)
+	testing.expect_value(t, offset_of(Reordered, d), 8)
+	testing.expect_value(t, offset_of(Reordered, c), 12)
+
+	// Fields of equal alignment keep their declaration order
+	testing.expect_value(t, offset_of(Reordered, a), 14)
+	testing.expect_value(t, offset_of(Reordered, e), 15)
+}
+
+@(test)
+test_struct_reorder_subtype_first :: proc(t: ^testing.T) {
+	testing.expect_value(t, offset_of(Derived, base), 0)
+	testing.expect_value(t, offset_of(Derived, y),    8)
+	testing.expect_value(t, offset_of(Derived, z),    16)
+	testing.expect_value(t, offset_of(Derived, x),    20)
+
+	d := Derived{base = {tag = 7}, x = 1}
+	b := (^Base)(&d)
+	testing.expect_value(t, b.tag, 7)
+}
+
+@(test)
+test_struct_reorder_named_literals :: proc(t: ^testing.T) {
+	r := Reordered{e = 5, a = 1, d = 4, b = 2, c = 3}
+	testing.expect_value(t, r.a, 1)
+	testing.expect_value(t, r.b, 2)
+	testing.expect_value(t, r.c, 3)
+	testing.expect_value(t, r.d, 4)
+	testing.expect_value(t, r.e, 5)
+
+	CONSTANT :: Reordered{c = 30, e = 50}
+	r = CONSTANT
+	testing.expect_value(t, r, Reordered{a = 0, b = 0, c = 30, d = 0, e = 50})
+
+	bytes := transmute([size_of(Reordered)]u8)r
+	testing.expect_value(t, bytes[12], 30)
+	testing.expect_value(t, bytes[15], 50)
+}
+
+// NOTE: positional compound literals would depend on the order the fields end up in, so they are
+// rejected. That is only checked with
+//     odin check tests/internal -no-entry-point -define:TEST_REORDER_ERRORS=true
+// which is expected to report 2 errors.
+TEST_REORDER_ERRORS :: #config(TEST_REORDER_ERRORS, false)
+
+when TEST_REORDER_ERRORS {
+	@(test)
+	test_struct_reorder_positional_literals :: proc(t: ^testing.T) {
+		_ = Reordered{1, 2, 3, 4, 5}
+		_ = Derived{{1}, 2, 3, 4}
+	}
+}
@@ -0,0 +1,15 @@
+// NOTE: these must not compile, and this package is not imported by the internal tests. Check it with
+//     odin check tests/internal/test_struct_reorder_errors -no-entry-point
+// which is expected to report 2 syntax errors. Positional compound literals are covered in
+// test_struct_reorder.odin, as syntax errors stop the checking.
+package test_struct_reorder_errors
+
+Packed :: struct #packed #reorder {
+	a: u8,
+	b: u64,
+}
+
+Raw :: struct #raw_union #reorder {
+	a: u8,
+	b: u64,
+}
@@ -0,0 +1,66 @@
+package test_internal
+
+import "core:testing"
+
+@(private="file")
+overlapping_inclusive :: proc(x: int) -> int {
+	switch x {
+	case 1..=10:
+		return 1
+	case 5:
+		return 2
+	case 11..=20:
+		return 3
+	}
+	return 0
+}
+
+@(private="file")
+overlapping_half_open :: proc(x: int) -> int {
+	switch x {
+	case 0..<10:
+		return 1
+	case 5..<15:
+		return 2
+	}
+	return 0
+}
+
+@(private="file")
+disjoint_ranges :: proc(x: u8) -> int {
+	switch x {
+	case 0..<4:
+		return 1
+	case 4, 5:
+		return 2
+	case 6..=9:
+		return 3
+	}
+	return 0
+}
+
+@(test)
+test_switch_overlapping_ranges :: proc(t: ^testing.T) {
+	// The first case which matches wins
+	testing.expect_value(t, overlapping_inclusive(0),  0)
+	testing.expect_value(t, overlapping_inclusive(1),  1)
+	testing.expect_value(t, overlapping_inclusive(5),  1)
+	testing.expect_value(t, overlapping_inclusive(10), 1)
+	testing.expect_value(t, overlapping_inclusive(11), 3)
+	testing.expect_value(t, overlapping_inclusive(21), 0)
+
+	testing.expect_value(t, overlapping_half_open(-1), 0)
+	testing.expect_value(t, overlapping_half_open(5),  1)
+	testing.expect_value(t, overlapping_half_open(9),  1)
+	testing.expect_value(t, overlapping_half_open(10), 2)
+	testing.expect_value(t, overlapping_half_open(14), 2)
+	testing.expect_value(t, overlapping_half_open(15), 0)
+}
+
+@(test)
+test_switch_disjoint_ranges :: proc(t: ^testing.T) {
+	expected := [?]int{1, 1, 1, 1, 2, 2, 3, 3, 3, 3, 0}
+	for want, i in expected {
+		testing.expect_value(t, disjoint_ranges(u8(i)), want)
+	}
+}
@@ -0,0 +1,54 @@
+#+build amd64
+package test_internal
+
+import "core:sys/info"
+import "core:testing"
+
+// NOTE: `llvm.fmuladd` is only fused when the procedure is compiled with FMA, so the result tells which clone
+// the dispatcher picked. 1 + 2^-30 times 1 - 2^-30 is 1 - 2^-60, which rounds to 1 unless the multiply is fused.
+
+@(default_calling_convention="none", private="file")
+foreign _ {
+	@(link_name="llvm.fmuladd.f64", require_results)
+	_fmuladd_f64 :: proc(a, b, c: f64) -> f64 ---
+}
+
+@(private="file", target_clones="fma")
+clones_fmuladd :: proc(a, b, c: f64) -> f64 {
+	return _fmuladd_f64(a, b, c)
+}
+
+@(private="file", target_clones="x86-64-v4,x86-64-v3,avx2")
+clones_sum :: proc(x: []f32) -> (sum: f32) {
+	for v in x {
+		sum += v
+	}
+	return
+}
+
+@(test)
+test_target_clones_dispatch :: proc(t: ^testing.T) {
+	features := info.cpu_features()
+	// NOTE: `.avx` is only reported when the OS saves the YMM registers, unlike `.fma`
+	has_fma := .fma in features && .avx in features
+
+	EPS :: 1.0 / (1 << 30)
+	expected := -EPS*EPS if has_fma else 0
+
+	a, b, c := 1 + EPS, 1 - EPS, f64(-1)
+	testing.expect_value(t, clones_fmuladd(a, b, c), expected)
+	// NOTE: the choice is cached after the first call
+	testing.expect_value(t, clones_fmuladd(a, b, c), expected)
+}
+
+@(test)
+test_target_clones_vector_levels :: proc(t: ^testing.T) {
+	x: [1000]f32
+	for &v, i in x {
+		v = f32(i % 7)
+	}
+	// NOTE: whichever level is picked must be able to run here, the sum is exact in f32
+	testing.expect_value(t, clones_sum(x[:]), 2997)
+	testing.expect_value(t, clones_sum(x[:3]), 3)
+	testing.expect_value(t, clones_sum(nil), 0)
+}